@@ -87,6 +87,14 @@ typedef struct
 	uint16_t height;
 } LCD_Image_TypeDef;
 
+typedef struct
+{
+	const uint8_t *data;		/* Run-length encoded pixels, see Software/tools/lcd_image_converter.py */
+	const uint16_t *palette;	/* RGB565 palette or 0 if the pixels are stored as RGB565 values */
+	uint16_t width;
+	uint16_t height;
+} LCD_CompressedImage_TypeDef;
+
 typedef struct
 {
 	uint16_t xLeft;
@@ -100,6 +108,7 @@ void LCD_Init();
 
 void LCD_ClearFullWindow();
 void LCD_ClearActiveWindow(uint16_t XLeft, uint16_t XRight, uint16_t YTop, uint16_t YBottom);
+void LCD_WaitUntilIdle();
 void LCD_SetBrightness(uint8_t Brightness);
 void LCD_DisplayOn();
 
@@ -126,7 +135,10 @@ void LCD_DrawSquareOrLine(uint16_t XStart, uint16_t XEnd, uint16_t YStart, uint1
 /* BTE - Block Transfer Engine */
 void LCD_BTESize(uint16_t Width, uint16_t Height);
 void LCD_BTESourceDestinationPoints(uint16_t SourceX, uint16_t SourceY, uint16_t DestinationX, uint16_t DestinationY);
+void LCD_BTEMove(uint16_t SourceX, uint16_t SourceY, uint16_t DestinationX, uint16_t DestinationY,
+				 uint16_t Width, uint16_t Height);
 void LCD_BTEDisplayImageOfSizeAt(const LCD_Image_TypeDef* Image, uint16_t XPos, uint16_t YPos);
+void LCD_BTEDisplayCompressedImageAt(const LCD_CompressedImage_TypeDef* Image, uint16_t XPos, uint16_t YPos);
 
 void LCD_TestBackground(uint16_t Delay);
 void LCD_TestBackgroundFade(uint16_t Delay);
@@ -27,24 +27,85 @@
 #include "lcd_ra8875.h"
 #include "lcd_ra8875_registers.h"
 
+#include <stdbool.h>
+
 /* Private defines -----------------------------------------------------------*/
+#define LCD_WAIT_PORT				(GPIOD)
+#define LCD_WAIT_PIN				(GPIO_PIN_11)
+
+/* Only DMA2 can do memory-to-memory transfers */
+#define LCD_DMA_STREAM				(DMA2_Stream0)
+#define LCD_DMA_CHANNEL				(DMA_CHANNEL_0)
+#define LCD_DMA_IRQn				(DMA2_Stream0_IRQn)
+#define LCD_DMA_CLK_ENABLE()		(__DMA2_CLK_ENABLE())
+
+/*
+ * Max number of pixels in one DMA transfer, a full screen is sent in about 24 chunks. The FSMC
+ * doesn't use the WAIT signal (NWAIT is taken by the touch interrupt) so nothing holds the DMA
+ * back inside a chunk. Instead the FSMC data phase is stretched to LCD_DMA_DATA_SETUP_TIME
+ * while the DMA runs, that is about 100 ns per pixel which the RA8875 memory write FIFO keeps
+ * up with, and the next chunk is only started from the WAIT interrupt.
+ */
+#define LCD_DMA_CHUNK_SIZE			(16384)
+#define LCD_DMA_DATA_SETUP_TIME		(12)
+#define LCD_DMA_TIMEOUT				(1000)
+
+/* The CCM RAM is only connected to the D-bus so the DMA can't read from it */
+#define IS_LCD_DMA_ADDRESS(X)		(((uint32_t)(X) < 0x10000000) || ((uint32_t)(X) >= 0x10010000))
+
+/* Packet header for compressed images, see Software/tools/lcd_image_converter.py */
+#define LCD_RLE_RUN_FLAG			(0x80)
+#define LCD_RLE_LENGTH_MASK			(0x7F)
+
+/* Bus accesses through the FSMC, the host tests define them to run the driver against a simulated RA8875 */
+#ifndef LCD_BUS_WRITE_REG
+#define LCD_BUS_WRITE_REG(VALUE)	(*LCD.LCD_REG = (VALUE))
+#define LCD_BUS_WRITE_RAM(VALUE)	(*LCD.LCD_RAM = (VALUE))
+#define LCD_BUS_READ_REG()			(*LCD.LCD_REG)
+#define LCD_BUS_READ_RAM()			(*LCD.LCD_RAM)
+#endif
+
 /* Private typedefs ----------------------------------------------------------*/
 typedef struct
 {
 	__IO uint16_t *LCD_REG;
 	__IO uint16_t *LCD_RAM;
 	SemaphoreHandle_t xWaitSemaphore;	/* Semaphore for the wait signal */
+	SemaphoreHandle_t xDMASemaphore;	/* Semaphore for when a DMA transfer is done */
 } LCD_TypeDef;
 
 /* Private variables ---------------------------------------------------------*/
 LCD_TypeDef LCD;
 SemaphoreHandle_t xLCDSemaphore;
 
+static DMA_HandleTypeDef DMA_Handle = {
+		.Instance					= LCD_DMA_STREAM,
+		.Init.Channel 				= LCD_DMA_CHANNEL,
+		.Init.Direction 			= DMA_MEMORY_TO_MEMORY,
+		.Init.PeriphInc 			= DMA_PINC_ENABLE,		/* Source: the pixel data */
+		.Init.MemInc 				= DMA_MINC_DISABLE,		/* Destination: the FSMC data address */
+		.Init.PeriphDataAlignment 	= DMA_PDATAALIGN_HALFWORD,
+		.Init.MemDataAlignment 		= DMA_MDATAALIGN_HALFWORD,
+		.Init.Mode 					= DMA_NORMAL,
+		.Init.Priority				= DMA_PRIORITY_MEDIUM,
+		.Init.FIFOMode 				= DMA_FIFOMODE_ENABLE,	/* Direct mode is not allowed for memory-to-memory */
+		.Init.FIFOThreshold      	= DMA_FIFO_THRESHOLD_FULL,
+		.Init.MemBurst				= DMA_MBURST_SINGLE,
+		.Init.PeriphBurst			= DMA_PBURST_SINGLE,
+};
+
+/* State of the current DMA transfer, shared between the task and the interrupts */
+static volatile uint32_t prvDMASourceAddress = 0;
+static volatile uint32_t prvDMAPixelsLeft = 0;
+static volatile bool prvDMAIsWaitingForLcd = false;
+static volatile bool prvDMAErrorOccurred = false;
+
 /* Private function prototypes -----------------------------------------------*/
 static void prvLCD_GPIOConfig();
 static void prvLCD_FSMCConfig();
 static void prvLCD_InterruptConfig();
 static void prvLCD_PLLInit();
+static void prvLCD_DMAInit();
 
 static inline void prvLCD_CmdWrite(uint16_t Command);
 static inline void prvLCD_DataWrite(uint16_t Data);
@@ -57,6 +118,17 @@ static void prvLCD_CheckBTEBusy();
 
 static void prvLCD_SetActiveWindow(uint16_t XLeft, uint16_t XRight, uint16_t YTop, uint16_t YBottom);
 
+static void prvLCD_BTESize(uint16_t Width, uint16_t Height);
+static void prvLCD_BTESourceDestinationPoints(uint16_t SourceX, uint16_t SourceY, uint16_t DestinationX, uint16_t DestinationY);
+static void prvLCD_BTEStartImageWrite(uint16_t Width, uint16_t Height, uint16_t XPos, uint16_t YPos);
+static inline uint16_t prvLCD_ReadCompressedPixel(const uint8_t** ppData, const uint16_t* pPalette);
+
+static ErrorStatus prvLCD_DMAWritePixels(const uint16_t* pPixels, uint32_t NumOfPixels);
+static void prvLCD_DMAStartNextChunk();
+static void prvLCD_DMARequestNextChunk();
+static void prvLCD_DMATransferCompleteCallback(DMA_HandleTypeDef* hdma);
+static void prvLCD_DMATransferErrorCallback(DMA_HandleTypeDef* hdma);
+
 static void prvLCD_WriteString(uint8_t *String);
 static void prvLCD_SetTextWritePosition(uint16_t XPos, uint16_t YPos);
 static void prvLCD_GetTextWritePosition(uint16_t* XPos, uint16_t* YPos);
@@ -88,9 +160,13 @@ void LCD_Init()
 	/* Give the semaphore because the LCD should be when we start */
 	xSemaphoreGive(LCD.xWaitSemaphore);
 
+	/* Given from the DMA interrupt when all pixels of a transfer have been written */
+	LCD.xDMASemaphore = xSemaphoreCreateBinary();
+
 	prvLCD_GPIOConfig();
 	prvLCD_FSMCConfig();
 	prvLCD_InterruptConfig();
+	prvLCD_DMAInit();
 
 	/* Software reset the LCD */
 	prvLCD_WriteCommandWithData(LCD_PWRR, 0x01);
@@ -179,6 +255,25 @@ void LCD_ClearActiveWindow(uint16_t XLeft, uint16_t XRight, uint16_t YTop, uint1
 	xSemaphoreGive(xLCDSemaphore);
 }
 
+/**
+ * @brief	Wait until the LCD has finished the current memory clear, drawing or BTE operation
+ * @param	None
+ * @retval	None
+ * @note	The other functions return as soon as the command is written so this is needed when
+ * 			timing how long the LCD itself takes
+ */
+void LCD_WaitUntilIdle()
+{
+	/* Try to take the semaphore */
+	xSemaphoreTake(xLCDSemaphore, portMAX_DELAY);
+
+	prvLCD_CheckBusy();
+	prvLCD_CheckBTEBusy();
+
+	/* Give back the semaphore */
+	xSemaphoreGive(xLCDSemaphore);
+}
+
 /**
  * @brief	Sets the brightness of the backlight
  * @param	Brightness: A value between 0 and 255 where 255 is fully on
@@ -583,18 +678,7 @@ void LCD_BTESize(uint16_t Width, uint16_t Height)
 	/* Try to take the semaphore */
 	xSemaphoreTake(xLCDSemaphore, portMAX_DELAY);
 
-	uint16_t temp;
-	temp = Width;
-	/* BTE Width */
-	prvLCD_WriteCommandWithData(LCD_BEWR0, temp);
-	temp = Width >> 8;
-	prvLCD_WriteCommandWithData(LCD_BEWR1, temp);
-
-	temp = Height;
-	/* BTE Height */
-	prvLCD_WriteCommandWithData(LCD_BEHR0, temp);
-	temp = Height >> 8;
-	prvLCD_WriteCommandWithData(LCD_BEHR1, temp);
+	prvLCD_BTESize(Width, Height);
 
 	/* Give back the semaphore */
 	xSemaphoreGive(xLCDSemaphore);
@@ -613,39 +697,35 @@ void LCD_BTESourceDestinationPoints(uint16_t SourceX, uint16_t SourceY, uint16_t
 	/* Try to take the semaphore */
 	xSemaphoreTake(xLCDSemaphore, portMAX_DELAY);
 
-	uint16_t temp, temp1;
+	prvLCD_BTESourceDestinationPoints(SourceX, SourceY, DestinationX, DestinationY);
 
-	/* Horizontal Source Point of BTE */
-	temp = SourceX;
-	prvLCD_WriteCommandWithData(LCD_HSBE0, temp);
-	temp = SourceX >> 8;
-	prvLCD_WriteCommandWithData(LCD_HSBE1, temp);
-
-	/* Vertical Source Point of BTE */
-	temp = SourceY;
-	prvLCD_WriteCommandWithData(LCD_VSBE0, temp);
-	temp = SourceY >> 8;
-	prvLCD_CmdWrite(LCD_VSBE1);
-	temp1 = prvLCD_DataRead();
-	temp1 &= 0x80;	/* Get Source layer */
-    temp = temp | temp1;
-    prvLCD_WriteCommandWithData(LCD_VSBE1, temp);
+	/* Give back the semaphore */
+	xSemaphoreGive(xLCDSemaphore);
+}
 
-	/* Horizontal Destination Point of BTE */
-	temp = DestinationX;
-	prvLCD_WriteCommandWithData(LCD_HDBE0, temp);
-	temp = DestinationX >> 8;
-	prvLCD_WriteCommandWithData(LCD_HDBE1, temp);
+/**
+ * @brief	Copy a block of the display memory to another place with the BTE
+ * @param	SourceX: X-coordinate of the upper left corner of the block
+ * @param	SourceY: Y-coordinate of the upper left corner of the block
+ * @param	DestinationX: X-coordinate where the upper left corner should be copied to
+ * @param	DestinationY: Y-coordinate where the upper left corner should be copied to
+ * @param	Width: Width of the block
+ * @param	Height: Height of the block
+ * @retval	None
+ * @note	The move is done in the positive direction so if the blocks overlap the destination must be
+ * 			above or to the left of the source. Returns when the move has been started, use
+ * 			LCD_WaitUntilIdle to wait for it to finish.
+ */
+void LCD_BTEMove(uint16_t SourceX, uint16_t SourceY, uint16_t DestinationX, uint16_t DestinationY,
+				 uint16_t Width, uint16_t Height)
+{
+	/* Try to take the semaphore */
+	xSemaphoreTake(xLCDSemaphore, portMAX_DELAY);
 
-    /* Vertical Destination Point of BTE */
-	temp = DestinationY;
-	prvLCD_WriteCommandWithData(LCD_VDBE0, temp);
-	temp = DestinationY >> 8;
-	prvLCD_CmdWrite(LCD_VDBE1);
-	temp1 = prvLCD_DataRead();
-	temp1 &= 0x80;	/* Get Source layer */
-	temp = temp | temp1;
-	prvLCD_WriteCommandWithData(LCD_VDBE1, temp);
+	prvLCD_BTESize(Width, Height);
+	prvLCD_BTESourceDestinationPoints(SourceX, SourceY, DestinationX, DestinationY);
+	prvLCD_WriteCommandWithData(LCD_BECR1, 0xC2);	/* Move in positive direction with ROP - ROP is S (the source) */
+	prvLCD_WriteCommandWithData(LCD_BECR0, 0x80);	/* Enable BTE in block mode for source and destination */
 
 	/* Give back the semaphore */
 	xSemaphoreGive(xLCDSemaphore);
@@ -665,18 +745,78 @@ void LCD_BTEDisplayImageOfSizeAt(const LCD_Image_TypeDef* Image, uint16_t XPos,
 	/* Try to take the semaphore */
 	xSemaphoreTake(xLCDSemaphore, portMAX_DELAY);
 
-	LCD_BTESize(Image->width, Image->height);							/* Set size */
-	prvLCD_WriteCommandWithData(LCD_BECR1, 0xC0); 		/* Write BTE operation - Use source data (i.e. data we send) */
-	LCD_BTESourceDestinationPoints(0, 0, XPos, YPos);	/* Set destination coordinates */
-	prvLCD_WriteCommandWithData(LCD_BECR0, 0x80);		/* Enable BTE in block mode for source and destination */
-	prvLCD_CheckBusy();
+	prvLCD_BTEStartImageWrite(Image->width, Image->height, XPos, YPos);
 
 	/* Write data to memory */
-	prvLCD_CmdWrite(LCD_MRWC);
-	for (uint32_t i = 0; i < Image->width*Image->height; i++)
+	uint32_t numOfPixels = Image->width*Image->height;
+	if (IS_LCD_DMA_ADDRESS(Image->data))
 	{
-		prvLCD_DataWrite(Image->data[i]);
-		prvLCD_CheckBusy();
+		/* Let the DMA stream the pixels while this task sleeps */
+		if (prvLCD_DMAWritePixels(Image->data, numOfPixels) == SUCCESS)
+			prvLCD_CheckBTEBusy();
+		else
+			prvLCD_WriteCommandWithData(LCD_BECR0, 0x00);	/* Stop the BTE as it will never get the rest of the data */
+	}
+	else
+	{
+		for (uint32_t i = 0; i < numOfPixels; i++)
+		{
+			prvLCD_DataWrite(Image->data[i]);
+			prvLCD_CheckBusy();
+		}
+		prvLCD_CheckBTEBusy();
+	}
+
+	/* Give back the semaphore */
+	xSemaphoreGive(xLCDSemaphore);
+}
+
+/**
+ * @brief	Display a run-length encoded image at a specific location
+ * @param	Image: Pointer to the image to display, created with Software/tools/lcd_image_converter.py
+ * @param	XPos: The x position where the image should be displayed
+ * @param	YPos: The y position where the image should be displayed
+ * @retval	None
+ * @note	The pixels are decoded while they are written so no intermediate buffer is needed.
+ * 			No checks are done to make sure the image will fit on the screen.
+ */
+void LCD_BTEDisplayCompressedImageAt(const LCD_CompressedImage_TypeDef* Image, uint16_t XPos, uint16_t YPos)
+{
+	/* Try to take the semaphore */
+	xSemaphoreTake(xLCDSemaphore, portMAX_DELAY);
+
+	prvLCD_BTEStartImageWrite(Image->width, Image->height, XPos, YPos);
+
+	/* Decode the packets and write the pixels to memory */
+	const uint8_t* pData = Image->data;
+	uint32_t pixelsLeft = Image->width*Image->height;
+	while (pixelsLeft != 0)
+	{
+		uint8_t header = *pData++;
+		uint32_t count = (header & LCD_RLE_LENGTH_MASK) + 1;
+		if (count > pixelsLeft)
+			count = pixelsLeft;
+		pixelsLeft -= count;
+
+		if (header & LCD_RLE_RUN_FLAG)
+		{
+			/* Run packet - one pixel repeated count times */
+			uint16_t pixel = prvLCD_ReadCompressedPixel(&pData, Image->palette);
+			while (count--)
+			{
+				prvLCD_DataWrite(pixel);
+				prvLCD_CheckBusy();
+			}
+		}
+		else
+		{
+			/* Literal packet - count pixels follow */
+			while (count--)
+			{
+				prvLCD_DataWrite(prvLCD_ReadCompressedPixel(&pData, Image->palette));
+				prvLCD_CheckBusy();
+			}
+		}
 	}
 	prvLCD_CheckBTEBusy();
 
@@ -847,9 +987,8 @@ static void prvLCD_InterruptConfig()
 	GPIO_InitStructure.Speed = GPIO_SPEED_FAST;
 	HAL_GPIO_Init(GPIOD, &GPIO_InitStructure);
 
-	/* Configure priority and enable interrupt */
+	/* Configure priority, the interrupt is only enabled while a DMA transfer is running */
 	HAL_NVIC_SetPriority(EXTI15_10_IRQn, configLIBRARY_LOWEST_INTERRUPT_PRIORITY, 0);
-	HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
 }
 
 /**
@@ -866,6 +1005,23 @@ static void prvLCD_PLLInit()
 	vTaskDelay(1 / portTICK_PERIOD_MS);
 }
 
+/**
+ * @brief	Initializes the DMA used for pixel transfers to the LCD
+ * @param	None
+ * @retval	None
+ */
+static void prvLCD_DMAInit()
+{
+	LCD_DMA_CLK_ENABLE();
+	HAL_DMA_Init(&DMA_Handle);
+	DMA_Handle.XferCpltCallback = prvLCD_DMATransferCompleteCallback;
+	DMA_Handle.XferErrorCallback = prvLCD_DMATransferErrorCallback;
+
+	/* Same priority as the WAIT interrupt so they never preempt each other */
+	HAL_NVIC_SetPriority(LCD_DMA_IRQn, configLIBRARY_LOWEST_INTERRUPT_PRIORITY, 0);
+	HAL_NVIC_EnableIRQ(LCD_DMA_IRQn);
+}
+
 /**
  * @brief	Sends a command to the LCD
  * @param	None
@@ -873,7 +1029,7 @@ static void prvLCD_PLLInit()
  */
 static inline void prvLCD_CmdWrite(uint16_t Command)
 {
-	*LCD.LCD_REG = Command;
+	LCD_BUS_WRITE_REG(Command);
 }
 
 /**
@@ -883,7 +1039,7 @@ static inline void prvLCD_CmdWrite(uint16_t Command)
  */
 static inline void prvLCD_DataWrite(uint16_t Data)
 {
-	*LCD.LCD_RAM = Data;
+	LCD_BUS_WRITE_RAM(Data);
 }
 
 /**
@@ -905,7 +1061,7 @@ static inline void prvLCD_WriteCommandWithData(uint8_t Command, uint8_t Data)
  */
 static inline uint16_t prvLCD_StatusRead()
 {
-	return *LCD.LCD_REG;
+	return LCD_BUS_READ_REG();
 }
 
 
@@ -916,7 +1072,7 @@ static inline uint16_t prvLCD_StatusRead()
  */
 static inline uint16_t prvLCD_DataRead()
 {
-	return *LCD.LCD_RAM;
+	return LCD_BUS_READ_RAM();
 }
 
 
@@ -984,6 +1140,228 @@ static void prvLCD_SetActiveWindow(uint16_t XLeft, uint16_t XRight, uint16_t YTo
 	prvLCD_WriteCommandWithData(LCD_VEAW1, temp);
 }
 
+/**
+ * @brief	BTE area size settings
+ * @param	Width: The width
+ * @param	Height: The height
+ * @retval	None
+ * @note	The LCD semaphore must be taken before calling this
+ */
+static void prvLCD_BTESize(uint16_t Width, uint16_t Height)
+{
+	uint16_t temp;
+	temp = Width;
+	/* BTE Width */
+	prvLCD_WriteCommandWithData(LCD_BEWR0, temp);
+	temp = Width >> 8;
+	prvLCD_WriteCommandWithData(LCD_BEWR1, temp);
+
+	temp = Height;
+	/* BTE Height */
+	prvLCD_WriteCommandWithData(LCD_BEHR0, temp);
+	temp = Height >> 8;
+	prvLCD_WriteCommandWithData(LCD_BEHR1, temp);
+}
+
+/**
+ * @brief	Set points for source and destination for BTE
+ * @param	SourceX: X-coordinate for the source
+ * @param	SourceY: Y-coordinate for the source
+ * @param	DestinationX: X-coordinate for the destination
+ * @param	DestinationY: Y-coordinate for the destination
+ * @retval	None
+ * @note	The LCD semaphore must be taken before calling this
+ */
+static void prvLCD_BTESourceDestinationPoints(uint16_t SourceX, uint16_t SourceY, uint16_t DestinationX, uint16_t DestinationY)
+{
+	uint16_t temp, temp1;
+
+	/* Horizontal Source Point of BTE */
+	temp = SourceX;
+	prvLCD_WriteCommandWithData(LCD_HSBE0, temp);
+	temp = SourceX >> 8;
+	prvLCD_WriteCommandWithData(LCD_HSBE1, temp);
+
+	/* Vertical Source Point of BTE */
+	temp = SourceY;
+	prvLCD_WriteCommandWithData(LCD_VSBE0, temp);
+	temp = SourceY >> 8;
+	prvLCD_CmdWrite(LCD_VSBE1);
+	temp1 = prvLCD_DataRead();
+	temp1 &= 0x80;	/* Get Source layer */
+    temp = temp | temp1;
+    prvLCD_WriteCommandWithData(LCD_VSBE1, temp);
+
+	/* Horizontal Destination Point of BTE */
+	temp = DestinationX;
+	prvLCD_WriteCommandWithData(LCD_HDBE0, temp);
+	temp = DestinationX >> 8;
+	prvLCD_WriteCommandWithData(LCD_HDBE1, temp);
+
+    /* Vertical Destination Point of BTE */
+	temp = DestinationY;
+	prvLCD_WriteCommandWithData(LCD_VDBE0, temp);
+	temp = DestinationY >> 8;
+	prvLCD_CmdWrite(LCD_VDBE1);
+	temp1 = prvLCD_DataRead();
+	temp1 &= 0x80;	/* Get Source layer */
+	temp = temp | temp1;
+	prvLCD_WriteCommandWithData(LCD_VDBE1, temp);
+}
+
+/**
+ * @brief	Set up the BTE to write an image and send the memory write command
+ * @param	Width: Width of the image
+ * @param	Height: Height of the image
+ * @param	XPos: The x position where the image should be displayed
+ * @param	YPos: The y position where the image should be displayed
+ * @retval	None
+ * @note	The LCD semaphore must be taken before calling this
+ */
+static void prvLCD_BTEStartImageWrite(uint16_t Width, uint16_t Height, uint16_t XPos, uint16_t YPos)
+{
+	prvLCD_BTESize(Width, Height);							/* Set size */
+	prvLCD_WriteCommandWithData(LCD_BECR1, 0xC0); 			/* Write BTE operation - Use source data (i.e. data we send) */
+	prvLCD_BTESourceDestinationPoints(0, 0, XPos, YPos);	/* Set destination coordinates */
+	prvLCD_WriteCommandWithData(LCD_BECR0, 0x80);			/* Enable BTE in block mode for source and destination */
+	prvLCD_CheckBusy();
+	prvLCD_CmdWrite(LCD_MRWC);
+}
+
+/**
+ * @brief	Read one pixel from compressed image data
+ * @param	ppData: Pointer to the data pointer, will be moved past the pixel
+ * @param	pPalette: The palette of the image or 0 if the pixels are stored as RGB565 values
+ * @retval	The RGB565 value of the pixel
+ */
+static inline uint16_t prvLCD_ReadCompressedPixel(const uint8_t** ppData, const uint16_t* pPalette)
+{
+	const uint8_t* pData = *ppData;
+	if (pPalette != 0)
+	{
+		*ppData = pData + 1;
+		return pPalette[pData[0]];
+	}
+	else
+	{
+		*ppData = pData + 2;
+		return pData[0] | (pData[1] << 8);
+	}
+}
+
+/**
+ * @brief	Write pixel data to the display memory using DMA
+ * @param	pPixels: Pointer to the pixels, must not be located in CCM RAM
+ * @param	NumOfPixels: Number of pixels to write
+ * @retval	SUCCESS: All pixels were written
+ * @retval	ERROR: The transfer failed or timed out
+ * @note	The LCD semaphore must be taken and the memory write command sent before calling this.
+ * 			The data is sent in chunks of LCD_DMA_CHUNK_SIZE pixels with slowed down FSMC write timing.
+ * 			Every chunk is started from the WAIT interrupt so nothing polls the LCD in interrupt
+ * 			context. The calling task sleeps until the transfer is done.
+ */
+static ErrorStatus prvLCD_DMAWritePixels(const uint16_t* pPixels, uint32_t NumOfPixels)
+{
+	if (NumOfPixels == 0)
+		return SUCCESS;
+
+	prvDMASourceAddress = (uint32_t)pPixels;
+	prvDMAPixelsLeft = NumOfPixels;
+	prvDMAErrorOccurred = false;
+
+	/* Forget the WAIT edges from earlier writes and let the WAIT interrupt restart held off chunks */
+	__HAL_GPIO_EXTI_CLEAR_IT(LCD_WAIT_PIN);
+	HAL_NVIC_ClearPendingIRQ(EXTI15_10_IRQn);
+	HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
+
+	/* Pace the writes by stretching the data phase, nothing else is on the bus as the semaphore is taken */
+	uint32_t normalTiming = FSMC_Bank1->BTCR[1];
+	FSMC_Bank1->BTCR[1] = (normalTiming & ~FSMC_BTR1_DATAST) | (LCD_DMA_DATA_SETUP_TIME << 8);
+
+	/* Let the WAIT interrupt start the first chunk, the rest are requested from the DMA interrupt */
+	taskENTER_CRITICAL();
+	prvLCD_DMARequestNextChunk();
+	taskEXIT_CRITICAL();
+
+	/* Wait for the last chunk to be done */
+	ErrorStatus status = SUCCESS;
+	if (xSemaphoreTake(LCD.xDMASemaphore, LCD_DMA_TIMEOUT / portTICK_PERIOD_MS) != pdTRUE || prvDMAErrorOccurred)
+	{
+		/* Something went wrong so stop the transfer */
+		taskENTER_CRITICAL();
+		prvDMAPixelsLeft = 0;
+		prvDMAIsWaitingForLcd = false;
+		taskEXIT_CRITICAL();
+		HAL_DMA_Abort(&DMA_Handle);
+		status = ERROR;
+	}
+
+	HAL_NVIC_DisableIRQ(EXTI15_10_IRQn);
+	FSMC_Bank1->BTCR[1] = normalTiming;
+	return status;
+}
+
+/**
+ * @brief	Ask the WAIT interrupt to start the next chunk
+ * @param	None
+ * @retval	None
+ * @note	Must be called from an interrupt or inside a critical section. If WAIT is already high
+ * 			there will be no edge so the interrupt is triggered by software instead.
+ */
+static void prvLCD_DMARequestNextChunk()
+{
+	prvDMAIsWaitingForLcd = true;
+	if (HAL_GPIO_ReadPin(LCD_WAIT_PORT, LCD_WAIT_PIN) == GPIO_PIN_SET)
+		EXTI->SWIER = LCD_WAIT_PIN;
+}
+
+/**
+ * @brief	Start the DMA transfer of the next chunk
+ * @param	None
+ * @retval	None
+ * @note	Only called from the WAIT interrupt after prvLCD_DMARequestNextChunk
+ */
+static void prvLCD_DMAStartNextChunk()
+{
+	prvDMAIsWaitingForLcd = false;
+
+	uint32_t chunkSize = prvDMAPixelsLeft;
+	if (chunkSize > LCD_DMA_CHUNK_SIZE)
+		chunkSize = LCD_DMA_CHUNK_SIZE;
+
+	uint32_t sourceAddress = prvDMASourceAddress;
+	prvDMASourceAddress += chunkSize * sizeof(uint16_t);
+	prvDMAPixelsLeft -= chunkSize;
+
+	if (HAL_DMA_Start_IT(&DMA_Handle, sourceAddress, (uint32_t)LCD.LCD_RAM, chunkSize) != HAL_OK)
+		prvLCD_DMATransferErrorCallback(&DMA_Handle);
+}
+
+/**
+ * @brief	Called from the DMA interrupt when a chunk has been transferred
+ * @param	hdma: The DMA handle
+ * @retval	None
+ */
+static void prvLCD_DMATransferCompleteCallback(DMA_HandleTypeDef* hdma)
+{
+	if (prvDMAPixelsLeft != 0)
+		prvLCD_DMARequestNextChunk();
+	else
+		xSemaphoreGiveFromISR(LCD.xDMASemaphore, NULL);
+}
+
+/**
+ * @brief	Called from the DMA interrupt when a transfer error occurs
+ * @param	hdma: The DMA handle
+ * @retval	None
+ */
+static void prvLCD_DMATransferErrorCallback(DMA_HandleTypeDef* hdma)
+{
+	prvDMAErrorOccurred = true;
+	prvDMAPixelsLeft = 0;
+	xSemaphoreGiveFromISR(LCD.xDMASemaphore, NULL);
+}
+
 /**
  * @brief	Write a string
  * @param	String: The string to write
@@ -1279,6 +1657,10 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
 	{
 		/* Give the semaphore as the LCD is done processing now */
 		xSemaphoreGiveFromISR(LCD.xWaitSemaphore, NULL);
+
+		/* Continue a DMA transfer that was held off by the LCD */
+		if (prvDMAIsWaitingForLcd)
+			prvLCD_DMAStartNextChunk();
 	}
 	/* LCD Interrupt pin */
 	else if (GPIO_Pin == GPIO_PIN_12)
@@ -1286,3 +1668,13 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
 		/* Do something */
 	}
 }
+
+/**
+  * @brief  This function handles the LCD DMA interrupt request.
+  * @param  None
+  * @retval None
+  */
+void DMA2_Stream0_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&DMA_Handle);
+}
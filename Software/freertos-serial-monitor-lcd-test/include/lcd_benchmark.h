@@ -0,0 +1,45 @@
+/**
+ ******************************************************************************
+ * @file	lcd_benchmark.h
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-13
+ * @brief
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef LCD_BENCHMARK_H_
+#define LCD_BENCHMARK_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32f4xx_hal.h"
+
+#include "lcd_ra8875.h"
+
+/* Defines -------------------------------------------------------------------*/
+#define LCD_BENCHMARK_UART_BAUDRATE		(115200)
+
+/* Typedefs ------------------------------------------------------------------*/
+/* Function prototypes -------------------------------------------------------*/
+void LCD_BENCHMARK_Init();
+void LCD_BENCHMARK_Run(const LCD_Image_TypeDef* Image, const LCD_CompressedImage_TypeDef* CompressedImage);
+
+#endif /* LCD_BENCHMARK_H_ */
@@ -0,0 +1,383 @@
+/**
+ ******************************************************************************
+ * @file	lcd_benchmark.c
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-13
+ * @brief	Measures the throughput of the LCD driver and the simple GUI with the
+ *			DWT cycle counter and prints the results on USART1 (PA9, 115200 8N1).
+ *
+ *			Every result is one line of comma separated values so it can be
+ *			parsed directly from a log of the UART:
+ *				BENCH,<name>,<unit>,<count>,<cycles>,<count per second>
+ *			The run starts with "BENCH_BEGIN,<core clock>" and ends with
+ *			"BENCH_END". Nothing else should use the LCD while it's running.
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "lcd_benchmark.h"
+#include "simple_gui.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define BENCHMARK_UART					(USART1)
+#define BENCHMARK_UART_CLK_ENABLE()		(__USART1_CLK_ENABLE())
+#define BENCHMARK_UART_TX_PIN			(GPIO_PIN_9)
+#define BENCHMARK_UART_PORT				(GPIOA)
+#define BENCHMARK_UART_PORT_CLK_ENABLE()	(__GPIOA_CLK_ENABLE())
+#define BENCHMARK_UART_AF				(GPIO_AF7_USART1)
+#define BENCHMARK_UART_TIMEOUT			(100)
+
+#define TEXT_ITERATIONS					(20)
+#define FILL_ITERATIONS					(10)
+#define IMAGE_ITERATIONS				(20)
+#define BTE_MOVE_ITERATIONS				(20)
+#define BTE_MOVE_WIDTH					(400)
+#define BTE_MOVE_HEIGHT					(240)
+#define TEXT_BOX_ITERATIONS				(100)
+#define GUI_DRAW_ITERATIONS				(10)
+
+#define LCD_NUM_OF_PIXELS				(800 * 480)
+
+/* Private typedefs ----------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static UART_HandleTypeDef UART_Handle = {
+		.Instance			= BENCHMARK_UART,
+		.Init.BaudRate		= LCD_BENCHMARK_UART_BAUDRATE,
+		.Init.WordLength	= UART_WORDLENGTH_8B,
+		.Init.StopBits		= UART_STOPBITS_1,
+		.Init.Parity		= UART_PARITY_NONE,
+		.Init.Mode			= UART_MODE_TX,
+		.Init.HwFlowCtl		= UART_HWCONTROL_NONE,
+		.Init.OverSampling	= UART_OVERSAMPLING_16,
+};
+
+/* 64 characters which fits on one line with the 8x16 font */
+static uint8_t prvTextLine[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz!?";
+
+/* Private function prototypes -----------------------------------------------*/
+static void prvStartCycleCounter();
+static inline uint32_t prvGetCycles();
+
+static void prvBenchmarkText();
+static void prvBenchmarkFill();
+static void prvBenchmarkImageWrite(const LCD_Image_TypeDef* Image);
+static void prvBenchmarkCompressedImageWrite(const LCD_CompressedImage_TypeDef* Image);
+static void prvBenchmarkBTEMove();
+static void prvBenchmarkTextBoxAppend();
+static void prvBenchmarkGUIDraw();
+
+static void prvPrintResult(uint8_t* pName, uint8_t* pUnit, uint32_t Count, uint64_t Cycles);
+static void prvPrintString(uint8_t* pString);
+static void prvPrintNumber(uint64_t Number);
+
+/* Functions -----------------------------------------------------------------*/
+/**
+ * @brief	Initializes the UART used for the results and the DWT cycle counter
+ * @param	None
+ * @retval	None
+ * @note	LCD_Init must have been called before the benchmark is run
+ */
+void LCD_BENCHMARK_Init()
+{
+	BENCHMARK_UART_PORT_CLK_ENABLE();
+	BENCHMARK_UART_CLK_ENABLE();
+
+	GPIO_InitTypeDef GPIO_InitStructure;
+	GPIO_InitStructure.Pin  		= BENCHMARK_UART_TX_PIN;
+	GPIO_InitStructure.Mode  		= GPIO_MODE_AF_PP;
+	GPIO_InitStructure.Pull			= GPIO_PULLUP;
+	GPIO_InitStructure.Speed 		= GPIO_SPEED_HIGH;
+	GPIO_InitStructure.Alternate 	= BENCHMARK_UART_AF;
+	HAL_GPIO_Init(BENCHMARK_UART_PORT, &GPIO_InitStructure);
+
+	HAL_UART_Init(&UART_Handle);
+
+	prvStartCycleCounter();
+}
+
+/**
+ * @brief	Run all benchmarks and print the results
+ * @param	Image: Uncompressed image used for the image write benchmark
+ * @param	CompressedImage: Compressed image used for the image write benchmark, can be 0 to skip it
+ * @retval	None
+ * @note	The GUI benchmark draws the buttons that have been added with GUI_AddButton
+ */
+void LCD_BENCHMARK_Run(const LCD_Image_TypeDef* Image, const LCD_CompressedImage_TypeDef* CompressedImage)
+{
+	prvPrintString("BENCH_BEGIN,");
+	prvPrintNumber(SystemCoreClock);
+	prvPrintString("\r\n");
+
+	prvBenchmarkText();
+	prvBenchmarkFill();
+	if (Image != 0)
+		prvBenchmarkImageWrite(Image);
+	if (CompressedImage != 0)
+		prvBenchmarkCompressedImageWrite(CompressedImage);
+	prvBenchmarkBTEMove();
+	prvBenchmarkTextBoxAppend();
+	prvBenchmarkGUIDraw();
+
+	prvPrintString("BENCH_END\r\n");
+}
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief	Enable and reset the DWT cycle counter
+ * @param	None
+ * @retval	None
+ */
+static void prvStartCycleCounter()
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief	Get the current value of the cycle counter
+ * @param	None
+ * @retval	The number of cycles, wraps after about 25 s at 168 MHz so only short intervals can be timed
+ */
+static inline uint32_t prvGetCycles()
+{
+	return DWT->CYCCNT;
+}
+
+/**
+ * @brief	Characters per second written with LCD_WriteString
+ * @param	None
+ * @retval	None
+ */
+static void prvBenchmarkText()
+{
+	LCD_SetBackgroundColor(LCD_COLOR_BLACK);
+	LCD_ClearFullWindow();
+	LCD_WaitUntilIdle();
+	LCD_SetForegroundColor(LCD_COLOR_WHITE);
+
+	uint64_t cycles = 0;
+	for (uint32_t i = 0; i < TEXT_ITERATIONS; i++)
+	{
+		uint32_t startCycles = prvGetCycles();
+		LCD_SetTextWritePosition(0, i * 16);
+		LCD_WriteString(prvTextLine, NOT_TRANSPARENT, ENLARGE_1X);
+		cycles += prvGetCycles() - startCycles;
+	}
+
+	prvPrintResult("text", "chars", TEXT_ITERATIONS * (sizeof(prvTextLine) - 1), cycles);
+}
+
+/**
+ * @brief	Pixels per second when clearing the full window
+ * @param	None
+ * @retval	None
+ */
+static void prvBenchmarkFill()
+{
+	uint64_t cycles = 0;
+	for (uint32_t i = 0; i < FILL_ITERATIONS; i++)
+	{
+		uint32_t startCycles = prvGetCycles();
+		LCD_SetBackgroundColor((i & 1) ? LCD_COLOR_BLUE : LCD_COLOR_BLACK);
+		LCD_ClearFullWindow();
+		LCD_WaitUntilIdle();
+		cycles += prvGetCycles() - startCycles;
+	}
+
+	prvPrintResult("fill", "pixels", FILL_ITERATIONS * LCD_NUM_OF_PIXELS, cycles);
+}
+
+/**
+ * @brief	Pixels per second when writing an uncompressed image from the MCU through the BTE
+ * @param	Image: The image
+ * @retval	None
+ */
+static void prvBenchmarkImageWrite(const LCD_Image_TypeDef* Image)
+{
+	uint64_t cycles = 0;
+	for (uint32_t i = 0; i < IMAGE_ITERATIONS; i++)
+	{
+		uint32_t startCycles = prvGetCycles();
+		LCD_BTEDisplayImageOfSizeAt(Image, 0, 0);
+		LCD_WaitUntilIdle();
+		cycles += prvGetCycles() - startCycles;
+	}
+
+	prvPrintResult("image_write", "pixels", IMAGE_ITERATIONS * Image->width * Image->height, cycles);
+}
+
+/**
+ * @brief	Pixels per second when decoding a compressed image and writing it through the BTE
+ * @param	Image: The image
+ * @retval	None
+ */
+static void prvBenchmarkCompressedImageWrite(const LCD_CompressedImage_TypeDef* Image)
+{
+	uint64_t cycles = 0;
+	for (uint32_t i = 0; i < IMAGE_ITERATIONS; i++)
+	{
+		uint32_t startCycles = prvGetCycles();
+		LCD_BTEDisplayCompressedImageAt(Image, 0, 0);
+		LCD_WaitUntilIdle();
+		cycles += prvGetCycles() - startCycles;
+	}
+
+	prvPrintResult("image_write_compressed", "pixels", IMAGE_ITERATIONS * Image->width * Image->height, cycles);
+}
+
+/**
+ * @brief	Pixels per second when the BTE copies a block inside the display memory
+ * @param	None
+ * @retval	None
+ * @note	The block is moved back and forth between the upper left and the lower right quarter
+ */
+static void prvBenchmarkBTEMove()
+{
+	uint64_t cycles = 0;
+	for (uint32_t i = 0; i < BTE_MOVE_ITERATIONS; i++)
+	{
+		uint32_t startCycles = prvGetCycles();
+		if (i & 1)
+			LCD_BTEMove(800 - BTE_MOVE_WIDTH, 480 - BTE_MOVE_HEIGHT, 0, 0, BTE_MOVE_WIDTH, BTE_MOVE_HEIGHT);
+		else
+			LCD_BTEMove(0, 0, 800 - BTE_MOVE_WIDTH, 480 - BTE_MOVE_HEIGHT, BTE_MOVE_WIDTH, BTE_MOVE_HEIGHT);
+		LCD_WaitUntilIdle();
+		cycles += prvGetCycles() - startCycles;
+	}
+
+	prvPrintResult("bte_move", "pixels", BTE_MOVE_ITERATIONS * BTE_MOVE_WIDTH * BTE_MOVE_HEIGHT, cycles);
+}
+
+/**
+ * @brief	Appends per second to the main text box, every append is 10 characters
+ * @param	None
+ * @retval	None
+ */
+static void prvBenchmarkTextBoxAppend()
+{
+	GUI_TextBox_TypeDef textBox;
+	textBox.object.id = guiConfigMAIN_TEXT_BOX_ID;
+	textBox.object.xPos = 0;
+	textBox.object.yPos = 50;
+	textBox.object.width = 650;
+	textBox.object.height = 430;
+	textBox.object.layer = LAYER0;
+	textBox.object.hidden = NOT_HIDDEN;
+	textBox.object.border = BORDER_TOP | BORDER_RIGHT;
+	textBox.object.borderThickness = 1;
+	textBox.object.borderColor = LCD_COLOR_WHITE;
+	textBox.textSize = ENLARGE_1X;
+	textBox.xWritePos = 0;
+	textBox.yWritePos = 0;
+	GUI_AddTextBox(&textBox);
+
+	LCD_SetBackgroundColor(LCD_COLOR_BLACK);
+	GUI_ClearTextBox(guiConfigMAIN_TEXT_BOX_ID);
+	LCD_WaitUntilIdle();
+
+	uint64_t cycles = 0;
+	for (uint32_t i = 0; i < TEXT_BOX_ITERATIONS; i++)
+	{
+		uint32_t startCycles = prvGetCycles();
+		GUI_WriteStringInTextBox(guiConfigMAIN_TEXT_BOX_ID, "0123456789");
+		cycles += prvGetCycles() - startCycles;
+	}
+
+	prvPrintResult("textbox_append", "appends", TEXT_BOX_ITERATIONS, cycles);
+}
+
+/**
+ * @brief	Full redraws per second of all buttons
+ * @param	None
+ * @retval	None
+ */
+static void prvBenchmarkGUIDraw()
+{
+	uint64_t cycles = 0;
+	for (uint32_t i = 0; i < GUI_DRAW_ITERATIONS; i++)
+	{
+		uint32_t startCycles = prvGetCycles();
+		GUI_DrawAllButtons();
+		LCD_WaitUntilIdle();
+		cycles += prvGetCycles() - startCycles;
+	}
+
+	prvPrintResult("gui_draw_buttons", "draws", GUI_DRAW_ITERATIONS, cycles);
+}
+
+/**
+ * @brief	Print one result line
+ * @param	pName: Name of the benchmark
+ * @param	pUnit: What is counted
+ * @param	Count: Number of units processed
+ * @param	Cycles: Number of cycles it took
+ * @retval	None
+ */
+static void prvPrintResult(uint8_t* pName, uint8_t* pUnit, uint32_t Count, uint64_t Cycles)
+{
+	uint32_t perSecond = 0;
+	if (Cycles != 0)
+		perSecond = (uint32_t)(((uint64_t)Count * SystemCoreClock) / Cycles);
+
+	prvPrintString("BENCH,");
+	prvPrintString(pName);
+	prvPrintString(",");
+	prvPrintString(pUnit);
+	prvPrintString(",");
+	prvPrintNumber(Count);
+	prvPrintString(",");
+	prvPrintNumber(Cycles);
+	prvPrintString(",");
+	prvPrintNumber(perSecond);
+	prvPrintString("\r\n");
+}
+
+/**
+ * @brief	Print a string on the UART
+ * @param	pString: The null terminated string
+ * @retval	None
+ */
+static void prvPrintString(uint8_t* pString)
+{
+	uint16_t length = 0;
+	while (pString[length] != '\0')
+		length++;
+
+	HAL_UART_Transmit(&UART_Handle, pString, length, BENCHMARK_UART_TIMEOUT);
+}
+
+/**
+ * @brief	Print an unsigned number in decimal on the UART
+ * @param	Number: The number
+ * @retval	None
+ */
+static void prvPrintNumber(uint64_t Number)
+{
+	uint8_t buffer[21];
+	uint32_t index = sizeof(buffer) - 1;
+	buffer[index] = '\0';
+	do
+	{
+		buffer[--index] = '0' + Number % 10;
+		Number /= 10;
+	} while (Number != 0);
+
+	prvPrintString(&buffer[index]);
+}
@@ -14,6 +14,7 @@
 
 #include "lcd_ra8875.h"
 #include "simple_gui.h"
+#include "lcd_benchmark.h"
 
 #include "test_image.c"
 #include "golden_gate_bridge_image.c"
@@ -23,6 +24,10 @@
 #define mainLCD_TASK_PRIORITY				(tskIDLE_PRIORITY + 1)
 #define mainLCD_TASK2_PRIORITY				(tskIDLE_PRIORITY + 1)
 #define mainCLOCK_TASK_PRIORITY				(tskIDLE_PRIORITY + 1)
+#define mainBENCHMARK_TASK_PRIORITY			(tskIDLE_PRIORITY + 1)
+
+/* Set to 1 to run the LCD benchmark instead of the demo tasks, the results are printed on USART1 */
+#define mainRUN_BENCHMARK					0
 
 /* ----- LED definitions --------------------------------------------------- */
 /* LEDs on STM32F4 Discovery Board */
@@ -69,6 +74,7 @@ static void prvBlinkTask(void *pvParameters);
 static void prvLcdTask(void *pvParameters);
 static void prvLcdTask2(void *pvParameters);
 static void prvClockTask(void *pvParameters);
+static void prvBenchmarkTask(void *pvParameters);
 
 /* ----- Main -------------------------------------------------------------- */
 int main(int argc, char* argv[])
@@ -80,6 +86,14 @@ int main(int argc, char* argv[])
 	 */
 
 	/* Create the tasks */
+#if mainRUN_BENCHMARK
+	xTaskCreate(prvBenchmarkTask,				/* Pointer to the task entry function */
+				"Benchmark",					/* Name for the task */
+				configMINIMAL_STACK_SIZE * 2,	/* The size of the stack */
+				NULL,							/* Pointer to parameters for the task */
+				mainBENCHMARK_TASK_PRIORITY,	/* The priority for the task */
+				NULL);							/* Handle for the created task */
+#else
 #if 1
 	xTaskCreate(prvBlinkTask,					/* Pointer to the task entry function */
 				"Blink",						/* Name for the task */
@@ -112,6 +126,7 @@ int main(int argc, char* argv[])
 				mainCLOCK_TASK_PRIORITY,		/* The priority for the task */
 				NULL);							/* Handle for the created task */
 #endif
+#endif /* mainRUN_BENCHMARK */
 
 	/* Start the scheduler */
 	vTaskStartScheduler();
@@ -307,7 +322,6 @@ void guiTest()
 }
 
 const LCD_Image_TypeDef testImage = {image_data_test, 30, 29};
-const LCD_Image_TypeDef goldengatebridge = {image_data_goldengatebridge, 800, 480};
 
 static void prvLcdTask(void *pvParameters)
 {
@@ -333,7 +347,7 @@ static void prvLcdTask(void *pvParameters)
 //		vTaskDelayUntil(&xNextWakeTime, 4000 / portTICK_PERIOD_MS);
 		guiTest();
 //		LCD_TestBTE(&testImage, 30, 30);
-//		LCD_TestBTE(&goldengatebridge, 0, 0);
+//		LCD_BTEDisplayCompressedImageAt(&goldengatebridge, 0, 0);
 
 //		vTaskDelayUntil(&xNextWakeTime, 4000 / portTICK_PERIOD_MS);
 	}
@@ -491,6 +505,23 @@ static void prvClockTask(void *pvParameters)
 
 /*-----------------------------------------------------------*/
 
+static void prvBenchmarkTask(void *pvParameters)
+{
+	LCD_Init();
+	LCD_BENCHMARK_Init();
+
+	/* The GUI benchmark redraws the same buttons as the demo */
+	guiTestInit();
+
+	while (1)
+	{
+		LCD_BENCHMARK_Run(&testImage, &goldengatebridge);
+		vTaskDelay(5000 / portTICK_PERIOD_MS);
+	}
+}
+
+/*-----------------------------------------------------------*/
+
 void vApplicationMallocFailedHook(void)
 {
 	/*
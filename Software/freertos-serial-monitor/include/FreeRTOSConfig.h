@@ -95,7 +95,12 @@
 #define configTICK_RATE_HZ				( ( TickType_t ) 1000 )
 #define configMAX_PRIORITIES			( 5 )
 #define configMINIMAL_STACK_SIZE		( ( unsigned short ) 130 )
-#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 32 * 1024 ) )
+/* The text boxes that read from memory get their buffers from a pool in
+simple_gui.c instead of the heap, which took the heap down from 32K to 24K.
+heap_1 is used so nothing on the heap is ever freed, a text box that doesn't fit
+in the pool keeps its heap buffer for good. Check the text pool lines on the
+system page before adding text boxes or making the heap smaller. */
+#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 24 * 1024 ) )
 #define configMAX_TASK_NAME_LEN			( 10 )
 #define configUSE_TRACE_FACILITY		1
 #define configUSE_16_BIT_TICKS			0
@@ -128,6 +133,7 @@ to exclude the API function. */
 #define INCLUDE_vTaskSuspend			1
 #define INCLUDE_vTaskDelayUntil			1
 #define INCLUDE_vTaskDelay				1
+#define INCLUDE_xTimerPendFunctionCall	1
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -0,0 +1,70 @@
+/**
+ ******************************************************************************
+ * @file	adc_filter.h
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-18
+ * @brief
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ADC_FILTER_H_
+#define ADC_FILTER_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+
+/* Defines -------------------------------------------------------------------*/
+#define ADC_FILTER_MAX_BLOCK_SIZE		(256)	/* Larger blocks are filtered in parts of this size */
+#define ADC_FILTER_NUM_OF_TAPS			(32)	/* Length of the low-pass FIR, must be even */
+#define ADC_FILTER_AVERAGE_LENGTH		(16)	/* Length of the moving average, must be a power of 2 */
+
+/* Typedefs ------------------------------------------------------------------*/
+typedef enum
+{
+	ADCFilterType_None,
+	ADCFilterType_MovingAverage,
+	ADCFilterType_LowPass,
+	ADCFilterType_Notch50Hz,
+	ADCFilterType_Notch60Hz,
+} ADCFilterType;
+
+typedef struct
+{
+	ADCFilterType type;
+
+	/* Moving average */
+	int16_t averageHistory[ADC_FILTER_AVERAGE_LENGTH];
+	uint32_t averageIndex;
+	int32_t averageSum;
+
+	/* Low-pass FIR, the coefficients are stored reversed in Q15 */
+	int16_t firCoefficients[ADC_FILTER_NUM_OF_TAPS];
+	int16_t firState[ADC_FILTER_NUM_OF_TAPS - 1 + ADC_FILTER_MAX_BLOCK_SIZE];
+
+	/* Notch biquad in direct form I, coefficients b0, b1, b2, a1, a2 in Q30 */
+	int32_t biquadCoefficients[5];
+	int32_t biquadState[4];			/* x[n-1], x[n-2], y[n-1], y[n-2] with 13 extra fractional bits */
+} ADCFilter;
+
+/* Function prototypes -------------------------------------------------------*/
+void adcFilterInit(ADCFilter* pFilter, ADCFilterType Type, uint32_t SampleRate, uint32_t Cutoff);
+void adcFilterProcess(ADCFilter* pFilter, int16_t* pSamples, uint32_t NumOfSamples);
+
+#endif /* ADC_FILTER_H_ */
@@ -0,0 +1,113 @@
+/**
+ ******************************************************************************
+ * @file	adc_scope.h
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-18
+ * @brief
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ADC_SCOPE_H_
+#define ADC_SCOPE_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+
+#include <stdbool.h>
+
+/* Defines -------------------------------------------------------------------*/
+#define ADC_SCOPE_FRAME_SIZE		(2048)	/* Samples in a frame, must be a power of 2 */
+#define ADC_SCOPE_NUM_OF_COLUMNS	(600)	/* Pixel columns the frame is decimated to */
+
+/* Typedefs ------------------------------------------------------------------*/
+typedef enum
+{
+	ADCScopeMode_Auto,				/* Like normal but a frame is forced if there is no trigger for a while */
+	ADCScopeMode_Normal,			/* A new frame is captured for every trigger */
+	ADCScopeMode_Single,			/* Stops after the first triggered frame */
+} ADCScopeMode;
+
+typedef enum
+{
+	ADCScopeEdge_Rising,
+	ADCScopeEdge_Falling,
+} ADCScopeEdge;
+
+typedef enum
+{
+	ADCScopeState_Stopped,
+	ADCScopeState_Filling,			/* Collecting the pre-trigger samples */
+	ADCScopeState_Armed,			/* Waiting for a trigger */
+	ADCScopeState_Capturing,		/* Collecting the samples after the trigger */
+	ADCScopeState_Done,				/* A single shot frame has been captured */
+} ADCScopeState;
+
+typedef struct
+{
+	ADCScopeMode mode;
+	ADCScopeEdge edge;
+	int16_t level;
+	uint16_t hysteresis;			/* The signal has to pass this far on the other side of the level to arm the trigger */
+	uint32_t holdoff;				/* Min number of samples from one trigger to the next */
+	uint32_t preTriggerDepth;		/* Samples kept before the trigger, less than ADC_SCOPE_FRAME_SIZE */
+	uint32_t autoTimeout;			/* Samples without a trigger before a frame is forced in auto mode */
+} ADCScopeSettings;
+
+/* A captured frame reduced to the min and max of the samples in every column */
+typedef struct
+{
+	int16_t min[ADC_SCOPE_NUM_OF_COLUMNS];
+	int16_t max[ADC_SCOPE_NUM_OF_COLUMNS];
+	uint32_t triggerColumn;
+	bool triggered;					/* false if the frame was forced in auto mode */
+	uint32_t frameNumber;
+} ADCScopeFrame;
+
+typedef struct
+{
+	ADCScopeSettings settings;
+	volatile ADCScopeState state;
+
+	/* The last ADC_SCOPE_FRAME_SIZE samples */
+	int16_t ring[ADC_SCOPE_FRAME_SIZE];
+	uint32_t writeIndex;
+
+	uint32_t nextSampleNumber;		/* Used to detect samples that were lost between two blocks */
+	uint32_t numOfSamplesSinceArm;
+	uint32_t numOfSamplesLeft;		/* Samples left to capture after the trigger */
+	bool edgeIsArmed;				/* The signal has been on the other side of the hysteresis */
+	bool hasTriggered;
+	uint32_t lastTriggerSampleNumber;
+	bool forcedTrigger;
+
+	ADCScopeFrame frame;
+	volatile bool frameIsNew;		/* Set when a frame has been captured, cleared when it has been drawn */
+} ADCScope;
+
+/* Function prototypes -------------------------------------------------------*/
+void adcScopeReset(ADCScope* pScope);
+void adcScopeStart(ADCScope* pScope, const ADCScopeSettings* pSettings);
+void adcScopeStop(ADCScope* pScope);
+ADCScopeState adcScopeGetState(ADCScope* pScope);
+void adcScopeAddBlock(ADCScope* pScope, const int16_t* pSamples, uint32_t NumOfSamples, uint32_t FirstSampleNumber);
+bool adcScopeGetFrame(ADCScope* pScope, const ADCScopeFrame** ppFrame);
+void adcScopeReleaseFrame(ADCScope* pScope);
+
+#endif /* ADC_SCOPE_H_ */
@@ -0,0 +1,100 @@
+/**
+ ******************************************************************************
+ * @file	adc_spectrum.h
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-18
+ * @brief
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ADC_SPECTRUM_H_
+#define ADC_SPECTRUM_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+
+#include <stdbool.h>
+
+/* Defines -------------------------------------------------------------------*/
+#define ADC_SPECTRUM_MIN_SIZE			(256)	/* Transform sizes must be powers of 2 in this range */
+#define ADC_SPECTRUM_MAX_SIZE			(2048)
+#define ADC_SPECTRUM_MAX_NUM_OF_BINS	(ADC_SPECTRUM_MAX_SIZE / 2)
+#define ADC_SPECTRUM_MAX_NUM_OF_AVERAGES	(64)	/* Must be a power of 2 */
+#define ADC_SPECTRUM_MIN_LEVEL			(-1600)	/* 0.1 dBFS, used for bins without any energy */
+
+/* Typedefs ------------------------------------------------------------------*/
+typedef enum
+{
+	ADCSpectrumState_Stopped,
+	ADCSpectrumState_Collecting,	/* Windowing the incoming samples into the transform buffer */
+	ADCSpectrumState_Transforming,	/* One step is done for every call to adcSpectrumProcess */
+} ADCSpectrumState;
+
+typedef struct
+{
+	uint32_t size;					/* Number of samples in a transform */
+	uint32_t numOfAverages;			/* Transforms the power is averaged over, must be a power of 2 */
+} ADCSpectrumSettings;
+
+typedef struct
+{
+	int16_t level[ADC_SPECTRUM_MAX_NUM_OF_BINS];	/* 0.1 dBFS, a full scale sine in a single bin is 0 */
+	uint32_t numOfBins;
+	uint32_t binWidth;				/* mHz */
+	uint32_t peakBin;
+	uint32_t peakFrequency;			/* mHz, interpolated between the bins around the peak */
+	int16_t peakLevel;				/* 0.1 dBFS */
+	uint32_t numOfAverages;			/* Transforms that have been averaged into this frame */
+	uint32_t frameNumber;
+} ADCSpectrumFrame;
+
+typedef struct
+{
+	ADCSpectrumSettings settings;
+	volatile ADCSpectrumState state;
+	uint32_t log2Size;
+
+	uint32_t sampleRate;			/* Of the samples in the transform buffer */
+	uint32_t nextSampleNumber;		/* Used to detect samples that were lost between two blocks */
+	uint32_t numOfCollectedSamples;
+	uint32_t step;
+
+	/* size / 2 complex values with the real and imaginary part interleaved, each transform is scaled by 2 / size */
+	int32_t buffer[ADC_SPECTRUM_MAX_SIZE];
+	uint64_t power[ADC_SPECTRUM_MAX_NUM_OF_BINS];
+	uint32_t numOfTransforms;
+
+	int32_t sine[ADC_SPECTRUM_MAX_SIZE / 4 + 1];	/* Quarter of a sine period in Q31 */
+
+	ADCSpectrumFrame frame;
+	volatile bool frameIsNew;		/* Set when a frame has been calculated, cleared when it has been drawn */
+} ADCSpectrum;
+
+/* Function prototypes -------------------------------------------------------*/
+void adcSpectrumReset(ADCSpectrum* pSpectrum);
+ErrorStatus adcSpectrumStart(ADCSpectrum* pSpectrum, const ADCSpectrumSettings* pSettings);
+void adcSpectrumStop(ADCSpectrum* pSpectrum);
+ADCSpectrumState adcSpectrumGetState(ADCSpectrum* pSpectrum);
+void adcSpectrumAddBlock(ADCSpectrum* pSpectrum, const int16_t* pSamples, uint32_t NumOfSamples, uint32_t FirstSampleNumber, uint32_t SampleRate);
+void adcSpectrumProcess(ADCSpectrum* pSpectrum);
+bool adcSpectrumGetFrame(ADCSpectrum* pSpectrum, const ADCSpectrumFrame** ppFrame);
+void adcSpectrumReleaseFrame(ADCSpectrum* pSpectrum);
+
+#endif /* ADC_SPECTRUM_H_ */
@@ -0,0 +1,79 @@
+/**
+ ******************************************************************************
+ * @file	adc_stats.h
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-18
+ * @brief
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ADC_STATS_H_
+#define ADC_STATS_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+
+/* Defines -------------------------------------------------------------------*/
+#define ADC_STATS_WINDOW_SIZE	(8)		/* Number of acquisition blocks in the sliding window */
+
+/* Typedefs ------------------------------------------------------------------*/
+/*
+ * Running sums of a number of samples. The squares of full scale samples fill the 64 bit sum after 2^34 samples,
+ * about 47 hours at 100 kS/s, so the total mean and RMS are restarted before that happens.
+ */
+typedef struct
+{
+	int16_t min;
+	int16_t max;
+	int64_t sum;
+	uint64_t sumOfSquares;
+	uint64_t numOfSamples;
+} ADCStatsSums;
+
+/* All values are in ADC counts, rounded to the closest count */
+typedef struct
+{
+	int16_t min;
+	int16_t max;
+	uint16_t peakToPeak;
+	int16_t mean;
+	uint16_t rms;
+	uint64_t numOfSamples;
+} ADCStatsResult;
+
+typedef struct
+{
+	ADCStatsSums total;
+
+	/* The sums of the last blocks, the window sums are updated by adding the new block and removing the oldest */
+	ADCStatsSums blocks[ADC_STATS_WINDOW_SIZE];
+	uint32_t nextBlockIndex;
+	uint32_t numOfBlocks;
+	ADCStatsSums window;
+
+	ADCStatsResult totalResult;
+	ADCStatsResult windowResult;
+} ADCStats;
+
+/* Function prototypes -------------------------------------------------------*/
+void adcStatsReset(ADCStats* pStats);
+void adcStatsAddBlock(ADCStats* pStats, const int16_t* pSamples, uint32_t NumOfSamples);
+
+#endif /* ADC_STATS_H_ */
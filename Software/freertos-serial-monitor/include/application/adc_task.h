@@ -32,14 +32,65 @@
 #include "FreeRTOS.h"
 #include "task.h"
 
+#include "adc_stats.h"
+#include "adc_scope.h"
+#include "adc_filter.h"
+#include "adc_spectrum.h"
+
 #include <stdbool.h>
 
 /* Defines -------------------------------------------------------------------*/
+#define ADC_DEFAULT_SAMPLE_RATE		(1000)
+
 /* Typedefs ------------------------------------------------------------------*/
+/* Written to the FLASH in front of every block of samples */
+typedef struct
+{
+	uint32_t timestamp;				/* Tick count when the last sample in the block was converted */
+	uint32_t firstSampleNumber;		/* Number of the first sample in the block counted from the start of the acquisition */
+	uint32_t sampleRate;			/* Hz */
+	uint16_t numOfSamples;
+	uint8_t channel;				/* Any value of MAX1301DiffChannel */
+	uint8_t filter;					/* Any value of ADCFilterType, the samples are saved after the filter */
+} ADCBlockHeader;
+
+typedef struct
+{
+	uint32_t sampleRate;			/* The rate the timer is set to, in Hz */
+	uint32_t achievedSampleRate;	/* Measured over the last second, in Hz */
+	uint32_t jitter;				/* Peak-to-peak variation of the time between two blocks over the last second, in ns. The
+									   conversions are started by the timer hardware so this is only the interrupt latency */
+	uint32_t numOfOverruns;			/* Conversions lost because of a DMA error */
+	uint32_t numOfDroppedSamples;	/* Samples lost because the task couldn't keep up */
+	uint32_t numOfSavedBlocks;
+	uint32_t numOfUnsavedBlocks;	/* Blocks that didn't fit in the FLASH */
+	uint32_t filterCycles;			/* Average CPU cycles per sample spent in the filter over the last second */
+} ADCAcquisitionStatus;
 
 /* Function prototypes -------------------------------------------------------*/
 void adcTask(void *pvParameters);
 bool adcIsDoneInitializing();
 
+ErrorStatus adcStartAcquisition(uint32_t SampleRate);
+void adcStopAcquisition();
+bool adcIsAcquiring();
+int16_t adcGetLatestSample();
+void adcGetStatus(ADCAcquisitionStatus* pStatus);
+void adcGetStatistics(ADCStatsResult* pTotal, ADCStatsResult* pWindow);
+void adcSetFilter(ADCFilterType Type, uint32_t Cutoff);
+ADCFilterType adcGetFilter();
+
+void adcStartScope(const ADCScopeSettings* pSettings);
+void adcStopScope();
+ADCScopeState adcGetScopeState();
+bool adcGetScopeFrame(const ADCScopeFrame** ppFrame);
+void adcReleaseScopeFrame();
+
+void adcStartSpectrum(const ADCSpectrumSettings* pSettings);
+void adcStopSpectrum();
+bool adcGetSpectrumFrame(const ADCSpectrumFrame** ppFrame);
+void adcReleaseSpectrumFrame();
+void adcClearFlash();
+
 
 #endif /* ADC_TASK_H_ */
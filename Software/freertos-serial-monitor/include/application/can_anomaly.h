@@ -0,0 +1,118 @@
+/**
+ ******************************************************************************
+ * @file	can_anomaly.h
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-12
+ * @brief
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef CAN_ANOMALY_H_
+#define CAN_ANOMALY_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "messages.h"
+
+#include <stdbool.h>
+
+/* Defines -------------------------------------------------------------------*/
+#define CAN_ANOMALY_TABLE_SIZE			(128)	/* Max number of IDs in the baseline, must be a power of 2 */
+#define CAN_ANOMALY_MAX_PROBES			(8)		/* Max number of table slots checked for every message */
+#define CAN_ANOMALY_ALERT_BUFFER_SIZE	(16)	/* Must be a power of 2 */
+/* Every queued alert string plus the one the LCD task is showing must stay valid */
+#define CAN_ANOMALY_NUM_OF_MESSAGES		(LCD_EVENT_QUEUE_SIZE + 1)
+#define CAN_ANOMALY_MESSAGE_SIZE		(48)
+
+#define CAN_ANOMALY_LEARNING_TIME		(10000)	/* ms of traffic used to build the baseline */
+#define CAN_ANOMALY_PERIOD_DIVISOR		(2)		/* Alert when a message arrives faster than learned period / divisor */
+#define CAN_ANOMALY_VARIABLE_DLC		(0xFF)
+
+/* Typedefs ------------------------------------------------------------------*/
+typedef enum
+{
+	CANAnomalyState_Disabled,
+	CANAnomalyState_Learning,
+	CANAnomalyState_Detecting,
+} CANAnomalyState;
+
+typedef enum
+{
+	CANAnomalyType_UnknownId,			/* An ID that was not seen during learning */
+	CANAnomalyType_TooFast,				/* A periodic ID arrived much faster than its learned period */
+	CANAnomalyType_WrongDlc,			/* The DLC differs from the learned DLC */
+	CANAnomalyType_DataOutOfRange,		/* A data byte is outside of its learned range */
+	CANAnomalyType_TableFull,			/* Too many IDs during learning, the baseline is incomplete */
+} CANAnomalyType;
+
+typedef struct
+{
+	TickType_t timestamp;
+	uint32_t id;
+	CANAnomalyType type;
+	uint8_t byteIndex;					/* Only valid for CANAnomalyType_DataOutOfRange */
+	uint8_t value;						/* The DLC or data byte that caused the alert */
+} CANAnomalyAlert;
+
+typedef struct
+{
+	uint32_t id;
+	TickType_t lastTimestamp;
+	TickType_t minPeriod;				/* Shortest time between two messages seen during learning */
+	bool used;
+	uint8_t dlc;						/* CAN_ANOMALY_VARIABLE_DLC if it changed during learning */
+	uint8_t minData[8];
+	uint8_t maxData[8];
+} CANAnomalyEntry;
+
+typedef struct
+{
+	uint8_t* name;						/* Name of the channel used in the alert messages */
+	volatile CANAnomalyState state;
+	TickType_t learningEndTime;
+	bool tableFullReported;
+
+	CANAnomalyEntry table[CAN_ANOMALY_TABLE_SIZE];
+
+	/* Single producer (CAN RX interrupt), single consumer (channel task) ring buffer */
+	CANAnomalyAlert alerts[CAN_ANOMALY_ALERT_BUFFER_SIZE];
+	volatile uint32_t alertWriteIndex;
+	volatile uint32_t alertReadIndex;
+	uint32_t numOfAlerts;
+	uint32_t numOfDroppedAlerts;
+
+	uint8_t messages[CAN_ANOMALY_NUM_OF_MESSAGES][CAN_ANOMALY_MESSAGE_SIZE];
+	uint32_t nextMessageIndex;
+} CANAnomalyDetector;
+
+/* Function prototypes -------------------------------------------------------*/
+void canAnomalyInit(CANAnomalyDetector* pDetector, uint8_t* pName);
+void canAnomalyStartLearning(CANAnomalyDetector* pDetector, uint32_t LearningTime);
+void canAnomalyStop(CANAnomalyDetector* pDetector);
+CANAnomalyState canAnomalyGetState(CANAnomalyDetector* pDetector);
+uint32_t canAnomalyGetNumOfAlerts(CANAnomalyDetector* pDetector);
+
+void canAnomalyCheckMessageFromISR(CANAnomalyDetector* pDetector, uint32_t Id, uint8_t Dlc, uint8_t* pData, TickType_t Timestamp);
+bool canAnomalyGetAlert(CANAnomalyDetector* pDetector, CANAnomalyAlert* pAlert);
+void canAnomalyReportAlerts(CANAnomalyDetector* pDetector, uint32_t MaxNumOfAlerts);
+
+#endif /* CAN_ANOMALY_H_ */
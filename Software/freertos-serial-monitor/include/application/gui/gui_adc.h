@@ -31,7 +31,7 @@
 #include "FreeRTOS.h"
 #include "stm32f4xx_hal.h"
 
-//#include "adc_task.h"
+#include "adc_task.h"
 #include "lcd_task.h"
 #include "simple_gui.h"
 #include "simple_gui_config.h"
@@ -41,7 +41,15 @@
 /* Function prototypes -------------------------------------------------------*/
 void guiAdcManageMainTextBox(bool ShouldRefresh);
 void guiAdcTopButtonCallback(GUITouchEvent Event, uint32_t ButtonId);
+void guiAdcEnableButtonCallback(GUITouchEvent Event, uint32_t ButtonId);
+void guiAdcSampleRateButtonCallback(GUITouchEvent Event, uint32_t ButtonId);
+void guiAdcViewButtonCallback(GUITouchEvent Event, uint32_t ButtonId);
+void guiAdcScopeButtonCallback(GUITouchEvent Event, uint32_t ButtonId);
+void guiAdcFilterButtonCallback(GUITouchEvent Event, uint32_t ButtonId);
+void guiAdcSpectrumButtonCallback(GUITouchEvent Event, uint32_t ButtonId);
+void guiAdcSidebarForwardBackwardsButtonsCallback(GUITouchEvent Event, uint32_t ButtonId);
 void guiAdcInitGuiElements();
+void guiAdcInitSidebarGuiElements();
 
 
 #endif /* GUI_ADC_H_ */
@@ -48,6 +48,7 @@ void guiCan1BitRateSelectionCallback(GUITouchEvent Event, uint32_t ButtonId);
 void guiCan1UpdateGuiElementsReadFromSettings();
 void guiCan1ClearButtonCallback(GUITouchEvent Event, uint32_t ButtonId);
 void guiCan1InitGuiElements();
+void guiCan1InitSidebarGuiElements();
 
 
 #endif /* GUI_CAN1_H_ */
@@ -47,6 +47,7 @@ void guiCan2BitRateButtonCallback(GUITouchEvent Event, uint32_t ButtonId);
 void guiCan2BitRateSelectionCallback(GUITouchEvent Event, uint32_t ButtonId);
 void guiCan2UpdateGuiElementsReadFromSettings();
 void guiCan2InitGuiElements();
+void guiCan2InitSidebarGuiElements();
 
 
 
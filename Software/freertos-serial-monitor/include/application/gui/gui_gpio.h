@@ -51,6 +51,7 @@ void guiGpioOutPinCallback(GUITouchEvent Event, uint32_t ButtonId);
 void guiGpioDutyCallback(GUITouchEvent Event, uint32_t ButtonId);
 void guiGpioFrequencyCallback(GUITouchEvent Event, uint32_t ButtonId);
 void guiGpioInitGuiElements();
+void guiGpioInitSidebarGuiElements();
 
 
 #endif /* GUI_GPIO_H_ */
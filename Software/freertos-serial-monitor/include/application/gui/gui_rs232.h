@@ -33,6 +33,7 @@
 
 #include "rs232_task.h"
 #include "lcd_task.h"
+#include "gui_search.h"
 #include "simple_gui.h"
 #include "simple_gui_config.h"
 
@@ -52,6 +53,7 @@ void guiRs232ParitySelectionCallback(GUITouchEvent Event, uint32_t ButtonId);
 void guiRs232SidebarForwardBackwardsButtonsCallback(GUITouchEvent Event, uint32_t ButtonId);
 void guiRs232UpdateGuiElementsReadFromSettings();
 void guiRs232InitGuiElements();
+void guiRs232InitSidebarGuiElements();
 
 
 #endif /* GUI_RS232_H_ */
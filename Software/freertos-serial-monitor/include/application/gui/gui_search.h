@@ -0,0 +1,54 @@
+/**
+ ******************************************************************************
+ * @file	gui_search.h
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-16
+ * @brief
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef GUI_SEARCH_H_
+#define GUI_SEARCH_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+#include "stm32f4xx_hal.h"
+
+#include "uart1_task.h"
+#include "uart2_task.h"
+#include "rs232_task.h"
+#include "uart_search.h"
+#include "lcd_task.h"
+#include "simple_gui.h"
+#include "simple_gui_config.h"
+#include "spi_flash_memory_map.h"
+
+/* Defines -------------------------------------------------------------------*/
+/* Typedefs ------------------------------------------------------------------*/
+/* Function prototypes -------------------------------------------------------*/
+void guiSearchInitGuiElements();
+void guiSearchInitPopoutGuiElements();
+void guiSearchManage();
+void guiSearchPatternButtonCallback(GUITouchEvent Event, uint32_t ButtonId);
+void guiSearchFindButtonCallback(GUITouchEvent Event, uint32_t ButtonId);
+void guiSearchKeyCallback(GUITouchEvent Event, uint32_t ButtonId);
+
+
+#endif /* GUI_SEARCH_H_ */
@@ -46,6 +46,7 @@
 /* Typedefs ------------------------------------------------------------------*/
 /* Function prototypes -------------------------------------------------------*/
 void guiSystemInitGuiElements();
+void guiSystemInitSidebarGuiElements();
 void guiDebugToggleCallback(GUITouchEvent Event, uint32_t ButtonId);
 void guiSystemButtonCallback(GUITouchEvent Event, uint32_t ButtonId);
 void guiSaveSettingsButtonCallback(GUITouchEvent Event, uint32_t ButtonId);
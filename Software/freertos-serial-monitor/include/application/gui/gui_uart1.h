@@ -33,6 +33,7 @@
 
 #include "uart1_task.h"
 #include "lcd_task.h"
+#include "gui_search.h"
 #include "simple_gui.h"
 #include "simple_gui_config.h"
 
@@ -52,6 +53,7 @@ void guiUart1ParitySelectionCallback(GUITouchEvent Event, uint32_t ButtonId);
 void guiUart1SidebarForwardBackwardsButtonsCallback(GUITouchEvent Event, uint32_t ButtonId);
 void guiUart1UpdateGuiElementsReadFromSettings();
 void guiUart1InitGuiElements();
+void guiUart1InitSidebarGuiElements();
 
 
 #endif /* GUI_UART1_H_ */
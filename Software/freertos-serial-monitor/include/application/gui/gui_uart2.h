@@ -33,6 +33,7 @@
 
 #include "uart2_task.h"
 #include "lcd_task.h"
+#include "gui_search.h"
 #include "simple_gui.h"
 #include "simple_gui_config.h"
 
@@ -52,6 +53,7 @@ void guiUart2ParitySelectionCallback(GUITouchEvent Event, uint32_t ButtonId);
 void guiUart2SidebarForwardBackwardsButtonsCallback(GUITouchEvent Event, uint32_t ButtonId);
 void guiUart2UpdateGuiElementsReadFromSettings();
 void guiUart2InitGuiElements();
+void guiUart2InitSidebarGuiElements();
 
 
 #endif /* GUI_UART2_H_ */
@@ -38,6 +38,7 @@
 #include "uart_common.h"
 #include "messages.h"
 #include "simple_gui.h"
+#include "uart_summary.h"
 
 /* Defines -------------------------------------------------------------------*/
 /* Typedefs ------------------------------------------------------------------*/
@@ -51,6 +52,9 @@ ErrorStatus rs232UpdateWithNewSettings();
 SemaphoreHandle_t* rs232GetSettingsSemaphore();
 ErrorStatus rs232Clear();
 uint32_t rs232GetCurrentWriteAddress();
+ErrorStatus rs232ReadData(uint8_t* pBuffer, uint32_t ReadAddress, uint32_t NumByteToRead, TickType_t BlockTime);
+uint32_t rs232GetMinimap(GUIMinimapBucket* pBuckets, uint32_t MaxNumOfBuckets);
+UARTSummary* rs232GetSummary();
 
 void rs232Transmit(uint8_t* Data, uint32_t Size);
 void rs232ClearFlash();
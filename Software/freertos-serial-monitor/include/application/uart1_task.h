@@ -38,6 +38,7 @@
 #include "uart_common.h"
 #include "messages.h"
 #include "simple_gui.h"
+#include "uart_summary.h"
 
 /* Defines -------------------------------------------------------------------*/
 /* Typedefs ------------------------------------------------------------------*/
@@ -53,6 +54,9 @@ ErrorStatus uart1UpdateWithNewSettings();
 SemaphoreHandle_t* uart1GetSettingsSemaphore();
 ErrorStatus uart1Clear();
 uint32_t uart1GetCurrentWriteAddress();
+ErrorStatus uart1ReadData(uint8_t* pBuffer, uint32_t ReadAddress, uint32_t NumByteToRead, TickType_t BlockTime);
+uint32_t uart1GetMinimap(GUIMinimapBucket* pBuckets, uint32_t MaxNumOfBuckets);
+UARTSummary* uart1GetSummary();
 
 void uart1Transmit(uint8_t* Data, uint32_t Size);
 void uart1ClearFlash();
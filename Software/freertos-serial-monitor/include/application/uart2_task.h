@@ -38,6 +38,7 @@
 #include "uart_common.h"
 #include "messages.h"
 #include "simple_gui.h"
+#include "uart_summary.h"
 
 /* Defines -------------------------------------------------------------------*/
 /* Typedefs ------------------------------------------------------------------*/
@@ -52,6 +53,9 @@ ErrorStatus uart2UpdateWithNewSettings();
 SemaphoreHandle_t* uart2GetSettingsSemaphore();
 ErrorStatus uart2Clear();
 uint32_t uart2GetCurrentWriteAddress();
+ErrorStatus uart2ReadData(uint8_t* pBuffer, uint32_t ReadAddress, uint32_t NumByteToRead, TickType_t BlockTime);
+uint32_t uart2GetMinimap(GUIMinimapBucket* pBuckets, uint32_t MaxNumOfBuckets);
+UARTSummary* uart2GetSummary();
 
 void uart2Transmit(uint8_t* Data, uint32_t Size);
 void uart2ClearFlash();
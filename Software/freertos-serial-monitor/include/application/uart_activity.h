@@ -0,0 +1,75 @@
+/**
+ ******************************************************************************
+ * @file	uart_activity.h
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-15
+ * @brief
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef UART_ACTIVITY_H_
+#define UART_ACTIVITY_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "simple_gui.h"
+
+#include <stdbool.h>
+
+/* Defines -------------------------------------------------------------------*/
+#define UART_ACTIVITY_NUM_OF_LEVELS		(3)
+#define UART_ACTIVITY_NUM_OF_BUCKETS	(64)	/* Buckets on every level, must be even */
+#define UART_ACTIVITY_BUCKET_TIME		(500)	/* ms covered by a bucket on the first level */
+#define UART_ACTIVITY_LEVEL_FACTOR		(8)		/* How many times longer a bucket is on the next level */
+
+/* Typedefs ------------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t address;			/* FLASH address of the first byte in the bucket */
+	uint32_t numOfBytes;
+	uint32_t numOfErrors;
+} UARTActivityBucket;
+
+typedef struct
+{
+	UARTActivityBucket buckets[UART_ACTIVITY_NUM_OF_BUCKETS];
+	uint32_t bucketTime;		/* ms covered by a bucket */
+	uint32_t currentBucket;		/* Number of the bucket that is written to, counted from the start */
+} UARTActivityLevel;
+
+/*
+ * Levels below the last are circular and keep the most recent buckets. The last level always covers all of
+ * the data, when it's full every pair of buckets is merged and the bucket time is doubled.
+ */
+typedef struct
+{
+	UARTActivityLevel levels[UART_ACTIVITY_NUM_OF_LEVELS];
+	TickType_t startTime;
+} UARTActivity;
+
+/* Function prototypes -------------------------------------------------------*/
+void uartActivityReset(UARTActivity* pActivity, uint32_t Address);
+void uartActivityAdd(UARTActivity* pActivity, uint32_t Address, uint32_t NumOfBytes, uint32_t NumOfErrors);
+uint32_t uartActivityGetMinimap(UARTActivity* pActivity, GUIMinimapBucket* pBuckets, uint32_t MaxNumOfBuckets);
+
+#endif /* UART_ACTIVITY_H_ */
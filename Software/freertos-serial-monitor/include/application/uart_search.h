@@ -0,0 +1,108 @@
+/**
+ ******************************************************************************
+ * @file	uart_search.h
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-16
+ * @brief
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef UART_SEARCH_H_
+#define UART_SEARCH_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "uart_summary.h"
+
+#include <stdbool.h>
+
+/* Defines -------------------------------------------------------------------*/
+#define UART_SEARCH_MAX_PATTERN_SIZE	(16)	/* Must be less than 256 */
+#define UART_SEARCH_BLOCK_SIZE			(2048)	/* Number of new bytes read from memory at a time */
+#define UART_SEARCH_READ_TIMEOUT		(100)	/* ms to wait for the memory */
+
+/* Typedefs ------------------------------------------------------------------*/
+typedef enum
+{
+	UARTSearchState_Idle,
+	UARTSearchState_Searching,
+	UARTSearchState_Found,
+	UARTSearchState_NotFound,
+	UARTSearchState_Error,
+} UARTSearchState;
+
+typedef enum
+{
+	UARTSearchDirection_Forward,
+	UARTSearchDirection_Backward,
+} UARTSearchDirection;
+
+typedef enum
+{
+	UARTSearchPatternFormat_Ascii,	/* Every character is one byte */
+	UARTSearchPatternFormat_Hex,	/* Pairs of hex digits, spaces are ignored */
+} UARTSearchPatternFormat;
+
+typedef struct
+{
+	uint8_t pattern[UART_SEARCH_MAX_PATTERN_SIZE];
+	uint32_t patternSize;
+
+	/* Boyer-Moore-Horspool shift for every byte value, one table for each direction */
+	uint8_t forwardShift[256];
+	uint8_t backwardShift[256];
+
+	/* Function used to read the data. Arguments: buffer, address, number of bytes to read, block time */
+	ErrorStatus (*readFunction)(uint8_t*, uint32_t, uint32_t, TickType_t);
+	uint32_t minAddress;
+	uint32_t endAddress;			/* The address after the last byte to search */
+	uint32_t nextAddress;			/* Forward: first byte of the next block, backward: end of the next block */
+	UARTSearchDirection direction;
+	volatile UARTSearchState state;
+	uint32_t matchAddress;
+	uint32_t numOfBytesToSearch;
+	uint32_t numOfBytesSearched;
+	uint32_t numOfBytesSkipped;
+
+	/* Optional summaries of the data used to skip blocks that can't contain the pattern */
+	UARTSummary* summary;
+	UARTSummaryQuery query;
+
+	/* Room for a block and the end of the block before so matches across two blocks are found */
+	uint8_t buffer[UART_SEARCH_BLOCK_SIZE + UART_SEARCH_MAX_PATTERN_SIZE - 1];
+} UARTSearch;
+
+/* Function prototypes -------------------------------------------------------*/
+ErrorStatus uartSearchSetPattern(UARTSearch* pSearch, const uint8_t* pPattern, uint32_t Size);
+ErrorStatus uartSearchSetPatternFromString(UARTSearch* pSearch, const uint8_t* pString, UARTSearchPatternFormat Format);
+void uartSearchStart(UARTSearch* pSearch, ErrorStatus (*ReadFunction)(uint8_t*, uint32_t, uint32_t, TickType_t),
+					 UARTSummary* pSummary, uint32_t MinAddress, uint32_t EndAddress, uint32_t FromAddress,
+					 UARTSearchDirection Direction);
+UARTSearchState uartSearchContinue(UARTSearch* pSearch, uint32_t MaxNumOfBlocks);
+void uartSearchStop(UARTSearch* pSearch);
+UARTSearchState uartSearchGetState(UARTSearch* pSearch);
+uint32_t uartSearchGetMatchAddress(UARTSearch* pSearch);
+uint32_t uartSearchGetProgress(UARTSearch* pSearch);
+uint32_t uartSearchGetSkippedPercentage(UARTSearch* pSearch);
+
+#endif /* UART_SEARCH_H_ */
@@ -0,0 +1,75 @@
+/**
+ ******************************************************************************
+ * @file	uart_summary.h
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-17
+ * @brief
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef UART_SUMMARY_H_
+#define UART_SUMMARY_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <stdbool.h>
+
+/* Defines -------------------------------------------------------------------*/
+#define UART_SUMMARY_BLOCK_SIZE			(4096)	/* Number of data bytes described by one summary */
+#define UART_SUMMARY_FILTER_SIZE		(256)	/* Bytes in the bloom filter of a block, one FLASH page */
+#define UART_SUMMARY_MAX_NUM_OF_BLOCKS	(240)	/* 240 filters fit in the summary sector */
+#define UART_SUMMARY_MAX_NUM_OF_TRIGRAMS	(14)	/* Max number of pattern trigrams checked in a query */
+#define UART_SUMMARY_READ_TIMEOUT		(100)	/* ms to wait for the FLASH */
+
+/* Typedefs ------------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t dataAddress;			/* FLASH address of the first byte of the channel */
+	uint32_t summaryAddress;		/* FLASH address of the filter for the first block */
+	uint32_t firstBlock;			/* The first block that has all its bytes in the filter */
+	uint32_t currentBlock;			/* The block the filter is being built for */
+	uint32_t lastBytes;				/* The two bytes before the next one */
+	uint32_t numOfLastBytes;
+	uint8_t filter[UART_SUMMARY_FILTER_SIZE];
+} UARTSummary;
+
+/* What a search needs to check the summaries for a pattern, the filters are read with DMA so it can't be in CCM RAM */
+typedef struct
+{
+	uint16_t bits[UART_SUMMARY_MAX_NUM_OF_TRIGRAMS];
+	uint32_t numOfBits;
+	uint32_t filterBlock[2];		/* The block in each filter buffer, even blocks in the first and odd in the second */
+	uint8_t filters[2][UART_SUMMARY_FILTER_SIZE];
+	uint32_t numOfBlocksChecked;
+	uint32_t numOfBlocksSkipped;
+} UARTSummaryQuery;
+
+/* Function prototypes -------------------------------------------------------*/
+void uartSummaryReset(UARTSummary* pSummary, uint32_t DataAddress, uint32_t Address);
+void uartSummaryAdd(UARTSummary* pSummary, uint32_t Address, const uint8_t* pData, uint32_t NumOfBytes);
+
+void uartSummaryQueryInit(UARTSummaryQuery* pQuery, const uint8_t* pPattern, uint32_t Size);
+bool uartSummaryCanContainMatch(UARTSummary* pSummary, UARTSummaryQuery* pQuery, uint32_t Address);
+uint32_t uartSummaryGetBlockStartAddress(UARTSummary* pSummary, uint32_t Address);
+
+#endif /* UART_SUMMARY_H_ */
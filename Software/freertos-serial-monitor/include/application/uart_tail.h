@@ -0,0 +1,52 @@
+/**
+ ******************************************************************************
+ * @file	uart_tail.h
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-14
+ * @brief
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef UART_TAIL_H_
+#define UART_TAIL_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+
+#include <stdbool.h>
+
+/* Defines -------------------------------------------------------------------*/
+#define UART_TAIL_SIZE		(4096)	/* Must be a power of 2 and bigger than one page of the main text box */
+
+/* Typedefs ------------------------------------------------------------------*/
+typedef struct
+{
+	uint8_t data[UART_TAIL_SIZE];		/* The byte for address A is at data[A & (UART_TAIL_SIZE - 1)] */
+	uint32_t startAddress;				/* Address of the first byte written since the last reset */
+	volatile uint32_t endAddress;		/* Address after the last byte written */
+} UARTTail;
+
+/* Function prototypes -------------------------------------------------------*/
+void uartTailReset(UARTTail* pTail, uint32_t Address);
+void uartTailWrite(UARTTail* pTail, uint8_t* pData, uint32_t Size);
+bool uartTailRead(UARTTail* pTail, uint8_t* pBuffer, uint32_t Address, uint32_t Size);
+
+#endif /* UART_TAIL_H_ */
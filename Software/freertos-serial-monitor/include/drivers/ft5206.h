@@ -33,6 +33,8 @@
 #include "queue.h"
 #include "messages.h"
 
+#include <stdbool.h>
+
 /* Defines -------------------------------------------------------------------*/
 /* Typedefs ------------------------------------------------------------------*/
 typedef enum
@@ -73,6 +75,8 @@ typedef struct
 void FT5206_Init();
 uint32_t FT5206_GetNumOfTouchPoints();
 void FT5206_GetTouchDataForPoint(FT5206Event* pEvent, FT5206TouchCoordinate* pCoordinate, FT5206Point Point);
+bool FT5206_GetPendingMove(uint32_t MoveNumber, FT5206TouchCoordinate* pCoordinate);
+uint32_t FT5206_GetMaxInterruptCycles();
 
 void CTP_INT_Callback();
 
@@ -32,13 +32,80 @@
 #include "FreeRTOS.h"
 #include "semphr.h"
 
+#include <stdbool.h>
+
 /* Defines -------------------------------------------------------------------*/
+#define I2C2_TRANSACTION_TIMEOUT	(50)	/* ms before a synchronous transfer gives up and recovers the bus */
+
 /* Typedefs ------------------------------------------------------------------*/
+typedef enum
+{
+	I2C2Direction_Write,
+	I2C2Direction_Read,
+} I2C2Direction;
+
+typedef enum
+{
+	I2C2Priority_High,
+	I2C2Priority_Low,
+	I2C2Priority_NumOfPriorities,
+} I2C2Priority;
+
+typedef enum
+{
+	I2C2Client_Touch,
+	I2C2Client_Temperature,
+	I2C2Client_Other,
+	I2C2Client_NumOfClients,
+} I2C2Client;
+
+typedef enum
+{
+	I2C2TransactionState_Idle,
+	I2C2TransactionState_Queued,
+	I2C2TransactionState_Active,
+	I2C2TransactionState_Done,
+	I2C2TransactionState_Error,
+} I2C2TransactionState;
+
+typedef struct I2C2Transaction I2C2Transaction;
+struct I2C2Transaction
+{
+	uint8_t devAddress;
+	bool useRegister;					/* Write the register address before the data */
+	uint8_t registerAddress;
+	I2C2Direction direction;
+	uint8_t* pBuffer;					/* Must be valid until the transaction is done */
+	uint16_t size;
+	I2C2Priority priority;
+	I2C2Client client;
+	void (*callback)(I2C2Transaction*);	/* Called from the I2C interrupt when done, can be 0 */
+
+	/* Used by the driver */
+	volatile I2C2TransactionState state;
+	uint32_t submitCycles;
+	I2C2Transaction* next;
+};
+
+typedef struct
+{
+	uint32_t numOfTransactions;
+	uint32_t numOfErrors;
+	uint32_t maxLatency;				/* us from submit until done */
+	uint32_t totalLatency;				/* us, divide by numOfTransactions for the mean */
+} I2C2ClientStats;
+
 /* Function prototypes -------------------------------------------------------*/
 void I2C2_Init();
-void I2C2_Transmit(uint8_t DevAddress, uint8_t *Data, uint16_t Size);
-void I2C2_TransmitFromISR(uint8_t DevAddress, uint8_t* pBuffer, uint16_t Size);
-void I2C2_Receive(uint8_t DevAddress, uint8_t *Data, uint16_t Size);
-void I2C2_ReceiveFromISR(uint8_t DevAddress, uint8_t* pBuffer, uint16_t Size);
+ErrorStatus I2C2_Submit(I2C2Transaction* pTransaction);
+ErrorStatus I2C2_SubmitFromISR(I2C2Transaction* pTransaction);
+ErrorStatus I2C2_Transfer(I2C2Transaction* pTransaction);
+void I2C2_RecoverBus();
+void I2C2_GetClientStats(I2C2Client Client, I2C2ClientStats* pStats);
+
+ErrorStatus I2C2_Transmit(uint8_t DevAddress, uint8_t* pBuffer, uint16_t Size, I2C2Client Client);
+ErrorStatus I2C2_Receive(uint8_t DevAddress, uint8_t* pBuffer, uint16_t Size, I2C2Client Client);
+ErrorStatus I2C2_ReadRegister(uint8_t DevAddress, uint8_t Register, uint8_t* pBuffer, uint16_t Size, I2C2Client Client);
+ErrorStatus I2C2_WriteRegister(uint8_t DevAddress, uint8_t Register, uint8_t* pBuffer, uint16_t Size, I2C2Client Client);
 
 #endif /* I2C2_H_ */
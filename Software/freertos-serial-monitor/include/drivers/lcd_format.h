@@ -0,0 +1,57 @@
+/**
+ ******************************************************************************
+ * @file	lcd_format.h
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-09-07
+ * @brief
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef LCD_FORMAT_H_
+#define LCD_FORMAT_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Defines -------------------------------------------------------------------*/
+/* Rows in LCDTextFormat_HexDump look like "0010: 48 65 6C 6C 6F 0D 0A 00 | Hello..." */
+#define LCD_HEX_DUMP_BYTES_PER_ROW	(8)
+#define LCD_HEX_DUMP_CHARS_PER_ROW	(6 + 3 * LCD_HEX_DUMP_BYTES_PER_ROW + 2 + LCD_HEX_DUMP_BYTES_PER_ROW)
+
+/* Max number of characters a single byte can be formatted to, see LCDTextFormat */
+#define LCD_MAX_CHARS_PER_FORMATTED_BYTE	(9)
+
+/* Typedefs ------------------------------------------------------------------*/
+typedef enum
+{
+	LCDTextFormat_ASCII,				/* "A" */
+	LCDTextFormat_HexWithSpaces,		/* "41 " */
+	LCDTextFormat_HexWithoutSpaces,		/* "41" */
+	LCDTextFormat_Decimal,				/* " 65 " */
+	LCDTextFormat_Binary,				/* "01000001 " */
+	LCDTextFormat_CEscaped,				/* "A   ", "\n  " or "\x1B", every byte is 4 characters so the columns line up */
+	LCDTextFormat_HexDump,				/* Rows of LCD_HEX_DUMP_BYTES_PER_ROW bytes with offset, hex and ASCII */
+} LCDTextFormat;
+
+/* Function prototypes -------------------------------------------------------*/
+uint32_t LCD_FormatBuffer(const uint8_t* pSource, uint32_t Size, uint8_t* pDestination, LCDTextFormat Format);
+uint32_t LCD_FormatHexDump(const uint8_t* pSource, uint32_t Size, uint32_t Offset, uint8_t* pDestination);
+
+#endif /* LCD_FORMAT_H_ */
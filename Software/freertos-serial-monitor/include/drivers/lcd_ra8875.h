@@ -34,6 +34,7 @@
 #include "stm32f4xx_hal.h"
 
 #include "color.h"
+#include "lcd_format.h"
 
 /* Defines -------------------------------------------------------------------*/
 #define LCD_COLOR_BROWN		(0x40C0)
@@ -80,13 +81,6 @@ typedef enum
 	LCDFill_Fill,
 } LCDFill;
 
-typedef enum
-{
-	LCDTextFormat_ASCII,
-	LCDTextFormat_HexWithSpaces,
-	LCDTextFormat_HexWithoutSpaces,
-} LCDTextFormat;
-
 typedef struct
 {
 	const uint16_t *data;
@@ -94,6 +88,14 @@ typedef struct
 	uint16_t height;
 } LCDImage;
 
+typedef struct
+{
+	const uint8_t *data;		/* Run-length encoded pixels, see Software/tools/lcd_image_converter.py */
+	const uint16_t *palette;	/* RGB565 palette or 0 if the pixels are stored as RGB565 values */
+	uint16_t width;
+	uint16_t height;
+} LCDCompressedImage;
+
 typedef struct
 {
 	uint16_t xLeft;
@@ -107,6 +109,8 @@ void LCD_Init();
 
 void LCD_ClearFullWindow();
 void LCD_ClearActiveWindow(uint16_t XLeft, uint16_t XRight, uint16_t YTop, uint16_t YBottom);
+void LCD_SetClipWindow(LCDActiveWindow Window);
+void LCD_ResetClipWindow();
 void LCD_SetBrightness(uint8_t Brightness);
 uint8_t LCD_GetBrightness();
 void LCD_DisplayOn();
@@ -141,6 +145,7 @@ void LCD_DrawSquareOrLine(uint16_t XStart, uint16_t XEnd, uint16_t YStart, uint1
 void LCD_BTESize(uint16_t Width, uint16_t Height);
 void LCD_BTESourceDestinationPoints(uint16_t SourceX, uint16_t SourceY, uint16_t DestinationX, uint16_t DestinationY);
 void LCD_BTEDisplayImageOfSizeAt(const LCDImage* Image, uint16_t XPos, uint16_t YPos);
+void LCD_BTEDisplayCompressedImageAt(const LCDCompressedImage* Image, uint16_t XPos, uint16_t YPos);
 
 void LCD_TestBackground(uint16_t Delay);
 void LCD_TestBackgroundFade(uint16_t Delay);
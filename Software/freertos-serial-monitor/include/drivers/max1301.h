@@ -30,8 +30,14 @@
 /* Includes ------------------------------------------------------------------*/
 #include "stm32f4xx_hal.h"
 #include "FreeRTOS.h"
+#include "task.h"
+
+#include <stdbool.h>
 
 /* Defines -------------------------------------------------------------------*/
+#define MAX1301_MAX_SAMPLE_RATE		(100000)	/* Hz, one conversion is 32 SCLK cycles at 5.25 MHz, about 6.1 us */
+#define MAX1301_BLOCK_SIZE			(256)		/* Number of samples in each of the two acquisition buffers */
+
 /* Typedefs ------------------------------------------------------------------*/
 typedef enum
 {
@@ -67,9 +73,29 @@ typedef struct
 	MAX1301Range range;
 } MAX1301Configuration;
 
+typedef struct
+{
+	uint32_t numOfSamples;			/* Samples converted since the acquisition was started */
+	uint32_t numOfOverruns;			/* Samples lost because of a DMA transfer error, the acquisition stops then */
+	uint32_t numOfDroppedSamples;	/* Samples lost because both buffers were still being processed */
+	uint32_t lastSampleCycles;		/* DWT cycle count when the last block was handed over */
+	uint32_t minPeriod;				/* Shortest time between two blocks since the last read, in CPU cycles */
+	uint32_t maxPeriod;				/* Longest time between two blocks since the last read, in CPU cycles */
+} MAX1301AcquisitionStats;
+
+/* Called from interrupt context when one of the buffers is full, give it back with MAX1301_ReleaseBlock */
+typedef void (*MAX1301BlockCallback)(int16_t* pSamples, uint32_t NumOfSamples, uint32_t FirstSampleNumber);
+
 /* Function prototypes -------------------------------------------------------*/
 void MAX1301_Init();
 int16_t MAX1301_GetDataFromDiffChannel(MAX1301DiffChannel Channel);
 
+ErrorStatus MAX1301_StartAcquisition(MAX1301DiffChannel Channel, uint32_t SampleRate, MAX1301BlockCallback Callback);
+void MAX1301_StopAcquisition();
+bool MAX1301_AcquisitionIsRunning();
+uint32_t MAX1301_GetAcquisitionSampleRate();
+void MAX1301_GetAcquisitionStats(MAX1301AcquisitionStats* pStats);
+void MAX1301_ReleaseBlock(int16_t* pSamples);
+
 
 #endif /* MAX1301_H_ */
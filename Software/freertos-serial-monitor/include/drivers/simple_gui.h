@@ -39,9 +39,16 @@
 #include <stdbool.h>
 
 /* Defines -------------------------------------------------------------------*/
+/* Formats that can be used in a text box, GUITextFormat_HexDump can only be used with GUITextBox_WriteBufferWithFormat */
 #define IS_GUI_TEXT_FORMAT(X)	(((X) == GUITextFormat_ASCII) || \
 								 ((X) == GUITextFormat_HexWithSpaces) || \
-								 ((X) == GUITextFormat_HexWithoutSpaces))
+								 ((X) == GUITextFormat_HexWithoutSpaces) || \
+								 ((X) == GUITextFormat_Decimal) || \
+								 ((X) == GUITextFormat_Binary) || \
+								 ((X) == GUITextFormat_CEscaped))
+
+/* Number of objects in a const table of objects, used to fill in a GUILayout */
+#define GUI_NUM_OF_OBJECTS(TABLE)	(sizeof(TABLE) / sizeof((TABLE)[0]))
 
 /* Typedefs ------------------------------------------------------------------*/
 typedef enum
@@ -103,6 +110,10 @@ typedef enum
 	GUITextFormat_ASCII,
 	GUITextFormat_HexWithSpaces,
 	GUITextFormat_HexWithoutSpaces,
+	GUITextFormat_Decimal,
+	GUITextFormat_Binary,
+	GUITextFormat_CEscaped,
+	GUITextFormat_HexDump,
 } GUITextFormat;
 
 typedef enum
@@ -214,6 +225,17 @@ typedef struct
 	uint32_t textHeight[2];		/* --------------------------------------------------------- */
 } GUIButton;
 
+/*
+ * @name	GUIMinimapBucket
+ * @brief	A part of the saved data shown as one row in the minimap of a text box
+ */
+typedef struct
+{
+	uint8_t activity;		/* Amount of data in the bucket, 255 for the busiest bucket */
+	bool hasErrors;
+	uint32_t address;		/* Address of the first byte in the bucket */
+} GUIMinimapBucket;
+
 /*
  * @name	GUITextBox
  * @brief	- 	A box that can display text of arbitrary length. When the text cursor reaches
@@ -250,8 +272,9 @@ typedef struct
 	uint32_t effectiveHeight;		/* ----------------------------------------------------------- */
 
 	/*
-	 * Pointer to an array where all the text displayed in the text box is stored. The memory for this will
-	 * be allocated when calling the GUI_AddTextBox and will only contain the amount that can be displayed.
+	 * Pointer to an array where all the text displayed in the text box is stored. The memory for this is
+	 * taken from the text buffer pool the first time data is read with the dataReadFunction and given back
+	 * when the text box is hidden.
 	 */
 	uint8_t* textBuffer;		/* Circular buffer */
 	uint32_t bufferCount;		/* Number of valid characters in the buffer */
@@ -266,6 +289,32 @@ typedef struct
 	uint32_t readLastValidByteAddress;
 	bool isScrolling;
 
+	/*
+	 * Width of a scrollbar on the right side of the text box, 0 if it should not have one. Only used when there's
+	 * a dataReadFunction. Touching the scrollbar moves the displayed data directly to that part of the memory.
+	 */
+	uint16_t scrollbarWidth;
+	uint16_t scrollbarThumbTop;		/* Calculated automatically, where the thumb was last drawn */
+	uint16_t scrollbarThumbHeight;	/* ---------------------------------------------------------- */
+
+	/*
+	 * Position a touch on the scrollbar or the minimap, or a search match, wants to move the displayed data to.
+	 * Touches are handled in the LCD task so only the position is saved there, the task that manages the text box
+	 * does the actual move with GUITextBox_MoveDisplayedDataToPendingPosition.
+	 */
+	volatile bool hasPendingPosition;
+	volatile uint32_t pendingPosition;
+
+	/*
+	 * Width of a minimap to the left of the scrollbar, 0 if it should not have one. The minimapFunction gives a
+	 * summary of the saved data from the oldest to the newest bucket so that drawing it never reads the memory.
+	 * Arguments: buckets, max number of buckets. Returns the number of buckets. Touching a row in the minimap
+	 * moves the displayed data to the start of that bucket. It's called from the LCD task for touches as well.
+	 */
+	uint16_t minimapWidth;
+	uint32_t (*minimapFunction)(GUIMinimapBucket*, uint32_t);
+	TickType_t minimapLastDrawTime;		/* Calculated automatically */
+
 	/* Position where the next character will be written. Referenced from the objects origin (xPos, yPos) */
 	uint16_t xWritePos;
 	uint16_t yWritePos;
@@ -314,6 +363,7 @@ typedef struct
  * @brief	- 	A collection of other GUI items to more easily hide/show groups of items.
  * 			- 	When a container is drawn it will draw all of it's containing elements as well.
  * 				The same happens when it is hidden.
+ * 			-	Containers are added by filling in a GUIContainerTemplate and calling GUIContainer_Add.
  */
 typedef struct GUIContainer GUIContainer;	/* We need to typedef here because a GUIContainer can contain other GUIContainers */
 struct GUIContainer
@@ -326,11 +376,14 @@ struct GUIContainer
 	/* Colors */
 	uint16_t backgroundColor;
 
-	/* Store a pointer to all the object on the page for easy access and small footprint */
-	GUIButton* buttons[guiConfigNUMBER_OF_BUTTONS];
-	GUITextBox* textBoxes[guiConfigNUMBER_OF_TEXT_BOXES];
-	GUIGrid* tables[guiConfigNUMBER_OF_GRIDS];
-	GUIContainer* containers[guiConfigNUMBER_OF_CONTAINERS];
+	/*
+	 * Index in the object lists of everything in the container, first the buttons, then the text boxes and last
+	 * the containers. The memory is allocated in GUIContainer_Add and only has room for the objects in it.
+	 */
+	uint8_t* children;
+	uint8_t numOfButtons;
+	uint8_t numOfTextBoxes;
+	uint8_t numOfContainers;
 
 	/* The active page of the container, starts at GUIContainerPage_None */
 	GUIContainerPage activePage;
@@ -340,19 +393,93 @@ struct GUIContainer
 	void (*touchCallback)(GUITouchEvent, uint16_t, uint16_t);
 };
 
+/*
+ * @name	GUIContainerTemplate
+ * @brief	-	Describes a container and what it contains when calling GUIContainer_Add.
+ * 			-	The objects in it are given by their id so the template can be a const table in flash. They are
+ * 				copied to a compact list in the GUIContainer and don't have to be added before the container.
+ */
+typedef struct
+{
+	/* Basic information about the object */
+	GUIObject object;
+
+	GUIHideState contentHideState;
+
+	/* Colors */
+	uint16_t backgroundColor;
+
+	/* IDs of the objects in the container, unused entries should be 0 */
+	uint16_t buttons[guiConfigMAX_NUM_OF_BUTTONS_IN_CONTAINER];
+	uint16_t textBoxes[guiConfigMAX_NUM_OF_TEXT_BOXES_IN_CONTAINER];
+	uint16_t containers[guiConfigMAX_NUM_OF_CONTAINERS_IN_CONTAINER];
+
+	/* The active page of the container, starts at GUIContainerPage_None */
+	GUIContainerPage activePage;
+	GUIContainerPage lastPage;
+
+	/* Pointer to a callback function called when a touch event has happened */
+	void (*touchCallback)(GUITouchEvent, uint16_t, uint16_t);
+} GUIContainerTemplate;
+
+/*
+ * @name	GUILayout
+ * @brief	-	Const tables with the objects for a part of the display, for example a sidebar and everything
+ * 				shown together with it. The tables stay in flash and GUI_AddLayout copies them to the object lists.
+ * 			-	The text boxes are added first, then the buttons and last the containers.
+ */
+typedef struct
+{
+	const GUITextBox* textBoxes;
+	uint32_t numOfTextBoxes;
+	const GUIButton* buttons;
+	uint32_t numOfButtons;
+	const GUIContainerTemplate* containers;
+	uint32_t numOfContainers;
+} GUILayout;
+
+/*
+ * @name	GUITextBufferPoolStats
+ * @brief	Statistics for the pool of text buffers used by text boxes that read from memory
+ */
+typedef struct
+{
+	uint32_t numOfBlocks;
+	uint32_t numOfBlocksInUse;
+	uint32_t maxNumOfBlocksInUse;
+	uint32_t numOfAllocations;		/* Number of times a block was handed out */
+	uint32_t numOfHeapFallbacks;	/* Number of buffers taken from the heap because no block could be used */
+} GUITextBufferPoolStats;
+
+/*
+ * @name	GUIReadCacheStats
+ * @brief	Statistics for the cache of data read by text boxes from memory, counted in pages
+ */
+typedef struct
+{
+	uint32_t numOfHits;
+	uint32_t numOfMisses;
+	uint32_t numOfReadAheads;		/* Pages read before they were needed while scrolling */
+} GUIReadCacheStats;
+
 /* Function prototypes -------------------------------------------------------*/
 void GUI_Init();
 void GUI_DrawBorder(GUIObject Object);
 void GUI_RedrawLayer(GUILayer Layer);
 void GUI_SetActiveLayer(GUILayer Layer);
 GUILayer GUI_GetActiveLayer();
+void GUI_InvalidateRegion(GUILayer Layer, LCDActiveWindow Region);
+void GUI_RedrawDirtyRegions();
+void GUI_GetTextBufferPoolStats(GUITextBufferPoolStats* pStats);
+void GUI_GetReadCacheStats(GUIReadCacheStats* pStats);
+GUIErrorStatus GUI_AddLayout(const GUILayout* Layout);
 void GUI_SetBeepOn();
 void GUI_SetBeepOff();
 bool GUI_BeepIsOn();
 
 /* Button functions ==========================================================*/
 GUIButton* GUIButton_GetFromId(uint32_t ButtonId);
-GUIErrorStatus GUIButton_Add(GUIButton* Button);
+GUIErrorStatus GUIButton_Add(const GUIButton* Button);
 GUIErrorStatus GUIButton_Hide(uint32_t ButtonId);
 GUIErrorStatus GUIButton_Draw(uint32_t ButtonId);
 void GUIButton_DrawAll();
@@ -365,7 +492,7 @@ void GUIButton_CheckAllActiveForTouchEventAt(GUITouchEvent Event, uint16_t XPos,
 
 /* Text box functions ========================================================*/
 GUITextBox* GUITextBox_GetFromId(uint32_t TextBoxId);
-GUIErrorStatus GUITextBox_Add(GUITextBox* TextBox);
+GUIErrorStatus GUITextBox_Add(const GUITextBox* TextBox);
 GUIErrorStatus GUITextBox_Hide(uint32_t TextBoxId);
 GUIErrorStatus GUITextBox_Draw(uint32_t TextBoxId);
 void GUITextBox_DrawAll();
@@ -386,6 +513,9 @@ GUIErrorStatus GUITextBox_AppendDataFromMemory(uint32_t TextBoxId, uint32_t NewE
 GUIErrorStatus GUITextBox_RefreshCurrentDataFromMemory(uint32_t TextBoxId);
 GUIErrorStatus GUITextBox_ChangeTextFormat(uint32_t TextBoxId, GUITextFormat NewFormat, GUITextFormatChangeStyle ChangeStyle);
 GUIErrorStatus GUITextBox_MoveDisplayedDataNumOfRows(uint32_t TextBoxId, int32_t NumOfRows);
+GUIErrorStatus GUITextBox_MoveDisplayedDataToPosition(uint32_t TextBoxId, uint32_t Position);
+GUIErrorStatus GUITextBox_MoveDisplayedDataToPendingPosition(uint32_t TextBoxId);
+GUIErrorStatus GUITextBox_SetPendingPosition(uint32_t TextBoxId, uint32_t Position);
 GUIErrorStatus GUITextBox_ClearDisplayedDataInBuffer(uint32_t TextBoxId);
 uint32_t GUITextBox_GetNumberForFirstDisplayedData(uint32_t TextBoxId);
 uint32_t GUITextBox_GetNumberForLastDisplayedData(uint32_t TextBoxId);
@@ -405,12 +535,13 @@ GUIErrorStatus GUITextBox_GetWritePosition(uint32_t TextBoxId, uint16_t* XPos, u
 GUIDisplayState GUITextBox_GetDisplayState(uint32_t TextBoxId);
 bool GUITextBox_IsScrolling(uint32_t TextBoxId);
 
-void GUITextBox_CheckAllActiveForTouchEventAt(GUITouchEvent Event, uint16_t XPos, uint16_t YPos);
+bool GUITextBox_CheckAllActiveForTouchEventAt(GUITouchEvent Event, uint16_t XPos, uint16_t YPos);
 
 
 /* Container functions =======================================================*/
 GUIContainer* GUIContainer_GetFromId(uint32_t ContainerId);
-GUIErrorStatus GUIContainer_Add(GUIContainer* Container);
+GUIErrorStatus GUIContainer_Add(const GUIContainerTemplate* Container);
+bool GUIContainer_IsAdded(uint32_t ContainerId);
 GUIErrorStatus GUIContainer_HideContent(uint32_t ContainerId);
 GUIErrorStatus GUIContainer_Hide(uint32_t ContainerId);
 GUIErrorStatus GUIContainer_Draw(uint32_t ContainerId);
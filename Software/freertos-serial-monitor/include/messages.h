@@ -34,10 +34,21 @@
 #include "task.h"
 
 /* Defines -------------------------------------------------------------------*/
+#define LCD_EVENT_QUEUE_SIZE					(10)	/* Max number of messages waiting for the LCD task */
+
+/* Packing of the coordinates and the event for touch messages */
+#define MESSAGES_TOUCH_PACK_POSITION(X, Y)		(((uint32_t)(Y) << 16) | ((X) & 0xFFFF))
+#define MESSAGES_TOUCH_PACK_EVENT(EVENT, POINT)	(((uint32_t)(POINT) << 8) | ((EVENT) & 0xFF))
+#define MESSAGES_TOUCH_X(DATA)					((uint16_t)((DATA) & 0xFFFF))
+#define MESSAGES_TOUCH_Y(DATA)					((uint16_t)((DATA) >> 16))
+#define MESSAGES_TOUCH_EVENT(DATA)				((uint8_t)((DATA) & 0xFF))
+#define MESSAGES_TOUCH_POINT(DATA)				((uint8_t)(((DATA) >> 8) & 0xFF))
+
 /* Typedefs ------------------------------------------------------------------*/
 typedef enum
 {
-	LCDEvent_TouchEvent,		/* data[0]=x, data[1]=y, data[2]=FT5206Event, data[3]=FT5206Point_n */
+	LCDEvent_TouchEvent,		/* data[0]=x and y packed, data[1]=FT5206Event and FT5206Point_n packed */
+	LCDEvent_TouchMove,			/* data[0]=number of the move, the latest position is read with FT5206_GetPendingMove */
 	LCDEvent_TemperatureData,	/* data[0]=temperature as a float */
 	LCDEvent_DebugMessage,		/* data[0]=timestamp in ticks, data[1]=pointer to the message */
 } LCDEvent;
@@ -45,7 +56,7 @@ typedef enum
 typedef struct
 {
 	LCDEvent event;
-	uint32_t data[8];
+	uint32_t data[2];
 } LCDEventMessage;
 
 /* Global Queues -------------------------------------------------------------*/
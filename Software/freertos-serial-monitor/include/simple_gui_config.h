@@ -68,14 +68,52 @@
 
 #define guiConfigMAX_NUM_OF_CHARACTERS_ON_DISPLAY	3000	/* 800/8 * 480/16 = 100 * 30 = 3000 */
 
+/* Max number of separate regions per layer that are waiting to be redrawn */
+#define guiConfigMAX_NUM_OF_DIRTY_REGIONS			8
+
+/*
+ * Text buffers for the text boxes that read from memory. A text box gets a block when it needs one and gives it
+ * back when it's hidden. Text boxes bigger than a block, or when all blocks are used, get memory from the heap.
+ */
+#define guiConfigTEXT_BUFFER_POOL_NUM_OF_BLOCKS		2
+#define guiConfigTEXT_BUFFER_POOL_BLOCK_SIZE		2048	/* The main text boxes need 1817 */
+
+/*
+ * Cache for the data text boxes read from memory, it's placed in CCM RAM. Only whole pages before the last valid
+ * byte are cached as they don't change until the addresses of the text box are reset.
+ */
+#define guiConfigREAD_CACHE_PAGE_SIZE			256		/* Must be a power of 2 */
+#define guiConfigREAD_CACHE_NUM_OF_PAGES		128
+#define guiConfigREAD_CACHE_READ_AHEAD_PAGES	4
+
+/* Scrollbar for text boxes that read from memory */
+#define guiConfigSCROLLBAR_WIDTH				12
+#define guiConfigSCROLLBAR_MIN_THUMB_HEIGHT		16
+#define guiConfigSCROLLBAR_TRACK_COLOR			GUI_CYAN_VERY_DARK
+#define guiConfigSCROLLBAR_THUMB_COLOR			GUI_GRAY
+
+/* Minimap of the saved data for text boxes that read from memory, drawn at most every MINIMAP_UPDATE_TIME ms */
+#define guiConfigMINIMAP_WIDTH					24
+#define guiConfigMINIMAP_MAX_NUM_OF_BUCKETS		64
+#define guiConfigMINIMAP_UPDATE_TIME			500
+#define guiConfigMINIMAP_BACKGROUND_COLOR		GUI_BLACK
+#define guiConfigMINIMAP_ACTIVITY_COLOR			GUI_CYAN
+#define guiConfigMINIMAP_ERROR_COLOR			GUI_RED
+#define guiConfigMINIMAP_DISPLAYED_COLOR		GUI_GRAY	/* Background of the rows that are displayed */
+
+/* Size of the grid used to find the objects at a touch position, 10x6 gives 80x80 pixel cells */
+#define guiConfigTOUCH_GRID_COLUMNS		10
+#define guiConfigTOUCH_GRID_ROWS		6
+
 /*
  * Object IDs:
- * 		0-199:		Buttons
+ * 		1-199:		Buttons
  * 		200-299:	Text box
  * 		300-399:	Containers
  * 		400-499:	Grids
+ * ID 0 is not used by any object so it marks unused entries in a GUIContainerTemplate and objects not added yet
  */
-#define guiConfigBUTTON_ID_OFFSET		0
+#define guiConfigBUTTON_ID_OFFSET		1
 #define guiConfigTEXT_BOX_ID_OFFSET		200
 #define guiConfigCONTAINER_ID_OFFSET	300
 #define guiConfigGRID_ID_OFFSET			400
@@ -123,6 +161,9 @@ typedef enum
 	GUIButtonId_Uart1Format,
 	GUIButtonId_Uart1Clear,
 	GUIButtonId_Uart1Debug,
+	GUIButtonId_Uart1SearchPattern,
+	GUIButtonId_Uart1SearchNext,
+	GUIButtonId_Uart1SearchPrevious,
 	GUIButtonId_Uart1SidebarBackwards,
 	GUIButtonId_Uart1SidebarForwards,
 
@@ -148,6 +189,9 @@ typedef enum
 	GUIButtonId_Uart2Format,
 	GUIButtonId_Uart2Clear,
 	GUIButtonId_Uart2Debug,
+	GUIButtonId_Uart2SearchPattern,
+	GUIButtonId_Uart2SearchNext,
+	GUIButtonId_Uart2SearchPrevious,
 	GUIButtonId_Uart2SidebarBackwards,
 	GUIButtonId_Uart2SidebarForwards,
 
@@ -173,6 +217,9 @@ typedef enum
 	GUIButtonId_Rs232Format,
 	GUIButtonId_Rs232Clear,
 	GUIButtonId_Rs232Debug,
+	GUIButtonId_Rs232SearchPattern,
+	GUIButtonId_Rs232SearchNext,
+	GUIButtonId_Rs232SearchPrevious,
 	GUIButtonId_Rs232SidebarBackwards,
 	GUIButtonId_Rs232SidebarForwards,
 
@@ -221,6 +268,17 @@ typedef enum
 	/* ADC */
 	GUIButtonId_AdcTop,
 	GUIButtonId_AdcEnable,
+	GUIButtonId_AdcSampleRate,
+	GUIButtonId_AdcView,
+	GUIButtonId_AdcFilter,
+	GUIButtonId_AdcTriggerMode,
+	GUIButtonId_AdcTriggerEdge,
+	GUIButtonId_AdcTriggerLevel,
+	GUIButtonId_AdcPreTrigger,
+	GUIButtonId_AdcSpectrumSize,
+	GUIButtonId_AdcSpectrumAverages,
+	GUIButtonId_AdcSidebarBackwards,
+	GUIButtonId_AdcSidebarForwards,
 
 	/* SYSTEM */
 	GUIButtonId_System,
@@ -233,6 +291,26 @@ typedef enum
 	GUIButtonId_ScreenBrightnessUp,
 	GUIButtonId_ScreenBrightnessDown,
 
+	/* SEARCH */
+	GUIButtonId_SearchKey0,
+	GUIButtonId_SearchKey1,
+	GUIButtonId_SearchKey2,
+	GUIButtonId_SearchKey3,
+	GUIButtonId_SearchKey4,
+	GUIButtonId_SearchKey5,
+	GUIButtonId_SearchKey6,
+	GUIButtonId_SearchKey7,
+	GUIButtonId_SearchKey8,
+	GUIButtonId_SearchKey9,
+	GUIButtonId_SearchKeyA,
+	GUIButtonId_SearchKeyB,
+	GUIButtonId_SearchKeyC,
+	GUIButtonId_SearchKeyD,
+	GUIButtonId_SearchKeyE,
+	GUIButtonId_SearchKeyF,
+	GUIButtonId_SearchDelete,
+	GUIButtonId_SearchClear,
+
 	/* The last item will represent how many buttons there are in total */
 	GUIButtonId_NumberOfButtons,
 } GUIButtonId;
@@ -258,6 +336,8 @@ typedef enum
 	GUITextBoxId_GpioLabel,
 	GUITextBoxId_AdcLabel,
 	GUITextBoxId_SystemLabel,
+	GUITextBoxId_SystemReadCache,
+	GUITextBoxId_SystemStats,
 
 
 	/* CAN1 */
@@ -301,6 +381,14 @@ typedef enum
 	/* ADC */
 	GUITextBoxId_Adc0Value,
 	GUITextBoxId_Adc1Value,
+	GUITextBoxId_AdcStatus,
+	GUITextBoxId_AdcTotalStatistics,
+	GUITextBoxId_AdcWindowStatistics,
+	GUITextBoxId_AdcScopeStatus,
+	GUITextBoxId_AdcSpectrumStatus,
+
+	/* SEARCH */
+	GUITextBoxId_SearchPattern,
 
 	/* The last item will represent how many text boxes there are in total */
 	GUITextBoxId_NumberOfTextBoxes,
@@ -339,6 +427,7 @@ typedef enum
 	GUIContainerId_PopoutGpio0Type,
 	GUIContainerId_PopoutGpio1Type,
 	GUIContainerId_PopoutScreenBrightness,
+	GUIContainerId_PopoutSearch,
 
 	GUIContainerId_Can1MainContent,
 	GUIContainerId_Can2MainContent,
@@ -355,6 +444,11 @@ typedef enum
 
 #define guiConfigNUMBER_OF_CONTAINERS (GUIContainerId_NumberOfContainers - guiConfigCONTAINER_ID_OFFSET)
 
+/* Max number of objects of each type in one container, only used by GUIContainerTemplate */
+#define guiConfigMAX_NUM_OF_BUTTONS_IN_CONTAINER		18
+#define guiConfigMAX_NUM_OF_TEXT_BOXES_IN_CONTAINER		8
+#define guiConfigMAX_NUM_OF_CONTAINERS_IN_CONTAINER		8
+
 
 /* Main container pages */
 #define guiConfigMAIN_CONTAINER_EMPTY_PAGE				GUIContainerPage_1
@@ -51,6 +51,7 @@
 #define FLASH_ADR_THERM_DATA		(0x810000)
 
 #define FLASH_CHANNEL_DATA_SIZE		(0x100000)
+#define FLASH_CHANNEL_SUMMARY_OFFSET	(0x0F0000)	/* The last sector of a UART channel holds the search summaries, log data ends here */
 
 /* Typedefs ------------------------------------------------------------------*/
 /* Function prototypes -------------------------------------------------------*/
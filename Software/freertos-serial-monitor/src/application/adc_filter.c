@@ -0,0 +1,317 @@
+/**
+ ******************************************************************************
+ * @file	adc_filter.c
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-18
+ * @brief	Optional filter stage for the acquired ADC samples.
+ *
+ *			The blocks are filtered in place before they are used for the
+ *			statistics, the scope and the FLASH log. The FIR uses the dual
+ *			16-bit multiply-accumulate of the M4 and the notch a 64-bit
+ *			accumulator so it stays stable far below the sample rate.
+ *			The coefficients are designed in double when the filter is
+ *			selected, never per sample.
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "adc_filter.h"
+
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define PI						(3.14159265358979)
+#define NOTCH_Q					(5.0)		/* Center frequency divided by the -3 dB bandwidth */
+#define BIQUAD_EXTRA_BITS		(13)		/* Low notches have poles close to 1 and amplify the state rounding */
+#define AVERAGE_SHIFT			(4)			/* log2(ADC_FILTER_AVERAGE_LENGTH) */
+#define MIN_CUTOFF				(0.001)	/* Low-pass cutoff limits relative to the sample rate */
+#define MAX_CUTOFF				(0.45)
+
+/* Private typedefs ----------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void prvDesignLowPass(ADCFilter* pFilter, double Cutoff);
+static void prvDesignNotch(ADCFilter* pFilter, double Frequency);
+static void prvMovingAverage(ADCFilter* pFilter, int16_t* pSamples, uint32_t NumOfSamples);
+static void prvLowPass(ADCFilter* pFilter, int16_t* pSamples, uint32_t NumOfSamples);
+static void prvNotch(ADCFilter* pFilter, int16_t* pSamples, uint32_t NumOfSamples);
+static inline uint32_t prvReadPair(const int16_t* pData);
+static double prvSine(double X);
+
+/* Functions -----------------------------------------------------------------*/
+/**
+ * @brief	Selects a filter and clears its history
+ * @param	pFilter: The filter
+ * @param	Type: Any value of ADCFilterType
+ * @param	SampleRate: The sample rate in Hz
+ * @param	Cutoff: Cutoff frequency in Hz, only used by ADCFilterType_LowPass
+ * @retval	None
+ */
+void adcFilterInit(ADCFilter* pFilter, ADCFilterType Type, uint32_t SampleRate, uint32_t Cutoff)
+{
+	memset(pFilter, 0, sizeof(ADCFilter));
+	pFilter->type = Type;
+
+	if (SampleRate == 0)
+		pFilter->type = ADCFilterType_None;
+	else if (Type == ADCFilterType_LowPass)
+		prvDesignLowPass(pFilter, (double)Cutoff / SampleRate);
+	else if (Type == ADCFilterType_Notch50Hz)
+		prvDesignNotch(pFilter, 50.0 / SampleRate);
+	else if (Type == ADCFilterType_Notch60Hz)
+		prvDesignNotch(pFilter, 60.0 / SampleRate);
+}
+
+/**
+ * @brief	Filters a block of samples in place, the history is kept between the blocks
+ * @param	pFilter: The filter
+ * @param	pSamples: The samples
+ * @param	NumOfSamples: Number of samples
+ * @retval	None
+ */
+void adcFilterProcess(ADCFilter* pFilter, int16_t* pSamples, uint32_t NumOfSamples)
+{
+	switch (pFilter->type)
+	{
+		case ADCFilterType_MovingAverage:
+			prvMovingAverage(pFilter, pSamples, NumOfSamples);
+			break;
+		case ADCFilterType_LowPass:
+			/* The FIR state only has room for ADC_FILTER_MAX_BLOCK_SIZE new samples */
+			while (NumOfSamples != 0)
+			{
+				uint32_t numOfSamples = NumOfSamples;
+				if (numOfSamples > ADC_FILTER_MAX_BLOCK_SIZE)
+					numOfSamples = ADC_FILTER_MAX_BLOCK_SIZE;
+				prvLowPass(pFilter, pSamples, numOfSamples);
+				pSamples += numOfSamples;
+				NumOfSamples -= numOfSamples;
+			}
+			break;
+		case ADCFilterType_Notch50Hz:
+		case ADCFilterType_Notch60Hz:
+			prvNotch(pFilter, pSamples, NumOfSamples);
+			break;
+		default:
+			break;
+	}
+}
+
+/* Private functions .--------------------------------------------------------*/
+/**
+ * @brief	Designs a Hamming windowed sinc low-pass with unity gain at DC
+ * @param	pFilter: The filter
+ * @param	Cutoff: Cutoff frequency relative to the sample rate
+ * @retval	None
+ */
+static void prvDesignLowPass(ADCFilter* pFilter, double Cutoff)
+{
+	if (Cutoff < MIN_CUTOFF)
+		Cutoff = MIN_CUTOFF;
+	else if (Cutoff > MAX_CUTOFF)
+		Cutoff = MAX_CUTOFF;
+
+	double taps[ADC_FILTER_NUM_OF_TAPS];
+	double sum = 0.0;
+	for (uint32_t i = 0; i < ADC_FILTER_NUM_OF_TAPS; i++)
+	{
+		/* The number of taps is even so the center is between two taps and t is never 0 */
+		double t = i - (ADC_FILTER_NUM_OF_TAPS - 1) / 2.0;
+		double window = 0.54 - 0.46 * prvSine(2.0 * PI * i / (ADC_FILTER_NUM_OF_TAPS - 1) + PI / 2.0);
+		taps[i] = prvSine(2.0 * PI * Cutoff * t) / (PI * t) * window;
+		sum += taps[i];
+	}
+
+	/* Normalize, quantize and store them reversed so the newest sample is multiplied with the last coefficient */
+	for (uint32_t i = 0; i < ADC_FILTER_NUM_OF_TAPS; i++)
+	{
+		double value = taps[i] / sum * 32768.0;
+		int32_t coefficient = (int32_t)(value < 0.0 ? value - 0.5 : value + 0.5);
+		if (coefficient > INT16_MAX)
+			coefficient = INT16_MAX;
+		else if (coefficient < INT16_MIN)
+			coefficient = INT16_MIN;
+		pFilter->firCoefficients[ADC_FILTER_NUM_OF_TAPS - 1 - i] = (int16_t)coefficient;
+	}
+}
+
+/**
+ * @brief	Designs a notch biquad (RBJ cookbook) with unity gain outside the notch
+ * @param	pFilter: The filter
+ * @param	Frequency: Notch frequency relative to the sample rate
+ * @retval	None
+ */
+static void prvDesignNotch(ADCFilter* pFilter, double Frequency)
+{
+	/* A notch above the Nyquist frequency would just attenuate something else */
+	if (Frequency >= 0.5)
+	{
+		pFilter->type = ADCFilterType_None;
+		return;
+	}
+
+	double omega = 2.0 * PI * Frequency;
+	double cosine = prvSine(omega + PI / 2.0);
+	double alpha = prvSine(omega) / (2.0 * NOTCH_Q);
+	double a0 = 1.0 + alpha;
+	double coefficients[5] = {
+			1.0 / a0,					/* b0 */
+			-2.0 * cosine / a0,			/* b1 */
+			1.0 / a0,					/* b2 */
+			-2.0 * cosine / a0,			/* a1 */
+			(1.0 - alpha) / a0,			/* a2 */
+	};
+
+	for (uint32_t i = 0; i < 5; i++)
+	{
+		double value = coefficients[i] * 1073741824.0;	/* 2^30 */
+		pFilter->biquadCoefficients[i] = (int32_t)(value < 0.0 ? value - 0.5 : value + 0.5);
+	}
+}
+
+/**
+ * @brief	Moving average with a running sum, a few cycles per sample independent of the length
+ * @param	pFilter: The filter
+ * @param	pSamples: The samples
+ * @param	NumOfSamples: Number of samples
+ * @retval	None
+ */
+static void prvMovingAverage(ADCFilter* pFilter, int16_t* pSamples, uint32_t NumOfSamples)
+{
+	int32_t sum = pFilter->averageSum;
+	uint32_t index = pFilter->averageIndex;
+	for (uint32_t i = 0; i < NumOfSamples; i++)
+	{
+		sum += pSamples[i] - pFilter->averageHistory[index];
+		pFilter->averageHistory[index] = pSamples[i];
+		index = (index + 1) & (ADC_FILTER_AVERAGE_LENGTH - 1);
+		pSamples[i] = (int16_t)(sum >> AVERAGE_SHIFT);
+	}
+	pFilter->averageSum = sum;
+	pFilter->averageIndex = index;
+}
+
+/**
+ * @brief	Q15 FIR, two outputs are calculated per loop so that every coefficient pair is only loaded once
+ * @param	pFilter: The filter
+ * @param	pSamples: The samples
+ * @param	NumOfSamples: Number of samples, at most ADC_FILTER_MAX_BLOCK_SIZE
+ * @retval	None
+ */
+static void prvLowPass(ADCFilter* pFilter, int16_t* pSamples, uint32_t NumOfSamples)
+{
+	/* The new samples are placed after the history so each output is a straight dot product */
+	int16_t* pState = pFilter->firState;
+	memcpy(&pState[ADC_FILTER_NUM_OF_TAPS - 1], pSamples, NumOfSamples * sizeof(int16_t));
+
+	const int16_t* pCoefficients = pFilter->firCoefficients;
+	uint32_t i = 0;
+	for (; i + 1 < NumOfSamples; i += 2)
+	{
+		int32_t acc0 = 0;
+		int32_t acc1 = 0;
+		for (uint32_t tap = 0; tap < ADC_FILTER_NUM_OF_TAPS; tap += 2)
+		{
+			uint32_t coefficients = prvReadPair(&pCoefficients[tap]);
+			acc0 = (int32_t)__SMLAD(coefficients, prvReadPair(&pState[i + tap]), (uint32_t)acc0);
+			acc1 = (int32_t)__SMLAD(coefficients, prvReadPair(&pState[i + 1 + tap]), (uint32_t)acc1);
+		}
+		pSamples[i] = (int16_t)__SSAT((acc0 + (1 << 14)) >> 15, 16);
+		pSamples[i + 1] = (int16_t)__SSAT((acc1 + (1 << 14)) >> 15, 16);
+	}
+	for (; i < NumOfSamples; i++)
+	{
+		int32_t acc = 0;
+		for (uint32_t tap = 0; tap < ADC_FILTER_NUM_OF_TAPS; tap += 2)
+			acc = (int32_t)__SMLAD(prvReadPair(&pCoefficients[tap]), prvReadPair(&pState[i + tap]), (uint32_t)acc);
+		pSamples[i] = (int16_t)__SSAT((acc + (1 << 14)) >> 15, 16);
+	}
+
+	/* Keep the newest samples as history for the next block */
+	memmove(pState, &pState[NumOfSamples], (ADC_FILTER_NUM_OF_TAPS - 1) * sizeof(int16_t));
+}
+
+/**
+ * @brief	Direct form I biquad with Q30 coefficients and a 64-bit accumulator
+ * @param	pFilter: The filter
+ * @param	pSamples: The samples
+ * @param	NumOfSamples: Number of samples
+ * @retval	None
+ */
+static void prvNotch(ADCFilter* pFilter, int16_t* pSamples, uint32_t NumOfSamples)
+{
+	const int32_t* c = pFilter->biquadCoefficients;
+	int32_t x1 = pFilter->biquadState[0];
+	int32_t x2 = pFilter->biquadState[1];
+	int32_t y1 = pFilter->biquadState[2];
+	int32_t y2 = pFilter->biquadState[3];
+
+	for (uint32_t i = 0; i < NumOfSamples; i++)
+	{
+		int32_t x0 = (int32_t)pSamples[i] << BIQUAD_EXTRA_BITS;
+		int64_t acc = (int64_t)c[0] * x0 + (int64_t)c[1] * x1 + (int64_t)c[2] * x2 -
+					  (int64_t)c[3] * y1 - (int64_t)c[4] * y2;
+		int32_t y0 = (int32_t)((acc + (1 << 29)) >> 30);
+
+		x2 = x1;
+		x1 = x0;
+		y2 = y1;
+		y1 = y0;
+		pSamples[i] = (int16_t)__SSAT((y0 + (1 << (BIQUAD_EXTRA_BITS - 1))) >> BIQUAD_EXTRA_BITS, 16);
+	}
+
+	pFilter->biquadState[0] = x1;
+	pFilter->biquadState[1] = x2;
+	pFilter->biquadState[2] = y1;
+	pFilter->biquadState[3] = y2;
+}
+
+/**
+ * @brief	Read two 16-bit values as one word, the M4 handles the unaligned access
+ * @param	pData: Pointer to the first value
+ * @retval	The first value in the lower half and the second in the upper half
+ */
+static inline uint32_t prvReadPair(const int16_t* pData)
+{
+	uint32_t pair;
+	memcpy(&pair, pData, sizeof(uint32_t));
+	return pair;
+}
+
+/**
+ * @brief	Sine without the math library, only used when the coefficients are designed
+ * @param	X: Angle in radians
+ * @retval	sin(X)
+ */
+static double prvSine(double X)
+{
+	/* Reduce to -PI..PI and then to -PI/2..PI/2 where the series converges fast */
+	int32_t turns = (int32_t)(X / (2.0 * PI) + (X < 0.0 ? -0.5 : 0.5));
+	X -= turns * 2.0 * PI;
+	if (X > PI / 2.0)
+		X = PI - X;
+	else if (X < -PI / 2.0)
+		X = -PI - X;
+
+	/* Taylor series up to x^15, plenty for Q30 coefficients */
+	double x2 = X * X;
+	return X * (1.0 - x2 / 6.0 * (1.0 - x2 / 20.0 * (1.0 - x2 / 42.0 * (1.0 - x2 / 72.0 * (1.0 - x2 / 110.0 * (1.0 - x2 / 156.0 * (1.0 - x2 / 210.0)))))));
+}
+
+/* Interrupt Handlers --------------------------------------------------------*/
@@ -0,0 +1,294 @@
+/**
+ ******************************************************************************
+ * @file	adc_scope.c
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-18
+ * @brief	Oscilloscope capture on the acquired ADC samples.
+ *
+ *			Every sample goes into a ring of the last frame so the samples
+ *			before the trigger are always available. When enough samples
+ *			have been collected after the trigger the frame is reduced to
+ *			the min and max of every pixel column, so drawing it costs the
+ *			same no matter how many samples there are.
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "adc_scope.h"
+
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define RING_MASK		(ADC_SCOPE_FRAME_SIZE - 1)
+
+/* Private typedefs ----------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void prvArm(ADCScope* pScope);
+static bool prvCheckEdge(ADCScope* pScope, int32_t Sample);
+static void prvFinishFrame(ADCScope* pScope);
+
+/* Functions -----------------------------------------------------------------*/
+/**
+ * @brief	Resets the scope to the stopped state
+ * @param	pScope: The scope to reset
+ * @retval	None
+ */
+void adcScopeReset(ADCScope* pScope)
+{
+	memset(pScope, 0, sizeof(ADCScope));
+	pScope->state = ADCScopeState_Stopped;
+}
+
+/**
+ * @brief	Starts capturing with new settings
+ * @param	pScope: The scope
+ * @param	pSettings: The settings to use
+ * @retval	None
+ */
+void adcScopeStart(ADCScope* pScope, const ADCScopeSettings* pSettings)
+{
+	pScope->settings = *pSettings;
+	if (pScope->settings.preTriggerDepth >= ADC_SCOPE_FRAME_SIZE)
+		pScope->settings.preTriggerDepth = ADC_SCOPE_FRAME_SIZE - 1;
+
+	pScope->hasTriggered = false;
+	pScope->edgeIsArmed = false;
+	prvArm(pScope);
+}
+
+/**
+ * @brief	Stops capturing, the last frame is kept
+ * @param	pScope: The scope
+ * @retval	None
+ */
+void adcScopeStop(ADCScope* pScope)
+{
+	pScope->state = ADCScopeState_Stopped;
+}
+
+/**
+ * @brief	Get the state of the scope
+ * @param	pScope: The scope
+ * @retval	The state
+ */
+ADCScopeState adcScopeGetState(ADCScope* pScope)
+{
+	return pScope->state;
+}
+
+/**
+ * @brief	Runs the trigger on a block of samples
+ * @param	pScope: The scope
+ * @param	pSamples: The samples
+ * @param	NumOfSamples: Number of samples
+ * @param	FirstSampleNumber: Number of the first sample counted from the start of the acquisition
+ * @retval	None
+ */
+void adcScopeAddBlock(ADCScope* pScope, const int16_t* pSamples, uint32_t NumOfSamples, uint32_t FirstSampleNumber)
+{
+	if (pScope->state == ADCScopeState_Stopped || pScope->state == ADCScopeState_Done)
+		return;
+
+	/* A frame can't span samples that were lost so start over if there is a gap */
+	if (FirstSampleNumber != pScope->nextSampleNumber)
+	{
+		pScope->edgeIsArmed = false;
+		pScope->hasTriggered = false;
+		prvArm(pScope);
+	}
+	pScope->nextSampleNumber = FirstSampleNumber + NumOfSamples;
+
+	for (uint32_t i = 0; i < NumOfSamples && pScope->state != ADCScopeState_Done; i++)
+	{
+		int32_t sample = pSamples[i];
+		pScope->ring[pScope->writeIndex] = (int16_t)sample;
+		pScope->writeIndex = (pScope->writeIndex + 1) & RING_MASK;
+
+		bool edge = prvCheckEdge(pScope, sample);
+
+		switch (pScope->state)
+		{
+			case ADCScopeState_Filling:
+				if (++pScope->numOfSamplesSinceArm >= pScope->settings.preTriggerDepth)
+					pScope->state = ADCScopeState_Armed;
+				break;
+
+			case ADCScopeState_Armed:
+			{
+				uint32_t sampleNumber = FirstSampleNumber + i;
+				pScope->numOfSamplesSinceArm++;
+
+				/* Edges inside the holdoff are ignored */
+				if (edge && pScope->hasTriggered &&
+					sampleNumber - pScope->lastTriggerSampleNumber < pScope->settings.holdoff)
+					edge = false;
+
+				pScope->forcedTrigger = false;
+				if (!edge && pScope->settings.mode == ADCScopeMode_Auto &&
+					pScope->numOfSamplesSinceArm - pScope->settings.preTriggerDepth >= pScope->settings.autoTimeout)
+				{
+					edge = true;
+					pScope->forcedTrigger = true;
+				}
+
+				if (edge)
+				{
+					pScope->hasTriggered = true;
+					pScope->lastTriggerSampleNumber = sampleNumber;
+					pScope->numOfSamplesLeft = ADC_SCOPE_FRAME_SIZE - pScope->settings.preTriggerDepth - 1;
+					pScope->state = ADCScopeState_Capturing;
+					if (pScope->numOfSamplesLeft == 0)
+						prvFinishFrame(pScope);
+				}
+				break;
+			}
+
+			case ADCScopeState_Capturing:
+				if (--pScope->numOfSamplesLeft == 0)
+					prvFinishFrame(pScope);
+				break;
+
+			default:
+				break;
+		}
+	}
+}
+
+/**
+ * @brief	Get the latest frame
+ * @param	pScope: The scope
+ * @param	ppFrame: Will point to the frame
+ * @retval	true if the frame hasn't been released yet, release it with adcScopeReleaseFrame when it's drawn
+ * @retval	false if it's the same frame as before
+ */
+bool adcScopeGetFrame(ADCScope* pScope, const ADCScopeFrame** ppFrame)
+{
+	*ppFrame = &pScope->frame;
+	return pScope->frameIsNew;
+}
+
+/**
+ * @brief	Tell the scope that the frame has been drawn so that it can be replaced by the next one
+ * @param	pScope: The scope
+ * @retval	None
+ */
+void adcScopeReleaseFrame(ADCScope* pScope)
+{
+	pScope->frameIsNew = false;
+}
+
+/* Private functions .--------------------------------------------------------*/
+/**
+ * @brief	Starts collecting the pre-trigger samples
+ * @param	pScope: The scope
+ * @retval	None
+ */
+static void prvArm(ADCScope* pScope)
+{
+	pScope->numOfSamplesSinceArm = 0;
+	if (pScope->settings.preTriggerDepth == 0)
+		pScope->state = ADCScopeState_Armed;
+	else
+		pScope->state = ADCScopeState_Filling;
+}
+
+/**
+ * @brief	Checks if a sample completes an edge through the level
+ * @param	pScope: The scope
+ * @param	Sample: The sample
+ * @retval	true if it's an edge
+ * @retval	false if not
+ */
+static bool prvCheckEdge(ADCScope* pScope, int32_t Sample)
+{
+	int32_t level = pScope->settings.level;
+	int32_t hysteresis = pScope->settings.hysteresis;
+
+	if (pScope->settings.edge == ADCScopeEdge_Rising)
+	{
+		if (Sample <= level - hysteresis)
+			pScope->edgeIsArmed = true;
+		else if (pScope->edgeIsArmed && Sample >= level)
+		{
+			pScope->edgeIsArmed = false;
+			return true;
+		}
+	}
+	else
+	{
+		if (Sample >= level + hysteresis)
+			pScope->edgeIsArmed = true;
+		else if (pScope->edgeIsArmed && Sample <= level)
+		{
+			pScope->edgeIsArmed = false;
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief	Decimates the ring to the frame and arms again unless it's single shot
+ * @param	pScope: The scope
+ * @retval	None
+ * @note	If the previous frame hasn't been drawn yet the new one is dropped
+ */
+static void prvFinishFrame(ADCScope* pScope)
+{
+	if (!pScope->frameIsNew)
+	{
+		ADCScopeFrame* pFrame = &pScope->frame;
+
+		/* The ring holds exactly one frame and the write index points at its oldest sample */
+		uint32_t start = pScope->writeIndex;
+		for (uint32_t column = 0; column < ADC_SCOPE_NUM_OF_COLUMNS; column++)
+		{
+			uint32_t from = column * ADC_SCOPE_FRAME_SIZE / ADC_SCOPE_NUM_OF_COLUMNS;
+			uint32_t to = (column + 1) * ADC_SCOPE_FRAME_SIZE / ADC_SCOPE_NUM_OF_COLUMNS;
+			if (to == from)
+				to = from + 1;
+
+			int16_t min = INT16_MAX;
+			int16_t max = INT16_MIN;
+			for (uint32_t i = from; i < to; i++)
+			{
+				int16_t sample = pScope->ring[(start + i) & RING_MASK];
+				if (sample < min)
+					min = sample;
+				if (sample > max)
+					max = sample;
+			}
+			pFrame->min[column] = min;
+			pFrame->max[column] = max;
+		}
+
+		pFrame->triggerColumn = pScope->settings.preTriggerDepth * ADC_SCOPE_NUM_OF_COLUMNS / ADC_SCOPE_FRAME_SIZE;
+		pFrame->triggered = !pScope->forcedTrigger;
+		pFrame->frameNumber++;
+		pScope->frameIsNew = true;
+	}
+
+	if (pScope->settings.mode == ADCScopeMode_Single)
+		pScope->state = ADCScopeState_Done;
+	else
+		prvArm(pScope);
+}
+
+/* Interrupt Handlers --------------------------------------------------------*/
@@ -0,0 +1,429 @@
+/**
+ ******************************************************************************
+ * @file	adc_spectrum.c
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-18
+ * @brief	Spectrum of the acquired ADC samples.
+ *
+ *			The samples are windowed straight into the transform buffer in
+ *			bit reversed order. The real transform is done as a complex
+ *			transform of half the size in Q31 that is scaled down by 2 in
+ *			every stage so it can't overflow. The work is split into steps
+ *			of at most one stage each so the caller can let other tasks run
+ *			in between, the GUI would otherwise stall for the whole transform.
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "adc_spectrum.h"
+
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define QUARTER				(ADC_SPECTRUM_MAX_SIZE / 4)
+#define INPUT_SHIFT			(18)		/* Sample * Q31 window -> 28 bits, leaves room for the growth in the split */
+#define FULL_SCALE_LOG2		(54 * 256)	/* log2 of the power of a full scale sine in one bin in Q8 */
+#define PEAK_MIN_BIN		(2)			/* DC leaks into the first bin through the window */
+
+/* Private typedefs ----------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void prvCollect(ADCSpectrum* pSpectrum, int32_t Sample);
+static void prvTransformStage(ADCSpectrum* pSpectrum, uint32_t Stage);
+static void prvSplitAndAverage(ADCSpectrum* pSpectrum);
+static void prvFinishFrame(ADCSpectrum* pSpectrum);
+static int32_t prvCosine(ADCSpectrum* pSpectrum, uint32_t Index);
+static int32_t prvSine(ADCSpectrum* pSpectrum, uint32_t Index);
+static int16_t prvLevel(uint64_t Power);
+static uint32_t prvLog2(uint32_t Value);
+
+/* Functions -----------------------------------------------------------------*/
+/**
+ * @brief	Resets the spectrum to the stopped state and builds the sine table
+ * @param	pSpectrum: The spectrum to reset
+ * @retval	None
+ */
+void adcSpectrumReset(ADCSpectrum* pSpectrum)
+{
+	memset(pSpectrum, 0, sizeof(ADCSpectrum));
+	pSpectrum->state = ADCSpectrumState_Stopped;
+
+	/* sin((k + 1) * a) = 2 * cos(a) * sin(k * a) - sin((k - 1) * a), the series for the small angle a are exact in double */
+	double angle = 2.0 * 3.14159265358979 / ADC_SPECTRUM_MAX_SIZE;
+	double a2 = angle * angle;
+	double twoCosine = 2.0 * (1.0 - a2 / 2.0 * (1.0 - a2 / 12.0 * (1.0 - a2 / 30.0)));
+	double previous = 0.0;
+	double current = angle * (1.0 - a2 / 6.0 * (1.0 - a2 / 20.0 * (1.0 - a2 / 42.0)));
+	pSpectrum->sine[0] = 0;
+	for (uint32_t i = 1; i <= QUARTER; i++)
+	{
+		double value = current * 2147483648.0 + 0.5;
+		pSpectrum->sine[i] = (value >= 2147483647.0) ? INT32_MAX : (int32_t)value;
+		double next = twoCosine * current - previous;
+		previous = current;
+		current = next;
+	}
+}
+
+/**
+ * @brief	Starts collecting samples with new settings, the averaging starts over
+ * @param	pSpectrum: The spectrum
+ * @param	pSettings: The settings to use
+ * @retval	SUCCESS: Started
+ * @retval	ERROR: The size or the number of averages is not a power of 2 in the allowed range
+ */
+ErrorStatus adcSpectrumStart(ADCSpectrum* pSpectrum, const ADCSpectrumSettings* pSettings)
+{
+	uint32_t size = pSettings->size;
+	uint32_t numOfAverages = pSettings->numOfAverages;
+	if (size < ADC_SPECTRUM_MIN_SIZE || size > ADC_SPECTRUM_MAX_SIZE || (size & (size - 1)) != 0 ||
+		numOfAverages == 0 || numOfAverages > ADC_SPECTRUM_MAX_NUM_OF_AVERAGES || (numOfAverages & (numOfAverages - 1)) != 0)
+		return ERROR;
+
+	pSpectrum->settings = *pSettings;
+	pSpectrum->log2Size = prvLog2(size);
+	pSpectrum->numOfTransforms = 0;
+	pSpectrum->numOfCollectedSamples = 0;
+	pSpectrum->state = ADCSpectrumState_Collecting;
+	return SUCCESS;
+}
+
+/**
+ * @brief	Stops the spectrum, the last frame is kept
+ * @param	pSpectrum: The spectrum
+ * @retval	None
+ */
+void adcSpectrumStop(ADCSpectrum* pSpectrum)
+{
+	pSpectrum->state = ADCSpectrumState_Stopped;
+}
+
+/**
+ * @brief	Get the state of the spectrum
+ * @param	pSpectrum: The spectrum
+ * @retval	The state
+ */
+ADCSpectrumState adcSpectrumGetState(ADCSpectrum* pSpectrum)
+{
+	return pSpectrum->state;
+}
+
+/**
+ * @brief	Collects samples for the next transform, samples that arrive during a transform are skipped
+ * @param	pSpectrum: The spectrum
+ * @param	pSamples: The samples
+ * @param	NumOfSamples: Number of samples
+ * @param	FirstSampleNumber: Number of the first sample counted from the start of the acquisition
+ * @param	SampleRate: The sample rate in Hz
+ * @retval	None
+ */
+void adcSpectrumAddBlock(ADCSpectrum* pSpectrum, const int16_t* pSamples, uint32_t NumOfSamples, uint32_t FirstSampleNumber, uint32_t SampleRate)
+{
+	if (pSpectrum->state != ADCSpectrumState_Collecting)
+		return;
+
+	/* A transform can't span samples that were lost so start over if there is a gap */
+	if (pSpectrum->numOfCollectedSamples != 0 && FirstSampleNumber != pSpectrum->nextSampleNumber)
+		pSpectrum->numOfCollectedSamples = 0;
+	pSpectrum->nextSampleNumber = FirstSampleNumber + NumOfSamples;
+
+	/* The averages don't mean anything if the sample rate has changed */
+	if (SampleRate != pSpectrum->sampleRate)
+	{
+		pSpectrum->sampleRate = SampleRate;
+		pSpectrum->numOfTransforms = 0;
+		pSpectrum->numOfCollectedSamples = 0;
+	}
+
+	for (uint32_t i = 0; i < NumOfSamples; i++)
+	{
+		prvCollect(pSpectrum, pSamples[i]);
+		if (pSpectrum->numOfCollectedSamples == pSpectrum->settings.size)
+		{
+			pSpectrum->step = 0;
+			pSpectrum->state = ADCSpectrumState_Transforming;
+			break;
+		}
+	}
+}
+
+/**
+ * @brief	Does the next step of the transform: one stage, the split into the real spectrum or the frame
+ * @param	pSpectrum: The spectrum
+ * @retval	None
+ * @note	Call it until the state is no longer ADCSpectrumState_Transforming, every step touches the
+ * 			buffer at most size / 2 times
+ */
+void adcSpectrumProcess(ADCSpectrum* pSpectrum)
+{
+	if (pSpectrum->state != ADCSpectrumState_Transforming)
+		return;
+
+	uint32_t numOfStages = pSpectrum->log2Size - 1;
+	if (pSpectrum->step < numOfStages)
+		prvTransformStage(pSpectrum, pSpectrum->step);
+	else if (pSpectrum->step == numOfStages)
+		prvSplitAndAverage(pSpectrum);
+	else
+	{
+		prvFinishFrame(pSpectrum);
+		pSpectrum->numOfCollectedSamples = 0;
+		pSpectrum->state = ADCSpectrumState_Collecting;
+	}
+	pSpectrum->step++;
+}
+
+/**
+ * @brief	Get the latest frame
+ * @param	pSpectrum: The spectrum
+ * @param	ppFrame: Will point to the frame
+ * @retval	true if the frame hasn't been released yet, release it with adcSpectrumReleaseFrame when it's drawn
+ * @retval	false if it's the same frame as before
+ */
+bool adcSpectrumGetFrame(ADCSpectrum* pSpectrum, const ADCSpectrumFrame** ppFrame)
+{
+	*ppFrame = &pSpectrum->frame;
+	return pSpectrum->frameIsNew;
+}
+
+/**
+ * @brief	Tell the spectrum that the frame has been drawn so that it can be replaced by the next one
+ * @param	pSpectrum: The spectrum
+ * @retval	None
+ */
+void adcSpectrumReleaseFrame(ADCSpectrum* pSpectrum)
+{
+	pSpectrum->frameIsNew = false;
+}
+
+/* Private functions .--------------------------------------------------------*/
+/**
+ * @brief	Window a sample and put it in bit reversed order, even samples are real and odd are imaginary
+ * @param	pSpectrum: The spectrum
+ * @param	Sample: The sample
+ * @retval	None
+ */
+static void prvCollect(ADCSpectrum* pSpectrum, int32_t Sample)
+{
+	uint32_t n = pSpectrum->numOfCollectedSamples++;
+
+	/* Hann window, 0.5 - 0.5 * cos(2 * pi * n / size) in Q31 */
+	int32_t cosine = prvCosine(pSpectrum, n * (ADC_SPECTRUM_MAX_SIZE >> pSpectrum->log2Size));
+	uint32_t window = ((uint32_t)INT32_MAX - (uint32_t)cosine) >> 1;
+	int32_t value = (int32_t)(((int64_t)Sample * window) >> INPUT_SHIFT);
+
+	uint32_t index = __RBIT(n >> 1) >> (33 - pSpectrum->log2Size);
+	pSpectrum->buffer[2 * index + (n & 1)] = value;
+}
+
+/**
+ * @brief	One radix-2 decimation in time stage with the result scaled down by 2
+ * @param	pSpectrum: The spectrum
+ * @param	Stage: The stage, 0 to log2(size / 2) - 1
+ * @retval	None
+ */
+static void prvTransformStage(ADCSpectrum* pSpectrum, uint32_t Stage)
+{
+	int32_t* pBuffer = pSpectrum->buffer;
+	uint32_t numOfPoints = pSpectrum->settings.size / 2;
+	uint32_t half = 1 << Stage;
+	uint32_t twiddleStep = ADC_SPECTRUM_MAX_SIZE >> (Stage + 1);
+
+	for (uint32_t j = 0; j < half; j++)
+	{
+		int32_t cosine = prvCosine(pSpectrum, j * twiddleStep);
+		int32_t sine = prvSine(pSpectrum, j * twiddleStep);
+		for (uint32_t a = 2 * j; a < 2 * numOfPoints; a += 4 * half)
+		{
+			uint32_t b = a + 2 * half;
+			/* t = b * exp(-i * angle) */
+			int32_t tReal = (int32_t)(((int64_t)pBuffer[b] * cosine + (int64_t)pBuffer[b + 1] * sine) >> 31);
+			int32_t tImag = (int32_t)(((int64_t)pBuffer[b + 1] * cosine - (int64_t)pBuffer[b] * sine) >> 31);
+			int32_t aReal = pBuffer[a];
+			int32_t aImag = pBuffer[a + 1];
+			pBuffer[a] = (aReal + tReal) >> 1;
+			pBuffer[a + 1] = (aImag + tImag) >> 1;
+			pBuffer[b] = (aReal - tReal) >> 1;
+			pBuffer[b + 1] = (aImag - tImag) >> 1;
+		}
+	}
+}
+
+/**
+ * @brief	Get the real spectrum from the half size complex transform and add its power to the average
+ * @param	pSpectrum: The spectrum
+ * @retval	None
+ * @note	The average is exponential with a weight of 1 / numOfAverages, the weight starts larger
+ * 			so the first frames settle quickly
+ */
+static void prvSplitAndAverage(ADCSpectrum* pSpectrum)
+{
+	const int32_t* pBuffer = pSpectrum->buffer;
+	uint32_t numOfBins = pSpectrum->settings.size / 2;
+	uint32_t twiddleStep = ADC_SPECTRUM_MAX_SIZE >> pSpectrum->log2Size;
+
+	if (pSpectrum->numOfTransforms < pSpectrum->settings.numOfAverages)
+		pSpectrum->numOfTransforms++;
+	uint32_t shift = prvLog2(pSpectrum->numOfTransforms);
+
+	for (uint32_t k = 0; k < numOfBins; k++)
+	{
+		uint32_t m = (numOfBins - k) & (numOfBins - 1);
+		/* Even samples: (Z[k] + conj(Z[N/2 - k])) / 2, odd samples: (Z[k] - conj(Z[N/2 - k])) / 2i */
+		int32_t evenReal = (pBuffer[2 * k] + pBuffer[2 * m]) >> 1;
+		int32_t evenImag = (pBuffer[2 * k + 1] - pBuffer[2 * m + 1]) >> 1;
+		int32_t oddReal = (pBuffer[2 * k + 1] + pBuffer[2 * m + 1]) >> 1;
+		int32_t oddImag = (pBuffer[2 * m] - pBuffer[2 * k]) >> 1;
+
+		/* X[k] = even + odd * exp(-2 * pi * i * k / size) */
+		int32_t cosine = prvCosine(pSpectrum, k * twiddleStep);
+		int32_t sine = prvSine(pSpectrum, k * twiddleStep);
+		int64_t real = evenReal + (((int64_t)oddReal * cosine + (int64_t)oddImag * sine) >> 31);
+		int64_t imag = evenImag + (((int64_t)oddImag * cosine - (int64_t)oddReal * sine) >> 31);
+		uint64_t power = (uint64_t)(real * real) + (uint64_t)(imag * imag);
+
+		if (shift == 0)
+			pSpectrum->power[k] = power;
+		else
+			pSpectrum->power[k] += ((int64_t)power - (int64_t)pSpectrum->power[k]) >> shift;
+	}
+}
+
+/**
+ * @brief	Convert the averaged power to dB and find the peak, skipped if the last frame hasn't been drawn yet
+ * @param	pSpectrum: The spectrum
+ * @retval	None
+ */
+static void prvFinishFrame(ADCSpectrum* pSpectrum)
+{
+	if (pSpectrum->frameIsNew)
+		return;
+
+	ADCSpectrumFrame* pFrame = &pSpectrum->frame;
+	uint32_t numOfBins = pSpectrum->settings.size / 2;
+	uint32_t peakBin = PEAK_MIN_BIN;
+	for (uint32_t k = 0; k < numOfBins; k++)
+	{
+		pFrame->level[k] = prvLevel(pSpectrum->power[k]);
+		if (k > PEAK_MIN_BIN && pFrame->level[k] > pFrame->level[peakBin])
+			peakBin = k;
+	}
+
+	/* Fit a parabola through the peak and its neighbours to get the frequency between the bins */
+	int64_t numerator = 0, denominator = 1;
+	if (peakBin + 1 < numOfBins)
+	{
+		int32_t left = pFrame->level[peakBin - 1];
+		int32_t center = pFrame->level[peakBin];
+		int32_t right = pFrame->level[peakBin + 1];
+		if (left - 2 * center + right != 0)
+		{
+			numerator = left - right;
+			denominator = 2 * (left - 2 * center + right);
+		}
+	}
+	int64_t sampleRate = (int64_t)pSpectrum->sampleRate * 1000;		/* mHz */
+	pFrame->numOfBins = numOfBins;
+	pFrame->binWidth = (uint32_t)(sampleRate >> pSpectrum->log2Size);
+	pFrame->peakBin = peakBin;
+	pFrame->peakFrequency = (uint32_t)(((int64_t)peakBin * denominator + numerator) * sampleRate /
+									   (denominator * (int64_t)pSpectrum->settings.size));
+	pFrame->peakLevel = pFrame->level[peakBin];
+	pFrame->numOfAverages = pSpectrum->numOfTransforms;
+	pFrame->frameNumber++;
+	pSpectrum->frameIsNew = true;
+}
+
+/**
+ * @brief	Cosine from the quarter wave table
+ * @param	pSpectrum: The spectrum
+ * @param	Index: Angle in 2 * pi / ADC_SPECTRUM_MAX_SIZE, less than ADC_SPECTRUM_MAX_SIZE
+ * @retval	The cosine in Q31
+ */
+static int32_t prvCosine(ADCSpectrum* pSpectrum, uint32_t Index)
+{
+	if (Index <= QUARTER)
+		return pSpectrum->sine[QUARTER - Index];
+	else if (Index <= 2 * QUARTER)
+		return -pSpectrum->sine[Index - QUARTER];
+	else if (Index <= 3 * QUARTER)
+		return -pSpectrum->sine[3 * QUARTER - Index];
+	else
+		return pSpectrum->sine[Index - 3 * QUARTER];
+}
+
+/**
+ * @brief	Sine from the quarter wave table
+ * @param	pSpectrum: The spectrum
+ * @param	Index: Angle in 2 * pi / ADC_SPECTRUM_MAX_SIZE, at most ADC_SPECTRUM_MAX_SIZE / 2
+ * @retval	The sine in Q31
+ */
+static int32_t prvSine(ADCSpectrum* pSpectrum, uint32_t Index)
+{
+	if (Index <= QUARTER)
+		return pSpectrum->sine[Index];
+	else
+		return pSpectrum->sine[2 * QUARTER - Index];
+}
+
+/**
+ * @brief	Convert a power to dB relative to a full scale sine
+ * @param	Power: The power
+ * @retval	The level in 0.1 dBFS
+ */
+static int16_t prvLevel(uint64_t Power)
+{
+	if (Power == 0)
+		return ADC_SPECTRUM_MIN_LEVEL;
+
+	/* Integer part of log2 from the leading zeros, the mantissa is normalized to 1.31 */
+	uint32_t high = (uint32_t)(Power >> 32);
+	uint32_t exponent = (high != 0) ? 63 - __CLZ(high) : 31 - __CLZ((uint32_t)Power);
+	uint64_t mantissa = (exponent >= 31) ? (Power >> (exponent - 31)) : (Power << (31 - exponent));
+
+	/* Every squaring of the mantissa gives one more bit of the fraction */
+	int32_t log2 = exponent << 8;
+	for (uint32_t bit = 0x80; bit != 0; bit >>= 1)
+	{
+		mantissa = (mantissa * mantissa) >> 31;
+		if (mantissa >= ((uint64_t)1 << 32))
+		{
+			log2 |= bit;
+			mantissa >>= 1;
+		}
+	}
+
+	/* 10 * log10(2) = 3.0103 dB */
+	int32_t level = (int32_t)(((int64_t)(log2 - FULL_SCALE_LOG2) * 30103) / 256000);
+	if (level < ADC_SPECTRUM_MIN_LEVEL)
+		level = ADC_SPECTRUM_MIN_LEVEL;
+	return (int16_t)level;
+}
+
+/**
+ * @brief	log2 of a power of 2
+ * @param	Value: The value
+ * @retval	The number of the highest bit that is set
+ */
+static uint32_t prvLog2(uint32_t Value)
+{
+	return 31 - __CLZ(Value);
+}
+
+/* Interrupt Handlers --------------------------------------------------------*/
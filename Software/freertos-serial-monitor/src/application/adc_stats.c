@@ -0,0 +1,224 @@
+/**
+ ******************************************************************************
+ * @file	adc_stats.c
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-18
+ * @brief	Min, max, mean, RMS and peak-to-peak of the acquired ADC samples,
+ *			both for everything since the acquisition started and for a
+ *			sliding window of the last blocks.
+ *
+ *			Every block is reduced to integer sums in a single pass, the
+ *			divisions and square roots are only done once per block so the
+ *			readers just copy the finished results.
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "adc_stats.h"
+
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+/* Private typedefs ----------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void prvResetSums(ADCStatsSums* pSums);
+static void prvCalculateResult(ADCStatsSums* pSums, ADCStatsResult* pResult);
+static int32_t prvDivideRounded(int64_t Dividend, uint64_t Divisor);
+static uint32_t prvSquareRootRounded(uint64_t Value);
+
+/* Functions -----------------------------------------------------------------*/
+/**
+ * @brief	Resets all the statistics
+ * @param	pStats: The statistics to reset
+ * @retval	None
+ */
+void adcStatsReset(ADCStats* pStats)
+{
+	memset(pStats, 0, sizeof(ADCStats));
+	prvResetSums(&pStats->total);
+	prvResetSums(&pStats->window);
+}
+
+/**
+ * @brief	Adds a block of samples to the total and the sliding window
+ * @param	pStats: The statistics
+ * @param	pSamples: The samples
+ * @param	NumOfSamples: Number of samples, at most 65536 so that the block sum fits in 32 bits
+ * @retval	None
+ */
+void adcStatsAddBlock(ADCStats* pStats, const int16_t* pSamples, uint32_t NumOfSamples)
+{
+	if (NumOfSamples == 0)
+		return;
+
+	/* Only integer adds, compares and multiply-accumulates per sample */
+	int32_t min = INT16_MAX;
+	int32_t max = INT16_MIN;
+	int32_t sum = 0;
+	uint64_t sumOfSquares = 0;
+	for (uint32_t i = 0; i < NumOfSamples; i++)
+	{
+		int32_t sample = pSamples[i];
+		if (sample < min)
+			min = sample;
+		if (sample > max)
+			max = sample;
+		sum += sample;
+		sumOfSquares += (uint32_t)(sample * sample);
+	}
+
+	/* Add the block to the total, the mean and RMS are restarted when the sum of squares would overflow */
+	ADCStatsSums* pTotal = &pStats->total;
+	if (pTotal->sumOfSquares > UINT64_MAX - sumOfSquares)
+	{
+		pTotal->sum = 0;
+		pTotal->sumOfSquares = 0;
+		pTotal->numOfSamples = 0;
+	}
+	if (min < pTotal->min)
+		pTotal->min = (int16_t)min;
+	if (max > pTotal->max)
+		pTotal->max = (int16_t)max;
+	pTotal->sum += sum;
+	pTotal->sumOfSquares += sumOfSquares;
+	pTotal->numOfSamples += NumOfSamples;
+
+	/* Replace the oldest block in the window */
+	ADCStatsSums* pWindow = &pStats->window;
+	ADCStatsSums* pBlock = &pStats->blocks[pStats->nextBlockIndex];
+	if (pStats->numOfBlocks == ADC_STATS_WINDOW_SIZE)
+	{
+		pWindow->sum -= pBlock->sum;
+		pWindow->sumOfSquares -= pBlock->sumOfSquares;
+		pWindow->numOfSamples -= pBlock->numOfSamples;
+	}
+	else
+		pStats->numOfBlocks++;
+
+	pBlock->min = (int16_t)min;
+	pBlock->max = (int16_t)max;
+	pBlock->sum = sum;
+	pBlock->sumOfSquares = sumOfSquares;
+	pBlock->numOfSamples = NumOfSamples;
+	pStats->nextBlockIndex = (pStats->nextBlockIndex + 1) % ADC_STATS_WINDOW_SIZE;
+
+	pWindow->sum += sum;
+	pWindow->sumOfSquares += sumOfSquares;
+	pWindow->numOfSamples += NumOfSamples;
+
+	/* The extremes can't be removed incrementally so they are found again among the blocks in the window */
+	pWindow->min = INT16_MAX;
+	pWindow->max = INT16_MIN;
+	for (uint32_t i = 0; i < pStats->numOfBlocks; i++)
+	{
+		if (pStats->blocks[i].min < pWindow->min)
+			pWindow->min = pStats->blocks[i].min;
+		if (pStats->blocks[i].max > pWindow->max)
+			pWindow->max = pStats->blocks[i].max;
+	}
+
+	prvCalculateResult(pTotal, &pStats->totalResult);
+	prvCalculateResult(pWindow, &pStats->windowResult);
+}
+
+/* Private functions .--------------------------------------------------------*/
+/**
+ * @brief	Resets sums so that any sample will become the new min and max
+ * @param	pSums: The sums to reset
+ * @retval	None
+ */
+static void prvResetSums(ADCStatsSums* pSums)
+{
+	pSums->min = INT16_MAX;
+	pSums->max = INT16_MIN;
+	pSums->sum = 0;
+	pSums->sumOfSquares = 0;
+	pSums->numOfSamples = 0;
+}
+
+/**
+ * @brief	Calculates the results from the sums
+ * @param	pSums: The sums
+ * @param	pResult: Where the results will be stored
+ * @retval	None
+ */
+static void prvCalculateResult(ADCStatsSums* pSums, ADCStatsResult* pResult)
+{
+	if (pSums->numOfSamples == 0)
+	{
+		memset(pResult, 0, sizeof(ADCStatsResult));
+		return;
+	}
+
+	pResult->min = pSums->min;
+	pResult->max = pSums->max;
+	pResult->peakToPeak = (uint16_t)(pSums->max - pSums->min);
+	pResult->mean = (int16_t)prvDivideRounded(pSums->sum, pSums->numOfSamples);
+	pResult->rms = (uint16_t)prvSquareRootRounded(pSums->sumOfSquares / pSums->numOfSamples);
+	pResult->numOfSamples = pSums->numOfSamples;
+}
+
+/**
+ * @brief	Divides and rounds to the closest integer, halfway cases are rounded away from zero
+ * @param	Dividend: The dividend
+ * @param	Divisor: The divisor, must not be 0
+ * @retval	The quotient
+ */
+static int32_t prvDivideRounded(int64_t Dividend, uint64_t Divisor)
+{
+	if (Dividend < 0)
+		return -(int32_t)(((uint64_t)-Dividend + Divisor / 2) / Divisor);
+	else
+		return (int32_t)(((uint64_t)Dividend + Divisor / 2) / Divisor);
+}
+
+/**
+ * @brief	Square root rounded to the closest integer
+ * @param	Value: The value
+ * @retval	The square root
+ */
+static uint32_t prvSquareRootRounded(uint64_t Value)
+{
+	/* Digit by digit calculation, two bits of the value for every bit of the result */
+	uint64_t root = 0;
+	uint64_t bit = (uint64_t)1 << 62;
+	while (bit > Value)
+		bit >>= 2;
+
+	while (bit != 0)
+	{
+		if (Value >= root + bit)
+		{
+			Value -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else
+			root >>= 1;
+		bit >>= 2;
+	}
+
+	/* Value is now the remainder, (root + 0.5)^2 = root^2 + root + 0.25 */
+	if (Value > root)
+		root++;
+
+	return (uint32_t)root;
+}
+
+/* Interrupt Handlers --------------------------------------------------------*/
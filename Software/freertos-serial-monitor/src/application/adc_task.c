@@ -26,6 +26,8 @@
 /* Includes ------------------------------------------------------------------*/
 #include "adc_task.h"
 
+#include "queue.h"
+
 #include "relay.h"
 #include "spi_flash_memory_map.h"
 #include "spi_flash.h"
@@ -35,14 +37,64 @@
 #include <stdbool.h>
 
 /* Private defines -----------------------------------------------------------*/
+#define BLOCK_QUEUE_SIZE		(2)		/* One for each of the MAX1301 buffers */
+#define BLOCK_WAIT_TIME			(100)	/* ms, also how often the ADC is sampled when no acquisition is running */
+#define STATUS_UPDATE_PERIOD	(1000)	/* ms */
+#define SPECTRUM_STEP_WAIT_TIME	(1)		/* ms between the steps of a transform so the LCD task gets to run */
+
 /* Private typedefs ----------------------------------------------------------*/
+typedef struct
+{
+	int16_t* pSamples;
+	ADCBlockHeader header;
+} ADCBlock;
+
 /* Private variables ---------------------------------------------------------*/
 
 static bool prvDoneInitializing = false;
 
+static QueueHandle_t prvBlockQueue;
+static MAX1301DiffChannel prvChannel = MAX1301DiffChannel_0;
+static volatile uint32_t prvRequestedSampleRate = 0;	/* 0 when the acquisition should be stopped */
+static volatile bool prvRequestIsPending = false;
+static volatile int16_t prvLatestSample = 0;
+static uint32_t prvWriteAddress = FLASH_ADR_ADC_DATA;
+
+static ADCAcquisitionStatus prvStatus = {0};
+static MAX1301AcquisitionStats prvLastStats = {0};
+static ADCStats prvStatistics __attribute__((section(".bss.CCMRAM")));
+static ADCStatsResult prvTotalResult = {0};
+static ADCStatsResult prvWindowResult = {0};
+
+static ADCScope prvScope __attribute__((section(".bss.CCMRAM")));
+static ADCScopeSettings prvScopeSettings;
+static volatile bool prvScopeIsRequested = false;
+static volatile bool prvScopeRequestIsPending = false;
+
+static ADCSpectrum prvSpectrum;	/* Doesn't fit in the CCM RAM */
+static ADCSpectrumSettings prvSpectrumSettings;
+static volatile bool prvSpectrumIsRequested = false;
+static volatile bool prvSpectrumRequestIsPending = false;
+
+static ADCFilter prvFilter __attribute__((section(".bss.CCMRAM")));
+static volatile ADCFilterType prvFilterType = ADCFilterType_None;
+static volatile uint32_t prvFilterCutoff = 0;
+static volatile bool prvFilterRequestIsPending = false;
+static uint32_t prvFilterCycles = 0;
+static uint32_t prvNumOfFilteredSamples = 0;
+
 /* Private function prototypes -----------------------------------------------*/
 static void prvHardwareInit();
 static void prvReadSettingsFromSpiFlash();
+static void prvHandleRequest();
+static void prvHandleScopeRequest();
+static void prvHandleSpectrumRequest();
+static void prvHandleFilterRequest();
+static void prvFilterBlock(ADCBlock* pBlock);
+static void prvAddBlockToStatistics(ADCBlock* pBlock);
+static void prvSaveBlock(ADCBlock* pBlock);
+static void prvUpdateStatus();
+static void prvBlockDoneCallback(int16_t* pSamples, uint32_t NumOfSamples, uint32_t FirstSampleNumber);
 
 /* Functions -----------------------------------------------------------------*/
 /**
@@ -52,6 +104,14 @@ static void prvReadSettingsFromSpiFlash();
  */
 void adcTask(void *pvParameters)
 {
+	/* Queue for the blocks handed over by the MAX1301 interrupts */
+	prvBlockQueue = xQueueCreate(BLOCK_QUEUE_SIZE, sizeof(ADCBlock));
+
+	adcStatsReset(&prvStatistics);
+	adcScopeReset(&prvScope);
+	adcSpectrumReset(&prvSpectrum);
+	adcFilterInit(&prvFilter, ADCFilterType_None, 0, 0);
+
 	/* Initialize hardware */
 	prvHardwareInit();
 
@@ -65,18 +125,65 @@ void adcTask(void *pvParameters)
 	prvReadSettingsFromSpiFlash();
 
 
-	/* The parameter in vTaskDelayUntil is the absolute time
-	 * in ticks at which you want to be woken calculated as
-	 * an increment from the time you were last woken. */
-	TickType_t xNextWakeTime;
-	/* Initialize xNextWakeTime - this only needs to be done once. */
-	xNextWakeTime = xTaskGetTickCount();
+	TickType_t lastStatusUpdate = xTaskGetTickCount();
+	ADCBlock block;
 
 	prvDoneInitializing = true;
 	while (1)
 	{
-		vTaskDelayUntil(&xNextWakeTime, 250 / portTICK_PERIOD_MS);
+		/* Don't wait long for a block while a transform is in progress, one step of it is done every loop */
+		TickType_t waitTime = BLOCK_WAIT_TIME / portTICK_PERIOD_MS;
+		if (adcSpectrumGetState(&prvSpectrum) == ADCSpectrumState_Transforming)
+			waitTime = SPECTRUM_STEP_WAIT_TIME / portTICK_PERIOD_MS;
+
+		/* Save the blocks to FLASH as they come in and give the buffers back to the driver */
+		if (xQueueReceive(prvBlockQueue, &block, waitTime) == pdTRUE)
+		{
+			prvFilterBlock(&block);
+			prvAddBlockToStatistics(&block);
+			adcScopeAddBlock(&prvScope, block.pSamples, block.header.numOfSamples, block.header.firstSampleNumber);
+			adcSpectrumAddBlock(&prvSpectrum, block.pSamples, block.header.numOfSamples,
+								block.header.firstSampleNumber, block.header.sampleRate);
+
+			/* Page programs keep up with the scope and spectrum so the logging runs all the time */
+			prvSaveBlock(&block);
+			MAX1301_ReleaseBlock(block.pSamples);
+		}
+
+		adcSpectrumProcess(&prvSpectrum);
 
+		if (prvScopeRequestIsPending)
+		{
+			prvScopeRequestIsPending = false;
+			prvHandleScopeRequest();
+		}
+
+		if (prvSpectrumRequestIsPending)
+		{
+			prvSpectrumRequestIsPending = false;
+			prvHandleSpectrumRequest();
+		}
+
+		if (prvRequestIsPending)
+		{
+			prvRequestIsPending = false;
+			prvHandleRequest();
+		}
+
+		if (prvFilterRequestIsPending)
+		{
+			prvFilterRequestIsPending = false;
+			prvHandleFilterRequest();
+		}
+
+		/* Converts a single sample when idle, returns the newest acquired sample while an acquisition is running */
+		prvLatestSample = MAX1301_GetDataFromDiffChannel(prvChannel);
+
+		if (xTaskGetTickCount() - lastStatusUpdate >= STATUS_UPDATE_PERIOD / portTICK_PERIOD_MS)
+		{
+			lastStatusUpdate = xTaskGetTickCount();
+			prvUpdateStatus();
+		}
 	}
 
 	/* Something has gone wrong */
@@ -95,6 +202,222 @@ bool adcIsDoneInitializing()
 	return prvDoneInitializing;
 }
 
+/**
+ * @brief	Start a timer paced acquisition that is logged to the FLASH, the ADC task clears the FLASH and starts it
+ * @param	SampleRate: Number of samples per second, 1 to MAX1301_MAX_SAMPLE_RATE
+ * @retval	SUCCES: The acquisition will be started
+ * @retval	ERROR: Invalid sample rate
+ */
+ErrorStatus adcStartAcquisition(uint32_t SampleRate)
+{
+	if (SampleRate == 0 || SampleRate > MAX1301_MAX_SAMPLE_RATE)
+		return ERROR;
+
+	prvRequestedSampleRate = SampleRate;
+	prvRequestIsPending = true;
+	return SUCCESS;
+}
+
+/**
+ * @brief	Stop the acquisition, the data that has been saved stays in the FLASH until the next start
+ * @param	None
+ * @retval	None
+ */
+void adcStopAcquisition()
+{
+	prvRequestedSampleRate = 0;
+	prvRequestIsPending = true;
+}
+
+/**
+ * @brief	Check if an acquisition has been requested
+ * @param	None
+ * @retval	true if it has
+ * @retval	false if not
+ */
+bool adcIsAcquiring()
+{
+	return (prvRequestedSampleRate != 0);
+}
+
+/**
+ * @brief	Get the newest sample
+ * @param	None
+ * @retval	The sample
+ */
+int16_t adcGetLatestSample()
+{
+	return prvLatestSample;
+}
+
+/**
+ * @brief	Get the status of the acquisition, it's updated once every second
+ * @param	pStatus: Pointer to a struct where the status will be copied to
+ * @retval	None
+ */
+void adcGetStatus(ADCAcquisitionStatus* pStatus)
+{
+	*pStatus = prvStatus;
+}
+
+/**
+ * @brief	Get the statistics of the acquisition, they are updated for every block of samples
+ * @param	pTotal: Where the statistics since the acquisition started will be copied to
+ * @param	pWindow: Where the statistics of the last ADC_STATS_WINDOW_SIZE blocks will be copied to
+ * @retval	None
+ */
+void adcGetStatistics(ADCStatsResult* pTotal, ADCStatsResult* pWindow)
+{
+	taskENTER_CRITICAL();
+	*pTotal = prvTotalResult;
+	*pWindow = prvWindowResult;
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief	Select the filter applied to the acquired samples before they are used for anything else
+ * @param	Type: Any value of ADCFilterType
+ * @param	Cutoff: Cutoff frequency in Hz for ADCFilterType_LowPass, limited to 0.45 times the sample rate
+ * @retval	None
+ */
+void adcSetFilter(ADCFilterType Type, uint32_t Cutoff)
+{
+	taskENTER_CRITICAL();
+	prvFilterType = Type;
+	prvFilterCutoff = Cutoff;
+	prvFilterRequestIsPending = true;
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief	Get the selected filter
+ * @param	None
+ * @retval	Any value of ADCFilterType
+ */
+ADCFilterType adcGetFilter()
+{
+	return prvFilterType;
+}
+
+/**
+ * @brief	Start the scope on the acquired samples, it's started by the ADC task
+ * @param	pSettings: The trigger settings
+ * @retval	None
+ * @note	The acquisition has to be started with adcStartAcquisition for the scope to get any samples
+ */
+void adcStartScope(const ADCScopeSettings* pSettings)
+{
+	taskENTER_CRITICAL();
+	prvScopeSettings = *pSettings;
+	prvScopeIsRequested = true;
+	prvScopeRequestIsPending = true;
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief	Stop the scope, the logging to FLASH continues
+ * @param	None
+ * @retval	None
+ */
+void adcStopScope()
+{
+	prvScopeIsRequested = false;
+	prvScopeRequestIsPending = true;
+}
+
+/**
+ * @brief	Get the state of the scope
+ * @param	None
+ * @retval	The state
+ */
+ADCScopeState adcGetScopeState()
+{
+	return adcScopeGetState(&prvScope);
+}
+
+/**
+ * @brief	Get the latest scope frame
+ * @param	ppFrame: Will point to the frame
+ * @retval	true if it's a new frame, it has to be released with adcReleaseScopeFrame when it's drawn
+ * @retval	false if it's the same frame as before
+ */
+bool adcGetScopeFrame(const ADCScopeFrame** ppFrame)
+{
+	return adcScopeGetFrame(&prvScope, ppFrame);
+}
+
+/**
+ * @brief	Let the scope replace the frame with the next one
+ * @param	None
+ * @retval	None
+ */
+void adcReleaseScopeFrame()
+{
+	adcScopeReleaseFrame(&prvScope);
+}
+
+/**
+ * @brief	Start the spectrum on the acquired samples, it's started by the ADC task
+ * @param	pSettings: The transform size and the number of averages
+ * @retval	None
+ * @note	The acquisition has to be started with adcStartAcquisition for the spectrum to get any samples
+ */
+void adcStartSpectrum(const ADCSpectrumSettings* pSettings)
+{
+	taskENTER_CRITICAL();
+	prvSpectrumSettings = *pSettings;
+	prvSpectrumIsRequested = true;
+	prvSpectrumRequestIsPending = true;
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief	Stop the spectrum, the logging to FLASH continues
+ * @param	None
+ * @retval	None
+ */
+void adcStopSpectrum()
+{
+	prvSpectrumIsRequested = false;
+	prvSpectrumRequestIsPending = true;
+}
+
+/**
+ * @brief	Get the latest spectrum frame
+ * @param	ppFrame: Will point to the frame
+ * @retval	true if it's a new frame, it has to be released with adcReleaseSpectrumFrame when it's drawn
+ * @retval	false if it's the same frame as before
+ */
+bool adcGetSpectrumFrame(const ADCSpectrumFrame** ppFrame)
+{
+	return adcSpectrumGetFrame(&prvSpectrum, ppFrame);
+}
+
+/**
+ * @brief	Let the spectrum replace the frame with the next one
+ * @param	None
+ * @retval	None
+ */
+void adcReleaseSpectrumFrame()
+{
+	adcSpectrumReleaseFrame(&prvSpectrum);
+}
+
+/**
+ * @brief	Clear the FLASH memory by first checking if it's clean or not -> avoids clear when not needed
+ * @param	None
+ * @retval	None
+ */
+void adcClearFlash()
+{
+	/* Check if the sectors associated with this channel are clean or not and erase them if necassary */
+	for (uint32_t i = 0; i < 16; i++)
+	{
+		if (!SPI_FLASH_SectorIsClean(FLASH_ADR_ADC_DATA + i * 0x10000))
+			SPI_FLASH_EraseSector(FLASH_ADR_ADC_DATA + i * 0x10000);
+	}
+}
+
 
 /* Private functions .--------------------------------------------------------*/
 /**
@@ -121,6 +444,220 @@ static void prvReadSettingsFromSpiFlash()
 
 }
 
+/**
+ * @brief	Start or stop the acquisition as requested by adcStartAcquisition/adcStopAcquisition
+ * @param	None
+ * @retval	None
+ */
+static void prvHandleRequest()
+{
+	MAX1301_StopAcquisition();
+
+	uint32_t sampleRate = prvRequestedSampleRate;
+	if (sampleRate == 0)
+		return;
+
+	/* Start over from the beginning of the FLASH region */
+	adcClearFlash();
+	prvWriteAddress = FLASH_ADR_ADC_DATA;
+	xQueueReset(prvBlockQueue);
+	memset(&prvStatus, 0, sizeof(ADCAcquisitionStatus));
+	adcStatsReset(&prvStatistics);
+	taskENTER_CRITICAL();
+	memset(&prvTotalResult, 0, sizeof(ADCStatsResult));
+	memset(&prvWindowResult, 0, sizeof(ADCStatsResult));
+	taskEXIT_CRITICAL();
+
+	if (MAX1301_StartAcquisition(prvChannel, sampleRate, prvBlockDoneCallback) == SUCCESS)
+	{
+		prvStatus.sampleRate = MAX1301_GetAcquisitionSampleRate();
+		MAX1301_GetAcquisitionStats(&prvLastStats);
+		/* The coefficients depend on the sample rate */
+		prvHandleFilterRequest();
+	}
+	else
+		prvRequestedSampleRate = 0;
+}
+
+/**
+ * @brief	Start or stop the scope as requested by adcStartScope/adcStopScope
+ * @param	None
+ * @retval	None
+ */
+static void prvHandleScopeRequest()
+{
+	if (prvScopeIsRequested)
+	{
+		ADCScopeSettings settings;
+		taskENTER_CRITICAL();
+		settings = prvScopeSettings;
+		taskEXIT_CRITICAL();
+		adcScopeStart(&prvScope, &settings);
+	}
+	else
+		adcScopeStop(&prvScope);
+}
+
+/**
+ * @brief	Start or stop the spectrum as requested by adcStartSpectrum/adcStopSpectrum
+ * @param	None
+ * @retval	None
+ */
+static void prvHandleSpectrumRequest()
+{
+	if (prvSpectrumIsRequested)
+	{
+		ADCSpectrumSettings settings;
+		taskENTER_CRITICAL();
+		settings = prvSpectrumSettings;
+		taskEXIT_CRITICAL();
+		if (adcSpectrumStart(&prvSpectrum, &settings) != SUCCESS)
+			prvSpectrumIsRequested = false;
+	}
+	else
+		adcSpectrumStop(&prvSpectrum);
+}
+
+/**
+ * @brief	Set up the filter requested by adcSetFilter for the current sample rate, this clears its history
+ * @param	None
+ * @retval	None
+ */
+static void prvHandleFilterRequest()
+{
+	ADCFilterType type;
+	uint32_t cutoff;
+	taskENTER_CRITICAL();
+	type = prvFilterType;
+	cutoff = prvFilterCutoff;
+	taskEXIT_CRITICAL();
+
+	adcFilterInit(&prvFilter, type, prvStatus.sampleRate, cutoff);
+	prvFilterCycles = 0;
+	prvNumOfFilteredSamples = 0;
+}
+
+/**
+ * @brief	Filter a block in place and measure the time it takes
+ * @param	pBlock: The block to filter
+ * @retval	None
+ */
+static void prvFilterBlock(ADCBlock* pBlock)
+{
+	pBlock->header.filter = (uint8_t)prvFilter.type;
+	if (prvFilter.type == ADCFilterType_None)
+		return;
+
+	uint32_t startCycles = DWT->CYCCNT;
+	adcFilterProcess(&prvFilter, pBlock->pSamples, pBlock->header.numOfSamples);
+	prvFilterCycles += DWT->CYCCNT - startCycles;
+	prvNumOfFilteredSamples += pBlock->header.numOfSamples;
+}
+
+/**
+ * @brief	Update the statistics with a block, only the finished results are shared with the readers
+ * @param	pBlock: The block to add
+ * @retval	None
+ */
+static void prvAddBlockToStatistics(ADCBlock* pBlock)
+{
+	adcStatsAddBlock(&prvStatistics, pBlock->pSamples, pBlock->header.numOfSamples);
+
+	taskENTER_CRITICAL();
+	prvTotalResult = prvStatistics.totalResult;
+	prvWindowResult = prvStatistics.windowResult;
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief	Write a block with its header to the FLASH if there is room left
+ * @param	pBlock: The block to save
+ * @retval	None
+ */
+static void prvSaveBlock(ADCBlock* pBlock)
+{
+	uint32_t size = sizeof(ADCBlockHeader) + pBlock->header.numOfSamples * sizeof(int16_t);
+	if (prvWriteAddress + size > FLASH_ADR_ADC_DATA + FLASH_CHANNEL_DATA_SIZE)
+	{
+		prvStatus.numOfUnsavedBlocks++;
+		return;
+	}
+
+	/* Page programs, a block takes at most four of them instead of one program per byte */
+	SPI_FLASH_WriteBuffer((uint8_t*)&pBlock->header, prvWriteAddress, sizeof(ADCBlockHeader));
+	prvWriteAddress += sizeof(ADCBlockHeader);
+	SPI_FLASH_WriteBuffer((uint8_t*)pBlock->pSamples, prvWriteAddress, pBlock->header.numOfSamples * sizeof(int16_t));
+	prvWriteAddress += pBlock->header.numOfSamples * sizeof(int16_t);
+
+	prvStatus.numOfSavedBlocks++;
+}
+
+/**
+ * @brief	Calculate the achieved sample rate and the jitter since the last update
+ * @param	None
+ * @retval	None
+ */
+static void prvUpdateStatus()
+{
+	if (!MAX1301_AcquisitionIsRunning())
+	{
+		prvStatus.achievedSampleRate = 0;
+		prvStatus.jitter = 0;
+		prvStatus.filterCycles = 0;
+		return;
+	}
+
+	/* The task is preempted by the sampling interrupts so this includes a bit of their time as well */
+	if (prvNumOfFilteredSamples != 0)
+		prvStatus.filterCycles = prvFilterCycles / prvNumOfFilteredSamples;
+	else
+		prvStatus.filterCycles = 0;
+	prvFilterCycles = 0;
+	prvNumOfFilteredSamples = 0;
+
+	MAX1301AcquisitionStats stats;
+	MAX1301_GetAcquisitionStats(&stats);
+
+	/* Samples converted between the last sample of the previous update and the last sample of this one */
+	uint32_t numOfSamples = stats.numOfSamples - prvLastStats.numOfSamples;
+	uint32_t cycles = stats.lastSampleCycles - prvLastStats.lastSampleCycles;
+	if (numOfSamples != 0 && cycles != 0)
+		prvStatus.achievedSampleRate = (uint32_t)(((uint64_t)numOfSamples * SystemCoreClock + cycles / 2) / cycles);
+	else
+		prvStatus.achievedSampleRate = 0;
+
+	if (stats.maxPeriod >= stats.minPeriod)
+		prvStatus.jitter = (uint32_t)((uint64_t)(stats.maxPeriod - stats.minPeriod) * 1000000000 / SystemCoreClock);
+	else
+		prvStatus.jitter = 0;
+
+	prvStatus.numOfOverruns = stats.numOfOverruns;
+	prvStatus.numOfDroppedSamples = stats.numOfDroppedSamples;
+	prvLastStats = stats;
+}
+
 
 /* Interrupt Handlers --------------------------------------------------------*/
+/**
+ * @brief	Called by the MAX1301 driver from interrupt context when a buffer is full
+ * @param	pSamples: The samples
+ * @param	NumOfSamples: Number of samples in the buffer
+ * @param	FirstSampleNumber: Number of the first sample counted from the start of the acquisition
+ * @retval	None
+ */
+static void prvBlockDoneCallback(int16_t* pSamples, uint32_t NumOfSamples, uint32_t FirstSampleNumber)
+{
+	ADCBlock block;
+	block.pSamples = pSamples;
+	block.header.timestamp = xTaskGetTickCountFromISR();
+	block.header.firstSampleNumber = FirstSampleNumber;
+	block.header.sampleRate = MAX1301_GetAcquisitionSampleRate();
+	block.header.numOfSamples = (uint16_t)NumOfSamples;
+	block.header.channel = (uint8_t)prvChannel;
+
+	/* Give the buffer straight back if it can't be queued, the samples are lost */
+	if (xQueueSendToBackFromISR(prvBlockQueue, &block, NULL) != pdTRUE)
+		MAX1301_ReleaseBlock(pSamples);
+}
+
 /* HAL Callback functions ----------------------------------------------------*/
@@ -26,6 +26,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "can1_task.h"
 
+#include "can_anomaly.h"
 #include "relay.h"
 #include "spi_flash_memory_map.h"
 #include "spi_flash.h"
@@ -131,6 +132,8 @@ static TimerHandle_t prvBuffer2ClearTimer;
 
 static bool prvDoneInitializing = false;
 
+static CANAnomalyDetector prvAnomalyDetector;
+
 /* Private function prototypes -----------------------------------------------*/
 static void prvHardwareInit();
 static ErrorStatus prvEnableCan1Interface();
@@ -158,6 +161,9 @@ void can1Task(void *pvParameters)
 	prvBuffer1ClearTimer = xTimerCreate("Buf1ClearCan1", 10, pdFALSE, 0, prvBuffer1ClearTimerCallback);
 	prvBuffer2ClearTimer = xTimerCreate("Buf2ClearCan1", 10, pdFALSE, 0, prvBuffer2ClearTimerCallback);
 
+	/* The anomaly detector starts learning when the channel is connected */
+	canAnomalyInit(&prvAnomalyDetector, "CAN1");
+
 	/* Initialize hardware */
 	prvHardwareInit();
 
@@ -184,7 +190,10 @@ void can1Task(void *pvParameters)
 	prvDoneInitializing = true;
 	while (1)
 	{
-		vTaskDelayUntil(&xNextWakeTime, 1000 / portTICK_PERIOD_MS);
+		vTaskDelayUntil(&xNextWakeTime, 100 / portTICK_PERIOD_MS);
+
+		/* Show any anomalies detected on the bus */
+		canAnomalyReportAlerts(&prvAnomalyDetector, 2);
 //		/* Transmit debug data */
 //		if (prvCurrentSettings.connection == CANConnection_Connected)
 //		{
@@ -272,6 +281,12 @@ ErrorStatus can1SetConnection(CANConnection Connection)
 		if (errorStatus == SUCCESS)
 		{
 			prvCurrentSettings.connection = Connection;
+
+			/* Learn a new baseline every time the channel is connected as it might be a different bus */
+			if (Connection == CANConnection_Connected)
+				canAnomalyStartLearning(&prvAnomalyDetector, CAN_ANOMALY_LEARNING_TIME);
+			else
+				canAnomalyStop(&prvAnomalyDetector);
 			return SUCCESS;
 		}
 		else
@@ -732,6 +747,13 @@ void can1TxCpltCallback()
   */
 void can1RxCpltCallback()
 {
+	/* Check the message against the learned baseline, the HAL stores one data byte per word */
+	uint8_t data[8];
+	for (uint32_t i = 0; i < CAN_Handle.pRxMsg->DLC && i < 8; i++)
+		data[i] = CAN_Handle.pRxMsg->Data[i];
+	uint32_t id = (CAN_Handle.pRxMsg->IDE == CAN_ID_STD) ? CAN_Handle.pRxMsg->StdId : CAN_Handle.pRxMsg->ExtId;
+	canAnomalyCheckMessageFromISR(&prvAnomalyDetector, id, CAN_Handle.pRxMsg->DLC, data, xTaskGetTickCountFromISR());
+
 //	if ((CAN_Handle.pRxMsg->StdId == 0x321) && (CAN_Handle.pRxMsg->IDE == CAN_ID_STD) && (CAN_Handle.pRxMsg->DLC == 2))
 //	{
 //		uint8_t ubKeyNumber = CAN_Handle.pRxMsg->Data[0];
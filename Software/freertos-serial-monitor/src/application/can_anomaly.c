@@ -0,0 +1,402 @@
+/**
+ ******************************************************************************
+ * @file	can_anomaly.c
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-12
+ * @brief	Learns a baseline of the traffic on a CAN bus and reports messages
+ *			that deviate from it.
+ *
+ *			During learning every ID gets an entry with the shortest period,
+ *			the DLC and the min/max value of every data byte. During detection
+ *			every message is compared against its entry. The table is a hash
+ *			table with a bounded number of probes so every message is checked
+ *			in constant time directly in the RX interrupt.
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "can_anomaly.h"
+
+#include "messages.h"
+
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define HASH_MULTIPLIER		(2654435761UL)	/* Knuth's multiplicative hash */
+#define NO_PERIOD			(0xFFFFFFFF)
+
+/* Private typedefs ----------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static const uint8_t prvHexTable[16] = {
+		'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+};
+
+static const uint8_t* prvAnomalyTypeText[] = {
+		"Unknown ID",
+		"Too fast",
+		"Wrong DLC",
+		"Data out of range",
+		"Table full",
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static CANAnomalyEntry* prvFindEntry(CANAnomalyDetector* pDetector, uint32_t Id);
+static void prvLearnMessage(CANAnomalyDetector* pDetector, uint32_t Id, uint8_t Dlc, uint8_t* pData, TickType_t Timestamp);
+static void prvDetectMessage(CANAnomalyDetector* pDetector, uint32_t Id, uint8_t Dlc, uint8_t* pData, TickType_t Timestamp);
+static void prvAddAlert(CANAnomalyDetector* pDetector, CANAnomalyType Type, uint32_t Id, uint8_t ByteIndex,
+						uint8_t Value, TickType_t Timestamp);
+static uint8_t* prvAppendString(uint8_t* pDestination, const uint8_t* pString);
+static uint8_t* prvAppendHex(uint8_t* pDestination, uint32_t Value, uint32_t NumOfDigits);
+
+/* Functions -----------------------------------------------------------------*/
+/**
+ * @brief	Initializes an anomaly detector, it starts in the disabled state
+ * @param	pDetector: The detector to initialize
+ * @param	pName: Name of the channel which is used in the alert messages
+ * @retval	None
+ */
+void canAnomalyInit(CANAnomalyDetector* pDetector, uint8_t* pName)
+{
+	memset(pDetector, 0, sizeof(CANAnomalyDetector));
+	pDetector->name = pName;
+	pDetector->state = CANAnomalyState_Disabled;
+}
+
+/**
+ * @brief	Clear the baseline and start learning a new one
+ * @param	pDetector: The detector
+ * @param	LearningTime: Time in ms to learn before detection starts
+ * @retval	None
+ */
+void canAnomalyStartLearning(CANAnomalyDetector* pDetector, uint32_t LearningTime)
+{
+	/* Make sure the RX interrupt does not use the table while it's cleared */
+	pDetector->state = CANAnomalyState_Disabled;
+
+	memset(pDetector->table, 0, sizeof(pDetector->table));
+	pDetector->tableFullReported = false;
+	pDetector->learningEndTime = xTaskGetTickCount() + LearningTime / portTICK_PERIOD_MS;
+
+	pDetector->state = CANAnomalyState_Learning;
+}
+
+/**
+ * @brief	Stop learning or detecting
+ * @param	pDetector: The detector
+ * @retval	None
+ */
+void canAnomalyStop(CANAnomalyDetector* pDetector)
+{
+	pDetector->state = CANAnomalyState_Disabled;
+}
+
+/**
+ * @brief	Get the current state of the detector
+ * @param	pDetector: The detector
+ * @retval	The state
+ */
+CANAnomalyState canAnomalyGetState(CANAnomalyDetector* pDetector)
+{
+	return pDetector->state;
+}
+
+/**
+ * @brief	Get the total number of alerts since the detector was initialized
+ * @param	pDetector: The detector
+ * @retval	The number of alerts
+ */
+uint32_t canAnomalyGetNumOfAlerts(CANAnomalyDetector* pDetector)
+{
+	return pDetector->numOfAlerts;
+}
+
+/**
+ * @brief	Check a received message against the baseline, or add it to the baseline when learning
+ * @param	pDetector: The detector
+ * @param	Id: The ID of the message
+ * @param	Dlc: The DLC of the message
+ * @param	pData: Pointer to the data of the message
+ * @param	Timestamp: The tick when the message was received
+ * @retval	None
+ * @note	Should be called from the RX interrupt for every message. The time is bounded by
+ * 			CAN_ANOMALY_MAX_PROBES table lookups.
+ */
+void canAnomalyCheckMessageFromISR(CANAnomalyDetector* pDetector, uint32_t Id, uint8_t Dlc, uint8_t* pData, TickType_t Timestamp)
+{
+	if (Dlc > 8)
+		Dlc = 8;
+
+	if (pDetector->state == CANAnomalyState_Learning)
+	{
+		/* Switch to detection when the learning time is over */
+		if ((int32_t)(Timestamp - pDetector->learningEndTime) >= 0)
+			pDetector->state = CANAnomalyState_Detecting;
+		else
+			prvLearnMessage(pDetector, Id, Dlc, pData, Timestamp);
+	}
+
+	if (pDetector->state == CANAnomalyState_Detecting)
+		prvDetectMessage(pDetector, Id, Dlc, pData, Timestamp);
+}
+
+/**
+ * @brief	Get the oldest alert that has not been read yet
+ * @param	pDetector: The detector
+ * @param	pAlert: Pointer to where the alert should be copied
+ * @retval	true if an alert was copied
+ * @retval	false if there are no alerts
+ */
+bool canAnomalyGetAlert(CANAnomalyDetector* pDetector, CANAnomalyAlert* pAlert)
+{
+	uint32_t readIndex = pDetector->alertReadIndex;
+	if (readIndex == pDetector->alertWriteIndex)
+		return false;
+
+	memcpy(pAlert, &pDetector->alerts[readIndex % CAN_ANOMALY_ALERT_BUFFER_SIZE], sizeof(CANAnomalyAlert));
+	pDetector->alertReadIndex = readIndex + 1;
+	return true;
+}
+
+/**
+ * @brief	Send the unread alerts as timestamped debug messages to the LCD
+ * @param	pDetector: The detector
+ * @param	MaxNumOfAlerts: Max number of alerts to send, the rest are kept until the next call
+ * @retval	None
+ */
+void canAnomalyReportAlerts(CANAnomalyDetector* pDetector, uint32_t MaxNumOfAlerts)
+{
+	if (MaxNumOfAlerts > CAN_ANOMALY_NUM_OF_MESSAGES)
+		MaxNumOfAlerts = CAN_ANOMALY_NUM_OF_MESSAGES;
+
+	CANAnomalyAlert alert;
+	for (uint32_t i = 0; i < MaxNumOfAlerts && canAnomalyGetAlert(pDetector, &alert); i++)
+	{
+		/* Format as "CAN1 ID 0x123: Data out of range [2]=0x45" */
+		uint8_t* pMessage = pDetector->messages[pDetector->nextMessageIndex];
+		pDetector->nextMessageIndex = (pDetector->nextMessageIndex + 1) % CAN_ANOMALY_NUM_OF_MESSAGES;
+
+		uint8_t* pString = prvAppendString(pMessage, pDetector->name);
+		if (alert.type != CANAnomalyType_TableFull)
+		{
+			pString = prvAppendString(pString, " ID 0x");
+			pString = prvAppendHex(pString, alert.id, (alert.id > 0x7FF) ? 8 : 3);
+		}
+		pString = prvAppendString(pString, ": ");
+		pString = prvAppendString(pString, prvAnomalyTypeText[alert.type]);
+		if (alert.type == CANAnomalyType_DataOutOfRange)
+		{
+			pString = prvAppendString(pString, " [");
+			*pString++ = '0' + alert.byteIndex;
+			pString = prvAppendString(pString, "]=0x");
+			pString = prvAppendHex(pString, alert.value, 2);
+		}
+		else if (alert.type == CANAnomalyType_WrongDlc)
+		{
+			pString = prvAppendString(pString, " ");
+			*pString++ = '0' + alert.value;
+		}
+		*pString = 0;
+
+		LCDEventMessage message;
+		message.event = LCDEvent_DebugMessage;
+		message.data[0] = alert.timestamp;
+		message.data[1] = (uint32_t)pMessage;
+		xQueueSendToBack(xLCDEventQueue, &message, 100);
+	}
+}
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief	Find the entry for an ID
+ * @param	pDetector: The detector
+ * @param	Id: The ID to find
+ * @retval	Pointer to the entry for the ID, or to an unused entry where it can be inserted
+ * @retval	0 if the ID is not in the table and there is no free entry within CAN_ANOMALY_MAX_PROBES
+ */
+static CANAnomalyEntry* prvFindEntry(CANAnomalyDetector* pDetector, uint32_t Id)
+{
+	uint32_t index = (Id * HASH_MULTIPLIER) >> 16;
+	for (uint32_t i = 0; i < CAN_ANOMALY_MAX_PROBES; i++)
+	{
+		CANAnomalyEntry* pEntry = &pDetector->table[(index + i) & (CAN_ANOMALY_TABLE_SIZE - 1)];
+		if (!pEntry->used || pEntry->id == Id)
+			return pEntry;
+	}
+	return 0;
+}
+
+/**
+ * @brief	Add a message to the baseline
+ * @param	pDetector: The detector
+ * @param	Id: The ID of the message
+ * @param	Dlc: The DLC of the message
+ * @param	pData: Pointer to the data of the message
+ * @param	Timestamp: The tick when the message was received
+ * @retval	None
+ */
+static void prvLearnMessage(CANAnomalyDetector* pDetector, uint32_t Id, uint8_t Dlc, uint8_t* pData, TickType_t Timestamp)
+{
+	CANAnomalyEntry* pEntry = prvFindEntry(pDetector, Id);
+	if (pEntry == 0)
+	{
+		if (!pDetector->tableFullReported)
+		{
+			prvAddAlert(pDetector, CANAnomalyType_TableFull, Id, 0, 0, Timestamp);
+			pDetector->tableFullReported = true;
+		}
+		return;
+	}
+
+	/* First time this ID is seen */
+	if (!pEntry->used)
+	{
+		pEntry->used = true;
+		pEntry->id = Id;
+		pEntry->lastTimestamp = Timestamp;
+		pEntry->minPeriod = NO_PERIOD;
+		pEntry->dlc = Dlc;
+		for (uint32_t i = 0; i < 8; i++)
+		{
+			pEntry->minData[i] = (i < Dlc) ? pData[i] : 0xFF;
+			pEntry->maxData[i] = (i < Dlc) ? pData[i] : 0x00;
+		}
+		return;
+	}
+
+	TickType_t period = Timestamp - pEntry->lastTimestamp;
+	pEntry->lastTimestamp = Timestamp;
+	if (period < pEntry->minPeriod)
+		pEntry->minPeriod = period;
+
+	if (pEntry->dlc != Dlc)
+		pEntry->dlc = CAN_ANOMALY_VARIABLE_DLC;
+
+	for (uint32_t i = 0; i < Dlc; i++)
+	{
+		if (pData[i] < pEntry->minData[i])
+			pEntry->minData[i] = pData[i];
+		if (pData[i] > pEntry->maxData[i])
+			pEntry->maxData[i] = pData[i];
+	}
+}
+
+/**
+ * @brief	Compare a message to the baseline and add an alert if it deviates
+ * @param	pDetector: The detector
+ * @param	Id: The ID of the message
+ * @param	Dlc: The DLC of the message
+ * @param	pData: Pointer to the data of the message
+ * @param	Timestamp: The tick when the message was received
+ * @retval	None
+ */
+static void prvDetectMessage(CANAnomalyDetector* pDetector, uint32_t Id, uint8_t Dlc, uint8_t* pData, TickType_t Timestamp)
+{
+	CANAnomalyEntry* pEntry = prvFindEntry(pDetector, Id);
+	if (pEntry == 0 || !pEntry->used)
+	{
+		prvAddAlert(pDetector, CANAnomalyType_UnknownId, Id, 0, 0, Timestamp);
+		return;
+	}
+
+	/*
+	 * IDs that came in bursts during learning have a min period of 0 and
+	 * IDs that were only seen once have no period so they can't be checked
+	 */
+	TickType_t period = Timestamp - pEntry->lastTimestamp;
+	pEntry->lastTimestamp = Timestamp;
+	if (pEntry->minPeriod != NO_PERIOD && period < pEntry->minPeriod / CAN_ANOMALY_PERIOD_DIVISOR)
+	{
+		prvAddAlert(pDetector, CANAnomalyType_TooFast, Id, 0, 0, Timestamp);
+		return;
+	}
+
+	if (pEntry->dlc != CAN_ANOMALY_VARIABLE_DLC && pEntry->dlc != Dlc)
+	{
+		prvAddAlert(pDetector, CANAnomalyType_WrongDlc, Id, 0, Dlc, Timestamp);
+		return;
+	}
+
+	for (uint32_t i = 0; i < Dlc; i++)
+	{
+		if (pData[i] < pEntry->minData[i] || pData[i] > pEntry->maxData[i])
+		{
+			prvAddAlert(pDetector, CANAnomalyType_DataOutOfRange, Id, i, pData[i], Timestamp);
+			return;
+		}
+	}
+}
+
+/**
+ * @brief	Add an alert to the alert buffer
+ * @param	pDetector: The detector
+ * @param	Type: The type of anomaly
+ * @param	Id: The ID of the message
+ * @param	ByteIndex: Index of the data byte, only used for CANAnomalyType_DataOutOfRange
+ * @param	Value: The DLC or data byte that caused the alert
+ * @param	Timestamp: The tick when the message was received
+ * @retval	None
+ */
+static void prvAddAlert(CANAnomalyDetector* pDetector, CANAnomalyType Type, uint32_t Id, uint8_t ByteIndex,
+						uint8_t Value, TickType_t Timestamp)
+{
+	pDetector->numOfAlerts++;
+
+	/* Drop the alert if the buffer is full, an attack can generate alerts much faster than they can be shown */
+	uint32_t writeIndex = pDetector->alertWriteIndex;
+	if (writeIndex - pDetector->alertReadIndex >= CAN_ANOMALY_ALERT_BUFFER_SIZE)
+	{
+		pDetector->numOfDroppedAlerts++;
+		return;
+	}
+
+	CANAnomalyAlert* pAlert = &pDetector->alerts[writeIndex % CAN_ANOMALY_ALERT_BUFFER_SIZE];
+	pAlert->timestamp = Timestamp;
+	pAlert->id = Id;
+	pAlert->type = Type;
+	pAlert->byteIndex = ByteIndex;
+	pAlert->value = Value;
+	pDetector->alertWriteIndex = writeIndex + 1;
+}
+
+/**
+ * @brief	Copy a string without the null termination
+ * @param	pDestination: Where to copy the string
+ * @param	pString: The string to copy
+ * @retval	Pointer to the position after the copied string
+ */
+static uint8_t* prvAppendString(uint8_t* pDestination, const uint8_t* pString)
+{
+	while (*pString)
+		*pDestination++ = *pString++;
+	return pDestination;
+}
+
+/**
+ * @brief	Write a value as hex characters
+ * @param	pDestination: Where to write the characters
+ * @param	Value: The value
+ * @param	NumOfDigits: Number of hex digits to write
+ * @retval	Pointer to the position after the written characters
+ */
+static uint8_t* prvAppendHex(uint8_t* pDestination, uint32_t Value, uint32_t NumOfDigits)
+{
+	for (int32_t i = NumOfDigits - 1; i >= 0; i--)
+		*pDestination++ = prvHexTable[(Value >> (i * 4)) & 0xF];
+	return pDestination;
+}
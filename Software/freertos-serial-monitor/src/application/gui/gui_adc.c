@@ -29,13 +29,83 @@
 #include "max1301.h"
 
 /* Private defines -----------------------------------------------------------*/
+#define NUM_OF_SAMPLE_RATES		(5)
+#define NUM_OF_TRIGGER_MODES	(3)
+#define NUM_OF_TRIGGER_LEVELS	(5)
+#define NUM_OF_PRE_TRIGGERS		(4)
+#define NUM_OF_FILTERS			(7)
+#define NUM_OF_SPECTRUM_SIZES	(4)
+#define NUM_OF_AVERAGES			(4)
+
+#define SCOPE_X_POS				(25)
+#define SCOPE_Y_POS				(110)
+#define SCOPE_HEIGHT			(320)
+#define SCOPE_HYSTERESIS		(256)
+#define SPECTRUM_RANGE			(1200)	/* 0.1 dB shown below full scale */
+#define SPECTRUM_GRID_STEP		(200)	/* 0.1 dB between the grid lines */
+
 /* Private typedefs ----------------------------------------------------------*/
+typedef enum
+{
+	ADCView_Values,
+	ADCView_Scope,
+	ADCView_Spectrum,
+	ADCView_NumOfViews,
+} ADCView;
+
 /* Private variables ---------------------------------------------------------*/
-static GUITextBox prvTextBox = {0};
-static GUIButton prvButton = {0};
-static GUIContainer prvContainer = {0};
+static const uint32_t prvSampleRates[NUM_OF_SAMPLE_RATES] = {100, 1000, 10000, 50000, 100000};
+static uint8_t* prvSampleRateText[NUM_OF_SAMPLE_RATES] = {"100 Hz", "1 kHz", "10 kHz", "50 kHz", "100 kHz"};
+static uint32_t prvSampleRateIndex = 1;
+
+static ADCView prvView = ADCView_Values;
+static uint8_t* prvViewText[ADCView_NumOfViews] = {"Values", "Scope", "Spectrum"};
+static ADCScopeSettings prvScopeSettings = {
+		.mode = ADCScopeMode_Auto,
+		.edge = ADCScopeEdge_Rising,
+		.level = 0,
+		.hysteresis = SCOPE_HYSTERESIS,
+		.holdoff = ADC_SCOPE_FRAME_SIZE,
+		.preTriggerDepth = ADC_SCOPE_FRAME_SIZE / 4,
+		.autoTimeout = ADC_SCOPE_FRAME_SIZE,
+};
+static uint8_t* prvTriggerModeText[NUM_OF_TRIGGER_MODES] = {"Auto", "Normal", "Single"};
+static const int16_t prvTriggerLevels[NUM_OF_TRIGGER_LEVELS] = {-16384, -8192, 0, 8192, 16384};
+static uint8_t* prvTriggerLevelText[NUM_OF_TRIGGER_LEVELS] = {"-16384", "-8192", "0", "8192", "16384"};
+static uint32_t prvTriggerLevelIndex = 2;
+static const uint32_t prvPreTriggers[NUM_OF_PRE_TRIGGERS] = {10, 25, 50, 75};
+static uint8_t* prvPreTriggerText[NUM_OF_PRE_TRIGGERS] = {"10 %", "25 %", "50 %", "75 %"};
+static uint32_t prvPreTriggerIndex = 1;
+
+static const ADCFilterType prvFilterTypes[NUM_OF_FILTERS] = {
+		ADCFilterType_None, ADCFilterType_MovingAverage, ADCFilterType_LowPass, ADCFilterType_LowPass,
+		ADCFilterType_LowPass, ADCFilterType_Notch50Hz, ADCFilterType_Notch60Hz};
+static const uint32_t prvFilterCutoffs[NUM_OF_FILTERS] = {0, 0, 100, 1000, 10000, 0, 0};
+static uint8_t* prvFilterText[NUM_OF_FILTERS] = {"Off", "Average", "LP 100 Hz", "LP 1 kHz", "LP 10 kHz", "Notch 50 Hz", "Notch 60 Hz"};
+static uint32_t prvFilterIndex = 0;
+
+static ADCSpectrumSettings prvSpectrumSettings = {
+		.size = 1024,
+		.numOfAverages = 4,
+};
+static const uint32_t prvSpectrumSizes[NUM_OF_SPECTRUM_SIZES] = {256, 512, 1024, 2048};
+static uint8_t* prvSpectrumSizeText[NUM_OF_SPECTRUM_SIZES] = {"256", "512", "1024", "2048"};
+static uint32_t prvSpectrumSizeIndex = 2;
+static const uint32_t prvAverages[NUM_OF_AVERAGES] = {1, 4, 16, 64};
+static uint8_t* prvAveragesText[NUM_OF_AVERAGES] = {"Off", "4", "16", "64"};
+static uint32_t prvAveragesIndex = 1;
 
 /* Private function prototypes -----------------------------------------------*/
+static void prvWriteStatistics(uint32_t TextBoxId, uint8_t* pLabel, ADCStatsResult* pResult);
+static void prvManageScope(bool ShouldRefresh);
+static void prvDrawScopeFrame(const ADCScopeFrame* pFrame);
+static void prvClearScope();
+static uint16_t prvScopeYPos(int32_t Value);
+static void prvManageSpectrum(bool ShouldRefresh);
+static void prvDrawSpectrumFrame(const ADCSpectrumFrame* pFrame);
+static uint16_t prvSpectrumYPos(int32_t Level);
+static void prvWriteTenths(uint32_t TextBoxId, int32_t Value);
+
 /* Functions -----------------------------------------------------------------*/
 /* ADC GUI Elements ========================================================*/
 /**
@@ -45,13 +115,52 @@ static GUIContainer prvContainer = {0};
  */
 void guiAdcManageMainTextBox(bool ShouldRefresh)
 {
+	if (prvView == ADCView_Scope)
+	{
+		prvManageScope(ShouldRefresh);
+		return;
+	}
+	else if (prvView == ADCView_Spectrum)
+	{
+		prvManageSpectrum(ShouldRefresh);
+		return;
+	}
+
 	/* Update the text box for channel 0 */
 	GUITextBox_ClearAndResetWritePosition(GUITextBoxId_Adc0Value);
 	GUITextBox_SetYWritePositionToCenter(GUITextBoxId_Adc0Value);
-	int16_t currentValue = MAX1301_GetDataFromDiffChannel(MAX1301DiffChannel_0);
+	int16_t currentValue = adcGetLatestSample();
 	GUITextBox_WriteNumber(GUITextBoxId_Adc0Value, (int32_t)currentValue);
 	GUITextBox_WriteString(GUITextBoxId_Adc0Value, " V");
 
+	/* Update the acquisition status */
+	GUITextBox_ClearAndResetWritePosition(GUITextBoxId_AdcStatus);
+	GUITextBox_SetYWritePositionToCenter(GUITextBoxId_AdcStatus);
+	if (adcIsAcquiring())
+	{
+		ADCAcquisitionStatus status;
+		adcGetStatus(&status);
+		GUITextBox_WriteNumber(GUITextBoxId_AdcStatus, (int32_t)status.achievedSampleRate);
+		GUITextBox_WriteString(GUITextBoxId_AdcStatus, " Hz, jitter: ");
+		GUITextBox_WriteNumber(GUITextBoxId_AdcStatus, (int32_t)status.jitter);
+		GUITextBox_WriteString(GUITextBoxId_AdcStatus, " ns, lost: ");
+		GUITextBox_WriteNumber(GUITextBoxId_AdcStatus, (int32_t)(status.numOfOverruns + status.numOfDroppedSamples));
+		if (adcGetFilter() != ADCFilterType_None)
+		{
+			GUITextBox_WriteString(GUITextBoxId_AdcStatus, ", filter: ");
+			GUITextBox_WriteNumber(GUITextBoxId_AdcStatus, (int32_t)status.filterCycles);
+			GUITextBox_WriteString(GUITextBoxId_AdcStatus, " cycles/sample");
+		}
+	}
+	else
+		GUITextBox_WriteString(GUITextBoxId_AdcStatus, "Not sampling");
+
+	/* Update the statistics, they are calculated by the ADC task for every block */
+	ADCStatsResult total, window;
+	adcGetStatistics(&total, &window);
+	prvWriteStatistics(GUITextBoxId_AdcTotalStatistics, "Total: ", &total);
+	prvWriteStatistics(GUITextBoxId_AdcWindowStatistics, "Window:", &window);
+
 //	/* Update the text box for channel 1 */
 //	GUITextBox_ClearAndResetWritePosition(GUITextBoxId_Adc1Value);
 //	GUITextBox_SetYWritePositionToCenter(GUITextBoxId_Adc1Value);
@@ -75,134 +184,954 @@ void guiAdcTopButtonCallback(GUITouchEvent Event, uint32_t ButtonId)
 	}
 }
 
+/**
+ * @brief	Callback for the enable button, starts and stops the acquisition
+ * @param	Event: The event that caused the callback
+ * @param	ButtonId: The button ID that the event happened on
+ * @retval	None
+ */
+void guiAdcEnableButtonCallback(GUITouchEvent Event, uint32_t ButtonId)
+{
+	if (Event == GUITouchEvent_Up)
+	{
+		if (adcIsAcquiring())
+		{
+			adcStopAcquisition();
+			GUIButton_SetTextForRow(GUIButtonId_AdcEnable, "Disabled", 1);
+			GUIButton_SetState(GUIButtonId_AdcTop, GUIButtonState_Disabled);
+			GUIButton_SetState(GUIButtonId_AdcSampleRate, GUIButtonState_Disabled);
+		}
+		else if (adcStartAcquisition(prvSampleRates[prvSampleRateIndex]) == SUCCESS)
+		{
+			GUIButton_SetTextForRow(GUIButtonId_AdcEnable, "Enabled", 1);
+			GUIButton_SetState(GUIButtonId_AdcTop, GUIButtonState_Enabled);
+			GUIButton_SetState(GUIButtonId_AdcSampleRate, GUIButtonState_DisabledTouch);
+		}
+	}
+}
+
+/**
+ * @brief	Callback for the view button, steps through the values, the scope and the spectrum
+ * @param	Event: The event that caused the callback
+ * @param	ButtonId: The button ID that the event happened on
+ * @retval	None
+ */
+void guiAdcViewButtonCallback(GUITouchEvent Event, uint32_t ButtonId)
+{
+	if (Event == GUITouchEvent_Up)
+	{
+		prvView = (prvView + 1) % ADCView_NumOfViews;
+		GUIButton_SetTextForRow(GUIButtonId_AdcView, prvViewText[prvView], 1);
+
+		switch (prvView)
+		{
+			case ADCView_Scope:
+				adcStartScope(&prvScopeSettings);
+				GUIContainer_ChangePage(GUIContainerId_AdcMainContent, GUIContainerPage_2);
+				prvManageScope(true);
+				break;
+			case ADCView_Spectrum:
+				adcStopScope();
+				adcStartSpectrum(&prvSpectrumSettings);
+				GUIContainer_ChangePage(GUIContainerId_AdcMainContent, GUIContainerPage_3);
+				prvManageSpectrum(true);
+				break;
+			default:
+				adcStopSpectrum();
+				prvClearScope();
+				GUIContainer_ChangePage(GUIContainerId_AdcMainContent, GUIContainerPage_1);
+				break;
+		}
+	}
+}
+
+/**
+ * @brief	Callback for the scope trigger buttons, the scope is restarted with the new settings
+ * @param	Event: The event that caused the callback
+ * @param	ButtonId: The button ID that the event happened on
+ * @retval	None
+ * @note	Pressing the trigger mode button after a single shot arms it again instead of changing the mode
+ */
+void guiAdcScopeButtonCallback(GUITouchEvent Event, uint32_t ButtonId)
+{
+	if (Event == GUITouchEvent_Up)
+	{
+		switch (ButtonId)
+		{
+			case GUIButtonId_AdcTriggerMode:
+				if (prvScopeSettings.mode != ADCScopeMode_Single || adcGetScopeState() != ADCScopeState_Done)
+				{
+					prvScopeSettings.mode = (prvScopeSettings.mode + 1) % NUM_OF_TRIGGER_MODES;
+					GUIButton_SetTextForRow(GUIButtonId_AdcTriggerMode, prvTriggerModeText[prvScopeSettings.mode], 1);
+				}
+				break;
+			case GUIButtonId_AdcTriggerEdge:
+				if (prvScopeSettings.edge == ADCScopeEdge_Rising)
+				{
+					prvScopeSettings.edge = ADCScopeEdge_Falling;
+					GUIButton_SetTextForRow(GUIButtonId_AdcTriggerEdge, "Falling", 1);
+				}
+				else
+				{
+					prvScopeSettings.edge = ADCScopeEdge_Rising;
+					GUIButton_SetTextForRow(GUIButtonId_AdcTriggerEdge, "Rising", 1);
+				}
+				break;
+			case GUIButtonId_AdcTriggerLevel:
+				prvTriggerLevelIndex = (prvTriggerLevelIndex + 1) % NUM_OF_TRIGGER_LEVELS;
+				prvScopeSettings.level = prvTriggerLevels[prvTriggerLevelIndex];
+				GUIButton_SetTextForRow(GUIButtonId_AdcTriggerLevel, prvTriggerLevelText[prvTriggerLevelIndex], 1);
+				break;
+			case GUIButtonId_AdcPreTrigger:
+				prvPreTriggerIndex = (prvPreTriggerIndex + 1) % NUM_OF_PRE_TRIGGERS;
+				prvScopeSettings.preTriggerDepth = ADC_SCOPE_FRAME_SIZE * prvPreTriggers[prvPreTriggerIndex] / 100;
+				GUIButton_SetTextForRow(GUIButtonId_AdcPreTrigger, prvPreTriggerText[prvPreTriggerIndex], 1);
+				break;
+			default:
+				break;
+		}
+
+		if (prvView == ADCView_Scope)
+			adcStartScope(&prvScopeSettings);
+	}
+}
+
+/**
+ * @brief	Callback for the spectrum buttons, the spectrum is restarted with the new settings
+ * @param	Event: The event that caused the callback
+ * @param	ButtonId: The button ID that the event happened on
+ * @retval	None
+ */
+void guiAdcSpectrumButtonCallback(GUITouchEvent Event, uint32_t ButtonId)
+{
+	if (Event == GUITouchEvent_Up)
+	{
+		if (ButtonId == GUIButtonId_AdcSpectrumSize)
+		{
+			prvSpectrumSizeIndex = (prvSpectrumSizeIndex + 1) % NUM_OF_SPECTRUM_SIZES;
+			prvSpectrumSettings.size = prvSpectrumSizes[prvSpectrumSizeIndex];
+			GUIButton_SetTextForRow(GUIButtonId_AdcSpectrumSize, prvSpectrumSizeText[prvSpectrumSizeIndex], 1);
+		}
+		else if (ButtonId == GUIButtonId_AdcSpectrumAverages)
+		{
+			prvAveragesIndex = (prvAveragesIndex + 1) % NUM_OF_AVERAGES;
+			prvSpectrumSettings.numOfAverages = prvAverages[prvAveragesIndex];
+			GUIButton_SetTextForRow(GUIButtonId_AdcSpectrumAverages, prvAveragesText[prvAveragesIndex], 1);
+		}
+
+		if (prvView == ADCView_Spectrum)
+			adcStartSpectrum(&prvSpectrumSettings);
+	}
+}
+
+/**
+ * @brief	Callback for the filter button, steps through the filter presets
+ * @param	Event: The event that caused the callback
+ * @param	ButtonId: The button ID that the event happened on
+ * @retval	None
+ * @note	The filter can be changed while sampling, its history is cleared when it's changed
+ */
+void guiAdcFilterButtonCallback(GUITouchEvent Event, uint32_t ButtonId)
+{
+	if (Event == GUITouchEvent_Up)
+	{
+		prvFilterIndex = (prvFilterIndex + 1) % NUM_OF_FILTERS;
+		adcSetFilter(prvFilterTypes[prvFilterIndex], prvFilterCutoffs[prvFilterIndex]);
+		GUIButton_SetTextForRow(GUIButtonId_AdcFilter, prvFilterText[prvFilterIndex], 1);
+	}
+}
+
 /**
  * @brief
+ * @param	Event: The event that caused the callback
+ * @param	ButtonId: The button ID that the event happened on
+ * @retval	None
+ */
+void guiAdcSidebarForwardBackwardsButtonsCallback(GUITouchEvent Event, uint32_t ButtonId)
+{
+	if (Event == GUITouchEvent_Up)
+	{
+		if (ButtonId == GUIButtonId_AdcSidebarBackwards)
+		{
+			/* Decrease the page by one step */
+			GUIContainer_DecrementPage(GUIContainerId_SidebarAdc);
+		}
+		else if (ButtonId == GUIButtonId_AdcSidebarForwards)
+		{
+			/* Increase the page by one step */
+			GUIContainer_IncrementPage(GUIContainerId_SidebarAdc);
+		}
+
+		/* Update the state of the forward and backwards buttons to indicate if the ends have been reached */
+		GUIContainerPage activePage = GUIContainer_GetActivePage(GUIContainerId_SidebarAdc);
+		GUIContainerPage lastPage = GUIContainer_GetLastPage(GUIContainerId_SidebarAdc);
+		if (activePage == GUIContainerPage_1)
+			GUIButton_SetState(GUIButtonId_AdcSidebarBackwards, GUIButtonState_DisabledTouch);
+		else
+			GUIButton_SetState(GUIButtonId_AdcSidebarBackwards, GUIButtonState_Enabled);
+
+		if (activePage == lastPage)
+			GUIButton_SetState(GUIButtonId_AdcSidebarForwards, GUIButtonState_DisabledTouch);
+		else
+			GUIButton_SetState(GUIButtonId_AdcSidebarForwards, GUIButtonState_Enabled);
+	}
+}
+
+/**
+ * @brief	Callback for the sample rate button, steps through the available rates
+ * @param	Event: The event that caused the callback
+ * @param	ButtonId: The button ID that the event happened on
+ * @retval	None
+ */
+void guiAdcSampleRateButtonCallback(GUITouchEvent Event, uint32_t ButtonId)
+{
+	if (Event == GUITouchEvent_Up && !adcIsAcquiring())
+	{
+		prvSampleRateIndex = (prvSampleRateIndex + 1) % NUM_OF_SAMPLE_RATES;
+		GUIButton_SetTextForRow(GUIButtonId_AdcSampleRate, prvSampleRateText[prvSampleRateIndex], 1);
+	}
+}
+
+/**
+ * @brief	Initializes the ADC top button, the rest is initialized by guiAdcInitSidebarGuiElements
  * @param	None
  * @retval	None
  */
 void guiAdcInitGuiElements()
+{
+	/* Buttons -------------------------------------------------------------------*/
+	/* ADC Top Button */
+	static const GUIButton topButton = {
+		.object.id = GUIButtonId_AdcTop,
+		.object.xPos = 600,
+		.object.yPos = 0,
+		.object.width = 50,
+		.object.height = 50,
+		.object.displayState = GUIDisplayState_NotHidden,
+		.object.border = GUIBorder_Bottom | GUIBorder_Right | GUIBorder_Left,
+		.object.borderThickness = 1,
+		.object.borderColor = GUI_WHITE,
+		.enabledTextColor = GUI_WHITE,
+		.enabledBackgroundColor = GUI_MAGENTA,
+		.disabledTextColor = GUI_MAGENTA,
+		.disabledBackgroundColor = LCD_COLOR_BLACK,
+		.pressedTextColor = GUI_MAGENTA,
+		.pressedBackgroundColor = GUI_WHITE,
+		.state = GUIButtonState_Disabled,
+		.touchCallback = guiAdcTopButtonCallback,
+		.text[0] = "ADC",
+		.textSize[0] = LCDFontEnlarge_1x,
+	};
+
+	GUIButton_Add(&topButton);
+}
+
+/**
+ * @brief	Initializes the ADC sidebar and the ADC main content, called the first time the sidebar is shown
+ * @param	None
+ * @retval	None
+ */
+void guiAdcInitSidebarGuiElements()
 {
 	/* Text boxes ----------------------------------------------------------------*/
-	/* ADC Label text box */
-	prvTextBox.object.id = GUITextBoxId_AdcLabel;
-	prvTextBox.object.xPos = 650;
-	prvTextBox.object.yPos = 50;
-	prvTextBox.object.width = 150;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvTextBox.object.borderThickness = 1;
-	prvTextBox.object.borderColor = GUI_WHITE;
-	prvTextBox.object.containerPage = GUIContainerPage_All;
-	prvTextBox.textColor = GUI_MAGENTA;
-	prvTextBox.backgroundColor = GUI_WHITE;
-	prvTextBox.staticText = "ADC";
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* ADC channel 0 Value text box */
-	prvTextBox.object.id = GUITextBoxId_Adc0Value;
-	prvTextBox.object.xPos = 50;
-	prvTextBox.object.yPos = 200;
-	prvTextBox.object.width = 300;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.containerPage = GUIContainerPage_1;
-	prvTextBox.textColor = GUI_MAGENTA;
-	prvTextBox.backgroundColor = GUI_WHITE;
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* ADC channel 1 Value text box */
-	prvTextBox.object.id = GUITextBoxId_Adc1Value;
-	prvTextBox.object.xPos = 50;
-	prvTextBox.object.yPos = 300;
-	prvTextBox.object.width = 300;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.containerPage = GUIContainerPage_1;
-	prvTextBox.textColor = GUI_MAGENTA;
-	prvTextBox.backgroundColor = GUI_WHITE;
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
+	static const GUITextBox textBoxes[] = {
+		/* ADC Label text box */
+		{
+			.object.id = GUITextBoxId_AdcLabel,
+			.object.xPos = 650,
+			.object.yPos = 50,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_All,
+			.textColor = GUI_MAGENTA,
+			.backgroundColor = GUI_WHITE,
+			.staticText = "ADC",
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* ADC channel 0 Value text box */
+		{
+			.object.id = GUITextBoxId_Adc0Value,
+			.object.xPos = 50,
+			.object.yPos = 200,
+			.object.width = 300,
+			.object.height = 50,
+			.object.containerPage = GUIContainerPage_1,
+			.textColor = GUI_MAGENTA,
+			.backgroundColor = GUI_WHITE,
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* ADC channel 1 Value text box */
+		{
+			.object.id = GUITextBoxId_Adc1Value,
+			.object.xPos = 50,
+			.object.yPos = 300,
+			.object.width = 300,
+			.object.height = 50,
+			.object.containerPage = GUIContainerPage_1,
+			.textColor = GUI_MAGENTA,
+			.backgroundColor = GUI_WHITE,
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* ADC acquisition status text box */
+		{
+			.object.id = GUITextBoxId_AdcStatus,
+			.object.xPos = 50,
+			.object.yPos = 100,
+			.object.width = 550,
+			.object.height = 50,
+			.object.containerPage = GUIContainerPage_1,
+			.textColor = GUI_MAGENTA,
+			.backgroundColor = GUI_WHITE,
+			.textSize = LCDFontEnlarge_1x,
+		},
+		/* ADC total statistics text box */
+		{
+			.object.id = GUITextBoxId_AdcTotalStatistics,
+			.object.xPos = 50,
+			.object.yPos = 250,
+			.object.width = 550,
+			.object.height = 50,
+			.object.containerPage = GUIContainerPage_1,
+			.textColor = GUI_MAGENTA,
+			.backgroundColor = GUI_WHITE,
+			.textSize = LCDFontEnlarge_1x,
+		},
+		/* ADC sliding window statistics text box */
+		{
+			.object.id = GUITextBoxId_AdcWindowStatistics,
+			.object.xPos = 50,
+			.object.yPos = 350,
+			.object.width = 550,
+			.object.height = 50,
+			.object.containerPage = GUIContainerPage_1,
+			.textColor = GUI_MAGENTA,
+			.backgroundColor = GUI_WHITE,
+			.textSize = LCDFontEnlarge_1x,
+		},
+		/* ADC scope status text box */
+		{
+			.object.id = GUITextBoxId_AdcScopeStatus,
+			.object.xPos = 25,
+			.object.yPos = 60,
+			.object.width = 600,
+			.object.height = 40,
+			.object.containerPage = GUIContainerPage_2,
+			.textColor = GUI_MAGENTA,
+			.backgroundColor = GUI_WHITE,
+			.textSize = LCDFontEnlarge_1x,
+		},
+		/* ADC spectrum status text box */
+		{
+			.object.id = GUITextBoxId_AdcSpectrumStatus,
+			.object.xPos = 25,
+			.object.yPos = 60,
+			.object.width = 600,
+			.object.height = 40,
+			.object.containerPage = GUIContainerPage_3,
+			.textColor = GUI_MAGENTA,
+			.backgroundColor = GUI_WHITE,
+			.textSize = LCDFontEnlarge_1x,
+		},
+	};
 
 	/* Buttons -------------------------------------------------------------------*/
-	/* ADC Top Button */
-	prvButton.object.id = GUIButtonId_AdcTop;
-	prvButton.object.xPos = 600;
-	prvButton.object.yPos = 0;
-	prvButton.object.width = 50;
-	prvButton.object.height = 50;
-	prvButton.object.displayState = GUIDisplayState_NotHidden;
-	prvButton.object.border = GUIBorder_Bottom | GUIBorder_Right | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_MAGENTA;
-	prvButton.disabledTextColor = GUI_MAGENTA;
-	prvButton.disabledBackgroundColor = LCD_COLOR_BLACK;
-	prvButton.pressedTextColor = GUI_MAGENTA;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_DisabledTouch;			/* TODO: Something is wrong with ADC, so disabled for now */
-	prvButton.touchCallback = guiAdcTopButtonCallback;
-	prvButton.text[0] = "ADC";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* ADC Enable Button */
-	prvButton.object.id = GUIButtonId_AdcEnable;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 100;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_MAGENTA;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_MAGENTA;
-	prvButton.pressedTextColor = GUI_MAGENTA;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = 0;
-	prvButton.text[0] = "Output:";
-//	prvButton.text[1] = "Enabled";
-	prvButton.text[1] = "Disabled";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
+	static const GUIButton buttons[] = {
+		/* ADC Enable Button */
+		{
+			.object.id = GUIButtonId_AdcEnable,
+			.object.xPos = 650,
+			.object.yPos = 100,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_MAGENTA,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_MAGENTA,
+			.pressedTextColor = GUI_MAGENTA,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiAdcEnableButtonCallback,
+			.text[0] = "Sampling:",
+//			.text[1] = "Enabled",
+			.text[1] = "Disabled",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* ADC Sample Rate Button */
+		{
+			.object.id = GUIButtonId_AdcSampleRate,
+			.object.xPos = 650,
+			.object.yPos = 150,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_MAGENTA,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_MAGENTA,
+			.pressedTextColor = GUI_MAGENTA,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiAdcSampleRateButtonCallback,
+			.text[0] = "Sample Rate:",
+			.text[1] = prvSampleRateText[prvSampleRateIndex],
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* ADC View Button */
+		{
+			.object.id = GUIButtonId_AdcView,
+			.object.xPos = 650,
+			.object.yPos = 200,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_MAGENTA,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_MAGENTA,
+			.pressedTextColor = GUI_MAGENTA,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiAdcViewButtonCallback,
+			.text[0] = "View:",
+			.text[1] = "Values",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* ADC Filter Button */
+		{
+			.object.id = GUIButtonId_AdcFilter,
+			.object.xPos = 650,
+			.object.yPos = 250,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_MAGENTA,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_MAGENTA,
+			.pressedTextColor = GUI_MAGENTA,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiAdcFilterButtonCallback,
+			.text[0] = "Filter:",
+			.text[1] = prvFilterText[prvFilterIndex],
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* ADC Trigger Mode Button */
+		{
+			.object.id = GUIButtonId_AdcTriggerMode,
+			.object.xPos = 650,
+			.object.yPos = 100,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_2,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_MAGENTA,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_MAGENTA,
+			.pressedTextColor = GUI_MAGENTA,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiAdcScopeButtonCallback,
+			.text[0] = "Trigger:",
+			.text[1] = prvTriggerModeText[prvScopeSettings.mode],
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* ADC Trigger Edge Button */
+		{
+			.object.id = GUIButtonId_AdcTriggerEdge,
+			.object.xPos = 650,
+			.object.yPos = 150,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_2,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_MAGENTA,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_MAGENTA,
+			.pressedTextColor = GUI_MAGENTA,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiAdcScopeButtonCallback,
+			.text[0] = "Edge:",
+			.text[1] = "Rising",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* ADC Trigger Level Button */
+		{
+			.object.id = GUIButtonId_AdcTriggerLevel,
+			.object.xPos = 650,
+			.object.yPos = 200,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_2,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_MAGENTA,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_MAGENTA,
+			.pressedTextColor = GUI_MAGENTA,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiAdcScopeButtonCallback,
+			.text[0] = "Level:",
+			.text[1] = prvTriggerLevelText[prvTriggerLevelIndex],
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* ADC Pre-trigger Button */
+		{
+			.object.id = GUIButtonId_AdcPreTrigger,
+			.object.xPos = 650,
+			.object.yPos = 250,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_2,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_MAGENTA,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_MAGENTA,
+			.pressedTextColor = GUI_MAGENTA,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiAdcScopeButtonCallback,
+			.text[0] = "Pre-trigger:",
+			.text[1] = prvPreTriggerText[prvPreTriggerIndex],
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* ADC Spectrum Size Button */
+		{
+			.object.id = GUIButtonId_AdcSpectrumSize,
+			.object.xPos = 650,
+			.object.yPos = 300,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_2,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_MAGENTA,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_MAGENTA,
+			.pressedTextColor = GUI_MAGENTA,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiAdcSpectrumButtonCallback,
+			.text[0] = "FFT Size:",
+			.text[1] = prvSpectrumSizeText[prvSpectrumSizeIndex],
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* ADC Spectrum Averages Button */
+		{
+			.object.id = GUIButtonId_AdcSpectrumAverages,
+			.object.xPos = 650,
+			.object.yPos = 350,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_2,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_MAGENTA,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_MAGENTA,
+			.pressedTextColor = GUI_MAGENTA,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiAdcSpectrumButtonCallback,
+			.text[0] = "Averaging:",
+			.text[1] = prvAveragesText[prvAveragesIndex],
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* ADC Sidebar backwards button */
+		{
+			.object.id = GUIButtonId_AdcSidebarBackwards,
+			.object.xPos = 650,
+			.object.yPos = 400,
+			.object.width = 75,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left | GUIBorder_Right,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_All,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_MAGENTA,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_DARK_PURPLE,
+			.pressedTextColor = GUI_MAGENTA,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_DisabledTouch,
+			.touchCallback = guiAdcSidebarForwardBackwardsButtonsCallback,
+			.text[0] = "<",
+			.text[1] = 0,
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* ADC Sidebar forwards button */
+		{
+			.object.id = GUIButtonId_AdcSidebarForwards,
+			.object.xPos = 725,
+			.object.yPos = 400,
+			.object.width = 75,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_All,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_MAGENTA,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_DARK_PURPLE,
+			.pressedTextColor = GUI_MAGENTA,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Enabled,
+			.touchCallback = guiAdcSidebarForwardBackwardsButtonsCallback,
+			.text[0] = ">",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+	};
 
 	/* Containers ----------------------------------------------------------------*/
-	/* Sidebar ADC container */
-	prvContainer.object.id = GUIContainerId_SidebarAdc;
-	prvContainer.object.xPos = 650;
-	prvContainer.object.yPos = 50;
-	prvContainer.object.width = 150;
-	prvContainer.object.height = 400;
-	prvContainer.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvContainer.object.borderThickness = 1;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.activePage = GUIContainerPage_1;
-	prvContainer.contentHideState = GUIHideState_KeepBorders;
-	prvContainer.buttons[0] = GUIButton_GetFromId(GUIButtonId_AdcEnable);
-	prvContainer.textBoxes[0] = GUITextBox_GetFromId(GUITextBoxId_AdcLabel);
-	GUIContainer_Add(&prvContainer);
-
-	/* ADC main container */
-	prvContainer.object.id = GUIContainerId_AdcMainContent;
-	prvContainer.object.xPos = 0;
-	prvContainer.object.yPos = 50;
-	prvContainer.object.width = 650;
-	prvContainer.object.height = 400;
-	prvContainer.object.containerPage = guiConfigMAIN_CONTAINER_ADC_PAGE;
-	prvContainer.object.border = GUIBorder_Right | GUIBorder_Top;
-	prvContainer.object.borderThickness = 2;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.activePage = GUIContainerPage_1;
-	prvContainer.backgroundColor = GUI_BLACK;
-	prvContainer.contentHideState = GUIHideState_HideAll;
-	prvContainer.textBoxes[0] = GUITextBox_GetFromId(GUITextBoxId_Adc0Value);
-	prvContainer.textBoxes[1] = GUITextBox_GetFromId(GUITextBoxId_Adc1Value);
-	GUIContainer_Add(&prvContainer);
+	static const GUIContainerTemplate containers[] = {
+		/* Sidebar ADC container */
+		{
+			.object.id = GUIContainerId_SidebarAdc,
+			.object.xPos = 650,
+			.object.yPos = 50,
+			.object.width = 150,
+			.object.height = 400,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.activePage = GUIContainerPage_1,
+			.lastPage = GUIContainerPage_2,
+			.contentHideState = GUIHideState_KeepBorders,
+			.buttons[0] = GUIButtonId_AdcEnable,
+			.buttons[1] = GUIButtonId_AdcSampleRate,
+			.buttons[2] = GUIButtonId_AdcView,
+			.buttons[3] = GUIButtonId_AdcFilter,
+			.buttons[4] = GUIButtonId_AdcTriggerMode,
+			.buttons[5] = GUIButtonId_AdcTriggerEdge,
+			.buttons[6] = GUIButtonId_AdcTriggerLevel,
+			.buttons[7] = GUIButtonId_AdcPreTrigger,
+			.buttons[8] = GUIButtonId_AdcSpectrumSize,
+			.buttons[9] = GUIButtonId_AdcSpectrumAverages,
+			.buttons[10] = GUIButtonId_AdcSidebarBackwards,
+			.buttons[11] = GUIButtonId_AdcSidebarForwards,
+			.textBoxes[0] = GUITextBoxId_AdcLabel,
+		},
+		/* ADC main container */
+		{
+			.object.id = GUIContainerId_AdcMainContent,
+			.object.xPos = 0,
+			.object.yPos = 50,
+			.object.width = 650,
+			.object.height = 400,
+			.object.containerPage = guiConfigMAIN_CONTAINER_ADC_PAGE,
+			.object.border = GUIBorder_Right | GUIBorder_Top,
+			.object.borderThickness = 2,
+			.object.borderColor = GUI_WHITE,
+			.activePage = GUIContainerPage_1,
+			.lastPage = GUIContainerPage_3,
+			.backgroundColor = GUI_BLACK,
+			.contentHideState = GUIHideState_HideAll,
+			.textBoxes[0] = GUITextBoxId_Adc0Value,
+			.textBoxes[1] = GUITextBoxId_Adc1Value,
+			.textBoxes[2] = GUITextBoxId_AdcStatus,
+			.textBoxes[3] = GUITextBoxId_AdcTotalStatistics,
+			.textBoxes[4] = GUITextBoxId_AdcWindowStatistics,
+			.textBoxes[5] = GUITextBoxId_AdcScopeStatus,
+			.textBoxes[6] = GUITextBoxId_AdcSpectrumStatus,
+		},
+	};
+
+	static const GUILayout layout = {
+		textBoxes, GUI_NUM_OF_OBJECTS(textBoxes),
+		buttons, GUI_NUM_OF_OBJECTS(buttons),
+		containers, GUI_NUM_OF_OBJECTS(containers),
+	};
+	GUI_AddLayout(&layout);
+}
+
+/* Private functions .--------------------------------------------------------*/
+/**
+ * @brief	Write statistics on one line in a text box
+ * @param	TextBoxId: The text box to write to
+ * @param	pLabel: Text in front of the values
+ * @param	pResult: The statistics
+ * @retval	None
+ */
+static void prvWriteStatistics(uint32_t TextBoxId, uint8_t* pLabel, ADCStatsResult* pResult)
+{
+	GUITextBox_ClearAndResetWritePosition(TextBoxId);
+	GUITextBox_SetYWritePositionToCenter(TextBoxId);
+	GUITextBox_WriteString(TextBoxId, pLabel);
+	GUITextBox_WriteString(TextBoxId, " min ");
+	GUITextBox_WriteNumber(TextBoxId, (int32_t)pResult->min);
+	GUITextBox_WriteString(TextBoxId, " max ");
+	GUITextBox_WriteNumber(TextBoxId, (int32_t)pResult->max);
+	GUITextBox_WriteString(TextBoxId, " p-p ");
+	GUITextBox_WriteNumber(TextBoxId, (int32_t)pResult->peakToPeak);
+	GUITextBox_WriteString(TextBoxId, " mean ");
+	GUITextBox_WriteNumber(TextBoxId, (int32_t)pResult->mean);
+	GUITextBox_WriteString(TextBoxId, " rms ");
+	GUITextBox_WriteNumber(TextBoxId, (int32_t)pResult->rms);
+}
+
+/**
+ * @brief	Update the scope status and draw a new frame when there is one
+ * @param	ShouldRefresh: If the last frame should be drawn again
+ * @retval	None
+ */
+static void prvManageScope(bool ShouldRefresh)
+{
+	const ADCScopeFrame* pFrame;
+	bool frameIsNew = adcGetScopeFrame(&pFrame);
+	if (frameIsNew || ShouldRefresh)
+		prvDrawScopeFrame(pFrame);
+	if (frameIsNew)
+		adcReleaseScopeFrame();
+
+	GUITextBox_ClearAndResetWritePosition(GUITextBoxId_AdcScopeStatus);
+	GUITextBox_SetYWritePositionToCenter(GUITextBoxId_AdcScopeStatus);
+	if (!adcIsAcquiring())
+	{
+		GUITextBox_WriteString(GUITextBoxId_AdcScopeStatus, "Enable sampling to use the scope");
+		return;
+	}
+
+	switch (adcGetScopeState())
+	{
+		case ADCScopeState_Filling:
+		case ADCScopeState_Armed:
+			GUITextBox_WriteString(GUITextBoxId_AdcScopeStatus, "Waiting for trigger");
+			break;
+		case ADCScopeState_Capturing:
+			GUITextBox_WriteString(GUITextBoxId_AdcScopeStatus, "Triggered");
+			break;
+		case ADCScopeState_Done:
+			GUITextBox_WriteString(GUITextBoxId_AdcScopeStatus, "Done, press Trigger to re-arm");
+			break;
+		default:
+			GUITextBox_WriteString(GUITextBoxId_AdcScopeStatus, "Stopped");
+			break;
+	}
+	GUITextBox_WriteString(GUITextBoxId_AdcScopeStatus, ", frame ");
+	GUITextBox_WriteNumber(GUITextBoxId_AdcScopeStatus, (int32_t)pFrame->frameNumber);
+	if (pFrame->frameNumber != 0 && !pFrame->triggered)
+		GUITextBox_WriteString(GUITextBoxId_AdcScopeStatus, " (auto)");
+}
+
+/**
+ * @brief	Draw a scope frame, one vertical line from min to max for every column
+ * @param	pFrame: The frame to draw
+ * @retval	None
+ */
+static void prvDrawScopeFrame(const ADCScopeFrame* pFrame)
+{
+	prvClearScope();
+
+	/* Zero line and trigger position */
+	uint16_t xEnd = SCOPE_X_POS + ADC_SCOPE_NUM_OF_COLUMNS - 1;
+	LCD_SetForegroundColor(GUI_DARK_PURPLE);
+	LCD_DrawSquareOrLine(SCOPE_X_POS, xEnd, prvScopeYPos(0), prvScopeYPos(0), LCDDrawType_Line, LCDFill_NoFill);
+	LCD_SetForegroundColor(GUI_DARK_YELLOW);
+	LCD_DrawSquareOrLine(SCOPE_X_POS, xEnd, prvScopeYPos(prvScopeSettings.level), prvScopeYPos(prvScopeSettings.level),
+						 LCDDrawType_Line, LCDFill_NoFill);
+	LCD_DrawSquareOrLine(SCOPE_X_POS + pFrame->triggerColumn, SCOPE_X_POS + pFrame->triggerColumn,
+						 SCOPE_Y_POS, SCOPE_Y_POS + SCOPE_HEIGHT - 1, LCDDrawType_Line, LCDFill_NoFill);
+
+	if (pFrame->frameNumber == 0)
+		return;
+
+	/* The waveform, every line is extended to touch the previous column so that steep edges stay connected */
+	LCD_SetForegroundColor(GUI_MAGENTA);
+	uint16_t previousTop = 0, previousBottom = 0;
+	for (uint32_t column = 0; column < ADC_SCOPE_NUM_OF_COLUMNS; column++)
+	{
+		uint16_t top = prvScopeYPos(pFrame->max[column]);
+		uint16_t bottom = prvScopeYPos(pFrame->min[column]);
+		uint16_t lineTop = top, lineBottom = bottom;
+		if (column != 0)
+		{
+			if (lineTop > previousBottom)
+				lineTop = previousBottom;
+			if (lineBottom < previousTop)
+				lineBottom = previousTop;
+		}
+		LCD_DrawSquareOrLine(SCOPE_X_POS + column, SCOPE_X_POS + column, lineTop, lineBottom, LCDDrawType_Line, LCDFill_NoFill);
+		previousTop = top;
+		previousBottom = bottom;
+	}
+}
+
+/**
+ * @brief	Update the spectrum status and draw a new frame when there is one
+ * @param	ShouldRefresh: If the last frame should be drawn again
+ * @retval	None
+ */
+static void prvManageSpectrum(bool ShouldRefresh)
+{
+	const ADCSpectrumFrame* pFrame;
+	bool frameIsNew = adcGetSpectrumFrame(&pFrame);
+	if (frameIsNew || ShouldRefresh)
+		prvDrawSpectrumFrame(pFrame);
+	if (frameIsNew)
+		adcReleaseSpectrumFrame();
+
+	GUITextBox_ClearAndResetWritePosition(GUITextBoxId_AdcSpectrumStatus);
+	GUITextBox_SetYWritePositionToCenter(GUITextBoxId_AdcSpectrumStatus);
+	if (!adcIsAcquiring())
+	{
+		GUITextBox_WriteString(GUITextBoxId_AdcSpectrumStatus, "Enable sampling to use the spectrum");
+		return;
+	}
+	else if (pFrame->frameNumber == 0)
+	{
+		GUITextBox_WriteString(GUITextBoxId_AdcSpectrumStatus, "Collecting samples");
+		return;
+	}
+
+	GUITextBox_WriteString(GUITextBoxId_AdcSpectrumStatus, "Peak: ");
+	prvWriteTenths(GUITextBoxId_AdcSpectrumStatus, (int32_t)(pFrame->peakFrequency / 100));
+	GUITextBox_WriteString(GUITextBoxId_AdcSpectrumStatus, " Hz ");
+	prvWriteTenths(GUITextBoxId_AdcSpectrumStatus, pFrame->peakLevel);
+	GUITextBox_WriteString(GUITextBoxId_AdcSpectrumStatus, " dBFS, bin: ");
+	prvWriteTenths(GUITextBoxId_AdcSpectrumStatus, (int32_t)(pFrame->binWidth / 100));
+	GUITextBox_WriteString(GUITextBoxId_AdcSpectrumStatus, " Hz, averages: ");
+	GUITextBox_WriteNumber(GUITextBoxId_AdcSpectrumStatus, (int32_t)pFrame->numOfAverages);
+}
+
+/**
+ * @brief	Draw a spectrum frame, one column from the bottom up to the highest bin in it
+ * @param	pFrame: The frame to draw
+ * @retval	None
+ */
+static void prvDrawSpectrumFrame(const ADCSpectrumFrame* pFrame)
+{
+	prvClearScope();
+
+	/* Grid lines every SPECTRUM_GRID_STEP below full scale */
+	uint16_t xEnd = SCOPE_X_POS + ADC_SCOPE_NUM_OF_COLUMNS - 1;
+	uint16_t yBottom = SCOPE_Y_POS + SCOPE_HEIGHT - 1;
+	LCD_SetForegroundColor(GUI_DARK_PURPLE);
+	for (int32_t level = 0; level > -SPECTRUM_RANGE; level -= SPECTRUM_GRID_STEP)
+		LCD_DrawSquareOrLine(SCOPE_X_POS, xEnd, prvSpectrumYPos(level), prvSpectrumYPos(level), LCDDrawType_Line, LCDFill_NoFill);
+
+	if (pFrame->frameNumber == 0 || pFrame->numOfBins == 0)
+		return;
+
+	/* Peak marker */
+	uint16_t peakColumn = (uint16_t)(pFrame->peakBin * ADC_SCOPE_NUM_OF_COLUMNS / pFrame->numOfBins);
+	LCD_SetForegroundColor(GUI_DARK_YELLOW);
+	LCD_DrawSquareOrLine(SCOPE_X_POS + peakColumn, SCOPE_X_POS + peakColumn, SCOPE_Y_POS, yBottom, LCDDrawType_Line, LCDFill_NoFill);
+
+	/* The bins are stretched or reduced to the columns, the highest bin in a column is shown so no peak is missed */
+	LCD_SetForegroundColor(GUI_MAGENTA);
+	for (uint32_t column = 0; column < ADC_SCOPE_NUM_OF_COLUMNS; column++)
+	{
+		uint32_t firstBin = column * pFrame->numOfBins / ADC_SCOPE_NUM_OF_COLUMNS;
+		uint32_t lastBin = (column + 1) * pFrame->numOfBins / ADC_SCOPE_NUM_OF_COLUMNS;
+		int32_t level = pFrame->level[firstBin];
+		for (uint32_t bin = firstBin + 1; bin < lastBin; bin++)
+		{
+			if (pFrame->level[bin] > level)
+				level = pFrame->level[bin];
+		}
+		uint16_t top = prvSpectrumYPos(level);
+		if (top < yBottom)
+			LCD_DrawSquareOrLine(SCOPE_X_POS + column, SCOPE_X_POS + column, top, yBottom, LCDDrawType_Line, LCDFill_NoFill);
+	}
+}
+
+/**
+ * @brief	Clear the area the scope is drawn in
+ * @param	None
+ * @retval	None
+ */
+static void prvClearScope()
+{
+	LCD_SetForegroundColor(GUI_BLACK);
+	LCD_DrawSquareOrLine(SCOPE_X_POS, SCOPE_X_POS + ADC_SCOPE_NUM_OF_COLUMNS - 1,
+						 SCOPE_Y_POS, SCOPE_Y_POS + SCOPE_HEIGHT - 1, LCDDrawType_Square, LCDFill_Fill);
+}
+
+/**
+ * @brief	Get the y position on the display for a sample value, full scale is the height of the scope
+ * @param	Value: The sample value
+ * @retval	The y position
+ */
+static uint16_t prvScopeYPos(int32_t Value)
+{
+	return (uint16_t)(SCOPE_Y_POS + SCOPE_HEIGHT / 2 - 1 - (Value * (SCOPE_HEIGHT / 2)) / 32768);
+}
+
+/**
+ * @brief	Get the y position on the display for a spectrum level, full scale is at the top
+ * @param	Level: The level in 0.1 dBFS
+ * @retval	The y position
+ */
+static uint16_t prvSpectrumYPos(int32_t Level)
+{
+	if (Level > 0)
+		Level = 0;
+	else if (Level < -SPECTRUM_RANGE)
+		Level = -SPECTRUM_RANGE;
+	return (uint16_t)(SCOPE_Y_POS + (-Level * (SCOPE_HEIGHT - 1)) / SPECTRUM_RANGE);
+}
+
+/**
+ * @brief	Write a value with one decimal
+ * @param	TextBoxId: The text box to write to
+ * @param	Value: The value in tenths
+ * @retval	None
+ */
+static void prvWriteTenths(uint32_t TextBoxId, int32_t Value)
+{
+	if (Value < 0)
+	{
+		GUITextBox_WriteString(TextBoxId, "-");
+		Value = -Value;
+	}
+	GUITextBox_WriteNumber(TextBoxId, Value / 10);
+	GUITextBox_WriteString(TextBoxId, ".");
+	GUITextBox_WriteNumber(TextBoxId, Value % 10);
 }
 
 /* Interrupt Handlers --------------------------------------------------------*/
@@ -33,10 +33,6 @@
 
 /* Private typedefs ----------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
-static GUITextBox prvTextBox = {0};
-static GUIButton prvButton = {0};
-static GUIContainer prvContainer = {0};
-
 static CANDisplayedItem prvMessageList[MAX_MESSAGES_IN_LIST];
 static uint32_t prvNextIndexInList = 0;
 
@@ -384,383 +380,410 @@ void guiCan1ClearButtonCallback(GUITouchEvent Event, uint32_t ButtonId)
 }
 
 /**
- * @brief
+ * @brief	Initializes the CAN1 top button, the rest is initialized by guiCan1InitSidebarGuiElements
  * @param	None
  * @retval	None
  */
 void guiCan1InitGuiElements()
+{
+	/* Buttons -------------------------------------------------------------------*/
+	/* CAN1 Top Button */
+	static const GUIButton topButton = {
+		.object.id = GUIButtonId_Can1Top,
+		.object.xPos = 0,
+		.object.yPos = 0,
+		.object.width = 100,
+		.object.height = 50,
+		.object.displayState = GUIDisplayState_NotHidden,
+		.object.border = GUIBorder_Bottom | GUIBorder_Right,
+		.object.borderThickness = 1,
+		.object.borderColor = GUI_WHITE,
+		.enabledTextColor = GUI_WHITE,
+		.enabledBackgroundColor = GUI_BLUE,
+		.disabledTextColor = GUI_BLUE,
+		.disabledBackgroundColor = LCD_COLOR_BLACK,
+		.pressedTextColor = GUI_BLUE,
+		.pressedBackgroundColor = GUI_WHITE,
+		.state = GUIButtonState_Disabled,
+		.touchCallback = guiCan1TopButtonCallback,
+		.text[0] = "CAN1",
+		.textSize[0] = LCDFontEnlarge_2x,
+	};
+
+	GUIButton_Add(&topButton);
+}
+
+/**
+ * @brief	Initializes the CAN1 sidebar, its bit rate popout and the CAN1 main text box, called the first time the sidebar is shown
+ * @param	None
+ * @retval	None
+ */
+void guiCan1InitSidebarGuiElements()
 {
 	/* Text boxes ----------------------------------------------------------------*/
-	/* CAN1 Label text box */
-	prvTextBox.object.id = GUITextBoxId_Can1Label;
-	prvTextBox.object.xPos = 650;
-	prvTextBox.object.yPos = 50;
-	prvTextBox.object.width = 150;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvTextBox.object.borderThickness = 1;
-	prvTextBox.object.borderColor = GUI_WHITE;
-	prvTextBox.object.containerPage = GUIContainerPage_All;
-	prvTextBox.textColor = GUI_BLUE;
-	prvTextBox.backgroundColor = GUI_WHITE;
-	prvTextBox.staticText = "CAN1";
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* CAN1 Main text box */
-	prvTextBox.object.id = GUITextBoxId_Can1Main;
-	prvTextBox.object.xPos = 0;
-	prvTextBox.object.yPos = 50;
-	prvTextBox.object.width = 650;
-	prvTextBox.object.height = 400;
-	prvTextBox.object.border = GUIBorder_Top | GUIBorder_Right;
-	prvTextBox.object.borderThickness = 1;
-	prvTextBox.object.borderColor = GUI_WHITE;
-	prvTextBox.object.containerPage = GUIContainerPage_1;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = LCD_COLOR_BLACK;
-	prvTextBox.textSize = LCDFontEnlarge_1x;
-//	prvTextBox.padding.bottom = guiConfigFONT_HEIGHT_UNIT;
-//	prvTextBox.padding.top = guiConfigFONT_HEIGHT_UNIT;
-//	prvTextBox.padding.left = guiConfigFONT_WIDTH_UNIT;
-//	prvTextBox.padding.right = guiConfigFONT_WIDTH_UNIT;
-	GUITextBox_Add(&prvTextBox);
+	static const GUITextBox textBoxes[] = {
+		/* CAN1 Label text box */
+		{
+			.object.id = GUITextBoxId_Can1Label,
+			.object.xPos = 650,
+			.object.yPos = 50,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_All,
+			.textColor = GUI_BLUE,
+			.backgroundColor = GUI_WHITE,
+			.staticText = "CAN1",
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* CAN1 Main text box */
+		{
+			.object.id = GUITextBoxId_Can1Main,
+			.object.xPos = 0,
+			.object.yPos = 50,
+			.object.width = 650,
+			.object.height = 400,
+			.object.border = GUIBorder_Top | GUIBorder_Right,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.textColor = GUI_WHITE,
+			.backgroundColor = LCD_COLOR_BLACK,
+			.textSize = LCDFontEnlarge_1x,
+//			.padding.bottom = guiConfigFONT_HEIGHT_UNIT,
+//			.padding.top = guiConfigFONT_HEIGHT_UNIT,
+//			.padding.left = guiConfigFONT_WIDTH_UNIT,
+//			.padding.right = guiConfigFONT_WIDTH_UNIT,
+		},
+	};
 
 	/* Buttons -------------------------------------------------------------------*/
-	/* CAN1 Top Button */
-	prvButton.object.id = GUIButtonId_Can1Top;
-	prvButton.object.xPos = 0;
-	prvButton.object.yPos = 0;
-	prvButton.object.width = 100;
-	prvButton.object.height = 50;
-	prvButton.object.displayState = GUIDisplayState_NotHidden;
-	prvButton.object.border = GUIBorder_Bottom | GUIBorder_Right;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_BLUE;
-	prvButton.disabledTextColor = GUI_BLUE;
-	prvButton.disabledBackgroundColor = LCD_COLOR_BLACK;
-	prvButton.pressedTextColor = GUI_BLUE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan1TopButtonCallback;
-	prvButton.text[0] = "CAN1";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN1 Enable Button */
-	prvButton.object.id = GUIButtonId_Can1Enable;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 100;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_BLUE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_BLUE;
-	prvButton.pressedTextColor = GUI_BLUE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan1EnableButtonCallback;
-	prvButton.text[0] = "Output:";
-//	prvButton.text[1] = "Enabled ";
-	prvButton.text[1] = "Disabled";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN1 Bit Rate Button */
-	prvButton.object.id = GUIButtonId_Can1BitRate;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 150;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_DARK_BLUE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_BLUE;
-	prvButton.pressedTextColor = GUI_BLUE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan1BitRateButtonCallback;
-	prvButton.text[0] = "< Bit Rate:";
-	prvButton.text[1] = "125kbit/s";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN1 Termination Button */
-	prvButton.object.id = GUIButtonId_Can1Termination;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 200;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_BLUE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_BLUE;
-	prvButton.pressedTextColor = GUI_BLUE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan1TerminationButtonCallback;
-	prvButton.text[0] = "Termination:";
-	prvButton.text[1] = "None";
-//	prvButton.text[1] = "120 R";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN1 Clear Button */
-	prvButton.object.id = GUIButtonId_Can1Clear;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 250;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_BLUE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_BLUE;
-	prvButton.pressedTextColor = GUI_BLUE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan1ClearButtonCallback;
-	prvButton.text[0] = "Clear";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-
-	/* CAN1 10k bit rate Button */
-	prvButton.object.id = GUIButtonId_Can1BitRate10k;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 150;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_BLUE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_BLUE;
-	prvButton.pressedTextColor = GUI_BLUE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan1BitRateSelectionCallback;
-	prvButton.text[0] = "10kbit/s";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN1 20k bit rate Button */
-	prvButton.object.id = GUIButtonId_Can1BitRate20k;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 190;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_BLUE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_BLUE;
-	prvButton.pressedTextColor = GUI_BLUE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan1BitRateSelectionCallback;
-	prvButton.text[0] = "20kbit/s";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN1 50k bit rate Button */
-	prvButton.object.id = GUIButtonId_Can1BitRate50k;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 230;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_BLUE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_BLUE;
-	prvButton.pressedTextColor = GUI_BLUE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan1BitRateSelectionCallback;
-	prvButton.text[0] = "50kbit/s";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN1 100k bit rate Button */
-	prvButton.object.id = GUIButtonId_Can1BitRate100k;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 270;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_BLUE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_BLUE;
-	prvButton.pressedTextColor = GUI_BLUE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan1BitRateSelectionCallback;
-	prvButton.text[0] = "100kbit/s";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN1 125k bit rate Button */
-	prvButton.object.id = GUIButtonId_Can1BitRate125k;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 310;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_BLUE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_BLUE;
-	prvButton.pressedTextColor = GUI_BLUE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan1BitRateSelectionCallback;
-	prvButton.text[0] = "125kbit/s";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN1 250k bit rate Button */
-	prvButton.object.id = GUIButtonId_Can1BitRate250k;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 350;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_BLUE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_BLUE;
-	prvButton.pressedTextColor = GUI_BLUE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan1BitRateSelectionCallback;
-	prvButton.text[0] = "250kbit/s";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN1 500k bit rate Button */
-	prvButton.object.id = GUIButtonId_Can1BitRate500k;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 390;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_BLUE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_BLUE;
-	prvButton.pressedTextColor = GUI_BLUE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan1BitRateSelectionCallback;
-	prvButton.text[0] = "500kbit/s";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN1 1M bit rate Button */
-	prvButton.object.id = GUIButtonId_Can1BitRate1M;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 430;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_BLUE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_BLUE;
-	prvButton.pressedTextColor = GUI_BLUE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan1BitRateSelectionCallback;
-	prvButton.text[0] = "1Mbit/s";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
+	static const GUIButton buttons[] = {
+		/* CAN1 Enable Button */
+		{
+			.object.id = GUIButtonId_Can1Enable,
+			.object.xPos = 650,
+			.object.yPos = 100,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_BLUE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_BLUE,
+			.pressedTextColor = GUI_BLUE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan1EnableButtonCallback,
+			.text[0] = "Output:",
+//			.text[1] = "Enabled ",
+			.text[1] = "Disabled",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* CAN1 Bit Rate Button */
+		{
+			.object.id = GUIButtonId_Can1BitRate,
+			.object.xPos = 650,
+			.object.yPos = 150,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_DARK_BLUE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_BLUE,
+			.pressedTextColor = GUI_BLUE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan1BitRateButtonCallback,
+			.text[0] = "< Bit Rate:",
+			.text[1] = "125kbit/s",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* CAN1 Termination Button */
+		{
+			.object.id = GUIButtonId_Can1Termination,
+			.object.xPos = 650,
+			.object.yPos = 200,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_BLUE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_BLUE,
+			.pressedTextColor = GUI_BLUE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan1TerminationButtonCallback,
+			.text[0] = "Termination:",
+			.text[1] = "None",
+//			.text[1] = "120 R",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* CAN1 Clear Button */
+		{
+			.object.id = GUIButtonId_Can1Clear,
+			.object.xPos = 650,
+			.object.yPos = 250,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_BLUE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_BLUE,
+			.pressedTextColor = GUI_BLUE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan1ClearButtonCallback,
+			.text[0] = "Clear",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* CAN1 10k bit rate Button */
+		{
+			.object.id = GUIButtonId_Can1BitRate10k,
+			.object.xPos = 500,
+			.object.yPos = 150,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_BLUE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_BLUE,
+			.pressedTextColor = GUI_BLUE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan1BitRateSelectionCallback,
+			.text[0] = "10kbit/s",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* CAN1 20k bit rate Button */
+		{
+			.object.id = GUIButtonId_Can1BitRate20k,
+			.object.xPos = 500,
+			.object.yPos = 190,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_BLUE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_BLUE,
+			.pressedTextColor = GUI_BLUE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan1BitRateSelectionCallback,
+			.text[0] = "20kbit/s",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* CAN1 50k bit rate Button */
+		{
+			.object.id = GUIButtonId_Can1BitRate50k,
+			.object.xPos = 500,
+			.object.yPos = 230,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_BLUE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_BLUE,
+			.pressedTextColor = GUI_BLUE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan1BitRateSelectionCallback,
+			.text[0] = "50kbit/s",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* CAN1 100k bit rate Button */
+		{
+			.object.id = GUIButtonId_Can1BitRate100k,
+			.object.xPos = 500,
+			.object.yPos = 270,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_BLUE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_BLUE,
+			.pressedTextColor = GUI_BLUE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan1BitRateSelectionCallback,
+			.text[0] = "100kbit/s",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* CAN1 125k bit rate Button */
+		{
+			.object.id = GUIButtonId_Can1BitRate125k,
+			.object.xPos = 500,
+			.object.yPos = 310,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_BLUE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_BLUE,
+			.pressedTextColor = GUI_BLUE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan1BitRateSelectionCallback,
+			.text[0] = "125kbit/s",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* CAN1 250k bit rate Button */
+		{
+			.object.id = GUIButtonId_Can1BitRate250k,
+			.object.xPos = 500,
+			.object.yPos = 350,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_BLUE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_BLUE,
+			.pressedTextColor = GUI_BLUE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan1BitRateSelectionCallback,
+			.text[0] = "250kbit/s",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* CAN1 500k bit rate Button */
+		{
+			.object.id = GUIButtonId_Can1BitRate500k,
+			.object.xPos = 500,
+			.object.yPos = 390,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_BLUE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_BLUE,
+			.pressedTextColor = GUI_BLUE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan1BitRateSelectionCallback,
+			.text[0] = "500kbit/s",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* CAN1 1M bit rate Button */
+		{
+			.object.id = GUIButtonId_Can1BitRate1M,
+			.object.xPos = 500,
+			.object.yPos = 430,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_BLUE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_BLUE,
+			.pressedTextColor = GUI_BLUE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan1BitRateSelectionCallback,
+			.text[0] = "1Mbit/s",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+	};
 
 	/* Containers ----------------------------------------------------------------*/
-	/* Sidebar CAN1 container */
-	prvContainer.object.id = GUIContainerId_SidebarCan1;
-	prvContainer.object.xPos = 650;
-	prvContainer.object.yPos = 50;
-	prvContainer.object.width = 150;
-	prvContainer.object.height = 400;
-	prvContainer.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvContainer.object.borderThickness = 1;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.activePage = GUIContainerPage_1;
-	prvContainer.contentHideState = GUIHideState_KeepBorders;
-	prvContainer.buttons[0] = GUIButton_GetFromId(GUIButtonId_Can1Enable);
-	prvContainer.buttons[1] = GUIButton_GetFromId(GUIButtonId_Can1BitRate);
-	prvContainer.buttons[2] = GUIButton_GetFromId(GUIButtonId_Can1Termination);
-	prvContainer.buttons[3] = GUIButton_GetFromId(GUIButtonId_Can1Clear);
-	prvContainer.textBoxes[0] = GUITextBox_GetFromId(GUITextBoxId_Can1Label);
-	GUIContainer_Add(&prvContainer);
-
-	/* CAN1 bit rate popout container */
-	prvContainer.object.id = GUIContainerId_PopoutCan1BitRate;
-	prvContainer.object.xPos = 500;
-	prvContainer.object.yPos = 150;
-	prvContainer.object.width = 149;
-	prvContainer.object.height = 320;
-	prvContainer.object.layer = GUILayer_1;
-	prvContainer.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvContainer.object.borderThickness = 2;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.contentHideState = GUIHideState_HideAll;
-	prvContainer.buttons[0] = GUIButton_GetFromId(GUIButtonId_Can1BitRate10k);
-	prvContainer.buttons[1] = GUIButton_GetFromId(GUIButtonId_Can1BitRate20k);
-	prvContainer.buttons[2] = GUIButton_GetFromId(GUIButtonId_Can1BitRate50k);
-	prvContainer.buttons[3] = GUIButton_GetFromId(GUIButtonId_Can1BitRate100k);
-	prvContainer.buttons[4] = GUIButton_GetFromId(GUIButtonId_Can1BitRate125k);
-	prvContainer.buttons[5] = GUIButton_GetFromId(GUIButtonId_Can1BitRate250k);
-	prvContainer.buttons[6] = GUIButton_GetFromId(GUIButtonId_Can1BitRate500k);
-	prvContainer.buttons[7] = GUIButton_GetFromId(GUIButtonId_Can1BitRate1M);
-	GUIContainer_Add(&prvContainer);
+	static const GUIContainerTemplate containers[] = {
+		/* Sidebar CAN1 container */
+		{
+			.object.id = GUIContainerId_SidebarCan1,
+			.object.xPos = 650,
+			.object.yPos = 50,
+			.object.width = 150,
+			.object.height = 400,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.activePage = GUIContainerPage_1,
+			.contentHideState = GUIHideState_KeepBorders,
+			.buttons[0] = GUIButtonId_Can1Enable,
+			.buttons[1] = GUIButtonId_Can1BitRate,
+			.buttons[2] = GUIButtonId_Can1Termination,
+			.buttons[3] = GUIButtonId_Can1Clear,
+			.textBoxes[0] = GUITextBoxId_Can1Label,
+		},
+		/* CAN1 bit rate popout container */
+		{
+			.object.id = GUIContainerId_PopoutCan1BitRate,
+			.object.xPos = 500,
+			.object.yPos = 150,
+			.object.width = 149,
+			.object.height = 320,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 2,
+			.object.borderColor = GUI_WHITE,
+			.contentHideState = GUIHideState_HideAll,
+			.buttons[0] = GUIButtonId_Can1BitRate10k,
+			.buttons[1] = GUIButtonId_Can1BitRate20k,
+			.buttons[2] = GUIButtonId_Can1BitRate50k,
+			.buttons[3] = GUIButtonId_Can1BitRate100k,
+			.buttons[4] = GUIButtonId_Can1BitRate125k,
+			.buttons[5] = GUIButtonId_Can1BitRate250k,
+			.buttons[6] = GUIButtonId_Can1BitRate500k,
+			.buttons[7] = GUIButtonId_Can1BitRate1M,
+		},
+	};
+
+	static const GUILayout layout = {
+		textBoxes, GUI_NUM_OF_OBJECTS(textBoxes),
+		buttons, GUI_NUM_OF_OBJECTS(buttons),
+		containers, GUI_NUM_OF_OBJECTS(containers),
+	};
+	GUI_AddLayout(&layout);
 }
 
 /* Private functions .--------------------------------------------------------*/
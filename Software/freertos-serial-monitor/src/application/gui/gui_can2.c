@@ -33,10 +33,6 @@
 
 /* Private typedefs ----------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
-static GUITextBox prvTextBox = {0};
-static GUIButton prvButton = {0};
-static GUIContainer prvContainer = {0};
-
 static CANDisplayedItem prvMessageList[MAX_MESSAGES_IN_LIST];
 static uint32_t prvNextIndexInList = 0;
 
@@ -425,370 +421,396 @@ void guiCan2UpdateGuiElementsReadFromSettings()
 }
 
 /**
- * @brief
+ * @brief	Initializes the CAN2 top button, the rest is initialized by guiCan2InitSidebarGuiElements
  * @param	None
  * @retval	None
  */
 void guiCan2InitGuiElements()
 {
-	/* Text boxes ----------------------------------------------------------------*/
-	/* CAN2 Label text box */
-	prvTextBox.object.id = GUITextBoxId_Can2Label;
-	prvTextBox.object.xPos = 650;
-	prvTextBox.object.yPos = 50;
-	prvTextBox.object.width = 150;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvTextBox.object.borderThickness = 1;
-	prvTextBox.object.borderColor = GUI_WHITE;
-	prvTextBox.object.containerPage = GUIContainerPage_All;
-	prvTextBox.textColor = GUI_RED;
-	prvTextBox.backgroundColor = GUI_WHITE;
-	prvTextBox.staticText = "CAN2";
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* CAN2 Main text box */
-	prvTextBox.object.id = GUITextBoxId_Can2Main;
-	prvTextBox.object.xPos = 0;
-	prvTextBox.object.yPos = 50;
-	prvTextBox.object.width = 650;
-	prvTextBox.object.height = 400;
-	prvTextBox.object.containerPage = GUIContainerPage_1;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = LCD_COLOR_BLACK;
-	prvTextBox.textSize = LCDFontEnlarge_1x;
-	GUITextBox_Add(&prvTextBox);
+	/* Buttons -------------------------------------------------------------------*/
+	/* CAN2 Top Button */
+	static const GUIButton topButton = {
+		.object.id = GUIButtonId_Can2Top,
+		.object.xPos = 100,
+		.object.yPos = 0,
+		.object.width = 100,
+		.object.height = 50,
+		.object.displayState = GUIDisplayState_NotHidden,
+		.object.border = GUIBorder_Bottom | GUIBorder_Right | GUIBorder_Left,
+		.object.borderThickness = 1,
+		.object.borderColor = GUI_WHITE,
+		.enabledTextColor = GUI_WHITE,
+		.enabledBackgroundColor = GUI_RED,
+		.disabledTextColor = GUI_RED,
+		.disabledBackgroundColor = LCD_COLOR_BLACK,
+		.pressedTextColor = GUI_RED,
+		.pressedBackgroundColor = GUI_WHITE,
+		.state = GUIButtonState_Disabled,
+		.touchCallback = guiCan2TopButtonCallback,
+		.text[0] = "CAN2",
+		.textSize[0] = LCDFontEnlarge_2x,
+	};
+
+	GUIButton_Add(&topButton);
+}
 
+/**
+ * @brief	Initializes the CAN2 sidebar, its bit rate popout and the CAN2 main content, called the first time the sidebar is shown
+ * @param	None
+ * @retval	None
+ */
+void guiCan2InitSidebarGuiElements()
+{
+	/* Text boxes ----------------------------------------------------------------*/
+	static const GUITextBox textBoxes[] = {
+		/* CAN2 Label text box */
+		{
+			.object.id = GUITextBoxId_Can2Label,
+			.object.xPos = 650,
+			.object.yPos = 50,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_All,
+			.textColor = GUI_RED,
+			.backgroundColor = GUI_WHITE,
+			.staticText = "CAN2",
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* CAN2 Main text box */
+		{
+			.object.id = GUITextBoxId_Can2Main,
+			.object.xPos = 0,
+			.object.yPos = 50,
+			.object.width = 650,
+			.object.height = 400,
+			.object.containerPage = GUIContainerPage_1,
+			.textColor = GUI_WHITE,
+			.backgroundColor = LCD_COLOR_BLACK,
+			.textSize = LCDFontEnlarge_1x,
+		},
+	};
 
 	/* Buttons -------------------------------------------------------------------*/
-	/* CAN2 Top Button */
-	prvButton.object.id = GUIButtonId_Can2Top;
-	prvButton.object.xPos = 100;
-	prvButton.object.yPos = 0;
-	prvButton.object.width = 100;
-	prvButton.object.height = 50;
-	prvButton.object.displayState = GUIDisplayState_NotHidden;
-	prvButton.object.border = GUIBorder_Bottom | GUIBorder_Right | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_RED;
-	prvButton.disabledTextColor = GUI_RED;
-	prvButton.disabledBackgroundColor = LCD_COLOR_BLACK;
-	prvButton.pressedTextColor = GUI_RED;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan2TopButtonCallback;
-	prvButton.text[0] = "CAN2";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN2 Enable Button */
-	prvButton.object.id = GUIButtonId_Can2Enable;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 100;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_RED;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_RED;
-	prvButton.pressedTextColor = GUI_RED;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan2EnableButtonCallback;
-	prvButton.text[0] = "Output:";
-//	prvButton.text[1] = "Enabled";
-	prvButton.text[1] = "Disabled";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN2 Bit Rate Button */
-	prvButton.object.id = GUIButtonId_Can2BitRate;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 150;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_DARK_RED;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_RED;
-	prvButton.pressedTextColor = GUI_RED;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan2BitRateButtonCallback;
-	prvButton.text[0] = "< Bit Rate:";
-	prvButton.text[1] = "125kbit/s";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN2 Termination Button */
-	prvButton.object.id = GUIButtonId_Can2Termination;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 200;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_RED;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_RED;
-	prvButton.pressedTextColor = GUI_RED;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan2TerminationButtonCallback;
-	prvButton.text[0] = "Termination:";
-	prvButton.text[1] = "None";
-//	prvButton.text[1] = "120 R";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-
-	/* CAN2 10k bit rate Button */
-	prvButton.object.id = GUIButtonId_Can2BitRate10k;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 150;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_RED;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_RED;
-	prvButton.pressedTextColor = GUI_RED;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan2BitRateSelectionCallback;
-	prvButton.text[0] = "10kbit/s";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN2 20k bit rate Button */
-	prvButton.object.id = GUIButtonId_Can2BitRate20k;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 190;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_RED;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_RED;
-	prvButton.pressedTextColor = GUI_RED;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan2BitRateSelectionCallback;
-	prvButton.text[0] = "20kbit/s";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN2 50k bit rate Button */
-	prvButton.object.id = GUIButtonId_Can2BitRate50k;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 230;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_RED;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_RED;
-	prvButton.pressedTextColor = GUI_RED;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan2BitRateSelectionCallback;
-	prvButton.text[0] = "50kbit/s";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN2 100k bit rate Button */
-	prvButton.object.id = GUIButtonId_Can2BitRate100k;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 270;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_RED;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_RED;
-	prvButton.pressedTextColor = GUI_RED;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan2BitRateSelectionCallback;
-	prvButton.text[0] = "100kbit/s";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN2 125k bit rate Button */
-	prvButton.object.id = GUIButtonId_Can2BitRate125k;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 310;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_RED;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_RED;
-	prvButton.pressedTextColor = GUI_RED;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan2BitRateSelectionCallback;
-	prvButton.text[0] = "125kbit/s";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN2 250k bit rate Button */
-	prvButton.object.id = GUIButtonId_Can2BitRate250k;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 350;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_RED;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_RED;
-	prvButton.pressedTextColor = GUI_RED;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan2BitRateSelectionCallback;
-	prvButton.text[0] = "250kbit/s";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN2 500k bit rate Button */
-	prvButton.object.id = GUIButtonId_Can2BitRate500k;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 390;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_RED;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_RED;
-	prvButton.pressedTextColor = GUI_RED;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan2BitRateSelectionCallback;
-	prvButton.text[0] = "500kbit/s";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* CAN2 1M bit rate Button */
-	prvButton.object.id = GUIButtonId_Can2BitRate1M;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 430;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_RED;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_RED;
-	prvButton.pressedTextColor = GUI_RED;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiCan2BitRateSelectionCallback;
-	prvButton.text[0] = "1Mbit/s";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
+	static const GUIButton buttons[] = {
+		/* CAN2 Enable Button */
+		{
+			.object.id = GUIButtonId_Can2Enable,
+			.object.xPos = 650,
+			.object.yPos = 100,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_RED,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_RED,
+			.pressedTextColor = GUI_RED,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan2EnableButtonCallback,
+			.text[0] = "Output:",
+//			.text[1] = "Enabled",
+			.text[1] = "Disabled",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* CAN2 Bit Rate Button */
+		{
+			.object.id = GUIButtonId_Can2BitRate,
+			.object.xPos = 650,
+			.object.yPos = 150,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_DARK_RED,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_RED,
+			.pressedTextColor = GUI_RED,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan2BitRateButtonCallback,
+			.text[0] = "< Bit Rate:",
+			.text[1] = "125kbit/s",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* CAN2 Termination Button */
+		{
+			.object.id = GUIButtonId_Can2Termination,
+			.object.xPos = 650,
+			.object.yPos = 200,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_RED,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_RED,
+			.pressedTextColor = GUI_RED,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan2TerminationButtonCallback,
+			.text[0] = "Termination:",
+			.text[1] = "None",
+//			.text[1] = "120 R",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* CAN2 10k bit rate Button */
+		{
+			.object.id = GUIButtonId_Can2BitRate10k,
+			.object.xPos = 500,
+			.object.yPos = 150,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_RED,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_RED,
+			.pressedTextColor = GUI_RED,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan2BitRateSelectionCallback,
+			.text[0] = "10kbit/s",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* CAN2 20k bit rate Button */
+		{
+			.object.id = GUIButtonId_Can2BitRate20k,
+			.object.xPos = 500,
+			.object.yPos = 190,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_RED,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_RED,
+			.pressedTextColor = GUI_RED,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan2BitRateSelectionCallback,
+			.text[0] = "20kbit/s",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* CAN2 50k bit rate Button */
+		{
+			.object.id = GUIButtonId_Can2BitRate50k,
+			.object.xPos = 500,
+			.object.yPos = 230,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_RED,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_RED,
+			.pressedTextColor = GUI_RED,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan2BitRateSelectionCallback,
+			.text[0] = "50kbit/s",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* CAN2 100k bit rate Button */
+		{
+			.object.id = GUIButtonId_Can2BitRate100k,
+			.object.xPos = 500,
+			.object.yPos = 270,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_RED,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_RED,
+			.pressedTextColor = GUI_RED,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan2BitRateSelectionCallback,
+			.text[0] = "100kbit/s",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* CAN2 125k bit rate Button */
+		{
+			.object.id = GUIButtonId_Can2BitRate125k,
+			.object.xPos = 500,
+			.object.yPos = 310,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_RED,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_RED,
+			.pressedTextColor = GUI_RED,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan2BitRateSelectionCallback,
+			.text[0] = "125kbit/s",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* CAN2 250k bit rate Button */
+		{
+			.object.id = GUIButtonId_Can2BitRate250k,
+			.object.xPos = 500,
+			.object.yPos = 350,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_RED,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_RED,
+			.pressedTextColor = GUI_RED,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan2BitRateSelectionCallback,
+			.text[0] = "250kbit/s",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* CAN2 500k bit rate Button */
+		{
+			.object.id = GUIButtonId_Can2BitRate500k,
+			.object.xPos = 500,
+			.object.yPos = 390,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_RED,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_RED,
+			.pressedTextColor = GUI_RED,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan2BitRateSelectionCallback,
+			.text[0] = "500kbit/s",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* CAN2 1M bit rate Button */
+		{
+			.object.id = GUIButtonId_Can2BitRate1M,
+			.object.xPos = 500,
+			.object.yPos = 430,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_RED,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_RED,
+			.pressedTextColor = GUI_RED,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiCan2BitRateSelectionCallback,
+			.text[0] = "1Mbit/s",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+	};
 
 	/* Containers ----------------------------------------------------------------*/
-	/* Sidebar CAN2 container */
-	prvContainer.object.id = GUIContainerId_SidebarCan2;
-	prvContainer.object.xPos = 650;
-	prvContainer.object.yPos = 50;
-	prvContainer.object.width = 150;
-	prvContainer.object.height = 400;
-	prvContainer.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvContainer.object.borderThickness = 1;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.activePage = GUIContainerPage_1;
-	prvContainer.contentHideState = GUIHideState_KeepBorders;
-	prvContainer.buttons[0] = GUIButton_GetFromId(GUIButtonId_Can2Enable);
-	prvContainer.buttons[1] = GUIButton_GetFromId(GUIButtonId_Can2BitRate);
-	prvContainer.buttons[2] = GUIButton_GetFromId(GUIButtonId_Can2Termination);
-	prvContainer.textBoxes[0] = GUITextBox_GetFromId(GUITextBoxId_Can2Label);
-	GUIContainer_Add(&prvContainer);
-
-	/* CAN2 bit rate popout container */
-	prvContainer.object.id = GUIContainerId_PopoutCan2BitRate;
-	prvContainer.object.xPos = 500;
-	prvContainer.object.yPos = 150;
-	prvContainer.object.width = 149;
-	prvContainer.object.height = 320;
-	prvContainer.object.layer = GUILayer_1;
-	prvContainer.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvContainer.object.borderThickness = 2;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.contentHideState = GUIHideState_HideAll;
-	prvContainer.buttons[0] = GUIButton_GetFromId(GUIButtonId_Can2BitRate10k);
-	prvContainer.buttons[1] = GUIButton_GetFromId(GUIButtonId_Can2BitRate20k);
-	prvContainer.buttons[2] = GUIButton_GetFromId(GUIButtonId_Can2BitRate50k);
-	prvContainer.buttons[3] = GUIButton_GetFromId(GUIButtonId_Can2BitRate100k);
-	prvContainer.buttons[4] = GUIButton_GetFromId(GUIButtonId_Can2BitRate125k);
-	prvContainer.buttons[5] = GUIButton_GetFromId(GUIButtonId_Can2BitRate250k);
-	prvContainer.buttons[6] = GUIButton_GetFromId(GUIButtonId_Can2BitRate500k);
-	prvContainer.buttons[7] = GUIButton_GetFromId(GUIButtonId_Can2BitRate1M);
-	GUIContainer_Add(&prvContainer);
-
-	/* CAN2 main container */
-	prvContainer.object.id = GUIContainerId_Can2MainContent;
-	prvContainer.object.xPos = 0;
-	prvContainer.object.yPos = 50;
-	prvContainer.object.width = 650;
-	prvContainer.object.height = 400;
-	prvContainer.object.containerPage = guiConfigMAIN_CONTAINER_CAN2_PAGE;
-	prvContainer.object.border = GUIBorder_Right | GUIBorder_Top;
-	prvContainer.object.borderThickness = 1;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.activePage = GUIContainerPage_1;
-	prvContainer.backgroundColor = GUI_BLACK;
-	prvContainer.contentHideState = GUIHideState_HideAll;
-	prvContainer.textBoxes[0] = GUITextBox_GetFromId(GUITextBoxId_Can2Main);
-	GUIContainer_Add(&prvContainer);
+	static const GUIContainerTemplate containers[] = {
+		/* Sidebar CAN2 container */
+		{
+			.object.id = GUIContainerId_SidebarCan2,
+			.object.xPos = 650,
+			.object.yPos = 50,
+			.object.width = 150,
+			.object.height = 400,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.activePage = GUIContainerPage_1,
+			.contentHideState = GUIHideState_KeepBorders,
+			.buttons[0] = GUIButtonId_Can2Enable,
+			.buttons[1] = GUIButtonId_Can2BitRate,
+			.buttons[2] = GUIButtonId_Can2Termination,
+			.textBoxes[0] = GUITextBoxId_Can2Label,
+		},
+		/* CAN2 bit rate popout container */
+		{
+			.object.id = GUIContainerId_PopoutCan2BitRate,
+			.object.xPos = 500,
+			.object.yPos = 150,
+			.object.width = 149,
+			.object.height = 320,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 2,
+			.object.borderColor = GUI_WHITE,
+			.contentHideState = GUIHideState_HideAll,
+			.buttons[0] = GUIButtonId_Can2BitRate10k,
+			.buttons[1] = GUIButtonId_Can2BitRate20k,
+			.buttons[2] = GUIButtonId_Can2BitRate50k,
+			.buttons[3] = GUIButtonId_Can2BitRate100k,
+			.buttons[4] = GUIButtonId_Can2BitRate125k,
+			.buttons[5] = GUIButtonId_Can2BitRate250k,
+			.buttons[6] = GUIButtonId_Can2BitRate500k,
+			.buttons[7] = GUIButtonId_Can2BitRate1M,
+		},
+		/* CAN2 main container */
+		{
+			.object.id = GUIContainerId_Can2MainContent,
+			.object.xPos = 0,
+			.object.yPos = 50,
+			.object.width = 650,
+			.object.height = 400,
+			.object.containerPage = guiConfigMAIN_CONTAINER_CAN2_PAGE,
+			.object.border = GUIBorder_Right | GUIBorder_Top,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.activePage = GUIContainerPage_1,
+			.backgroundColor = GUI_BLACK,
+			.contentHideState = GUIHideState_HideAll,
+			.textBoxes[0] = GUITextBoxId_Can2Main,
+		},
+	};
+
+	static const GUILayout layout = {
+		textBoxes, GUI_NUM_OF_OBJECTS(textBoxes),
+		buttons, GUI_NUM_OF_OBJECTS(buttons),
+		containers, GUI_NUM_OF_OBJECTS(containers),
+	};
+	GUI_AddLayout(&layout);
 }
 
 /* Interrupt Handlers --------------------------------------------------------*/
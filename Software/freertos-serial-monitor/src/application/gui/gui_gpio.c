@@ -29,10 +29,6 @@
 /* Private defines -----------------------------------------------------------*/
 /* Private typedefs ----------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
-static GUITextBox prvTextBox = {0};
-static GUIButton prvButton = {0};
-static GUIContainer prvContainer = {0};
-
 static bool prvRefreshMainContent = false;
 
 /* Private function prototypes -----------------------------------------------*/
@@ -531,882 +527,900 @@ void guiGpioFrequencyCallback(GUITouchEvent Event, uint32_t ButtonId)
 
 
 /**
- * @brief
+ * @brief	Initializes the GPIO top button, the rest is initialized by guiGpioInitSidebarGuiElements
  * @param	None
  * @retval	None
  */
 void guiGpioInitGuiElements()
+{
+	/* Buttons -------------------------------------------------------------------*/
+	/* GPIO Top Button */
+	static const GUIButton topButton = {
+		.object.id = GUIButtonId_GpioTop,
+		.object.xPos = 500,
+		.object.yPos = 0,
+		.object.width = 100,
+		.object.height = 50,
+		.object.displayState = GUIDisplayState_NotHidden,
+		.object.border = GUIBorder_Bottom | GUIBorder_Right | GUIBorder_Left,
+		.object.borderThickness = 1,
+		.object.borderColor = GUI_WHITE,
+		.enabledTextColor = GUI_WHITE,
+		.enabledBackgroundColor = GUI_CYAN_LIGHT,
+		.disabledTextColor = GUI_CYAN_LIGHT,
+		.disabledBackgroundColor = LCD_COLOR_BLACK,
+		.pressedTextColor = GUI_CYAN_LIGHT,
+		.pressedBackgroundColor = GUI_WHITE,
+		.state = GUIButtonState_Disabled,
+		.touchCallback = guiGpioTopButtonCallback,
+		.text[0] = "GPIO",
+		.textSize[0] = LCDFontEnlarge_2x,
+	};
+
+	GUIButton_Add(&topButton);
+}
+
+/**
+ * @brief	Initializes the GPIO sidebar, the type popouts and the main content of both channels, called the first time the sidebar is shown
+ * @param	None
+ * @retval	None
+ */
+void guiGpioInitSidebarGuiElements()
 {
 	/* Text boxes ----------------------------------------------------------------*/
-	/* GPIO Label text box */
-	prvTextBox.object.id = GUITextBoxId_GpioLabel;
-	prvTextBox.object.xPos = 650;
-	prvTextBox.object.yPos = 50;
-	prvTextBox.object.width = 150;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvTextBox.object.borderThickness = 1;
-	prvTextBox.object.borderColor = GUI_WHITE;
-	prvTextBox.object.containerPage = GUIContainerPage_All;
-	prvTextBox.textColor = GUI_CYAN_LIGHT;
-	prvTextBox.backgroundColor = GUI_WHITE;
-	prvTextBox.staticText = "GPIO";
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* GPIO0 Label text box */
-	prvTextBox.object.id = GUITextBoxId_Gpio0Label;
-	prvTextBox.object.xPos = 30;
-	prvTextBox.object.yPos = 80;
-	prvTextBox.object.width = 100;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left | GUIBorder_Right;
-	prvTextBox.object.borderThickness = 1;
-	prvTextBox.object.borderColor = GUI_WHITE;
-	prvTextBox.object.containerPage = GUIContainerPage_All;
-	prvTextBox.textColor = GUI_CYAN_LIGHT;
-	prvTextBox.backgroundColor = GUI_WHITE;
-	prvTextBox.staticText = "GPIO0";
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* GPIO0 type text box */
-	prvTextBox.object.id = GUITextBoxId_Gpio0Type;
-	prvTextBox.object.xPos = 30;
-	prvTextBox.object.yPos = 135;
-	prvTextBox.object.width = 100;
-	prvTextBox.object.height = 30;
-	prvTextBox.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left | GUIBorder_Right;
-	prvTextBox.object.borderThickness = 1;
-	prvTextBox.object.borderColor = GUI_WHITE;
-	prvTextBox.object.containerPage = GUIContainerPage_All;
-	prvTextBox.textColor = GUI_CYAN_LIGHT;
-	prvTextBox.backgroundColor = GUI_WHITE;
-	prvTextBox.staticText = "Output ->";
-	prvTextBox.textSize = LCDFontEnlarge_1x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* GPIO1 Label text box */
-	prvTextBox.object.id = GUITextBoxId_Gpio1Label;
-	prvTextBox.object.xPos = 30;
-	prvTextBox.object.yPos = 280;
-	prvTextBox.object.width = 100;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left | GUIBorder_Right;
-	prvTextBox.object.borderThickness = 1;
-	prvTextBox.object.borderColor = GUI_WHITE;
-	prvTextBox.object.containerPage = GUIContainerPage_All;
-	prvTextBox.textColor = GUI_CYAN_DARK;
-	prvTextBox.backgroundColor = GUI_WHITE;
-	prvTextBox.staticText = "GPIO1";
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* GPIO1 type text box */
-	prvTextBox.object.id = GUITextBoxId_Gpio1Type;
-	prvTextBox.object.xPos = 30;
-	prvTextBox.object.yPos = 335;
-	prvTextBox.object.width = 100;
-	prvTextBox.object.height = 30;
-	prvTextBox.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left | GUIBorder_Right;
-	prvTextBox.object.borderThickness = 1;
-	prvTextBox.object.borderColor = GUI_WHITE;
-	prvTextBox.object.containerPage = GUIContainerPage_All;
-	prvTextBox.textColor = GUI_CYAN_DARK;
-	prvTextBox.backgroundColor = GUI_WHITE;
-	prvTextBox.staticText = "Output ->";
-	prvTextBox.textSize = LCDFontEnlarge_1x;
-	GUITextBox_Add(&prvTextBox);
-
-
-
-	/* GPIO0 Value label text box */
-	prvTextBox.object.id = GUITextBoxId_Gpio0ValueLabel;
-	prvTextBox.object.xPos = 400;
-	prvTextBox.object.yPos = 80;
-	prvTextBox.object.width = 150;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.containerPage = guiConfigGPIO_INPUT_PAGE;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = GUI_CYAN_LIGHT;
-	prvTextBox.staticText = "Current value:";
-	prvTextBox.textSize = LCDFontEnlarge_1x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* GPIO0 Value text box */
-	prvTextBox.object.id = GUITextBoxId_Gpio0Value;
-	prvTextBox.object.xPos = 400;
-	prvTextBox.object.yPos = 135;
-	prvTextBox.object.width = 150;
-	prvTextBox.object.height = 100;
-	prvTextBox.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left | GUIBorder_Right;
-	prvTextBox.object.borderThickness = 1;
-	prvTextBox.object.borderColor = GUI_WHITE;
-	prvTextBox.object.containerPage = guiConfigGPIO_INPUT_PAGE;
-	prvTextBox.textColor = GUI_CYAN_LIGHT;
-	prvTextBox.backgroundColor = GUI_WHITE;
-	prvTextBox.staticText = "Unknown";
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* GPIO0 Duty value text box */
-	prvTextBox.object.id = GUITextBoxId_Gpio0DutyCycleValue;
-	prvTextBox.object.xPos = 445;
-	prvTextBox.object.yPos = 135;
-	prvTextBox.object.width = 100;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.containerPage = guiConfigGPIO_PWM_PAGE;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = GUI_CYAN_LIGHT;
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* GPIO0 Frequency value text box */
-	prvTextBox.object.id = GUITextBoxId_Gpio0FrequencyValue;
-	prvTextBox.object.xPos = 410;
-	prvTextBox.object.yPos = 190;
-	prvTextBox.object.width = 150;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.containerPage = guiConfigGPIO_PWM_PAGE;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = GUI_CYAN_LIGHT;
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* GPIO0 Duty label text box */
-	prvTextBox.object.id = GUITextBoxId_Gpio0DutyCycleLabel;
-	prvTextBox.object.xPos = 200;
-	prvTextBox.object.yPos = 135;
-	prvTextBox.object.width = 150;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.containerPage = guiConfigGPIO_PWM_PAGE;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = GUI_CYAN_LIGHT;
-	prvTextBox.staticText = "Duty:";
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* GPIO0 Frequency label text box */
-	prvTextBox.object.id = GUITextBoxId_Gpio0FrequencyLabel;
-	prvTextBox.object.xPos = 200;
-	prvTextBox.object.yPos = 190;
-	prvTextBox.object.width = 150;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.containerPage = guiConfigGPIO_PWM_PAGE;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = GUI_CYAN_LIGHT;
-	prvTextBox.staticText = "Freq:";
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
-
-
-
-	/* GPIO1 Value label text box */
-	prvTextBox.object.id = GUITextBoxId_Gpio1ValueLabel;
-	prvTextBox.object.xPos = 400;
-	prvTextBox.object.yPos = 280;
-	prvTextBox.object.width = 150;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.containerPage = guiConfigGPIO_INPUT_PAGE;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = GUI_CYAN_DARK;
-	prvTextBox.staticText = "Current value:";
-	prvTextBox.textSize = LCDFontEnlarge_1x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* GPIO1 Value text box */
-	prvTextBox.object.id = GUITextBoxId_Gpio1Value;
-	prvTextBox.object.xPos = 400;
-	prvTextBox.object.yPos = 335;
-	prvTextBox.object.width = 150;
-	prvTextBox.object.height = 100;
-	prvTextBox.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left | GUIBorder_Right;
-	prvTextBox.object.borderThickness = 1;
-	prvTextBox.object.borderColor = GUI_WHITE;
-	prvTextBox.object.containerPage = guiConfigGPIO_INPUT_PAGE;
-	prvTextBox.textColor = GUI_CYAN_DARK;
-	prvTextBox.backgroundColor = GUI_WHITE;
-	prvTextBox.staticText = "Unknown";
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* GPIO1 Duty value text box */
-	prvTextBox.object.id = GUITextBoxId_Gpio1DutyCycleValue;
-	prvTextBox.object.xPos = 445;
-	prvTextBox.object.yPos = 335;
-	prvTextBox.object.width = 100;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.containerPage = guiConfigGPIO_PWM_PAGE;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = GUI_CYAN_DARK;
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* GPIO1 Frequency value text box */
-	prvTextBox.object.id = GUITextBoxId_Gpio1FrequencyValue;
-	prvTextBox.object.xPos = 410;
-	prvTextBox.object.yPos = 390;
-	prvTextBox.object.width = 150;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.containerPage = guiConfigGPIO_PWM_PAGE;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = GUI_CYAN_DARK;
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* GPIO1 Duty label text box */
-	prvTextBox.object.id = GUITextBoxId_Gpio1DutyCycleLabel;
-	prvTextBox.object.xPos = 200;
-	prvTextBox.object.yPos = 335;
-	prvTextBox.object.width = 150;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.containerPage = guiConfigGPIO_PWM_PAGE;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = GUI_CYAN_DARK;
-	prvTextBox.staticText = "Duty:";
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* GPIO1 Frequency label text box */
-	prvTextBox.object.id = GUITextBoxId_Gpio1FrequencyLabel;
-	prvTextBox.object.xPos = 200;
-	prvTextBox.object.yPos = 390;
-	prvTextBox.object.width = 150;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.containerPage = guiConfigGPIO_PWM_PAGE;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = GUI_CYAN_DARK;
-	prvTextBox.staticText = "Freq:";
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
+	static const GUITextBox textBoxes[] = {
+		/* GPIO Label text box */
+		{
+			.object.id = GUITextBoxId_GpioLabel,
+			.object.xPos = 650,
+			.object.yPos = 50,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_All,
+			.textColor = GUI_CYAN_LIGHT,
+			.backgroundColor = GUI_WHITE,
+			.staticText = "GPIO",
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* GPIO0 Label text box */
+		{
+			.object.id = GUITextBoxId_Gpio0Label,
+			.object.xPos = 30,
+			.object.yPos = 80,
+			.object.width = 100,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left | GUIBorder_Right,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_All,
+			.textColor = GUI_CYAN_LIGHT,
+			.backgroundColor = GUI_WHITE,
+			.staticText = "GPIO0",
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* GPIO0 type text box */
+		{
+			.object.id = GUITextBoxId_Gpio0Type,
+			.object.xPos = 30,
+			.object.yPos = 135,
+			.object.width = 100,
+			.object.height = 30,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left | GUIBorder_Right,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_All,
+			.textColor = GUI_CYAN_LIGHT,
+			.backgroundColor = GUI_WHITE,
+			.staticText = "Output ->",
+			.textSize = LCDFontEnlarge_1x,
+		},
+		/* GPIO1 Label text box */
+		{
+			.object.id = GUITextBoxId_Gpio1Label,
+			.object.xPos = 30,
+			.object.yPos = 280,
+			.object.width = 100,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left | GUIBorder_Right,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_All,
+			.textColor = GUI_CYAN_DARK,
+			.backgroundColor = GUI_WHITE,
+			.staticText = "GPIO1",
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* GPIO1 type text box */
+		{
+			.object.id = GUITextBoxId_Gpio1Type,
+			.object.xPos = 30,
+			.object.yPos = 335,
+			.object.width = 100,
+			.object.height = 30,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left | GUIBorder_Right,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_All,
+			.textColor = GUI_CYAN_DARK,
+			.backgroundColor = GUI_WHITE,
+			.staticText = "Output ->",
+			.textSize = LCDFontEnlarge_1x,
+		},
+		/* GPIO0 Value label text box */
+		{
+			.object.id = GUITextBoxId_Gpio0ValueLabel,
+			.object.xPos = 400,
+			.object.yPos = 80,
+			.object.width = 150,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_INPUT_PAGE,
+			.textColor = GUI_WHITE,
+			.backgroundColor = GUI_CYAN_LIGHT,
+			.staticText = "Current value:",
+			.textSize = LCDFontEnlarge_1x,
+		},
+		/* GPIO0 Value text box */
+		{
+			.object.id = GUITextBoxId_Gpio0Value,
+			.object.xPos = 400,
+			.object.yPos = 135,
+			.object.width = 150,
+			.object.height = 100,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left | GUIBorder_Right,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = guiConfigGPIO_INPUT_PAGE,
+			.textColor = GUI_CYAN_LIGHT,
+			.backgroundColor = GUI_WHITE,
+			.staticText = "Unknown",
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* GPIO0 Duty value text box */
+		{
+			.object.id = GUITextBoxId_Gpio0DutyCycleValue,
+			.object.xPos = 445,
+			.object.yPos = 135,
+			.object.width = 100,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_PWM_PAGE,
+			.textColor = GUI_WHITE,
+			.backgroundColor = GUI_CYAN_LIGHT,
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* GPIO0 Frequency value text box */
+		{
+			.object.id = GUITextBoxId_Gpio0FrequencyValue,
+			.object.xPos = 410,
+			.object.yPos = 190,
+			.object.width = 150,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_PWM_PAGE,
+			.textColor = GUI_WHITE,
+			.backgroundColor = GUI_CYAN_LIGHT,
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* GPIO0 Duty label text box */
+		{
+			.object.id = GUITextBoxId_Gpio0DutyCycleLabel,
+			.object.xPos = 200,
+			.object.yPos = 135,
+			.object.width = 150,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_PWM_PAGE,
+			.textColor = GUI_WHITE,
+			.backgroundColor = GUI_CYAN_LIGHT,
+			.staticText = "Duty:",
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* GPIO0 Frequency label text box */
+		{
+			.object.id = GUITextBoxId_Gpio0FrequencyLabel,
+			.object.xPos = 200,
+			.object.yPos = 190,
+			.object.width = 150,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_PWM_PAGE,
+			.textColor = GUI_WHITE,
+			.backgroundColor = GUI_CYAN_LIGHT,
+			.staticText = "Freq:",
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* GPIO1 Value label text box */
+		{
+			.object.id = GUITextBoxId_Gpio1ValueLabel,
+			.object.xPos = 400,
+			.object.yPos = 280,
+			.object.width = 150,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_INPUT_PAGE,
+			.textColor = GUI_WHITE,
+			.backgroundColor = GUI_CYAN_DARK,
+			.staticText = "Current value:",
+			.textSize = LCDFontEnlarge_1x,
+		},
+		/* GPIO1 Value text box */
+		{
+			.object.id = GUITextBoxId_Gpio1Value,
+			.object.xPos = 400,
+			.object.yPos = 335,
+			.object.width = 150,
+			.object.height = 100,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left | GUIBorder_Right,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = guiConfigGPIO_INPUT_PAGE,
+			.textColor = GUI_CYAN_DARK,
+			.backgroundColor = GUI_WHITE,
+			.staticText = "Unknown",
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* GPIO1 Duty value text box */
+		{
+			.object.id = GUITextBoxId_Gpio1DutyCycleValue,
+			.object.xPos = 445,
+			.object.yPos = 335,
+			.object.width = 100,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_PWM_PAGE,
+			.textColor = GUI_WHITE,
+			.backgroundColor = GUI_CYAN_DARK,
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* GPIO1 Frequency value text box */
+		{
+			.object.id = GUITextBoxId_Gpio1FrequencyValue,
+			.object.xPos = 410,
+			.object.yPos = 390,
+			.object.width = 150,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_PWM_PAGE,
+			.textColor = GUI_WHITE,
+			.backgroundColor = GUI_CYAN_DARK,
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* GPIO1 Duty label text box */
+		{
+			.object.id = GUITextBoxId_Gpio1DutyCycleLabel,
+			.object.xPos = 200,
+			.object.yPos = 335,
+			.object.width = 150,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_PWM_PAGE,
+			.textColor = GUI_WHITE,
+			.backgroundColor = GUI_CYAN_DARK,
+			.staticText = "Duty:",
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* GPIO1 Frequency label text box */
+		{
+			.object.id = GUITextBoxId_Gpio1FrequencyLabel,
+			.object.xPos = 200,
+			.object.yPos = 390,
+			.object.width = 150,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_PWM_PAGE,
+			.textColor = GUI_WHITE,
+			.backgroundColor = GUI_CYAN_DARK,
+			.staticText = "Freq:",
+			.textSize = LCDFontEnlarge_2x,
+		},
+	};
 
 	/* Buttons -------------------------------------------------------------------*/
-	/* GPIO Top Button */
-	prvButton.object.id = GUIButtonId_GpioTop;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 0;
-	prvButton.object.width = 100;
-	prvButton.object.height = 50;
-	prvButton.object.displayState = GUIDisplayState_NotHidden;
-	prvButton.object.border = GUIBorder_Bottom | GUIBorder_Right | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_CYAN_LIGHT;
-	prvButton.disabledTextColor = GUI_CYAN_LIGHT;
-	prvButton.disabledBackgroundColor = LCD_COLOR_BLACK;
-	prvButton.pressedTextColor = GUI_CYAN_LIGHT;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpioTopButtonCallback;
-	prvButton.text[0] = "GPIO";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO0 Type Button */
-	prvButton.object.id = GUIButtonId_Gpio0Type;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 100;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_CYAN;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_CYAN_LIGHT;
-	prvButton.pressedTextColor = GUI_CYAN_LIGHT;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpio0TypeButtonCallback;
-	prvButton.text[0] = "< Ch0 Type:";
-	prvButton.text[1] = "Output";
-//	prvButton.text[1] = "Input";
-//	prvButton.text[1] = "PWM";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO1 Type Button */
-	prvButton.object.id = GUIButtonId_Gpio1Type;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 150;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_CYAN_VERY_DARK;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_CYAN_DARK;
-	prvButton.pressedTextColor = GUI_CYAN_DARK;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpio1TypeButtonCallback;
-	prvButton.text[0] = "< Ch1 Type:";
-	prvButton.text[1] = "Output";
-//	prvButton.text[1] = "Input";
-//	prvButton.text[1] = "PWM";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO0 Output type Button */
-	prvButton.object.id = GUIButtonId_Gpio0TypeOut;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 100;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_CYAN_LIGHT;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_CYAN_LIGHT;
-	prvButton.pressedTextColor = GUI_CYAN_LIGHT;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpio0TypeSelectionCallback;
-	prvButton.text[0] = "Output";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO0 Input type Button */
-	prvButton.object.id = GUIButtonId_Gpio0TypeIn;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 140;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_CYAN_LIGHT;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_CYAN_LIGHT;
-	prvButton.pressedTextColor = GUI_CYAN_LIGHT;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpio0TypeSelectionCallback;
-	prvButton.text[0] = "Input";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO0 PWM type Button */
-	prvButton.object.id = GUIButtonId_Gpio0TypePwm;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 180;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_CYAN_LIGHT;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_CYAN_LIGHT;
-	prvButton.pressedTextColor = GUI_CYAN_LIGHT;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpio0TypeSelectionCallback;
-	prvButton.text[0] = "PWM";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO1 Output type Button */
-	prvButton.object.id = GUIButtonId_Gpio1TypeOut;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 150;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_CYAN_DARK;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_CYAN_DARK;
-	prvButton.pressedTextColor = GUI_CYAN_DARK;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpio1TypeSelectionCallback;
-	prvButton.text[0] = "Output";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO1 Input type Button */
-	prvButton.object.id = GUIButtonId_Gpio1TypeIn;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 190;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_CYAN_DARK;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_CYAN_DARK;
-	prvButton.pressedTextColor = GUI_CYAN_DARK;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpio1TypeSelectionCallback;
-	prvButton.text[0] = "Input";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO1 PWM type Button */
-	prvButton.object.id = GUIButtonId_Gpio1TypePwm;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 230;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_CYAN_DARK;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_CYAN_DARK;
-	prvButton.pressedTextColor = GUI_CYAN_DARK;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpio1TypeSelectionCallback;
-	prvButton.text[0] = "PWM";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-
-	/* GPIO0 Enable Button */
-	prvButton.object.id = GUIButtonId_Gpio0Enable;
-	prvButton.object.xPos = 200;
-	prvButton.object.yPos = 80;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.containerPage = guiConfigGPIO_OUTPUT_PAGE | guiConfigGPIO_INPUT_PAGE | guiConfigGPIO_PWM_PAGE;
-	prvButton.enabledTextColor = GUI_CYAN_LIGHT;
-	prvButton.enabledBackgroundColor = GUI_CYAN_LIGHT;
-	prvButton.disabledTextColor = GUI_CYAN_LIGHT;
-	prvButton.disabledBackgroundColor = GUI_WHITE;
-	prvButton.pressedTextColor = GUI_CYAN_LIGHT;
-	prvButton.pressedBackgroundColor = GUI_CYAN;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpioEnableCallback;
-	prvButton.text[0] = "Enable";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO0 Out high Button */
-	prvButton.object.id = GUIButtonId_Gpio0OutHigh;
-	prvButton.object.xPos = 400;
-	prvButton.object.yPos = 80;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.containerPage = guiConfigGPIO_OUTPUT_PAGE;
-	prvButton.enabledTextColor = GUI_CYAN_LIGHT;
-	prvButton.enabledBackgroundColor = GUI_CYAN_LIGHT;
-	prvButton.disabledTextColor = GUI_CYAN_LIGHT;
-	prvButton.disabledBackgroundColor = GUI_WHITE;
-	prvButton.pressedTextColor = GUI_CYAN_LIGHT;
-	prvButton.pressedBackgroundColor = GUI_CYAN;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpioOutPinCallback;
-	prvButton.text[0] = "High";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO0 Out toggle Button */
-	prvButton.object.id = GUIButtonId_Gpio0OutToggle;
-	prvButton.object.xPos = 400;
-	prvButton.object.yPos = 135;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.containerPage = guiConfigGPIO_OUTPUT_PAGE;
-	prvButton.enabledTextColor = GUI_CYAN_LIGHT;
-	prvButton.enabledBackgroundColor = GUI_CYAN_LIGHT;
-	prvButton.disabledTextColor = GUI_CYAN_LIGHT;
-	prvButton.disabledBackgroundColor = GUI_WHITE;
-	prvButton.pressedTextColor = GUI_CYAN_LIGHT;
-	prvButton.pressedBackgroundColor = GUI_CYAN;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpioOutPinCallback;
-	prvButton.text[0] = "Toggle";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO0 Out low Button */
-	prvButton.object.id = GUIButtonId_Gpio0OutLow;
-	prvButton.object.xPos = 400;
-	prvButton.object.yPos = 190;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.containerPage = guiConfigGPIO_OUTPUT_PAGE;
-	prvButton.enabledTextColor = GUI_CYAN_LIGHT;
-	prvButton.enabledBackgroundColor = GUI_CYAN_LIGHT;
-	prvButton.disabledTextColor = GUI_CYAN_LIGHT;
-	prvButton.disabledBackgroundColor = GUI_WHITE;
-	prvButton.pressedTextColor = GUI_CYAN_LIGHT;
-	prvButton.pressedBackgroundColor = GUI_CYAN;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpioOutPinCallback;
-	prvButton.text[0] = "Low";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO0 Duty Up Button */
-	prvButton.object.id = GUIButtonId_Gpio0PwmDutyUp;
-	prvButton.object.xPos = 570;
-	prvButton.object.yPos = 135;
-	prvButton.object.width = 50;
-	prvButton.object.height = 50;
-	prvButton.object.containerPage = guiConfigGPIO_PWM_PAGE;
-	prvButton.enabledTextColor = GUI_CYAN_LIGHT;
-	prvButton.enabledBackgroundColor = GUI_CYAN_LIGHT;
-	prvButton.disabledTextColor = GUI_CYAN_LIGHT;
-	prvButton.disabledBackgroundColor = GUI_WHITE;
-	prvButton.pressedTextColor = GUI_CYAN_LIGHT;
-	prvButton.pressedBackgroundColor = GUI_CYAN;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpioDutyCallback;
-	prvButton.text[0] = "+";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO0 Duty Down Button */
-	prvButton.object.id = GUIButtonId_Gpio0PwmDutyDown;
-	prvButton.object.xPos = 350;
-	prvButton.object.yPos = 135;
-	prvButton.object.width = 50;
-	prvButton.object.height = 50;
-	prvButton.object.containerPage = guiConfigGPIO_PWM_PAGE;
-	prvButton.enabledTextColor = GUI_CYAN_LIGHT;
-	prvButton.enabledBackgroundColor = GUI_CYAN_LIGHT;
-	prvButton.disabledTextColor = GUI_CYAN_LIGHT;
-	prvButton.disabledBackgroundColor = GUI_WHITE;
-	prvButton.pressedTextColor = GUI_CYAN_LIGHT;
-	prvButton.pressedBackgroundColor = GUI_CYAN;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpioDutyCallback;
-	prvButton.text[0] = "-";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO0 Frequency Up Button */
-	prvButton.object.id = GUIButtonId_Gpio0PwmFreqUp;
-	prvButton.object.xPos = 570;
-	prvButton.object.yPos = 190;
-	prvButton.object.width = 50;
-	prvButton.object.height = 50;
-	prvButton.object.containerPage = guiConfigGPIO_PWM_PAGE;
-	prvButton.enabledTextColor = GUI_CYAN_LIGHT;
-	prvButton.enabledBackgroundColor = GUI_CYAN_LIGHT;
-	prvButton.disabledTextColor = GUI_CYAN_LIGHT;
-	prvButton.disabledBackgroundColor = GUI_WHITE;
-	prvButton.pressedTextColor = GUI_CYAN_LIGHT;
-	prvButton.pressedBackgroundColor = GUI_CYAN;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpioFrequencyCallback;
-	prvButton.text[0] = "+";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO0 Frequency Down Button */
-	prvButton.object.id = GUIButtonId_Gpio0PwmFreqDown;
-	prvButton.object.xPos = 350;
-	prvButton.object.yPos = 190;
-	prvButton.object.width = 50;
-	prvButton.object.height = 50;
-	prvButton.object.containerPage = guiConfigGPIO_PWM_PAGE;
-	prvButton.enabledTextColor = GUI_CYAN_LIGHT;
-	prvButton.enabledBackgroundColor = GUI_CYAN_LIGHT;
-	prvButton.disabledTextColor = GUI_CYAN_LIGHT;
-	prvButton.disabledBackgroundColor = GUI_WHITE;
-	prvButton.pressedTextColor = GUI_CYAN_LIGHT;
-	prvButton.pressedBackgroundColor = GUI_CYAN;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpioFrequencyCallback;
-	prvButton.text[0] = "-";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-
-
-	/* GPIO1 Enable Button */
-	prvButton.object.id = GUIButtonId_Gpio1Enable;
-	prvButton.object.xPos = 200;
-	prvButton.object.yPos = 280;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.containerPage = guiConfigGPIO_OUTPUT_PAGE | guiConfigGPIO_INPUT_PAGE | guiConfigGPIO_PWM_PAGE;
-	prvButton.enabledTextColor = GUI_CYAN_DARK;
-	prvButton.enabledBackgroundColor = GUI_CYAN_DARK;
-	prvButton.disabledTextColor = GUI_CYAN_DARK;
-	prvButton.disabledBackgroundColor = GUI_WHITE;
-	prvButton.pressedTextColor = GUI_CYAN_DARK;
-	prvButton.pressedBackgroundColor = GUI_CYAN_VERY_DARK;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpioEnableCallback;
-	prvButton.text[0] = "Enable";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO1 Out high Button */
-	prvButton.object.id = GUIButtonId_Gpio1OutHigh;
-	prvButton.object.xPos = 400;
-	prvButton.object.yPos = 280;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.containerPage = guiConfigGPIO_OUTPUT_PAGE;
-	prvButton.enabledTextColor = GUI_CYAN_DARK;
-	prvButton.enabledBackgroundColor = GUI_CYAN_DARK;
-	prvButton.disabledTextColor = GUI_CYAN_DARK;
-	prvButton.disabledBackgroundColor = GUI_WHITE;
-	prvButton.pressedTextColor = GUI_CYAN_DARK;
-	prvButton.pressedBackgroundColor = GUI_CYAN_VERY_DARK;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpioOutPinCallback;
-	prvButton.text[0] = "High";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO1 Out toggle Button */
-	prvButton.object.id = GUIButtonId_Gpio1OutToggle;
-	prvButton.object.xPos = 400;
-	prvButton.object.yPos = 335;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.containerPage = guiConfigGPIO_OUTPUT_PAGE;
-	prvButton.enabledTextColor = GUI_CYAN_DARK;
-	prvButton.enabledBackgroundColor = GUI_CYAN_DARK;
-	prvButton.disabledTextColor = GUI_CYAN_DARK;
-	prvButton.disabledBackgroundColor = GUI_WHITE;
-	prvButton.pressedTextColor = GUI_CYAN_DARK;
-	prvButton.pressedBackgroundColor = GUI_CYAN_VERY_DARK;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpioOutPinCallback;
-	prvButton.text[0] = "Toggle";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO1 Out low Button */
-	prvButton.object.id = GUIButtonId_Gpio1OutLow;
-	prvButton.object.xPos = 400;
-	prvButton.object.yPos = 390;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.containerPage = guiConfigGPIO_OUTPUT_PAGE;
-	prvButton.enabledTextColor = GUI_CYAN_DARK;
-	prvButton.enabledBackgroundColor = GUI_CYAN_DARK;
-	prvButton.disabledTextColor = GUI_CYAN_DARK;
-	prvButton.disabledBackgroundColor = GUI_WHITE;
-	prvButton.pressedTextColor = GUI_CYAN_DARK;
-	prvButton.pressedBackgroundColor = GUI_CYAN_VERY_DARK;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpioOutPinCallback;
-	prvButton.text[0] = "Low";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO1 Duty Up Button */
-	prvButton.object.id = GUIButtonId_Gpio1PwmDutyUp;
-	prvButton.object.xPos = 570;
-	prvButton.object.yPos = 335;
-	prvButton.object.width = 50;
-	prvButton.object.height = 50;
-	prvButton.object.containerPage = guiConfigGPIO_PWM_PAGE;
-	prvButton.enabledTextColor = GUI_CYAN_DARK;
-	prvButton.enabledBackgroundColor = GUI_CYAN_DARK;
-	prvButton.disabledTextColor = GUI_CYAN_DARK;
-	prvButton.disabledBackgroundColor = GUI_WHITE;
-	prvButton.pressedTextColor = GUI_CYAN_DARK;
-	prvButton.pressedBackgroundColor = GUI_CYAN_VERY_DARK;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpioDutyCallback;
-	prvButton.text[0] = "+";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO1 Duty Down Button */
-	prvButton.object.id = GUIButtonId_Gpio1PwmDutyDown;
-	prvButton.object.xPos = 350;
-	prvButton.object.yPos = 335;
-	prvButton.object.width = 50;
-	prvButton.object.height = 50;
-	prvButton.object.containerPage = guiConfigGPIO_PWM_PAGE;
-	prvButton.enabledTextColor = GUI_CYAN_DARK;
-	prvButton.enabledBackgroundColor = GUI_CYAN_DARK;
-	prvButton.disabledTextColor = GUI_CYAN_DARK;
-	prvButton.disabledBackgroundColor = GUI_WHITE;
-	prvButton.pressedTextColor = GUI_CYAN_DARK;
-	prvButton.pressedBackgroundColor = GUI_CYAN_VERY_DARK;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpioDutyCallback;
-	prvButton.text[0] = "-";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO1 Frequency Up Button */
-	prvButton.object.id = GUIButtonId_Gpio1PwmFreqUp;
-	prvButton.object.xPos = 570;
-	prvButton.object.yPos = 390;
-	prvButton.object.width = 50;
-	prvButton.object.height = 50;
-	prvButton.object.containerPage = guiConfigGPIO_PWM_PAGE;
-	prvButton.enabledTextColor = GUI_CYAN_DARK;
-	prvButton.enabledBackgroundColor = GUI_CYAN_DARK;
-	prvButton.disabledTextColor = GUI_CYAN_DARK;
-	prvButton.disabledBackgroundColor = GUI_WHITE;
-	prvButton.pressedTextColor = GUI_CYAN_DARK;
-	prvButton.pressedBackgroundColor = GUI_CYAN_VERY_DARK;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpioFrequencyCallback;
-	prvButton.text[0] = "+";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* GPIO1 Frequency Down Button */
-	prvButton.object.id = GUIButtonId_Gpio1PwmFreqDown;
-	prvButton.object.xPos = 350;
-	prvButton.object.yPos = 390;
-	prvButton.object.width = 50;
-	prvButton.object.height = 50;
-	prvButton.object.containerPage = guiConfigGPIO_PWM_PAGE;
-	prvButton.enabledTextColor = GUI_CYAN_DARK;
-	prvButton.enabledBackgroundColor = GUI_CYAN_DARK;
-	prvButton.disabledTextColor = GUI_CYAN_DARK;
-	prvButton.disabledBackgroundColor = GUI_WHITE;
-	prvButton.pressedTextColor = GUI_CYAN_DARK;
-	prvButton.pressedBackgroundColor = GUI_CYAN_VERY_DARK;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiGpioFrequencyCallback;
-	prvButton.text[0] = "-";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
+	static const GUIButton buttons[] = {
+		/* GPIO0 Type Button */
+		{
+			.object.id = GUIButtonId_Gpio0Type,
+			.object.xPos = 650,
+			.object.yPos = 100,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_CYAN,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_CYAN_LIGHT,
+			.pressedTextColor = GUI_CYAN_LIGHT,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpio0TypeButtonCallback,
+			.text[0] = "< Ch0 Type:",
+			.text[1] = "Output",
+//			.text[1] = "Input",
+//			.text[1] = "PWM",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* GPIO1 Type Button */
+		{
+			.object.id = GUIButtonId_Gpio1Type,
+			.object.xPos = 650,
+			.object.yPos = 150,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_CYAN_VERY_DARK,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_CYAN_DARK,
+			.pressedTextColor = GUI_CYAN_DARK,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpio1TypeButtonCallback,
+			.text[0] = "< Ch1 Type:",
+			.text[1] = "Output",
+//			.text[1] = "Input",
+//			.text[1] = "PWM",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* GPIO0 Output type Button */
+		{
+			.object.id = GUIButtonId_Gpio0TypeOut,
+			.object.xPos = 500,
+			.object.yPos = 100,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_CYAN_LIGHT,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_CYAN_LIGHT,
+			.pressedTextColor = GUI_CYAN_LIGHT,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpio0TypeSelectionCallback,
+			.text[0] = "Output",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* GPIO0 Input type Button */
+		{
+			.object.id = GUIButtonId_Gpio0TypeIn,
+			.object.xPos = 500,
+			.object.yPos = 140,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_CYAN_LIGHT,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_CYAN_LIGHT,
+			.pressedTextColor = GUI_CYAN_LIGHT,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpio0TypeSelectionCallback,
+			.text[0] = "Input",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* GPIO0 PWM type Button */
+		{
+			.object.id = GUIButtonId_Gpio0TypePwm,
+			.object.xPos = 500,
+			.object.yPos = 180,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_CYAN_LIGHT,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_CYAN_LIGHT,
+			.pressedTextColor = GUI_CYAN_LIGHT,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpio0TypeSelectionCallback,
+			.text[0] = "PWM",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* GPIO1 Output type Button */
+		{
+			.object.id = GUIButtonId_Gpio1TypeOut,
+			.object.xPos = 500,
+			.object.yPos = 150,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_CYAN_DARK,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_CYAN_DARK,
+			.pressedTextColor = GUI_CYAN_DARK,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpio1TypeSelectionCallback,
+			.text[0] = "Output",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* GPIO1 Input type Button */
+		{
+			.object.id = GUIButtonId_Gpio1TypeIn,
+			.object.xPos = 500,
+			.object.yPos = 190,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_CYAN_DARK,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_CYAN_DARK,
+			.pressedTextColor = GUI_CYAN_DARK,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpio1TypeSelectionCallback,
+			.text[0] = "Input",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* GPIO1 PWM type Button */
+		{
+			.object.id = GUIButtonId_Gpio1TypePwm,
+			.object.xPos = 500,
+			.object.yPos = 230,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_CYAN_DARK,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_CYAN_DARK,
+			.pressedTextColor = GUI_CYAN_DARK,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpio1TypeSelectionCallback,
+			.text[0] = "PWM",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* GPIO0 Enable Button */
+		{
+			.object.id = GUIButtonId_Gpio0Enable,
+			.object.xPos = 200,
+			.object.yPos = 80,
+			.object.width = 150,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_OUTPUT_PAGE | guiConfigGPIO_INPUT_PAGE | guiConfigGPIO_PWM_PAGE,
+			.enabledTextColor = GUI_CYAN_LIGHT,
+			.enabledBackgroundColor = GUI_CYAN_LIGHT,
+			.disabledTextColor = GUI_CYAN_LIGHT,
+			.disabledBackgroundColor = GUI_WHITE,
+			.pressedTextColor = GUI_CYAN_LIGHT,
+			.pressedBackgroundColor = GUI_CYAN,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpioEnableCallback,
+			.text[0] = "Enable",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* GPIO0 Out high Button */
+		{
+			.object.id = GUIButtonId_Gpio0OutHigh,
+			.object.xPos = 400,
+			.object.yPos = 80,
+			.object.width = 150,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_OUTPUT_PAGE,
+			.enabledTextColor = GUI_CYAN_LIGHT,
+			.enabledBackgroundColor = GUI_CYAN_LIGHT,
+			.disabledTextColor = GUI_CYAN_LIGHT,
+			.disabledBackgroundColor = GUI_WHITE,
+			.pressedTextColor = GUI_CYAN_LIGHT,
+			.pressedBackgroundColor = GUI_CYAN,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpioOutPinCallback,
+			.text[0] = "High",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* GPIO0 Out toggle Button */
+		{
+			.object.id = GUIButtonId_Gpio0OutToggle,
+			.object.xPos = 400,
+			.object.yPos = 135,
+			.object.width = 150,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_OUTPUT_PAGE,
+			.enabledTextColor = GUI_CYAN_LIGHT,
+			.enabledBackgroundColor = GUI_CYAN_LIGHT,
+			.disabledTextColor = GUI_CYAN_LIGHT,
+			.disabledBackgroundColor = GUI_WHITE,
+			.pressedTextColor = GUI_CYAN_LIGHT,
+			.pressedBackgroundColor = GUI_CYAN,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpioOutPinCallback,
+			.text[0] = "Toggle",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* GPIO0 Out low Button */
+		{
+			.object.id = GUIButtonId_Gpio0OutLow,
+			.object.xPos = 400,
+			.object.yPos = 190,
+			.object.width = 150,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_OUTPUT_PAGE,
+			.enabledTextColor = GUI_CYAN_LIGHT,
+			.enabledBackgroundColor = GUI_CYAN_LIGHT,
+			.disabledTextColor = GUI_CYAN_LIGHT,
+			.disabledBackgroundColor = GUI_WHITE,
+			.pressedTextColor = GUI_CYAN_LIGHT,
+			.pressedBackgroundColor = GUI_CYAN,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpioOutPinCallback,
+			.text[0] = "Low",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* GPIO0 Duty Up Button */
+		{
+			.object.id = GUIButtonId_Gpio0PwmDutyUp,
+			.object.xPos = 570,
+			.object.yPos = 135,
+			.object.width = 50,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_PWM_PAGE,
+			.enabledTextColor = GUI_CYAN_LIGHT,
+			.enabledBackgroundColor = GUI_CYAN_LIGHT,
+			.disabledTextColor = GUI_CYAN_LIGHT,
+			.disabledBackgroundColor = GUI_WHITE,
+			.pressedTextColor = GUI_CYAN_LIGHT,
+			.pressedBackgroundColor = GUI_CYAN,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpioDutyCallback,
+			.text[0] = "+",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* GPIO0 Duty Down Button */
+		{
+			.object.id = GUIButtonId_Gpio0PwmDutyDown,
+			.object.xPos = 350,
+			.object.yPos = 135,
+			.object.width = 50,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_PWM_PAGE,
+			.enabledTextColor = GUI_CYAN_LIGHT,
+			.enabledBackgroundColor = GUI_CYAN_LIGHT,
+			.disabledTextColor = GUI_CYAN_LIGHT,
+			.disabledBackgroundColor = GUI_WHITE,
+			.pressedTextColor = GUI_CYAN_LIGHT,
+			.pressedBackgroundColor = GUI_CYAN,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpioDutyCallback,
+			.text[0] = "-",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* GPIO0 Frequency Up Button */
+		{
+			.object.id = GUIButtonId_Gpio0PwmFreqUp,
+			.object.xPos = 570,
+			.object.yPos = 190,
+			.object.width = 50,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_PWM_PAGE,
+			.enabledTextColor = GUI_CYAN_LIGHT,
+			.enabledBackgroundColor = GUI_CYAN_LIGHT,
+			.disabledTextColor = GUI_CYAN_LIGHT,
+			.disabledBackgroundColor = GUI_WHITE,
+			.pressedTextColor = GUI_CYAN_LIGHT,
+			.pressedBackgroundColor = GUI_CYAN,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpioFrequencyCallback,
+			.text[0] = "+",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* GPIO0 Frequency Down Button */
+		{
+			.object.id = GUIButtonId_Gpio0PwmFreqDown,
+			.object.xPos = 350,
+			.object.yPos = 190,
+			.object.width = 50,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_PWM_PAGE,
+			.enabledTextColor = GUI_CYAN_LIGHT,
+			.enabledBackgroundColor = GUI_CYAN_LIGHT,
+			.disabledTextColor = GUI_CYAN_LIGHT,
+			.disabledBackgroundColor = GUI_WHITE,
+			.pressedTextColor = GUI_CYAN_LIGHT,
+			.pressedBackgroundColor = GUI_CYAN,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpioFrequencyCallback,
+			.text[0] = "-",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* GPIO1 Enable Button */
+		{
+			.object.id = GUIButtonId_Gpio1Enable,
+			.object.xPos = 200,
+			.object.yPos = 280,
+			.object.width = 150,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_OUTPUT_PAGE | guiConfigGPIO_INPUT_PAGE | guiConfigGPIO_PWM_PAGE,
+			.enabledTextColor = GUI_CYAN_DARK,
+			.enabledBackgroundColor = GUI_CYAN_DARK,
+			.disabledTextColor = GUI_CYAN_DARK,
+			.disabledBackgroundColor = GUI_WHITE,
+			.pressedTextColor = GUI_CYAN_DARK,
+			.pressedBackgroundColor = GUI_CYAN_VERY_DARK,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpioEnableCallback,
+			.text[0] = "Enable",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* GPIO1 Out high Button */
+		{
+			.object.id = GUIButtonId_Gpio1OutHigh,
+			.object.xPos = 400,
+			.object.yPos = 280,
+			.object.width = 150,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_OUTPUT_PAGE,
+			.enabledTextColor = GUI_CYAN_DARK,
+			.enabledBackgroundColor = GUI_CYAN_DARK,
+			.disabledTextColor = GUI_CYAN_DARK,
+			.disabledBackgroundColor = GUI_WHITE,
+			.pressedTextColor = GUI_CYAN_DARK,
+			.pressedBackgroundColor = GUI_CYAN_VERY_DARK,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpioOutPinCallback,
+			.text[0] = "High",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* GPIO1 Out toggle Button */
+		{
+			.object.id = GUIButtonId_Gpio1OutToggle,
+			.object.xPos = 400,
+			.object.yPos = 335,
+			.object.width = 150,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_OUTPUT_PAGE,
+			.enabledTextColor = GUI_CYAN_DARK,
+			.enabledBackgroundColor = GUI_CYAN_DARK,
+			.disabledTextColor = GUI_CYAN_DARK,
+			.disabledBackgroundColor = GUI_WHITE,
+			.pressedTextColor = GUI_CYAN_DARK,
+			.pressedBackgroundColor = GUI_CYAN_VERY_DARK,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpioOutPinCallback,
+			.text[0] = "Toggle",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* GPIO1 Out low Button */
+		{
+			.object.id = GUIButtonId_Gpio1OutLow,
+			.object.xPos = 400,
+			.object.yPos = 390,
+			.object.width = 150,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_OUTPUT_PAGE,
+			.enabledTextColor = GUI_CYAN_DARK,
+			.enabledBackgroundColor = GUI_CYAN_DARK,
+			.disabledTextColor = GUI_CYAN_DARK,
+			.disabledBackgroundColor = GUI_WHITE,
+			.pressedTextColor = GUI_CYAN_DARK,
+			.pressedBackgroundColor = GUI_CYAN_VERY_DARK,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpioOutPinCallback,
+			.text[0] = "Low",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* GPIO1 Duty Up Button */
+		{
+			.object.id = GUIButtonId_Gpio1PwmDutyUp,
+			.object.xPos = 570,
+			.object.yPos = 335,
+			.object.width = 50,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_PWM_PAGE,
+			.enabledTextColor = GUI_CYAN_DARK,
+			.enabledBackgroundColor = GUI_CYAN_DARK,
+			.disabledTextColor = GUI_CYAN_DARK,
+			.disabledBackgroundColor = GUI_WHITE,
+			.pressedTextColor = GUI_CYAN_DARK,
+			.pressedBackgroundColor = GUI_CYAN_VERY_DARK,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpioDutyCallback,
+			.text[0] = "+",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* GPIO1 Duty Down Button */
+		{
+			.object.id = GUIButtonId_Gpio1PwmDutyDown,
+			.object.xPos = 350,
+			.object.yPos = 335,
+			.object.width = 50,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_PWM_PAGE,
+			.enabledTextColor = GUI_CYAN_DARK,
+			.enabledBackgroundColor = GUI_CYAN_DARK,
+			.disabledTextColor = GUI_CYAN_DARK,
+			.disabledBackgroundColor = GUI_WHITE,
+			.pressedTextColor = GUI_CYAN_DARK,
+			.pressedBackgroundColor = GUI_CYAN_VERY_DARK,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpioDutyCallback,
+			.text[0] = "-",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* GPIO1 Frequency Up Button */
+		{
+			.object.id = GUIButtonId_Gpio1PwmFreqUp,
+			.object.xPos = 570,
+			.object.yPos = 390,
+			.object.width = 50,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_PWM_PAGE,
+			.enabledTextColor = GUI_CYAN_DARK,
+			.enabledBackgroundColor = GUI_CYAN_DARK,
+			.disabledTextColor = GUI_CYAN_DARK,
+			.disabledBackgroundColor = GUI_WHITE,
+			.pressedTextColor = GUI_CYAN_DARK,
+			.pressedBackgroundColor = GUI_CYAN_VERY_DARK,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpioFrequencyCallback,
+			.text[0] = "+",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* GPIO1 Frequency Down Button */
+		{
+			.object.id = GUIButtonId_Gpio1PwmFreqDown,
+			.object.xPos = 350,
+			.object.yPos = 390,
+			.object.width = 50,
+			.object.height = 50,
+			.object.containerPage = guiConfigGPIO_PWM_PAGE,
+			.enabledTextColor = GUI_CYAN_DARK,
+			.enabledBackgroundColor = GUI_CYAN_DARK,
+			.disabledTextColor = GUI_CYAN_DARK,
+			.disabledBackgroundColor = GUI_WHITE,
+			.pressedTextColor = GUI_CYAN_DARK,
+			.pressedBackgroundColor = GUI_CYAN_VERY_DARK,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiGpioFrequencyCallback,
+			.text[0] = "-",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+	};
 
 	/* Containers ----------------------------------------------------------------*/
-	/* Sidebar GPIO container */
-	prvContainer.object.id = GUIContainerId_SidebarGpio;
-	prvContainer.object.xPos = 650;
-	prvContainer.object.yPos = 50;
-	prvContainer.object.width = 150;
-	prvContainer.object.height = 400;
-	prvContainer.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvContainer.object.borderThickness = 1;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.activePage = GUIContainerPage_1;
-	prvContainer.contentHideState = GUIHideState_KeepBorders;
-	prvContainer.buttons[0] = GUIButton_GetFromId(GUIButtonId_Gpio0Type);
-	prvContainer.buttons[1] = GUIButton_GetFromId(GUIButtonId_Gpio1Type);
-	prvContainer.textBoxes[0] = GUITextBox_GetFromId(GUITextBoxId_GpioLabel);
-	GUIContainer_Add(&prvContainer);
-
-	/* GPIO0 type popout container */
-	prvContainer.object.id = GUIContainerId_PopoutGpio0Type;
-	prvContainer.object.xPos = 500;
-	prvContainer.object.yPos = 100;
-	prvContainer.object.width = 149;
-	prvContainer.object.height = 120;
-	prvContainer.object.layer = GUILayer_1;
-	prvContainer.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvContainer.object.borderThickness = 2;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.contentHideState = GUIHideState_HideAll;
-	prvContainer.buttons[0] = GUIButton_GetFromId(GUIButtonId_Gpio0TypeOut);
-	prvContainer.buttons[1] = GUIButton_GetFromId(GUIButtonId_Gpio0TypeIn);
-	prvContainer.buttons[2] = GUIButton_GetFromId(GUIButtonId_Gpio0TypePwm);
-	GUIContainer_Add(&prvContainer);
-
-	/* GPIO1 type popout container */
-	prvContainer.object.id = GUIContainerId_PopoutGpio1Type;
-	prvContainer.object.xPos = 500;
-	prvContainer.object.yPos = 150;
-	prvContainer.object.width = 149;
-	prvContainer.object.height = 120;
-	prvContainer.object.layer = GUILayer_1;
-	prvContainer.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvContainer.object.borderThickness = 2;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.contentHideState = GUIHideState_HideAll;
-	prvContainer.buttons[0] = GUIButton_GetFromId(GUIButtonId_Gpio1TypeOut);
-	prvContainer.buttons[1] = GUIButton_GetFromId(GUIButtonId_Gpio1TypeIn);
-	prvContainer.buttons[2] = GUIButton_GetFromId(GUIButtonId_Gpio1TypePwm);
-	GUIContainer_Add(&prvContainer);
-
-	/* GPIO0 main container */
-	prvContainer.object.id = GUIContainerId_Gpio0MainContent;
-	prvContainer.object.xPos = 25;
-	prvContainer.object.yPos = 75;
-	prvContainer.object.width = 600;
-	prvContainer.object.height = 170;
-	prvContainer.object.containerPage = guiConfigMAIN_CONTAINER_GPIO_PAGE;
-	prvContainer.object.border = GUIBorder_Left | GUIBorder_Right | GUIBorder_Top | GUIBorder_Bottom;
-	prvContainer.object.borderThickness = 2;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.activePage = guiConfigGPIO_OUTPUT_PAGE;
-	prvContainer.backgroundColor = GUI_CYAN_LIGHT;
-	prvContainer.contentHideState = GUIHideState_HideAll;
-	prvContainer.textBoxes[0] = GUITextBox_GetFromId(GUITextBoxId_Gpio0ValueLabel);
-	prvContainer.textBoxes[1] = GUITextBox_GetFromId(GUITextBoxId_Gpio0Value);
-	prvContainer.textBoxes[2] = GUITextBox_GetFromId(GUITextBoxId_Gpio0Label);
-	prvContainer.textBoxes[3] = GUITextBox_GetFromId(GUITextBoxId_Gpio0Type);
-	prvContainer.textBoxes[4] = GUITextBox_GetFromId(GUITextBoxId_Gpio0DutyCycleValue);
-	prvContainer.textBoxes[5] = GUITextBox_GetFromId(GUITextBoxId_Gpio0FrequencyValue);
-	prvContainer.textBoxes[6] = GUITextBox_GetFromId(GUITextBoxId_Gpio0DutyCycleLabel);
-	prvContainer.textBoxes[7] = GUITextBox_GetFromId(GUITextBoxId_Gpio0FrequencyValue);
-
-	prvContainer.buttons[0] = GUIButton_GetFromId(GUIButtonId_Gpio0Enable);
-	prvContainer.buttons[1] = GUIButton_GetFromId(GUIButtonId_Gpio0OutHigh);
-	prvContainer.buttons[2] = GUIButton_GetFromId(GUIButtonId_Gpio0OutLow);
-	prvContainer.buttons[3] = GUIButton_GetFromId(GUIButtonId_Gpio0OutToggle);
-	prvContainer.buttons[4] = GUIButton_GetFromId(GUIButtonId_Gpio0PwmDutyUp);
-	prvContainer.buttons[5] = GUIButton_GetFromId(GUIButtonId_Gpio0PwmDutyDown);
-	prvContainer.buttons[6] = GUIButton_GetFromId(GUIButtonId_Gpio0PwmFreqUp);
-	prvContainer.buttons[7] = GUIButton_GetFromId(GUIButtonId_Gpio0PwmFreqDown);
-	GUIContainer_Add(&prvContainer);
-
-
-	/* GPIO1 main container */
-	prvContainer.object.id = GUIContainerId_Gpio1MainContent;
-	prvContainer.object.xPos = 25;
-	prvContainer.object.yPos = 275;
-	prvContainer.object.width = 600;
-	prvContainer.object.height = 170;
-	prvContainer.object.containerPage = guiConfigMAIN_CONTAINER_GPIO_PAGE;
-	prvContainer.object.border = GUIBorder_Left | GUIBorder_Right | GUIBorder_Top | GUIBorder_Bottom;
-	prvContainer.object.borderThickness = 2;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.activePage = guiConfigGPIO_OUTPUT_PAGE;
-	prvContainer.backgroundColor = GUI_CYAN_DARK;
-	prvContainer.contentHideState = GUIHideState_HideAll;
-	prvContainer.textBoxes[0] = GUITextBox_GetFromId(GUITextBoxId_Gpio1ValueLabel);
-	prvContainer.textBoxes[1] = GUITextBox_GetFromId(GUITextBoxId_Gpio1Value);
-	prvContainer.textBoxes[2] = GUITextBox_GetFromId(GUITextBoxId_Gpio1Label);
-	prvContainer.textBoxes[3] = GUITextBox_GetFromId(GUITextBoxId_Gpio1Type);
-	prvContainer.textBoxes[4] = GUITextBox_GetFromId(GUITextBoxId_Gpio1DutyCycleValue);
-	prvContainer.textBoxes[5] = GUITextBox_GetFromId(GUITextBoxId_Gpio1FrequencyValue);
-	prvContainer.textBoxes[6] = GUITextBox_GetFromId(GUITextBoxId_Gpio1DutyCycleLabel);
-	prvContainer.textBoxes[7] = GUITextBox_GetFromId(GUITextBoxId_Gpio1FrequencyLabel);
-
-	prvContainer.buttons[0] = GUIButton_GetFromId(GUIButtonId_Gpio1Enable);
-	prvContainer.buttons[1] = GUIButton_GetFromId(GUIButtonId_Gpio1OutHigh);
-	prvContainer.buttons[2] = GUIButton_GetFromId(GUIButtonId_Gpio1OutLow);
-	prvContainer.buttons[3] = GUIButton_GetFromId(GUIButtonId_Gpio1OutToggle);
-	prvContainer.buttons[4] = GUIButton_GetFromId(GUIButtonId_Gpio1PwmDutyUp);
-	prvContainer.buttons[5] = GUIButton_GetFromId(GUIButtonId_Gpio1PwmDutyDown);
-	prvContainer.buttons[6] = GUIButton_GetFromId(GUIButtonId_Gpio1PwmFreqUp);
-	prvContainer.buttons[7] = GUIButton_GetFromId(GUIButtonId_Gpio1PwmFreqDown);
-	GUIContainer_Add(&prvContainer);
+	static const GUIContainerTemplate containers[] = {
+		/* Sidebar GPIO container */
+		{
+			.object.id = GUIContainerId_SidebarGpio,
+			.object.xPos = 650,
+			.object.yPos = 50,
+			.object.width = 150,
+			.object.height = 400,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.activePage = GUIContainerPage_1,
+			.contentHideState = GUIHideState_KeepBorders,
+			.buttons[0] = GUIButtonId_Gpio0Type,
+			.buttons[1] = GUIButtonId_Gpio1Type,
+			.textBoxes[0] = GUITextBoxId_GpioLabel,
+		},
+		/* GPIO0 type popout container */
+		{
+			.object.id = GUIContainerId_PopoutGpio0Type,
+			.object.xPos = 500,
+			.object.yPos = 100,
+			.object.width = 149,
+			.object.height = 120,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 2,
+			.object.borderColor = GUI_WHITE,
+			.contentHideState = GUIHideState_HideAll,
+			.buttons[0] = GUIButtonId_Gpio0TypeOut,
+			.buttons[1] = GUIButtonId_Gpio0TypeIn,
+			.buttons[2] = GUIButtonId_Gpio0TypePwm,
+		},
+		/* GPIO1 type popout container */
+		{
+			.object.id = GUIContainerId_PopoutGpio1Type,
+			.object.xPos = 500,
+			.object.yPos = 150,
+			.object.width = 149,
+			.object.height = 120,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 2,
+			.object.borderColor = GUI_WHITE,
+			.contentHideState = GUIHideState_HideAll,
+			.buttons[0] = GUIButtonId_Gpio1TypeOut,
+			.buttons[1] = GUIButtonId_Gpio1TypeIn,
+			.buttons[2] = GUIButtonId_Gpio1TypePwm,
+		},
+		/* GPIO0 main container */
+		{
+			.object.id = GUIContainerId_Gpio0MainContent,
+			.object.xPos = 25,
+			.object.yPos = 75,
+			.object.width = 600,
+			.object.height = 170,
+			.object.containerPage = guiConfigMAIN_CONTAINER_GPIO_PAGE,
+			.object.border = GUIBorder_Left | GUIBorder_Right | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 2,
+			.object.borderColor = GUI_WHITE,
+			.activePage = guiConfigGPIO_OUTPUT_PAGE,
+			.backgroundColor = GUI_CYAN_LIGHT,
+			.contentHideState = GUIHideState_HideAll,
+			.textBoxes[0] = GUITextBoxId_Gpio0ValueLabel,
+			.textBoxes[1] = GUITextBoxId_Gpio0Value,
+			.textBoxes[2] = GUITextBoxId_Gpio0Label,
+			.textBoxes[3] = GUITextBoxId_Gpio0Type,
+			.textBoxes[4] = GUITextBoxId_Gpio0DutyCycleValue,
+			.textBoxes[5] = GUITextBoxId_Gpio0FrequencyValue,
+			.textBoxes[6] = GUITextBoxId_Gpio0DutyCycleLabel,
+			.textBoxes[7] = GUITextBoxId_Gpio0FrequencyValue,
+			.buttons[0] = GUIButtonId_Gpio0Enable,
+			.buttons[1] = GUIButtonId_Gpio0OutHigh,
+			.buttons[2] = GUIButtonId_Gpio0OutLow,
+			.buttons[3] = GUIButtonId_Gpio0OutToggle,
+			.buttons[4] = GUIButtonId_Gpio0PwmDutyUp,
+			.buttons[5] = GUIButtonId_Gpio0PwmDutyDown,
+			.buttons[6] = GUIButtonId_Gpio0PwmFreqUp,
+			.buttons[7] = GUIButtonId_Gpio0PwmFreqDown,
+		},
+		/* GPIO1 main container */
+		{
+			.object.id = GUIContainerId_Gpio1MainContent,
+			.object.xPos = 25,
+			.object.yPos = 275,
+			.object.width = 600,
+			.object.height = 170,
+			.object.containerPage = guiConfigMAIN_CONTAINER_GPIO_PAGE,
+			.object.border = GUIBorder_Left | GUIBorder_Right | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 2,
+			.object.borderColor = GUI_WHITE,
+			.activePage = guiConfigGPIO_OUTPUT_PAGE,
+			.backgroundColor = GUI_CYAN_DARK,
+			.contentHideState = GUIHideState_HideAll,
+			.textBoxes[0] = GUITextBoxId_Gpio1ValueLabel,
+			.textBoxes[1] = GUITextBoxId_Gpio1Value,
+			.textBoxes[2] = GUITextBoxId_Gpio1Label,
+			.textBoxes[3] = GUITextBoxId_Gpio1Type,
+			.textBoxes[4] = GUITextBoxId_Gpio1DutyCycleValue,
+			.textBoxes[5] = GUITextBoxId_Gpio1FrequencyValue,
+			.textBoxes[6] = GUITextBoxId_Gpio1DutyCycleLabel,
+			.textBoxes[7] = GUITextBoxId_Gpio1FrequencyLabel,
+			.buttons[0] = GUIButtonId_Gpio1Enable,
+			.buttons[1] = GUIButtonId_Gpio1OutHigh,
+			.buttons[2] = GUIButtonId_Gpio1OutLow,
+			.buttons[3] = GUIButtonId_Gpio1OutToggle,
+			.buttons[4] = GUIButtonId_Gpio1PwmDutyUp,
+			.buttons[5] = GUIButtonId_Gpio1PwmDutyDown,
+			.buttons[6] = GUIButtonId_Gpio1PwmFreqUp,
+			.buttons[7] = GUIButtonId_Gpio1PwmFreqDown,
+		},
+	};
+
+	static const GUILayout layout = {
+		textBoxes, GUI_NUM_OF_OBJECTS(textBoxes),
+		buttons, GUI_NUM_OF_OBJECTS(buttons),
+		containers, GUI_NUM_OF_OBJECTS(containers),
+	};
+	GUI_AddLayout(&layout);
 }
 
 
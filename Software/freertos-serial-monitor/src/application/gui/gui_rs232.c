@@ -31,10 +31,6 @@
 /* Private defines -----------------------------------------------------------*/
 /* Private typedefs ----------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
-static GUITextBox prvTextBox = {0};
-static GUIButton prvButton = {0};
-static GUIContainer prvContainer = {0};
-
 /* Private function prototypes -----------------------------------------------*/
 /* Functions -----------------------------------------------------------------*/
 /* RS232 GUI Elements ========================================================*/
@@ -151,15 +147,29 @@ void guiRs232FormatButtonCallback(GUITouchEvent Event, uint32_t ButtonId)
 		/* Try to take the settings semaphore */
 		if (*settingsSemaphore != 0 && xSemaphoreTake(*settingsSemaphore, 100) == pdTRUE)
 		{
-			if (settings->textFormat == GUITextFormat_ASCII)
-			{
-				settings->textFormat = GUITextFormat_HexWithSpaces;
-				GUIButton_SetTextForRow(GUIButtonId_Rs232Format, "Hex", 1);
-			}
-			else if (settings->textFormat == GUITextFormat_HexWithSpaces)
+			/* Cycle through the formats: ASCII -> Hex -> Decimal -> Binary -> Escaped -> ASCII */
+			switch (settings->textFormat)
 			{
-				settings->textFormat = GUITextFormat_ASCII;
-				GUIButton_SetTextForRow(GUIButtonId_Rs232Format, "ASCII", 1);
+				case GUITextFormat_ASCII:
+					settings->textFormat = GUITextFormat_HexWithSpaces;
+					GUIButton_SetTextForRow(GUIButtonId_Rs232Format, "Hex", 1);
+					break;
+				case GUITextFormat_HexWithSpaces:
+					settings->textFormat = GUITextFormat_Decimal;
+					GUIButton_SetTextForRow(GUIButtonId_Rs232Format, "Decimal", 1);
+					break;
+				case GUITextFormat_Decimal:
+					settings->textFormat = GUITextFormat_Binary;
+					GUIButton_SetTextForRow(GUIButtonId_Rs232Format, "Binary", 1);
+					break;
+				case GUITextFormat_Binary:
+					settings->textFormat = GUITextFormat_CEscaped;
+					GUIButton_SetTextForRow(GUIButtonId_Rs232Format, "Escaped", 1);
+					break;
+				default:
+					settings->textFormat = GUITextFormat_ASCII;
+					GUIButton_SetTextForRow(GUIButtonId_Rs232Format, "ASCII", 1);
+					break;
 			}
 
 			/* Give back the semaphore now that we are done */
@@ -508,608 +518,723 @@ void guiRs232UpdateGuiElementsReadFromSettings()
 		case GUITextFormat_HexWithSpaces:
 			GUIButton_SetTextForRow(GUIButtonId_Rs232Format, "Hex", 1);
 			break;
+		case GUITextFormat_Decimal:
+			GUIButton_SetTextForRow(GUIButtonId_Rs232Format, "Decimal", 1);
+			break;
+		case GUITextFormat_Binary:
+			GUIButton_SetTextForRow(GUIButtonId_Rs232Format, "Binary", 1);
+			break;
+		case GUITextFormat_CEscaped:
+			GUIButton_SetTextForRow(GUIButtonId_Rs232Format, "Escaped", 1);
+			break;
 		default:
 			break;
 	}
 }
 
 /**
- * @brief
+ * @brief	Initializes the RS232 top button, the rest is initialized by guiRs232InitSidebarGuiElements
  * @param	None
  * @retval	None
  */
 void guiRs232InitGuiElements()
 {
-	/* Text boxes ----------------------------------------------------------------*/
-	/* RS232 Label text box */
-	prvTextBox.object.id = GUITextBoxId_Rs232Label;
-	prvTextBox.object.xPos = 650;
-	prvTextBox.object.yPos = 50;
-	prvTextBox.object.width = 150;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvTextBox.object.borderThickness = 1;
-	prvTextBox.object.borderColor = GUI_WHITE;
-	prvTextBox.object.containerPage = GUIContainerPage_All;
-	prvTextBox.textColor = GUI_PURPLE;
-	prvTextBox.backgroundColor = GUI_WHITE;
-	prvTextBox.staticText = "RS232";
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* RS232 Main text box */
-	prvTextBox.object.id = GUITextBoxId_Rs232Main;
-	prvTextBox.object.xPos = 0;
-	prvTextBox.object.yPos = 50;
-	prvTextBox.object.width = 650;
-	prvTextBox.object.height = 400;
-	prvTextBox.object.border = GUIBorder_Top | GUIBorder_Right;
-	prvTextBox.object.borderThickness = 1;
-	prvTextBox.object.borderColor = GUI_WHITE;
-	prvTextBox.object.containerPage = GUI_PURPLE;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = LCD_COLOR_BLACK;
-	prvTextBox.textSize = LCDFontEnlarge_1x;
-	prvTextBox.padding.bottom = guiConfigFONT_HEIGHT_UNIT;
-	prvTextBox.padding.top = guiConfigFONT_HEIGHT_UNIT;
-	prvTextBox.padding.left = guiConfigFONT_WIDTH_UNIT;
-	prvTextBox.padding.right = guiConfigFONT_WIDTH_UNIT;
-	prvTextBox.dataReadFunction = SPI_FLASH_ReadBufferDMA;
-	prvTextBox.readStartAddress = FLASH_ADR_RS232_DATA;
-	prvTextBox.readEndAddress = FLASH_ADR_RS232_DATA;
-	prvTextBox.readMinAddress = FLASH_ADR_RS232_DATA;
-	prvTextBox.readLastValidByteAddress = FLASH_ADR_RS232_DATA;
-	prvTextBox.readMaxAddress = FLASH_ADR_RS232_DATA + FLASH_CHANNEL_DATA_SIZE - 1;
-	GUITextBox_Add(&prvTextBox);
-
-	/* RS232 Info Text Box */
-	prvTextBox.object.id = GUITextBoxId_Rs232Info;
-	prvTextBox.object.xPos = 0;
-	prvTextBox.object.yPos = 450;
-	prvTextBox.object.width = 650;
-	prvTextBox.object.height = 30;
-	prvTextBox.object.border = GUIBorder_Top | GUIBorder_Right;
-	prvTextBox.object.borderThickness = 2;
-	prvTextBox.object.borderColor = GUI_WHITE;
-	prvTextBox.object.containerPage = GUIContainerPage_1;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = GUI_PURPLE;
-	prvTextBox.textSize = LCDFontEnlarge_1x;
-	prvTextBox.xWritePos = 0;
-	prvTextBox.yWritePos = 0;
-	GUITextBox_Add(&prvTextBox);
-
 	/* Buttons -------------------------------------------------------------------*/
 	/* RS232 Button */
-	prvButton.object.id = GUIButtonId_Rs232Top;
-	prvButton.object.xPos = 400;
-	prvButton.object.yPos = 0;
-	prvButton.object.width = 100;
-	prvButton.object.height = 50;
-	prvButton.object.displayState = GUIDisplayState_NotHidden;
-	prvButton.object.border = GUIBorder_Bottom | GUIBorder_Right | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_PURPLE;
-	prvButton.disabledTextColor = GUI_PURPLE;
-	prvButton.disabledBackgroundColor = LCD_COLOR_BLACK;
-	prvButton.pressedTextColor = GUI_PURPLE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiRs232TopButtonCallback;
-	prvButton.text[0] = "RS232";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* RS232 Enable Button */
-	prvButton.object.id = GUIButtonId_Rs232Enable;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 100;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_PURPLE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_PURPLE;
-	prvButton.pressedTextColor = GUI_PURPLE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiRs232EnableButtonCallback;
-	prvButton.text[0] = "Output:";
-//	prvButton.text[1] = "Enabled";
-	prvButton.text[1] = "Disabled";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* RS232 Baud Rate Button */
-	prvButton.object.id = GUIButtonId_Rs232BaudRate;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 150;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_DARK_PURPLE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_PURPLE;
-	prvButton.pressedTextColor = GUI_PURPLE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiRs232BaudRateButtonCallback;
-	prvButton.text[0] = "< Baud Rate:";
-	prvButton.text[1] = "115200 bps";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* RS232 Parity Button */
-	prvButton.object.id = GUIButtonId_Rs232Parity;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 200;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_DARK_PURPLE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_PURPLE;
-	prvButton.pressedTextColor = GUI_PURPLE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiRs232ParityButtonCallback;
-	prvButton.text[0] = "< Parity:";
-	prvButton.text[1] = "None";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* RS232 Format Button */
-	prvButton.object.id = GUIButtonId_Rs232Format;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 250;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_PURPLE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_PURPLE;
-	prvButton.pressedTextColor = GUI_PURPLE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiRs232FormatButtonCallback;
-	prvButton.text[0] = "Display Format:";
-	prvButton.text[1] = "ASCII";
-//	prvButton.text[1] = "HEX";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* RS232 Clear Button */
-	prvButton.object.id = GUIButtonId_Rs232Clear;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 300;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_PURPLE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_PURPLE;
-	prvButton.pressedTextColor = GUI_PURPLE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = lcdGenericUartClearButtonCallback;
-	prvButton.text[0] = "Clear";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* RS232 Debug Button */
-	prvButton.object.id = GUIButtonId_Rs232Debug;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 100;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_2;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_RED;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_RED;
-	prvButton.pressedTextColor = GUI_RED;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiRs232DebugButtonCallback;
-	prvButton.text[0] = "Debug TX:";
-	prvButton.text[1] = "Disabled";
-//	prvButton.text[1] = "Enabled";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* RS232 Sidebar backwards button */
-	prvButton.object.id = GUIButtonId_Rs232SidebarBackwards;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 400;
-	prvButton.object.width = 75;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left | GUIBorder_Right;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_All;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_PURPLE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_DARK_PURPLE;
-	prvButton.pressedTextColor = GUI_PURPLE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_DisabledTouch;
-	prvButton.touchCallback = guiRs232SidebarForwardBackwardsButtonsCallback;
-	prvButton.text[0] = "<";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* RS232 Sidebar forwards button */
-	prvButton.object.id = GUIButtonId_Rs232SidebarForwards;
-	prvButton.object.xPos = 725;
-	prvButton.object.yPos = 400;
-	prvButton.object.width = 75;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_All;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_PURPLE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_DARK_PURPLE;
-	prvButton.pressedTextColor = GUI_PURPLE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Enabled;
-	prvButton.touchCallback = guiRs232SidebarForwardBackwardsButtonsCallback;
-	prvButton.text[0] = ">";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* RS232 4800 bps Button */
-	prvButton.object.id = GUIButtonId_Rs232BaudRate4800;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 150;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_PURPLE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_PURPLE;
-	prvButton.pressedTextColor = GUI_PURPLE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiRs232BaudRateSelectionCallback;
-	prvButton.text[0] = "4800 bps";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* RS232 7200 bps Button */
-	prvButton.object.id = GUIButtonId_Rs232BaudRate7200;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 190;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_PURPLE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_PURPLE;
-	prvButton.pressedTextColor = GUI_PURPLE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiRs232BaudRateSelectionCallback;
-	prvButton.text[0] = "7200 bps";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* RS232 9600 bps Button */
-	prvButton.object.id = GUIButtonId_Rs232BaudRate9600;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 230;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_PURPLE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_PURPLE;
-	prvButton.pressedTextColor = GUI_PURPLE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiRs232BaudRateSelectionCallback;
-	prvButton.text[0] = "9600 bps";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* RS232 19200 bps Button */
-	prvButton.object.id = GUIButtonId_Rs232BaudRate19k2;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 270;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_PURPLE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_PURPLE;
-	prvButton.pressedTextColor = GUI_PURPLE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiRs232BaudRateSelectionCallback;
-	prvButton.text[0] = "19200 bps";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* RS232 28800 bps Button */
-	prvButton.object.id = GUIButtonId_Rs232BaudRate28k8;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 310;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_PURPLE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_PURPLE;
-	prvButton.pressedTextColor = GUI_PURPLE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiRs232BaudRateSelectionCallback;
-	prvButton.text[0] = "28800 bps";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* RS232 38400 bps Button */
-	prvButton.object.id = GUIButtonId_Rs232BaudRate38k4;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 350;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_PURPLE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_PURPLE;
-	prvButton.pressedTextColor = GUI_PURPLE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiRs232BaudRateSelectionCallback;
-	prvButton.text[0] = "38400 bps";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* RS232 57600 bps Button */
-	prvButton.object.id = GUIButtonId_Rs232BaudRate57k6;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 390;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_PURPLE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_PURPLE;
-	prvButton.pressedTextColor = GUI_PURPLE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiRs232BaudRateSelectionCallback;
-	prvButton.text[0] = "57600 bps";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* RS232 115200 bps Button */
-	prvButton.object.id = GUIButtonId_Rs232BaudRate115k;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 430;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_PURPLE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_PURPLE;
-	prvButton.pressedTextColor = GUI_PURPLE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiRs232BaudRateSelectionCallback;
-	prvButton.text[0] = "115200 bps";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* RS232 Parity None Button */
-	prvButton.object.id = GUIButtonId_Rs232ParityNone;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 200;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_PURPLE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_PURPLE;
-	prvButton.pressedTextColor = GUI_PURPLE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiRs232ParitySelectionCallback;
-	prvButton.text[0] = "None";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
+	static const GUIButton topButton = {
+		.object.id = GUIButtonId_Rs232Top,
+		.object.xPos = 400,
+		.object.yPos = 0,
+		.object.width = 100,
+		.object.height = 50,
+		.object.displayState = GUIDisplayState_NotHidden,
+		.object.border = GUIBorder_Bottom | GUIBorder_Right | GUIBorder_Left,
+		.object.borderThickness = 1,
+		.object.borderColor = GUI_WHITE,
+		.enabledTextColor = GUI_WHITE,
+		.enabledBackgroundColor = GUI_PURPLE,
+		.disabledTextColor = GUI_PURPLE,
+		.disabledBackgroundColor = LCD_COLOR_BLACK,
+		.pressedTextColor = GUI_PURPLE,
+		.pressedBackgroundColor = GUI_WHITE,
+		.state = GUIButtonState_Disabled,
+		.touchCallback = guiRs232TopButtonCallback,
+		.text[0] = "RS232",
+		.textSize[0] = LCDFontEnlarge_2x,
+	};
+
+	GUIButton_Add(&topButton);
+}
 
-	/* RS232 Parity Odd Button */
-	prvButton.object.id = GUIButtonId_Rs232ParityOdd;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 240;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_PURPLE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_PURPLE;
-	prvButton.pressedTextColor = GUI_PURPLE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiRs232ParitySelectionCallback;
-	prvButton.text[0] = "Odd";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
+/**
+ * @brief	Initializes the RS232 sidebar, its popouts and the RS232 main content, called the first time the sidebar is shown
+ * @param	None
+ * @retval	None
+ */
+void guiRs232InitSidebarGuiElements()
+{
+	/* Text boxes ----------------------------------------------------------------*/
+	static const GUITextBox textBoxes[] = {
+		/* RS232 Label text box */
+		{
+			.object.id = GUITextBoxId_Rs232Label,
+			.object.xPos = 650,
+			.object.yPos = 50,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_All,
+			.textColor = GUI_PURPLE,
+			.backgroundColor = GUI_WHITE,
+			.staticText = "RS232",
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* RS232 Main text box */
+		{
+			.object.id = GUITextBoxId_Rs232Main,
+			.object.xPos = 0,
+			.object.yPos = 50,
+			.object.width = 650,
+			.object.height = 400,
+			.object.border = GUIBorder_Top | GUIBorder_Right,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUI_PURPLE,
+			.textColor = GUI_WHITE,
+			.backgroundColor = LCD_COLOR_BLACK,
+			.textSize = LCDFontEnlarge_1x,
+			.padding.bottom = guiConfigFONT_HEIGHT_UNIT,
+			.padding.top = guiConfigFONT_HEIGHT_UNIT,
+			.padding.left = guiConfigFONT_WIDTH_UNIT,
+			.padding.right = guiConfigFONT_WIDTH_UNIT,
+			.dataReadFunction = rs232ReadData,
+			.scrollbarWidth = guiConfigSCROLLBAR_WIDTH,
+			.minimapWidth = guiConfigMINIMAP_WIDTH,
+			.minimapFunction = rs232GetMinimap,
+			.readStartAddress = FLASH_ADR_RS232_DATA,
+			.readEndAddress = FLASH_ADR_RS232_DATA,
+			.readMinAddress = FLASH_ADR_RS232_DATA,
+			.readLastValidByteAddress = FLASH_ADR_RS232_DATA,
+			.readMaxAddress = FLASH_ADR_RS232_DATA + FLASH_CHANNEL_SUMMARY_OFFSET - 1,
+		},
+		/* RS232 Info Text Box */
+		{
+			.object.id = GUITextBoxId_Rs232Info,
+			.object.xPos = 0,
+			.object.yPos = 450,
+			.object.width = 650,
+			.object.height = 30,
+			.object.border = GUIBorder_Top | GUIBorder_Right,
+			.object.borderThickness = 2,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.textColor = GUI_WHITE,
+			.backgroundColor = GUI_PURPLE,
+			.textSize = LCDFontEnlarge_1x,
+			.xWritePos = 0,
+			.yWritePos = 0,
+		},
+	};
 
-	/* RS232 Parity None Button */
-	prvButton.object.id = GUIButtonId_Rs232ParityEven;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 280;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_PURPLE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_PURPLE;
-	prvButton.pressedTextColor = GUI_PURPLE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiRs232ParitySelectionCallback;
-	prvButton.text[0] = "Even";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
+	/* Buttons -------------------------------------------------------------------*/
+	static const GUIButton buttons[] = {
+		/* RS232 Enable Button */
+		{
+			.object.id = GUIButtonId_Rs232Enable,
+			.object.xPos = 650,
+			.object.yPos = 100,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiRs232EnableButtonCallback,
+			.text[0] = "Output:",
+//			.text[1] = "Enabled",
+			.text[1] = "Disabled",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* RS232 Baud Rate Button */
+		{
+			.object.id = GUIButtonId_Rs232BaudRate,
+			.object.xPos = 650,
+			.object.yPos = 150,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_DARK_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiRs232BaudRateButtonCallback,
+			.text[0] = "< Baud Rate:",
+			.text[1] = "115200 bps",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* RS232 Parity Button */
+		{
+			.object.id = GUIButtonId_Rs232Parity,
+			.object.xPos = 650,
+			.object.yPos = 200,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_DARK_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiRs232ParityButtonCallback,
+			.text[0] = "< Parity:",
+			.text[1] = "None",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* RS232 Format Button */
+		{
+			.object.id = GUIButtonId_Rs232Format,
+			.object.xPos = 650,
+			.object.yPos = 250,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiRs232FormatButtonCallback,
+			.text[0] = "Display Format:",
+			.text[1] = "ASCII",
+//			.text[1] = "HEX",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* RS232 Clear Button */
+		{
+			.object.id = GUIButtonId_Rs232Clear,
+			.object.xPos = 650,
+			.object.yPos = 300,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = lcdGenericUartClearButtonCallback,
+			.text[0] = "Clear",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* RS232 Debug Button */
+		{
+			.object.id = GUIButtonId_Rs232Debug,
+			.object.xPos = 650,
+			.object.yPos = 100,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_2,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_RED,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_RED,
+			.pressedTextColor = GUI_RED,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiRs232DebugButtonCallback,
+			.text[0] = "Debug TX:",
+			.text[1] = "Disabled",
+//			.text[1] = "Enabled",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* RS232 Search Pattern Button */
+		{
+			.object.id = GUIButtonId_Rs232SearchPattern,
+			.object.xPos = 650,
+			.object.yPos = 150,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_2,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_DARK_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiSearchPatternButtonCallback,
+			.text[0] = "Search for:",
+			.text[1] = "None",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* RS232 Search Next Button */
+		{
+			.object.id = GUIButtonId_Rs232SearchNext,
+			.object.xPos = 650,
+			.object.yPos = 200,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_2,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiSearchFindButtonCallback,
+			.text[0] = "Find:",
+			.text[1] = "Next",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* RS232 Search Previous Button */
+		{
+			.object.id = GUIButtonId_Rs232SearchPrevious,
+			.object.xPos = 650,
+			.object.yPos = 250,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_2,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiSearchFindButtonCallback,
+			.text[0] = "Find:",
+			.text[1] = "Previous",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* RS232 Sidebar backwards button */
+		{
+			.object.id = GUIButtonId_Rs232SidebarBackwards,
+			.object.xPos = 650,
+			.object.yPos = 400,
+			.object.width = 75,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left | GUIBorder_Right,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_All,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_DARK_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_DisabledTouch,
+			.touchCallback = guiRs232SidebarForwardBackwardsButtonsCallback,
+			.text[0] = "<",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* RS232 Sidebar forwards button */
+		{
+			.object.id = GUIButtonId_Rs232SidebarForwards,
+			.object.xPos = 725,
+			.object.yPos = 400,
+			.object.width = 75,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_All,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_DARK_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Enabled,
+			.touchCallback = guiRs232SidebarForwardBackwardsButtonsCallback,
+			.text[0] = ">",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* RS232 4800 bps Button */
+		{
+			.object.id = GUIButtonId_Rs232BaudRate4800,
+			.object.xPos = 500,
+			.object.yPos = 150,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiRs232BaudRateSelectionCallback,
+			.text[0] = "4800 bps",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* RS232 7200 bps Button */
+		{
+			.object.id = GUIButtonId_Rs232BaudRate7200,
+			.object.xPos = 500,
+			.object.yPos = 190,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiRs232BaudRateSelectionCallback,
+			.text[0] = "7200 bps",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* RS232 9600 bps Button */
+		{
+			.object.id = GUIButtonId_Rs232BaudRate9600,
+			.object.xPos = 500,
+			.object.yPos = 230,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiRs232BaudRateSelectionCallback,
+			.text[0] = "9600 bps",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* RS232 19200 bps Button */
+		{
+			.object.id = GUIButtonId_Rs232BaudRate19k2,
+			.object.xPos = 500,
+			.object.yPos = 270,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiRs232BaudRateSelectionCallback,
+			.text[0] = "19200 bps",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* RS232 28800 bps Button */
+		{
+			.object.id = GUIButtonId_Rs232BaudRate28k8,
+			.object.xPos = 500,
+			.object.yPos = 310,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiRs232BaudRateSelectionCallback,
+			.text[0] = "28800 bps",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* RS232 38400 bps Button */
+		{
+			.object.id = GUIButtonId_Rs232BaudRate38k4,
+			.object.xPos = 500,
+			.object.yPos = 350,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiRs232BaudRateSelectionCallback,
+			.text[0] = "38400 bps",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* RS232 57600 bps Button */
+		{
+			.object.id = GUIButtonId_Rs232BaudRate57k6,
+			.object.xPos = 500,
+			.object.yPos = 390,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiRs232BaudRateSelectionCallback,
+			.text[0] = "57600 bps",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* RS232 115200 bps Button */
+		{
+			.object.id = GUIButtonId_Rs232BaudRate115k,
+			.object.xPos = 500,
+			.object.yPos = 430,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiRs232BaudRateSelectionCallback,
+			.text[0] = "115200 bps",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* RS232 Parity None Button */
+		{
+			.object.id = GUIButtonId_Rs232ParityNone,
+			.object.xPos = 500,
+			.object.yPos = 200,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiRs232ParitySelectionCallback,
+			.text[0] = "None",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* RS232 Parity Odd Button */
+		{
+			.object.id = GUIButtonId_Rs232ParityOdd,
+			.object.xPos = 500,
+			.object.yPos = 240,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiRs232ParitySelectionCallback,
+			.text[0] = "Odd",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* RS232 Parity None Button */
+		{
+			.object.id = GUIButtonId_Rs232ParityEven,
+			.object.xPos = 500,
+			.object.yPos = 280,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_PURPLE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_PURPLE,
+			.pressedTextColor = GUI_PURPLE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiRs232ParitySelectionCallback,
+			.text[0] = "Even",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+	};
 
 	/* Containers ----------------------------------------------------------------*/
-	/* Sidebar RS232 container */
-	prvContainer.object.id = GUIContainerId_SidebarRs232;
-	prvContainer.object.xPos = 650;
-	prvContainer.object.yPos = 50;
-	prvContainer.object.width = 150;
-	prvContainer.object.height = 400;
-	prvContainer.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvContainer.object.borderThickness = 1;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.activePage = GUIContainerPage_1;
-	prvContainer.lastPage = GUIContainerPage_2;
-	prvContainer.contentHideState = GUIHideState_KeepBorders;
-	prvContainer.buttons[0] = GUIButton_GetFromId(GUIButtonId_Rs232Enable);
-	prvContainer.buttons[1] = GUIButton_GetFromId(GUIButtonId_Rs232BaudRate);
-	prvContainer.buttons[2] = GUIButton_GetFromId(GUIButtonId_Rs232Parity);
-	prvContainer.buttons[3] = GUIButton_GetFromId(GUIButtonId_Rs232Format);
-	prvContainer.buttons[4] = GUIButton_GetFromId(GUIButtonId_Rs232Clear);
-	prvContainer.buttons[5] = GUIButton_GetFromId(GUIButtonId_Rs232Debug);
-	prvContainer.buttons[6] = GUIButton_GetFromId(GUIButtonId_Rs232SidebarBackwards);
-	prvContainer.buttons[7] = GUIButton_GetFromId(GUIButtonId_Rs232SidebarForwards);
-	prvContainer.textBoxes[0] = GUITextBox_GetFromId(GUITextBoxId_Rs232Label);
-	GUIContainer_Add(&prvContainer);
-
-	/* RS232 baud rate popout container */
-	prvContainer.object.id = GUIContainerId_PopoutRs232BaudRate;
-	prvContainer.object.xPos = 500;
-	prvContainer.object.yPos = 150;
-	prvContainer.object.width = 149;
-	prvContainer.object.height = 320;
-	prvContainer.object.layer = GUILayer_1;
-	prvContainer.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvContainer.object.borderThickness = 2;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.contentHideState = GUIHideState_HideAll;
-	prvContainer.buttons[0] = GUIButton_GetFromId(GUIButtonId_Rs232BaudRate4800);
-	prvContainer.buttons[1] = GUIButton_GetFromId(GUIButtonId_Rs232BaudRate7200);
-	prvContainer.buttons[2] = GUIButton_GetFromId(GUIButtonId_Rs232BaudRate9600);
-	prvContainer.buttons[3] = GUIButton_GetFromId(GUIButtonId_Rs232BaudRate19k2);
-	prvContainer.buttons[4] = GUIButton_GetFromId(GUIButtonId_Rs232BaudRate28k8);
-	prvContainer.buttons[5] = GUIButton_GetFromId(GUIButtonId_Rs232BaudRate38k4);
-	prvContainer.buttons[6] = GUIButton_GetFromId(GUIButtonId_Rs232BaudRate57k6);
-	prvContainer.buttons[7] = GUIButton_GetFromId(GUIButtonId_Rs232BaudRate115k);
-	GUIContainer_Add(&prvContainer);
-
-	/* RS232 parity popout container */
-	prvContainer.object.id = GUIContainerId_PopoutRs232Parity;
-	prvContainer.object.xPos = 500;
-	prvContainer.object.yPos = 200;
-	prvContainer.object.width = 149;
-	prvContainer.object.height = 120;
-	prvContainer.object.layer = GUILayer_1;
-	prvContainer.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvContainer.object.borderThickness = 2;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.contentHideState = GUIHideState_HideAll;
-	prvContainer.buttons[0] = GUIButton_GetFromId(GUIButtonId_Rs232ParityNone);
-	prvContainer.buttons[1] = GUIButton_GetFromId(GUIButtonId_Rs232ParityOdd);
-	prvContainer.buttons[2] = GUIButton_GetFromId(GUIButtonId_Rs232ParityEven);
-	GUIContainer_Add(&prvContainer);
-
-	/* RS232 main container */
-	prvContainer.object.id = GUIContainerId_Rs232MainContent;
-	prvContainer.object.xPos = 0;
-	prvContainer.object.yPos = 50;
-	prvContainer.object.width = 650;
-	prvContainer.object.height = 400;
-	prvContainer.object.containerPage = guiConfigMAIN_CONTAINER_RS232_PAGE;
-	prvContainer.object.border = GUIBorder_Right | GUIBorder_Top;
-	prvContainer.object.borderThickness = 1;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.activePage = GUIContainerPage_1;
-	prvContainer.backgroundColor = GUI_BLACK;
-	prvContainer.contentHideState = GUIHideState_HideAll;
-	prvContainer.textBoxes[0] = GUITextBox_GetFromId(GUITextBoxId_Rs232Main);
-	prvContainer.textBoxes[1] = GUITextBox_GetFromId(GUITextBoxId_Rs232Info);
-	GUIContainer_Add(&prvContainer);
+	static const GUIContainerTemplate containers[] = {
+		/* Sidebar RS232 container */
+		{
+			.object.id = GUIContainerId_SidebarRs232,
+			.object.xPos = 650,
+			.object.yPos = 50,
+			.object.width = 150,
+			.object.height = 400,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.activePage = GUIContainerPage_1,
+			.lastPage = GUIContainerPage_2,
+			.contentHideState = GUIHideState_KeepBorders,
+			.buttons[0] = GUIButtonId_Rs232Enable,
+			.buttons[1] = GUIButtonId_Rs232BaudRate,
+			.buttons[2] = GUIButtonId_Rs232Parity,
+			.buttons[3] = GUIButtonId_Rs232Format,
+			.buttons[4] = GUIButtonId_Rs232Clear,
+			.buttons[5] = GUIButtonId_Rs232Debug,
+			.buttons[6] = GUIButtonId_Rs232SearchPattern,
+			.buttons[7] = GUIButtonId_Rs232SearchNext,
+			.buttons[8] = GUIButtonId_Rs232SearchPrevious,
+			.buttons[9] = GUIButtonId_Rs232SidebarBackwards,
+			.buttons[10] = GUIButtonId_Rs232SidebarForwards,
+			.textBoxes[0] = GUITextBoxId_Rs232Label,
+		},
+		/* RS232 baud rate popout container */
+		{
+			.object.id = GUIContainerId_PopoutRs232BaudRate,
+			.object.xPos = 500,
+			.object.yPos = 150,
+			.object.width = 149,
+			.object.height = 320,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 2,
+			.object.borderColor = GUI_WHITE,
+			.contentHideState = GUIHideState_HideAll,
+			.buttons[0] = GUIButtonId_Rs232BaudRate4800,
+			.buttons[1] = GUIButtonId_Rs232BaudRate7200,
+			.buttons[2] = GUIButtonId_Rs232BaudRate9600,
+			.buttons[3] = GUIButtonId_Rs232BaudRate19k2,
+			.buttons[4] = GUIButtonId_Rs232BaudRate28k8,
+			.buttons[5] = GUIButtonId_Rs232BaudRate38k4,
+			.buttons[6] = GUIButtonId_Rs232BaudRate57k6,
+			.buttons[7] = GUIButtonId_Rs232BaudRate115k,
+		},
+		/* RS232 parity popout container */
+		{
+			.object.id = GUIContainerId_PopoutRs232Parity,
+			.object.xPos = 500,
+			.object.yPos = 200,
+			.object.width = 149,
+			.object.height = 120,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 2,
+			.object.borderColor = GUI_WHITE,
+			.contentHideState = GUIHideState_HideAll,
+			.buttons[0] = GUIButtonId_Rs232ParityNone,
+			.buttons[1] = GUIButtonId_Rs232ParityOdd,
+			.buttons[2] = GUIButtonId_Rs232ParityEven,
+		},
+		/* RS232 main container */
+		{
+			.object.id = GUIContainerId_Rs232MainContent,
+			.object.xPos = 0,
+			.object.yPos = 50,
+			.object.width = 650,
+			.object.height = 400,
+			.object.containerPage = guiConfigMAIN_CONTAINER_RS232_PAGE,
+			.object.border = GUIBorder_Right | GUIBorder_Top,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.activePage = GUIContainerPage_1,
+			.backgroundColor = GUI_BLACK,
+			.contentHideState = GUIHideState_HideAll,
+			.textBoxes[0] = GUITextBoxId_Rs232Main,
+			.textBoxes[1] = GUITextBoxId_Rs232Info,
+		},
+	};
+
+	static const GUILayout layout = {
+		textBoxes, GUI_NUM_OF_OBJECTS(textBoxes),
+		buttons, GUI_NUM_OF_OBJECTS(buttons),
+		containers, GUI_NUM_OF_OBJECTS(containers),
+	};
+	GUI_AddLayout(&layout);
 }
 
 /* Interrupt Handlers --------------------------------------------------------*/
@@ -0,0 +1,536 @@
+/**
+ ******************************************************************************
+ * @file	gui_search.c
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-16
+ * @brief	Search for a pattern in the data of the UART channels. The pattern
+ *			is entered as hex with a keypad and is the same for all channels.
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "gui_search.h"
+
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define NUM_OF_KEYS				(18)
+#define NUM_OF_KEY_COLUMNS		(6)
+#define KEY_WIDTH				(66)
+#define KEY_HEIGHT				(80)
+
+#define BLOCKS_PER_FRAME		(2)		/* Blocks searched every time guiSearchManage is called */
+
+/* Private typedefs ----------------------------------------------------------*/
+typedef struct
+{
+	uint32_t textBoxId;
+	uint32_t patternButtonId;
+	uint32_t nextButtonId;
+	uint32_t previousButtonId;
+	uint32_t minAddress;
+	uint32_t (*getCurrentWriteAddress)();
+	ErrorStatus (*readFunction)(uint8_t*, uint32_t, uint32_t, TickType_t);
+	UARTSummary* (*getSummary)();
+} SearchChannel;
+
+/* Key in the keypad, hex digits are drawn larger than the delete and clear keys */
+#define SEARCH_KEY(INDEX, TEXT, SIZE)												\
+	{																				\
+		.object.id = GUIButtonId_SearchKey0 + (INDEX),								\
+		.object.xPos = 250 + ((INDEX) % NUM_OF_KEY_COLUMNS) * KEY_WIDTH,			\
+		.object.yPos = 160 + ((INDEX) / NUM_OF_KEY_COLUMNS) * KEY_HEIGHT,			\
+		.object.width = KEY_WIDTH,													\
+		.object.height = KEY_HEIGHT,												\
+		.object.layer = GUILayer_1,													\
+		.object.border = GUIBorder_Top | GUIBorder_Left,							\
+		.object.borderThickness = 1,												\
+		.object.borderColor = GUI_SYSTEM_BLUE,										\
+		.enabledTextColor = GUI_SYSTEM_BLUE,										\
+		.enabledBackgroundColor = GUI_SYSTEM_BLUE,									\
+		.disabledTextColor = GUI_SYSTEM_BLUE,										\
+		.disabledBackgroundColor = GUI_WHITE,										\
+		.pressedTextColor = GUI_WHITE,												\
+		.pressedBackgroundColor = GUI_SYSTEM_BLUE_DARK,								\
+		.state = GUIButtonState_Disabled,											\
+		.touchCallback = guiSearchKeyCallback,										\
+		.text[0] = (TEXT),															\
+		.textSize[0] = (SIZE),														\
+	}
+
+/* Private variables ---------------------------------------------------------*/
+static const SearchChannel prvChannels[] = {
+	{GUITextBoxId_Uart1Main, GUIButtonId_Uart1SearchPattern, GUIButtonId_Uart1SearchNext, GUIButtonId_Uart1SearchPrevious,
+	 FLASH_ADR_UART1_DATA, uart1GetCurrentWriteAddress, uart1ReadData, uart1GetSummary},
+	{GUITextBoxId_Uart2Main, GUIButtonId_Uart2SearchPattern, GUIButtonId_Uart2SearchNext, GUIButtonId_Uart2SearchPrevious,
+	 FLASH_ADR_UART2_DATA, uart2GetCurrentWriteAddress, uart2ReadData, uart2GetSummary},
+	{GUITextBoxId_Rs232Main, GUIButtonId_Rs232SearchPattern, GUIButtonId_Rs232SearchNext, GUIButtonId_Rs232SearchPrevious,
+	 FLASH_ADR_RS232_DATA, rs232GetCurrentWriteAddress, rs232ReadData, rs232GetSummary},
+};
+#define NUM_OF_CHANNELS		(sizeof(prvChannels) / sizeof(prvChannels[0]))
+
+/* Digits of the keys from GUIButtonId_SearchKey0 to GUIButtonId_SearchKeyF */
+static const uint8_t prvKeyDigits[] = "0123456789ABCDEF";
+
+/* The search reads with DMA so it can't be placed in CCM RAM */
+static UARTSearch prvSearch;
+
+/*
+ * The search runs in the timer task and the buttons that change it are handled in the LCD task. The mutex is
+ * held while the search or the variables about it are used so a pattern is never changed during a block.
+ */
+static SemaphoreHandle_t xSearchSemaphore;
+
+/* Hex digits entered with the keypad, two for every byte */
+static uint8_t prvPatternDigits[UART_SEARCH_MAX_PATTERN_SIZE * 2 + 1];
+static uint32_t prvNumOfPatternDigits = 0;
+static bool prvPatternIsValid = false;
+static uint8_t prvPatternButtonText[24] = "None";
+
+/* The channel and button of the running or last search */
+static const SearchChannel* prvSearchChannel = 0;
+static uint32_t prvStatusButtonId = guiConfigINVALID_ID;
+static uint8_t* prvStatusButtonDefaultText = 0;
+static uint8_t prvStatusText[24];
+static uint32_t prvLastProgress = 0;
+static bool prvHasMatch = false;
+
+/* Private function prototypes -----------------------------------------------*/
+static const SearchChannel* prvGetChannelForButton(uint32_t ButtonId);
+static void prvStartSearch(const SearchChannel* Channel, uint32_t ButtonId);
+static void prvSetStatus(uint8_t* pText);
+static void prvUpdatePatternGuiValue();
+static uint8_t* prvUintToString(uint32_t Number, uint8_t* pBuffer);
+
+/* Functions -----------------------------------------------------------------*/
+/* Search GUI Elements =======================================================*/
+/**
+ * @brief	Initializes the search, the keypad is initialized by guiSearchInitPopoutGuiElements
+ * @param	None
+ * @retval	None
+ */
+void guiSearchInitGuiElements()
+{
+	xSearchSemaphore = xSemaphoreCreateMutex();
+}
+
+/**
+ * @brief	Initializes the keypad used to enter the search pattern, called the first time the popout is shown
+ * @param	None
+ * @retval	None
+ */
+void guiSearchInitPopoutGuiElements()
+{
+	/* Text boxes ----------------------------------------------------------------*/
+	static const GUITextBox textBoxes[] = {
+		/* Search pattern text box */
+		{
+			.object.id = GUITextBoxId_SearchPattern,
+			.object.xPos = 250,
+			.object.yPos = 100,
+			.object.width = 399,
+			.object.height = 60,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.textColor = GUI_WHITE,
+			.backgroundColor = GUI_SYSTEM_BLUE,
+			.textSize = LCDFontEnlarge_1x,
+		},
+	};
+
+	/* Buttons -------------------------------------------------------------------*/
+	/* Keypad, hex digits and the delete and clear keys */
+	static const GUIButton buttons[NUM_OF_KEYS] = {
+		SEARCH_KEY(0, "0", LCDFontEnlarge_2x), SEARCH_KEY(1, "1", LCDFontEnlarge_2x),
+		SEARCH_KEY(2, "2", LCDFontEnlarge_2x), SEARCH_KEY(3, "3", LCDFontEnlarge_2x),
+		SEARCH_KEY(4, "4", LCDFontEnlarge_2x), SEARCH_KEY(5, "5", LCDFontEnlarge_2x),
+		SEARCH_KEY(6, "6", LCDFontEnlarge_2x), SEARCH_KEY(7, "7", LCDFontEnlarge_2x),
+		SEARCH_KEY(8, "8", LCDFontEnlarge_2x), SEARCH_KEY(9, "9", LCDFontEnlarge_2x),
+		SEARCH_KEY(10, "A", LCDFontEnlarge_2x), SEARCH_KEY(11, "B", LCDFontEnlarge_2x),
+		SEARCH_KEY(12, "C", LCDFontEnlarge_2x), SEARCH_KEY(13, "D", LCDFontEnlarge_2x),
+		SEARCH_KEY(14, "E", LCDFontEnlarge_2x), SEARCH_KEY(15, "F", LCDFontEnlarge_2x),
+		SEARCH_KEY(16, "Del", LCDFontEnlarge_1x), SEARCH_KEY(17, "Clear", LCDFontEnlarge_1x),
+	};
+
+	/* Containers ----------------------------------------------------------------*/
+	static const GUIContainerTemplate containers[] = {
+		/* Search popout container */
+		{
+			.object.id = GUIContainerId_PopoutSearch,
+			.object.xPos = 250,
+			.object.yPos = 100,
+			.object.width = 399,
+			.object.height = 300,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 2,
+			.object.borderColor = GUI_WHITE,
+			.backgroundColor = GUI_SYSTEM_BLUE,
+			.contentHideState = GUIHideState_HideAll,
+			.textBoxes[0] = GUITextBoxId_SearchPattern,
+			.buttons = {
+				GUIButtonId_SearchKey0, GUIButtonId_SearchKey1, GUIButtonId_SearchKey2, GUIButtonId_SearchKey3,
+				GUIButtonId_SearchKey4, GUIButtonId_SearchKey5, GUIButtonId_SearchKey6, GUIButtonId_SearchKey7,
+				GUIButtonId_SearchKey8, GUIButtonId_SearchKey9, GUIButtonId_SearchKeyA, GUIButtonId_SearchKeyB,
+				GUIButtonId_SearchKeyC, GUIButtonId_SearchKeyD, GUIButtonId_SearchKeyE, GUIButtonId_SearchKeyF,
+				GUIButtonId_SearchDelete, GUIButtonId_SearchClear,
+			},
+		},
+	};
+
+	static const GUILayout layout = {
+		textBoxes, GUI_NUM_OF_OBJECTS(textBoxes),
+		buttons, GUI_NUM_OF_OBJECTS(buttons),
+		containers, GUI_NUM_OF_OBJECTS(containers),
+	};
+	GUI_AddLayout(&layout);
+}
+
+/**
+ * @brief	Continues a running search, should be called periodically
+ * @param	None
+ * @retval	None
+ * @note	Only a few blocks are searched every call so the GUI keeps responding during long searches. A match
+ * 			is moved to by the task that manages the text box of the channel the next time it's shown.
+ */
+void guiSearchManage()
+{
+	/* Try again next time if the LCD task is changing the search */
+	if (xSearchSemaphore == 0 || xSemaphoreTake(xSearchSemaphore, 0) != pdTRUE)
+		return;
+
+	if (prvSearchChannel == 0 || uartSearchGetState(&prvSearch) != UARTSearchState_Searching)
+	{
+		xSemaphoreGive(xSearchSemaphore);
+		return;
+	}
+
+	UARTSearchState state = uartSearchContinue(&prvSearch, BLOCKS_PER_FRAME);
+	if (state == UARTSearchState_Searching)
+	{
+		/* Only update the status when the value has changed to avoid redrawing the button every time */
+		uint32_t progress = uartSearchGetProgress(&prvSearch);
+		if (progress != prvLastProgress)
+		{
+			prvLastProgress = progress;
+			uint8_t* end = prvUintToString(progress, prvStatusText);
+			strcpy((char*)end, " %");
+			prvSetStatus(prvStatusText);
+		}
+	}
+	else if (state == UARTSearchState_Found)
+	{
+		uint32_t matchPosition = uartSearchGetMatchAddress(&prvSearch) - prvSearchChannel->minAddress;
+		prvHasMatch = true;
+
+		/* The match ends up on the first displayed row */
+		GUITextBox_SetPendingPosition(prvSearchChannel->textBoxId, matchPosition);
+
+		strcpy((char*)prvStatusText, "At byte ");
+		prvUintToString(matchPosition, &prvStatusText[8]);
+		prvSetStatus(prvStatusText);
+	}
+	else if (state == UARTSearchState_NotFound)
+	{
+		prvHasMatch = false;
+
+		/* Show how much of the data the summaries made it possible to skip */
+		uint32_t skipped = uartSearchGetSkippedPercentage(&prvSearch);
+		if (skipped != 0)
+		{
+			strcpy((char*)prvStatusText, "None, ");
+			uint8_t* end = prvUintToString(skipped, &prvStatusText[6]);
+			strcpy((char*)end, " % skip");
+			prvSetStatus(prvStatusText);
+		}
+		else
+			prvSetStatus("Not found");
+	}
+	else
+	{
+		prvHasMatch = false;
+		prvSetStatus("Read error");
+	}
+
+	xSemaphoreGive(xSearchSemaphore);
+}
+
+/**
+ * @brief	Callback for the search pattern buttons, opens and closes the keypad
+ * @param	Event: The event that caused the callback
+ * @param	ButtonId: The button ID that the event happened on
+ * @retval	None
+ */
+void guiSearchPatternButtonCallback(GUITouchEvent Event, uint32_t ButtonId)
+{
+	if (Event == GUITouchEvent_Up)
+	{
+		GUIDisplayState displayState = GUIContainer_GetDisplayState(GUIContainerId_PopoutSearch);
+
+		if (displayState == GUIDisplayState_Hidden)
+		{
+			if (!GUIContainer_IsAdded(GUIContainerId_PopoutSearch))
+				guiSearchInitPopoutGuiElements();
+
+			GUI_SetActiveLayer(GUILayer_1);
+			GUIButton_SetLayer(ButtonId, GUILayer_1);
+			GUIButton_SetState(ButtonId, GUIButtonState_Enabled);
+			GUIContainer_Draw(GUIContainerId_PopoutSearch);
+			prvUpdatePatternGuiValue();
+		}
+		else if (displayState == GUIDisplayState_NotHidden)
+		{
+			GUIContainer_Hide(GUIContainerId_PopoutSearch);
+			GUI_SetActiveLayer(GUILayer_0);
+			GUIButton_SetLayer(ButtonId, GUILayer_0);
+			GUIButton_SetState(ButtonId, GUIButtonState_Disabled);
+
+			/* Use the new pattern, digits without a pair are ignored */
+			uint8_t digits[sizeof(prvPatternDigits)];
+			memcpy(digits, prvPatternDigits, prvNumOfPatternDigits & ~1);
+			digits[prvNumOfPatternDigits & ~1] = 0;
+			xSemaphoreTake(xSearchSemaphore, portMAX_DELAY);
+			prvPatternIsValid = (uartSearchSetPatternFromString(&prvSearch, digits, UARTSearchPatternFormat_Hex) == SUCCESS);
+			prvHasMatch = false;
+			if (prvStatusButtonId != guiConfigINVALID_ID)
+				GUIButton_SetTextForRow(prvStatusButtonId, prvStatusButtonDefaultText, 1);
+			prvStatusButtonId = guiConfigINVALID_ID;
+			xSemaphoreGive(xSearchSemaphore);
+
+			if (prvPatternIsValid)
+			{
+				/* Show the start of the pattern on the buttons */
+				uint32_t i = 0;
+				for (; i < prvNumOfPatternDigits / 2 && i < 6; i++)
+				{
+					prvPatternButtonText[3*i] = digits[2*i];
+					prvPatternButtonText[3*i + 1] = digits[2*i + 1];
+					prvPatternButtonText[3*i + 2] = ' ';
+				}
+				if (i < prvNumOfPatternDigits / 2)
+					strcpy((char*)&prvPatternButtonText[3*i], "..");
+				else
+					prvPatternButtonText[3*i - 1] = 0;
+			}
+			else
+				strcpy((char*)prvPatternButtonText, "None");
+
+			for (uint32_t i = 0; i < NUM_OF_CHANNELS; i++)
+				GUIButton_SetTextForRow(prvChannels[i].patternButtonId, prvPatternButtonText, 1);
+
+			/* Refresh the main text box */
+			lcdForceRefreshOfActiveMainContent();
+		}
+	}
+}
+
+/**
+ * @brief	Callback for the find next and find previous buttons
+ * @param	Event: The event that caused the callback
+ * @param	ButtonId: The button ID that the event happened on
+ * @retval	None
+ * @note	Pressing the button of a running search stops it
+ */
+void guiSearchFindButtonCallback(GUITouchEvent Event, uint32_t ButtonId)
+{
+	if (Event != GUITouchEvent_Up)
+		return;
+
+	const SearchChannel* channel = prvGetChannelForButton(ButtonId);
+	if (channel == 0)
+		return;
+
+	xSemaphoreTake(xSearchSemaphore, portMAX_DELAY);
+	prvStartSearch(channel, ButtonId);
+	xSemaphoreGive(xSearchSemaphore);
+}
+
+/**
+ * @brief	Callback for the keys in the search keypad
+ * @param	Event: The event that caused the callback
+ * @param	ButtonId: The button ID that the event happened on
+ * @retval	None
+ */
+void guiSearchKeyCallback(GUITouchEvent Event, uint32_t ButtonId)
+{
+	if (Event == GUITouchEvent_Up)
+	{
+		if (ButtonId == GUIButtonId_SearchDelete)
+		{
+			if (prvNumOfPatternDigits != 0)
+				prvNumOfPatternDigits--;
+		}
+		else if (ButtonId == GUIButtonId_SearchClear)
+		{
+			prvNumOfPatternDigits = 0;
+		}
+		else if (prvNumOfPatternDigits < sizeof(prvPatternDigits) - 1)
+		{
+			prvPatternDigits[prvNumOfPatternDigits++] = prvKeyDigits[ButtonId - GUIButtonId_SearchKey0];
+		}
+
+		prvPatternDigits[prvNumOfPatternDigits] = 0;
+		prvUpdatePatternGuiValue();
+	}
+}
+
+/* Private functions .--------------------------------------------------------*/
+/**
+ * @brief	Get the channel that a find button belongs to
+ * @param	ButtonId: The button
+ * @retval	Pointer to the channel or 0 if it's not a find button
+ */
+static const SearchChannel* prvGetChannelForButton(uint32_t ButtonId)
+{
+	for (uint32_t i = 0; i < NUM_OF_CHANNELS; i++)
+	{
+		if (ButtonId == prvChannels[i].nextButtonId || ButtonId == prvChannels[i].previousButtonId)
+			return &prvChannels[i];
+	}
+	return 0;
+}
+
+/**
+ * @brief	Start a search from a find button, or stop it if the button's search is running
+ * @param	Channel: The channel the button belongs to
+ * @param	ButtonId: The find next or find previous button
+ * @retval	None
+ * @note	xSearchSemaphore must be taken
+ */
+static void prvStartSearch(const SearchChannel* Channel, uint32_t ButtonId)
+{
+	bool wasSearching = (uartSearchGetState(&prvSearch) == UARTSearchState_Searching);
+	uartSearchStop(&prvSearch);
+	if (wasSearching && ButtonId == prvStatusButtonId)
+	{
+		prvSetStatus("Stopped");
+		return;
+	}
+
+	/* Give the previous button its text back before another one shows the status */
+	if (prvStatusButtonId != guiConfigINVALID_ID && prvStatusButtonId != ButtonId)
+		GUIButton_SetTextForRow(prvStatusButtonId, prvStatusButtonDefaultText, 1);
+	prvStatusButtonId = ButtonId;
+	if (ButtonId == Channel->nextButtonId)
+		prvStatusButtonDefaultText = "Next";
+	else
+		prvStatusButtonDefaultText = "Previous";
+
+	if (!prvPatternIsValid)
+	{
+		prvSetStatus("No pattern");
+		return;
+	}
+
+	/* Continue from the last match if it's still displayed, otherwise from the first displayed byte */
+	uint32_t firstDisplayedAddress = Channel->minAddress + GUITextBox_GetNumberForFirstDisplayedData(Channel->textBoxId);
+	uint32_t lastDisplayedAddress = GUITextBox_GetReadEndAddress(Channel->textBoxId);
+	uint32_t matchAddress = uartSearchGetMatchAddress(&prvSearch);
+	bool matchIsDisplayed = (prvHasMatch && Channel == prvSearchChannel &&
+							 matchAddress >= firstDisplayedAddress && matchAddress < lastDisplayedAddress);
+
+	prvSearchChannel = Channel;
+	prvHasMatch = false;
+	prvLastProgress = 0;
+	prvSetStatus("0 %");
+
+	if (ButtonId == Channel->nextButtonId)
+		uartSearchStart(&prvSearch, Channel->readFunction, Channel->getSummary(), Channel->minAddress, Channel->getCurrentWriteAddress(),
+						matchIsDisplayed ? matchAddress + 1 : firstDisplayedAddress, UARTSearchDirection_Forward);
+	else
+		uartSearchStart(&prvSearch, Channel->readFunction, Channel->getSummary(), Channel->minAddress, Channel->getCurrentWriteAddress(),
+						matchIsDisplayed ? matchAddress : firstDisplayedAddress, UARTSearchDirection_Backward);
+}
+
+/**
+ * @brief	Show the status of the search on the button that started it
+ * @param	pText: The text to show, it must not be changed until the button has been redrawn
+ * @retval	None
+ */
+static void prvSetStatus(uint8_t* pText)
+{
+	if (prvStatusButtonId != guiConfigINVALID_ID)
+		GUIButton_SetTextForRow(prvStatusButtonId, pText, 1);
+}
+
+/**
+ * @brief	Update the pattern text box with the entered digits as hex and as ASCII
+ * @param	None
+ * @retval	None
+ */
+static void prvUpdatePatternGuiValue()
+{
+	uint8_t hex[3 * UART_SEARCH_MAX_PATTERN_SIZE + 1];
+	uint8_t ascii[UART_SEARCH_MAX_PATTERN_SIZE + 1];
+	uint32_t numOfHexChars = 0;
+	uint32_t numOfAsciiChars = 0;
+
+	for (uint32_t i = 0; i < prvNumOfPatternDigits; i++)
+	{
+		hex[numOfHexChars++] = prvPatternDigits[i];
+		if (i % 2 == 1)
+		{
+			hex[numOfHexChars++] = ' ';
+
+			uint8_t value = 0;
+			for (uint32_t j = i - 1; j <= i; j++)
+			{
+				uint8_t digit = prvPatternDigits[j];
+				value = (value << 4) | ((digit <= '9') ? digit - '0' : digit - 'A' + 10);
+			}
+			ascii[numOfAsciiChars++] = (value >= ' ' && value <= '~') ? value : '.';
+		}
+	}
+	hex[numOfHexChars] = 0;
+	ascii[numOfAsciiChars] = 0;
+
+	GUITextBox_ClearAndResetWritePosition(GUITextBoxId_SearchPattern);
+	GUITextBox_SetWritePosition(GUITextBoxId_SearchPattern, 5, 8);
+	GUITextBox_WriteString(GUITextBoxId_SearchPattern, "Hex:   ");
+	GUITextBox_WriteString(GUITextBoxId_SearchPattern, hex);
+	GUITextBox_SetWritePosition(GUITextBoxId_SearchPattern, 5, 34);
+	GUITextBox_WriteString(GUITextBoxId_SearchPattern, "ASCII: ");
+	GUITextBox_WriteString(GUITextBoxId_SearchPattern, ascii);
+}
+
+/**
+ * @brief	Write a number as a string
+ * @param	Number: The number
+ * @param	pBuffer: Where to write the string, it's null-terminated
+ * @retval	Pointer to the null termination
+ */
+static uint8_t* prvUintToString(uint32_t Number, uint8_t* pBuffer)
+{
+	uint8_t digits[10];
+	uint32_t numOfDigits = 0;
+	do
+	{
+		digits[numOfDigits++] = '0' + Number % 10;
+		Number /= 10;
+	} while (Number != 0);
+
+	while (numOfDigits != 0)
+		*pBuffer++ = digits[--numOfDigits];
+	*pBuffer = 0;
+	return pBuffer;
+}
+
+/* Interrupt Handlers --------------------------------------------------------*/
@@ -26,339 +26,416 @@
 /* Includes ------------------------------------------------------------------*/
 #include "gui_system.h"
 
+#include "ft5206.h"
+#include "i2c2.h"
+
 /* Private defines -----------------------------------------------------------*/
 /* Private typedefs ----------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
-static GUITextBox prvTextBox = {0};
-static GUIButton prvButton = {0};
-static GUIContainer prvContainer = {0};
-
 /* Private function prototypes -----------------------------------------------*/
 static void prvUpdateScreenBrightnessGuiValue();
+static void prvUpdateReadCacheGuiValue();
+static void prvUpdateStatsGuiValue();
 
 /* Functions -----------------------------------------------------------------*/
 /* System GUI Elements =======================================================*/
 /**
- * @brief
+ * @brief	Initializes the system button, the debug console and the empty sidebar that are used from start.
+ * 			The rest is initialized by guiSystemInitSidebarGuiElements
  * @param	None
  * @retval	None
  */
 void guiSystemInitGuiElements()
 {
 	/* Text boxes ----------------------------------------------------------------*/
-	/* System Label text box */
-	prvTextBox.object.id = GUITextBoxId_SystemLabel;
-	prvTextBox.object.xPos = 650;
-	prvTextBox.object.yPos = 50;
-	prvTextBox.object.width = 150;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvTextBox.object.borderThickness = 1;
-	prvTextBox.object.borderColor = GUI_WHITE;
-	prvTextBox.object.containerPage = GUIContainerPage_All;
-	prvTextBox.textColor = GUI_SYSTEM_BLUE;
-	prvTextBox.backgroundColor = GUI_WHITE;
-	prvTextBox.staticText = "System";
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* Debug Text Box */
-	prvTextBox.object.id = GUITextBoxId_Debug;
-	prvTextBox.object.xPos = 0;
-	prvTextBox.object.yPos = 450;
-	prvTextBox.object.width = 649;
-	prvTextBox.object.height = 30;
-	prvTextBox.object.border = GUIBorder_Top;
-	prvTextBox.object.borderThickness = 1;
-	prvTextBox.object.borderColor = GUI_WHITE;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = GUI_RED;
-	prvTextBox.textSize = LCDFontEnlarge_1x;
-	prvTextBox.xWritePos = 0;
-	prvTextBox.yWritePos = 0;
-	GUITextBox_Add(&prvTextBox);
-
-	/* Screen brightness value text box */
-	prvTextBox.object.id = GUITextBoxId_ScreenBrightnessValue;
-	prvTextBox.object.xPos = 500;
-	prvTextBox.object.yPos = 175;
-	prvTextBox.object.width = 80;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.layer = GUILayer_1;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = GUI_SYSTEM_BLUE;
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
+	static const GUITextBox textBoxes[] = {
+		/* Debug Text Box */
+		{
+			.object.id = GUITextBoxId_Debug,
+			.object.xPos = 0,
+			.object.yPos = 450,
+			.object.width = 649,
+			.object.height = 30,
+			.object.border = GUIBorder_Top,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.textColor = GUI_WHITE,
+			.backgroundColor = GUI_RED,
+			.textSize = LCDFontEnlarge_1x,
+			.xWritePos = 0,
+			.yWritePos = 0,
+		},
+	};
+
+	/* Buttons -------------------------------------------------------------------*/
+	static const GUIButton buttons[] = {
+		/* System Button */
+		{
+			.object.id = GUIButtonId_System,
+			.object.xPos = 650,
+			.object.yPos = 450,
+			.object.width = 150,
+			.object.height = 30,
+			.object.layer = GUILayer_0,
+			.object.displayState = GUIDisplayState_NotHidden,
+			.object.border = GUIBorder_Top | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_SYSTEM_BLUE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_SYSTEM_BLUE,
+			.pressedTextColor = GUI_SYSTEM_BLUE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiSystemButtonCallback,
+			.text[0] = "System",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+	};
+
+	/* Containers ----------------------------------------------------------------*/
+	static const GUIContainerTemplate containers[] = {
+		/* Debug container */
+		{
+			.object.id = GUIContainerId_Debug,
+			.object.xPos = 0,
+			.object.yPos = 450,
+			.object.width = 650,
+			.object.height = 30,
+			.object.border = GUIBorder_Right,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.contentHideState = GUIHideState_KeepBorders,
+			.textBoxes[0] = GUITextBoxId_Debug,
+		},
+		/* Side empty container */
+		{
+			.object.id = GUIContainerId_SidebarEmpty,
+			.object.xPos = 650,
+			.object.yPos = 50,
+			.object.width = 150,
+			.object.height = 400,
+			.object.layer = GUILayer_0,
+			.object.displayState = GUIDisplayState_Hidden,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.activePage = GUIContainerPage_1,
+			.contentHideState = GUIHideState_KeepBorders,
+		},
+	};
+
+	static const GUILayout layout = {
+		textBoxes, GUI_NUM_OF_OBJECTS(textBoxes),
+		buttons, GUI_NUM_OF_OBJECTS(buttons),
+		containers, GUI_NUM_OF_OBJECTS(containers),
+	};
+	GUI_AddLayout(&layout);
+}
+
+/**
+ * @brief	Initializes the system sidebar and the screen brightness popout, called the first time the sidebar is shown
+ * @param	None
+ * @retval	None
+ */
+void guiSystemInitSidebarGuiElements()
+{
+	/* Text boxes ----------------------------------------------------------------*/
+	static const GUITextBox textBoxes[] = {
+		/* System Label text box */
+		{
+			.object.id = GUITextBoxId_SystemLabel,
+			.object.xPos = 650,
+			.object.yPos = 50,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_All,
+			.textColor = GUI_SYSTEM_BLUE,
+			.backgroundColor = GUI_WHITE,
+			.staticText = "System",
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* Screen brightness value text box */
+		{
+			.object.id = GUITextBoxId_ScreenBrightnessValue,
+			.object.xPos = 500,
+			.object.yPos = 175,
+			.object.width = 80,
+			.object.height = 50,
+			.object.layer = GUILayer_1,
+			.textColor = GUI_WHITE,
+			.backgroundColor = GUI_SYSTEM_BLUE,
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* Read cache statistics text box */
+		{
+			.object.id = GUITextBoxId_SystemReadCache,
+			.object.xPos = 650,
+			.object.yPos = 300,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.textColor = GUI_WHITE,
+			.backgroundColor = GUI_SYSTEM_BLUE,
+			.textSize = LCDFontEnlarge_1x,
+		},
+		/* Driver statistics text box, one line per value */
+		{
+			.object.id = GUITextBoxId_SystemStats,
+			.object.xPos = 650,
+			.object.yPos = 350,
+			.object.width = 150,
+			.object.height = 100,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.textColor = GUI_WHITE,
+			.backgroundColor = GUI_SYSTEM_BLUE,
+			.textSize = LCDFontEnlarge_1x,
+		},
+	};
 
 	/* Buttons -------------------------------------------------------------------*/
-	/* Beep Button */
-	prvButton.object.id = GUIButtonId_Beep;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 100;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_SYSTEM_BLUE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_SYSTEM_BLUE;
-	prvButton.pressedTextColor = GUI_SYSTEM_BLUE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiBeepButtonCallback;
-	prvButton.text[0] = "Button Beep:";
-	prvButton.text[1] = "On";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* Screen brightness Button */
-	prvButton.object.id = GUIButtonId_ScreenBrightness;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 150;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_SYSTEM_BLUE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_SYSTEM_BLUE;
-	prvButton.pressedTextColor = GUI_SYSTEM_BLUE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiScreenBrightnessButtonCallback;
-	prvButton.text[0] = "< Screen Brightn.";
-	prvButton.text[1] = "100%";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* Debug Button */
-	prvButton.object.id = GUIButtonId_Debug;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 200;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_RED;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_RED;
-	prvButton.pressedTextColor = GUI_RED;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiDebugToggleCallback;
-	prvButton.text[0] = "Debug";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* Save settings Button */
-	prvButton.object.id = GUIButtonId_SaveSettings;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 250;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_SYSTEM_BLUE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_SYSTEM_BLUE;
-	prvButton.pressedTextColor = GUI_SYSTEM_BLUE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiSaveSettingsButtonCallback;
-	prvButton.text[0] = "Save Channel";
-	prvButton.text[1] = "Settings";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-//	/* Storage Button */
-//	prvButton.object.id = GUIButtonId_Storage;
-//	prvButton.object.xPos = 650;
-//	prvButton.object.yPos = 300;
-//	prvButton.object.width = 150;
-//	prvButton.object.height = 50;
-//	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-//	prvButton.object.borderThickness = 1;
-//	prvButton.object.borderColor = GUI_WHITE;
-//	prvButton.object.containerPage = GUIContainerPage_1;
-//	prvButton.enabledTextColor = GUI_WHITE;
-//	prvButton.enabledBackgroundColor = GUI_SYSTEM_BLUE;
-//	prvButton.disabledTextColor = GUI_WHITE;
-//	prvButton.disabledBackgroundColor = GUI_SYSTEM_BLUE;
-//	prvButton.pressedTextColor = GUI_SYSTEM_BLUE;
-//	prvButton.pressedBackgroundColor = GUI_WHITE;
-//	prvButton.state = GUIButtonState_Disabled;
-//	prvButton.touchCallback = 0;
-//	prvButton.text[0] = "Storage";
-//	prvButton.textSize[0] = LCDFontEnlarge_1x;
-//	GUIButton_Add(&prvButton);
-
-//	/* Settings Button */
-//	prvButton.object.id = GUIButtonId_Settings;
-//	prvButton.object.xPos = 650;
-//	prvButton.object.yPos = 350;
-//	prvButton.object.width = 150;
-//	prvButton.object.height = 50;
-//	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-//	prvButton.object.borderThickness = 1;
-//	prvButton.object.borderColor = GUI_WHITE;
-//	prvButton.object.containerPage = GUIContainerPage_1;
-//	prvButton.enabledTextColor = GUI_WHITE;
-//	prvButton.enabledBackgroundColor = GUI_SYSTEM_BLUE;
-//	prvButton.disabledTextColor = GUI_WHITE;
-//	prvButton.disabledBackgroundColor = GUI_SYSTEM_BLUE;
-//	prvButton.pressedTextColor = GUI_SYSTEM_BLUE;
-//	prvButton.pressedBackgroundColor = GUI_WHITE;
-//	prvButton.state = GUIButtonState_Disabled;
-//	prvButton.touchCallback = 0;
-//	prvButton.text[0] = "Settings";
-//	prvButton.textSize[0] = LCDFontEnlarge_1x;
-//	GUIButton_Add(&prvButton);
-
-	/* System Button */
-	prvButton.object.id = GUIButtonId_System;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 450;
-	prvButton.object.width = 150;
-	prvButton.object.height = 30;
-	prvButton.object.layer = GUILayer_0;
-	prvButton.object.displayState = GUIDisplayState_NotHidden;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_SYSTEM_BLUE;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_SYSTEM_BLUE;
-	prvButton.pressedTextColor = GUI_SYSTEM_BLUE;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiSystemButtonCallback;
-	prvButton.text[0] = "System";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* Screen Brightness Down Button */
-	prvButton.object.id = GUIButtonId_ScreenBrightnessDown;
-	prvButton.object.xPos = 425;
-	prvButton.object.yPos = 175;
-	prvButton.object.width = 50;
-	prvButton.object.height = 50;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.enabledTextColor = GUI_SYSTEM_BLUE;
-	prvButton.enabledBackgroundColor = GUI_SYSTEM_BLUE;
-	prvButton.disabledTextColor = GUI_SYSTEM_BLUE;
-	prvButton.disabledBackgroundColor = GUI_WHITE;
-	prvButton.pressedTextColor = GUI_SYSTEM_BLUE;
-	prvButton.pressedBackgroundColor = GUI_SYSTEM_BLUE_DARK;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiScreenBrightnessCallback;
-	prvButton.text[0] = "-";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* Screen Brightness Up Button */
-	prvButton.object.id = GUIButtonId_ScreenBrightnessUp;
-	prvButton.object.xPos = 575;
-	prvButton.object.yPos = 175;
-	prvButton.object.width = 50;
-	prvButton.object.height = 50;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.enabledTextColor = GUI_SYSTEM_BLUE;
-	prvButton.enabledBackgroundColor = GUI_SYSTEM_BLUE;
-	prvButton.disabledTextColor = GUI_SYSTEM_BLUE;
-	prvButton.disabledBackgroundColor = GUI_WHITE;
-	prvButton.pressedTextColor = GUI_SYSTEM_BLUE;
-	prvButton.pressedBackgroundColor = GUI_SYSTEM_BLUE_DARK;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiScreenBrightnessCallback;
-	prvButton.text[0] = "+";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
+	static const GUIButton buttons[] = {
+		/* Beep Button */
+		{
+			.object.id = GUIButtonId_Beep,
+			.object.xPos = 650,
+			.object.yPos = 100,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_SYSTEM_BLUE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_SYSTEM_BLUE,
+			.pressedTextColor = GUI_SYSTEM_BLUE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiBeepButtonCallback,
+			.text[0] = "Button Beep:",
+			.text[1] = "On",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* Screen brightness Button */
+		{
+			.object.id = GUIButtonId_ScreenBrightness,
+			.object.xPos = 650,
+			.object.yPos = 150,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_SYSTEM_BLUE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_SYSTEM_BLUE,
+			.pressedTextColor = GUI_SYSTEM_BLUE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiScreenBrightnessButtonCallback,
+			.text[0] = "< Screen Brightn.",
+			.text[1] = "100%",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* Debug Button */
+		{
+			.object.id = GUIButtonId_Debug,
+			.object.xPos = 650,
+			.object.yPos = 200,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_RED,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_RED,
+			.pressedTextColor = GUI_RED,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiDebugToggleCallback,
+			.text[0] = "Debug",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* Save settings Button */
+		{
+			.object.id = GUIButtonId_SaveSettings,
+			.object.xPos = 650,
+			.object.yPos = 250,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_SYSTEM_BLUE,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_SYSTEM_BLUE,
+			.pressedTextColor = GUI_SYSTEM_BLUE,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiSaveSettingsButtonCallback,
+			.text[0] = "Save Channel",
+			.text[1] = "Settings",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+//		/* Storage Button */
+//		{
+//			.object.id = GUIButtonId_Storage,
+//			.object.xPos = 650,
+//			.object.yPos = 300,
+//			.object.width = 150,
+//			.object.height = 50,
+//			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+//			.object.borderThickness = 1,
+//			.object.borderColor = GUI_WHITE,
+//			.object.containerPage = GUIContainerPage_1,
+//			.enabledTextColor = GUI_WHITE,
+//			.enabledBackgroundColor = GUI_SYSTEM_BLUE,
+//			.disabledTextColor = GUI_WHITE,
+//			.disabledBackgroundColor = GUI_SYSTEM_BLUE,
+//			.pressedTextColor = GUI_SYSTEM_BLUE,
+//			.pressedBackgroundColor = GUI_WHITE,
+//			.state = GUIButtonState_Disabled,
+//			.touchCallback = 0,
+//			.text[0] = "Storage",
+//			.textSize[0] = LCDFontEnlarge_1x,
+//		},
+//		/* Settings Button */
+//		{
+//			.object.id = GUIButtonId_Settings,
+//			.object.xPos = 650,
+//			.object.yPos = 350,
+//			.object.width = 150,
+//			.object.height = 50,
+//			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+//			.object.borderThickness = 1,
+//			.object.borderColor = GUI_WHITE,
+//			.object.containerPage = GUIContainerPage_1,
+//			.enabledTextColor = GUI_WHITE,
+//			.enabledBackgroundColor = GUI_SYSTEM_BLUE,
+//			.disabledTextColor = GUI_WHITE,
+//			.disabledBackgroundColor = GUI_SYSTEM_BLUE,
+//			.pressedTextColor = GUI_SYSTEM_BLUE,
+//			.pressedBackgroundColor = GUI_WHITE,
+//			.state = GUIButtonState_Disabled,
+//			.touchCallback = 0,
+//			.text[0] = "Settings",
+//			.textSize[0] = LCDFontEnlarge_1x,
+//		},
+		/* Screen Brightness Down Button */
+		{
+			.object.id = GUIButtonId_ScreenBrightnessDown,
+			.object.xPos = 425,
+			.object.yPos = 175,
+			.object.width = 50,
+			.object.height = 50,
+			.object.layer = GUILayer_1,
+			.enabledTextColor = GUI_SYSTEM_BLUE,
+			.enabledBackgroundColor = GUI_SYSTEM_BLUE,
+			.disabledTextColor = GUI_SYSTEM_BLUE,
+			.disabledBackgroundColor = GUI_WHITE,
+			.pressedTextColor = GUI_SYSTEM_BLUE,
+			.pressedBackgroundColor = GUI_SYSTEM_BLUE_DARK,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiScreenBrightnessCallback,
+			.text[0] = "-",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* Screen Brightness Up Button */
+		{
+			.object.id = GUIButtonId_ScreenBrightnessUp,
+			.object.xPos = 575,
+			.object.yPos = 175,
+			.object.width = 50,
+			.object.height = 50,
+			.object.layer = GUILayer_1,
+			.enabledTextColor = GUI_SYSTEM_BLUE,
+			.enabledBackgroundColor = GUI_SYSTEM_BLUE,
+			.disabledTextColor = GUI_SYSTEM_BLUE,
+			.disabledBackgroundColor = GUI_WHITE,
+			.pressedTextColor = GUI_SYSTEM_BLUE,
+			.pressedBackgroundColor = GUI_SYSTEM_BLUE_DARK,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiScreenBrightnessCallback,
+			.text[0] = "+",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+	};
 
 	/* Containers ----------------------------------------------------------------*/
-	/* Debug container */
-	prvContainer.object.id = GUIContainerId_Debug;
-	prvContainer.object.xPos = 0;
-	prvContainer.object.yPos = 450;
-	prvContainer.object.width = 650;
-	prvContainer.object.height = 30;
-	prvContainer.object.border = GUIBorder_Right;
-	prvContainer.object.borderThickness = 1;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.contentHideState = GUIHideState_KeepBorders;
-	prvContainer.textBoxes[0] = GUITextBox_GetFromId(GUITextBoxId_Debug);
-	GUIContainer_Add(&prvContainer);
-//	GUIContainer_Draw(GUIContainerId_Debug);
-//	GUIContainer_HideContent(GUIContainerId_Debug);
-
-	/* Side system container */
-	prvContainer.object.id = GUIContainerId_SidebarSystem;
-	prvContainer.object.xPos = 650;
-	prvContainer.object.yPos = 50;
-	prvContainer.object.width = 150;
-	prvContainer.object.height = 400;
-	prvContainer.object.layer = GUILayer_0;
-	prvContainer.object.displayState = GUIDisplayState_Hidden;
-	prvContainer.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvContainer.object.borderThickness = 1;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.activePage = GUIContainerPage_1;
-	prvContainer.contentHideState = GUIHideState_KeepBorders;
-	prvContainer.buttons[0] = GUIButton_GetFromId(GUIButtonId_Beep);
-	prvContainer.buttons[1] = GUIButton_GetFromId(GUIButtonId_ScreenBrightness);
-	prvContainer.buttons[2] = GUIButton_GetFromId(GUIButtonId_Debug);
-	prvContainer.buttons[3] = GUIButton_GetFromId(GUIButtonId_SaveSettings);
-//	prvContainer.buttons[4] = GUIButton_GetFromId(GUIButtonId_Settings);
-//	prvContainer.buttons[5] = GUIButton_GetFromId(GUIButtonId_Storage);
-	prvContainer.textBoxes[0] = GUITextBox_GetFromId(GUITextBoxId_SystemLabel);
-	GUIContainer_Add(&prvContainer);
-
-	/* Side empty container */
-	prvContainer.object.id = GUIContainerId_SidebarEmpty;
-	prvContainer.object.xPos = 650;
-	prvContainer.object.yPos = 50;
-	prvContainer.object.width = 150;
-	prvContainer.object.height = 400;
-	prvContainer.object.layer = GUILayer_0;
-	prvContainer.object.displayState = GUIDisplayState_Hidden;
-	prvContainer.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvContainer.object.borderThickness = 1;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.activePage = GUIContainerPage_1;
-	prvContainer.contentHideState = GUIHideState_KeepBorders;
-	GUIContainer_Add(&prvContainer);
-
-	/* Screen brightness popout container */
-	prvContainer.object.id = GUIContainerId_PopoutScreenBrightness;
-	prvContainer.object.xPos = 400;
-	prvContainer.object.yPos = 150;
-	prvContainer.object.width = 249;
-	prvContainer.object.height = 100;
-	prvContainer.object.layer = GUILayer_1;
-	prvContainer.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvContainer.object.borderThickness = 2;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.backgroundColor = GUI_SYSTEM_BLUE;
-	prvContainer.contentHideState = GUIHideState_HideAll;
-	prvContainer.buttons[0] = GUIButton_GetFromId(GUIButtonId_ScreenBrightnessUp);
-	prvContainer.buttons[1] = GUIButton_GetFromId(GUIButtonId_ScreenBrightnessDown);
-	prvContainer.textBoxes[0] = GUITextBox_GetFromId(GUITextBoxId_ScreenBrightnessValue);
-	GUIContainer_Add(&prvContainer);
+	static const GUIContainerTemplate containers[] = {
+//		GUIContainer_Draw(GUIContainerId_Debug);
+//		GUIContainer_HideContent(GUIContainerId_Debug);
+		/* Side system container */
+		{
+			.object.id = GUIContainerId_SidebarSystem,
+			.object.xPos = 650,
+			.object.yPos = 50,
+			.object.width = 150,
+			.object.height = 400,
+			.object.layer = GUILayer_0,
+			.object.displayState = GUIDisplayState_Hidden,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.activePage = GUIContainerPage_1,
+			.contentHideState = GUIHideState_KeepBorders,
+			.buttons[0] = GUIButtonId_Beep,
+			.buttons[1] = GUIButtonId_ScreenBrightness,
+			.buttons[2] = GUIButtonId_Debug,
+			.buttons[3] = GUIButtonId_SaveSettings,
+//			.buttons[4] = GUIButtonId_Settings,
+//			.buttons[5] = GUIButtonId_Storage,
+			.textBoxes[0] = GUITextBoxId_SystemLabel,
+			.textBoxes[1] = GUITextBoxId_SystemReadCache,
+			.textBoxes[2] = GUITextBoxId_SystemStats,
+		},
+		/* Screen brightness popout container */
+		{
+			.object.id = GUIContainerId_PopoutScreenBrightness,
+			.object.xPos = 400,
+			.object.yPos = 150,
+			.object.width = 249,
+			.object.height = 100,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 2,
+			.object.borderColor = GUI_WHITE,
+			.backgroundColor = GUI_SYSTEM_BLUE,
+			.contentHideState = GUIHideState_HideAll,
+			.buttons[0] = GUIButtonId_ScreenBrightnessUp,
+			.buttons[1] = GUIButtonId_ScreenBrightnessDown,
+			.textBoxes[0] = GUITextBoxId_ScreenBrightnessValue,
+		},
+	};
+
+	static const GUILayout layout = {
+		textBoxes, GUI_NUM_OF_OBJECTS(textBoxes),
+		buttons, GUI_NUM_OF_OBJECTS(buttons),
+		containers, GUI_NUM_OF_OBJECTS(containers),
+	};
+	GUI_AddLayout(&layout);
 }
 
 /**
@@ -393,8 +470,14 @@ void guiSystemButtonCallback(GUITouchEvent Event, uint32_t ButtonId)
 {
 	if (Event == GUITouchEvent_Up)
 	{
-		GUIDisplayState displayState = GUIContainer_GetDisplayState(GUIContainerId_SidebarSystem);
 		lcdChangeDisplayStateOfSidebar(GUIContainerId_SidebarSystem);
+
+		/* Show the latest statistics every time the sidebar is opened */
+		if (GUIContainer_GetDisplayState(GUIContainerId_SidebarSystem) == GUIDisplayState_NotHidden)
+		{
+			prvUpdateReadCacheGuiValue();
+			prvUpdateStatsGuiValue();
+		}
 	}
 }
 
@@ -545,4 +628,74 @@ static void prvUpdateScreenBrightnessGuiValue()
 	GUITextBox_WriteString(GUITextBoxId_ScreenBrightnessValue, "%");
 }
 
+/**
+ * @brief	Update the read cache statistics text box
+ * @param	None
+ * @retval	None
+ */
+static void prvUpdateReadCacheGuiValue()
+{
+	GUIReadCacheStats stats;
+	GUI_GetReadCacheStats(&stats);
+
+	GUITextBox_ClearAndResetWritePosition(GUITextBoxId_SystemReadCache);
+	GUITextBox_SetWritePosition(GUITextBoxId_SystemReadCache, 5, 8);
+	GUITextBox_WriteString(GUITextBoxId_SystemReadCache, "Cache hits: ");
+	GUITextBox_WriteNumber(GUITextBoxId_SystemReadCache, (int32_t)stats.numOfHits);
+	GUITextBox_SetWritePosition(GUITextBoxId_SystemReadCache, 5, 26);
+	GUITextBox_WriteString(GUITextBoxId_SystemReadCache, "Misses: ");
+	GUITextBox_WriteNumber(GUITextBoxId_SystemReadCache, (int32_t)stats.numOfMisses);
+}
+
+/**
+ * @brief	Update the driver statistics text box
+ * @param	None
+ * @retval	None
+ */
+static void prvUpdateStatsGuiValue()
+{
+	/* Longest time in the touch interrupt in tenths of a us */
+	uint32_t touchTime = FT5206_GetMaxInterruptCycles() / (SystemCoreClock / 10000000);
+
+	GUITextBox_ClearAndResetWritePosition(GUITextBoxId_SystemStats);
+	GUITextBox_SetWritePosition(GUITextBoxId_SystemStats, 5, 2);
+	GUITextBox_WriteString(GUITextBoxId_SystemStats, "Touch IRQ: ");
+	GUITextBox_WriteNumber(GUITextBoxId_SystemStats, (int32_t)(touchTime / 10));
+	GUITextBox_WriteString(GUITextBoxId_SystemStats, ".");
+	GUITextBox_WriteNumber(GUITextBoxId_SystemStats, (int32_t)(touchTime % 10));
+	GUITextBox_WriteString(GUITextBoxId_SystemStats, " us");
+
+	/* Longest time from submit until done for the I2C clients and the errors of all of them */
+	I2C2ClientStats touchStats, temperatureStats, otherStats;
+	I2C2_GetClientStats(I2C2Client_Touch, &touchStats);
+	I2C2_GetClientStats(I2C2Client_Temperature, &temperatureStats);
+	I2C2_GetClientStats(I2C2Client_Other, &otherStats);
+
+	GUITextBox_SetWritePosition(GUITextBoxId_SystemStats, 5, 18);
+	GUITextBox_WriteString(GUITextBoxId_SystemStats, "I2C touch: ");
+	GUITextBox_WriteNumber(GUITextBoxId_SystemStats, (int32_t)touchStats.maxLatency);
+	GUITextBox_WriteString(GUITextBoxId_SystemStats, " us");
+	GUITextBox_SetWritePosition(GUITextBoxId_SystemStats, 5, 34);
+	GUITextBox_WriteString(GUITextBoxId_SystemStats, "I2C temp: ");
+	GUITextBox_WriteNumber(GUITextBoxId_SystemStats, (int32_t)temperatureStats.maxLatency);
+	GUITextBox_WriteString(GUITextBoxId_SystemStats, " us");
+	GUITextBox_SetWritePosition(GUITextBoxId_SystemStats, 5, 50);
+	GUITextBox_WriteString(GUITextBoxId_SystemStats, "I2C errors: ");
+	GUITextBox_WriteNumber(GUITextBoxId_SystemStats,
+						   (int32_t)(touchStats.numOfErrors + temperatureStats.numOfErrors + otherStats.numOfErrors));
+
+	/* Most text buffer blocks used at once and the buffers that had to come from the heap, which heap_1 never frees */
+	GUITextBufferPoolStats poolStats;
+	GUI_GetTextBufferPoolStats(&poolStats);
+
+	GUITextBox_SetWritePosition(GUITextBoxId_SystemStats, 5, 66);
+	GUITextBox_WriteString(GUITextBoxId_SystemStats, "Text pool: ");
+	GUITextBox_WriteNumber(GUITextBoxId_SystemStats, (int32_t)poolStats.maxNumOfBlocksInUse);
+	GUITextBox_WriteString(GUITextBoxId_SystemStats, "/");
+	GUITextBox_WriteNumber(GUITextBoxId_SystemStats, (int32_t)poolStats.numOfBlocks);
+	GUITextBox_SetWritePosition(GUITextBoxId_SystemStats, 5, 82);
+	GUITextBox_WriteString(GUITextBoxId_SystemStats, "Text heap: ");
+	GUITextBox_WriteNumber(GUITextBoxId_SystemStats, (int32_t)poolStats.numOfHeapFallbacks);
+}
+
 /* Interrupt Handlers --------------------------------------------------------*/
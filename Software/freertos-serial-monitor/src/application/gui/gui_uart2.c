@@ -31,10 +31,6 @@
 /* Private defines -----------------------------------------------------------*/
 /* Private typedefs ----------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
-static GUITextBox prvTextBox = {0};
-static GUIButton prvButton = {0};
-static GUIContainer prvContainer = {0};
-
 /* Private function prototypes -----------------------------------------------*/
 
 /* Functions -----------------------------------------------------------------*/
@@ -185,15 +181,29 @@ void guiUart2FormatButtonCallback(GUITouchEvent Event, uint32_t ButtonId)
 		/* Try to take the settings semaphore */
 		if (*settingsSemaphore != 0 && xSemaphoreTake(*settingsSemaphore, 100) == pdTRUE)
 		{
-			if (settings->textFormat == GUITextFormat_ASCII)
-			{
-				settings->textFormat = GUITextFormat_HexWithSpaces;
-				GUIButton_SetTextForRow(GUIButtonId_Uart2Format, "Hex", 1);
-			}
-			else if (settings->textFormat == GUITextFormat_HexWithSpaces)
+			/* Cycle through the formats: ASCII -> Hex -> Decimal -> Binary -> Escaped -> ASCII */
+			switch (settings->textFormat)
 			{
-				settings->textFormat = GUITextFormat_ASCII;
-				GUIButton_SetTextForRow(GUIButtonId_Uart2Format, "ASCII", 1);
+				case GUITextFormat_ASCII:
+					settings->textFormat = GUITextFormat_HexWithSpaces;
+					GUIButton_SetTextForRow(GUIButtonId_Uart2Format, "Hex", 1);
+					break;
+				case GUITextFormat_HexWithSpaces:
+					settings->textFormat = GUITextFormat_Decimal;
+					GUIButton_SetTextForRow(GUIButtonId_Uart2Format, "Decimal", 1);
+					break;
+				case GUITextFormat_Decimal:
+					settings->textFormat = GUITextFormat_Binary;
+					GUIButton_SetTextForRow(GUIButtonId_Uart2Format, "Binary", 1);
+					break;
+				case GUITextFormat_Binary:
+					settings->textFormat = GUITextFormat_CEscaped;
+					GUIButton_SetTextForRow(GUIButtonId_Uart2Format, "Escaped", 1);
+					break;
+				default:
+					settings->textFormat = GUITextFormat_ASCII;
+					GUIButton_SetTextForRow(GUIButtonId_Uart2Format, "ASCII", 1);
+					break;
 			}
 
 			/* Give back the semaphore now that we are done */
@@ -544,635 +554,749 @@ void guiUart2UpdateGuiElementsReadFromSettings()
 		case GUITextFormat_HexWithSpaces:
 			GUIButton_SetTextForRow(GUIButtonId_Uart2Format, "Hex", 1);
 			break;
+		case GUITextFormat_Decimal:
+			GUIButton_SetTextForRow(GUIButtonId_Uart2Format, "Decimal", 1);
+			break;
+		case GUITextFormat_Binary:
+			GUIButton_SetTextForRow(GUIButtonId_Uart2Format, "Binary", 1);
+			break;
+		case GUITextFormat_CEscaped:
+			GUIButton_SetTextForRow(GUIButtonId_Uart2Format, "Escaped", 1);
+			break;
 		default:
 			break;
 	}
 }
 
 /**
- * @brief
+ * @brief	Initializes the UART2 top button, the rest is initialized by guiUart2InitSidebarGuiElements
  * @param	None
  * @retval	None
  */
 void guiUart2InitGuiElements()
 {
-	/* Text boxes ----------------------------------------------------------------*/
-	/* UART2 Label text box */
-	prvTextBox.object.id = GUITextBoxId_Uart2Label;
-	prvTextBox.object.xPos = 650;
-	prvTextBox.object.yPos = 50;
-	prvTextBox.object.width = 150;
-	prvTextBox.object.height = 50;
-	prvTextBox.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvTextBox.object.borderThickness = 1;
-	prvTextBox.object.borderColor = GUI_WHITE;
-	prvTextBox.object.containerPage = GUIContainerPage_All;
-	prvTextBox.textColor = GUI_YELLOW;
-	prvTextBox.backgroundColor = GUI_WHITE;
-	prvTextBox.staticText = "UART2";
-	prvTextBox.textSize = LCDFontEnlarge_2x;
-	GUITextBox_Add(&prvTextBox);
-
-	/* UART2 Main text box */
-	prvTextBox.object.id = GUITextBoxId_Uart2Main;
-	prvTextBox.object.xPos = 0;
-	prvTextBox.object.yPos = 50;
-	prvTextBox.object.width = 650;
-	prvTextBox.object.height = 400;
-	prvTextBox.object.border = GUIBorder_Top | GUIBorder_Right;
-	prvTextBox.object.borderThickness = 1;
-	prvTextBox.object.borderColor = GUI_WHITE;
-	prvTextBox.object.containerPage = GUIContainerPage_1;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = LCD_COLOR_BLACK;
-	prvTextBox.textSize = LCDFontEnlarge_1x;
-	prvTextBox.padding.bottom = guiConfigFONT_HEIGHT_UNIT;
-	prvTextBox.padding.top = guiConfigFONT_HEIGHT_UNIT;
-	prvTextBox.padding.left = guiConfigFONT_WIDTH_UNIT;
-	prvTextBox.padding.right = guiConfigFONT_WIDTH_UNIT;
-	prvTextBox.dataReadFunction = SPI_FLASH_ReadBufferDMA;
-	prvTextBox.readStartAddress = FLASH_ADR_UART2_DATA;
-	prvTextBox.readEndAddress = FLASH_ADR_UART2_DATA;
-	prvTextBox.readMinAddress = FLASH_ADR_UART2_DATA;
-	prvTextBox.readLastValidByteAddress = FLASH_ADR_UART2_DATA;
-	prvTextBox.readMaxAddress = FLASH_ADR_UART2_DATA + FLASH_CHANNEL_DATA_SIZE - 1;
-	GUITextBox_Add(&prvTextBox);
-
-	/* UART2 Info Text Box */
-	prvTextBox.object.id = GUITextBoxId_Uart2Info;
-	prvTextBox.object.xPos = 0;
-	prvTextBox.object.yPos = 450;
-	prvTextBox.object.width = 650;
-	prvTextBox.object.height = 30;
-	prvTextBox.object.border = GUIBorder_Top | GUIBorder_Right;
-	prvTextBox.object.borderThickness = 2;
-	prvTextBox.object.borderColor = GUI_WHITE;
-	prvTextBox.object.containerPage = GUIContainerPage_1;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = GUI_YELLOW;
-	prvTextBox.textSize = LCDFontEnlarge_1x;
-	prvTextBox.xWritePos = 0;
-	prvTextBox.yWritePos = 0;
-	GUITextBox_Add(&prvTextBox);
-
 	/* Buttons -------------------------------------------------------------------*/
 	/* UART2 Top Button */
-	prvButton.object.id = GUIButtonId_Uart2Top;
-	prvButton.object.xPos = 300;
-	prvButton.object.yPos = 0;
-	prvButton.object.width = 100;
-	prvButton.object.height = 50;
-	prvButton.object.displayState = GUIDisplayState_NotHidden;
-	prvButton.object.border = GUIBorder_Bottom | GUIBorder_Right | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_YELLOW;
-	prvButton.disabledTextColor = GUI_YELLOW;
-	prvButton.disabledBackgroundColor = LCD_COLOR_BLACK;
-	prvButton.pressedTextColor = GUI_YELLOW;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiUart2TopButtonCallback;
-	prvButton.text[0] = "UART2";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* UART2 Enable Button */
-	prvButton.object.id = GUIButtonId_Uart2Enable;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 100;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_YELLOW;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_YELLOW;
-	prvButton.pressedTextColor = GUI_YELLOW;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiUart2EnableButtonCallback;
-	prvButton.text[0] = "Output:";
-//	prvButton.text[1] = "Enabled";
-	prvButton.text[1] = "Disabled";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* UART2 Baud Rate Button */
-	prvButton.object.id = GUIButtonId_Uart2BaudRate;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 150;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_DARK_YELLOW;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_YELLOW;
-	prvButton.pressedTextColor = GUI_YELLOW;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiUart2BaudRateButtonCallback;
-	prvButton.text[0] = "< Baud Rate:";
-	prvButton.text[1] = "115200 bps";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* UART2 Parity Button */
-	prvButton.object.id = GUIButtonId_Uart2Parity;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 200;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_DARK_YELLOW;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_YELLOW;
-	prvButton.pressedTextColor = GUI_YELLOW;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiUart2ParityButtonCallback;
-	prvButton.text[0] = "< Parity:";
-	prvButton.text[1] = "None";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* UART2 Format Button */
-	prvButton.object.id = GUIButtonId_Uart2Format;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 250;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_YELLOW;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_YELLOW;
-	prvButton.pressedTextColor = GUI_YELLOW;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiUart2FormatButtonCallback;
-	prvButton.text[0] = "Display Format:";
-	prvButton.text[1] = "ASCII";
-//	prvButton.text[1] = "HEX";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* UART2 Clear Button */
-	prvButton.object.id = GUIButtonId_Uart2Clear;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 300;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_1;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_YELLOW;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_YELLOW;
-	prvButton.pressedTextColor = GUI_YELLOW;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = lcdGenericUartClearButtonCallback;
-	prvButton.text[0] = "Clear";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* UART2 Voltage Level Button */
-	prvButton.object.id = GUIButtonId_Uart2VoltageLevel;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 100;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_2;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_YELLOW;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_YELLOW;
-	prvButton.pressedTextColor = GUI_YELLOW;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiUart2VoltageLevelButtonCallback;
-	prvButton.text[0] = "Voltage Level:";
-	prvButton.text[1] = "5 V";
-//	prvButton.text[1] = "3.3 V";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* UART2 Debug Button */
-	prvButton.object.id = GUIButtonId_Uart2Debug;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 150;
-	prvButton.object.width = 150;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_2;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_RED;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_RED;
-	prvButton.pressedTextColor = GUI_RED;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiUart2DebugButtonCallback;
-	prvButton.text[0] = "Debug TX:";
-	prvButton.text[1] = "Disabled";
-//	prvButton.text[1] = "Enabled";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	prvButton.textSize[1] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* UART2 Sidebar backwards button */
-	prvButton.object.id = GUIButtonId_Uart2SidebarBackwards;
-	prvButton.object.xPos = 650;
-	prvButton.object.yPos = 400;
-	prvButton.object.width = 75;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left | GUIBorder_Right;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_All;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_YELLOW;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_DARK_YELLOW;
-	prvButton.pressedTextColor = GUI_YELLOW;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_DisabledTouch;
-	prvButton.touchCallback = guiUart2SidebarForwardBackwardsButtonsCallback;
-	prvButton.text[0] = "<";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-	/* UART2 Sidebar forwards button */
-	prvButton.object.id = GUIButtonId_Uart2SidebarForwards;
-	prvButton.object.xPos = 725;
-	prvButton.object.yPos = 400;
-	prvButton.object.width = 75;
-	prvButton.object.height = 50;
-	prvButton.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.object.containerPage = GUIContainerPage_All;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_YELLOW;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_DARK_YELLOW;
-	prvButton.pressedTextColor = GUI_YELLOW;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Enabled;
-	prvButton.touchCallback = guiUart2SidebarForwardBackwardsButtonsCallback;
-	prvButton.text[0] = ">";
-	prvButton.textSize[0] = LCDFontEnlarge_2x;
-	GUIButton_Add(&prvButton);
-
-
-	/* UART2 4800 bps Button */
-	prvButton.object.id = GUIButtonId_Uart2BaudRate4800;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 150;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_YELLOW;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_YELLOW;
-	prvButton.pressedTextColor = GUI_YELLOW;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiUart2BaudRateSelectionCallback;
-	prvButton.text[0] = "4800 bps";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* UART2 7200 bps Button */
-	prvButton.object.id = GUIButtonId_Uart2BaudRate7200;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 190;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_YELLOW;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_YELLOW;
-	prvButton.pressedTextColor = GUI_YELLOW;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiUart2BaudRateSelectionCallback;
-	prvButton.text[0] = "7200 bps";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* UART2 9600 bps Button */
-	prvButton.object.id = GUIButtonId_Uart2BaudRate9600;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 230;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_YELLOW;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_YELLOW;
-	prvButton.pressedTextColor = GUI_YELLOW;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiUart2BaudRateSelectionCallback;
-	prvButton.text[0] = "9600 bps";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* UART2 19200 bps Button */
-	prvButton.object.id = GUIButtonId_Uart2BaudRate19k2;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 270;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_YELLOW;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_YELLOW;
-	prvButton.pressedTextColor = GUI_YELLOW;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiUart2BaudRateSelectionCallback;
-	prvButton.text[0] = "19200 bps";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* UART2 28800 bps Button */
-	prvButton.object.id = GUIButtonId_Uart2BaudRate28k8;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 310;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_YELLOW;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_YELLOW;
-	prvButton.pressedTextColor = GUI_YELLOW;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiUart2BaudRateSelectionCallback;
-	prvButton.text[0] = "28800 bps";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* UART2 38400 bps Button */
-	prvButton.object.id = GUIButtonId_Uart2BaudRate38k4;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 350;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_YELLOW;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_YELLOW;
-	prvButton.pressedTextColor = GUI_YELLOW;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiUart2BaudRateSelectionCallback;
-	prvButton.text[0] = "38400 bps";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* UART2 57600 bps Button */
-	prvButton.object.id = GUIButtonId_Uart2BaudRate57k6;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 390;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_YELLOW;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_YELLOW;
-	prvButton.pressedTextColor = GUI_YELLOW;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiUart2BaudRateSelectionCallback;
-	prvButton.text[0] = "57600 bps";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* UART2 115200 bps Button */
-	prvButton.object.id = GUIButtonId_Uart2BaudRate115k;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 430;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_YELLOW;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_YELLOW;
-	prvButton.pressedTextColor = GUI_YELLOW;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiUart2BaudRateSelectionCallback;
-	prvButton.text[0] = "115200 bps";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
-
-	/* UART2 Parity None Button */
-	prvButton.object.id = GUIButtonId_Uart2ParityNone;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 200;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_YELLOW;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_YELLOW;
-	prvButton.pressedTextColor = GUI_YELLOW;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiUart2ParitySelectionCallback;
-	prvButton.text[0] = "None";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
+	static const GUIButton topButton = {
+		.object.id = GUIButtonId_Uart2Top,
+		.object.xPos = 300,
+		.object.yPos = 0,
+		.object.width = 100,
+		.object.height = 50,
+		.object.displayState = GUIDisplayState_NotHidden,
+		.object.border = GUIBorder_Bottom | GUIBorder_Right | GUIBorder_Left,
+		.object.borderThickness = 1,
+		.object.borderColor = GUI_WHITE,
+		.enabledTextColor = GUI_WHITE,
+		.enabledBackgroundColor = GUI_YELLOW,
+		.disabledTextColor = GUI_YELLOW,
+		.disabledBackgroundColor = LCD_COLOR_BLACK,
+		.pressedTextColor = GUI_YELLOW,
+		.pressedBackgroundColor = GUI_WHITE,
+		.state = GUIButtonState_Disabled,
+		.touchCallback = guiUart2TopButtonCallback,
+		.text[0] = "UART2",
+		.textSize[0] = LCDFontEnlarge_2x,
+	};
+
+	GUIButton_Add(&topButton);
+}
 
-	/* UART2 Parity Odd Button */
-	prvButton.object.id = GUIButtonId_Uart2ParityOdd;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 240;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_YELLOW;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_YELLOW;
-	prvButton.pressedTextColor = GUI_YELLOW;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiUart2ParitySelectionCallback;
-	prvButton.text[0] = "Odd";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
+/**
+ * @brief	Initializes the UART2 sidebar, its popouts and the UART2 main content, called the first time the sidebar is shown
+ * @param	None
+ * @retval	None
+ */
+void guiUart2InitSidebarGuiElements()
+{
+	/* Text boxes ----------------------------------------------------------------*/
+	static const GUITextBox textBoxes[] = {
+		/* UART2 Label text box */
+		{
+			.object.id = GUITextBoxId_Uart2Label,
+			.object.xPos = 650,
+			.object.yPos = 50,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_All,
+			.textColor = GUI_YELLOW,
+			.backgroundColor = GUI_WHITE,
+			.staticText = "UART2",
+			.textSize = LCDFontEnlarge_2x,
+		},
+		/* UART2 Main text box */
+		{
+			.object.id = GUITextBoxId_Uart2Main,
+			.object.xPos = 0,
+			.object.yPos = 50,
+			.object.width = 650,
+			.object.height = 400,
+			.object.border = GUIBorder_Top | GUIBorder_Right,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.textColor = GUI_WHITE,
+			.backgroundColor = LCD_COLOR_BLACK,
+			.textSize = LCDFontEnlarge_1x,
+			.padding.bottom = guiConfigFONT_HEIGHT_UNIT,
+			.padding.top = guiConfigFONT_HEIGHT_UNIT,
+			.padding.left = guiConfigFONT_WIDTH_UNIT,
+			.padding.right = guiConfigFONT_WIDTH_UNIT,
+			.dataReadFunction = uart2ReadData,
+			.scrollbarWidth = guiConfigSCROLLBAR_WIDTH,
+			.minimapWidth = guiConfigMINIMAP_WIDTH,
+			.minimapFunction = uart2GetMinimap,
+			.readStartAddress = FLASH_ADR_UART2_DATA,
+			.readEndAddress = FLASH_ADR_UART2_DATA,
+			.readMinAddress = FLASH_ADR_UART2_DATA,
+			.readLastValidByteAddress = FLASH_ADR_UART2_DATA,
+			.readMaxAddress = FLASH_ADR_UART2_DATA + FLASH_CHANNEL_SUMMARY_OFFSET - 1,
+		},
+		/* UART2 Info Text Box */
+		{
+			.object.id = GUITextBoxId_Uart2Info,
+			.object.xPos = 0,
+			.object.yPos = 450,
+			.object.width = 650,
+			.object.height = 30,
+			.object.border = GUIBorder_Top | GUIBorder_Right,
+			.object.borderThickness = 2,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.textColor = GUI_WHITE,
+			.backgroundColor = GUI_YELLOW,
+			.textSize = LCDFontEnlarge_1x,
+			.xWritePos = 0,
+			.yWritePos = 0,
+		},
+	};
 
-	/* UART2 Parity None Button */
-	prvButton.object.id = GUIButtonId_Uart2ParityEven;
-	prvButton.object.xPos = 500;
-	prvButton.object.yPos = 280;
-	prvButton.object.width = 149;
-	prvButton.object.height = 40;
-	prvButton.object.layer = GUILayer_1;
-	prvButton.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvButton.object.borderThickness = 1;
-	prvButton.object.borderColor = GUI_WHITE;
-	prvButton.enabledTextColor = GUI_WHITE;
-	prvButton.enabledBackgroundColor = GUI_YELLOW;
-	prvButton.disabledTextColor = GUI_WHITE;
-	prvButton.disabledBackgroundColor = GUI_YELLOW;
-	prvButton.pressedTextColor = GUI_YELLOW;
-	prvButton.pressedBackgroundColor = GUI_WHITE;
-	prvButton.state = GUIButtonState_Disabled;
-	prvButton.touchCallback = guiUart2ParitySelectionCallback;
-	prvButton.text[0] = "Even";
-	prvButton.textSize[0] = LCDFontEnlarge_1x;
-	GUIButton_Add(&prvButton);
+	/* Buttons -------------------------------------------------------------------*/
+	static const GUIButton buttons[] = {
+		/* UART2 Enable Button */
+		{
+			.object.id = GUIButtonId_Uart2Enable,
+			.object.xPos = 650,
+			.object.yPos = 100,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiUart2EnableButtonCallback,
+			.text[0] = "Output:",
+//			.text[1] = "Enabled",
+			.text[1] = "Disabled",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* UART2 Baud Rate Button */
+		{
+			.object.id = GUIButtonId_Uart2BaudRate,
+			.object.xPos = 650,
+			.object.yPos = 150,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_DARK_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiUart2BaudRateButtonCallback,
+			.text[0] = "< Baud Rate:",
+			.text[1] = "115200 bps",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* UART2 Parity Button */
+		{
+			.object.id = GUIButtonId_Uart2Parity,
+			.object.xPos = 650,
+			.object.yPos = 200,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_DARK_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiUart2ParityButtonCallback,
+			.text[0] = "< Parity:",
+			.text[1] = "None",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* UART2 Format Button */
+		{
+			.object.id = GUIButtonId_Uart2Format,
+			.object.xPos = 650,
+			.object.yPos = 250,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiUart2FormatButtonCallback,
+			.text[0] = "Display Format:",
+			.text[1] = "ASCII",
+//			.text[1] = "HEX",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* UART2 Clear Button */
+		{
+			.object.id = GUIButtonId_Uart2Clear,
+			.object.xPos = 650,
+			.object.yPos = 300,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_1,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = lcdGenericUartClearButtonCallback,
+			.text[0] = "Clear",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* UART2 Voltage Level Button */
+		{
+			.object.id = GUIButtonId_Uart2VoltageLevel,
+			.object.xPos = 650,
+			.object.yPos = 100,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_2,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiUart2VoltageLevelButtonCallback,
+			.text[0] = "Voltage Level:",
+			.text[1] = "5 V",
+//			.text[1] = "3.3 V",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* UART2 Debug Button */
+		{
+			.object.id = GUIButtonId_Uart2Debug,
+			.object.xPos = 650,
+			.object.yPos = 150,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_2,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_RED,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_RED,
+			.pressedTextColor = GUI_RED,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiUart2DebugButtonCallback,
+			.text[0] = "Debug TX:",
+			.text[1] = "Disabled",
+//			.text[1] = "Enabled",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* UART2 Search Pattern Button */
+		{
+			.object.id = GUIButtonId_Uart2SearchPattern,
+			.object.xPos = 650,
+			.object.yPos = 200,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_2,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_DARK_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiSearchPatternButtonCallback,
+			.text[0] = "Search for:",
+			.text[1] = "None",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* UART2 Search Next Button */
+		{
+			.object.id = GUIButtonId_Uart2SearchNext,
+			.object.xPos = 650,
+			.object.yPos = 250,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_2,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiSearchFindButtonCallback,
+			.text[0] = "Find:",
+			.text[1] = "Next",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* UART2 Search Previous Button */
+		{
+			.object.id = GUIButtonId_Uart2SearchPrevious,
+			.object.xPos = 650,
+			.object.yPos = 300,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_2,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiSearchFindButtonCallback,
+			.text[0] = "Find:",
+			.text[1] = "Previous",
+			.textSize[0] = LCDFontEnlarge_1x,
+			.textSize[1] = LCDFontEnlarge_1x,
+		},
+		/* UART2 Sidebar backwards button */
+		{
+			.object.id = GUIButtonId_Uart2SidebarBackwards,
+			.object.xPos = 650,
+			.object.yPos = 400,
+			.object.width = 75,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left | GUIBorder_Right,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_All,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_DARK_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_DisabledTouch,
+			.touchCallback = guiUart2SidebarForwardBackwardsButtonsCallback,
+			.text[0] = "<",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* UART2 Sidebar forwards button */
+		{
+			.object.id = GUIButtonId_Uart2SidebarForwards,
+			.object.xPos = 725,
+			.object.yPos = 400,
+			.object.width = 75,
+			.object.height = 50,
+			.object.border = GUIBorder_Top | GUIBorder_Bottom | GUIBorder_Left,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.object.containerPage = GUIContainerPage_All,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_DARK_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Enabled,
+			.touchCallback = guiUart2SidebarForwardBackwardsButtonsCallback,
+			.text[0] = ">",
+			.textSize[0] = LCDFontEnlarge_2x,
+		},
+		/* UART2 4800 bps Button */
+		{
+			.object.id = GUIButtonId_Uart2BaudRate4800,
+			.object.xPos = 500,
+			.object.yPos = 150,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiUart2BaudRateSelectionCallback,
+			.text[0] = "4800 bps",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* UART2 7200 bps Button */
+		{
+			.object.id = GUIButtonId_Uart2BaudRate7200,
+			.object.xPos = 500,
+			.object.yPos = 190,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiUart2BaudRateSelectionCallback,
+			.text[0] = "7200 bps",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* UART2 9600 bps Button */
+		{
+			.object.id = GUIButtonId_Uart2BaudRate9600,
+			.object.xPos = 500,
+			.object.yPos = 230,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiUart2BaudRateSelectionCallback,
+			.text[0] = "9600 bps",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* UART2 19200 bps Button */
+		{
+			.object.id = GUIButtonId_Uart2BaudRate19k2,
+			.object.xPos = 500,
+			.object.yPos = 270,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiUart2BaudRateSelectionCallback,
+			.text[0] = "19200 bps",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* UART2 28800 bps Button */
+		{
+			.object.id = GUIButtonId_Uart2BaudRate28k8,
+			.object.xPos = 500,
+			.object.yPos = 310,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiUart2BaudRateSelectionCallback,
+			.text[0] = "28800 bps",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* UART2 38400 bps Button */
+		{
+			.object.id = GUIButtonId_Uart2BaudRate38k4,
+			.object.xPos = 500,
+			.object.yPos = 350,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiUart2BaudRateSelectionCallback,
+			.text[0] = "38400 bps",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* UART2 57600 bps Button */
+		{
+			.object.id = GUIButtonId_Uart2BaudRate57k6,
+			.object.xPos = 500,
+			.object.yPos = 390,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiUart2BaudRateSelectionCallback,
+			.text[0] = "57600 bps",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* UART2 115200 bps Button */
+		{
+			.object.id = GUIButtonId_Uart2BaudRate115k,
+			.object.xPos = 500,
+			.object.yPos = 430,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiUart2BaudRateSelectionCallback,
+			.text[0] = "115200 bps",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* UART2 Parity None Button */
+		{
+			.object.id = GUIButtonId_Uart2ParityNone,
+			.object.xPos = 500,
+			.object.yPos = 200,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiUart2ParitySelectionCallback,
+			.text[0] = "None",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* UART2 Parity Odd Button */
+		{
+			.object.id = GUIButtonId_Uart2ParityOdd,
+			.object.xPos = 500,
+			.object.yPos = 240,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiUart2ParitySelectionCallback,
+			.text[0] = "Odd",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+		/* UART2 Parity None Button */
+		{
+			.object.id = GUIButtonId_Uart2ParityEven,
+			.object.xPos = 500,
+			.object.yPos = 280,
+			.object.width = 149,
+			.object.height = 40,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.enabledTextColor = GUI_WHITE,
+			.enabledBackgroundColor = GUI_YELLOW,
+			.disabledTextColor = GUI_WHITE,
+			.disabledBackgroundColor = GUI_YELLOW,
+			.pressedTextColor = GUI_YELLOW,
+			.pressedBackgroundColor = GUI_WHITE,
+			.state = GUIButtonState_Disabled,
+			.touchCallback = guiUart2ParitySelectionCallback,
+			.text[0] = "Even",
+			.textSize[0] = LCDFontEnlarge_1x,
+		},
+	};
 
 	/* Containers ----------------------------------------------------------------*/
-	/* Sidebar UART2 container */
-	prvContainer.object.id = GUIContainerId_SidebarUart2;
-	prvContainer.object.xPos = 650;
-	prvContainer.object.yPos = 50;
-	prvContainer.object.width = 150;
-	prvContainer.object.height = 400;
-	prvContainer.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvContainer.object.borderThickness = 1;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.activePage = GUIContainerPage_1;
-	prvContainer.lastPage = GUIContainerPage_2;
-	prvContainer.contentHideState = GUIHideState_KeepBorders;
-	prvContainer.buttons[0] = GUIButton_GetFromId(GUIButtonId_Uart2Enable);
-	prvContainer.buttons[1] = GUIButton_GetFromId(GUIButtonId_Uart2BaudRate);
-	prvContainer.buttons[2] = GUIButton_GetFromId(GUIButtonId_Uart2Parity);
-	prvContainer.buttons[3] = GUIButton_GetFromId(GUIButtonId_Uart2VoltageLevel);
-	prvContainer.buttons[4] = GUIButton_GetFromId(GUIButtonId_Uart2Format);
-	prvContainer.buttons[5] = GUIButton_GetFromId(GUIButtonId_Uart2Clear);
-	prvContainer.buttons[6] = GUIButton_GetFromId(GUIButtonId_Uart2Debug);
-	prvContainer.buttons[7] = GUIButton_GetFromId(GUIButtonId_Uart2SidebarBackwards);
-	prvContainer.buttons[8] = GUIButton_GetFromId(GUIButtonId_Uart2SidebarForwards);
-	prvContainer.textBoxes[0] = GUITextBox_GetFromId(GUITextBoxId_Uart2Label);
-	GUIContainer_Add(&prvContainer);
-
-	/* UART2 baud rate popout container */
-	prvContainer.object.id = GUIContainerId_PopoutUart2BaudRate;
-	prvContainer.object.xPos = 500;
-	prvContainer.object.yPos = 150;
-	prvContainer.object.width = 149;
-	prvContainer.object.height = 320;
-	prvContainer.object.layer = GUILayer_1;
-	prvContainer.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvContainer.object.borderThickness = 2;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.contentHideState = GUIHideState_HideAll;
-	prvContainer.buttons[0] = GUIButton_GetFromId(GUIButtonId_Uart2BaudRate4800);
-	prvContainer.buttons[1] = GUIButton_GetFromId(GUIButtonId_Uart2BaudRate7200);
-	prvContainer.buttons[2] = GUIButton_GetFromId(GUIButtonId_Uart2BaudRate9600);
-	prvContainer.buttons[3] = GUIButton_GetFromId(GUIButtonId_Uart2BaudRate19k2);
-	prvContainer.buttons[4] = GUIButton_GetFromId(GUIButtonId_Uart2BaudRate28k8);
-	prvContainer.buttons[5] = GUIButton_GetFromId(GUIButtonId_Uart2BaudRate38k4);
-	prvContainer.buttons[6] = GUIButton_GetFromId(GUIButtonId_Uart2BaudRate57k6);
-	prvContainer.buttons[7] = GUIButton_GetFromId(GUIButtonId_Uart2BaudRate115k);
-	GUIContainer_Add(&prvContainer);
-
-	/* UART2 parity popout container */
-	prvContainer.object.id = GUIContainerId_PopoutUart2Parity;
-	prvContainer.object.xPos = 500;
-	prvContainer.object.yPos = 200;
-	prvContainer.object.width = 149;
-	prvContainer.object.height = 120;
-	prvContainer.object.layer = GUILayer_1;
-	prvContainer.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom;
-	prvContainer.object.borderThickness = 2;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.contentHideState = GUIHideState_HideAll;
-	prvContainer.buttons[0] = GUIButton_GetFromId(GUIButtonId_Uart2ParityNone);
-	prvContainer.buttons[1] = GUIButton_GetFromId(GUIButtonId_Uart2ParityOdd);
-	prvContainer.buttons[2] = GUIButton_GetFromId(GUIButtonId_Uart2ParityEven);
-	GUIContainer_Add(&prvContainer);
-
-	/* UART2 main container */
-	prvContainer.object.id = GUIContainerId_Uart2MainContent;
-	prvContainer.object.xPos = 0;
-	prvContainer.object.yPos = 50;
-	prvContainer.object.width = 650;
-	prvContainer.object.height = 400;
-	prvContainer.object.containerPage = guiConfigMAIN_CONTAINER_UART2_PAGE;
-	prvContainer.object.border = GUIBorder_Right | GUIBorder_Top;
-	prvContainer.object.borderThickness = 1;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.activePage = GUIContainerPage_1;
-	prvContainer.backgroundColor = GUI_BLACK;
-	prvContainer.contentHideState = GUIHideState_HideAll;
-	prvContainer.textBoxes[0] = GUITextBox_GetFromId(GUITextBoxId_Uart2Main);
-	prvContainer.textBoxes[1] = GUITextBox_GetFromId(GUITextBoxId_Uart2Info);
-	GUIContainer_Add(&prvContainer);
+	static const GUIContainerTemplate containers[] = {
+		/* Sidebar UART2 container */
+		{
+			.object.id = GUIContainerId_SidebarUart2,
+			.object.xPos = 650,
+			.object.yPos = 50,
+			.object.width = 150,
+			.object.height = 400,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.activePage = GUIContainerPage_1,
+			.lastPage = GUIContainerPage_2,
+			.contentHideState = GUIHideState_KeepBorders,
+			.buttons[0] = GUIButtonId_Uart2Enable,
+			.buttons[1] = GUIButtonId_Uart2BaudRate,
+			.buttons[2] = GUIButtonId_Uart2Parity,
+			.buttons[3] = GUIButtonId_Uart2VoltageLevel,
+			.buttons[4] = GUIButtonId_Uart2Format,
+			.buttons[5] = GUIButtonId_Uart2Clear,
+			.buttons[6] = GUIButtonId_Uart2Debug,
+			.buttons[7] = GUIButtonId_Uart2SearchPattern,
+			.buttons[8] = GUIButtonId_Uart2SearchNext,
+			.buttons[9] = GUIButtonId_Uart2SearchPrevious,
+			.buttons[10] = GUIButtonId_Uart2SidebarBackwards,
+			.buttons[11] = GUIButtonId_Uart2SidebarForwards,
+			.textBoxes[0] = GUITextBoxId_Uart2Label,
+		},
+		/* UART2 baud rate popout container */
+		{
+			.object.id = GUIContainerId_PopoutUart2BaudRate,
+			.object.xPos = 500,
+			.object.yPos = 150,
+			.object.width = 149,
+			.object.height = 320,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 2,
+			.object.borderColor = GUI_WHITE,
+			.contentHideState = GUIHideState_HideAll,
+			.buttons[0] = GUIButtonId_Uart2BaudRate4800,
+			.buttons[1] = GUIButtonId_Uart2BaudRate7200,
+			.buttons[2] = GUIButtonId_Uart2BaudRate9600,
+			.buttons[3] = GUIButtonId_Uart2BaudRate19k2,
+			.buttons[4] = GUIButtonId_Uart2BaudRate28k8,
+			.buttons[5] = GUIButtonId_Uart2BaudRate38k4,
+			.buttons[6] = GUIButtonId_Uart2BaudRate57k6,
+			.buttons[7] = GUIButtonId_Uart2BaudRate115k,
+		},
+		/* UART2 parity popout container */
+		{
+			.object.id = GUIContainerId_PopoutUart2Parity,
+			.object.xPos = 500,
+			.object.yPos = 200,
+			.object.width = 149,
+			.object.height = 120,
+			.object.layer = GUILayer_1,
+			.object.border = GUIBorder_Left | GUIBorder_Top | GUIBorder_Bottom,
+			.object.borderThickness = 2,
+			.object.borderColor = GUI_WHITE,
+			.contentHideState = GUIHideState_HideAll,
+			.buttons[0] = GUIButtonId_Uart2ParityNone,
+			.buttons[1] = GUIButtonId_Uart2ParityOdd,
+			.buttons[2] = GUIButtonId_Uart2ParityEven,
+		},
+		/* UART2 main container */
+		{
+			.object.id = GUIContainerId_Uart2MainContent,
+			.object.xPos = 0,
+			.object.yPos = 50,
+			.object.width = 650,
+			.object.height = 400,
+			.object.containerPage = guiConfigMAIN_CONTAINER_UART2_PAGE,
+			.object.border = GUIBorder_Right | GUIBorder_Top,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.activePage = GUIContainerPage_1,
+			.backgroundColor = GUI_BLACK,
+			.contentHideState = GUIHideState_HideAll,
+			.textBoxes[0] = GUITextBoxId_Uart2Main,
+			.textBoxes[1] = GUITextBoxId_Uart2Info,
+		},
+	};
+
+	static const GUILayout layout = {
+		textBoxes, GUI_NUM_OF_OBJECTS(textBoxes),
+		buttons, GUI_NUM_OF_OBJECTS(buttons),
+		containers, GUI_NUM_OF_OBJECTS(containers),
+	};
+	GUI_AddLayout(&layout);
 }
 
 /* Interrupt Handlers --------------------------------------------------------*/
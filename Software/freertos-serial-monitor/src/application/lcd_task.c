@@ -54,19 +54,35 @@
 #include "gui_gpio.h"
 #include "gui_adc.h"
 #include "gui_system.h"
+#include "gui_search.h"
 
 /* Private defines -----------------------------------------------------------*/
+/*
+ * Kinetic scrolling of the main content. Velocities are in 1/256 pixels per frame where a frame is one
+ * period of the main text box refresh timer.
+ */
+#define SCROLL_ROW_HEIGHT		(16)
+#define SCROLL_FRACTION_BITS	(8)
+#define SCROLL_FRICTION_SHIFT	(4)									/* The velocity is reduced by 1/16 every frame */
+#define SCROLL_MIN_VELOCITY		((1 << SCROLL_FRACTION_BITS) / 4)	/* Stop when slower than a quarter pixel per frame */
+#define SCROLL_MAX_VELOCITY		((4 * SCROLL_ROW_HEIGHT) << SCROLL_FRACTION_BITS)
+
 /* Private typedefs ----------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
-static GUITextBox prvTextBox = {0};
-static GUIButton prvButton = {0};
-static GUIContainer prvContainer = {0};
 static uint32_t prvIdOfLastActiveSidebar = guiConfigINVALID_ID;
 static uint32_t prvIdOfActiveSidebar = GUIContainerId_SidebarEmpty;
 static bool prvDebugConsoleIsHidden = false;
 static float prvTemperature = 0.0;
 
+/*
+ * Scroll state, written by the touch handling in the LCD task and by the refresh timer in the timer task so
+ * it's only changed inside a critical section
+ */
 static int32_t prvMainContainerYPosOffset = 0;
+static int32_t prvTouchYDeltaSinceLastFrame = 0;
+static int32_t prvScrollVelocity = 0;
+static int32_t prvScrollFraction = 0;
+static bool prvMainContentIsTouched = false;
 static bool prvActiveChannelHasChanged = false;
 static bool prvForceRefresh = false;
 
@@ -74,12 +90,16 @@ static xTimerHandle prvMainTextBoxRefreshTimer;
 
 /* Private function prototypes -----------------------------------------------*/
 static void prvMainContainerRefreshTimerCallback();
+static void prvUpdateKineticScroll();
+static void prvStopKineticScroll();
 static void prvManageEmptyMainTextBox(bool ShouldRefresh);
 
 static void prvHardwareInit();
+static void prvCheckAllActiveForTouchEventAt(GUITouchEvent Event, uint16_t XPos, uint16_t YPos);
 static void prvMainContentContainerCallback(GUITouchEvent Event, uint16_t XPos, uint16_t YPos);
 static bool prvAllChanneAreDoneInitializing();
 static void prvInitGuiElements();
+static void prvInitSidebarGuiElements(uint32_t SidebarId);
 static void prvSplashScreen();
 
 /* Functions -----------------------------------------------------------------*/
@@ -105,7 +125,7 @@ void lcdTask(void *pvParameters)
 	/* Initialize the GUI elements */
 	prvInitGuiElements();
 
-	xLCDEventQueue = xQueueCreate(10, sizeof(LCDEventMessage));
+	xLCDEventQueue = xQueueCreate(LCD_EVENT_QUEUE_SIZE, sizeof(LCDEventMessage));
 	if (xLCDEventQueue == 0)
 	{
 		// Queue was not created and must not be used.
@@ -135,8 +155,11 @@ void lcdTask(void *pvParameters)
 			{
 				/* New touch data received */
 				case LCDEvent_TouchEvent:
-					if (receivedMessage.data[3] == FT5206Point_1)
+					if (MESSAGES_TOUCH_POINT(receivedMessage.data[1]) == FT5206Point_1)
 					{
+						uint16_t xPos = MESSAGES_TOUCH_X(receivedMessage.data[0]);
+						uint16_t yPos = MESSAGES_TOUCH_Y(receivedMessage.data[0]);
+
 #if 0
 						/* DEBUG */
 						if (GUI_GetDisplayStateForTextBox(GUITextBoxId_Debug) == GUIDisplayState_NotHidden)
@@ -144,11 +167,11 @@ void lcdTask(void *pvParameters)
 							GUITextBox_SetWritePosition(GUITextBoxId_Debug, 5, 5);
 							GUITextBox_Clear(GUITextBoxId_Debug);
 							GUITextBox_WriteString(GUITextBoxId_Debug, "X:");
-							GUITextBox_WriteNumber(GUITextBoxId_Debug, receivedMessage.data[0]);
+							GUITextBox_WriteNumber(GUITextBoxId_Debug, xPos);
 							GUITextBox_WriteString(GUITextBoxId_Debug, ", Y:");
-							GUITextBox_WriteNumber(GUITextBoxId_Debug, receivedMessage.data[1]);
+							GUITextBox_WriteNumber(GUITextBoxId_Debug, yPos);
 							GUITextBox_WriteString(GUITextBoxId_Debug, ", EVENT:");
-							GUITextBox_WriteNumber(GUITextBoxId_Debug, receivedMessage.data[2]);
+							GUITextBox_WriteNumber(GUITextBoxId_Debug, MESSAGES_TOUCH_EVENT(receivedMessage.data[1]));
 						}
 #endif
 
@@ -157,24 +180,26 @@ void lcdTask(void *pvParameters)
 						if (!prvDebugConsoleIsHidden)
 						{
 							LCD_SetForegroundColor(LCD_COLOR_GREEN);
-							LCD_DrawCircle(receivedMessage.data[0], receivedMessage.data[1], 2, 1);
+							LCD_DrawCircle(xPos, yPos, 2, 1);
 						}
 #endif
 
-						GUITouchEvent touchEvent;
-						if (receivedMessage.data[2] == FT5206Event_PutUp)
-							touchEvent = GUITouchEvent_Up;
-						else if (receivedMessage.data[2] == FT5206Event_PutDown)
-							touchEvent = GUITouchEvent_Down;
-						/* Check all buttons */
-						GUIButton_CheckAllActiveForTouchEventAt(touchEvent, receivedMessage.data[0], receivedMessage.data[1]);
-						/* Check all text boxes */
-						GUITextBox_CheckAllActiveForTouchEventAt(touchEvent, receivedMessage.data[0], receivedMessage.data[1]);
-						/* Check all containers */
-						GUIContainer_CheckAllActiveForTouchEventAt(touchEvent, receivedMessage.data[0], receivedMessage.data[1]);
+						if (MESSAGES_TOUCH_EVENT(receivedMessage.data[1]) == FT5206Event_PutUp)
+							prvCheckAllActiveForTouchEventAt(GUITouchEvent_Up, xPos, yPos);
+						else
+							prvCheckAllActiveForTouchEventAt(GUITouchEvent_Down, xPos, yPos);
 					}
 					break;
 
+				/* The finger has moved, all moves since the last message are merged into the latest position */
+				case LCDEvent_TouchMove:
+				{
+					FT5206TouchCoordinate position;
+					if (FT5206_GetPendingMove(receivedMessage.data[0], &position))
+						prvCheckAllActiveForTouchEventAt(GUITouchEvent_Down, position.x, position.y);
+					break;
+				}
+
 				/* New temperature data received */
 				case LCDEvent_TemperatureData:
 					memcpy(&prvTemperature, receivedMessage.data, sizeof(float));
@@ -205,6 +230,9 @@ void lcdTask(void *pvParameters)
 //			HAL_GPIO_TogglePin(GPIOC, GPIO_PIN_2);
 			/* Do something else */
 		}
+
+		/* Draw everything that has changed while handling the events */
+		GUI_RedrawDirtyRegions();
 	}
 }
 
@@ -276,6 +304,9 @@ void lcdManageGenericUartMainTextBox(const uint32_t constStartFlashAddress, uint
 			GUITextBox_RefreshCurrentDataFromMemory(TextBoxId);
 		}
 
+		/* Jump to where the scrollbar or the minimap was touched or to where a search found a match */
+		GUITextBox_MoveDisplayedDataToPendingPosition(TextBoxId);
+
 		uint32_t readEndAddress = GUITextBox_GetReadEndAddress(TextBoxId);
 		/* New data has been written that we have not displayed yet */
 		if (readEndAddress != 0 && readEndAddress < currentWriteAddress)
@@ -293,15 +324,28 @@ void lcdManageGenericUartMainTextBox(const uint32_t constStartFlashAddress, uint
 		}
 
 		/* Get how many rows the offset equals */
-		int32_t rowDiff = prvMainContainerYPosOffset / 16;
-
-		/* Manage offset caused by scrolling */
-		if (prvMainContainerYPosOffset != 0 && rowDiff != 0)
+		taskENTER_CRITICAL();
+		int32_t rowDiff = prvMainContainerYPosOffset / SCROLL_ROW_HEIGHT;
+		taskEXIT_CRITICAL();
+
+		/*
+		 * Manage offset caused by scrolling, all rows for this frame are moved at once so the flash is
+		 * only read one time per frame
+		 */
+		if (rowDiff != 0)
 		{
-			GUITextBox_MoveDisplayedDataNumOfRows(TextBoxId, rowDiff);
-
-			/* Set it to 0 now that we have managed it */
-			prvMainContainerYPosOffset = 0;
+			if (GUITextBox_MoveDisplayedDataNumOfRows(TextBoxId, rowDiff) == GUIErrorStatus_Success)
+			{
+				/* Keep the part of a row that has not been moved yet and what was added by touches during the move */
+				taskENTER_CRITICAL();
+				prvMainContainerYPosOffset -= rowDiff * SCROLL_ROW_HEIGHT;
+				taskEXIT_CRITICAL();
+			}
+			else
+			{
+				/* We can't move any further in this direction */
+				prvStopKineticScroll();
+			}
 		}
 
 #if 0
@@ -340,6 +384,7 @@ void lcdChangeDisplayStateOfSidebar(uint32_t SidebarId)
 	{
 		/* Hide the active sidebar and display this sidebar instead */
 		GUIContainer_Hide(prvIdOfActiveSidebar);
+		prvInitSidebarGuiElements(SidebarId);
 		GUIContainer_Draw(SidebarId);
 		/* Save the old active sidebar and set this sidebar as the new active one */
 		prvIdOfLastActiveSidebar = prvIdOfActiveSidebar;
@@ -377,10 +422,14 @@ static void prvMainContainerRefreshTimerCallback()
 
 	bool shouldRefresh = false;
 
+	/* Every timer period is one frame for the scrolling */
+	prvUpdateKineticScroll();
+
 	/* Check if a new channel has been selected */
 	if (prvActiveChannelHasChanged)
 	{
 		prvActiveChannelHasChanged = false;
+		prvStopKineticScroll();
 
 		switch (prvIdOfActiveSidebar)
 		{
@@ -448,6 +497,65 @@ static void prvMainContainerRefreshTimerCallback()
 	{
 		activeManageFunction(shouldRefresh);
 	}
+
+	/* Search a bit more if a search is running */
+	guiSearchManage();
+}
+
+/**
+ * @brief	Updates the scroll offset for one frame
+ * @param	None
+ * @retval	None
+ * @note	While the main content is touched the velocity follows the finger. When it's released the
+ * 			offset keeps moving with the last velocity which is reduced every frame until it stops.
+ */
+static void prvUpdateKineticScroll()
+{
+	taskENTER_CRITICAL();
+
+	if (prvMainContentIsTouched)
+	{
+		/* Smooth the velocity over a few frames */
+		int32_t delta = prvTouchYDeltaSinceLastFrame;
+		prvTouchYDeltaSinceLastFrame = 0;
+		prvScrollVelocity += ((delta << SCROLL_FRACTION_BITS) - prvScrollVelocity) / 2;
+	}
+	else if (prvScrollVelocity != 0)
+	{
+		prvScrollFraction += prvScrollVelocity;
+		int32_t pixels = prvScrollFraction / (1 << SCROLL_FRACTION_BITS);
+		prvScrollFraction -= pixels * (1 << SCROLL_FRACTION_BITS);
+		prvMainContainerYPosOffset += pixels;
+
+		prvScrollVelocity -= prvScrollVelocity / (1 << SCROLL_FRICTION_SHIFT);
+		if (prvScrollVelocity < SCROLL_MIN_VELOCITY && prvScrollVelocity > -SCROLL_MIN_VELOCITY)
+		{
+			prvScrollVelocity = 0;
+			prvScrollFraction = 0;
+		}
+	}
+
+	/* Limit the speed so a fast flick doesn't skip through the data */
+	if (prvScrollVelocity > SCROLL_MAX_VELOCITY)
+		prvScrollVelocity = SCROLL_MAX_VELOCITY;
+	else if (prvScrollVelocity < -SCROLL_MAX_VELOCITY)
+		prvScrollVelocity = -SCROLL_MAX_VELOCITY;
+
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief	Stops the scrolling and throws away any offset that has not been managed
+ * @param	None
+ * @retval	None
+ */
+static void prvStopKineticScroll()
+{
+	taskENTER_CRITICAL();
+	prvScrollVelocity = 0;
+	prvScrollFraction = 0;
+	prvMainContainerYPosOffset = 0;
+	taskEXIT_CRITICAL();
 }
 
 /**
@@ -480,6 +588,27 @@ static void prvHardwareInit()
 	BUZZER_BeepNumOfTimes(1);
 }
 
+/**
+ * @brief	Check all active GUI objects for a touch event
+ * @param	Event: The touch event
+ * @param	XPos: The X coordinate for the event
+ * @param	YPos: The Y coordinate for the event
+ * @retval	None
+ */
+static void prvCheckAllActiveForTouchEventAt(GUITouchEvent Event, uint16_t XPos, uint16_t YPos)
+{
+	/* Check all buttons */
+	GUIButton_CheckAllActiveForTouchEventAt(Event, XPos, YPos);
+	/* Check all text boxes, a touch on a scrollbar moves the data directly so it's not passed on to the containers */
+	if (GUITextBox_CheckAllActiveForTouchEventAt(Event, XPos, YPos))
+	{
+		prvStopKineticScroll();
+		return;
+	}
+	/* Check all containers */
+	GUIContainer_CheckAllActiveForTouchEventAt(Event, XPos, YPos);
+}
+
 /**
  * @brief	Callback for the main content container
  * @param	Event: The event that caused the callback
@@ -497,7 +626,13 @@ static void prvMainContentContainerCallback(GUITouchEvent Event, uint16_t XPos,
 	{
 		/* Update the delta one last time */
 		yDelta =  YPos - lastYValue;
+		taskENTER_CRITICAL();
 		prvMainContainerYPosOffset += yDelta;
+		prvTouchYDeltaSinceLastFrame += yDelta;
+
+		/* Let the content keep moving with the current velocity */
+		prvMainContentIsTouched = false;
+		taskEXIT_CRITICAL();
 
 		lastYValue = 0;
 		lastEvent = GUITouchEvent_Up;
@@ -508,12 +643,23 @@ static void prvMainContentContainerCallback(GUITouchEvent Event, uint16_t XPos,
 		if (lastEvent == GUITouchEvent_Up)
 		{
 			lastYValue = YPos;
+
+			/* Touching the content stops any ongoing scroll */
+			taskENTER_CRITICAL();
+			prvScrollVelocity = 0;
+			prvScrollFraction = 0;
+			prvTouchYDeltaSinceLastFrame = 0;
+			prvMainContentIsTouched = true;
+			taskEXIT_CRITICAL();
 		}
 		else
 		{
 			/* Update the delta */
 			yDelta =  YPos - lastYValue;
+			taskENTER_CRITICAL();
 			prvMainContainerYPosOffset += yDelta;
+			prvTouchYDeltaSinceLastFrame += yDelta;
+			taskEXIT_CRITICAL();
 			lastYValue = YPos;
 		}
 
@@ -564,23 +710,18 @@ static void prvInitGuiElements()
 
 	/* CAN1 */
 	guiCan1InitGuiElements();
-	guiCan1UpdateGuiElementsReadFromSettings();
 
 	/* CAN2 */
 	guiCan2InitGuiElements();
-	guiCan2UpdateGuiElementsReadFromSettings();
 
 	/* UART1 */
 	guiUart1InitGuiElements();
-	guiUart1UpdateGuiElementsReadFromSettings();
 
 	/* UART2 */
 	guiUart2InitGuiElements();
-	guiUart2UpdateGuiElementsReadFromSettings();
 
 	/* RS232 */
 	guiRs232InitGuiElements();
-	guiRs232UpdateGuiElementsReadFromSettings();
 
 	/* GPIO */
 	guiGpioInitGuiElements();
@@ -591,97 +732,114 @@ static void prvInitGuiElements()
 	/* System */
 	guiSystemInitGuiElements();
 
+	/* Search */
+	guiSearchInitGuiElements();
+
 
 	/* Text boxes ----------------------------------------------------------------*/
-	/* Main text box */
-	prvTextBox.object.id = GUITextBoxId_Main;
-	prvTextBox.object.xPos = 0;
-	prvTextBox.object.yPos = 50;
-	prvTextBox.object.width = 650;
-	prvTextBox.object.height = 400;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = LCD_COLOR_BLACK;
-	prvTextBox.textSize = LCDFontEnlarge_1x;
-	prvTextBox.xWritePos = 0;
-	prvTextBox.yWritePos = 0;
-	GUITextBox_Add(&prvTextBox);
-
-//	/* Clock Text Box */
-//	prvTextBox.object.id = GUITextBoxId_Clock;
-//	prvTextBox.object.xPos = 650;
-//	prvTextBox.object.yPos = 0;
-//	prvTextBox.object.width = 150;
-//	prvTextBox.object.height = 25;
-//	prvTextBox.textColor = GUI_WHITE;
-//	prvTextBox.backgroundColor = LCD_COLOR_BLACK;
-//	prvTextBox.textSize = LCDFontEnlarge_1x;
-//	prvTextBox.xWritePos = 50;
-//	prvTextBox.yWritePos = 3;
-//	GUITextBox_Add(&prvTextBox);
-
-	/* Serial Monitor Text Box */
-	prvTextBox.object.id = GUITextBoxId_SerialMonitor;
-	prvTextBox.object.xPos = 650;
-	prvTextBox.object.yPos = 0;
-	prvTextBox.object.width = 150;
-	prvTextBox.object.height = 25;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = LCD_COLOR_BLACK;
-	prvTextBox.textSize = LCDFontEnlarge_1x;
-	prvTextBox.staticText = "Serial Monitor";
-	GUITextBox_Add(&prvTextBox);
-
-	/* Temperature Text Box */
-	prvTextBox.object.id = GUITextBoxId_Temperature;
-	prvTextBox.object.xPos = 651;
-	prvTextBox.object.yPos = 25;
-	prvTextBox.object.width = 149;
-	prvTextBox.object.height = 24;
-	prvTextBox.textColor = GUI_WHITE;
-	prvTextBox.backgroundColor = LCD_COLOR_BLACK;
-	prvTextBox.textSize = LCDFontEnlarge_1x;
-	prvTextBox.xWritePos = 50;
-	prvTextBox.yWritePos = 3;
-	GUITextBox_Add(&prvTextBox);
+	static const GUITextBox textBoxes[] = {
+		/* Main text box */
+		{
+			.object.id = GUITextBoxId_Main,
+			.object.xPos = 0,
+			.object.yPos = 50,
+			.object.width = 650,
+			.object.height = 400,
+			.textColor = GUI_WHITE,
+			.backgroundColor = LCD_COLOR_BLACK,
+			.textSize = LCDFontEnlarge_1x,
+			.xWritePos = 0,
+			.yWritePos = 0,
+		},
+//		/* Clock Text Box */
+//		{
+//			.object.id = GUITextBoxId_Clock,
+//			.object.xPos = 650,
+//			.object.yPos = 0,
+//			.object.width = 150,
+//			.object.height = 25,
+//			.textColor = GUI_WHITE,
+//			.backgroundColor = LCD_COLOR_BLACK,
+//			.textSize = LCDFontEnlarge_1x,
+//			.xWritePos = 50,
+//			.yWritePos = 3,
+//		},
+		/* Serial Monitor Text Box */
+		{
+			.object.id = GUITextBoxId_SerialMonitor,
+			.object.xPos = 650,
+			.object.yPos = 0,
+			.object.width = 150,
+			.object.height = 25,
+			.textColor = GUI_WHITE,
+			.backgroundColor = LCD_COLOR_BLACK,
+			.textSize = LCDFontEnlarge_1x,
+			.staticText = "Serial Monitor",
+		},
+		/* Temperature Text Box */
+		{
+			.object.id = GUITextBoxId_Temperature,
+			.object.xPos = 651,
+			.object.yPos = 25,
+			.object.width = 149,
+			.object.height = 24,
+			.textColor = GUI_WHITE,
+			.backgroundColor = LCD_COLOR_BLACK,
+			.textSize = LCDFontEnlarge_1x,
+			.xWritePos = 50,
+			.yWritePos = 3,
+		},
+	};
 
 	/* Buttons -------------------------------------------------------------------*/
 
 	/* Containers ----------------------------------------------------------------*/
-	/* Main content container */
-	prvContainer.object.id = GUIContainerId_MainContent;
-	prvContainer.object.xPos = 0;
-	prvContainer.object.yPos = 50;
-	prvContainer.object.width = 650;
-	prvContainer.object.height = 400;
-	prvContainer.object.border = GUIBorder_Right | GUIBorder_Top;
-	prvContainer.object.borderThickness = 1;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.contentHideState = GUIHideState_KeepBorders;
-	prvContainer.activePage = guiConfigMAIN_CONTAINER_EMPTY_PAGE;
-	prvContainer.containers[0] = GUIContainer_GetFromId(GUIContainerId_Can2MainContent);
-	prvContainer.containers[1] = GUIContainer_GetFromId(GUIContainerId_Uart1MainContent);
-	prvContainer.containers[2] = GUIContainer_GetFromId(GUIContainerId_Uart2MainContent);
-	prvContainer.containers[3] = GUIContainer_GetFromId(GUIContainerId_Rs232MainContent);
-	prvContainer.containers[4] = GUIContainer_GetFromId(GUIContainerId_Gpio0MainContent);
-	prvContainer.containers[5] = GUIContainer_GetFromId(GUIContainerId_Gpio1MainContent);
-	prvContainer.containers[6] = GUIContainer_GetFromId(GUIContainerId_AdcMainContent);
-	prvContainer.touchCallback = prvMainContentContainerCallback;
-	GUIContainer_Add(&prvContainer);
-
-	/* Status info container */
-	prvContainer.object.id = GUIContainerId_Status;
-	prvContainer.object.xPos = 650;
-	prvContainer.object.yPos = 0;
-	prvContainer.object.width = 150;
-	prvContainer.object.height = 50;
-	prvContainer.object.border = GUIBorder_Left | GUIBorder_Bottom;
-	prvContainer.object.borderThickness = 1;
-	prvContainer.object.borderColor = GUI_WHITE;
-	prvContainer.contentHideState = GUIHideState_KeepBorders;
-//	prvContainer.textBoxes[0] = GUITextBox_GetFromId(GUITextBoxId_Clock);
-	prvContainer.textBoxes[0] = GUITextBox_GetFromId(GUITextBoxId_SerialMonitor);
-	prvContainer.textBoxes[1] = GUITextBox_GetFromId(GUITextBoxId_Temperature);
-	GUIContainer_Add(&prvContainer);
+	/* The channel main content is added the first time the sidebar of the channel is shown */
+	static const GUIContainerTemplate containers[] = {
+		/* Main content container */
+		{
+			.object.id = GUIContainerId_MainContent,
+			.object.xPos = 0,
+			.object.yPos = 50,
+			.object.width = 650,
+			.object.height = 400,
+			.object.border = GUIBorder_Right | GUIBorder_Top,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.contentHideState = GUIHideState_KeepBorders,
+			.activePage = guiConfigMAIN_CONTAINER_EMPTY_PAGE,
+			.containers[0] = GUIContainerId_Can2MainContent,
+			.containers[1] = GUIContainerId_Uart1MainContent,
+			.containers[2] = GUIContainerId_Uart2MainContent,
+			.containers[3] = GUIContainerId_Rs232MainContent,
+			.containers[4] = GUIContainerId_Gpio0MainContent,
+			.containers[5] = GUIContainerId_Gpio1MainContent,
+			.containers[6] = GUIContainerId_AdcMainContent,
+			.touchCallback = prvMainContentContainerCallback,
+		},
+		/* Status info container */
+		{
+			.object.id = GUIContainerId_Status,
+			.object.xPos = 650,
+			.object.yPos = 0,
+			.object.width = 150,
+			.object.height = 50,
+			.object.border = GUIBorder_Left | GUIBorder_Bottom,
+			.object.borderThickness = 1,
+			.object.borderColor = GUI_WHITE,
+			.contentHideState = GUIHideState_KeepBorders,
+//			.textBoxes[0] = GUITextBoxId_Clock,
+			.textBoxes[0] = GUITextBoxId_SerialMonitor,
+			.textBoxes[1] = GUITextBoxId_Temperature,
+		},
+	};
+
+	static const GUILayout layout = {
+		textBoxes, GUI_NUM_OF_OBJECTS(textBoxes),
+		0, 0,
+		containers, GUI_NUM_OF_OBJECTS(containers),
+	};
+	GUI_AddLayout(&layout);
 
 	/* Draw the main container */
 	GUIContainer_Draw(GUIContainerId_MainContent);
@@ -694,6 +852,52 @@ static void prvInitGuiElements()
 	prvIdOfActiveSidebar = prvIdOfLastActiveSidebar = GUIContainerId_SidebarEmpty;
 }
 
+/**
+ * @brief	Adds the objects of a sidebar the first time it's shown
+ * @param	SidebarId: The sidebar that is about to be shown
+ * @retval	None
+ */
+static void prvInitSidebarGuiElements(uint32_t SidebarId)
+{
+	if (GUIContainer_IsAdded(SidebarId))
+		return;
+
+	switch (SidebarId)
+	{
+		case GUIContainerId_SidebarSystem:
+			guiSystemInitSidebarGuiElements();
+			break;
+		case GUIContainerId_SidebarCan1:
+			guiCan1InitSidebarGuiElements();
+			guiCan1UpdateGuiElementsReadFromSettings();
+			break;
+		case GUIContainerId_SidebarCan2:
+			guiCan2InitSidebarGuiElements();
+			guiCan2UpdateGuiElementsReadFromSettings();
+			break;
+		case GUIContainerId_SidebarUart1:
+			guiUart1InitSidebarGuiElements();
+			guiUart1UpdateGuiElementsReadFromSettings();
+			break;
+		case GUIContainerId_SidebarUart2:
+			guiUart2InitSidebarGuiElements();
+			guiUart2UpdateGuiElementsReadFromSettings();
+			break;
+		case GUIContainerId_SidebarRs232:
+			guiRs232InitSidebarGuiElements();
+			guiRs232UpdateGuiElementsReadFromSettings();
+			break;
+		case GUIContainerId_SidebarGpio:
+			guiGpioInitSidebarGuiElements();
+			break;
+		case GUIContainerId_SidebarAdc:
+			guiAdcInitSidebarGuiElements();
+			break;
+		default:
+			break;
+	}
+}
+
 /**
  * @brief	Displays the splash screen
  * @param	None
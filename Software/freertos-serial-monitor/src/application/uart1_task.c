@@ -29,6 +29,9 @@
 #include "relay.h"
 #include "spi_flash_memory_map.h"
 #include "spi_flash.h"
+#include "uart_tail.h"
+#include "uart_activity.h"
+#include "uart_summary.h"
 
 #include <string.h>
 #include <stdbool.h>
@@ -40,7 +43,7 @@
 #define UART_RX_PIN		(GPIO_PIN_10)
 #define UART_PORT		(GPIOA)
 
-#define RX_BUFFER_SIZE	(256)
+#define RX_BUFFER_SIZE	(512)
 
 /* Private typedefs ----------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
@@ -98,6 +101,19 @@ static TimerHandle_t prvBuffer2ClearTimer;
 static bool prvDoneInitializing = false;
 static bool prvChannelIsEnabled = false;
 
+/* The newest data for the channel in CCM RAM, it's reset before it's used */
+static UARTTail prvTail __attribute__((section(".bss.CCMRAM")));
+
+/* Summary of how much data has been received over time, also in CCM RAM */
+static UARTActivity prvActivity __attribute__((section(".bss.CCMRAM")));
+/* Blocks are added to the activity in the timer task and the minimap is also read in the LCD task */
+static SemaphoreHandle_t xActivitySemaphore;
+static volatile uint32_t prvNumOfRxErrors = 0;	/* Incremented from the UART interrupt */
+static uint32_t prvNumOfSavedRxErrors = 0;
+
+/* Summary of every saved block used by the search to skip blocks, also in CCM RAM */
+static UARTSummary prvSummary __attribute__((section(".bss.CCMRAM")));
+
 /* Private function prototypes -----------------------------------------------*/
 static void prvHardwareInit();
 static void prvEnableUart1Interface();
@@ -106,6 +122,9 @@ static ErrorStatus prvReadSettingsFromSpiFlash();
 
 static void prvBuffer1ClearTimerCallback();
 static void prvBuffer2ClearTimerCallback();
+static void prvResetActivity(uint32_t Address);
+static void prvSaveActivity(uint32_t NumOfBytes);
+static uint32_t prvNumOfBytesThatFitInFlash(uint32_t NumOfBytes);
 
 /* Functions -----------------------------------------------------------------*/
 /**
@@ -121,6 +140,9 @@ void uart1Task(void *pvParameters)
 	/* Mutex semaphore for accessing the settings for this channel */
 	xSettingsSemaphore = xSemaphoreCreateMutex();
 
+	/* Mutex semaphore for accessing the activity summary */
+	xActivitySemaphore = xSemaphoreCreateMutex();
+
 	/* Create software timers */
 	prvBuffer1ClearTimer = xTimerCreate("Buf1ClearUart1", 10, pdFALSE, 0, prvBuffer1ClearTimerCallback);
 	prvBuffer2ClearTimer = xTimerCreate("Buf2ClearUart1", 10, pdFALSE, 0, prvBuffer2ClearTimerCallback);
@@ -136,6 +158,9 @@ void uart1Task(void *pvParameters)
 
 	/* Try to read the settings from SPI FLASH */
 	prvReadSettingsFromSpiFlash();
+	uartTailReset(&prvTail, prvCurrentSettings.writeAddress);
+	uartSummaryReset(&prvSummary, FLASH_ADR_UART1_DATA, prvCurrentSettings.writeAddress);
+	prvResetActivity(prvCurrentSettings.writeAddress);
 
 	/*
 	 * TODO: Figure out a good way to allow saved data in SPI FLASH to be read next time we wake up so that we
@@ -292,6 +317,9 @@ ErrorStatus uart1Clear()
 	{
 		prvCurrentSettings.writeAddress = FLASH_ADR_UART1_DATA;
 		prvCurrentSettings.amountOfDataSaved = 0;
+		uartTailReset(&prvTail, FLASH_ADR_UART1_DATA);
+		uartSummaryReset(&prvSummary, FLASH_ADR_UART1_DATA, FLASH_ADR_UART1_DATA);
+		prvResetActivity(FLASH_ADR_UART1_DATA);
 
 		/* Clear the FLASH */
 		uart1ClearFlash();
@@ -317,6 +345,52 @@ uint32_t uart1GetCurrentWriteAddress()
 	return prvCurrentSettings.writeAddress;
 }
 
+/**
+ * @brief	Read data that has been saved for the channel, the newest data is read from RAM instead of the FLASH
+ * @param	pBuffer: Pointer to where the data should be stored
+ * @param	ReadAddress: FLASH address to read from
+ * @param	NumByteToRead: Number of bytes to read
+ * @param	BlockTime: ms to wait for the FLASH if the data has to be read from there
+ * @retval	SUCCESS: Everything went ok
+ * @retval	ERROR: Something went wrong
+ */
+ErrorStatus uart1ReadData(uint8_t* pBuffer, uint32_t ReadAddress, uint32_t NumByteToRead, TickType_t BlockTime)
+{
+	if (uartTailRead(&prvTail, pBuffer, ReadAddress, NumByteToRead))
+		return SUCCESS;
+	else
+		return SPI_FLASH_ReadBufferDMA(pBuffer, ReadAddress, NumByteToRead, BlockTime);
+}
+
+/**
+ * @brief	Get the buckets for the activity minimap of the channel
+ * @param	pBuckets: Pointer to where the buckets should be stored
+ * @param	MaxNumOfBuckets: Max number of buckets to get
+ * @retval	The number of buckets
+ */
+uint32_t uart1GetMinimap(GUIMinimapBucket* pBuckets, uint32_t MaxNumOfBuckets)
+{
+	/* The buckets are a snapshot, the timer task can't add a block or merge the levels while they are read */
+	uint32_t numOfBuckets = 0;
+	if (xActivitySemaphore != 0 && xSemaphoreTake(xActivitySemaphore, 100) == pdTRUE)
+	{
+		numOfBuckets = uartActivityGetMinimap(&prvActivity, pBuckets, MaxNumOfBuckets);
+		xSemaphoreGive(xActivitySemaphore);
+	}
+	return numOfBuckets;
+}
+
+/**
+ * @brief	Get the summary of the saved data that the search uses to skip blocks
+ * @param	None
+ * @retval	Pointer to the summary
+ * @note	The summary is updated from the timer task so it should only be used from there
+ */
+UARTSummary* uart1GetSummary()
+{
+	return &prvSummary;
+}
+
 /**
  * @brief	Transmit data
  * @param	Data: Pointer to the buffer to send
@@ -345,6 +419,10 @@ void uart1ClearFlash()
 		if (!SPI_FLASH_SectorIsClean(FLASH_ADR_UART1_DATA + i * 0x10000))
 			SPI_FLASH_EraseSector(FLASH_ADR_UART1_DATA + i * 0x10000);
 	}
+
+	/* The search summaries are in the last sector */
+	if (!SPI_FLASH_SectorIsClean(FLASH_ADR_UART1_DATA + FLASH_CHANNEL_SUMMARY_OFFSET))
+		SPI_FLASH_EraseSector(FLASH_ADR_UART1_DATA + FLASH_CHANNEL_SUMMARY_OFFSET);
 }
 
 /* Private functions .--------------------------------------------------------*/
@@ -471,6 +549,14 @@ static void prvBuffer1ClearTimerCallback()
 	/* Set the buffer to reading state */
 	prvRxBuffer1State = BUFFERState_Reading;
 
+	/* Drop what doesn't fit in the data area of the FLASH */
+	prvRxBuffer1Count = prvNumOfBytesThatFitInFlash(prvRxBuffer1Count);
+
+	/* Keep the newest data in RAM so the live view doesn't have to read it back from the FLASH */
+	uartTailWrite(&prvTail, prvRxBuffer1, prvRxBuffer1Count);
+	uartSummaryAdd(&prvSummary, prvCurrentSettings.writeAddress, prvRxBuffer1, prvRxBuffer1Count);
+	prvSaveActivity(prvRxBuffer1Count);
+
 	/* Write the data to FLASH */
 	for (uint32_t i = 0; i < prvRxBuffer1Count; i++)
 		SPI_FLASH_WriteByte(prvCurrentSettings.writeAddress++, prvRxBuffer1[i]);
@@ -499,6 +585,14 @@ static void prvBuffer2ClearTimerCallback()
 	/* Set the buffer to reading state */
 	prvRxBuffer2State = BUFFERState_Reading;
 
+	/* Drop what doesn't fit in the data area of the FLASH */
+	prvRxBuffer2Count = prvNumOfBytesThatFitInFlash(prvRxBuffer2Count);
+
+	/* Keep the newest data in RAM so the live view doesn't have to read it back from the FLASH */
+	uartTailWrite(&prvTail, prvRxBuffer2, prvRxBuffer2Count);
+	uartSummaryAdd(&prvSummary, prvCurrentSettings.writeAddress, prvRxBuffer2, prvRxBuffer2Count);
+	prvSaveActivity(prvRxBuffer2Count);
+
 	/* Write the data to FLASH */
 	for (uint32_t i = 0; i < prvRxBuffer2Count; i++)
 		SPI_FLASH_WriteByte(prvCurrentSettings.writeAddress++, prvRxBuffer2[i]);
@@ -517,6 +611,53 @@ static void prvBuffer2ClearTimerCallback()
 	prvRxBuffer2State = BUFFERState_Writing;
 }
 
+/**
+ * @brief	Restart the activity summary
+ * @param	Address: The FLASH address the next byte will be written to
+ * @retval	None
+ */
+static void prvResetActivity(uint32_t Address)
+{
+	if (xActivitySemaphore != 0 && xSemaphoreTake(xActivitySemaphore, 100) == pdTRUE)
+	{
+		uartActivityReset(&prvActivity, Address);
+		xSemaphoreGive(xActivitySemaphore);
+	}
+	prvNumOfSavedRxErrors = prvNumOfRxErrors;
+}
+
+/**
+ * @brief	Add a block that is about to be saved to the activity summary together with the errors since the last block
+ * @param	NumOfBytes: Number of bytes in the block, they will be written to the current write address
+ * @retval	None
+ */
+static void prvSaveActivity(uint32_t NumOfBytes)
+{
+	if (xActivitySemaphore != 0 && xSemaphoreTake(xActivitySemaphore, 100) == pdTRUE)
+	{
+		uint32_t numOfRxErrors = prvNumOfRxErrors;
+		uartActivityAdd(&prvActivity, prvCurrentSettings.writeAddress, NumOfBytes, numOfRxErrors - prvNumOfSavedRxErrors);
+		prvNumOfSavedRxErrors = numOfRxErrors;
+		xSemaphoreGive(xActivitySemaphore);
+	}
+}
+
+/**
+ * @brief	Limit a block so it's not written past the data area, the last sector holds the search summaries
+ * @param	NumOfBytes: Number of bytes in the block
+ * @retval	The number of bytes that can be written at the current write address
+ */
+static uint32_t prvNumOfBytesThatFitInFlash(uint32_t NumOfBytes)
+{
+	uint32_t endAddress = FLASH_ADR_UART1_DATA + FLASH_CHANNEL_SUMMARY_OFFSET;
+	if (prvCurrentSettings.writeAddress >= endAddress)
+		return 0;
+	else if (NumOfBytes > endAddress - prvCurrentSettings.writeAddress)
+		return endAddress - prvCurrentSettings.writeAddress;
+	else
+		return NumOfBytes;
+}
+
 /* Interrupt Handlers --------------------------------------------------------*/
 /**
   * @brief  This function handles UART1 interrupt request
@@ -568,6 +709,7 @@ void uart1RxCpltCallback()
 	else
 	{
 		/* No buffer available, something has gone wrong */
+		prvNumOfRxErrors++;
 		HAL_GPIO_TogglePin(GPIOC, GPIO_PIN_3);
 	}
 
@@ -584,7 +726,7 @@ void uart1RxCpltCallback()
   */
  void uart1ErrorCallback()
 {
+	prvNumOfRxErrors++;
 	/* Give back the semaphore now that we are done */
 	xSemaphoreGiveFromISR(xSemaphore, NULL);
-	/* TODO: Indicate error somehow ??? */
 }
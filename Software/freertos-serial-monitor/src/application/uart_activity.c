@@ -0,0 +1,196 @@
+/**
+ ******************************************************************************
+ * @file	uart_activity.c
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-15
+ * @brief	Keeps a summary of how much data a UART channel has received over
+ *			time so that it can be displayed as a minimap.
+ *
+ *			The summary is a small pyramid of levels with a fixed number of
+ *			buckets, every level has buckets that are longer than the one
+ *			below. Adding a flushed block only updates the current bucket on
+ *			every level and reading a level never touches the saved data.
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "uart_activity.h"
+
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define TOP_LEVEL	(UART_ACTIVITY_NUM_OF_LEVELS - 1)
+
+/* Private typedefs ----------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void prvMoveToBucket(UARTActivityLevel* pLevel, uint32_t Bucket, uint32_t Address, bool IsCircular);
+static void prvMergeTopLevel(UARTActivityLevel* pLevel);
+
+/* Functions -----------------------------------------------------------------*/
+/**
+ * @brief	Resets the activity so that it starts from now
+ * @param	pActivity: The activity to reset
+ * @param	Address: The FLASH address the next byte will be written to
+ * @retval	None
+ */
+void uartActivityReset(UARTActivity* pActivity, uint32_t Address)
+{
+	memset(pActivity, 0, sizeof(UARTActivity));
+	pActivity->startTime = xTaskGetTickCount();
+
+	uint32_t bucketTime = UART_ACTIVITY_BUCKET_TIME;
+	for (uint32_t i = 0; i < UART_ACTIVITY_NUM_OF_LEVELS; i++)
+	{
+		pActivity->levels[i].bucketTime = bucketTime;
+		pActivity->levels[i].buckets[0].address = Address;
+		bucketTime *= UART_ACTIVITY_LEVEL_FACTOR;
+	}
+}
+
+/**
+ * @brief	Adds a block of data that has been saved
+ * @param	pActivity: The activity
+ * @param	Address: FLASH address of the first byte in the block
+ * @param	NumOfBytes: Number of bytes in the block
+ * @param	NumOfErrors: Number of receive errors since the last block
+ * @retval	None
+ */
+void uartActivityAdd(UARTActivity* pActivity, uint32_t Address, uint32_t NumOfBytes, uint32_t NumOfErrors)
+{
+	uint32_t time = (xTaskGetTickCount() - pActivity->startTime) * portTICK_PERIOD_MS;
+
+	for (uint32_t i = 0; i < UART_ACTIVITY_NUM_OF_LEVELS; i++)
+	{
+		UARTActivityLevel* level = &pActivity->levels[i];
+		bool isTopLevel = (i == TOP_LEVEL);
+
+		/* The top level must cover everything so make the buckets longer until the time fits */
+		while (isTopLevel && time / level->bucketTime >= UART_ACTIVITY_NUM_OF_BUCKETS)
+			prvMergeTopLevel(level);
+
+		prvMoveToBucket(level, time / level->bucketTime, Address, !isTopLevel);
+
+		UARTActivityBucket* bucket = &level->buckets[level->currentBucket % UART_ACTIVITY_NUM_OF_BUCKETS];
+		bucket->numOfBytes += NumOfBytes;
+		bucket->numOfErrors += NumOfErrors;
+	}
+}
+
+/**
+ * @brief	Get the buckets to display in a minimap, from the oldest to the newest
+ * @param	pActivity: The activity
+ * @param	pBuckets: Pointer to where the buckets should be stored
+ * @param	MaxNumOfBuckets: Max number of buckets to get
+ * @retval	The number of buckets
+ * @note	The lowest level that still has all data from the start is used so the minimap zooms out as the
+ *			capture gets longer
+ */
+uint32_t uartActivityGetMinimap(UARTActivity* pActivity, GUIMinimapBucket* pBuckets, uint32_t MaxNumOfBuckets)
+{
+	UARTActivityLevel* level = &pActivity->levels[TOP_LEVEL];
+	for (uint32_t i = 0; i < TOP_LEVEL; i++)
+	{
+		if (pActivity->levels[i].currentBucket < UART_ACTIVITY_NUM_OF_BUCKETS)
+		{
+			level = &pActivity->levels[i];
+			break;
+		}
+	}
+
+	uint32_t numOfBuckets = level->currentBucket + 1;
+	if (numOfBuckets > UART_ACTIVITY_NUM_OF_BUCKETS)
+		numOfBuckets = UART_ACTIVITY_NUM_OF_BUCKETS;
+	if (numOfBuckets > MaxNumOfBuckets)
+		numOfBuckets = MaxNumOfBuckets;
+
+	/* Scale the activity to the busiest bucket */
+	uint32_t maxNumOfBytes = 1;
+	for (uint32_t i = 0; i < numOfBuckets; i++)
+	{
+		if (level->buckets[i].numOfBytes > maxNumOfBytes)
+			maxNumOfBytes = level->buckets[i].numOfBytes;
+	}
+
+	uint32_t firstBucket = level->currentBucket + 1 - numOfBuckets;
+	for (uint32_t i = 0; i < numOfBuckets; i++)
+	{
+		UARTActivityBucket* bucket = &level->buckets[(firstBucket + i) % UART_ACTIVITY_NUM_OF_BUCKETS];
+		pBuckets[i].activity = (uint64_t)bucket->numOfBytes * 255 / maxNumOfBytes;
+		/* Make sure buckets with only a little data are still visible */
+		if (pBuckets[i].activity == 0 && bucket->numOfBytes != 0)
+			pBuckets[i].activity = 1;
+		pBuckets[i].hasErrors = (bucket->numOfErrors != 0);
+		pBuckets[i].address = bucket->address;
+	}
+
+	return numOfBuckets;
+}
+
+/* Private functions .--------------------------------------------------------*/
+/**
+ * @brief	Moves the current bucket of a level forward and clears the buckets in between
+ * @param	pLevel: The level
+ * @param	Bucket: Number of the bucket to move to
+ * @param	Address: FLASH address to use as the start of the new buckets
+ * @param	IsCircular: true if old buckets should be reused when the end is reached
+ * @retval	None
+ * @note	At most UART_ACTIVITY_NUM_OF_BUCKETS buckets are cleared even after a long time without data
+ */
+static void prvMoveToBucket(UARTActivityLevel* pLevel, uint32_t Bucket, uint32_t Address, bool IsCircular)
+{
+	if (Bucket <= pLevel->currentBucket)
+		return;
+
+	uint32_t firstNewBucket = pLevel->currentBucket + 1;
+	if (IsCircular && Bucket - firstNewBucket >= UART_ACTIVITY_NUM_OF_BUCKETS)
+		firstNewBucket = Bucket - UART_ACTIVITY_NUM_OF_BUCKETS + 1;
+
+	for (uint32_t i = firstNewBucket; i <= Bucket; i++)
+	{
+		UARTActivityBucket* bucket = &pLevel->buckets[i % UART_ACTIVITY_NUM_OF_BUCKETS];
+		bucket->address = Address;
+		bucket->numOfBytes = 0;
+		bucket->numOfErrors = 0;
+	}
+	pLevel->currentBucket = Bucket;
+}
+
+/**
+ * @brief	Merges every pair of buckets on the top level so it covers twice the time
+ * @param	pLevel: The level
+ * @retval	None
+ */
+static void prvMergeTopLevel(UARTActivityLevel* pLevel)
+{
+	for (uint32_t i = 0; i < UART_ACTIVITY_NUM_OF_BUCKETS / 2; i++)
+	{
+		UARTActivityBucket* first = &pLevel->buckets[2*i];
+		UARTActivityBucket* second = &pLevel->buckets[2*i + 1];
+		pLevel->buckets[i].address = first->address;
+		pLevel->buckets[i].numOfBytes = first->numOfBytes + second->numOfBytes;
+		pLevel->buckets[i].numOfErrors = first->numOfErrors + second->numOfErrors;
+	}
+	memset(&pLevel->buckets[UART_ACTIVITY_NUM_OF_BUCKETS / 2], 0, sizeof(UARTActivityBucket) * UART_ACTIVITY_NUM_OF_BUCKETS / 2);
+
+	pLevel->currentBucket /= 2;
+	pLevel->bucketTime *= 2;
+}
+
+/* Interrupt Handlers --------------------------------------------------------*/
@@ -0,0 +1,413 @@
+/**
+ ******************************************************************************
+ * @file	uart_search.c
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-16
+ * @brief	Search for a pattern in the data saved for a channel.
+ *
+ *			The data is read in blocks and searched with Boyer-Moore-Horspool
+ *			so most bytes are never compared. The search is done a few blocks
+ *			at a time by calling uartSearchContinue so that the caller can
+ *			keep doing other things and show the progress in between.
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "uart_search.h"
+
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+/* Private typedefs ----------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static int32_t prvHexValue(uint8_t Character);
+static int32_t prvFindFirst(UARTSearch* pSearch, const uint8_t* pData, uint32_t Size);
+static int32_t prvFindLast(UARTSearch* pSearch, const uint8_t* pData, uint32_t Size);
+static void prvSearchNextBlockForward(UARTSearch* pSearch);
+static void prvSearchNextBlockBackward(UARTSearch* pSearch);
+
+/* Functions -----------------------------------------------------------------*/
+/**
+ * @brief	Set the pattern to search for
+ * @param	pSearch: The search
+ * @param	pPattern: The bytes to search for
+ * @param	Size: Number of bytes in the pattern
+ * @retval	SUCCESS: Everything went ok
+ * @retval	ERROR: The pattern is empty or too long
+ */
+ErrorStatus uartSearchSetPattern(UARTSearch* pSearch, const uint8_t* pPattern, uint32_t Size)
+{
+	if (Size == 0 || Size > UART_SEARCH_MAX_PATTERN_SIZE)
+		return ERROR;
+
+	memcpy(pSearch->pattern, pPattern, Size);
+	pSearch->patternSize = Size;
+	pSearch->state = UARTSearchState_Idle;
+
+	/*
+	 * Forward: how far the pattern can move when a byte is under the last pattern position.
+	 * Backward: the same but for a byte under the first pattern position when moving towards lower addresses.
+	 */
+	memset(pSearch->forwardShift, Size, sizeof(pSearch->forwardShift));
+	memset(pSearch->backwardShift, Size, sizeof(pSearch->backwardShift));
+	for (uint32_t i = 0; i < Size - 1; i++)
+		pSearch->forwardShift[pPattern[i]] = Size - 1 - i;
+	for (uint32_t i = Size - 1; i > 0; i--)
+		pSearch->backwardShift[pPattern[i]] = i;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief	Set the pattern to search for from a string
+ * @param	pSearch: The search
+ * @param	pString: Null-terminated string with the pattern
+ * @param	Format: How the string should be interpreted, can be any value of UARTSearchPatternFormat
+ * @retval	SUCCESS: Everything went ok
+ * @retval	ERROR: The string is not a valid pattern
+ */
+ErrorStatus uartSearchSetPatternFromString(UARTSearch* pSearch, const uint8_t* pString, UARTSearchPatternFormat Format)
+{
+	if (Format == UARTSearchPatternFormat_Ascii)
+		return uartSearchSetPattern(pSearch, pString, strlen((const char*)pString));
+
+	uint8_t pattern[UART_SEARCH_MAX_PATTERN_SIZE];
+	uint32_t size = 0;
+	int32_t highNibble = -1;
+	for (; *pString != 0; pString++)
+	{
+		if (*pString == ' ')
+			continue;
+
+		int32_t value = prvHexValue(*pString);
+		if (value < 0)
+			return ERROR;
+
+		if (highNibble < 0)
+			highNibble = value;
+		else
+		{
+			if (size == UART_SEARCH_MAX_PATTERN_SIZE)
+				return ERROR;
+			pattern[size++] = (highNibble << 4) | value;
+			highNibble = -1;
+		}
+	}
+
+	/* Every byte needs two digits */
+	if (highNibble >= 0)
+		return ERROR;
+
+	return uartSearchSetPattern(pSearch, pattern, size);
+}
+
+/**
+ * @brief	Start a new search
+ * @param	pSearch: The search, the pattern must have been set
+ * @param	ReadFunction: Function used to read the data
+ * @param	pSummary: Summary of the data used to skip blocks, can be 0
+ * @param	MinAddress: Address of the first byte that can be searched
+ * @param	EndAddress: Address after the last byte that can be searched
+ * @param	FromAddress: Forward: the first match that can be found starts here,
+ *			backward: the last match that can be found starts before this
+ * @param	Direction: Direction to search in, can be any value of UARTSearchDirection
+ * @retval	None
+ */
+void uartSearchStart(UARTSearch* pSearch, ErrorStatus (*ReadFunction)(uint8_t*, uint32_t, uint32_t, TickType_t),
+					 UARTSummary* pSummary, uint32_t MinAddress, uint32_t EndAddress, uint32_t FromAddress,
+					 UARTSearchDirection Direction)
+{
+	if (pSearch->patternSize == 0)
+	{
+		pSearch->state = UARTSearchState_Error;
+		return;
+	}
+
+	if (FromAddress < MinAddress)
+		FromAddress = MinAddress;
+	if (FromAddress > EndAddress)
+		FromAddress = EndAddress;
+
+	pSearch->readFunction = ReadFunction;
+	pSearch->minAddress = MinAddress;
+	pSearch->endAddress = EndAddress;
+	pSearch->direction = Direction;
+	pSearch->numOfBytesSearched = 0;
+	pSearch->numOfBytesSkipped = 0;
+	pSearch->summary = pSummary;
+	if (pSummary != 0)
+		uartSummaryQueryInit(&pSearch->query, pSearch->pattern, pSearch->patternSize);
+
+	if (Direction == UARTSearchDirection_Forward)
+	{
+		pSearch->nextAddress = FromAddress;
+		pSearch->numOfBytesToSearch = EndAddress - FromAddress;
+	}
+	else
+	{
+		/* A match starting right before the from address ends this far into the data */
+		pSearch->nextAddress = FromAddress + pSearch->patternSize - 1;
+		if (pSearch->nextAddress > EndAddress)
+			pSearch->nextAddress = EndAddress;
+		pSearch->numOfBytesToSearch = pSearch->nextAddress - MinAddress;
+	}
+
+	pSearch->state = UARTSearchState_Searching;
+}
+
+/**
+ * @brief	Search some more blocks
+ * @param	pSearch: The search
+ * @param	MaxNumOfBlocks: Max number of blocks to read before returning
+ * @retval	The state of the search, UARTSearchState_Searching if it has not finished yet
+ */
+UARTSearchState uartSearchContinue(UARTSearch* pSearch, uint32_t MaxNumOfBlocks)
+{
+	for (uint32_t i = 0; i < MaxNumOfBlocks && pSearch->state == UARTSearchState_Searching; i++)
+	{
+		if (pSearch->direction == UARTSearchDirection_Forward)
+			prvSearchNextBlockForward(pSearch);
+		else
+			prvSearchNextBlockBackward(pSearch);
+	}
+
+	return pSearch->state;
+}
+
+/**
+ * @brief	Stop the search if it's running
+ * @param	pSearch: The search
+ * @retval	None
+ */
+void uartSearchStop(UARTSearch* pSearch)
+{
+	if (pSearch->state == UARTSearchState_Searching)
+		pSearch->state = UARTSearchState_Idle;
+}
+
+/**
+ * @brief	Get the state of a search
+ * @param	pSearch: The search
+ * @retval	The state
+ */
+UARTSearchState uartSearchGetState(UARTSearch* pSearch)
+{
+	return pSearch->state;
+}
+
+/**
+ * @brief	Get the address of the last match
+ * @param	pSearch: The search
+ * @retval	The address, only valid when the state is UARTSearchState_Found
+ */
+uint32_t uartSearchGetMatchAddress(UARTSearch* pSearch)
+{
+	return pSearch->matchAddress;
+}
+
+/**
+ * @brief	Get how far a search has come
+ * @param	pSearch: The search
+ * @retval	0 to 100 %
+ */
+uint32_t uartSearchGetProgress(UARTSearch* pSearch)
+{
+	if (pSearch->numOfBytesToSearch == 0 || pSearch->state != UARTSearchState_Searching)
+		return 100;
+	else
+		return (uint64_t)pSearch->numOfBytesSearched * 100 / pSearch->numOfBytesToSearch;
+}
+
+/**
+ * @brief	Get how much of the searched data was skipped with the help of the summary
+ * @param	pSearch: The search
+ * @retval	0 to 100 %
+ */
+uint32_t uartSearchGetSkippedPercentage(UARTSearch* pSearch)
+{
+	if (pSearch->numOfBytesSearched == 0)
+		return 0;
+	else
+		return (uint64_t)pSearch->numOfBytesSkipped * 100 / pSearch->numOfBytesSearched;
+}
+
+/* Private functions .--------------------------------------------------------*/
+/**
+ * @brief	Get the value of a hex digit
+ * @param	Character: The digit
+ * @retval	The value or -1 if it's not a hex digit
+ */
+static int32_t prvHexValue(uint8_t Character)
+{
+	if (Character >= '0' && Character <= '9')
+		return Character - '0';
+	else if (Character >= 'A' && Character <= 'F')
+		return Character - 'A' + 10;
+	else if (Character >= 'a' && Character <= 'f')
+		return Character - 'a' + 10;
+	else
+		return -1;
+}
+
+/**
+ * @brief	Find the first match in a buffer
+ * @param	pSearch: The search
+ * @param	pData: The buffer
+ * @param	Size: Size of the buffer
+ * @retval	Index of the match or -1 if there's no match
+ */
+static int32_t prvFindFirst(UARTSearch* pSearch, const uint8_t* pData, uint32_t Size)
+{
+	const uint32_t last = pSearch->patternSize - 1;
+
+	for (uint32_t i = 0; i + last < Size; i += pSearch->forwardShift[pData[i + last]])
+	{
+		if (pData[i + last] == pSearch->pattern[last] && memcmp(&pData[i], pSearch->pattern, last) == 0)
+			return i;
+	}
+	return -1;
+}
+
+/**
+ * @brief	Find the last match in a buffer
+ * @param	pSearch: The search
+ * @param	pData: The buffer
+ * @param	Size: Size of the buffer
+ * @retval	Index of the match or -1 if there's no match
+ */
+static int32_t prvFindLast(UARTSearch* pSearch, const uint8_t* pData, uint32_t Size)
+{
+	if (Size < pSearch->patternSize)
+		return -1;
+
+	for (int32_t i = Size - pSearch->patternSize; i >= 0; i -= pSearch->backwardShift[pData[i]])
+	{
+		if (pData[i] == pSearch->pattern[0] && memcmp(&pData[i + 1], &pSearch->pattern[1], pSearch->patternSize - 1) == 0)
+			return i;
+	}
+	return -1;
+}
+
+/**
+ * @brief	Read and search the next block towards higher addresses
+ * @param	pSearch: The search
+ * @retval	None
+ * @note	The block is read together with the first bytes of the block after it so a match starting at the end
+ *			of the block is found. Those bytes are read again with the next block.
+ */
+static void prvSearchNextBlockForward(UARTSearch* pSearch)
+{
+	if (pSearch->summary != 0 && pSearch->nextAddress < pSearch->endAddress &&
+		!uartSummaryCanContainMatch(pSearch->summary, &pSearch->query, pSearch->nextAddress))
+	{
+		/* Nothing starts in the rest of this summary block */
+		uint32_t nextAddress = uartSummaryGetBlockStartAddress(pSearch->summary, pSearch->nextAddress) + UART_SUMMARY_BLOCK_SIZE;
+		if (nextAddress > pSearch->endAddress)
+			nextAddress = pSearch->endAddress;
+		pSearch->numOfBytesSearched += nextAddress - pSearch->nextAddress;
+		pSearch->numOfBytesSkipped += nextAddress - pSearch->nextAddress;
+		pSearch->nextAddress = nextAddress;
+		return;
+	}
+
+	uint32_t size = pSearch->endAddress - pSearch->nextAddress;
+	if (size > sizeof(pSearch->buffer))
+		size = sizeof(pSearch->buffer);
+
+	if (size < pSearch->patternSize)
+	{
+		pSearch->state = UARTSearchState_NotFound;
+		return;
+	}
+
+	if (pSearch->readFunction(pSearch->buffer, pSearch->nextAddress, size, UART_SEARCH_READ_TIMEOUT) != SUCCESS)
+	{
+		pSearch->state = UARTSearchState_Error;
+		return;
+	}
+
+	int32_t index = prvFindFirst(pSearch, pSearch->buffer, size);
+	if (index >= 0)
+	{
+		pSearch->matchAddress = pSearch->nextAddress + index;
+		pSearch->state = UARTSearchState_Found;
+		return;
+	}
+
+	/* All matches that start in this block have been checked */
+	uint32_t numOfBytesChecked = size - (pSearch->patternSize - 1);
+	pSearch->nextAddress += numOfBytesChecked;
+	pSearch->numOfBytesSearched += numOfBytesChecked;
+}
+
+/**
+ * @brief	Read and search the next block towards lower addresses
+ * @param	pSearch: The search
+ * @retval	None
+ * @note	Same as forward but the overlapping bytes are at the start of the block
+ */
+static void prvSearchNextBlockBackward(UARTSearch* pSearch)
+{
+	uint32_t lastStartAddress = pSearch->nextAddress - pSearch->patternSize;
+	if (pSearch->summary != 0 && pSearch->nextAddress >= pSearch->minAddress + pSearch->patternSize &&
+		!uartSummaryCanContainMatch(pSearch->summary, &pSearch->query, lastStartAddress))
+	{
+		/* Nothing starts in the first part of this summary block so the next match ends before the block plus the pattern */
+		uint32_t nextAddress = pSearch->minAddress;
+		uint32_t blockAddress = uartSummaryGetBlockStartAddress(pSearch->summary, lastStartAddress);
+		if (blockAddress > pSearch->minAddress)
+			nextAddress = blockAddress + pSearch->patternSize - 1;
+		pSearch->numOfBytesSearched += pSearch->nextAddress - nextAddress;
+		pSearch->numOfBytesSkipped += pSearch->nextAddress - nextAddress;
+		pSearch->nextAddress = nextAddress;
+		return;
+	}
+
+	uint32_t size = pSearch->nextAddress - pSearch->minAddress;
+	if (size > sizeof(pSearch->buffer))
+		size = sizeof(pSearch->buffer);
+
+	if (size < pSearch->patternSize)
+	{
+		pSearch->state = UARTSearchState_NotFound;
+		return;
+	}
+
+	uint32_t startAddress = pSearch->nextAddress - size;
+	if (pSearch->readFunction(pSearch->buffer, startAddress, size, UART_SEARCH_READ_TIMEOUT) != SUCCESS)
+	{
+		pSearch->state = UARTSearchState_Error;
+		return;
+	}
+
+	int32_t index = prvFindLast(pSearch, pSearch->buffer, size);
+	if (index >= 0)
+	{
+		pSearch->matchAddress = startAddress + index;
+		pSearch->state = UARTSearchState_Found;
+		return;
+	}
+
+	uint32_t numOfBytesChecked = size - (pSearch->patternSize - 1);
+	pSearch->nextAddress -= numOfBytesChecked;
+	pSearch->numOfBytesSearched += numOfBytesChecked;
+}
+
+/* Interrupt Handlers --------------------------------------------------------*/
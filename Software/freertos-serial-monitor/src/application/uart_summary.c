@@ -0,0 +1,250 @@
+/**
+ ******************************************************************************
+ * @file	uart_summary.c
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-17
+ * @brief	Keeps a bloom filter over the byte trigrams of every 4 kB block
+ *			of saved UART data so a search can skip blocks that can't
+ *			contain the pattern.
+ *
+ *			The filter of the block being saved is built in RAM and written
+ *			to the last sector of the channel when the next block starts.
+ *			Blocks without a written filter read as 0xFF and are always
+ *			searched.
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "uart_summary.h"
+
+#include "spi_flash.h"
+#include "spi_flash_memory_map.h"
+
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define FILTER_BIT_SHIFT	(21)			/* 32 - log2(UART_SUMMARY_FILTER_SIZE * 8) */
+#define NO_BLOCK			(0xFFFFFFFF)
+
+/* Private typedefs ----------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t prvTrigramBit(uint32_t Trigram);
+static void prvSaveFilter(UARTSummary* pSummary);
+static const uint8_t* prvGetFilter(UARTSummary* pSummary, UARTSummaryQuery* pQuery, uint32_t Block);
+
+/* Functions -----------------------------------------------------------------*/
+/**
+ * @brief	Resets the summary so that it starts from an address
+ * @param	pSummary: The summary to reset
+ * @param	DataAddress: FLASH address of the first byte of the channel
+ * @param	Address: The FLASH address the next byte will be written to
+ * @retval	None
+ */
+void uartSummaryReset(UARTSummary* pSummary, uint32_t DataAddress, uint32_t Address)
+{
+	memset(pSummary, 0, sizeof(UARTSummary));
+	pSummary->dataAddress = DataAddress;
+	pSummary->summaryAddress = DataAddress + FLASH_CHANNEL_SUMMARY_OFFSET;
+
+	/* The bytes before the address are unknown so a block that has already been started can never be skipped */
+	uint32_t offset = Address - DataAddress;
+	pSummary->currentBlock = offset / UART_SUMMARY_BLOCK_SIZE;
+	pSummary->firstBlock = (offset + UART_SUMMARY_BLOCK_SIZE - 1) / UART_SUMMARY_BLOCK_SIZE;
+}
+
+/**
+ * @brief	Adds data that is about to be saved, the filter of a block is written to FLASH when the next block starts
+ * @param	pSummary: The summary
+ * @param	Address: FLASH address of the first byte
+ * @param	pData: The data
+ * @param	NumOfBytes: Number of bytes
+ * @retval	None
+ * @note	Every trigram is added to the block its last byte is in
+ */
+void uartSummaryAdd(UARTSummary* pSummary, uint32_t Address, const uint8_t* pData, uint32_t NumOfBytes)
+{
+	uint32_t offset = Address - pSummary->dataAddress;
+	uint32_t block = offset / UART_SUMMARY_BLOCK_SIZE;
+	uint32_t numOfBytesLeftInBlock = UART_SUMMARY_BLOCK_SIZE - offset % UART_SUMMARY_BLOCK_SIZE;
+
+	for (uint32_t i = 0; i < NumOfBytes; i++)
+	{
+		if (block != pSummary->currentBlock)
+		{
+			prvSaveFilter(pSummary);
+			memset(pSummary->filter, 0, sizeof(pSummary->filter));
+			pSummary->currentBlock = block;
+		}
+
+		pSummary->lastBytes = ((pSummary->lastBytes << 8) | pData[i]) & 0xFFFFFF;
+		if (pSummary->numOfLastBytes == 2)
+		{
+			uint32_t bit = prvTrigramBit(pSummary->lastBytes);
+			pSummary->filter[bit >> 3] |= 1 << (bit & 0x7);
+		}
+		else
+			pSummary->numOfLastBytes++;
+
+		if (--numOfBytesLeftInBlock == 0)
+		{
+			block++;
+			numOfBytesLeftInBlock = UART_SUMMARY_BLOCK_SIZE;
+		}
+	}
+}
+
+/**
+ * @brief	Prepares a query for a pattern, must be done before every new search as it also clears the read filters
+ * @param	pQuery: The query
+ * @param	pPattern: The pattern
+ * @param	Size: Number of bytes in the pattern, patterns shorter than 3 bytes can't be checked
+ * @retval	None
+ */
+void uartSummaryQueryInit(UARTSummaryQuery* pQuery, const uint8_t* pPattern, uint32_t Size)
+{
+	pQuery->numOfBits = 0;
+	for (uint32_t i = 2; i < Size && pQuery->numOfBits < UART_SUMMARY_MAX_NUM_OF_TRIGRAMS; i++)
+		pQuery->bits[pQuery->numOfBits++] = prvTrigramBit((pPattern[i - 2] << 16) | (pPattern[i - 1] << 8) | pPattern[i]);
+
+	pQuery->filterBlock[0] = NO_BLOCK;
+	pQuery->filterBlock[1] = NO_BLOCK;
+	pQuery->numOfBlocksChecked = 0;
+	pQuery->numOfBlocksSkipped = 0;
+}
+
+/**
+ * @brief	Check if a match can start in the block an address is in
+ * @param	pSummary: The summary of the channel
+ * @param	pQuery: The query for the pattern
+ * @param	Address: FLASH address in the block
+ * @retval	true: A match might start in the block
+ * @retval	false: No match starts in the block
+ * @note	A match that starts in a block ends in the same or the next block so all its trigrams are in one
+ *			of the two filters. Must be called from the same task that adds the data.
+ */
+bool uartSummaryCanContainMatch(UARTSummary* pSummary, UARTSummaryQuery* pQuery, uint32_t Address)
+{
+	if (pQuery->numOfBits == 0)
+		return true;
+
+	uint32_t block = (Address - pSummary->dataAddress) / UART_SUMMARY_BLOCK_SIZE;
+	const uint8_t* filter = prvGetFilter(pSummary, pQuery, block);
+	const uint8_t* nextFilter = prvGetFilter(pSummary, pQuery, block + 1);
+	if (filter == 0 || nextFilter == 0)
+		return true;
+
+	pQuery->numOfBlocksChecked++;
+	for (uint32_t i = 0; i < pQuery->numOfBits; i++)
+	{
+		uint32_t bit = pQuery->bits[i];
+		if (((filter[bit >> 3] | nextFilter[bit >> 3]) & (1 << (bit & 0x7))) == 0)
+		{
+			pQuery->numOfBlocksSkipped++;
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief	Get the address of the first byte in the block an address is in
+ * @param	pSummary: The summary of the channel
+ * @param	Address: FLASH address in the block
+ * @retval	The address
+ */
+uint32_t uartSummaryGetBlockStartAddress(UARTSummary* pSummary, uint32_t Address)
+{
+	return Address - (Address - pSummary->dataAddress) % UART_SUMMARY_BLOCK_SIZE;
+}
+
+/* Private functions .--------------------------------------------------------*/
+/**
+ * @brief	Get the filter bit for a trigram
+ * @param	Trigram: Three bytes with the first one in bit 16-23
+ * @retval	The bit
+ */
+static uint32_t prvTrigramBit(uint32_t Trigram)
+{
+	return (uint32_t)(Trigram * 2654435761U) >> FILTER_BIT_SHIFT;
+}
+
+/**
+ * @brief	Write the filter of the current block to FLASH
+ * @param	pSummary: The summary
+ * @retval	None
+ * @note	Blocks that are never written stay 0xFF in FLASH which means they are never skipped
+ */
+static void prvSaveFilter(UARTSummary* pSummary)
+{
+	if (pSummary->currentBlock < pSummary->firstBlock || pSummary->currentBlock >= UART_SUMMARY_MAX_NUM_OF_BLOCKS)
+		return;
+
+	/* Same as the data, one byte at a time. Erased bytes don't have to be written */
+	uint32_t address = pSummary->summaryAddress + pSummary->currentBlock * UART_SUMMARY_FILTER_SIZE;
+	for (uint32_t i = 0; i < UART_SUMMARY_FILTER_SIZE; i++)
+	{
+		if (pSummary->filter[i] != 0xFF)
+			SPI_FLASH_WriteByte(address + i, pSummary->filter[i]);
+	}
+}
+
+/**
+ * @brief	Get the filter for a block
+ * @param	pSummary: The summary
+ * @param	pQuery: The query where the filter is kept
+ * @param	Block: The block
+ * @retval	Pointer to the filter or 0 if nothing is known about the block
+ */
+static const uint8_t* prvGetFilter(UARTSummary* pSummary, UARTSummaryQuery* pQuery, uint32_t Block)
+{
+	uint32_t slot = Block & 0x1;
+	uint8_t* filter = pQuery->filters[slot];
+
+	if (Block > pSummary->currentBlock)
+	{
+		/* Nothing has been saved there yet */
+		memset(filter, 0, UART_SUMMARY_FILTER_SIZE);
+		pQuery->filterBlock[slot] = NO_BLOCK;
+	}
+	else if (Block < pSummary->firstBlock || Block >= UART_SUMMARY_MAX_NUM_OF_BLOCKS)
+	{
+		return 0;
+	}
+	else if (Block == pSummary->currentBlock)
+	{
+		/* Still being built so it's copied every time */
+		memcpy(filter, pSummary->filter, UART_SUMMARY_FILTER_SIZE);
+		pQuery->filterBlock[slot] = NO_BLOCK;
+	}
+	else if (pQuery->filterBlock[slot] != Block)
+	{
+		if (SPI_FLASH_ReadBufferDMA(filter, pSummary->summaryAddress + Block * UART_SUMMARY_FILTER_SIZE,
+									UART_SUMMARY_FILTER_SIZE, UART_SUMMARY_READ_TIMEOUT) != SUCCESS)
+		{
+			pQuery->filterBlock[slot] = NO_BLOCK;
+			return 0;
+		}
+		pQuery->filterBlock[slot] = Block;
+	}
+
+	return filter;
+}
+
+/* Interrupt Handlers --------------------------------------------------------*/
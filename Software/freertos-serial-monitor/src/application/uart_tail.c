@@ -0,0 +1,116 @@
+/**
+ ******************************************************************************
+ * @file	uart_tail.c
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-10-14
+ * @brief	Keeps the most recent bytes of a UART channel in RAM.
+ *
+ *			Every byte written to SPI FLASH is also written to the tail, which
+ *			is a circular buffer indexed by the FLASH address. The live view
+ *			can then read the newest data from RAM instead of reading back what
+ *			was just written to the FLASH.
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "uart_tail.h"
+
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define TAIL_MASK	(UART_TAIL_SIZE - 1)
+
+/* Private typedefs ----------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t prvOldestAddress(UARTTail* pTail);
+
+/* Functions -----------------------------------------------------------------*/
+/**
+ * @brief	Resets the tail so that it's empty
+ * @param	pTail: The tail to reset
+ * @param	Address: The FLASH address the next byte will be written to
+ * @retval	None
+ */
+void uartTailReset(UARTTail* pTail, uint32_t Address)
+{
+	pTail->startAddress = Address;
+	pTail->endAddress = Address;
+}
+
+/**
+ * @brief	Adds data to the end of the tail, the oldest data is overwritten when it's full
+ * @param	pTail: The tail
+ * @param	pData: Pointer to the data, it's written to the FLASH address at the end of the tail
+ * @param	Size: Number of bytes
+ * @retval	None
+ */
+void uartTailWrite(UARTTail* pTail, uint8_t* pData, uint32_t Size)
+{
+	uint32_t address = pTail->endAddress;
+	for (uint32_t i = 0; i < Size; i++)
+	{
+		pTail->data[address & TAIL_MASK] = pData[i];
+		address++;
+	}
+	pTail->endAddress = address;
+}
+
+/**
+ * @brief	Reads data from the tail if all of it is there
+ * @param	pTail: The tail
+ * @param	pBuffer: Pointer to where the data should be stored
+ * @param	Address: FLASH address of the first byte to read
+ * @param	Size: Number of bytes to read
+ * @retval	true if the data was read
+ * @retval	false if some of the data is not in the tail and it has to be read from the FLASH instead
+ */
+bool uartTailRead(UARTTail* pTail, uint8_t* pBuffer, uint32_t Address, uint32_t Size)
+{
+	if (Size > UART_TAIL_SIZE || Address < prvOldestAddress(pTail) || Address + Size > pTail->endAddress)
+		return false;
+
+	/* Copy in at most two parts as the data can wrap around the end of the buffer */
+	uint32_t index = Address & TAIL_MASK;
+	uint32_t firstPart = UART_TAIL_SIZE - index;
+	if (firstPart > Size)
+		firstPart = Size;
+	memcpy(pBuffer, &pTail->data[index], firstPart);
+	memcpy(&pBuffer[firstPart], pTail->data, Size - firstPart);
+
+	/* New data could have overwritten the oldest part while copying, check again */
+	return (Address >= prvOldestAddress(pTail));
+}
+
+/* Private functions .--------------------------------------------------------*/
+/**
+ * @brief	Get the address of the oldest byte in the tail
+ * @param	pTail: The tail
+ * @retval	The address
+ */
+static uint32_t prvOldestAddress(UARTTail* pTail)
+{
+	uint32_t endAddress = pTail->endAddress;
+	if (endAddress - pTail->startAddress > UART_TAIL_SIZE)
+		return endAddress - UART_TAIL_SIZE;
+	else
+		return pTail->startAddress;
+}
+
+/* Interrupt Handlers --------------------------------------------------------*/
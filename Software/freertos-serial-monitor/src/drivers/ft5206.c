@@ -76,6 +76,15 @@
 /* Uncomment below if multiple touch points should be detected */
 //#define MULTIPLE_TOUCH_POINTS
 
+/* Registers read after every touch interrupt */
+#if defined(MULTIPLE_TOUCH_POINTS)
+#define FT5206_READ_REGISTER	(FT5206_REGISTER_TD_STATUS)
+#define FT5206_READ_SIZE		(FT5206_REGISTER_TOUCH5_XH + 4 - FT5206_REGISTER_TD_STATUS)
+#else
+#define FT5206_READ_REGISTER	(FT5206_REGISTER_TOUCH1_XH)
+#define FT5206_READ_SIZE		(4)
+#endif
+
 /* Private typedefs ----------------------------------------------------------*/
 typedef enum
 {
@@ -93,7 +102,38 @@ static const uint8_t prvBaseRegisterForPoint[5] = {
 		FT5206_REGISTER_TOUCH5_XH
 };
 
+/*
+ * Moves of the first touch point are coalesced. Only the latest position is kept and a single
+ * LCDEvent_TouchMove message is in the queue until the LCD task has read it. The messages are numbered
+ * so that a message left behind by an earlier gesture can't pick up the position of a later one.
+ */
+static volatile FT5206TouchCoordinate prvPendingMove;
+static volatile bool prvMoveIsPending = false;
+static volatile uint32_t prvMoveNumber = 0;
+
+/*
+ * The interrupt only queues a read of the touch registers, the I2C driver does the rest using interrupts.
+ * Only one read at a time, an interrupt during a read makes a new read start after it.
+ */
+static uint8_t prvTouchData[FT5206_READ_SIZE];
+static I2C2Transaction prvTouchTransaction = {
+		.devAddress			= FT5206_ADDRESS,
+		.useRegister		= true,
+		.registerAddress	= FT5206_READ_REGISTER,
+		.direction			= I2C2Direction_Read,
+		.pBuffer			= prvTouchData,
+		.size				= FT5206_READ_SIZE,
+		.priority			= I2C2Priority_High,
+		.client				= I2C2Client_Touch,
+};
+static volatile bool prvReadIsPending = false;
+static volatile bool prvReadAgain = false;
+static volatile uint32_t prvMaxInterruptCycles = 0;
+
 /* Private function prototypes -----------------------------------------------*/
+static void prvPostTouchEventFromISR(uint16_t XPos, uint16_t YPos, FT5206Event Event, FT5206Point Point);
+static void prvStartReadFromISR();
+static void prvTouchDataReadDone(I2C2Transaction* pTransaction);
 
 /* Functions -----------------------------------------------------------------*/
 /**
@@ -124,7 +164,12 @@ void FT5206_Init()
 	HAL_GPIO_WritePin(FT5206_WAKE_PORT, FT5206_WAKE_PIN, GPIO_PIN_SET);
 	HAL_GPIO_WritePin(FT5206_RESET_PORT, FT5206_RESET_PIN, GPIO_PIN_SET);
 
-	/* Interrupt */
+	/* Cycle counter used to measure the time spent in the touch interrupt */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	/* Interrupt, the touch data is read in the background after it */
+	prvTouchTransaction.callback = prvTouchDataReadDone;
 	GPIO_InitStructure.Mode  		= GPIO_MODE_IT_FALLING;
 	GPIO_InitStructure.Pin  		= FT5206_INT_PIN;
 	HAL_GPIO_Init(FT5206_INT_PORT, &GPIO_InitStructure);
@@ -133,20 +178,18 @@ void FT5206_Init()
 	HAL_NVIC_EnableIRQ(EXTI9_5_IRQn);
 
 	/* Try to get chip id */
-	uint8_t data = FT5206_REGISTER_ID_G_CIPHER;
-	I2C2_Transmit(FT5206_ADDRESS, &data, 1);
 	uint8_t chipId = 0;
-	I2C2_Receive(FT5206_ADDRESS, &chipId, 1);
+	I2C2_ReadRegister(FT5206_ADDRESS, FT5206_REGISTER_ID_G_CIPHER, &chipId, 1, I2C2Client_Touch);
 	if (chipId != FT5206_CHIP_VENDOR_ID)
 	{
 		/* TODO: Do something */
 	}
 
 	/* Set interrupt mode to triggering and update rate */
-	uint8_t temp[2] = {FT5206_REGISTER_ID_G_MODE, FT5206InterruptMode_Trigger};
-	I2C2_Transmit(FT5206_ADDRESS, temp, 2);
-	uint8_t temp2[2] = {FT5206_REGISTER_ID_G_PERIODACTIVE, 12};	/* 3  33.56 Hz */
-	I2C2_Transmit(FT5206_ADDRESS, temp2, 2);
+	uint8_t temp = FT5206InterruptMode_Trigger;
+	I2C2_WriteRegister(FT5206_ADDRESS, FT5206_REGISTER_ID_G_MODE, &temp, 1, I2C2Client_Touch);
+	uint8_t temp2 = 12;	/* 3  33.56 Hz */
+	I2C2_WriteRegister(FT5206_ADDRESS, FT5206_REGISTER_ID_G_PERIODACTIVE, &temp2, 1, I2C2Client_Touch);
 }
 
 /**
@@ -156,10 +199,8 @@ void FT5206_Init()
  */
 uint32_t FT5206_GetNumOfTouchPoints()
 {
-	uint8_t data = FT5206_REGISTER_TD_STATUS;
-	I2C2_Transmit(FT5206_ADDRESS, &data, 1);
 	uint8_t storage = 0;
-	I2C2_Receive(FT5206_ADDRESS, &storage, 1);
+	I2C2_ReadRegister(FT5206_ADDRESS, FT5206_REGISTER_TD_STATUS, &storage, 1, I2C2Client_Touch);
 
 	return storage;
 }
@@ -173,53 +214,162 @@ uint32_t FT5206_GetNumOfTouchPoints()
  */
 void FT5206_GetTouchDataForPoint(FT5206Event* pEvent, FT5206TouchCoordinate* pCoordinate, FT5206Point Point)
 {
-	uint8_t reg = prvBaseRegisterForPoint[Point-1];
-	I2C2_Transmit(FT5206_ADDRESS, &reg, 1);
 	uint8_t storage[4] = {0x00};
-	I2C2_Receive(FT5206_ADDRESS, storage, 4);
+	I2C2_ReadRegister(FT5206_ADDRESS, prvBaseRegisterForPoint[Point-1], storage, 4, I2C2Client_Touch);
 
 	*pEvent = (storage[0] & 0xC0) >> 6;
 	pCoordinate->x = ((storage[0] & 0x0F) << 8) | storage[1];
 	pCoordinate->y = ((storage[2] & 0x0F) << 8) | storage[3];
 }
 
-/* Interrupt Handlers --------------------------------------------------------*/
-void CTP_INT_Callback()
+/**
+ * @brief	Get the latest position of a move that has not been handled yet
+ * @param	MoveNumber: The number in data[0] of the LCDEvent_TouchMove message
+ * @param	pCoordinate: Pointer to where the position should be stored
+ * @retval	true if the move of the message is still pending, false if it was sent as a normal event already
+ */
+bool FT5206_GetPendingMove(uint32_t MoveNumber, FT5206TouchCoordinate* pCoordinate)
 {
-#if defined(MULTIPLE_TOUCH_POINTS)
-	uint8_t numOfPoints = 0;
-	uint8_t data = FT5206_REGISTER_TD_STATUS;
-	I2C2_TransmitFromISR(FT5206_ADDRESS, &data, 1);
-	I2C2_ReceiveFromISR(FT5206_ADDRESS, &numOfPoints, 1);
+	bool moveWasPending;
+
+	taskENTER_CRITICAL();
+	moveWasPending = prvMoveIsPending && MoveNumber == prvMoveNumber;
+	if (moveWasPending)
+	{
+		pCoordinate->x = prvPendingMove.x;
+		pCoordinate->y = prvPendingMove.y;
+		prvMoveIsPending = false;
+	}
+	taskEXIT_CRITICAL();
+
+	return moveWasPending;
+}
+
+/**
+ * @brief	Get the longest time spent in the touch interrupt
+ * @param	None
+ * @retval	The time in CPU cycles, divide by SystemCoreClock for seconds
+ */
+uint32_t FT5206_GetMaxInterruptCycles()
+{
+	return prvMaxInterruptCycles;
+}
+
+/* Private functions .--------------------------------------------------------*/
+/**
+ * @brief	Send a touch event to the LCD task, moves of the first point are coalesced until the next other event
+ * @param	XPos: The X coordinate
+ * @param	YPos: The Y coordinate
+ * @param	Event: The event from the controller
+ * @param	Point: The point the event happened on
+ * @retval	None
+ */
+static void prvPostTouchEventFromISR(uint16_t XPos, uint16_t YPos, FT5206Event Event, FT5206Point Point)
+{
+	LCDEventMessage message;
+
+	if (Event == FT5206Event_Contact && Point == FT5206Point_1)
+	{
+		prvPendingMove.x = XPos;
+		prvPendingMove.y = YPos;
 
-	uint32_t i;
-	for (i = 0; i < numOfPoints; i++)
+		/* A message is already waiting in the queue, it will pick up the new position */
+		if (prvMoveIsPending)
+			return;
+
+		prvMoveIsPending = true;
+		message.event = LCDEvent_TouchMove;
+		message.data[0] = ++prvMoveNumber;
+	}
+	else
 	{
-		uint8_t reg = prvBaseRegisterForPoint[i];
-		I2C2_TransmitFromISR(FT5206_ADDRESS, &reg, 1);
-		uint8_t storage[4] = {0x00};
-		I2C2_ReceiveFromISR(FT5206_ADDRESS, storage, 4);
+		/*
+		 * The queued move message reads the position when it's handled, it must not pick up a position from
+		 * after this event. Send the pending position as a normal contact event in front of this one instead,
+		 * the move message is then ignored because the next move gets a new number.
+		 */
+		if (prvMoveIsPending)
+		{
+			prvMoveIsPending = false;
+			message.event = LCDEvent_TouchEvent;
+			message.data[0] = MESSAGES_TOUCH_PACK_POSITION(prvPendingMove.x, prvPendingMove.y);
+			message.data[1] = MESSAGES_TOUCH_PACK_EVENT(FT5206Event_Contact, FT5206Point_1);
+			xQueueSendToBackFromISR(xLCDEventQueue, &message, NULL);
+		}
 
-		LCDEventMessage message;
 		message.event = LCDEvent_TouchEvent;
-		message.data[0] = ((storage[0] & 0x0F) << 8) | storage[1];
-		message.data[1] = ((storage[2] & 0x0F) << 8) | storage[3];
-		message.data[2] = (storage[0] & 0xC0) >> 6;
-		message.data[3] = i+1;
-		xQueueSendToBackFromISR(xLCDEventQueue, &message, NULL);
+		message.data[0] = MESSAGES_TOUCH_PACK_POSITION(XPos, YPos);
+		message.data[1] = MESSAGES_TOUCH_PACK_EVENT(Event, Point);
 	}
-#else
-	uint8_t reg = prvBaseRegisterForPoint[FT5206Point_1 - 1];
-	I2C2_TransmitFromISR(FT5206_ADDRESS, &reg, 1);
-	uint8_t storage[4] = {0x00};
-	I2C2_ReceiveFromISR(FT5206_ADDRESS, storage, 4);
 
-	LCDEventMessage message;
-	message.event = LCDEvent_TouchEvent;
-	message.data[0] = ((storage[0] & 0x0F) << 8) | storage[1];
-	message.data[1] = ((storage[2] & 0x0F) << 8) | storage[3];
-	message.data[2] = (storage[0] & 0xC0) >> 6;
-	message.data[3] = FT5206Point_1;
-	xQueueSendToBackFromISR(xLCDEventQueue, &message, NULL);
+	if (xQueueSendToBackFromISR(xLCDEventQueue, &message, NULL) != pdTRUE && message.event == LCDEvent_TouchMove)
+		prvMoveIsPending = false;
+}
+
+/**
+ * @brief	Queue a read of the touch registers
+ * @param	None
+ * @retval	None
+ */
+static void prvStartReadFromISR()
+{
+	prvReadIsPending = true;
+	prvReadAgain = false;
+	if (I2C2_SubmitFromISR(&prvTouchTransaction) != SUCCESS)
+		prvReadIsPending = false;
+}
+
+/**
+ * @brief	Called from the I2C interrupt when the touch registers have been read
+ * @param	pTransaction: The read
+ * @retval	None
+ */
+static void prvTouchDataReadDone(I2C2Transaction* pTransaction)
+{
+	if (pTransaction->state == I2C2TransactionState_Done)
+	{
+#if defined(MULTIPLE_TOUCH_POINTS)
+		uint32_t numOfPoints = prvTouchData[0] & 0x0F;
+		if (numOfPoints > 5)
+			numOfPoints = 5;
+
+		for (uint32_t i = 0; i < numOfPoints; i++)
+		{
+			uint8_t* storage = &prvTouchData[prvBaseRegisterForPoint[i] - FT5206_READ_REGISTER];
+			prvPostTouchEventFromISR(((storage[0] & 0x0F) << 8) | storage[1], ((storage[2] & 0x0F) << 8) | storage[3],
+									 (storage[0] & 0xC0) >> 6, i+1);
+		}
+#else
+		uint8_t* storage = prvTouchData;
+		prvPostTouchEventFromISR(((storage[0] & 0x0F) << 8) | storage[1], ((storage[2] & 0x0F) << 8) | storage[3],
+								 (storage[0] & 0xC0) >> 6, FT5206Point_1);
 #endif
+	}
+
+	/* Don't lose an event that happened while reading, e.g. the last put up */
+	if (prvReadAgain)
+		prvStartReadFromISR();
+	else
+		prvReadIsPending = false;
+}
+
+/* Interrupt Handlers --------------------------------------------------------*/
+/**
+ * @brief	Called from the EXTI interrupt when the touch controller has new data
+ * @param	None
+ * @retval	None
+ * @note	Only queues the read so the interrupt takes a few us
+ */
+void CTP_INT_Callback()
+{
+	uint32_t startCycles = DWT->CYCCNT;
+
+	if (prvReadIsPending)
+		prvReadAgain = true;
+	else
+		prvStartReadFromISR();
+
+	uint32_t cycles = DWT->CYCCNT - startCycles;
+	if (cycles > prvMaxInterruptCycles)
+		prvMaxInterruptCycles = cycles;
 }
@@ -4,7 +4,10 @@
  * @author	Hampus Sandberg
  * @version	0.1
  * @date	2014-09-07
- * @brief
+ * @brief	Queued I2C2 driver. Clients submit transactions that are executed one
+ *			at a time by a register level interrupt driven engine. High priority
+ *			transactions are started before low priority ones but a running
+ *			transaction is never interrupted.
  ******************************************************************************
 	Copyright (c) 2014 Hampus Sandberg.
 
@@ -26,7 +29,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "i2c2.h"
 
-#include <stdbool.h>
+#include "timers.h"
 
 /* Private defines -----------------------------------------------------------*/
 #define I2C_PERIPHERAL		(I2C2)
@@ -37,7 +40,25 @@
 
 #define I2C_CLOCK_SPEED		(400000)
 
+#define I2C_ERROR_FLAGS		(I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_AF | I2C_SR1_OVR | I2C_SR1_TIMEOUT)
+
+#define RECOVERY_NUM_OF_CLOCKS	(9)		/* Enough for a slave to finish any byte it's in the middle of */
+#define RECOVERY_HALF_PERIOD	(5)		/* us, gives a 100 kHz clock */
+
 /* Private typedefs ----------------------------------------------------------*/
+typedef enum
+{
+	I2C2Phase_Idle,
+	I2C2Phase_Start,				/* Waiting for the start condition */
+	I2C2Phase_AddressWrite,			/* Waiting for the slave to ack its address in write mode */
+	I2C2Phase_Transmit,				/* Sending the register address and the data */
+	I2C2Phase_RepeatedStart,
+	I2C2Phase_AddressRead,			/* Waiting for the slave to ack its address in read mode */
+	I2C2Phase_Receive,				/* One byte at a time on RXNE */
+	I2C2Phase_ReceiveLastThree,		/* Waiting for BTF with three bytes left */
+	I2C2Phase_ReceiveLastTwo,		/* Waiting for BTF with two bytes left */
+} I2C2Phase;
+
 /* Private variables ---------------------------------------------------------*/
 static I2C_HandleTypeDef I2C_Handle = {
 		.Instance 				= I2C_PERIPHERAL,
@@ -49,10 +70,35 @@ static I2C_HandleTypeDef I2C_Handle = {
 		.Init.NoStretchMode		= I2C_NOSTRETCH_DISABLED,
 };
 
-static SemaphoreHandle_t xSemaphore;
 static bool prvInitialized = false;
 
+/* One queue for every priority, only changed with the I2C interrupts masked */
+static I2C2Transaction* prvQueueHead[I2C2Priority_NumOfPriorities];
+static I2C2Transaction* prvQueueTail[I2C2Priority_NumOfPriorities];
+static I2C2Transaction* volatile prvActiveTransaction = 0;
+static volatile I2C2Phase prvPhase = I2C2Phase_Idle;
+static uint16_t prvIndex = 0;
+static volatile bool prvBusNeedsRecovery = false;
+static volatile bool prvStartIsPended = false;
+
+static I2C2ClientStats prvStats[I2C2Client_NumOfClients];
+
+/* Synchronous transfers wait for the callback using the semaphore, only one task at a time */
+static SemaphoreHandle_t xSyncMutex;
+static SemaphoreHandle_t xSyncDoneSemaphore;
+
 /* Private function prototypes -----------------------------------------------*/
+static void prvGpioInit(uint32_t Mode);
+static ErrorStatus prvEnqueue(I2C2Transaction* pTransaction);
+static bool prvRemoveFromQueue(I2C2Transaction* pTransaction);
+static void prvStartNext();
+static void prvComplete(ErrorStatus Status);
+static void prvDelayUs(uint32_t Microseconds);
+static void prvRecoverBusCallback(void* pvParameter1, uint32_t ulParameter2);
+static void prvStartNextCallback(void* pvParameter1, uint32_t ulParameter2);
+static void prvSyncTransferDone(I2C2Transaction* pTransaction);
+static ErrorStatus prvSyncTransfer(uint8_t DevAddress, bool UseRegister, uint8_t Register, I2C2Direction Direction,
+								   uint8_t* pBuffer, uint16_t Size, I2C2Client Client);
 
 /* Functions -----------------------------------------------------------------*/
 /**
@@ -65,119 +111,649 @@ void I2C2_Init()
 	/* Make sure we only initialize it once */
 	if (!prvInitialized)
 	{
-		/* Mutex semaphore for mutual exclusion to the I2C2 device */
-		xSemaphore = xSemaphoreCreateMutex();
+		xSyncMutex = xSemaphoreCreateMutex();
+		xSyncDoneSemaphore = xSemaphoreCreateBinary();
+
+		/* I2C clock & GPIOB enable */
+		__GPIOB_CLK_ENABLE();
+		__I2C2_CLK_ENABLE();
+
+		/* I2C SDA and SCL configuration */
+		prvGpioInit(GPIO_MODE_AF_OD);
+
+		/* I2C Init */
+		HAL_I2C_Init(&I2C_Handle);
+
+		/* Cycle counter used for the latency stats and the recovery delays */
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
 
-		if (xSemaphoreTake(xSemaphore, 100) == pdTRUE)
+		/* Event and error interrupts that drive the transactions */
+		HAL_NVIC_SetPriority(I2C2_EV_IRQn, configLIBRARY_LOWEST_INTERRUPT_PRIORITY, 0);
+		HAL_NVIC_EnableIRQ(I2C2_EV_IRQn);
+		HAL_NVIC_SetPriority(I2C2_ER_IRQn, configLIBRARY_LOWEST_INTERRUPT_PRIORITY, 0);
+		HAL_NVIC_EnableIRQ(I2C2_ER_IRQn);
+
+		prvInitialized = true;
+	}
+}
+
+/**
+ * @brief	Add a transaction to the queue, it's started right away if the bus is free
+ * @param	pTransaction: The transaction, must not be changed until it's done
+ * @retval	SUCCESS: The transaction was queued and the callback will be called
+ * @retval	ERROR: The transaction is invalid or already queued
+ */
+ErrorStatus I2C2_Submit(I2C2Transaction* pTransaction)
+{
+	taskENTER_CRITICAL();
+	ErrorStatus status = prvEnqueue(pTransaction);
+	taskEXIT_CRITICAL();
+	return status;
+}
+
+/**
+ * @brief	Add a transaction to the queue, used in ISR
+ * @param	pTransaction: The transaction, must not be changed until it's done
+ * @retval	SUCCESS: The transaction was queued and the callback will be called
+ * @retval	ERROR: The transaction is invalid or already queued
+ * @note	Only takes a few us, starting a transaction is just setting the start bit
+ */
+ErrorStatus I2C2_SubmitFromISR(I2C2Transaction* pTransaction)
+{
+	UBaseType_t interruptMask = portSET_INTERRUPT_MASK_FROM_ISR();
+	ErrorStatus status = prvEnqueue(pTransaction);
+	portCLEAR_INTERRUPT_MASK_FROM_ISR(interruptMask);
+	return status;
+}
+
+/**
+ * @brief	Do a transaction and wait until it's done
+ * @param	pTransaction: The transaction, the callback will be replaced
+ * @retval	SUCCESS: Everything went ok
+ * @retval	ERROR: Something went wrong
+ * @note	The bus is recovered if the transaction doesn't finish within I2C2_TRANSACTION_TIMEOUT
+ */
+ErrorStatus I2C2_Transfer(I2C2Transaction* pTransaction)
+{
+	if (xSemaphoreTake(xSyncMutex, I2C2_TRANSACTION_TIMEOUT) != pdTRUE)
+		return ERROR;
+
+	ErrorStatus status = ERROR;
+	pTransaction->callback = prvSyncTransferDone;
+	if (I2C2_Submit(pTransaction) == SUCCESS)
+	{
+		if (xSemaphoreTake(xSyncDoneSemaphore, I2C2_TRANSACTION_TIMEOUT) == pdTRUE)
 		{
-			/* I2C clock & GPIOB enable */
-			__GPIOB_CLK_ENABLE();
-			__I2C2_CLK_ENABLE();
-
-			/* I2C SDA and SCL configuration */
-			GPIO_InitTypeDef GPIO_InitStructure;
-			GPIO_InitStructure.Pin  		= I2C_SCL_PIN | I2C_SDA_PIN;
-			GPIO_InitStructure.Mode  		= GPIO_MODE_AF_OD;
-			GPIO_InitStructure.Alternate 	= GPIO_AF4_I2C2;
-			GPIO_InitStructure.Pull			= GPIO_NOPULL;
-			GPIO_InitStructure.Speed 		= GPIO_SPEED_HIGH;
-			HAL_GPIO_Init(I2C_PORT, &GPIO_InitStructure);
-
-		//	/* NVIC Configuration */
-		//	NVIC_InitTypeDef NVIC_InitStructure;
-		//	/* Event interrupt */
-		//	NVIC_InitStructure.NVIC_IRQChannel = I2C1_EV_IRQn;
-		//	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = configMAX_SYSCALL_INTERRUPT_PRIORITY;
-		//	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
-		//	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
-		//	NVIC_Init(&NVIC_InitStructure);
-		//	/* Error interrupt */
-		//	NVIC_InitStructure.NVIC_IRQChannel = I2C1_ER_IRQn;
-		//	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 14;
-		//	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
-		//	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
-		//	NVIC_Init(&NVIC_InitStructure);
-
-			/* I2C Init */
-			HAL_I2C_Init(&I2C_Handle);
-
-			/* Enable the I2C1 interrupts */
-		//	I2C_ITConfig(I2C_PERIPHERAL, I2C_IT_EVT, ENABLE);
-		//	I2C_ITConfig(I2C_PERIPHERAL, I2C_IT_ERR, ENABLE);
-
-			xSemaphoreGive(xSemaphore);
+			if (pTransaction->state == I2C2TransactionState_Done)
+				status = SUCCESS;
 		}
+		else
+		{
+			/* Still waiting in the queue means the bus is stuck on some other transaction */
+			taskENTER_CRITICAL();
+			prvRemoveFromQueue(pTransaction);
+			taskEXIT_CRITICAL();
 
-		prvInitialized = true;
+			I2C2_RecoverBus();
+
+			/* The recovery may have finished our transaction */
+			xSemaphoreTake(xSyncDoneSemaphore, 0);
+		}
 	}
+
+	xSemaphoreGive(xSyncMutex);
+	return status;
 }
 
 /**
- * @brief	Transmits data as a master to a slave
- * @param	DevAddress: Address for the slave device
- * @param	pBuffer: Pointer to the buffer of data to send
- * @param	Size: Size of the buffer
+ * @brief	Abort the running transaction and get the bus working again
+ * @param	None
  * @retval	None
+ * @note	A slave in the middle of sending a byte can hold SDA low forever, clocking SCL until SDA is
+ *			released and then sending a stop condition resets it. Takes ~100 us, should not be called from an ISR.
  */
-void I2C2_Transmit(uint8_t DevAddress, uint8_t* pBuffer, uint16_t Size)
+void I2C2_RecoverBus()
 {
-	/* Try to take the semaphore in case some other process is using the device */
-	if (xSemaphoreTake(xSemaphore, 100) == pdTRUE)
+	HAL_NVIC_DisableIRQ(I2C2_EV_IRQn);
+	HAL_NVIC_DisableIRQ(I2C2_ER_IRQn);
+
+	taskENTER_CRITICAL();
+	prvBusNeedsRecovery = true;
+	if (prvActiveTransaction != 0)
+		prvComplete(ERROR);
+	taskEXIT_CRITICAL();
+
+	/* Reset the peripheral and take over the pins */
+	I2C_PERIPHERAL->CR1 = I2C_CR1_SWRST;
+	I2C_PERIPHERAL->CR1 = 0;
+	HAL_GPIO_WritePin(I2C_PORT, I2C_SCL_PIN | I2C_SDA_PIN, GPIO_PIN_SET);
+	prvGpioInit(GPIO_MODE_OUTPUT_OD);
+	prvDelayUs(RECOVERY_HALF_PERIOD);
+
+	for (uint32_t i = 0; i < RECOVERY_NUM_OF_CLOCKS && HAL_GPIO_ReadPin(I2C_PORT, I2C_SDA_PIN) == GPIO_PIN_RESET; i++)
 	{
-		HAL_I2C_Master_Transmit(&I2C_Handle, (uint16_t)(DevAddress << 1), pBuffer, Size, 500); /* TODO: Check timeout value */
-		xSemaphoreGive(xSemaphore);
+		HAL_GPIO_WritePin(I2C_PORT, I2C_SCL_PIN, GPIO_PIN_RESET);
+		prvDelayUs(RECOVERY_HALF_PERIOD);
+		HAL_GPIO_WritePin(I2C_PORT, I2C_SCL_PIN, GPIO_PIN_SET);
+		prvDelayUs(RECOVERY_HALF_PERIOD);
 	}
+
+	/* Stop condition: SDA goes high while SCL is high */
+	HAL_GPIO_WritePin(I2C_PORT, I2C_SCL_PIN, GPIO_PIN_RESET);
+	HAL_GPIO_WritePin(I2C_PORT, I2C_SDA_PIN, GPIO_PIN_RESET);
+	prvDelayUs(RECOVERY_HALF_PERIOD);
+	HAL_GPIO_WritePin(I2C_PORT, I2C_SCL_PIN, GPIO_PIN_SET);
+	prvDelayUs(RECOVERY_HALF_PERIOD);
+	HAL_GPIO_WritePin(I2C_PORT, I2C_SDA_PIN, GPIO_PIN_SET);
+	prvDelayUs(RECOVERY_HALF_PERIOD);
+
+	/* Give the pins back to the peripheral */
+	prvGpioInit(GPIO_MODE_AF_OD);
+	HAL_I2C_Init(&I2C_Handle);
+
+	taskENTER_CRITICAL();
+	prvBusNeedsRecovery = false;
+	prvStartNext();
+	taskEXIT_CRITICAL();
+
+	HAL_NVIC_EnableIRQ(I2C2_EV_IRQn);
+	HAL_NVIC_EnableIRQ(I2C2_ER_IRQn);
 }
 
 /**
- * @brief	Transmits data as a master to a slave, used in ISR
+ * @brief	Get the stats for a client
+ * @param	Client: The client, can be any value of I2C2Client
+ * @param	pStats: Pointer to where the stats should be stored
+ * @retval	None
+ */
+void I2C2_GetClientStats(I2C2Client Client, I2C2ClientStats* pStats)
+{
+	if (Client >= I2C2Client_NumOfClients)
+		return;
+
+	taskENTER_CRITICAL();
+	*pStats = prvStats[Client];
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief	Transmits data as a master to a slave
  * @param	DevAddress: Address for the slave device
  * @param	pBuffer: Pointer to the buffer of data to send
  * @param	Size: Size of the buffer
+ * @param	Client: The client doing the transfer, can be any value of I2C2Client
+ * @retval	SUCCESS: Everything went ok
+ * @retval	ERROR: Something went wrong
+ */
+ErrorStatus I2C2_Transmit(uint8_t DevAddress, uint8_t* pBuffer, uint16_t Size, I2C2Client Client)
+{
+	return prvSyncTransfer(DevAddress, false, 0, I2C2Direction_Write, pBuffer, Size, Client);
+}
+
+/**
+ * @brief	Receives data as a master from a slave
+ * @param	DevAddress: Address for the slave device
+ * @param	pBuffer: Pointer to a buffer where data will be stored
+ * @param	Size: Size of the amount of data to receive
+ * @param	Client: The client doing the transfer, can be any value of I2C2Client
+ * @retval	SUCCESS: Everything went ok
+ * @retval	ERROR: Something went wrong
+ */
+ErrorStatus I2C2_Receive(uint8_t DevAddress, uint8_t* pBuffer, uint16_t Size, I2C2Client Client)
+{
+	return prvSyncTransfer(DevAddress, false, 0, I2C2Direction_Read, pBuffer, Size, Client);
+}
+
+/**
+ * @brief	Reads registers from a slave in one transaction so no other transaction can move the register pointer
+ * @param	DevAddress: Address for the slave device
+ * @param	Register: The first register to read
+ * @param	pBuffer: Pointer to a buffer where data will be stored
+ * @param	Size: Number of bytes to read
+ * @param	Client: The client doing the transfer, can be any value of I2C2Client
+ * @retval	SUCCESS: Everything went ok
+ * @retval	ERROR: Something went wrong
+ */
+ErrorStatus I2C2_ReadRegister(uint8_t DevAddress, uint8_t Register, uint8_t* pBuffer, uint16_t Size, I2C2Client Client)
+{
+	return prvSyncTransfer(DevAddress, true, Register, I2C2Direction_Read, pBuffer, Size, Client);
+}
+
+/**
+ * @brief	Writes registers in a slave
+ * @param	DevAddress: Address for the slave device
+ * @param	Register: The first register to write
+ * @param	pBuffer: Pointer to the data to write
+ * @param	Size: Number of bytes to write
+ * @param	Client: The client doing the transfer, can be any value of I2C2Client
+ * @retval	SUCCESS: Everything went ok
+ * @retval	ERROR: Something went wrong
+ */
+ErrorStatus I2C2_WriteRegister(uint8_t DevAddress, uint8_t Register, uint8_t* pBuffer, uint16_t Size, I2C2Client Client)
+{
+	return prvSyncTransfer(DevAddress, true, Register, I2C2Direction_Write, pBuffer, Size, Client);
+}
+
+/* Private functions .--------------------------------------------------------*/
+/**
+ * @brief	Configure the SCL and SDA pins
+ * @param	Mode: GPIO_MODE_AF_OD for the peripheral or GPIO_MODE_OUTPUT_OD for bus recovery
  * @retval	None
  */
-void I2C2_TransmitFromISR(uint8_t DevAddress, uint8_t* pBuffer, uint16_t Size)
+static void prvGpioInit(uint32_t Mode)
+{
+	GPIO_InitTypeDef GPIO_InitStructure;
+	GPIO_InitStructure.Pin  		= I2C_SCL_PIN | I2C_SDA_PIN;
+	GPIO_InitStructure.Mode  		= Mode;
+	GPIO_InitStructure.Alternate 	= GPIO_AF4_I2C2;
+	GPIO_InitStructure.Pull			= GPIO_NOPULL;
+	GPIO_InitStructure.Speed 		= GPIO_SPEED_HIGH;
+	HAL_GPIO_Init(I2C_PORT, &GPIO_InitStructure);
+}
+
+/**
+ * @brief	Add a transaction to the queue for its priority
+ * @param	pTransaction: The transaction
+ * @retval	SUCCESS or ERROR
+ * @note	Must be called with the I2C interrupts masked
+ */
+static ErrorStatus prvEnqueue(I2C2Transaction* pTransaction)
 {
-	/* Try to take the semaphore in case some other process is using the device */
-	if (xSemaphoreTakeFromISR(xSemaphore, NULL) == pdTRUE)
+	if (!prvInitialized || pTransaction->priority >= I2C2Priority_NumOfPriorities ||
+		pTransaction->client >= I2C2Client_NumOfClients ||
+		pTransaction->state == I2C2TransactionState_Queued || pTransaction->state == I2C2TransactionState_Active ||
+		(pTransaction->direction == I2C2Direction_Read && pTransaction->size == 0))
+		return ERROR;
+
+	pTransaction->state = I2C2TransactionState_Queued;
+	pTransaction->submitCycles = DWT->CYCCNT;
+	pTransaction->next = 0;
+
+	I2C2Priority priority = pTransaction->priority;
+	if (prvQueueHead[priority] == 0)
+		prvQueueHead[priority] = pTransaction;
+	else
+		prvQueueTail[priority]->next = pTransaction;
+	prvQueueTail[priority] = pTransaction;
+
+	prvStartNext();
+	return SUCCESS;
+}
+
+/**
+ * @brief	Remove a transaction that has not been started from the queue
+ * @param	pTransaction: The transaction
+ * @retval	true if it was in the queue
+ * @note	Must be called with the I2C interrupts masked
+ */
+static bool prvRemoveFromQueue(I2C2Transaction* pTransaction)
+{
+	if (pTransaction->state != I2C2TransactionState_Queued)
+		return false;
+
+	I2C2Priority priority = pTransaction->priority;
+	I2C2Transaction* previous = 0;
+	for (I2C2Transaction* current = prvQueueHead[priority]; current != 0; current = current->next)
 	{
-		HAL_I2C_Master_Transmit(&I2C_Handle, (uint16_t)(DevAddress << 1), pBuffer, Size, 500); /* TODO: Check timeout value */
-		xSemaphoreGiveFromISR(xSemaphore, NULL);
+		if (current == pTransaction)
+		{
+			if (previous == 0)
+				prvQueueHead[priority] = current->next;
+			else
+				previous->next = current->next;
+			if (prvQueueTail[priority] == current)
+				prvQueueTail[priority] = previous;
+
+			pTransaction->state = I2C2TransactionState_Error;
+			return true;
+		}
+		previous = current;
 	}
+	return false;
 }
 
 /**
- * @brief	Transmits data as a master to a slave
- * @param	DevAddress: Address for the slave device
- * @param	Data: Pointer to a buffer where data will be stored
- * @param	Size: Size of the amount of data to receive
+ * @brief	Start the next transaction in the queue if the bus is free
+ * @param	None
  * @retval	None
+ * @note	Must be called with the I2C interrupts masked or from the I2C interrupts
  */
-void I2C2_Receive(uint8_t DevAddress, uint8_t* pBuffer, uint16_t Size)
+static void prvStartNext()
 {
-	/* Try to take the semaphore in case some other process is using the device */
-	if (xSemaphoreTake(xSemaphore, 100) == pdTRUE)
+	if (prvActiveTransaction != 0 || prvBusNeedsRecovery || prvStartIsPended)
+		return;
+
+	uint32_t priority = 0;
+	while (priority < I2C2Priority_NumOfPriorities && prvQueueHead[priority] == 0)
+		priority++;
+	if (priority == I2C2Priority_NumOfPriorities)
+		return;
+
+	/*
+	 * CR1 must not be written until the stop condition of the last transaction has been sent. That takes a few us
+	 * and there is no interrupt for it in master mode, so the timer task starts the transaction instead of waiting here.
+	 */
+	if (I2C_PERIPHERAL->CR1 & I2C_CR1_STOP)
 	{
-		HAL_I2C_Master_Receive(&I2C_Handle, (uint16_t)(DevAddress << 1), pBuffer, Size, 500); /* TODO: Check timeout value */
-		xSemaphoreGive(xSemaphore);
+		prvStartIsPended = true;
+		/* If the timer queue is full the next submit or the timeout of a transfer starts it */
+		if (xTimerPendFunctionCallFromISR(prvStartNextCallback, NULL, 0, NULL) != pdPASS)
+			prvStartIsPended = false;
+		return;
 	}
+
+	I2C2Transaction* transaction = prvQueueHead[priority];
+	prvQueueHead[priority] = transaction->next;
+	if (prvQueueHead[priority] == 0)
+		prvQueueTail[priority] = 0;
+
+	transaction->state = I2C2TransactionState_Active;
+	prvActiveTransaction = transaction;
+	prvIndex = 0;
+
+	/* The reads clear ACK at the end, a two byte read only acks its first byte if ACK is set before the address */
+	I2C_PERIPHERAL->CR1 = (I2C_PERIPHERAL->CR1 & ~I2C_CR1_POS) | I2C_CR1_ACK;
+	I2C_PERIPHERAL->CR2 = (I2C_PERIPHERAL->CR2 & ~I2C_CR2_ITBUFEN) | I2C_CR2_ITEVTEN | I2C_CR2_ITERREN;
+	prvPhase = I2C2Phase_Start;
+	I2C_PERIPHERAL->CR1 |= I2C_CR1_START;
 }
 
 /**
- * @brief	Transmits data as a master to a slave, used in ISR
- * @param	DevAddress: Address for the slave device
- * @param	Data: Pointer to a buffer where data will be stored
- * @param	Size: Size of the amount of data to receive
+ * @brief	Finish the active transaction and start the next one
+ * @param	Status: SUCCESS if the transaction went ok
  * @retval	None
+ * @note	Must be called with the I2C interrupts masked or from the I2C interrupts
  */
-void I2C2_ReceiveFromISR(uint8_t DevAddress, uint8_t* pBuffer, uint16_t Size)
+static void prvComplete(ErrorStatus Status)
 {
-	/* Try to take the semaphore in case some other process is using the device */
-	if (xSemaphoreTakeFromISR(xSemaphore, NULL) == pdTRUE)
+	I2C2Transaction* transaction = prvActiveTransaction;
+
+	/* CR1 is left alone, the stop condition may still be waiting to be sent */
+	I2C_PERIPHERAL->CR2 &= ~(I2C_CR2_ITBUFEN | I2C_CR2_ITEVTEN);
+	prvActiveTransaction = 0;
+	prvPhase = I2C2Phase_Idle;
+
+	I2C2ClientStats* stats = &prvStats[transaction->client];
+	uint32_t latency = (DWT->CYCCNT - transaction->submitCycles) / (SystemCoreClock / 1000000);
+	stats->numOfTransactions++;
+	stats->totalLatency += latency;
+	if (latency > stats->maxLatency)
+		stats->maxLatency = latency;
+
+	if (Status == SUCCESS)
+		transaction->state = I2C2TransactionState_Done;
+	else
 	{
-		HAL_I2C_Master_Receive(&I2C_Handle, (uint16_t)(DevAddress << 1), pBuffer, Size, 500); /* TODO: Check timeout value */
-		xSemaphoreGiveFromISR(xSemaphore, NULL);
+		transaction->state = I2C2TransactionState_Error;
+		stats->numOfErrors++;
 	}
+
+	/* The callback may submit a new transaction so the next one is started after it */
+	if (transaction->callback != 0)
+		transaction->callback(transaction);
+	prvStartNext();
+}
+
+/**
+ * @brief	Busy wait using the cycle counter
+ * @param	Microseconds: Time to wait
+ * @retval	None
+ */
+static void prvDelayUs(uint32_t Microseconds)
+{
+	uint32_t startCycles = DWT->CYCCNT;
+	uint32_t cycles = Microseconds * (SystemCoreClock / 1000000);
+	while (DWT->CYCCNT - startCycles < cycles);
+}
+
+/**
+ * @brief	Recover the bus from the timer task after a bus error
+ * @param	pvParameter1: Not used
+ * @param	ulParameter2: Not used
+ * @retval	None
+ */
+static void prvRecoverBusCallback(void* pvParameter1, uint32_t ulParameter2)
+{
+	I2C2_RecoverBus();
+}
+
+/**
+ * @brief	Start the next transaction from the timer task once the last stop condition has been sent
+ * @param	pvParameter1: Not used
+ * @param	ulParameter2: Not used
+ * @retval	None
+ */
+static void prvStartNextCallback(void* pvParameter1, uint32_t ulParameter2)
+{
+	taskENTER_CRITICAL();
+	prvStartIsPended = false;
+	prvStartNext();
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief	Callback for the synchronous transfers
+ * @param	pTransaction: The transaction that is done
+ * @retval	None
+ */
+static void prvSyncTransferDone(I2C2Transaction* pTransaction)
+{
+	xSemaphoreGiveFromISR(xSyncDoneSemaphore, NULL);
+}
+
+/**
+ * @brief	Set up a transaction and wait until it's done
+ * @param	DevAddress: Address for the slave device
+ * @param	UseRegister: If the register address should be sent first
+ * @param	Register: The register address
+ * @param	Direction: Can be any value of I2C2Direction
+ * @param	pBuffer: The data
+ * @param	Size: Number of bytes
+ * @param	Client: The client doing the transfer, the touch controller gets high priority
+ * @retval	SUCCESS or ERROR
+ */
+static ErrorStatus prvSyncTransfer(uint8_t DevAddress, bool UseRegister, uint8_t Register, I2C2Direction Direction,
+								   uint8_t* pBuffer, uint16_t Size, I2C2Client Client)
+{
+	I2C2Transaction transaction = {
+			.devAddress			= DevAddress,
+			.useRegister		= UseRegister,
+			.registerAddress	= Register,
+			.direction			= Direction,
+			.pBuffer			= pBuffer,
+			.size				= Size,
+			.priority			= (Client == I2C2Client_Touch) ? I2C2Priority_High : I2C2Priority_Low,
+			.client				= Client,
+	};
+	return I2C2_Transfer(&transaction);
 }
 
 /* Interrupt Handlers --------------------------------------------------------*/
+/**
+  * @brief  This function handles I2C2 event interrupt request.
+  * @param  None
+  * @retval None
+  * @note	Follows the master transmitter/receiver sequences in the reference manual, the special
+  *			cases for the last bytes make sure NACK and STOP are set before the last byte is clocked in
+  */
+void I2C2_EV_IRQHandler(void)
+{
+	I2C2Transaction* transaction = prvActiveTransaction;
+	uint32_t sr1 = I2C_PERIPHERAL->SR1;
+
+	if (transaction == 0)
+	{
+		/* Nothing should happen without a transaction */
+		I2C_PERIPHERAL->CR2 &= ~(I2C_CR2_ITBUFEN | I2C_CR2_ITEVTEN);
+		return;
+	}
+
+	uint8_t address = transaction->devAddress << 1;
+	uint16_t size = transaction->size;
+
+	switch (prvPhase)
+	{
+		case I2C2Phase_Start:
+			if (sr1 & I2C_SR1_SB)
+			{
+				if (transaction->useRegister || transaction->direction == I2C2Direction_Write)
+				{
+					I2C_PERIPHERAL->DR = address;
+					prvPhase = I2C2Phase_AddressWrite;
+				}
+				else
+				{
+					I2C_PERIPHERAL->DR = address | 0x1;
+					prvPhase = I2C2Phase_AddressRead;
+				}
+			}
+			break;
+
+		case I2C2Phase_AddressWrite:
+			if (sr1 & I2C_SR1_ADDR)
+			{
+				(void)I2C_PERIPHERAL->SR2;
+				if (transaction->useRegister)
+					I2C_PERIPHERAL->DR = transaction->registerAddress;
+				else if (size != 0)
+					I2C_PERIPHERAL->DR = transaction->pBuffer[prvIndex++];
+				else
+				{
+					/* Only the address, e.g. to check if the slave is there */
+					I2C_PERIPHERAL->CR1 |= I2C_CR1_STOP;
+					prvComplete(SUCCESS);
+					break;
+				}
+				prvPhase = I2C2Phase_Transmit;
+			}
+			break;
+
+		case I2C2Phase_Transmit:
+			if (sr1 & I2C_SR1_BTF)
+			{
+				if (transaction->direction == I2C2Direction_Read)
+				{
+					I2C_PERIPHERAL->CR1 |= I2C_CR1_START;
+					prvPhase = I2C2Phase_RepeatedStart;
+				}
+				else if (prvIndex < size)
+					I2C_PERIPHERAL->DR = transaction->pBuffer[prvIndex++];
+				else
+				{
+					I2C_PERIPHERAL->CR1 |= I2C_CR1_STOP;
+					prvComplete(SUCCESS);
+				}
+			}
+			break;
+
+		case I2C2Phase_RepeatedStart:
+			/* BTF stays set until the start condition has been sent */
+			if (sr1 & I2C_SR1_SB)
+			{
+				I2C_PERIPHERAL->DR = address | 0x1;
+				prvPhase = I2C2Phase_AddressRead;
+			}
+			break;
+
+		case I2C2Phase_AddressRead:
+			if (sr1 & I2C_SR1_ADDR)
+			{
+				if (size == 1)
+				{
+					I2C_PERIPHERAL->CR1 &= ~I2C_CR1_ACK;
+					(void)I2C_PERIPHERAL->SR2;
+					I2C_PERIPHERAL->CR1 |= I2C_CR1_STOP;
+					I2C_PERIPHERAL->CR2 |= I2C_CR2_ITBUFEN;
+					prvPhase = I2C2Phase_Receive;
+				}
+				else if (size == 2)
+				{
+					I2C_PERIPHERAL->CR1 &= ~I2C_CR1_ACK;
+					I2C_PERIPHERAL->CR1 |= I2C_CR1_POS;
+					(void)I2C_PERIPHERAL->SR2;
+					prvPhase = I2C2Phase_ReceiveLastTwo;
+				}
+				else
+				{
+					I2C_PERIPHERAL->CR1 |= I2C_CR1_ACK;
+					(void)I2C_PERIPHERAL->SR2;
+					if (size == 3)
+						prvPhase = I2C2Phase_ReceiveLastThree;
+					else
+					{
+						I2C_PERIPHERAL->CR2 |= I2C_CR2_ITBUFEN;
+						prvPhase = I2C2Phase_Receive;
+					}
+				}
+			}
+			break;
+
+		case I2C2Phase_Receive:
+			if (sr1 & I2C_SR1_RXNE)
+			{
+				transaction->pBuffer[prvIndex++] = I2C_PERIPHERAL->DR;
+				if (prvIndex == size)
+					prvComplete(SUCCESS);
+				else if (size - prvIndex == 3)
+				{
+					/* The last three bytes are handled with BTF */
+					I2C_PERIPHERAL->CR2 &= ~I2C_CR2_ITBUFEN;
+					prvPhase = I2C2Phase_ReceiveLastThree;
+				}
+			}
+			break;
+
+		case I2C2Phase_ReceiveLastThree:
+			/* Byte N-2 in DR and N-1 in the shift register, NACK byte N */
+			if (sr1 & I2C_SR1_BTF)
+			{
+				I2C_PERIPHERAL->CR1 &= ~I2C_CR1_ACK;
+				transaction->pBuffer[prvIndex++] = I2C_PERIPHERAL->DR;
+				prvPhase = I2C2Phase_ReceiveLastTwo;
+			}
+			break;
+
+		case I2C2Phase_ReceiveLastTwo:
+			/* Byte N-1 in DR and N in the shift register */
+			if (sr1 & I2C_SR1_BTF)
+			{
+				I2C_PERIPHERAL->CR1 |= I2C_CR1_STOP;
+				transaction->pBuffer[prvIndex++] = I2C_PERIPHERAL->DR;
+				transaction->pBuffer[prvIndex++] = I2C_PERIPHERAL->DR;
+				prvComplete(SUCCESS);
+			}
+			break;
+
+		default:
+			break;
+	}
+}
+
+/**
+  * @brief  This function handles I2C2 error interrupt request.
+  * @param  None
+  * @retval None
+  */
+void I2C2_ER_IRQHandler(void)
+{
+	uint32_t sr1 = I2C_PERIPHERAL->SR1;
+
+	/* The error flags are cleared by writing 0 to them */
+	I2C_PERIPHERAL->SR1 = ~(sr1 & I2C_ERROR_FLAGS);
+
+	/* No acknowledge, release the bus */
+	if (sr1 & I2C_SR1_AF)
+		I2C_PERIPHERAL->CR1 |= I2C_CR1_STOP;
+
+	/* Bus error or lost arbitration means something else is driving the lines, reset the bus outside of the interrupt */
+	if ((sr1 & (I2C_SR1_BERR | I2C_SR1_ARLO)) && !prvBusNeedsRecovery)
+	{
+		prvBusNeedsRecovery = true;
+		if (xTimerPendFunctionCallFromISR(prvRecoverBusCallback, NULL, 0, NULL) != pdPASS)
+			prvBusNeedsRecovery = false;
+	}
+
+	if (prvActiveTransaction != 0)
+		prvComplete(ERROR);
+}
@@ -0,0 +1,298 @@
+/**
+ ******************************************************************************
+ * @file	lcd_format.c
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2014-09-07
+ * @brief	Formatting of data as text before it's written to the LCD. Kept
+ *			apart from the RA8875 driver as it doesn't touch the hardware.
+ ******************************************************************************
+	Copyright (c) 2014 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "lcd_format.h"
+
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+/* Compile time generation of the format tables, the first character is in the low byte */
+#define HEX_CHAR(N)					((N) < 10 ? '0' + (N) : 'A' - 10 + (N))
+#define HEX_PAIR(B)					(HEX_CHAR((B) >> 4) | (HEX_CHAR((B) & 0xF) << 8))
+#define HEX_PAIR_ROW(H)				HEX_PAIR(H##0), HEX_PAIR(H##1), HEX_PAIR(H##2), HEX_PAIR(H##3), \
+									HEX_PAIR(H##4), HEX_PAIR(H##5), HEX_PAIR(H##6), HEX_PAIR(H##7), \
+									HEX_PAIR(H##8), HEX_PAIR(H##9), HEX_PAIR(H##A), HEX_PAIR(H##B), \
+									HEX_PAIR(H##C), HEX_PAIR(H##D), HEX_PAIR(H##E), HEX_PAIR(H##F)
+#define BINARY_NIBBLE(N)			(('0' + (((N) >> 3) & 1)) | (('0' + (((N) >> 2) & 1)) << 8) | \
+									(('0' + (((N) >> 1) & 1)) << 16) | (('0' + ((N) & 1)) << 24))
+
+/* Private variables ---------------------------------------------------------*/
+/* Two hex characters for every byte value, used so a byte is formatted with one lookup */
+static const uint16_t prvHexPairTable[256] = {
+		HEX_PAIR_ROW(0x0), HEX_PAIR_ROW(0x1), HEX_PAIR_ROW(0x2), HEX_PAIR_ROW(0x3),
+		HEX_PAIR_ROW(0x4), HEX_PAIR_ROW(0x5), HEX_PAIR_ROW(0x6), HEX_PAIR_ROW(0x7),
+		HEX_PAIR_ROW(0x8), HEX_PAIR_ROW(0x9), HEX_PAIR_ROW(0xA), HEX_PAIR_ROW(0xB),
+		HEX_PAIR_ROW(0xC), HEX_PAIR_ROW(0xD), HEX_PAIR_ROW(0xE), HEX_PAIR_ROW(0xF),
+};
+
+/* Four binary characters for every nibble value */
+static const uint32_t prvBinaryNibbleTable[16] = {
+		BINARY_NIBBLE(0x0), BINARY_NIBBLE(0x1), BINARY_NIBBLE(0x2), BINARY_NIBBLE(0x3),
+		BINARY_NIBBLE(0x4), BINARY_NIBBLE(0x5), BINARY_NIBBLE(0x6), BINARY_NIBBLE(0x7),
+		BINARY_NIBBLE(0x8), BINARY_NIBBLE(0x9), BINARY_NIBBLE(0xA), BINARY_NIBBLE(0xB),
+		BINARY_NIBBLE(0xC), BINARY_NIBBLE(0xD), BINARY_NIBBLE(0xE), BINARY_NIBBLE(0xF),
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static inline uint32_t prvLCD_HexFromTwoBytes(uint32_t Bytes);
+static uint32_t prvLCD_FormatHexWithoutSpaces(const uint8_t* pSource, uint32_t Size, uint8_t* pDestination);
+static uint32_t prvLCD_FormatHexWithSpaces(const uint8_t* pSource, uint32_t Size, uint8_t* pDestination);
+static uint32_t prvLCD_FormatDecimal(const uint8_t* pSource, uint32_t Size, uint8_t* pDestination);
+static uint32_t prvLCD_FormatBinary(const uint8_t* pSource, uint32_t Size, uint8_t* pDestination);
+static uint32_t prvLCD_FormatCEscaped(const uint8_t* pSource, uint32_t Size, uint8_t* pDestination);
+
+/* Functions -----------------------------------------------------------------*/
+/**
+ * @brief	Format a buffer as text
+ * @param	pSource: The data to format
+ * @param	Size: Size of the data
+ * @param	pDestination: Where to put the characters, must have room for Size * LCD_MAX_CHARS_PER_FORMATTED_BYTE
+ * 			characters or for LCDTextFormat_HexDump a full row of LCD_HEX_DUMP_CHARS_PER_ROW for every started row
+ * @param	Format: The format to use, can be any value of LCDTextFormat
+ * @retval	The number of characters written to pDestination
+ * @note	The loop is specialised per format so there's no branch on the format for every byte
+ */
+uint32_t LCD_FormatBuffer(const uint8_t* pSource, uint32_t Size, uint8_t* pDestination, LCDTextFormat Format)
+{
+	switch (Format)
+	{
+		case LCDTextFormat_ASCII:
+			memcpy(pDestination, pSource, Size);
+			return Size;
+		case LCDTextFormat_HexWithSpaces:
+			return prvLCD_FormatHexWithSpaces(pSource, Size, pDestination);
+		case LCDTextFormat_HexWithoutSpaces:
+			return prvLCD_FormatHexWithoutSpaces(pSource, Size, pDestination);
+		case LCDTextFormat_Decimal:
+			return prvLCD_FormatDecimal(pSource, Size, pDestination);
+		case LCDTextFormat_Binary:
+			return prvLCD_FormatBinary(pSource, Size, pDestination);
+		case LCDTextFormat_CEscaped:
+			return prvLCD_FormatCEscaped(pSource, Size, pDestination);
+		case LCDTextFormat_HexDump:
+			return LCD_FormatHexDump(pSource, Size, 0, pDestination);
+		default:
+			return 0;
+	}
+}
+
+/**
+ * @brief	Format as a classic hex dump, "0010: 48 65 6C 6C 6F 0D 0A 00 | Hello..."
+ * @param	pSource: The data to format
+ * @param	Size: Size of the data
+ * @param	Offset: Offset of the first byte which is shown at the start of the first row
+ * @param	pDestination: Where to put the characters
+ * @retval	The number of characters written, always full rows of LCD_HEX_DUMP_CHARS_PER_ROW
+ */
+uint32_t LCD_FormatHexDump(const uint8_t* pSource, uint32_t Size, uint32_t Offset, uint8_t* pDestination)
+{
+	uint32_t numOfChars = 0;
+	for (uint32_t rowStart = 0; rowStart < Size; rowStart += LCD_HEX_DUMP_BYTES_PER_ROW)
+	{
+		uint8_t* pRow = &pDestination[numOfChars];
+		uint32_t rowSize = Size - rowStart;
+		if (rowSize > LCD_HEX_DUMP_BYTES_PER_ROW)
+			rowSize = LCD_HEX_DUMP_BYTES_PER_ROW;
+
+		/* Offset */
+		uint32_t offset = Offset + rowStart;
+		memcpy(&pRow[0], &prvHexPairTable[(offset >> 8) & 0xFF], 2);
+		memcpy(&pRow[2], &prvHexPairTable[offset & 0xFF], 2);
+		pRow[4] = ':';
+		pRow[5] = ' ';
+
+		/* Hex, a short last row is padded so the ASCII column lines up */
+		uint8_t* pHex = &pRow[6];
+		prvLCD_FormatHexWithSpaces(&pSource[rowStart], rowSize, pHex);
+		memset(&pHex[rowSize * 3], ' ', (LCD_HEX_DUMP_BYTES_PER_ROW - rowSize) * 3);
+
+		/* ASCII, non-printable characters are shown as '.' */
+		uint8_t* pAscii = &pHex[LCD_HEX_DUMP_BYTES_PER_ROW * 3];
+		*pAscii++ = '|';
+		*pAscii++ = ' ';
+		for (uint32_t i = 0; i < LCD_HEX_DUMP_BYTES_PER_ROW; i++)
+		{
+			if (i >= rowSize)
+				pAscii[i] = ' ';
+			else if (pSource[rowStart + i] >= 0x20 && pSource[rowStart + i] <= 0x7E)
+				pAscii[i] = pSource[rowStart + i];
+			else
+				pAscii[i] = '.';
+		}
+
+		numOfChars += LCD_HEX_DUMP_CHARS_PER_ROW;
+	}
+	return numOfChars;
+}
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief	Convert two bytes to four hex characters at the same time
+ * @param	Bytes: The first byte in bits 0-7 and the second byte in bits 16-23
+ * @retval	The four characters, the first character is in the low byte
+ */
+static inline uint32_t prvLCD_HexFromTwoBytes(uint32_t Bytes)
+{
+	/* Spread the nibbles so every byte of the word holds one nibble in the order they should be written */
+	uint32_t nibbles = ((Bytes >> 4) & 0x000F000F) | ((Bytes & 0x000F000F) << 8);
+	/* Adding 6 sets bit 4 for the nibbles that are 10 or above, they need 7 extra to get to 'A' */
+	uint32_t letters = ((nibbles + 0x06060606) >> 4) & 0x01010101;
+	return nibbles + 0x30303030 + letters * 7;
+}
+
+/**
+ * @brief	Format as hex without spaces, "41"
+ * @param	pSource: The data to format
+ * @param	Size: Size of the data
+ * @param	pDestination: Where to put the characters
+ * @retval	The number of characters written
+ */
+static uint32_t prvLCD_FormatHexWithoutSpaces(const uint8_t* pSource, uint32_t Size, uint8_t* pDestination)
+{
+	uint32_t i = 0;
+	/* Four bytes at a time to eight characters */
+	for (; i + 4 <= Size; i += 4)
+	{
+		uint32_t characters[2];
+		characters[0] = prvLCD_HexFromTwoBytes(pSource[i] | (pSource[i+1] << 16));
+		characters[1] = prvLCD_HexFromTwoBytes(pSource[i+2] | (pSource[i+3] << 16));
+		memcpy(&pDestination[i*2], characters, sizeof(characters));
+	}
+	/* The remaining bytes */
+	for (; i < Size; i++)
+		memcpy(&pDestination[i*2], &prvHexPairTable[pSource[i]], 2);
+	return Size * 2;
+}
+
+/**
+ * @brief	Format as hex with spaces, "41 "
+ * @param	pSource: The data to format
+ * @param	Size: Size of the data
+ * @param	pDestination: Where to put the characters
+ * @retval	The number of characters written
+ */
+static uint32_t prvLCD_FormatHexWithSpaces(const uint8_t* pSource, uint32_t Size, uint8_t* pDestination)
+{
+	for (uint32_t i = 0; i < Size; i++)
+	{
+		memcpy(pDestination, &prvHexPairTable[pSource[i]], 2);
+		pDestination[2] = ' ';
+		pDestination += 3;
+	}
+	return Size * 3;
+}
+
+/**
+ * @brief	Format as right aligned decimal, " 65 "
+ * @param	pSource: The data to format
+ * @param	Size: Size of the data
+ * @param	pDestination: Where to put the characters
+ * @retval	The number of characters written
+ */
+static uint32_t prvLCD_FormatDecimal(const uint8_t* pSource, uint32_t Size, uint8_t* pDestination)
+{
+	for (uint32_t i = 0; i < Size; i++)
+	{
+		uint32_t value = pSource[i];
+		uint32_t hundreds = value / 100;
+		uint32_t tens = (value / 10) % 10;
+		pDestination[0] = hundreds ? '0' + hundreds : ' ';
+		pDestination[1] = (hundreds || tens) ? '0' + tens : ' ';
+		pDestination[2] = '0' + value % 10;
+		pDestination[3] = ' ';
+		pDestination += 4;
+	}
+	return Size * 4;
+}
+
+/**
+ * @brief	Format as binary, "01000001 "
+ * @param	pSource: The data to format
+ * @param	Size: Size of the data
+ * @param	pDestination: Where to put the characters
+ * @retval	The number of characters written
+ */
+static uint32_t prvLCD_FormatBinary(const uint8_t* pSource, uint32_t Size, uint8_t* pDestination)
+{
+	for (uint32_t i = 0; i < Size; i++)
+	{
+		memcpy(&pDestination[0], &prvBinaryNibbleTable[pSource[i] >> 4], 4);
+		memcpy(&pDestination[4], &prvBinaryNibbleTable[pSource[i] & 0x0F], 4);
+		pDestination[8] = ' ';
+		pDestination += 9;
+	}
+	return Size * 9;
+}
+
+/**
+ * @brief	Format as C escaped ASCII where every byte takes 4 characters, "A   ", "\n  " or "\x1B"
+ * @param	pSource: The data to format
+ * @param	Size: Size of the data
+ * @param	pDestination: Where to put the characters
+ * @retval	The number of characters written
+ */
+static uint32_t prvLCD_FormatCEscaped(const uint8_t* pSource, uint32_t Size, uint8_t* pDestination)
+{
+	for (uint32_t i = 0; i < Size; i++)
+	{
+		uint8_t value = pSource[i];
+		uint8_t escape = 0;
+		switch (value)
+		{
+			case '\0':	escape = '0';	break;
+			case '\a':	escape = 'a';	break;
+			case '\b':	escape = 'b';	break;
+			case '\t':	escape = 't';	break;
+			case '\n':	escape = 'n';	break;
+			case '\v':	escape = 'v';	break;
+			case '\f':	escape = 'f';	break;
+			case '\r':	escape = 'r';	break;
+			case '\\':	escape = '\\';	break;
+			default:	break;
+		}
+
+		/* Fill with spaces first and then overwrite with the actual characters */
+		memset(pDestination, ' ', 4);
+		if (escape != 0)
+		{
+			pDestination[0] = '\\';
+			pDestination[1] = escape;
+		}
+		else if (value >= 0x20 && value <= 0x7E)
+		{
+			pDestination[0] = value;
+		}
+		else
+		{
+			pDestination[0] = '\\';
+			pDestination[1] = 'x';
+			memcpy(&pDestination[2], &prvHexPairTable[value], 2);
+		}
+		pDestination += 4;
+	}
+	return Size * 4;
+}
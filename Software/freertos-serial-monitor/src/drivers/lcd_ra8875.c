@@ -28,31 +28,104 @@
 #include "lcd_ra8875_registers.h"
 
 #include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
 
 /* Private defines -----------------------------------------------------------*/
+#define LCD_WAIT_PORT				(GPIOD)
+#define LCD_WAIT_PIN				(GPIO_PIN_11)
+
+/* Only DMA2 can do memory-to-memory transfers */
+#define LCD_DMA_STREAM				(DMA2_Stream0)
+#define LCD_DMA_CHANNEL				(DMA_CHANNEL_0)
+#define LCD_DMA_IRQn				(DMA2_Stream0_IRQn)
+#define LCD_DMA_CLK_ENABLE()		(__DMA2_CLK_ENABLE())
+
+/*
+ * Max number of pixels in one DMA transfer, a full screen is sent in about 24 chunks. The FSMC
+ * doesn't use the WAIT signal (NWAIT is taken by the touch interrupt) so nothing holds the DMA
+ * back inside a chunk. Instead the FSMC data phase is stretched to LCD_DMA_DATA_SETUP_TIME
+ * while the DMA runs, that is about 100 ns per pixel which the RA8875 memory write FIFO keeps
+ * up with, and the next chunk is only started from the WAIT interrupt.
+ */
+#define LCD_DMA_CHUNK_SIZE			(16384)
+#define LCD_DMA_DATA_SETUP_TIME		(12)
+#define LCD_DMA_TIMEOUT				(1000)
+
+/* The CCM RAM is only connected to the D-bus so the DMA can't read from it */
+#define IS_LCD_DMA_ADDRESS(X)		(((uint32_t)(X) < 0x10000000) || ((uint32_t)(X) >= 0x10010000))
+
+/* Packet header for compressed images, see Software/tools/lcd_image_converter.py */
+#define LCD_RLE_RUN_FLAG			(0x80)
+#define LCD_RLE_LENGTH_MASK			(0x7F)
+
+/* Number of bytes formatted at a time before they are written to the LCD */
+#define LCD_FORMAT_CHUNK_SIZE		(LCD_HEX_DUMP_BYTES_PER_ROW)
+#define LCD_FORMAT_BUFFER_SIZE		(LCD_FORMAT_CHUNK_SIZE * LCD_MAX_CHARS_PER_FORMATTED_BYTE)
+
+/* Bus accesses through the FSMC, the host tests define them to run the driver against a simulated RA8875 */
+#ifndef LCD_BUS_WRITE_REG
+#define LCD_BUS_WRITE_REG(VALUE)	(*LCD.LCD_REG = (VALUE))
+#define LCD_BUS_WRITE_RAM(VALUE)	(*LCD.LCD_RAM = (VALUE))
+#define LCD_BUS_READ_REG()			(*LCD.LCD_REG)
+#define LCD_BUS_READ_RAM()			(*LCD.LCD_RAM)
+#endif
+
 /* Private typedefs ----------------------------------------------------------*/
 typedef struct
 {
 	__IO uint16_t *LCD_REG;
 	__IO uint16_t *LCD_RAM;
 	SemaphoreHandle_t xWaitSemaphore;	/* Semaphore for the wait signal */
+	SemaphoreHandle_t xDMASemaphore;	/* Semaphore for when a DMA transfer is done */
 } LCD_TypeDef;
 
 /* Private variables ---------------------------------------------------------*/
 static LCD_TypeDef LCD;
 static SemaphoreHandle_t xLCDSemaphore;
 
-static const uint8_t prvHexTable[16] = {
-		'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+static uint8_t prvCurrentBrightness;
+
+/* Window all drawing is limited to, the full screen unless a clipped redraw is in progress */
+static LCDActiveWindow prvClipWindow = {0, 799, 0, 479};
+
+/* Character cells of text that is partly outside the clip window, the RA8875 can only skip whole characters */
+static bool prvTextIsClipped = false;
+static bool prvTextCursorIsSynced;
+static LCDActiveWindow prvTextWindow;
+static uint16_t prvTextXPos;
+static uint16_t prvTextYPos;
+static uint16_t prvTextCharWidth;
+static uint16_t prvTextCharHeight;
+
+static DMA_HandleTypeDef DMA_Handle = {
+		.Instance					= LCD_DMA_STREAM,
+		.Init.Channel 				= LCD_DMA_CHANNEL,
+		.Init.Direction 			= DMA_MEMORY_TO_MEMORY,
+		.Init.PeriphInc 			= DMA_PINC_ENABLE,		/* Source: the pixel data */
+		.Init.MemInc 				= DMA_MINC_DISABLE,		/* Destination: the FSMC data address */
+		.Init.PeriphDataAlignment 	= DMA_PDATAALIGN_HALFWORD,
+		.Init.MemDataAlignment 		= DMA_MDATAALIGN_HALFWORD,
+		.Init.Mode 					= DMA_NORMAL,
+		.Init.Priority				= DMA_PRIORITY_MEDIUM,
+		.Init.FIFOMode 				= DMA_FIFOMODE_ENABLE,	/* Direct mode is not allowed for memory-to-memory */
+		.Init.FIFOThreshold      	= DMA_FIFO_THRESHOLD_FULL,
+		.Init.MemBurst				= DMA_MBURST_SINGLE,
+		.Init.PeriphBurst			= DMA_PBURST_SINGLE,
 };
 
-static uint8_t prvCurrentBrightness;
+/* State of the current DMA transfer, shared between the task and the interrupts */
+static volatile uint32_t prvDMASourceAddress = 0;
+static volatile uint32_t prvDMAPixelsLeft = 0;
+static volatile bool prvDMAIsWaitingForLcd = false;
+static volatile bool prvDMAErrorOccurred = false;
 
 /* Private function prototypes -----------------------------------------------*/
 static void prvLCD_GPIOConfig();
 static void prvLCD_FSMCConfig();
 static void prvLCD_InterruptConfig();
 static void prvLCD_PLLInit();
+static void prvLCD_DMAInit();
 
 static inline void prvLCD_CmdWrite(uint16_t Command);
 static inline void prvLCD_DataWrite(uint16_t Data);
@@ -64,10 +137,26 @@ static void prvLCD_CheckBusy();
 static void prvLCD_CheckBTEBusy();
 
 static void prvLCD_SetActiveWindow(uint16_t XLeft, uint16_t XRight, uint16_t YTop, uint16_t YBottom);
-
+static inline void prvLCD_RestoreClipWindow();
+
+static void prvLCD_BTESize(uint16_t Width, uint16_t Height);
+static void prvLCD_BTESourceDestinationPoints(uint16_t SourceX, uint16_t SourceY, uint16_t DestinationX, uint16_t DestinationY);
+static void prvLCD_BTEStartImageWrite(uint16_t Width, uint16_t Height, uint16_t XPos, uint16_t YPos);
+static inline uint16_t prvLCD_ReadCompressedPixel(const uint8_t** ppData, const uint16_t* pPalette);
+
+static ErrorStatus prvLCD_DMAWritePixels(const uint16_t* pPixels, uint32_t NumOfPixels);
+static void prvLCD_DMAStartNextChunk();
+static void prvLCD_DMARequestNextChunk();
+static void prvLCD_DMATransferCompleteCallback(DMA_HandleTypeDef* hdma);
+static void prvLCD_DMATransferErrorCallback(DMA_HandleTypeDef* hdma);
+
+static void prvLCD_BeginText(LCDActiveWindow Window, LCDFontEnlarge Enlargement);
+static inline void prvLCD_WriteTextChar(uint8_t Char);
+static void prvLCD_WriteClippedTextChar(uint8_t Char);
+static void prvLCD_EndText();
 static void prvLCD_WriteString(uint8_t *String);
 static void prvLCD_WriteBuffer(uint8_t *pBuffer, uint32_t Size);
-static void prvLCD_WriteBufferWithFormat(uint8_t *pBuffer, uint32_t Size, LCDTextFormat Format);
+static void prvLCD_WriteBufferWithFormat(uint8_t *pBuffer, uint32_t Size, LCDTextFormat Format, uint32_t CharsPerRow);
 static void prvLCD_SetTextWritePosition(uint16_t XPos, uint16_t YPos);
 static void prvLCD_GetTextWritePosition(uint16_t* XPos, uint16_t* YPos);
 
@@ -98,9 +187,13 @@ void LCD_Init()
 	/* Give the semaphore because the LCD should be when we start */
 	xSemaphoreGive(LCD.xWaitSemaphore);
 
+	/* Given from the DMA interrupt when all pixels of a transfer have been written */
+	LCD.xDMASemaphore = xSemaphoreCreateBinary();
+
 	prvLCD_GPIOConfig();
 	prvLCD_FSMCConfig();
-//	prvLCD_InterruptConfig();
+	prvLCD_InterruptConfig();
+	prvLCD_DMAInit();
 
 	/* Software reset the LCD */
 	prvLCD_WriteCommandWithData(LCD_PWRR, 0x01);
@@ -181,14 +274,56 @@ void LCD_ClearActiveWindow(uint16_t XLeft, uint16_t XRight, uint16_t YTop, uint1
 	/* Try to take the semaphore */
 	xSemaphoreTake(xLCDSemaphore, portMAX_DELAY);
 
-	prvLCD_SetActiveWindow(XLeft, XRight, YTop, YBottom);
-	prvLCD_WriteCommandWithData(LCD_MCLR, 0xC0);
-	prvLCD_SetActiveWindow(0, 799, 0, 479);		/* Restore the active window to the full screen */
+	/* Only clear the part that is inside the clip window */
+	if (XLeft < prvClipWindow.xLeft) XLeft = prvClipWindow.xLeft;
+	if (XRight > prvClipWindow.xRight) XRight = prvClipWindow.xRight;
+	if (YTop < prvClipWindow.yTop) YTop = prvClipWindow.yTop;
+	if (YBottom > prvClipWindow.yBottom) YBottom = prvClipWindow.yBottom;
+
+	if (XLeft <= XRight && YTop <= YBottom)
+	{
+		prvLCD_SetActiveWindow(XLeft, XRight, YTop, YBottom);
+		prvLCD_WriteCommandWithData(LCD_MCLR, 0xC0);
+		prvLCD_RestoreClipWindow();
+	}
 
 	/* Give back the semaphore */
 	xSemaphoreGive(xLCDSemaphore);
 }
 
+/**
+ * @brief	Limit all drawing to a window
+ * @param	Window: The window to limit drawing to
+ * @retval	None
+ * @note	Clears, geometric drawing and BTE writes are clipped by the RA8875 active window. Text is written
+ * 			in its own window so it wraps like normal and only characters completely inside the clip window are
+ * 			drawn, the RA8875 can't draw part of a character. Callers should make the window cover whole objects.
+ */
+void LCD_SetClipWindow(LCDActiveWindow Window)
+{
+	/* Try to take the semaphore */
+	xSemaphoreTake(xLCDSemaphore, portMAX_DELAY);
+
+	if (Window.xRight > 799) Window.xRight = 799;
+	if (Window.yBottom > 479) Window.yBottom = 479;
+	prvClipWindow = Window;
+	prvLCD_RestoreClipWindow();
+
+	/* Give back the semaphore */
+	xSemaphoreGive(xLCDSemaphore);
+}
+
+/**
+ * @brief	Stop limiting drawing to the clip window
+ * @param	None
+ * @retval	None
+ */
+void LCD_ResetClipWindow()
+{
+	LCDActiveWindow fullScreen = {0, 799, 0, 479};
+	LCD_SetClipWindow(fullScreen);
+}
+
 /**
  * @brief	Sets the brightness of the backlight
  * @param	Brightness: A value between 0 and 255 where 255 is fully on
@@ -397,9 +532,25 @@ void LCD_WriteString(uint8_t *String, LCDTransparency TransparentBackground, LCD
 		fontControlValue |= 0x0F;
 	prvLCD_WriteCommandWithData(LCD_FNCR1, fontControlValue);
 
+	/* Text should not wrap at the edge of the clip window so write it in the full screen */
+	bool isClipped = (prvClipWindow.xLeft != 0 || prvClipWindow.xRight != 799 ||
+					  prvClipWindow.yTop != 0 || prvClipWindow.yBottom != 479);
+	if (isClipped)
+	{
+		LCDActiveWindow fullScreen = {0, 799, 0, 479};
+		prvLCD_SetActiveWindow(0, 799, 0, 479);
+		prvLCD_BeginText(fullScreen, Enlargement);
+	}
+
 	/* Write the string */
 	prvLCD_WriteString(String);
 
+	if (isClipped)
+	{
+		prvLCD_EndText();
+		prvLCD_RestoreClipWindow();
+	}
+
 	/* Give back the semaphore */
 	xSemaphoreGive(xLCDSemaphore);
 }
@@ -440,13 +591,15 @@ void LCD_WriteStringInActiveWindowAtPosition(uint8_t *String, LCDTransparency Tr
 	prvLCD_WriteCommandWithData(LCD_FNCR1, fontControlValue);
 
 	/* Write the string */
+	prvLCD_BeginText(Window, Enlargement);
 	prvLCD_WriteString(String);
+	prvLCD_EndText();
 
 	/* Get the text write position */
 	prvLCD_GetTextWritePosition(XPos, YPos);
 
 	/* Reset the active window */
-	prvLCD_SetActiveWindow(0, 799, 0, 479);
+	prvLCD_RestoreClipWindow();
 
 	/* Give back the semaphore */
 	xSemaphoreGive(xLCDSemaphore);
@@ -492,13 +645,15 @@ void LCD_WriteBufferInActiveWindowAtPosition(uint8_t *pBuffer, uint32_t Size, LC
 		prvLCD_WriteCommandWithData(LCD_FNCR1, fontControlValue);	/* Time usage: ~0.7 us */
 
 		/* Write the buffer */
+		prvLCD_BeginText(Window, Enlargement);
 		prvLCD_WriteBuffer(pBuffer, Size);			/* Time usage: ~3.6 us/byte, with 64 bytes max ~228us */
+		prvLCD_EndText();
 
 		/* Get the text write position */
 		prvLCD_GetTextWritePosition(XPos, YPos);	/* Time usage: ~1.0 us */
 
 		/* Reset the active window */
-		prvLCD_SetActiveWindow(0, 799, 0, 479);		/* Time usage: ~2.8 us */
+		prvLCD_RestoreClipWindow();					/* Time usage: ~2.8 us */
 
 		/* Give back the semaphore */
 		xSemaphoreGive(xLCDSemaphore);				/* Time usage: ~2.0 us */
@@ -543,14 +698,17 @@ void LCD_WriteBufferInActiveWindowAtPositionWithFormat(uint8_t *pBuffer, uint32_
 		fontControlValue |= 0x0F;
 	prvLCD_WriteCommandWithData(LCD_FNCR1, fontControlValue);	/* Time usage: ~0.7 us */
 
-	/* Write the buffer */
-	prvLCD_WriteBufferWithFormat(pBuffer, Size, Format);	/* Time usage: ~3.6 us/byte, with 64 bytes max ~228us */
+	/* Write the buffer, hex dump rows are padded to fill the width of the window */
+	uint32_t charsPerRow = (Window.xRight - Window.xLeft + 1) / (8 * Enlargement);
+	prvLCD_BeginText(Window, Enlargement);
+	prvLCD_WriteBufferWithFormat(pBuffer, Size, Format, charsPerRow);
+	prvLCD_EndText();
 
 	/* Get the text write position */
 	prvLCD_GetTextWritePosition(XPos, YPos);	/* Time usage: ~1.0 us */
 
 	/* Reset the active window */
-	prvLCD_SetActiveWindow(0, 799, 0, 479);		/* Time usage: ~2.8 us */
+	prvLCD_RestoreClipWindow();					/* Time usage: ~2.8 us */
 
 	/* Give back the semaphore */
 	xSemaphoreGive(xLCDSemaphore);				/* Time usage: ~2.0 us */
@@ -710,18 +868,7 @@ void LCD_BTESize(uint16_t Width, uint16_t Height)
 	/* Try to take the semaphore */
 	xSemaphoreTake(xLCDSemaphore, portMAX_DELAY);
 
-	uint16_t temp;
-	temp = Width;
-	/* BTE Width */
-	prvLCD_WriteCommandWithData(LCD_BEWR0, temp);
-	temp = Width >> 8;
-	prvLCD_WriteCommandWithData(LCD_BEWR1, temp);
-
-	temp = Height;
-	/* BTE Height */
-	prvLCD_WriteCommandWithData(LCD_BEHR0, temp);
-	temp = Height >> 8;
-	prvLCD_WriteCommandWithData(LCD_BEHR1, temp);
+	prvLCD_BTESize(Width, Height);
 
 	/* Give back the semaphore */
 	xSemaphoreGive(xLCDSemaphore);
@@ -740,39 +887,7 @@ void LCD_BTESourceDestinationPoints(uint16_t SourceX, uint16_t SourceY, uint16_t
 	/* Try to take the semaphore */
 	xSemaphoreTake(xLCDSemaphore, portMAX_DELAY);
 
-	uint16_t temp, temp1;
-
-	/* Horizontal Source Point of BTE */
-	temp = SourceX;
-	prvLCD_WriteCommandWithData(LCD_HSBE0, temp);
-	temp = SourceX >> 8;
-	prvLCD_WriteCommandWithData(LCD_HSBE1, temp);
-
-	/* Vertical Source Point of BTE */
-	temp = SourceY;
-	prvLCD_WriteCommandWithData(LCD_VSBE0, temp);
-	temp = SourceY >> 8;
-	prvLCD_CmdWrite(LCD_VSBE1);
-	temp1 = prvLCD_DataRead();
-	temp1 &= 0x80;	/* Get Source layer */
-    temp = temp | temp1;
-    prvLCD_WriteCommandWithData(LCD_VSBE1, temp);
-
-	/* Horizontal Destination Point of BTE */
-	temp = DestinationX;
-	prvLCD_WriteCommandWithData(LCD_HDBE0, temp);
-	temp = DestinationX >> 8;
-	prvLCD_WriteCommandWithData(LCD_HDBE1, temp);
-
-    /* Vertical Destination Point of BTE */
-	temp = DestinationY;
-	prvLCD_WriteCommandWithData(LCD_VDBE0, temp);
-	temp = DestinationY >> 8;
-	prvLCD_CmdWrite(LCD_VDBE1);
-	temp1 = prvLCD_DataRead();
-	temp1 &= 0x80;	/* Get Source layer */
-	temp = temp | temp1;
-	prvLCD_WriteCommandWithData(LCD_VDBE1, temp);
+	prvLCD_BTESourceDestinationPoints(SourceX, SourceY, DestinationX, DestinationY);
 
 	/* Give back the semaphore */
 	xSemaphoreGive(xLCDSemaphore);
@@ -792,18 +907,78 @@ void LCD_BTEDisplayImageOfSizeAt(const LCDImage* Image, uint16_t XPos, uint16_t
 	/* Try to take the semaphore */
 	xSemaphoreTake(xLCDSemaphore, portMAX_DELAY);
 
-	LCD_BTESize(Image->width, Image->height);							/* Set size */
-	prvLCD_WriteCommandWithData(LCD_BECR1, 0xC0); 		/* Write BTE operation - Use source data (i.e. data we send) */
-	LCD_BTESourceDestinationPoints(0, 0, XPos, YPos);	/* Set destination coordinates */
-	prvLCD_WriteCommandWithData(LCD_BECR0, 0x80);		/* Enable BTE in block mode for source and destination */
-	prvLCD_CheckBusy();
+	prvLCD_BTEStartImageWrite(Image->width, Image->height, XPos, YPos);
 
 	/* Write data to memory */
-	prvLCD_CmdWrite(LCD_MRWC);
-	for (uint32_t i = 0; i < Image->width*Image->height; i++)
+	uint32_t numOfPixels = Image->width*Image->height;
+	if (IS_LCD_DMA_ADDRESS(Image->data))
 	{
-		prvLCD_DataWrite(Image->data[i]);
-		prvLCD_CheckBusy();
+		/* Let the DMA stream the pixels while this task sleeps */
+		if (prvLCD_DMAWritePixels(Image->data, numOfPixels) == SUCCESS)
+			prvLCD_CheckBTEBusy();
+		else
+			prvLCD_WriteCommandWithData(LCD_BECR0, 0x00);	/* Stop the BTE as it will never get the rest of the data */
+	}
+	else
+	{
+		for (uint32_t i = 0; i < numOfPixels; i++)
+		{
+			prvLCD_DataWrite(Image->data[i]);
+			prvLCD_CheckBusy();
+		}
+		prvLCD_CheckBTEBusy();
+	}
+
+	/* Give back the semaphore */
+	xSemaphoreGive(xLCDSemaphore);
+}
+
+/**
+ * @brief	Display a run-length encoded image at a specific location
+ * @param	Image: Pointer to the image to display, created with Software/tools/lcd_image_converter.py
+ * @param	XPos: The x position where the image should be displayed
+ * @param	YPos: The y position where the image should be displayed
+ * @retval	None
+ * @note	The pixels are decoded while they are written so no intermediate buffer is needed.
+ * 			No checks are done to make sure the image will fit on the screen.
+ */
+void LCD_BTEDisplayCompressedImageAt(const LCDCompressedImage* Image, uint16_t XPos, uint16_t YPos)
+{
+	/* Try to take the semaphore */
+	xSemaphoreTake(xLCDSemaphore, portMAX_DELAY);
+
+	prvLCD_BTEStartImageWrite(Image->width, Image->height, XPos, YPos);
+
+	/* Decode the packets and write the pixels to memory */
+	const uint8_t* pData = Image->data;
+	uint32_t pixelsLeft = Image->width*Image->height;
+	while (pixelsLeft != 0)
+	{
+		uint8_t header = *pData++;
+		uint32_t count = (header & LCD_RLE_LENGTH_MASK) + 1;
+		if (count > pixelsLeft)
+			count = pixelsLeft;
+		pixelsLeft -= count;
+
+		if (header & LCD_RLE_RUN_FLAG)
+		{
+			/* Run packet - one pixel repeated count times */
+			uint16_t pixel = prvLCD_ReadCompressedPixel(&pData, Image->palette);
+			while (count--)
+			{
+				prvLCD_DataWrite(pixel);
+				prvLCD_CheckBusy();
+			}
+		}
+		else
+		{
+			/* Literal packet - count pixels follow */
+			while (count--)
+			{
+				prvLCD_DataWrite(prvLCD_ReadCompressedPixel(&pData, Image->palette));
+				prvLCD_CheckBusy();
+			}
+		}
 	}
 	prvLCD_CheckBTEBusy();
 
@@ -974,9 +1149,8 @@ static void prvLCD_InterruptConfig()
 	GPIO_InitStructure.Speed = GPIO_SPEED_FAST;
 	HAL_GPIO_Init(GPIOD, &GPIO_InitStructure);
 
-	/* Configure priority and enable interrupt */
+	/* Configure priority, the interrupt is only enabled while a DMA transfer is running */
 	HAL_NVIC_SetPriority(EXTI15_10_IRQn, configLIBRARY_LOWEST_INTERRUPT_PRIORITY, 0);
-	HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
 }
 
 /**
@@ -993,6 +1167,23 @@ static void prvLCD_PLLInit()
 	vTaskDelay(1 / portTICK_PERIOD_MS);
 }
 
+/**
+ * @brief	Initializes the DMA used for pixel transfers to the LCD
+ * @param	None
+ * @retval	None
+ */
+static void prvLCD_DMAInit()
+{
+	LCD_DMA_CLK_ENABLE();
+	HAL_DMA_Init(&DMA_Handle);
+	DMA_Handle.XferCpltCallback = prvLCD_DMATransferCompleteCallback;
+	DMA_Handle.XferErrorCallback = prvLCD_DMATransferErrorCallback;
+
+	/* Same priority as the WAIT interrupt so they never preempt each other */
+	HAL_NVIC_SetPriority(LCD_DMA_IRQn, configLIBRARY_LOWEST_INTERRUPT_PRIORITY, 0);
+	HAL_NVIC_EnableIRQ(LCD_DMA_IRQn);
+}
+
 /**
  * @brief	Sends a command to the LCD
  * @param	None
@@ -1000,7 +1191,7 @@ static void prvLCD_PLLInit()
  */
 static inline void prvLCD_CmdWrite(uint16_t Command)
 {
-	*LCD.LCD_REG = Command;
+	LCD_BUS_WRITE_REG(Command);
 }
 
 /**
@@ -1010,7 +1201,7 @@ static inline void prvLCD_CmdWrite(uint16_t Command)
  */
 static inline void prvLCD_DataWrite(uint16_t Data)
 {
-	*LCD.LCD_RAM = Data;
+	LCD_BUS_WRITE_RAM(Data);
 }
 
 /**
@@ -1032,7 +1223,7 @@ static inline void prvLCD_WriteCommandWithData(uint8_t Command, uint8_t Data)
  */
 static inline uint16_t prvLCD_StatusRead()
 {
-	return *LCD.LCD_REG;
+	return LCD_BUS_READ_REG();
 }
 
 
@@ -1043,7 +1234,7 @@ static inline uint16_t prvLCD_StatusRead()
  */
 static inline uint16_t prvLCD_DataRead()
 {
-	return *LCD.LCD_RAM;
+	return LCD_BUS_READ_RAM();
 }
 
 
@@ -1109,6 +1300,322 @@ static void prvLCD_SetActiveWindow(uint16_t XLeft, uint16_t XRight, uint16_t YTo
 	prvLCD_WriteCommandWithData(LCD_VEAW1, temp);
 }
 
+/**
+ * @brief	Set the active window back to the clip window
+ * @param	None
+ * @retval	None
+ * @note	The LCD semaphore must be taken before calling this
+ */
+static inline void prvLCD_RestoreClipWindow()
+{
+	prvLCD_SetActiveWindow(prvClipWindow.xLeft, prvClipWindow.xRight, prvClipWindow.yTop, prvClipWindow.yBottom);
+}
+
+/**
+ * @brief	BTE area size settings
+ * @param	Width: The width
+ * @param	Height: The height
+ * @retval	None
+ * @note	The LCD semaphore must be taken before calling this
+ */
+static void prvLCD_BTESize(uint16_t Width, uint16_t Height)
+{
+	uint16_t temp;
+	temp = Width;
+	/* BTE Width */
+	prvLCD_WriteCommandWithData(LCD_BEWR0, temp);
+	temp = Width >> 8;
+	prvLCD_WriteCommandWithData(LCD_BEWR1, temp);
+
+	temp = Height;
+	/* BTE Height */
+	prvLCD_WriteCommandWithData(LCD_BEHR0, temp);
+	temp = Height >> 8;
+	prvLCD_WriteCommandWithData(LCD_BEHR1, temp);
+}
+
+/**
+ * @brief	Set points for source and destination for BTE
+ * @param	SourceX: X-coordinate for the source
+ * @param	SourceY: Y-coordinate for the source
+ * @param	DestinationX: X-coordinate for the destination
+ * @param	DestinationY: Y-coordinate for the destination
+ * @retval	None
+ * @note	The LCD semaphore must be taken before calling this
+ */
+static void prvLCD_BTESourceDestinationPoints(uint16_t SourceX, uint16_t SourceY, uint16_t DestinationX, uint16_t DestinationY)
+{
+	uint16_t temp, temp1;
+
+	/* Horizontal Source Point of BTE */
+	temp = SourceX;
+	prvLCD_WriteCommandWithData(LCD_HSBE0, temp);
+	temp = SourceX >> 8;
+	prvLCD_WriteCommandWithData(LCD_HSBE1, temp);
+
+	/* Vertical Source Point of BTE */
+	temp = SourceY;
+	prvLCD_WriteCommandWithData(LCD_VSBE0, temp);
+	temp = SourceY >> 8;
+	prvLCD_CmdWrite(LCD_VSBE1);
+	temp1 = prvLCD_DataRead();
+	temp1 &= 0x80;	/* Get Source layer */
+    temp = temp | temp1;
+    prvLCD_WriteCommandWithData(LCD_VSBE1, temp);
+
+	/* Horizontal Destination Point of BTE */
+	temp = DestinationX;
+	prvLCD_WriteCommandWithData(LCD_HDBE0, temp);
+	temp = DestinationX >> 8;
+	prvLCD_WriteCommandWithData(LCD_HDBE1, temp);
+
+    /* Vertical Destination Point of BTE */
+	temp = DestinationY;
+	prvLCD_WriteCommandWithData(LCD_VDBE0, temp);
+	temp = DestinationY >> 8;
+	prvLCD_CmdWrite(LCD_VDBE1);
+	temp1 = prvLCD_DataRead();
+	temp1 &= 0x80;	/* Get Source layer */
+	temp = temp | temp1;
+	prvLCD_WriteCommandWithData(LCD_VDBE1, temp);
+}
+
+/**
+ * @brief	Set up the BTE to write an image and send the memory write command
+ * @param	Width: Width of the image
+ * @param	Height: Height of the image
+ * @param	XPos: The x position where the image should be displayed
+ * @param	YPos: The y position where the image should be displayed
+ * @retval	None
+ * @note	The LCD semaphore must be taken before calling this
+ */
+static void prvLCD_BTEStartImageWrite(uint16_t Width, uint16_t Height, uint16_t XPos, uint16_t YPos)
+{
+	prvLCD_BTESize(Width, Height);							/* Set size */
+	prvLCD_WriteCommandWithData(LCD_BECR1, 0xC0); 			/* Write BTE operation - Use source data (i.e. data we send) */
+	prvLCD_BTESourceDestinationPoints(0, 0, XPos, YPos);	/* Set destination coordinates */
+	prvLCD_WriteCommandWithData(LCD_BECR0, 0x80);			/* Enable BTE in block mode for source and destination */
+	prvLCD_CheckBusy();
+	prvLCD_CmdWrite(LCD_MRWC);
+}
+
+/**
+ * @brief	Read one pixel from compressed image data
+ * @param	ppData: Pointer to the data pointer, will be moved past the pixel
+ * @param	pPalette: The palette of the image or 0 if the pixels are stored as RGB565 values
+ * @retval	The RGB565 value of the pixel
+ */
+static inline uint16_t prvLCD_ReadCompressedPixel(const uint8_t** ppData, const uint16_t* pPalette)
+{
+	const uint8_t* pData = *ppData;
+	if (pPalette != 0)
+	{
+		*ppData = pData + 1;
+		return pPalette[pData[0]];
+	}
+	else
+	{
+		*ppData = pData + 2;
+		return pData[0] | (pData[1] << 8);
+	}
+}
+
+/**
+ * @brief	Write pixel data to the display memory using DMA
+ * @param	pPixels: Pointer to the pixels, must not be located in CCM RAM
+ * @param	NumOfPixels: Number of pixels to write
+ * @retval	SUCCESS: All pixels were written
+ * @retval	ERROR: The transfer failed or timed out
+ * @note	The LCD semaphore must be taken and the memory write command sent before calling this.
+ * 			The data is sent in chunks of LCD_DMA_CHUNK_SIZE pixels with slowed down FSMC write timing.
+ * 			Every chunk is started from the WAIT interrupt so nothing polls the LCD in interrupt
+ * 			context. The calling task sleeps until the transfer is done.
+ */
+static ErrorStatus prvLCD_DMAWritePixels(const uint16_t* pPixels, uint32_t NumOfPixels)
+{
+	if (NumOfPixels == 0)
+		return SUCCESS;
+
+	prvDMASourceAddress = (uint32_t)pPixels;
+	prvDMAPixelsLeft = NumOfPixels;
+	prvDMAErrorOccurred = false;
+
+	/* Forget the WAIT edges from earlier writes and let the WAIT interrupt restart held off chunks */
+	__HAL_GPIO_EXTI_CLEAR_IT(LCD_WAIT_PIN);
+	HAL_NVIC_ClearPendingIRQ(EXTI15_10_IRQn);
+	HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
+
+	/* Pace the writes by stretching the data phase, nothing else is on the bus as the semaphore is taken */
+	uint32_t normalTiming = FSMC_Bank1->BTCR[1];
+	FSMC_Bank1->BTCR[1] = (normalTiming & ~FSMC_BTR1_DATAST) | (LCD_DMA_DATA_SETUP_TIME << 8);
+
+	/* Let the WAIT interrupt start the first chunk, the rest are requested from the DMA interrupt */
+	taskENTER_CRITICAL();
+	prvLCD_DMARequestNextChunk();
+	taskEXIT_CRITICAL();
+
+	/* Wait for the last chunk to be done */
+	ErrorStatus status = SUCCESS;
+	if (xSemaphoreTake(LCD.xDMASemaphore, LCD_DMA_TIMEOUT / portTICK_PERIOD_MS) != pdTRUE || prvDMAErrorOccurred)
+	{
+		/* Something went wrong so stop the transfer */
+		taskENTER_CRITICAL();
+		prvDMAPixelsLeft = 0;
+		prvDMAIsWaitingForLcd = false;
+		taskEXIT_CRITICAL();
+		HAL_DMA_Abort(&DMA_Handle);
+		status = ERROR;
+	}
+
+	HAL_NVIC_DisableIRQ(EXTI15_10_IRQn);
+	FSMC_Bank1->BTCR[1] = normalTiming;
+	return status;
+}
+
+/**
+ * @brief	Ask the WAIT interrupt to start the next chunk
+ * @param	None
+ * @retval	None
+ * @note	Must be called from an interrupt or inside a critical section. If WAIT is already high
+ * 			there will be no edge so the interrupt is triggered by software instead.
+ */
+static void prvLCD_DMARequestNextChunk()
+{
+	prvDMAIsWaitingForLcd = true;
+	if (HAL_GPIO_ReadPin(LCD_WAIT_PORT, LCD_WAIT_PIN) == GPIO_PIN_SET)
+		EXTI->SWIER = LCD_WAIT_PIN;
+}
+
+/**
+ * @brief	Start the DMA transfer of the next chunk
+ * @param	None
+ * @retval	None
+ * @note	Only called from the WAIT interrupt after prvLCD_DMARequestNextChunk
+ */
+static void prvLCD_DMAStartNextChunk()
+{
+	prvDMAIsWaitingForLcd = false;
+
+	uint32_t chunkSize = prvDMAPixelsLeft;
+	if (chunkSize > LCD_DMA_CHUNK_SIZE)
+		chunkSize = LCD_DMA_CHUNK_SIZE;
+
+	uint32_t sourceAddress = prvDMASourceAddress;
+	prvDMASourceAddress += chunkSize * sizeof(uint16_t);
+	prvDMAPixelsLeft -= chunkSize;
+
+	if (HAL_DMA_Start_IT(&DMA_Handle, sourceAddress, (uint32_t)LCD.LCD_RAM, chunkSize) != HAL_OK)
+		prvLCD_DMATransferErrorCallback(&DMA_Handle);
+}
+
+/**
+ * @brief	Called from the DMA interrupt when a chunk has been transferred
+ * @param	hdma: The DMA handle
+ * @retval	None
+ */
+static void prvLCD_DMATransferCompleteCallback(DMA_HandleTypeDef* hdma)
+{
+	if (prvDMAPixelsLeft != 0)
+		prvLCD_DMARequestNextChunk();
+	else
+		xSemaphoreGiveFromISR(LCD.xDMASemaphore, NULL);
+}
+
+/**
+ * @brief	Called from the DMA interrupt when a transfer error occurs
+ * @param	hdma: The DMA handle
+ * @retval	None
+ */
+static void prvLCD_DMATransferErrorCallback(DMA_HandleTypeDef* hdma)
+{
+	prvDMAErrorOccurred = true;
+	prvDMAPixelsLeft = 0;
+	xSemaphoreGiveFromISR(LCD.xDMASemaphore, NULL);
+}
+
+/**
+ * @brief	Prepare for writing text in a window, the text is clipped if the window is not inside the clip window
+ * @param	Window: The window the text wraps in
+ * @param	Enlargement: The font enlargement
+ * @retval	None
+ * @note	The text write position must be set before calling this and prvLCD_EndText called when done
+ */
+static void prvLCD_BeginText(LCDActiveWindow Window, LCDFontEnlarge Enlargement)
+{
+	prvTextIsClipped = (Window.xLeft < prvClipWindow.xLeft || Window.xRight > prvClipWindow.xRight ||
+						Window.yTop < prvClipWindow.yTop || Window.yBottom > prvClipWindow.yBottom);
+	if (!prvTextIsClipped)
+		return;
+
+	prvTextWindow = Window;
+	prvTextCharWidth = 8 * Enlargement;
+	prvTextCharHeight = 16 * Enlargement;
+	prvLCD_GetTextWritePosition(&prvTextXPos, &prvTextYPos);
+	prvTextCursorIsSynced = true;
+}
+
+/**
+ * @brief	Write one character of text
+ * @param	Char: The character
+ * @retval	None
+ */
+static inline void prvLCD_WriteTextChar(uint8_t Char)
+{
+	if (prvTextIsClipped)
+	{
+		prvLCD_WriteClippedTextChar(Char);
+		return;
+	}
+
+	prvLCD_DataWrite(Char);
+	prvLCD_CheckBusy();
+}
+
+/**
+ * @brief	Write one character of text if all of it is inside the clip window
+ * @param	Char: The character
+ * @retval	None
+ * @note	The position is tracked the same way the RA8875 moves its cursor, a character that doesn't fit on
+ * 			the row goes to the start of the next row. After skipped characters the cursor is moved past them.
+ */
+static void prvLCD_WriteClippedTextChar(uint8_t Char)
+{
+	if (prvTextXPos + prvTextCharWidth - 1 > prvTextWindow.xRight)
+	{
+		prvTextXPos = prvTextWindow.xLeft;
+		prvTextYPos += prvTextCharHeight;
+	}
+
+	if (prvTextXPos >= prvClipWindow.xLeft && prvTextXPos + prvTextCharWidth - 1 <= prvClipWindow.xRight &&
+		prvTextYPos >= prvClipWindow.yTop && prvTextYPos + prvTextCharHeight - 1 <= prvClipWindow.yBottom)
+	{
+		if (!prvTextCursorIsSynced)
+		{
+			prvLCD_SetTextWritePosition(prvTextXPos, prvTextYPos);
+			prvLCD_CmdWrite(LCD_MRWC);
+			prvTextCursorIsSynced = true;
+		}
+		prvLCD_DataWrite(Char);
+		prvLCD_CheckBusy();
+	}
+	else
+		prvTextCursorIsSynced = false;
+
+	prvTextXPos += prvTextCharWidth;
+}
+
+/**
+ * @brief	Finish writing text, the cursor is left after the last character even if it was skipped
+ * @param	None
+ * @retval	None
+ */
+static void prvLCD_EndText()
+{
+	if (prvTextIsClipped && !prvTextCursorIsSynced)
+		prvLCD_SetTextWritePosition(prvTextXPos, prvTextYPos);
+	prvTextIsClipped = false;
+}
+
 /**
  * @brief	Write a string
  * @param	String: The string to write
@@ -1120,9 +1627,8 @@ static void prvLCD_WriteString(uint8_t *String)
 	prvLCD_CmdWrite(LCD_MRWC);
 	while (*String != '\0')
 	{
-		prvLCD_DataWrite(*String);
+		prvLCD_WriteTextChar(*String);
 		++String;
-		prvLCD_CheckBusy();
 	}
 }
 
@@ -1137,10 +1643,7 @@ static void prvLCD_WriteBuffer(uint8_t *pBuffer, uint32_t Size)
 	/* Write to memory */
 	prvLCD_CmdWrite(LCD_MRWC);
 	for (uint32_t i = 0; i < Size; i++)
-	{
-		prvLCD_DataWrite(pBuffer[i]);
-		prvLCD_CheckBusy();
-	}
+		prvLCD_WriteTextChar(pBuffer[i]);
 }
 
 /**
@@ -1148,34 +1651,42 @@ static void prvLCD_WriteBuffer(uint8_t *pBuffer, uint32_t Size)
  * @param	pBuffer: The buffer to write
  * @param	Size: The size of the buffer
  * @param	Format: The format to use when writing the buffer, can be any value of LCDTextFormat
+ * @param	CharsPerRow: Number of characters on a row in the active window, only used for LCDTextFormat_HexDump
  * @retval	None
  */
-static void prvLCD_WriteBufferWithFormat(uint8_t *pBuffer, uint32_t Size, LCDTextFormat Format)
+static void prvLCD_WriteBufferWithFormat(uint8_t *pBuffer, uint32_t Size, LCDTextFormat Format, uint32_t CharsPerRow)
 {
+	if (Format == LCDTextFormat_ASCII)
+	{
+		prvLCD_WriteBuffer(pBuffer, Size);
+		return;
+	}
+
 	/* Write to memory */
 	prvLCD_CmdWrite(LCD_MRWC);
-	for (uint32_t i = 0; i < Size; i++)
+
+	/* Format a chunk at a time so the formatting is not mixed with the waiting on the LCD */
+	uint8_t formatted[LCD_FORMAT_BUFFER_SIZE];
+	for (uint32_t offset = 0; offset < Size; offset += LCD_FORMAT_CHUNK_SIZE)
 	{
-		if (Format == LCDTextFormat_ASCII)
-		{
-			prvLCD_DataWrite(pBuffer[i]);
-			prvLCD_CheckBusy();
-		}
-		else if (Format == LCDTextFormat_HexWithSpaces)
-		{
-			prvLCD_DataWrite(prvHexTable[pBuffer[i] >> 4]);
-			prvLCD_CheckBusy();
-			prvLCD_DataWrite(prvHexTable[pBuffer[i] & 0x0F]);
-			prvLCD_CheckBusy();
-			prvLCD_DataWrite(' ');
-			prvLCD_CheckBusy();
-		}
-		else if (Format == LCDTextFormat_HexWithoutSpaces)
+		uint32_t chunkSize = Size - offset;
+		if (chunkSize > LCD_FORMAT_CHUNK_SIZE)
+			chunkSize = LCD_FORMAT_CHUNK_SIZE;
+
+		uint32_t numOfChars;
+		if (Format == LCDTextFormat_HexDump)
+			numOfChars = LCD_FormatHexDump(&pBuffer[offset], chunkSize, offset, formatted);
+		else
+			numOfChars = LCD_FormatBuffer(&pBuffer[offset], chunkSize, formatted, Format);
+
+		for (uint32_t i = 0; i < numOfChars; i++)
+			prvLCD_WriteTextChar(formatted[i]);
+
+		/* Fill the rest of the row with spaces so the next dump row starts on a new row */
+		if (Format == LCDTextFormat_HexDump && CharsPerRow != 0)
 		{
-			prvLCD_DataWrite(prvHexTable[pBuffer[i] >> 4]);
-			prvLCD_CheckBusy();
-			prvLCD_DataWrite(prvHexTable[pBuffer[i] & 0x0F]);
-			prvLCD_CheckBusy();
+			for (uint32_t i = numOfChars % CharsPerRow; i != 0 && i < CharsPerRow; i++)
+				prvLCD_WriteTextChar(' ');
 		}
 	}
 }
@@ -1324,7 +1835,7 @@ void LCD_TestText(uint16_t Delay)
 
     LCD_SetForegroundColor(LCD_COLOR_BLUE);//Set the foreground color
     LCD_SetTextWritePosition(300, 232+64);//Text written to the position
-    LCD_WriteString("0123456789 !\"#%&/()=?`", LCDTransparency_Transparent, LCDFontEnlarge_1x);
+    LCD_WriteString("0123456789 !\"#Û%&/()=?`«", LCDTransparency_Transparent, LCDFontEnlarge_1x);
 
     LCD_SetForegroundColor(LCD_COLOR_PURPLE);//Set the foreground color
     LCD_SetTextWritePosition(0, 232+64);//Text written to the position
@@ -1460,4 +1971,18 @@ void LCD_WAIT_Callback()
 {
 	/* Give the semaphore as the LCD is done processing now */
 	xSemaphoreGiveFromISR(LCD.xWaitSemaphore, NULL);
+
+	/* Continue a DMA transfer that was held off by the LCD */
+	if (prvDMAIsWaitingForLcd)
+		prvLCD_DMAStartNextChunk();
+}
+
+/**
+  * @brief  This function handles the LCD DMA interrupt request.
+  * @param  None
+  * @retval None
+  */
+void DMA2_Stream0_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&DMA_Handle);
 }
@@ -27,7 +27,7 @@
 #include "max1301.h"
 
 /* Private defines -----------------------------------------------------------*/
-#define ADC_SPI					(SPI1)
+#define ADC_SPI					(SPI1)	/* Shared with the thermocouple, see spi.c, not locked */
 #define ADC_SPI_CLK_ENABLE()	(__SPI1_CLK_ENABLE())
 #define ADC_PORT				(GPIOA)
 #define ADC_GPIO_CLK_ENABLE()	(__GPIOA_CLK_ENABLE())
@@ -36,7 +36,30 @@
 #define ADC_MISO_PIN			(GPIO_PIN_6)
 #define ADC_MOSI_PIN			(GPIO_PIN_7)
 
+#define ADC_TIMER				(TIM2)
+#define ADC_TIMER_CLK_ENABLE()	(__TIM2_CLK_ENABLE())
+#define ADC_TIMER_CLK_DISABLE()	(__TIM2_CLK_DISABLE())
+#define ADC_TIMER_CLOCK			(84000000)	/* 84 MHz, see datasheet page 31 */
+#define ADC_FRAME_DELAY			(ADC_TIMER_CLOCK / 1000000)	/* 1 us between the two frames of a conversion */
+
+/*
+ * Every conversion is two 16-bit SPI frames, the start byte with a dummy byte and then two
+ * dummy bytes while the result is clocked out. TIM2 update writes the first frame and the
+ * TIM2 compare 1 the second one, both with DMA1. The DMA1 peripheral port only reaches APB1
+ * so the frames are read from the unused TIM2 CCR3 and CCR4 registers and written to SPI1
+ * on APB2 through the memory port. The received frames go to DMA2 in double buffer mode.
+ */
+#define ADC_DMA_START_STREAM	(DMA1_Stream7)	/* TIM2_UP, channel 3 */
+#define ADC_DMA_READ_STREAM		(DMA1_Stream5)	/* TIM2_CH1, channel 3 */
+#define ADC_DMA_TIMER_FLAGS		(DMA_HIFCR_CFEIF5 | DMA_HIFCR_CDMEIF5 | DMA_HIFCR_CTEIF5 | DMA_HIFCR_CHTIF5 | DMA_HIFCR_CTCIF5 | \
+								 DMA_HIFCR_CFEIF7 | DMA_HIFCR_CDMEIF7 | DMA_HIFCR_CTEIF7 | DMA_HIFCR_CHTIF7 | DMA_HIFCR_CTCIF7)
+#define ADC_DMA_RX_STREAM		(DMA2_Stream2)	/* SPI1_RX, channel 3 */
+#define ADC_DMA_RX_IRQn			(DMA2_Stream2_IRQn)
+#define ADC_DMA_RX_FLAGS		(DMA_LIFCR_CFEIF2 | DMA_LIFCR_CDMEIF2 | DMA_LIFCR_CTEIF2 | DMA_LIFCR_CHTIF2 | DMA_LIFCR_CTCIF2)
+
 #define START_BIT	(0x80)
+#define FRAMES_PER_CONVERSION	(2)		/* 16-bit frames clocked for every conversion, the second one is the result */
+#define STOP_TIMEOUT			(100000)
 
 
 /* Private typedefs ----------------------------------------------------------*/
@@ -49,7 +72,7 @@ static SPI_HandleTypeDef SPI_Handle = {
 		.Init.CLKPolarity 		= SPI_POLARITY_LOW,
 		.Init.CLKPhase 			= SPI_PHASE_1EDGE,
 		.Init.NSS 				= SPI_NSS_SOFT,
-		.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_64,
+		.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_16,
 		.Init.FirstBit 			= SPI_FIRSTBIT_MSB,
 		.Init.TIMode			= SPI_TIMODE_DISABLED,
 		.Init.CRCCalculation	= SPI_CRCCALCULATION_DISABLED,
@@ -69,11 +92,85 @@ static MAX1301Configuration prvCurrentConfig[2] = {
 		},
 };
 
+static TIM_HandleTypeDef prvTimerHandle = {
+		.Instance 			= ADC_TIMER,
+		.Init.Prescaler		= 0,
+		.Init.ClockDivision	= TIM_CLOCKDIVISION_DIV1,
+		.Init.CounterMode	= TIM_COUNTERMODE_UP,
+};
+
+/* Both timer streams copy a frame from a TIM2 register to the SPI for every request */
+static DMA_HandleTypeDef DMA_HandleStart = {
+		.Instance					= ADC_DMA_START_STREAM,
+		.Init.Channel 				= DMA_CHANNEL_3,
+		.Init.Direction 			= DMA_PERIPH_TO_MEMORY,
+		.Init.PeriphInc 			= DMA_PINC_DISABLE,
+		.Init.MemInc 				= DMA_MINC_DISABLE,
+		.Init.PeriphDataAlignment 	= DMA_PDATAALIGN_HALFWORD,
+		.Init.MemDataAlignment 		= DMA_MDATAALIGN_HALFWORD,
+		.Init.Mode 					= DMA_CIRCULAR,
+		.Init.Priority				= DMA_PRIORITY_VERY_HIGH,
+		.Init.FIFOMode 				= DMA_FIFOMODE_DISABLE,
+		.Init.FIFOThreshold      	= DMA_FIFO_THRESHOLD_FULL,
+		.Init.MemBurst				= DMA_MBURST_SINGLE,
+		.Init.PeriphBurst			= DMA_PBURST_SINGLE,
+};
+
+static DMA_HandleTypeDef DMA_HandleRead = {
+		.Instance					= ADC_DMA_READ_STREAM,
+		.Init.Channel 				= DMA_CHANNEL_3,
+		.Init.Direction 			= DMA_PERIPH_TO_MEMORY,
+		.Init.PeriphInc 			= DMA_PINC_DISABLE,
+		.Init.MemInc 				= DMA_MINC_DISABLE,
+		.Init.PeriphDataAlignment 	= DMA_PDATAALIGN_HALFWORD,
+		.Init.MemDataAlignment 		= DMA_MDATAALIGN_HALFWORD,
+		.Init.Mode 					= DMA_CIRCULAR,
+		.Init.Priority				= DMA_PRIORITY_VERY_HIGH,
+		.Init.FIFOMode 				= DMA_FIFOMODE_DISABLE,
+		.Init.FIFOThreshold      	= DMA_FIFO_THRESHOLD_FULL,
+		.Init.MemBurst				= DMA_MBURST_SINGLE,
+		.Init.PeriphBurst			= DMA_PBURST_SINGLE,
+};
+
+static DMA_HandleTypeDef DMA_HandleRx = {
+		.Instance					= ADC_DMA_RX_STREAM,
+		.Init.Channel 				= DMA_CHANNEL_3,
+		.Init.Direction 			= DMA_PERIPH_TO_MEMORY,
+		.Init.PeriphInc 			= DMA_PINC_DISABLE,
+		.Init.MemInc 				= DMA_MINC_ENABLE,
+		.Init.PeriphDataAlignment 	= DMA_PDATAALIGN_HALFWORD,
+		.Init.MemDataAlignment 		= DMA_MDATAALIGN_HALFWORD,
+		.Init.Mode 					= DMA_CIRCULAR,
+		.Init.Priority				= DMA_PRIORITY_VERY_HIGH,
+		.Init.FIFOMode 				= DMA_FIFOMODE_DISABLE,
+		.Init.FIFOThreshold      	= DMA_FIFO_THRESHOLD_FULL,
+		.Init.MemBurst				= DMA_MBURST_SINGLE,
+		.Init.PeriphBurst			= DMA_PBURST_SINGLE,
+};
+
+/* The received frames, the DMA fills one half while the other one is handed over. Can't be in the CCM RAM */
+static uint16_t prvRxFrames[2][MAX1301_BLOCK_SIZE * FRAMES_PER_CONVERSION];
+
+static volatile bool prvAcquisitionIsRunning = false;
+static MAX1301BlockCallback prvBlockCallback = 0;
+static uint32_t prvSampleRate = 0;
+static volatile int16_t prvLatestSample = 0;
+
+/* Double buffer, one is filled from the DMA interrupt while the other one is processed by the callback owner */
+static int16_t prvSampleBuffer[2][MAX1301_BLOCK_SIZE];
+static volatile bool prvBufferIsFull[2] = {false};
+static uint32_t prvActiveBuffer = 0;
+
+static volatile MAX1301AcquisitionStats prvStats = {0};
+static uint32_t prvLastBlockCycles = 0;
+static volatile bool prvResetPeriods = true;
+
 /* Private function prototypes -----------------------------------------------*/
 static inline void prvADC_CS_LOW();
 static inline void prvADC_CS_HIGH();
 
 static uint8_t prvADC_SendReceiveByte(uint8_t Byte);
+static void prvHandOverBlock(const uint16_t* pFrames);
 
 /* Functions -----------------------------------------------------------------*/
 /**
@@ -135,6 +232,10 @@ void MAX1301_Init()
  */
 int16_t MAX1301_GetDataFromDiffChannel(MAX1301DiffChannel Channel)
 {
+	/* The SPI is owned by the DMA while the acquisition is running */
+	if (prvAcquisitionIsRunning)
+		return prvLatestSample;
+
 	uint8_t byte0, byte1;
 	prvADC_CS_LOW();
 	prvADC_SendReceiveByte(START_BIT | Channel);	/* Conversion start byte */
@@ -147,6 +248,185 @@ int16_t MAX1301_GetDataFromDiffChannel(MAX1301DiffChannel Channel)
 	return result;
 }
 
+/**
+ * @brief	Start sampling a channel continuously. TIM2 triggers the DMA that starts every conversion and
+ * 			the results are collected by DMA in double buffer mode so the CPU is only interrupted once
+ * 			for every MAX1301_BLOCK_SIZE samples.
+ * @param	Channel: The channel to sample, can be any value of MAX1301DiffChannel
+ * @param	SampleRate: Number of samples per second, 1 to MAX1301_MAX_SAMPLE_RATE
+ * @param	Callback: Function that is called from interrupt context every time a buffer of MAX1301_BLOCK_SIZE samples is full
+ * @retval	SUCCESS: The acquisition was started
+ * @retval	ERROR: Invalid sample rate or already running
+ * @note	The start bit frames every conversion so CS is held low for the whole acquisition
+ */
+ErrorStatus MAX1301_StartAcquisition(MAX1301DiffChannel Channel, uint32_t SampleRate, MAX1301BlockCallback Callback)
+{
+	if (prvAcquisitionIsRunning || SampleRate == 0 || SampleRate > MAX1301_MAX_SAMPLE_RATE || Callback == 0)
+		return ERROR;
+
+	/* The DWT cycle counter is used to measure the time between the blocks */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	/* Reset the buffers and the statistics */
+	prvBlockCallback = Callback;
+	prvBufferIsFull[0] = false;
+	prvBufferIsFull[1] = false;
+	prvActiveBuffer = 0;
+	prvStats.numOfSamples = 0;
+	prvStats.numOfOverruns = 0;
+	prvStats.numOfDroppedSamples = 0;
+	prvStats.lastSampleCycles = DWT->CYCCNT;
+	prvLastBlockCycles = 0;
+	prvResetPeriods = true;
+
+	/* Timer Init, the compare has to come after the update so the counter starts after it */
+	ADC_TIMER_CLK_ENABLE();
+	prvTimerHandle.Init.Period = ADC_TIMER_CLOCK / SampleRate - 1;
+	HAL_TIM_Base_Init(&prvTimerHandle);
+	prvSampleRate = ADC_TIMER_CLOCK / (prvTimerHandle.Init.Period + 1);
+	ADC_TIMER->CCR1 = ADC_FRAME_DELAY;
+	ADC_TIMER->CCR3 = (uint32_t)(START_BIT | Channel) << 8;		/* Start byte and a dummy byte */
+	ADC_TIMER->CCR4 = 0;										/* Dummy bytes while the result is clocked out */
+	ADC_TIMER->CNT = ADC_FRAME_DELAY + 1;
+
+	/* 16-bit frames while the acquisition runs, the DFF bit can only be changed when the SPI is disabled */
+	__HAL_SPI_DISABLE(&SPI_Handle);
+	ADC_SPI->CR1 |= SPI_CR1_DFF;
+	__HAL_SPI_ENABLE(&SPI_Handle);
+	/* Flush anything left in the receive register so that the RX DMA starts in sync */
+	(void)ADC_SPI->DR;
+	(void)ADC_SPI->SR;
+
+	/* DMA Init */
+	__DMA1_CLK_ENABLE();
+	__DMA2_CLK_ENABLE();
+	HAL_DMA_Init(&DMA_HandleStart);
+	HAL_DMA_Init(&DMA_HandleRead);
+	HAL_DMA_Init(&DMA_HandleRx);
+	DMA1->HIFCR = ADC_DMA_TIMER_FLAGS;
+	DMA2->LIFCR = ADC_DMA_RX_FLAGS;
+
+	ADC_DMA_START_STREAM->PAR = (uint32_t)&ADC_TIMER->CCR3;
+	ADC_DMA_START_STREAM->M0AR = (uint32_t)&ADC_SPI->DR;
+	ADC_DMA_START_STREAM->NDTR = 1;
+	ADC_DMA_READ_STREAM->PAR = (uint32_t)&ADC_TIMER->CCR4;
+	ADC_DMA_READ_STREAM->M0AR = (uint32_t)&ADC_SPI->DR;
+	ADC_DMA_READ_STREAM->NDTR = 1;
+
+	ADC_DMA_RX_STREAM->PAR = (uint32_t)&ADC_SPI->DR;
+	ADC_DMA_RX_STREAM->M0AR = (uint32_t)prvRxFrames[0];
+	ADC_DMA_RX_STREAM->M1AR = (uint32_t)prvRxFrames[1];
+	ADC_DMA_RX_STREAM->NDTR = MAX1301_BLOCK_SIZE * FRAMES_PER_CONVERSION;
+	ADC_DMA_RX_STREAM->CR |= DMA_SxCR_DBM | DMA_SxCR_TCIE | DMA_SxCR_TEIE;
+
+	/* The RX interrupt hands the blocks over with FreeRTOS calls so it has to be at or below the syscall priority */
+	HAL_NVIC_SetPriority(ADC_DMA_RX_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY, 0);
+	HAL_NVIC_EnableIRQ(ADC_DMA_RX_IRQn);
+
+	ADC_DMA_RX_STREAM->CR |= DMA_SxCR_EN;
+	ADC_DMA_START_STREAM->CR |= DMA_SxCR_EN;
+	ADC_DMA_READ_STREAM->CR |= DMA_SxCR_EN;
+	ADC_SPI->CR2 |= SPI_CR2_RXDMAEN;
+
+	prvADC_CS_LOW();
+	prvAcquisitionIsRunning = true;
+	ADC_TIMER->DIER |= TIM_DIER_UDE | TIM_DIER_CC1DE;
+	HAL_TIM_Base_Start(&prvTimerHandle);
+
+	return SUCCESS;
+}
+
+/**
+ * @brief	Stop the acquisition, the conversion that is in progress is allowed to finish
+ * @param	None
+ * @retval	None
+ */
+void MAX1301_StopAcquisition()
+{
+	if (!prvAcquisitionIsRunning)
+		return;
+
+	HAL_TIM_Base_Stop(&prvTimerHandle);
+	ADC_TIMER->DIER &= ~(TIM_DIER_UDE | TIM_DIER_CC1DE);
+
+	uint32_t timeout = STOP_TIMEOUT;
+	while ((ADC_SPI->SR & SPI_SR_BSY) && timeout--);
+
+	HAL_NVIC_DisableIRQ(ADC_DMA_RX_IRQn);
+	ADC_SPI->CR2 &= ~SPI_CR2_RXDMAEN;
+	ADC_DMA_START_STREAM->CR &= ~DMA_SxCR_EN;
+	ADC_DMA_READ_STREAM->CR &= ~DMA_SxCR_EN;
+	ADC_DMA_RX_STREAM->CR &= ~DMA_SxCR_EN;
+	DMA1->HIFCR = ADC_DMA_TIMER_FLAGS;
+	DMA2->LIFCR = ADC_DMA_RX_FLAGS;
+	prvADC_CS_HIGH();
+
+	/* Back to the 8-bit frames used for the single conversions */
+	__HAL_SPI_DISABLE(&SPI_Handle);
+	ADC_SPI->CR1 &= ~SPI_CR1_DFF;
+	(void)ADC_SPI->DR;
+
+	HAL_TIM_Base_DeInit(&prvTimerHandle);
+	ADC_TIMER_CLK_DISABLE();
+
+	prvAcquisitionIsRunning = false;
+}
+
+/**
+ * @brief	Check if the acquisition is running
+ * @param	None
+ * @retval	true if it's running
+ * @retval	false if not
+ */
+bool MAX1301_AcquisitionIsRunning()
+{
+	return prvAcquisitionIsRunning;
+}
+
+/**
+ * @brief	Get the sample rate the timer is set to, it can differ slightly from the requested rate
+ * @param	None
+ * @retval	The sample rate in Hz
+ */
+uint32_t MAX1301_GetAcquisitionSampleRate()
+{
+	return prvSampleRate;
+}
+
+/**
+ * @brief	Get the acquisition statistics, the min and max period are restarted after every call
+ * @param	pStats: Pointer to a struct where the statistics will be copied to
+ * @retval	None
+ */
+void MAX1301_GetAcquisitionStats(MAX1301AcquisitionStats* pStats)
+{
+	taskENTER_CRITICAL();
+	pStats->numOfSamples = prvStats.numOfSamples;
+	pStats->numOfOverruns = prvStats.numOfOverruns;
+	pStats->numOfDroppedSamples = prvStats.numOfDroppedSamples;
+	pStats->lastSampleCycles = prvStats.lastSampleCycles;
+	taskEXIT_CRITICAL();
+
+	/* The periods are updated by the DMA interrupt, it restarts them on the next block */
+	pStats->minPeriod = prvStats.minPeriod;
+	pStats->maxPeriod = prvStats.maxPeriod;
+	prvResetPeriods = true;
+}
+
+/**
+ * @brief	Give back a buffer that was handed over by the block callback so that it can be filled again
+ * @param	pSamples: The pointer that was given to the callback
+ * @retval	None
+ */
+void MAX1301_ReleaseBlock(int16_t* pSamples)
+{
+	if (pSamples == prvSampleBuffer[0])
+		prvBufferIsFull[0] = false;
+	else if (pSamples == prvSampleBuffer[1])
+		prvBufferIsFull[1] = false;
+}
+
 /* Private functions .--------------------------------------------------------*/
 /**
  * @brief	Pull the CS pin LOW
@@ -181,4 +461,71 @@ static uint8_t prvADC_SendReceiveByte(uint8_t Byte)
 	return rxByte;
 }
 
+/**
+ * @brief	Copy the results out of the received frames and hand the buffer over
+ * @param	pFrames: The frames of MAX1301_BLOCK_SIZE conversions that the DMA has just filled
+ * @retval	None
+ */
+static void prvHandOverBlock(const uint16_t* pFrames)
+{
+	uint32_t firstSampleNumber = prvStats.numOfSamples;
+	prvStats.numOfSamples += MAX1301_BLOCK_SIZE;
+	prvLatestSample = (int16_t)pFrames[MAX1301_BLOCK_SIZE * FRAMES_PER_CONVERSION - 1];
+
+	if (prvBufferIsFull[prvActiveBuffer])
+	{
+		/* The callback owner hasn't released this buffer yet */
+		prvStats.numOfDroppedSamples += MAX1301_BLOCK_SIZE;
+		return;
+	}
+
+	int16_t* pSamples = prvSampleBuffer[prvActiveBuffer];
+	for (uint32_t i = 0; i < MAX1301_BLOCK_SIZE; i++)
+		pSamples[i] = (int16_t)pFrames[i * FRAMES_PER_CONVERSION + 1];
+
+	prvBufferIsFull[prvActiveBuffer] = true;
+	prvBlockCallback(pSamples, MAX1301_BLOCK_SIZE, firstSampleNumber);
+	prvActiveBuffer ^= 1;
+}
+
 /* Interrupt Handlers --------------------------------------------------------*/
+/**
+  * @brief  This function handles the DMA RX interrupt, it comes once for every full block
+  * @param  None
+  * @retval None
+  */
+void DMA2_Stream2_IRQHandler(void)
+{
+	uint32_t flags = DMA2->LISR;
+	DMA2->LIFCR = flags & ADC_DMA_RX_FLAGS;
+
+	/* Measure the time since the last block */
+	uint32_t cycles = DWT->CYCCNT;
+	if (prvResetPeriods)
+	{
+		prvStats.minPeriod = UINT32_MAX;
+		prvStats.maxPeriod = 0;
+		prvResetPeriods = false;
+	}
+	else if (prvLastBlockCycles != 0)
+	{
+		uint32_t period = cycles - prvLastBlockCycles;
+		if (period < prvStats.minPeriod)
+			prvStats.minPeriod = period;
+		if (period > prvStats.maxPeriod)
+			prvStats.maxPeriod = period;
+	}
+	prvLastBlockCycles = cycles;
+
+	/* The stream is disabled by a transfer error so nothing more will be converted */
+	if (flags & DMA_LISR_TEIF2)
+		prvStats.numOfOverruns += MAX1301_BLOCK_SIZE;
+
+	if (flags & DMA_LISR_TCIF2)
+	{
+		/* CT has already switched to the buffer that is being filled now */
+		uint32_t doneBuffer = (ADC_DMA_RX_STREAM->CR & DMA_SxCR_CT) ? 0 : 1;
+		prvStats.lastSampleCycles = cycles;
+		prvHandOverBlock(prvRxFrames[doneBuffer]);
+	}
+}
@@ -57,10 +57,8 @@ void MCP9808_Init()
 	I2C2_Init();
 
 	/* Get the Manufacturer ID from the MCP9808 */
-	uint8_t reg = MCP9808_REGISTER_MANUFAC_ID;
-	I2C2_Transmit(MCP9808_TEMP_SENSOR_ADDRESS, &reg, 1);
 	uint8_t storage[2] = {0x00, 0x00};
-	I2C2_Receive(MCP9808_TEMP_SENSOR_ADDRESS, storage, 2);
+	I2C2_ReadRegister(MCP9808_TEMP_SENSOR_ADDRESS, MCP9808_REGISTER_MANUFAC_ID, storage, 2, I2C2Client_Temperature);
 	uint16_t manufacturerId = (storage[0] << 8) | storage[1];
 	if (manufacturerId != MCP9808_MANUFACTURER_ID)
 	{
@@ -76,10 +74,8 @@ void MCP9808_Init()
 float MCP9808_GetTemperature()
 {
 	/* Get the temperature from the MCP9808 */
-	uint8_t reg = MCP9808_REGISTER_T_A;
-	I2C2_Transmit(MCP9808_TEMP_SENSOR_ADDRESS, &reg, 1);
 	uint8_t storage[2] = {0x00};
-	I2C2_Receive(MCP9808_TEMP_SENSOR_ADDRESS, storage, 2);
+	I2C2_ReadRegister(MCP9808_TEMP_SENSOR_ADDRESS, MCP9808_REGISTER_T_A, storage, 2, I2C2Client_Temperature);
 
 	/* Check flags */
 	if ((storage[0] & 0x80) == 0x80)	/* T_critical */
@@ -119,8 +115,8 @@ float MCP9808_GetTemperature()
 void MCP9808_SetResolution(MCP9808Resolution Resolution)
 {
 	/* Set the resolution register */
-	uint8_t data[2] = {MCP9808_REGISTER_RESOLUTION, Resolution};
-	I2C2_Transmit(MCP9808_TEMP_SENSOR_ADDRESS, data, 2);
+	uint8_t data = Resolution;
+	I2C2_WriteRegister(MCP9808_TEMP_SENSOR_ADDRESS, MCP9808_REGISTER_RESOLUTION, &data, 1, I2C2Client_Temperature);
 }
 
 /* Interrupt Handlers --------------------------------------------------------*/
@@ -27,31 +27,123 @@
 #include "simple_gui.h"
 
 /* Private defines -----------------------------------------------------------*/
+#define TOUCH_GRID_CELL_WIDTH			(guiConfigDISPLAY_WIDTH / guiConfigTOUCH_GRID_COLUMNS)
+#define TOUCH_GRID_CELL_HEIGHT			(guiConfigDISPLAY_HEIGHT / guiConfigTOUCH_GRID_ROWS)
+#define TOUCH_GRID_WORDS(NumOfObjects)	(((NumOfObjects) + 31) / 32)
+
+#define TOUCH_GRID_BUTTON_WORDS			TOUCH_GRID_WORDS(guiConfigNUMBER_OF_BUTTONS)
+#define TOUCH_GRID_TEXT_BOX_WORDS		TOUCH_GRID_WORDS(guiConfigNUMBER_OF_TEXT_BOXES)
+#define TOUCH_GRID_CONTAINER_WORDS		TOUCH_GRID_WORDS(guiConfigNUMBER_OF_CONTAINERS)
+
+#define READ_CACHE_INVALID_ADDRESS		(0xFFFFFFFF)
+#define READ_CACHE_PAGE_MASK			(~((uint32_t)guiConfigREAD_CACHE_PAGE_SIZE - 1))
+
+/* Keeps the compiler from moving memory accesses across it, enough to order them between tasks on one core */
+#define COMPILER_BARRIER()				__asm volatile ("" ::: "memory")
+
 /* Private typedefs ----------------------------------------------------------*/
+typedef struct
+{
+	uint32_t address;		/* Address of the first byte in the page or READ_CACHE_INVALID_ADDRESS if it's unused */
+	uint32_t lastUsed;		/* Value of prvReadCacheClock the last time the page was used */
+} GUIReadCachePage;
+
 /* Private variables ---------------------------------------------------------*/
 static GUIButton prvButton_list[guiConfigNUMBER_OF_BUTTONS];
 static GUITextBox prvTextBox_list[guiConfigNUMBER_OF_TEXT_BOXES];
 static GUIContainer prvContainer_list[guiConfigNUMBER_OF_CONTAINERS];
 static GUIGrid prvGrid_list[guiConfigNUMBER_OF_GRIDS];
 
-static const uint8_t prvHexTable[16] = {
-		'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
-};
-
-/* See the definition for GUITextFormat for the order */
-static const uint32_t prvNumOfCharsPerByteForTextFormat[3] = {
-		1, 3, 2
+/* See the definition for GUITextFormat for the order, GUITextFormat_HexDump can't be used in a text box */
+static const uint32_t prvNumOfCharsPerByteForTextFormat[6] = {
+		1, 3, 2, 4, 9, 4
 };
 
 static uint8_t prvTempBuffer[guiConfigMAX_NUM_OF_CHARACTERS_ON_DISPLAY];
 static GUILayer prvCurrentlyActiveLayer;
 static bool prvBeepIsOn = true;
 
+/* Regions on each layer that have changed and will be redrawn by GUI_RedrawDirtyRegions */
+static LCDActiveWindow prvDirtyRegions[GUILayer_1 + 1][guiConfigMAX_NUM_OF_DIRTY_REGIONS];
+static uint32_t prvNumOfDirtyRegions[GUILayer_1 + 1];
+
+/*
+ * The display is divided into a grid of cells and every cell has a bitmap of the objects that overlap it, one bit
+ * per index in the object lists. A touch only has to check the objects in the cell it's in. Objects never move so
+ * the bitmaps are set when the objects are added, layer and display state are checked when the touch happens.
+ */
+static uint32_t prvButtonTouchGrid[guiConfigTOUCH_GRID_ROWS][guiConfigTOUCH_GRID_COLUMNS][TOUCH_GRID_BUTTON_WORDS];
+static uint32_t prvTextBoxTouchGrid[guiConfigTOUCH_GRID_ROWS][guiConfigTOUCH_GRID_COLUMNS][TOUCH_GRID_TEXT_BOX_WORDS];
+static uint32_t prvContainerTouchGrid[guiConfigTOUCH_GRID_ROWS][guiConfigTOUCH_GRID_COLUMNS][TOUCH_GRID_CONTAINER_WORDS];
+
+
+/* Text buffer pool, a block is free when it has no owner */
+static uint8_t prvTextBufferPool[guiConfigTEXT_BUFFER_POOL_NUM_OF_BLOCKS][guiConfigTEXT_BUFFER_POOL_BLOCK_SIZE];
+static GUITextBox* prvTextBufferPoolOwner[guiConfigTEXT_BUFFER_POOL_NUM_OF_BLOCKS];
+static GUITextBufferPoolStats prvTextBufferPoolStats;
+
+/*
+ * Read cache, the data is in CCM RAM which the DMA can't access so pages are read to the bounce buffer first.
+ * The least recently used page is replaced when a new page is needed.
+ */
+static uint8_t prvReadCacheData[guiConfigREAD_CACHE_NUM_OF_PAGES][guiConfigREAD_CACHE_PAGE_SIZE] __attribute__((section(".bss.CCMRAM")));
+static uint8_t prvReadCacheBounceBuffer[guiConfigREAD_CACHE_PAGE_SIZE];
+static GUIReadCachePage prvReadCachePages[guiConfigREAD_CACHE_NUM_OF_PAGES];
+static uint32_t prvReadCacheClock = 0;
+static uint32_t prvReadCacheLastAddress = READ_CACHE_INVALID_ADDRESS;
+static GUIReadCacheStats prvReadCacheStats;
+
+/*
+ * Index of the text box whose scrollbar or minimap a touch started on, it gets all touch events until the touch
+ * is released
+ */
+static uint32_t prvScrollbarTouchOwner = guiConfigINVALID_ID;
+static bool prvTouchOwnerIsMinimap = false;
+static bool prvTouchIsDown = false;
+
+/*
+ * Buckets read from the minimapFunction. Drawing and touches have their own as the minimaps are drawn by the
+ * tasks that manage the text boxes while touches are handled in the LCD task.
+ */
+static GUIMinimapBucket prvMinimapBuckets[guiConfigMINIMAP_MAX_NUM_OF_BUCKETS];
+static GUIMinimapBucket prvMinimapTouchBuckets[guiConfigMINIMAP_MAX_NUM_OF_BUCKETS];
 
 /* Private function prototypes -----------------------------------------------*/
 static int32_t prvItoa(int32_t Number, uint8_t* Buffer);
 static void prvErrorHandler();
 
+static LCDActiveWindow prvGetWindowForObject(GUIObject* Object);
+static void prvInvalidateObject(GUIObject* Object);
+static uint32_t prvRegionArea(LCDActiveWindow* Region);
+static LCDActiveWindow prvRegionUnion(LCDActiveWindow* A, LCDActiveWindow* B);
+static void prvRegionAddPartlyCoveredObjects(LCDActiveWindow* Region);
+static bool prvObjectIsVisibleInRegion(GUIObject* Object, LCDActiveWindow* Region);
+static bool prvObjectCoversRegion(GUIObject* Object, LCDActiveWindow* Region);
+static bool prvObjectIsOnActivePage(GUIObject* Object, GUIContainer* Container);
+static void prvSetDisplayStateForContent(GUIContainer* Container, bool ContainerIsVisible);
+static void prvContainerShowActivePage(uint32_t ContainerId);
+static bool prvTextBoxAllocateBuffer(GUITextBox* TextBox);
+static void prvTextBoxReleaseBuffer(GUITextBox* TextBox);
+static uint32_t prvTextBoxGetCharsPerDataRow(GUITextBox* TextBox);
+static LCDActiveWindow prvTextBoxGetDataWindow(GUITextBox* TextBox);
+static LCDActiveWindow prvTextBoxGetScrollbarWindow(GUITextBox* TextBox);
+static void prvTextBoxReadData(GUITextBox* TextBox, uint8_t* pBuffer, uint32_t Address, uint32_t Size);
+static int32_t prvReadCacheGetPage(GUITextBox* TextBox, uint32_t PageAddress, bool ReadIfMissing);
+static void prvReadCacheInvalidate(uint32_t StartAddress, uint32_t EndAddress);
+static void prvTextBoxDrawScrollbar(GUITextBox* TextBox);
+static void prvTextBoxScrollbarTouchAt(uint32_t Index, uint16_t YPos);
+static LCDActiveWindow prvTextBoxGetMinimapWindow(GUITextBox* TextBox);
+static void prvTextBoxDrawMinimap(GUITextBox* TextBox);
+static void prvTextBoxMinimapTouchAt(uint32_t Index, uint16_t YPos);
+static void prvTextBoxSetPendingPosition(GUITextBox* TextBox, uint32_t Position);
+static inline bool prvObjectIsAdded(GUIObject* Object);
+static inline GUIButton* prvGetButtonInContainer(GUIContainer* Container, uint32_t Index);
+static inline GUITextBox* prvGetTextBoxInContainer(GUIContainer* Container, uint32_t Index);
+static inline GUIContainer* prvGetContainerInContainer(GUIContainer* Container, uint32_t Index);
+
+static void prvTouchGridAddObject(uint32_t* pGrid, uint32_t WordsPerCell, GUIObject* Object, uint32_t Index);
+static uint32_t* prvTouchGridGetCell(uint32_t* pGrid, uint32_t WordsPerCell, uint16_t XPos, uint16_t YPos);
+
 /* Functions -----------------------------------------------------------------*/
 /**
  * @brief	Initializes the GUI by setting the items in the lists to appropriate values
@@ -77,6 +169,20 @@ void GUI_Init()
 	{
 		memset(&prvContainer_list[i], 0, sizeof(GUIContainer));
 	}
+
+	/* Touch grids */
+	memset(prvButtonTouchGrid, 0, sizeof(prvButtonTouchGrid));
+	memset(prvTextBoxTouchGrid, 0, sizeof(prvTextBoxTouchGrid));
+	memset(prvContainerTouchGrid, 0, sizeof(prvContainerTouchGrid));
+
+	/* Text buffer pool */
+	memset(prvTextBufferPoolOwner, 0, sizeof(prvTextBufferPoolOwner));
+	memset(&prvTextBufferPoolStats, 0, sizeof(GUITextBufferPoolStats));
+	prvTextBufferPoolStats.numOfBlocks = guiConfigTEXT_BUFFER_POOL_NUM_OF_BLOCKS;
+
+	/* Read cache, only the page addresses have to be valid */
+	prvReadCacheInvalidate(0, READ_CACHE_INVALID_ADDRESS);
+	memset(&prvReadCacheStats, 0, sizeof(GUIReadCacheStats));
 }
 
 /**
@@ -121,6 +227,8 @@ void GUI_DrawBorder(GUIObject Object)
  */
 void GUI_RedrawLayer(GUILayer Layer)
 {
+	GUI_RedrawDirtyRegions();
+
 	/* Buttons */
 	for (uint32_t i = 0; i < guiConfigNUMBER_OF_BUTTONS; i++)
 	{
@@ -148,6 +256,9 @@ void GUI_RedrawLayer(GUILayer Layer)
  */
 void GUI_SetActiveLayer(GUILayer Layer)
 {
+	/* Changes on the old layer should be visible before anything is drawn on the new layer */
+	GUI_RedrawDirtyRegions();
+
 	prvCurrentlyActiveLayer = Layer;
 }
 
@@ -161,6 +272,240 @@ GUILayer GUI_GetActiveLayer()
 	return prvCurrentlyActiveLayer;
 }
 
+/**
+ * @brief	Mark a region of a layer as changed so that it's redrawn by GUI_RedrawDirtyRegions
+ * @param	Layer: The layer the region is on
+ * @param	Region: The region to redraw
+ * @retval	None
+ * @note	The region is merged with a region already marked if the merged region has no more pixels than the
+ * 			two together, so merging never adds to the pixels that are redrawn even though the merged region can
+ * 			include pixels that haven't changed. If all guiConfigMAX_NUM_OF_DIRTY_REGIONS are used it's merged with
+ * 			the region that grows the least.
+ */
+void GUI_InvalidateRegion(GUILayer Layer, LCDActiveWindow Region)
+{
+	if (Layer > GUILayer_1 || Region.xLeft > Region.xRight || Region.yTop > Region.yBottom)
+	{
+		prvErrorHandler();
+		return;
+	}
+
+	if (Region.xRight >= guiConfigDISPLAY_WIDTH)
+		Region.xRight = guiConfigDISPLAY_WIDTH - 1;
+	if (Region.yBottom >= guiConfigDISPLAY_HEIGHT)
+		Region.yBottom = guiConfigDISPLAY_HEIGHT - 1;
+
+	LCDActiveWindow* regions = prvDirtyRegions[Layer];
+	uint32_t* numOfRegions = &prvNumOfDirtyRegions[Layer];
+
+	/* Merge with the regions it overlaps or is next to, the merged region can then be merged with another one */
+	bool regionWasMerged;
+	do
+	{
+		regionWasMerged = false;
+		for (uint32_t i = 0; i < *numOfRegions; i++)
+		{
+			LCDActiveWindow merged = prvRegionUnion(&regions[i], &Region);
+			if (prvRegionArea(&merged) <= prvRegionArea(&regions[i]) + prvRegionArea(&Region))
+			{
+				Region = merged;
+				regions[i] = regions[--(*numOfRegions)];
+				regionWasMerged = true;
+				break;
+			}
+		}
+	} while (regionWasMerged);
+
+	/* No room left, merge with the region that grows the least */
+	if (*numOfRegions == guiConfigMAX_NUM_OF_DIRTY_REGIONS)
+	{
+		uint32_t bestIndex = 0;
+		uint32_t smallestGrowth = UINT32_MAX;
+		for (uint32_t i = 0; i < *numOfRegions; i++)
+		{
+			LCDActiveWindow merged = prvRegionUnion(&regions[i], &Region);
+			uint32_t growth = prvRegionArea(&merged) - prvRegionArea(&regions[i]);
+			if (growth < smallestGrowth)
+			{
+				smallestGrowth = growth;
+				bestIndex = i;
+			}
+		}
+		Region = prvRegionUnion(&regions[bestIndex], &Region);
+		regions[bestIndex] = regions[--(*numOfRegions)];
+	}
+
+	regions[(*numOfRegions)++] = Region;
+}
+
+/**
+ * @brief	Redraw the regions of the active layer that have changed
+ * @param	None
+ * @retval	None
+ * @note	Only the objects that are visible in a region are drawn and the drawing is clipped to the region.
+ * 			A region is first grown to cover all of the buttons and text boxes it's partly over as the LCD can
+ * 			only draw whole characters. This is called by all functions that draw directly so that things are
+ * 			drawn in the same order as they were changed, the LCD task also calls it every time it has handled
+ * 			its events.
+ */
+void GUI_RedrawDirtyRegions()
+{
+	GUILayer layer = prvCurrentlyActiveLayer;
+	uint32_t numOfRegions = prvNumOfDirtyRegions[layer];
+	if (numOfRegions == 0)
+		return;
+
+	/* Take the regions out of the list first as the draw functions below will call this function again */
+	LCDActiveWindow regions[guiConfigMAX_NUM_OF_DIRTY_REGIONS];
+	memcpy(regions, prvDirtyRegions[layer], numOfRegions * sizeof(LCDActiveWindow));
+	prvNumOfDirtyRegions[layer] = 0;
+
+	for (uint32_t r = 0; r < numOfRegions; r++)
+	{
+		LCDActiveWindow* region = &regions[r];
+		prvRegionAddPartlyCoveredObjects(region);
+		LCD_SetClipWindow(*region);
+
+		/* Find the visible containers, biggest first so that containers inside other containers are drawn on top */
+		GUIContainer* containers[guiConfigNUMBER_OF_CONTAINERS];
+		uint32_t numOfContainers = 0;
+		bool regionIsCovered = false;
+		for (uint32_t i = 0; i < guiConfigNUMBER_OF_CONTAINERS; i++)
+		{
+			GUIContainer* container = &prvContainer_list[i];
+			if (prvObjectIsVisibleInRegion(&container->object, region))
+			{
+				uint32_t area = container->object.width * container->object.height;
+				uint32_t j = numOfContainers++;
+				while (j > 0 && containers[j-1]->object.width * containers[j-1]->object.height < area)
+				{
+					containers[j] = containers[j-1];
+					j--;
+				}
+				containers[j] = container;
+
+				if (prvObjectCoversRegion(&container->object, region))
+					regionIsCovered = true;
+			}
+		}
+
+		/* A button or text box that covers the region fills all of it so nothing under it has to be cleared */
+		bool regionIsFilled = false;
+		for (uint32_t i = 0; i < guiConfigNUMBER_OF_BUTTONS + guiConfigNUMBER_OF_TEXT_BOXES && !regionIsFilled; i++)
+		{
+			GUIObject* object = (i < guiConfigNUMBER_OF_BUTTONS) ? &prvButton_list[i].object :
+																 &prvTextBox_list[i - guiConfigNUMBER_OF_BUTTONS].object;
+			regionIsFilled = prvObjectIsVisibleInRegion(object, region) && prvObjectCoversRegion(object, region);
+		}
+
+		/* Clear the parts that no container is covering */
+		if (!regionIsCovered && !regionIsFilled)
+		{
+			LCD_SetBackgroundColor(LCD_COLOR_BLACK);
+			LCD_ClearActiveWindow(region->xLeft, region->xRight, region->yTop, region->yBottom);
+		}
+
+		/* Container backgrounds */
+		for (uint32_t i = 0; i < numOfContainers && !regionIsFilled; i++)
+		{
+			LCDActiveWindow window = prvGetWindowForObject(&containers[i]->object);
+			LCD_SetBackgroundColor(containers[i]->backgroundColor);
+			LCD_ClearActiveWindow(window.xLeft, window.xRight, window.yTop, window.yBottom);
+		}
+
+		/* Buttons */
+		for (uint32_t i = 0; i < guiConfigNUMBER_OF_BUTTONS; i++)
+		{
+			if (prvObjectIsVisibleInRegion(&prvButton_list[i].object, region))
+				GUIButton_Draw(prvButton_list[i].object.id);
+		}
+
+		/* Text boxes, the ones showing data from memory read and write the displayed data again */
+		for (uint32_t i = 0; i < guiConfigNUMBER_OF_TEXT_BOXES; i++)
+		{
+			GUITextBox* textBox = &prvTextBox_list[i];
+			if (!prvObjectIsVisibleInRegion(&textBox->object, region))
+				continue;
+
+			if (textBox->dataReadFunction != 0 && textBox->textBuffer != 0)
+				GUITextBox_RefreshCurrentDataFromMemory(textBox->object.id);
+			else
+			{
+				GUITextBox_Draw(textBox->object.id);
+				/* Text written to the text box is not saved so the next text starts at the top like after a clear */
+				if (textBox->staticText == 0)
+				{
+					textBox->xWritePos = 0;
+					textBox->yWritePos = 0;
+				}
+			}
+		}
+
+		/* Container borders are drawn last like in GUIContainer_Draw */
+		for (uint32_t i = 0; i < numOfContainers; i++)
+		{
+			GUI_DrawBorder(containers[i]->object);
+		}
+	}
+
+	LCD_ResetClipWindow();
+}
+
+/**
+ * @brief	Get the statistics for the text buffer pool
+ * @param	pStats: Pointer to where the statistics should be copied
+ * @retval	None
+ */
+void GUI_GetTextBufferPoolStats(GUITextBufferPoolStats* pStats)
+{
+	memcpy(pStats, &prvTextBufferPoolStats, sizeof(GUITextBufferPoolStats));
+}
+
+/**
+ * @brief	Get the statistics for the read cache
+ * @param	pStats: Pointer to where the statistics should be copied
+ * @retval	None
+ */
+void GUI_GetReadCacheStats(GUIReadCacheStats* pStats)
+{
+	memcpy(pStats, &prvReadCacheStats, sizeof(GUIReadCacheStats));
+}
+
+/**
+ * @brief	Add all objects in a layout
+ * @param	Layout: The layout with the tables of objects to add
+ * @retval	GUIErrorStatus_Success: If everything went OK
+ * @retval	The status of the first object that failed otherwise
+ */
+GUIErrorStatus GUI_AddLayout(const GUILayout* Layout)
+{
+	GUIErrorStatus status = GUIErrorStatus_Success;
+	GUIErrorStatus objectStatus;
+
+	for (uint32_t i = 0; i < Layout->numOfTextBoxes; i++)
+	{
+		objectStatus = GUITextBox_Add(&Layout->textBoxes[i]);
+		if (objectStatus != GUIErrorStatus_Success && status == GUIErrorStatus_Success)
+			status = objectStatus;
+	}
+
+	for (uint32_t i = 0; i < Layout->numOfButtons; i++)
+	{
+		objectStatus = GUIButton_Add(&Layout->buttons[i]);
+		if (objectStatus != GUIErrorStatus_Success && status == GUIErrorStatus_Success)
+			status = objectStatus;
+	}
+
+	for (uint32_t i = 0; i < Layout->numOfContainers; i++)
+	{
+		objectStatus = GUIContainer_Add(&Layout->containers[i]);
+		if (objectStatus != GUIErrorStatus_Success && status == GUIErrorStatus_Success)
+			status = objectStatus;
+	}
+
+	return status;
+}
+
 /**
  * @brief	Turn on beep
  * @param	None
@@ -211,12 +556,12 @@ GUIButton* GUIButton_GetFromId(uint32_t ButtonId)
 }
 /**
  * @brief	Add a button to the button list
- * @param	Button: Pointer to a GUIButton_TypeDef struct which data should be copied from
+ * @param	Button: Pointer to a GUIButton struct which data should be copied from, can be in flash
  * @retval	GUIErrorStatus_Success: If everything went OK
  * @retval	GUIErrorStatus_InvalidId: If the ID is invalid
  * @retval	GUIErrorStatus_Error: If button was hidden or something else went wrong
  */
-GUIErrorStatus GUIButton_Add(GUIButton* Button)
+GUIErrorStatus GUIButton_Add(const GUIButton* Button)
 {
 	uint32_t index = Button->object.id - guiConfigBUTTON_ID_OFFSET;
 	GUIErrorStatus status = GUIErrorStatus_Success;
@@ -229,6 +574,7 @@ GUIErrorStatus GUIButton_Add(GUIButton* Button)
 
 		/* Get a pointer to the current button */
 		GUIButton* button = &prvButton_list[index];
+		prvTouchGridAddObject(&prvButtonTouchGrid[0][0][0], TOUCH_GRID_BUTTON_WORDS, &button->object, index);
 
 		/* Two rows of text */
 		if (button->text[0] != 0 && button->text[1] != 0)
@@ -260,9 +606,6 @@ GUIErrorStatus GUIButton_Add(GUIButton* Button)
 		status = GUIErrorStatus_InvalidId;
 	}
 
-	/* Set all the data in the Button we received as a parameter to 0 so that it can be reused easily */
-	memset(Button, 0, sizeof(GUIButton));
-
 	return status;
 }
 
@@ -275,6 +618,8 @@ GUIErrorStatus GUIButton_Add(GUIButton* Button)
  */
 GUIErrorStatus GUIButton_Hide(uint32_t ButtonId)
 {
+	GUI_RedrawDirtyRegions();
+
 	uint32_t index = ButtonId - guiConfigBUTTON_ID_OFFSET;
 
 	/* Make sure the index is valid and that the correct layer is active */
@@ -310,6 +655,8 @@ GUIErrorStatus GUIButton_Hide(uint32_t ButtonId)
  */
 GUIErrorStatus GUIButton_Draw(uint32_t ButtonId)
 {
+	GUI_RedrawDirtyRegions();
+
 	uint32_t index = ButtonId - guiConfigBUTTON_ID_OFFSET;
 
 	/* Make sure the index is valid and that the correct layer is active */
@@ -392,7 +739,7 @@ void GUIButton_DrawAll()
 {
 	for (uint32_t i = 0; i < guiConfigNUMBER_OF_BUTTONS; i++)
 	{
-		GUIButton_Draw(i);
+		GUIButton_Draw(guiConfigBUTTON_ID_OFFSET + i);
 	}
 }
 
@@ -408,8 +755,19 @@ GUIErrorStatus GUIButton_SetState(uint32_t ButtonId, GUIButtonState State)
 	uint32_t index = ButtonId - guiConfigBUTTON_ID_OFFSET;
 	if (index < guiConfigNUMBER_OF_BUTTONS)
 	{
-		prvButton_list[index].state = State;
-		return GUIButton_Draw(index);
+		GUIButton* button = &prvButton_list[index];
+		button->state = State;
+
+		/*
+		 * The button is drawn with the new state the next time the dirty regions are redrawn. Buttons on a layer
+		 * that is not active keep the state and show it when they are drawn again.
+		 */
+		if (button->object.layer == prvCurrentlyActiveLayer)
+		{
+			button->object.displayState = GUIDisplayState_NotHidden;
+			prvInvalidateObject(&button->object);
+		}
+		return GUIErrorStatus_Success;
 	}
 	else
 	{
@@ -442,9 +800,9 @@ GUIErrorStatus GUIButton_SetTextForRow(uint32_t ButtonId, uint8_t* Text, uint32_
 		button->textWidth[Row] = button->numOfChar[Row] * guiConfigFONT_WIDTH_UNIT * button->textSize[Row];
 		button->textHeight[Row] = guiConfigFONT_HEIGHT_UNIT * button->textSize[Row];
 
-		/* Draw the button so that the changes appear */
+		/* Redraw the button so that the changes appear */
 		if (button->object.displayState == GUIDisplayState_NotHidden)
-			GUIButton_Draw(ButtonId);
+			prvInvalidateObject(&button->object);
 
 		return GUIErrorStatus_Success;
 	}
@@ -508,54 +866,63 @@ void GUIButton_CheckAllActiveForTouchEventAt(GUITouchEvent Event, uint16_t XPos,
 	static GUIButton* lastActiveButton = 0;
 	static GUIButtonState lastState = GUIButtonState_NoState;
 
-	for (uint32_t index = 0; index < guiConfigNUMBER_OF_BUTTONS; index++)
+	/* Only the buttons in the touched grid cell are checked, lowest index first as before */
+	uint32_t* cell = prvTouchGridGetCell(&prvButtonTouchGrid[0][0][0], TOUCH_GRID_BUTTON_WORDS, XPos, YPos);
+	for (uint32_t word = 0; word < TOUCH_GRID_BUTTON_WORDS; word++)
 	{
-		GUIButton* activeButton = &prvButton_list[index];
-		/* Check if the button is not hidden and enabled and if it's hit */
-		if (activeButton->object.displayState == GUIDisplayState_NotHidden && activeButton->state != GUIButtonState_NoState &&
-			activeButton->object.layer == prvCurrentlyActiveLayer && activeButton->state != GUIButtonState_DisabledTouch &&
-			XPos >= activeButton->object.xPos && XPos <= activeButton->object.xPos + activeButton->object.width &&
-			YPos >= activeButton->object.yPos && YPos <= activeButton->object.yPos + activeButton->object.height)
+		uint32_t candidates = cell[word];
+		while (candidates != 0)
 		{
-			if (Event == GUITouchEvent_Up)
+			uint32_t index = word * 32 + __builtin_ctz(candidates);
+			candidates &= candidates - 1;
+
+			GUIButton* activeButton = &prvButton_list[index];
+			/* Check if the button is not hidden and enabled and if it's hit */
+			if (activeButton->object.displayState == GUIDisplayState_NotHidden && activeButton->state != GUIButtonState_NoState &&
+				activeButton->object.layer == prvCurrentlyActiveLayer && activeButton->state != GUIButtonState_DisabledTouch &&
+				XPos >= activeButton->object.xPos && XPos <= activeButton->object.xPos + activeButton->object.width &&
+				YPos >= activeButton->object.yPos && YPos <= activeButton->object.yPos + activeButton->object.height)
 			{
-				GUIButton_SetState(index + guiConfigBUTTON_ID_OFFSET, lastState);
-				lastActiveButton = 0;
-				lastState = GUIButtonState_Disabled;
-				if (activeButton->touchCallback != 0)
+				if (Event == GUITouchEvent_Up)
 				{
-					activeButton->touchCallback(Event, index + guiConfigBUTTON_ID_OFFSET);
-					if (prvBeepIsOn)
-						BUZZER_BeepNumOfTimes(1);
+					GUIButton_SetState(index + guiConfigBUTTON_ID_OFFSET, lastState);
+					lastActiveButton = 0;
+					lastState = GUIButtonState_Disabled;
+					if (activeButton->touchCallback != 0)
+					{
+						activeButton->touchCallback(Event, index + guiConfigBUTTON_ID_OFFSET);
+						if (prvBeepIsOn)
+							BUZZER_BeepNumOfTimes(1);
+					}
 				}
-			}
-			else if (Event == GUITouchEvent_Down)
-			{
-				/*
-				 * Check if the new button we have hit is different from the last time,
-				 * if so change back the state of the old button and activate the new one
-				 * and save a reference to it
-				 */
-				if (lastActiveButton == 0 || lastActiveButton->object.id != activeButton->object.id)
+				else if (Event == GUITouchEvent_Down)
 				{
 					/*
-					 * If we had a last active button it means the user has moved away from the button while
-					 * still holding down on the screen. We therefore have to reset the state of that button
+					 * Check if the new button we have hit is different from the last time,
+					 * if so change back the state of the old button and activate the new one
+					 * and save a reference to it
 					 */
-					if (lastActiveButton != 0)
-						GUIButton_SetState(lastActiveButton->object.id, lastState);
-
-					/* Save the new button and change it's state */
-					lastState = activeButton->state;
-					lastActiveButton = &prvButton_list[index];
-					GUIButton_SetState(index + guiConfigBUTTON_ID_OFFSET, GUIButtonState_TouchDown);
+					if (lastActiveButton == 0 || lastActiveButton->object.id != activeButton->object.id)
+					{
+						/*
+						 * If we had a last active button it means the user has moved away from the button while
+						 * still holding down on the screen. We therefore have to reset the state of that button
+						 */
+						if (lastActiveButton != 0)
+							GUIButton_SetState(lastActiveButton->object.id, lastState);
+
+						/* Save the new button and change it's state */
+						lastState = activeButton->state;
+						lastActiveButton = &prvButton_list[index];
+						GUIButton_SetState(index + guiConfigBUTTON_ID_OFFSET, GUIButtonState_TouchDown);
+					}
+					/* Otherwise just call the callback as the user is still touching the same button */
+					if (activeButton->touchCallback != 0)
+						activeButton->touchCallback(Event, index + guiConfigBUTTON_ID_OFFSET);
 				}
-				/* Otherwise just call the callback as the user is still touching the same button */
-				if (activeButton->touchCallback != 0)
-					activeButton->touchCallback(Event, index + guiConfigBUTTON_ID_OFFSET);
+				/* Only one button should be active on an event so return when we have found one */
+				return;
 			}
-			/* Only one button should be active on an event so return when we have found one */
-			return;
 		}
 	}
 
@@ -589,11 +956,11 @@ GUITextBox* GUITextBox_GetFromId(uint32_t TextBoxId)
 
 /**
  * @brief	Add a text box to the list
- * @param	TextBox: The text box to add
+ * @param	TextBox: The text box to add, can be in flash
  * @retval	GUIErrorStatus_Success: If everything went OK
  * @retval	GUIErrorStatus_InvalidId: if the ID is invalid
  */
-GUIErrorStatus GUITextBox_Add(GUITextBox* TextBox)
+GUIErrorStatus GUITextBox_Add(const GUITextBox* TextBox)
 {
 	uint32_t index = TextBox->object.id - guiConfigTEXT_BOX_ID_OFFSET;
 	GUIErrorStatus status;
@@ -604,6 +971,17 @@ GUIErrorStatus GUITextBox_Add(GUITextBox* TextBox)
 		/* Copy the text box to the list */
 		memcpy(&prvTextBox_list[index], TextBox, sizeof(GUITextBox));
 		GUITextBox* newTextBox = &prvTextBox_list[index];
+		prvTouchGridAddObject(&prvTextBoxTouchGrid[0][0][0], TOUCH_GRID_TEXT_BOX_WORDS, &newTextBox->object, index);
+
+		/* The scrollbar and the minimap are placed in the right padding so that no text is written over them */
+		if (newTextBox->dataReadFunction == 0)
+			newTextBox->scrollbarWidth = 0;
+		if (newTextBox->dataReadFunction == 0 || newTextBox->minimapFunction == 0)
+			newTextBox->minimapWidth = 0;
+		newTextBox->padding.right += newTextBox->scrollbarWidth + newTextBox->minimapWidth;
+		newTextBox->minimapLastDrawTime = 0;
+		newTextBox->scrollbarThumbHeight = 0;
+		newTextBox->hasPendingPosition = false;
 
 		/* Save effective width and height based on how much padding we got */
 		newTextBox->effectiveWidth = newTextBox->object.width - newTextBox->padding.left - newTextBox->padding.right;
@@ -631,8 +1009,11 @@ GUIErrorStatus GUITextBox_Add(GUITextBox* TextBox)
 			GUITextBox_SetWritePosition(newTextBox->object.id, 0, 0);
 		}
 
-		/* Allocate memory for text */
-		newTextBox->textBuffer = pvPortMalloc(newTextBox->maxNumOfCharacters);
+		/*
+		 * Memory for the text is only used by text boxes that read from memory, it's taken from the text buffer
+		 * pool the first time data is read so only visible text boxes have a buffer
+		 */
+		newTextBox->textBuffer = 0;
 
 		/* If it's set to not hidden we should draw the text box */
 		if (newTextBox->object.displayState == GUIDisplayState_NotHidden)
@@ -644,9 +1025,6 @@ GUIErrorStatus GUITextBox_Add(GUITextBox* TextBox)
 		status = GUIErrorStatus_InvalidId;
 	}
 
-	/* Set all the data in the TextBox we received as a parameter to 0 so that it can be reused easily */
-	memset(TextBox, 0, sizeof(GUITextBox));
-
 	return status;
 }
 
@@ -658,6 +1036,8 @@ GUIErrorStatus GUITextBox_Add(GUITextBox* TextBox)
  */
 GUIErrorStatus GUITextBox_Hide(uint32_t TextBoxId)
 {
+	GUI_RedrawDirtyRegions();
+
 	uint32_t index = TextBoxId - guiConfigTEXT_BOX_ID_OFFSET;
 
 	/* Make sure the index is valid and that the correct layer is active */
@@ -673,6 +1053,7 @@ GUIErrorStatus GUITextBox_Hide(uint32_t TextBoxId)
 		window.yBottom = prvTextBox_list[index].object.yPos + prvTextBox_list[index].object.height - 1;
 		LCD_ClearActiveWindow(window.xLeft, window.xRight, window.yTop, window.yBottom);
 		prvTextBox_list[index].object.displayState = GUIDisplayState_Hidden;
+		prvTextBoxReleaseBuffer(&prvTextBox_list[index]);
 		return GUIErrorStatus_Success;
 	}
 	else
@@ -690,6 +1071,8 @@ GUIErrorStatus GUITextBox_Hide(uint32_t TextBoxId)
  */
 GUIErrorStatus GUITextBox_Draw(uint32_t TextBoxId)
 {
+	GUI_RedrawDirtyRegions();
+
 	uint32_t index = TextBoxId - guiConfigTEXT_BOX_ID_OFFSET;
 
 	/* Make sure the index is valid */
@@ -720,6 +1103,11 @@ GUIErrorStatus GUITextBox_Draw(uint32_t TextBoxId)
 			{
 				GUITextBox_WriteString(TextBoxId, textBox->staticText);
 			}
+
+			/* The whole text box was cleared so the scrollbar must be drawn even if the thumb didn't move */
+			textBox->scrollbarThumbHeight = 0;
+			prvTextBoxDrawScrollbar(textBox);
+			prvTextBoxDrawMinimap(textBox);
 			return GUIErrorStatus_Success;
 		}
 		else
@@ -794,6 +1182,8 @@ GUIErrorStatus GUITextBox_ClearAndResetWritePosition(uint32_t TextBoxId)
  */
 GUIErrorStatus GUITextBox_WriteString(uint32_t TextBoxId, uint8_t* String)
 {
+	GUI_RedrawDirtyRegions();
+
 	uint32_t index = TextBoxId - guiConfigTEXT_BOX_ID_OFFSET;
 
 	/* Make sure the index is valid and that the correct layer is active */
@@ -842,6 +1232,8 @@ GUIErrorStatus GUITextBox_WriteString(uint32_t TextBoxId, uint8_t* String)
  */
 GUIErrorStatus GUITextBox_WriteBuffer(uint32_t TextBoxId, uint8_t* pBuffer, uint32_t Size)
 {
+	GUI_RedrawDirtyRegions();
+
 	uint32_t index = TextBoxId - guiConfigTEXT_BOX_ID_OFFSET;
 
 	/* Make sure the index is valid and that the correct layer is active */
@@ -893,6 +1285,8 @@ GUIErrorStatus GUITextBox_WriteBuffer(uint32_t TextBoxId, uint8_t* pBuffer, uint
  */
 GUIErrorStatus GUITextBox_WriteBufferWithFormat(uint32_t TextBoxId, uint8_t* pBuffer, uint32_t Size, GUITextFormat Format)
 {
+	GUI_RedrawDirtyRegions();
+
 	uint32_t index = TextBoxId - guiConfigTEXT_BOX_ID_OFFSET;
 
 	/* Make sure the index is valid and that the correct layer is active */
@@ -948,30 +1342,8 @@ GUIErrorStatus GUITextBox_FormatDataForTextBox(uint32_t TextBoxId, const uint8_t
 	{
 		GUITextBox* textBox = &prvTextBox_list[index];
 
-		if (textBox->textFormat == GUITextFormat_ASCII)
-		{
-			*pFormattedSize = SourceSize;
-			memcpy(pFormattedData, pSourceData, SourceSize);
-		}
-		else if (textBox->textFormat == GUITextFormat_HexWithSpaces)
-		{
-			for (uint32_t i = 0; i < SourceSize; i++)
-			{
-				pFormattedData[i*3] = prvHexTable[pSourceData[i] >> 4];
-				pFormattedData[i*3+1] = prvHexTable[pSourceData[i] & 0x0F];
-				pFormattedData[i*3+2] = ' ';
-				*pFormattedSize += 3;
-			}
-		}
-		else if (textBox->textFormat == GUITextFormat_HexWithoutSpaces)
-		{
-			for (uint32_t i = 0; i < SourceSize; i++)
-			{
-				pFormattedData[i*2] = prvHexTable[pSourceData[i] >> 4];
-				pFormattedData[i*2+1] = prvHexTable[pSourceData[i] & 0x0F];
-				*pFormattedSize += 2;
-			}
-		}
+		/* The GUI and LCD text formats are in the same order */
+		*pFormattedSize += LCD_FormatBuffer(pSourceData, SourceSize, pFormattedData, (LCDTextFormat)textBox->textFormat);
 
 		return GUIErrorStatus_Success;
 	}
@@ -1032,8 +1404,12 @@ GUIErrorStatus GUITextBox_SetStaticText(uint32_t TextBoxId, uint8_t* String)
 		textBox->xWritePos = (textBox->object.width - textBox->staticTextWidth) / 2;
 		textBox->yWritePos = (textBox->object.height - textBox->staticTextHeight) / 2 - 2;
 
-		/* Draw the text box with the new static text */
-		GUITextBox_Draw(TextBoxId);
+		/* Redraw the text box with the new static text */
+		if (textBox->object.layer == prvCurrentlyActiveLayer)
+		{
+			textBox->object.displayState = GUIDisplayState_NotHidden;
+			prvInvalidateObject(&textBox->object);
+		}
 
 		return GUIErrorStatus_Success;
 	}
@@ -1077,25 +1453,29 @@ GUIErrorStatus GUITextBox_NewLine(uint32_t TextBoxId)
  */
 GUIErrorStatus GUITextBox_AppendDataFromMemory(uint32_t TextBoxId, uint32_t NewEndAddress)
 {
+	GUI_RedrawDirtyRegions();
+
 	uint32_t index = TextBoxId - guiConfigTEXT_BOX_ID_OFFSET;
 
 	if (index < guiConfigNUMBER_OF_TEXT_BOXES)
 	{
 		GUITextBox* textBox = &prvTextBox_list[index];
 
-		if (textBox->dataReadFunction != 0)
+		if (textBox->dataReadFunction != 0 && prvTextBoxAllocateBuffer(textBox))
 		{
 			/* Get the data from memory */
 			uint32_t numOfNewBytes = NewEndAddress - textBox->readEndAddress;
 			uint32_t numOfNewCharacters = numOfNewBytes * prvNumOfCharsPerByteForTextFormat[textBox->textFormat];
+			uint32_t charsPerRow = prvTextBoxGetCharsPerDataRow(textBox);
+			uint32_t maxNumOfCharacters = charsPerRow * textBox->maxRows;
 
 			/* Check if the new data will cause it to append beyond the buffer capability */
-			if (textBox->bufferCount + numOfNewCharacters > textBox->maxNumOfCharacters)
+			if (textBox->bufferCount + numOfNewCharacters > maxNumOfCharacters)
 			{
 				/*
 				 * If the number of new characters is more than we can display on one screen we have to handle it.
 				 */
-				if (numOfNewCharacters > textBox->maxNumOfCharacters)
+				if (numOfNewCharacters > maxNumOfCharacters)
 				{
 					/* 1. Set the end address to the last data we have */
 					textBox->readEndAddress = NewEndAddress;
@@ -1104,21 +1484,21 @@ GUIErrorStatus GUITextBox_AppendDataFromMemory(uint32_t TextBoxId, uint32_t NewE
 					/* 2. Calculate how many characters there are on the last row */
 					uint32_t totalAmountOfData = textBox->readEndAddress - textBox->readMinAddress;
 					uint32_t totalNumOfCharacters = totalAmountOfData * prvNumOfCharsPerByteForTextFormat[textBox->textFormat];
-					uint32_t numOfCharactersOnLastRow = totalNumOfCharacters % textBox->maxCharactersPerRow;
+					uint32_t numOfCharactersOnLastRow = totalNumOfCharacters % charsPerRow;
 					uint32_t amountOfDataOnLastRow = numOfCharactersOnLastRow / prvNumOfCharsPerByteForTextFormat[textBox->textFormat];
 
 					/* 3. Update the start address so that the last row is at the bottom of the text box */
 					textBox->readStartAddress = textBox->readEndAddress - amountOfDataOnLastRow -
-												(textBox->maxRows - 1) * (textBox->maxCharactersPerRow / prvNumOfCharsPerByteForTextFormat[textBox->textFormat]);
+												(textBox->maxRows - 1) * (charsPerRow / prvNumOfCharsPerByteForTextFormat[textBox->textFormat]);
 
 					GUITextBox_RefreshCurrentDataFromMemory(TextBoxId);
 					return GUIErrorStatus_Success;
 				}
 
 
-				uint32_t numOfRowsToMove = numOfNewCharacters / textBox->maxCharactersPerRow + 1;
+				uint32_t numOfRowsToMove = numOfNewCharacters / charsPerRow + 1;
 				/* Increment the start address by an amount of rows. */
-				textBox->readStartAddress += numOfRowsToMove * (textBox->maxCharactersPerRow / prvNumOfCharsPerByteForTextFormat[textBox->textFormat]);
+				textBox->readStartAddress += numOfRowsToMove * (charsPerRow / prvNumOfCharsPerByteForTextFormat[textBox->textFormat]);
 
 				/* Refresh the text box now that we have changed the start address */
 				GUITextBox_RefreshCurrentDataFromMemory(TextBoxId);
@@ -1158,11 +1538,7 @@ GUIErrorStatus GUITextBox_AppendDataFromMemory(uint32_t TextBoxId, uint32_t NewE
 			LCD_SetForegroundColor(textBox->textColor);
 
 			/* Get the active window and then write the text in it */
-			LCDActiveWindow window;
-			window.xLeft = textBox->object.xPos + textBox->padding.left;
-			window.xRight = textBox->object.xPos + textBox->object.width - 1 - textBox->padding.right;
-			window.yTop = textBox->object.yPos + textBox->padding.top;
-			window.yBottom = textBox->object.yPos + textBox->object.height - 1 - textBox->padding.bottom;
+			LCDActiveWindow window = prvTextBoxGetDataWindow(textBox);
 
 			uint16_t xWritePosTemp = textBox->object.xPos + textBox->xWritePos;
 			uint16_t yWritePosTemp = textBox->object.yPos + textBox->yWritePos;
@@ -1177,6 +1553,13 @@ GUIErrorStatus GUITextBox_AppendDataFromMemory(uint32_t TextBoxId, uint32_t NewE
 			/* Update the buffer count to reflect the new amount of data it holds */
 			textBox->bufferCount += numOfCharsInFormattedData;
 
+			/* The amount of saved data has changed so the thumb has to be updated */
+			prvTextBoxDrawScrollbar(textBox);
+
+			/* The minimap doesn't change much with every block so it's only redrawn now and then */
+			if (xTaskGetTickCount() - textBox->minimapLastDrawTime >= guiConfigMINIMAP_UPDATE_TIME / portTICK_PERIOD_MS)
+				prvTextBoxDrawMinimap(textBox);
+
 			return GUIErrorStatus_Success;
 		}
 		else
@@ -1216,12 +1599,18 @@ GUIErrorStatus GUITextBox_RefreshCurrentDataFromMemory(uint32_t TextBoxId)
 				goto error;
 			}
 
+			if (!prvTextBoxAllocateBuffer(textBox))
+			{
+				status = GUIErrorStatus_Error;
+				goto error;
+			}
+
 			/* Calculate how many bytes we should read */
 			uint32_t numOfBytesToRead = textBox->readEndAddress - textBox->readStartAddress;
 			/* Update the buffer count to reflect the new amount of data it holds */
 			textBox->bufferCount = numOfBytesToRead;
 			/* Get the data from memory */
-			textBox->dataReadFunction(textBox->textBuffer, textBox->readStartAddress, numOfBytesToRead, 100);
+			prvTextBoxReadData(textBox, textBox->textBuffer, textBox->readStartAddress, numOfBytesToRead);
 
 			/* Format the data */
 			uint32_t numOfBytesInFormattedData = 0;
@@ -1252,11 +1641,7 @@ GUIErrorStatus GUITextBox_RefreshCurrentDataFromMemory(uint32_t TextBoxId)
 			LCD_SetForegroundColor(textBox->textColor);
 
 			/* Get the active window and then write the text in it */
-			LCDActiveWindow window;
-			window.xLeft = textBox->object.xPos + textBox->padding.left;
-			window.xRight = textBox->object.xPos + textBox->object.width - 1 - textBox->padding.right;
-			window.yTop = textBox->object.yPos + textBox->padding.top;
-			window.yBottom = textBox->object.yPos + textBox->object.height - 1 - textBox->padding.bottom;
+			LCDActiveWindow window = prvTextBoxGetDataWindow(textBox);
 
 			uint16_t xWritePosTemp = textBox->object.xPos + textBox->xWritePos;
 			uint16_t yWritePosTemp = textBox->object.yPos + textBox->yWritePos;
@@ -1284,11 +1669,16 @@ error:
  * @param	ChangeStyle:
  * @retval	GUIErrorStatus_Success: If everything went OK
  * @retval	GUIErrorStatus_InvalidId: If the ID is invalid
+ * @retval	GUIErrorStatus_Error: If the format can't be used in a text box
  */
 GUIErrorStatus GUITextBox_ChangeTextFormat(uint32_t TextBoxId, GUITextFormat NewFormat, GUITextFormatChangeStyle ChangeStyle)
 {
 	uint32_t index = TextBoxId - guiConfigTEXT_BOX_ID_OFFSET;
 
+	/* The hex dump is row based and can't be mapped to a fixed number of characters per byte */
+	if (!IS_GUI_TEXT_FORMAT(NewFormat))
+		return GUIErrorStatus_Error;
+
 	/* Make sure the index is valid */
 	if (index < guiConfigNUMBER_OF_TEXT_BOXES)
 	{
@@ -1339,6 +1729,7 @@ GUIErrorStatus GUITextBox_ChangeTextFormat(uint32_t TextBoxId, GUITextFormat New
  * @param	TextBoxId: The id of the text box
  * @param	NumOfRows: Number of rows to move
  * @retval	GUIErrorStatus_Success: If everything went OK
+ * @retval	GUIErrorStatus_EndReached: If it's not possible to move any further in that direction
  * @retval	GUIErrorStatus_InvalidId: If the ID is invalid
  */
 GUIErrorStatus GUITextBox_MoveDisplayedDataNumOfRows(uint32_t TextBoxId, int32_t NumOfRows)
@@ -1413,6 +1804,79 @@ GUIErrorStatus GUITextBox_MoveDisplayedDataNumOfRows(uint32_t TextBoxId, int32_t
 
 			return GUIErrorStatus_Success;
 		}
+
+		/* There is not enough data to move in */
+		return GUIErrorStatus_EndReached;
+	}
+	else
+	{
+		prvErrorHandler();
+		return GUIErrorStatus_InvalidId;
+	}
+}
+
+/**
+ * @brief	Move the displayed data directly to a position in the memory without reading the data in between
+ * @param	TextBoxId: The id of the text box
+ * @param	Position: Number of bytes from the min address where the displayed data should start
+ * @retval	GUIErrorStatus_Success: If everything went OK
+ * @retval	GUIErrorStatus_EndReached: If there's not more than one page of data to move in
+ * @retval	GUIErrorStatus_InvalidId: If the ID is invalid
+ * @retval	GUIErrorStatus_Error: If there's no dataReadFunction
+ * @note	The start is moved back to the closest row boundary so the rows are the same as when moving row by row
+ */
+GUIErrorStatus GUITextBox_MoveDisplayedDataToPosition(uint32_t TextBoxId, uint32_t Position)
+{
+	uint32_t index = TextBoxId - guiConfigTEXT_BOX_ID_OFFSET;
+
+	if (index < guiConfigNUMBER_OF_TEXT_BOXES)
+	{
+		GUITextBox* textBox = &prvTextBox_list[index];
+
+		if (textBox->dataReadFunction == 0)
+			return GUIErrorStatus_Error;
+
+		const uint32_t maxAmountOfData = textBox->maxNumOfCharacters / prvNumOfCharsPerByteForTextFormat[textBox->textFormat];
+		const uint32_t maxDataPerRow = textBox->maxCharactersPerRow / prvNumOfCharsPerByteForTextFormat[textBox->textFormat];
+		const uint32_t totalAmountOfData = textBox->readLastValidByteAddress - textBox->readMinAddress;
+
+		/* Only allow movement if we have saved more than one page of data */
+		if (totalAmountOfData <= maxAmountOfData || maxDataPerRow == 0)
+			return GUIErrorStatus_EndReached;
+
+		uint32_t newStartAddress;
+		uint32_t newEndAddress;
+		bool isScrolling;
+		Position -= Position % maxDataPerRow;
+
+		if (Position + maxAmountOfData >= totalAmountOfData)
+		{
+			/* The last page is displayed the same way as when appending so that new data can be appended again */
+			uint32_t numOfDataOnLastRow = totalAmountOfData % maxDataPerRow;
+			newEndAddress = textBox->readLastValidByteAddress;
+			if (numOfDataOnLastRow)
+				newStartAddress = newEndAddress - numOfDataOnLastRow - (textBox->maxRows-1)*maxDataPerRow;
+			else
+				newStartAddress = newEndAddress - textBox->maxRows*maxDataPerRow;
+			isScrolling = false;
+		}
+		else
+		{
+			newStartAddress = textBox->readMinAddress + Position;
+			newEndAddress = newStartAddress + maxAmountOfData;
+			isScrolling = true;
+		}
+
+		/* Don't read the same data again */
+		if (newStartAddress == textBox->readStartAddress && newEndAddress == textBox->readEndAddress)
+			return GUIErrorStatus_Success;
+
+		textBox->readStartAddress = newStartAddress;
+		textBox->readEndAddress = newEndAddress;
+		textBox->isScrolling = isScrolling;
+
+		/* Refresh the displayed data now that we have changed the limits */
+		return GUITextBox_RefreshCurrentDataFromMemory(TextBoxId);
 	}
 	else
 	{
@@ -1454,6 +1918,62 @@ GUIErrorStatus GUITextBox_ClearDisplayedDataInBuffer(uint32_t TextBoxId)
 	}
 }
 
+/**
+ * @brief	Move the displayed data to the position a touch on the scrollbar or the minimap asked for
+ * @param	TextBoxId: The id of the text box
+ * @retval	GUIErrorStatus_Success: If the data was moved or there was no pending position
+ * @retval	Any other value from GUITextBox_MoveDisplayedDataToPosition if the move failed
+ * @retval	GUIErrorStatus_InvalidId: If the ID is invalid
+ * @note	Must be called from the task that appends data to the text box so the move doesn't race with it
+ */
+GUIErrorStatus GUITextBox_MoveDisplayedDataToPendingPosition(uint32_t TextBoxId)
+{
+	uint32_t index = TextBoxId - guiConfigTEXT_BOX_ID_OFFSET;
+
+	if (index < guiConfigNUMBER_OF_TEXT_BOXES)
+	{
+		GUITextBox* textBox = &prvTextBox_list[index];
+		if (!textBox->hasPendingPosition)
+			return GUIErrorStatus_Success;
+
+		/* Clear the flag before the position is read so a position saved while this reads it is not lost */
+		textBox->hasPendingPosition = false;
+		COMPILER_BARRIER();
+		uint32_t position = textBox->pendingPosition;
+		return GUITextBox_MoveDisplayedDataToPosition(TextBoxId, position);
+	}
+	else
+	{
+		prvErrorHandler();
+		return GUIErrorStatus_InvalidId;
+	}
+}
+
+/**
+ * @brief	Save a position the displayed data should be moved to by the task that manages the text box
+ * @param	TextBoxId: The id of the text box
+ * @param	Position: Number of bytes from the min address where the displayed data should start
+ * @retval	GUIErrorStatus_Success: If everything went OK
+ * @retval	GUIErrorStatus_InvalidId: If the ID is invalid
+ * @note	Used by tasks that don't manage the text box, the move is done by the next call to
+ * 			GUITextBox_MoveDisplayedDataToPendingPosition which is only made while the text box is shown
+ */
+GUIErrorStatus GUITextBox_SetPendingPosition(uint32_t TextBoxId, uint32_t Position)
+{
+	uint32_t index = TextBoxId - guiConfigTEXT_BOX_ID_OFFSET;
+
+	if (index < guiConfigNUMBER_OF_TEXT_BOXES)
+	{
+		prvTextBoxSetPendingPosition(&prvTextBox_list[index], Position);
+		return GUIErrorStatus_Success;
+	}
+	else
+	{
+		prvErrorHandler();
+		return GUIErrorStatus_InvalidId;
+	}
+}
+
 /**
  * @brief	Get the number for the first displayed data item
  * @param	TextBoxId: The id of the text box
@@ -1627,6 +2147,10 @@ GUIErrorStatus GUITextBox_SetAddressesTo(uint32_t TextBoxId, uint32_t NewAddress
 	/* Make sure the index is valid */
 	if (index < guiConfigNUMBER_OF_TEXT_BOXES)
 	{
+		/* The data after the new address will be written again so it can't be in the cache */
+		if (prvTextBox_list[index].dataReadFunction != 0)
+			prvReadCacheInvalidate(NewAddress, prvTextBox_list[index].readMaxAddress);
+
 		prvTextBox_list[index].readEndAddress = NewAddress;
 		prvTextBox_list[index].readStartAddress = NewAddress;
 		prvTextBox_list[index].readLastValidByteAddress = NewAddress;
@@ -1800,30 +2324,77 @@ bool GUITextBox_IsScrolling(uint32_t TextBoxId)
  * @param	GUITouchEvent: The event that happened, can be any value of GUITouchEvent
  * @param	XPos: X-position for event
  * @param	XPos: Y-position for event
- * @retval	None
+ * @retval	true if the event was used by a scrollbar or a minimap and should not be passed on to anything else
+ * @retval	false otherwise
  */
-void GUITextBox_CheckAllActiveForTouchEventAt(GUITouchEvent Event, uint16_t XPos, uint16_t YPos)
+bool GUITextBox_CheckAllActiveForTouchEventAt(GUITouchEvent Event, uint16_t XPos, uint16_t YPos)
 {
-	for (uint32_t index = 0; index < guiConfigNUMBER_OF_TEXT_BOXES; index++)
+	/* A touch that started on a scrollbar stays with it until it's released, even if it moves outside of it */
+	if (prvScrollbarTouchOwner != guiConfigINVALID_ID)
 	{
-		GUITextBox* activeTextBox = &prvTextBox_list[index];
-		/* Check if the button is not hidden and enabled and if it's hit */
-		if (activeTextBox->object.displayState == GUIDisplayState_NotHidden &&
-			activeTextBox->object.layer == prvCurrentlyActiveLayer &&
-			XPos >= activeTextBox->object.xPos && XPos <= activeTextBox->object.xPos + activeTextBox->object.width &&
-			YPos >= activeTextBox->object.yPos && YPos <= activeTextBox->object.yPos + activeTextBox->object.height)
+		if (Event == GUITouchEvent_Down && prvTouchOwnerIsMinimap)
+			prvTextBoxMinimapTouchAt(prvScrollbarTouchOwner, YPos);
+		else if (Event == GUITouchEvent_Down)
+			prvTextBoxScrollbarTouchAt(prvScrollbarTouchOwner, YPos);
+		else
 		{
-			if (activeTextBox->touchCallback != 0)
-				activeTextBox->touchCallback(Event, XPos, YPos);
-			/* Only one text box should be active on an event so return when we have found one */
-			return;
+			prvScrollbarTouchOwner = guiConfigINVALID_ID;
+			prvTouchIsDown = false;
 		}
+		return true;
 	}
-}
 
-/* Container -----------------------------------------------------------------*/
-/**
- * @brief	Get a pointer to the container corresponding to the id
+	bool touchHasStarted = (Event == GUITouchEvent_Down && !prvTouchIsDown);
+	prvTouchIsDown = (Event == GUITouchEvent_Down);
+
+	uint32_t* cell = prvTouchGridGetCell(&prvTextBoxTouchGrid[0][0][0], TOUCH_GRID_TEXT_BOX_WORDS, XPos, YPos);
+	for (uint32_t word = 0; word < TOUCH_GRID_TEXT_BOX_WORDS; word++)
+	{
+		uint32_t candidates = cell[word];
+		while (candidates != 0)
+		{
+			uint32_t index = word * 32 + __builtin_ctz(candidates);
+			candidates &= candidates - 1;
+
+			GUITextBox* activeTextBox = &prvTextBox_list[index];
+			/* Check if the button is not hidden and enabled and if it's hit */
+			if (activeTextBox->object.displayState == GUIDisplayState_NotHidden &&
+				activeTextBox->object.layer == prvCurrentlyActiveLayer &&
+				XPos >= activeTextBox->object.xPos && XPos <= activeTextBox->object.xPos + activeTextBox->object.width &&
+				YPos >= activeTextBox->object.yPos && YPos <= activeTextBox->object.yPos + activeTextBox->object.height)
+			{
+				/* Check if the touch started on the scrollbar or the minimap */
+				if (touchHasStarted && activeTextBox->scrollbarWidth != 0 &&
+					XPos >= prvTextBoxGetScrollbarWindow(activeTextBox).xLeft)
+				{
+					prvScrollbarTouchOwner = index;
+					prvTouchOwnerIsMinimap = false;
+					prvTextBoxScrollbarTouchAt(index, YPos);
+					return true;
+				}
+				else if (touchHasStarted && activeTextBox->minimapWidth != 0 &&
+						 XPos >= prvTextBoxGetMinimapWindow(activeTextBox).xLeft)
+				{
+					prvScrollbarTouchOwner = index;
+					prvTouchOwnerIsMinimap = true;
+					prvTextBoxMinimapTouchAt(index, YPos);
+					return true;
+				}
+
+				if (activeTextBox->touchCallback != 0)
+					activeTextBox->touchCallback(Event, XPos, YPos);
+				/* Only one text box should be active on an event so return when we have found one */
+				return false;
+			}
+		}
+	}
+
+	return false;
+}
+
+/* Container -----------------------------------------------------------------*/
+/**
+ * @brief	Get a pointer to the container corresponding to the id
  * @param	ContainerId: The id of the container to get
  * @retval	Pointer the container or 0 if no container was found
  */
@@ -1842,20 +2413,81 @@ GUIContainer* GUIContainer_GetFromId(uint32_t ContainerId)
 
 /**
  * @brief	Add a container to the list
- * @param	Container: Pointer to the container to add
+ * @param	Container: Pointer to the container to add, can be in flash
  * @retval	GUIErrorStatus_Success: If everything went OK
  * @retval	GUIErrorStatus_InvalidId: If the ID is invalid
+ * @note	The objects in the container can be added later, they are left out when the container is drawn or
+ * 			hidden until then
  */
-GUIErrorStatus GUIContainer_Add(GUIContainer* Container)
+GUIErrorStatus GUIContainer_Add(const GUIContainerTemplate* Container)
 {
 	uint32_t index = Container->object.id - guiConfigCONTAINER_ID_OFFSET;
-	GUIErrorStatus status;
+	GUIErrorStatus status = GUIErrorStatus_Success;
 
 	/* Make sure we don't try to create more containers than there's room for in the textBox_list */
 	if (index < guiConfigNUMBER_OF_CONTAINERS)
 	{
 		/* Copy the container to the list */
-		memcpy(&prvContainer_list[index], Container, sizeof(GUIContainer));
+		GUIContainer* container = &prvContainer_list[index];
+		container->object = Container->object;
+		container->contentHideState = Container->contentHideState;
+		container->backgroundColor = Container->backgroundColor;
+		container->activePage = Container->activePage;
+		container->lastPage = Container->lastPage;
+		container->touchCallback = Container->touchCallback;
+		prvTouchGridAddObject(&prvContainerTouchGrid[0][0][0], TOUCH_GRID_CONTAINER_WORDS, &container->object, index);
+
+		/* Save the index of every object in it, the object lists are smaller than 256 so they fit in a byte */
+		uint8_t children[guiConfigMAX_NUM_OF_BUTTONS_IN_CONTAINER + guiConfigMAX_NUM_OF_TEXT_BOXES_IN_CONTAINER +
+						 guiConfigMAX_NUM_OF_CONTAINERS_IN_CONTAINER];
+		uint32_t numOfChildren = 0;
+		container->numOfButtons = 0;
+		container->numOfTextBoxes = 0;
+		container->numOfContainers = 0;
+		for (uint32_t i = 0; i < guiConfigMAX_NUM_OF_BUTTONS_IN_CONTAINER; i++)
+		{
+			uint32_t childIndex = Container->buttons[i] - guiConfigBUTTON_ID_OFFSET;
+			if (Container->buttons[i] != 0 && childIndex < guiConfigNUMBER_OF_BUTTONS)
+			{
+				children[numOfChildren++] = childIndex;
+				container->numOfButtons++;
+			}
+		}
+		for (uint32_t i = 0; i < guiConfigMAX_NUM_OF_TEXT_BOXES_IN_CONTAINER; i++)
+		{
+			uint32_t childIndex = Container->textBoxes[i] - guiConfigTEXT_BOX_ID_OFFSET;
+			if (Container->textBoxes[i] != 0 && childIndex < guiConfigNUMBER_OF_TEXT_BOXES)
+			{
+				children[numOfChildren++] = childIndex;
+				container->numOfTextBoxes++;
+			}
+		}
+		for (uint32_t i = 0; i < guiConfigMAX_NUM_OF_CONTAINERS_IN_CONTAINER; i++)
+		{
+			uint32_t childIndex = Container->containers[i] - guiConfigCONTAINER_ID_OFFSET;
+			if (Container->containers[i] != 0 && childIndex < guiConfigNUMBER_OF_CONTAINERS)
+			{
+				children[numOfChildren++] = childIndex;
+				container->numOfContainers++;
+			}
+		}
+
+		/* Allocate memory for the list of objects */
+		container->children = 0;
+		if (numOfChildren != 0)
+		{
+			container->children = pvPortMalloc(numOfChildren);
+			if (container->children != 0)
+				memcpy(container->children, children, numOfChildren);
+			else
+			{
+				container->numOfButtons = 0;
+				container->numOfTextBoxes = 0;
+				container->numOfContainers = 0;
+				prvErrorHandler();
+				status = GUIErrorStatus_Error;
+			}
+		}
 
 		/* If it's set to not hidden we should draw the button */
 		if (Container->object.displayState == GUIDisplayState_NotHidden)
@@ -1867,9 +2499,6 @@ GUIErrorStatus GUIContainer_Add(GUIContainer* Container)
 		status = GUIErrorStatus_InvalidId;
 	}
 
-	/* Set all the data in the Container we received as a parameter to 0 so that it can be reused easily */
-	memset(Container, 0, sizeof(GUIContainer));
-
 	return status;
 }
 
@@ -1881,32 +2510,36 @@ GUIErrorStatus GUIContainer_Add(GUIContainer* Container)
  */
 GUIErrorStatus GUIContainer_HideContent(uint32_t ContainerId)
 {
+	GUI_RedrawDirtyRegions();
+
 	uint32_t index = ContainerId - guiConfigCONTAINER_ID_OFFSET;
 
 	if (index < guiConfigNUMBER_OF_CONTAINERS)
 	{
+		GUIContainer* container = &prvContainer_list[index];
+
 		/* Hide the buttons */
-		for (uint32_t i = 0; i < guiConfigNUMBER_OF_BUTTONS; i++)
+		for (uint32_t i = 0; i < container->numOfButtons; i++)
 		{
-			if (prvContainer_list[index].buttons[i] != 0 &&
-				prvContainer_list[index].buttons[i]->object.displayState == GUIDisplayState_NotHidden)
-				GUIButton_Hide(prvContainer_list[index].buttons[i]->object.id);
+			GUIButton* button = prvGetButtonInContainer(container, i);
+			if (prvObjectIsAdded(&button->object) && button->object.displayState == GUIDisplayState_NotHidden)
+				GUIButton_Hide(button->object.id);
 		}
 
 		/* Hide the text boxes */
-		for (uint32_t i = 0; i < guiConfigNUMBER_OF_TEXT_BOXES; i++)
+		for (uint32_t i = 0; i < container->numOfTextBoxes; i++)
 		{
-			if (prvContainer_list[index].textBoxes[i] != 0 &&
-				prvContainer_list[index].textBoxes[i]->object.displayState == GUIDisplayState_NotHidden)
-				GUITextBox_Hide(prvContainer_list[index].textBoxes[i]->object.id);
+			GUITextBox* textBox = prvGetTextBoxInContainer(container, i);
+			if (prvObjectIsAdded(&textBox->object) && textBox->object.displayState == GUIDisplayState_NotHidden)
+				GUITextBox_Hide(textBox->object.id);
 		}
 
 		/* Hide the containers */
-		for (uint32_t i = 0; i < guiConfigNUMBER_OF_CONTAINERS; i++)
+		for (uint32_t i = 0; i < container->numOfContainers; i++)
 		{
-			if (prvContainer_list[index].containers[i] != 0 &&
-				prvContainer_list[index].containers[i]->object.displayState == GUIDisplayState_NotHidden)
-				GUIContainer_Hide(prvContainer_list[index].containers[i]->object.id);
+			GUIContainer* childContainer = prvGetContainerInContainer(container, i);
+			if (prvObjectIsAdded(&childContainer->object) && childContainer->object.displayState == GUIDisplayState_NotHidden)
+				GUIContainer_Hide(childContainer->object.id);
 		}
 
 
@@ -1933,6 +2566,8 @@ GUIErrorStatus GUIContainer_HideContent(uint32_t ContainerId)
  */
 GUIErrorStatus GUIContainer_Hide(uint32_t ContainerId)
 {
+	GUI_RedrawDirtyRegions();
+
 	uint32_t index = ContainerId - guiConfigCONTAINER_ID_OFFSET;
 
 	if (index < guiConfigNUMBER_OF_CONTAINERS)
@@ -1947,25 +2582,30 @@ GUIErrorStatus GUIContainer_Hide(uint32_t ContainerId)
 		window.yBottom = prvContainer_list[index].object.yPos + prvContainer_list[index].object.height - 1;
 		LCD_ClearActiveWindow(window.xLeft, window.xRight, window.yTop, window.yBottom);
 
+		GUIContainer* container = &prvContainer_list[index];
+
 		/* Hide the buttons */
-		for (uint32_t i = 0; i < guiConfigNUMBER_OF_BUTTONS; i++)
+		for (uint32_t i = 0; i < container->numOfButtons; i++)
 		{
-			if (prvContainer_list[index].buttons[i] != 0)
-				GUIButton_Hide(prvContainer_list[index].buttons[i]->object.id);
+			GUIButton* button = prvGetButtonInContainer(container, i);
+			if (prvObjectIsAdded(&button->object))
+				GUIButton_Hide(button->object.id);
 		}
 
 		/* Hide the text boxes */
-		for (uint32_t i = 0; i < guiConfigNUMBER_OF_TEXT_BOXES; i++)
+		for (uint32_t i = 0; i < container->numOfTextBoxes; i++)
 		{
-			if (prvContainer_list[index].textBoxes[i] != 0)
-				GUITextBox_Hide(prvContainer_list[index].textBoxes[i]->object.id);
+			GUITextBox* textBox = prvGetTextBoxInContainer(container, i);
+			if (prvObjectIsAdded(&textBox->object))
+				GUITextBox_Hide(textBox->object.id);
 		}
 
 		/* Hide the containers */
-		for (uint32_t i = 0; i < guiConfigNUMBER_OF_CONTAINERS; i++)
+		for (uint32_t i = 0; i < container->numOfContainers; i++)
 		{
-			if (prvContainer_list[index].containers[i] != 0)
-				GUIContainer_Hide(prvContainer_list[index].containers[i]->object.id);
+			GUIContainer* childContainer = prvGetContainerInContainer(container, i);
+			if (prvObjectIsAdded(&childContainer->object))
+				GUIContainer_Hide(childContainer->object.id);
 		}
 
 		prvContainer_list[index].object.displayState = GUIDisplayState_Hidden;
@@ -1987,6 +2627,8 @@ GUIErrorStatus GUIContainer_Hide(uint32_t ContainerId)
  */
 GUIErrorStatus GUIContainer_Draw(uint32_t ContainerId)
 {
+	GUI_RedrawDirtyRegions();
+
 	uint32_t index = ContainerId - guiConfigCONTAINER_ID_OFFSET;
 
 	/* Make sure the index is valid and that the correct layer is active */
@@ -2005,27 +2647,27 @@ GUIErrorStatus GUIContainer_Draw(uint32_t ContainerId)
 		LCD_ClearActiveWindow(window.xLeft, window.xRight, window.yTop, window.yBottom);
 
 		/* Draw the buttons */
-		for (uint32_t i = 0; i < guiConfigNUMBER_OF_BUTTONS; i++)
+		for (uint32_t i = 0; i < container->numOfButtons; i++)
 		{
-			if (container->buttons[i] != 0 && ((container->buttons[i]->object.containerPage & container->activePage) ||
-					(container->buttons[i]->object.containerPage == container->activePage)))
-				GUIButton_Draw(container->buttons[i]->object.id);
+			GUIButton* button = prvGetButtonInContainer(container, i);
+			if (prvObjectIsAdded(&button->object) && prvObjectIsOnActivePage(&button->object, container))
+				GUIButton_Draw(button->object.id);
 		}
 
 		/* Draw the text boxes */
-		for (uint32_t i = 0; i < guiConfigNUMBER_OF_TEXT_BOXES; i++)
+		for (uint32_t i = 0; i < container->numOfTextBoxes; i++)
 		{
-			if (container->textBoxes[i] != 0 && ((container->textBoxes[i]->object.containerPage & container->activePage) ||
-					(container->textBoxes[i]->object.containerPage == container->activePage)))
-				GUITextBox_Draw(container->textBoxes[i]->object.id);
+			GUITextBox* textBox = prvGetTextBoxInContainer(container, i);
+			if (prvObjectIsAdded(&textBox->object) && prvObjectIsOnActivePage(&textBox->object, container))
+				GUITextBox_Draw(textBox->object.id);
 		}
 
 		/* Draw the containers */
-		for (uint32_t i = 0; i < guiConfigNUMBER_OF_CONTAINERS; i++)
+		for (uint32_t i = 0; i < container->numOfContainers; i++)
 		{
-			if (container->containers[i] != 0 && ((container->containers[i]->object.containerPage & container->activePage) ||
-					(container->containers[i]->object.containerPage == container->activePage)))
-				GUIContainer_Draw(container->containers[i]->object.id);
+			GUIContainer* childContainer = prvGetContainerInContainer(container, i);
+			if (prvObjectIsAdded(&childContainer->object) && prvObjectIsOnActivePage(&childContainer->object, container))
+				GUIContainer_Draw(childContainer->object.id);
 		}
 
 		/* Draw the border */
@@ -2060,8 +2702,7 @@ GUIErrorStatus GUIContainer_ChangePage(uint32_t ContainerId, GUIContainerPage Ne
 		if (prvContainer_list[index].activePage != NewPage)
 		{
 			prvContainer_list[index].activePage = NewPage;
-			GUIContainer_HideContent(ContainerId);
-			GUIContainer_Draw(ContainerId);
+			prvContainerShowActivePage(ContainerId);
 			return GUIErrorStatus_Success;
 		}
 		else
@@ -2132,6 +2773,21 @@ GUIDisplayState GUIContainer_GetDisplayState(uint32_t ContainerId)
 		return GUIDisplayState_NoState;
 }
 
+/**
+ * @brief	Check if a container has been added
+ * @param	ContainerId: The container to check
+ * @retval	true if it has been added, false if not or if the ID is invalid
+ */
+bool GUIContainer_IsAdded(uint32_t ContainerId)
+{
+	uint32_t index = ContainerId - guiConfigCONTAINER_ID_OFFSET;
+
+	if (index < guiConfigNUMBER_OF_CONTAINERS)
+		return prvObjectIsAdded(&prvContainer_list[index].object);
+	else
+		return false;
+}
+
 /**
  * @brief	Increase the page of the container by one
  * @param	ContainerId: The id of the container to check
@@ -2151,8 +2807,7 @@ GUIErrorStatus GUIContainer_IncrementPage(uint32_t ContainerId)
 		{
 			/* Increase the page by one step */
 			container->activePage = container->activePage << 1;
-			GUIContainer_HideContent(ContainerId);
-			GUIContainer_Draw(ContainerId);
+			prvContainerShowActivePage(ContainerId);
 			return GUIErrorStatus_Success;
 		}
 		else
@@ -2187,8 +2842,7 @@ GUIErrorStatus GUIContainer_DecrementPage(uint32_t ContainerId)
 		{
 			/* Decrease the page by one step */
 			container->activePage = container->activePage >> 1;
-			GUIContainer_HideContent(ContainerId);
-			GUIContainer_Draw(ContainerId);
+			prvContainerShowActivePage(ContainerId);
 			return GUIErrorStatus_Success;
 		}
 		else
@@ -2213,19 +2867,27 @@ GUIErrorStatus GUIContainer_DecrementPage(uint32_t ContainerId)
  */
 void GUIContainer_CheckAllActiveForTouchEventAt(GUITouchEvent Event, uint16_t XPos, uint16_t YPos)
 {
-	for (uint32_t index = 0; index < guiConfigNUMBER_OF_CONTAINERS; index++)
+	uint32_t* cell = prvTouchGridGetCell(&prvContainerTouchGrid[0][0][0], TOUCH_GRID_CONTAINER_WORDS, XPos, YPos);
+	for (uint32_t word = 0; word < TOUCH_GRID_CONTAINER_WORDS; word++)
 	{
-		GUIContainer* activeContainer = &prvContainer_list[index];
-		/* Check if the container is not hidden and enabled and if it's hit */
-		if (activeContainer->object.displayState == GUIDisplayState_NotHidden &&
-			activeContainer->object.layer == prvCurrentlyActiveLayer &&
-			XPos >= activeContainer->object.xPos && XPos <= activeContainer->object.xPos + activeContainer->object.width &&
-			YPos >= activeContainer->object.yPos && YPos <= activeContainer->object.yPos + activeContainer->object.height)
+		uint32_t candidates = cell[word];
+		while (candidates != 0)
 		{
-			if (activeContainer->touchCallback != 0)
-				activeContainer->touchCallback(Event, XPos, YPos);
-			/* Only one container should be active on an event so return when we have found one */
-			return;
+			uint32_t index = word * 32 + __builtin_ctz(candidates);
+			candidates &= candidates - 1;
+
+			GUIContainer* activeContainer = &prvContainer_list[index];
+			/* Check if the container is not hidden and enabled and if it's hit */
+			if (activeContainer->object.displayState == GUIDisplayState_NotHidden &&
+				activeContainer->object.layer == prvCurrentlyActiveLayer &&
+				XPos >= activeContainer->object.xPos && XPos <= activeContainer->object.xPos + activeContainer->object.width &&
+				YPos >= activeContainer->object.yPos && YPos <= activeContainer->object.yPos + activeContainer->object.height)
+			{
+				if (activeContainer->touchCallback != 0)
+					activeContainer->touchCallback(Event, XPos, YPos);
+				/* Only one container should be active on an event so return when we have found one */
+				return;
+			}
 		}
 	}
 }
@@ -2327,4 +2989,768 @@ static void prvErrorHandler()
 	HAL_GPIO_TogglePin(GPIOC, GPIO_PIN_2);
 }
 
+/**
+ * @brief	Get the window an object covers on the display
+ * @param	Object: The object
+ * @retval	The window
+ */
+static LCDActiveWindow prvGetWindowForObject(GUIObject* Object)
+{
+	LCDActiveWindow window;
+	window.xLeft = Object->xPos;
+	window.xRight = Object->xPos + Object->width - 1;
+	window.yTop = Object->yPos;
+	window.yBottom = Object->yPos + Object->height - 1;
+	return window;
+}
+
+/**
+ * @brief	Mark the area of an object as dirty on its layer
+ * @param	Object: The object
+ * @retval	None
+ */
+static void prvInvalidateObject(GUIObject* Object)
+{
+	if (Object->width != 0 && Object->height != 0)
+		GUI_InvalidateRegion(Object->layer, prvGetWindowForObject(Object));
+}
+
+/**
+ * @brief	Get the number of pixels in a region
+ * @param	Region: The region
+ * @retval	The number of pixels
+ */
+static uint32_t prvRegionArea(LCDActiveWindow* Region)
+{
+	return (uint32_t)(Region->xRight - Region->xLeft + 1) * (Region->yBottom - Region->yTop + 1);
+}
+
+/**
+ * @brief	Get the smallest region that covers two regions
+ * @param	A: The first region
+ * @param	B: The second region
+ * @retval	The region covering both
+ */
+static LCDActiveWindow prvRegionUnion(LCDActiveWindow* A, LCDActiveWindow* B)
+{
+	LCDActiveWindow result;
+	result.xLeft = (A->xLeft < B->xLeft) ? A->xLeft : B->xLeft;
+	result.xRight = (A->xRight > B->xRight) ? A->xRight : B->xRight;
+	result.yTop = (A->yTop < B->yTop) ? A->yTop : B->yTop;
+	result.yBottom = (A->yBottom > B->yBottom) ? A->yBottom : B->yBottom;
+	return result;
+}
+
+/**
+ * @brief	Grow a region until no character of a visible button or text box is partly in it
+ * @param	Region: The region to grow
+ * @retval	None
+ * @note	The region covers all of the buttons and text boxes it's partly over, except for text boxes showing
+ * 			data from memory. Their characters are on a grid from the top left corner of the data window so the
+ * 			region only has to cover the character cells it's partly over.
+ */
+static void prvRegionAddPartlyCoveredObjects(LCDActiveWindow* Region)
+{
+	bool regionHasGrown;
+	do
+	{
+		regionHasGrown = false;
+		for (uint32_t i = 0; i < guiConfigNUMBER_OF_BUTTONS + guiConfigNUMBER_OF_TEXT_BOXES; i++)
+		{
+			GUIObject* object = (i < guiConfigNUMBER_OF_BUTTONS) ? &prvButton_list[i].object :
+																 &prvTextBox_list[i - guiConfigNUMBER_OF_BUTTONS].object;
+			if (!prvObjectIsVisibleInRegion(object, Region))
+				continue;
+
+			LCDActiveWindow window = prvGetWindowForObject(object);
+			GUITextBox* textBox = (i < guiConfigNUMBER_OF_BUTTONS) ? 0 : &prvTextBox_list[i - guiConfigNUMBER_OF_BUTTONS];
+			if (textBox != 0 && textBox->dataReadFunction != 0 && textBox->textBuffer != 0)
+			{
+				LCDActiveWindow data = prvTextBoxGetDataWindow(textBox);
+				if (data.xLeft > Region->xRight || data.xRight < Region->xLeft ||
+					data.yTop > Region->yBottom || data.yBottom < Region->yTop)
+					continue;
+
+				/* The character cells of the part of the data window that is in the region */
+				uint32_t charWidth = guiConfigFONT_WIDTH_UNIT * textBox->textSize;
+				uint32_t charHeight = guiConfigFONT_HEIGHT_UNIT * textBox->textSize;
+				uint32_t xLeft = (Region->xLeft > data.xLeft) ? Region->xLeft : data.xLeft;
+				uint32_t xRight = (Region->xRight < data.xRight) ? Region->xRight : data.xRight;
+				uint32_t yTop = (Region->yTop > data.yTop) ? Region->yTop : data.yTop;
+				uint32_t yBottom = (Region->yBottom < data.yBottom) ? Region->yBottom : data.yBottom;
+				window.xLeft = data.xLeft + (xLeft - data.xLeft) / charWidth * charWidth;
+				window.xRight = data.xLeft + ((xRight - data.xLeft) / charWidth + 1) * charWidth - 1;
+				window.yTop = data.yTop + (yTop - data.yTop) / charHeight * charHeight;
+				window.yBottom = data.yTop + ((yBottom - data.yTop) / charHeight + 1) * charHeight - 1;
+			}
+
+			LCDActiveWindow merged = prvRegionUnion(Region, &window);
+			if (prvRegionArea(&merged) != prvRegionArea(Region))
+			{
+				*Region = merged;
+				regionHasGrown = true;
+			}
+		}
+	} while (regionHasGrown);
+
+	if (Region->xRight >= guiConfigDISPLAY_WIDTH)
+		Region->xRight = guiConfigDISPLAY_WIDTH - 1;
+	if (Region->yBottom >= guiConfigDISPLAY_HEIGHT)
+		Region->yBottom = guiConfigDISPLAY_HEIGHT - 1;
+}
+
+/**
+ * @brief	Check if an object is drawn on the active layer and if any part of it is inside a region
+ * @param	Object: The object to check
+ * @param	Region: The region to check
+ * @retval	true if it's visible, false otherwise
+ */
+static bool prvObjectIsVisibleInRegion(GUIObject* Object, LCDActiveWindow* Region)
+{
+	return (Object->displayState == GUIDisplayState_NotHidden && Object->layer == prvCurrentlyActiveLayer &&
+			Object->width != 0 && Object->height != 0 &&
+			Object->xPos <= Region->xRight && Object->xPos + Object->width - 1 >= Region->xLeft &&
+			Object->yPos <= Region->yBottom && Object->yPos + Object->height - 1 >= Region->yTop);
+}
+
+/**
+ * @brief	Check if an object covers all of a region
+ * @param	Object: The object to check
+ * @param	Region: The region to check
+ * @retval	true if the region is covered, false otherwise
+ */
+static bool prvObjectCoversRegion(GUIObject* Object, LCDActiveWindow* Region)
+{
+	return (Object->xPos <= Region->xLeft && Object->xPos + Object->width - 1 >= Region->xRight &&
+			Object->yPos <= Region->yTop && Object->yPos + Object->height - 1 >= Region->yBottom);
+}
+
+/**
+ * @brief	Check if an object is on the active page of a container
+ * @param	Object: The object to check
+ * @param	Container: The container the object is in
+ * @retval	true if it's on the active page, false otherwise
+ */
+static bool prvObjectIsOnActivePage(GUIObject* Object, GUIContainer* Container)
+{
+	return ((Object->containerPage & Container->activePage) || (Object->containerPage == Container->activePage));
+}
+
+/**
+ * @brief	Set the display state of everything in a container from the active page, without drawing anything
+ * @param	Container: The container
+ * @param	ContainerIsVisible: If the container itself is visible
+ * @retval	None
+ * @note	Only objects on the active layer are changed, the same as when drawing or hiding
+ */
+static void prvSetDisplayStateForContent(GUIContainer* Container, bool ContainerIsVisible)
+{
+	for (uint32_t i = 0; i < Container->numOfButtons; i++)
+	{
+		GUIButton* button = prvGetButtonInContainer(Container, i);
+		if (prvObjectIsAdded(&button->object) && button->object.layer == prvCurrentlyActiveLayer)
+		{
+			if (ContainerIsVisible && prvObjectIsOnActivePage(&button->object, Container))
+				button->object.displayState = GUIDisplayState_NotHidden;
+			else
+				button->object.displayState = GUIDisplayState_Hidden;
+		}
+	}
+
+	for (uint32_t i = 0; i < Container->numOfTextBoxes; i++)
+	{
+		GUITextBox* textBox = prvGetTextBoxInContainer(Container, i);
+		if (prvObjectIsAdded(&textBox->object) && textBox->object.layer == prvCurrentlyActiveLayer)
+		{
+			if (ContainerIsVisible && prvObjectIsOnActivePage(&textBox->object, Container))
+				textBox->object.displayState = GUIDisplayState_NotHidden;
+			else
+			{
+				textBox->object.displayState = GUIDisplayState_Hidden;
+				prvTextBoxReleaseBuffer(textBox);
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < Container->numOfContainers; i++)
+	{
+		GUIContainer* container = prvGetContainerInContainer(Container, i);
+		if (prvObjectIsAdded(&container->object) && container->object.layer == prvCurrentlyActiveLayer)
+		{
+			bool isVisible = ContainerIsVisible && prvObjectIsOnActivePage(&container->object, Container);
+			container->object.displayState = isVisible ? GUIDisplayState_NotHidden : GUIDisplayState_Hidden;
+			prvSetDisplayStateForContent(container, isVisible);
+		}
+	}
+}
+
+/**
+ * @brief	Show the content on the active page of a container
+ * @param	ContainerId: The id of the container
+ * @retval	None
+ * @note	On the active layer the container is only marked as dirty so that hiding the old page and drawing
+ * 			the new one is done in one pass. On other layers it's done the same way as before.
+ */
+static void prvContainerShowActivePage(uint32_t ContainerId)
+{
+	GUIContainer* container = &prvContainer_list[ContainerId - guiConfigCONTAINER_ID_OFFSET];
+
+	if (container->object.layer == prvCurrentlyActiveLayer)
+	{
+		container->object.displayState = GUIDisplayState_NotHidden;
+		prvSetDisplayStateForContent(container, true);
+		prvInvalidateObject(&container->object);
+	}
+	else
+	{
+		GUIContainer_HideContent(ContainerId);
+		GUIContainer_Draw(ContainerId);
+	}
+}
+
+/**
+ * @brief	Give a text box a text buffer if it doesn't have one
+ * @param	TextBox: The text box
+ * @retval	true if the text box has a buffer, false if there was no memory left
+ * @note	A block from the pool is used if there's one free and the text box fits in it, otherwise the buffer
+ * 			is taken from the heap and kept by the text box as heap_1 can't free it
+ */
+static bool prvTextBoxAllocateBuffer(GUITextBox* TextBox)
+{
+	if (TextBox->textBuffer != 0 || TextBox->maxNumOfCharacters == 0)
+		return (TextBox->textBuffer != 0);
+
+	/* The old content was lost when the buffer was given back */
+	TextBox->bufferCount = 0;
+
+	if (TextBox->maxNumOfCharacters <= guiConfigTEXT_BUFFER_POOL_BLOCK_SIZE)
+	{
+		for (uint32_t i = 0; i < guiConfigTEXT_BUFFER_POOL_NUM_OF_BLOCKS; i++)
+		{
+			if (prvTextBufferPoolOwner[i] == 0)
+			{
+				prvTextBufferPoolOwner[i] = TextBox;
+				TextBox->textBuffer = prvTextBufferPool[i];
+
+				prvTextBufferPoolStats.numOfAllocations++;
+				prvTextBufferPoolStats.numOfBlocksInUse++;
+				if (prvTextBufferPoolStats.numOfBlocksInUse > prvTextBufferPoolStats.maxNumOfBlocksInUse)
+					prvTextBufferPoolStats.maxNumOfBlocksInUse = prvTextBufferPoolStats.numOfBlocksInUse;
+				return true;
+			}
+		}
+	}
+
+	TextBox->textBuffer = pvPortMalloc(TextBox->maxNumOfCharacters);
+	if (TextBox->textBuffer != 0)
+		prvTextBufferPoolStats.numOfHeapFallbacks++;
+
+	return (TextBox->textBuffer != 0);
+}
+
+/**
+ * @brief	Read data for a text box from memory, whole pages before the last valid byte are taken from the cache
+ * @param	TextBox: The text box
+ * @param	pBuffer: Pointer to where the data should be stored, it must be accessible by DMA
+ * @param	Address: Address of the first byte to read
+ * @param	Size: Number of bytes to read
+ * @retval	None
+ * @note	When the data has moved less than a page of data since the last read, pages in the same direction
+ * 			are read ahead so that the next move while scrolling is read from the cache
+ */
+static void prvTextBoxReadData(GUITextBox* TextBox, uint8_t* pBuffer, uint32_t Address, uint32_t Size)
+{
+	const uint32_t cacheableEndAddress = TextBox->readLastValidByteAddress & READ_CACHE_PAGE_MASK;
+	const uint32_t maxAmountOfData = TextBox->maxNumOfCharacters / prvNumOfCharsPerByteForTextFormat[TextBox->textFormat];
+	const uint32_t startAddress = Address;
+	const uint32_t endAddress = Address + Size;
+
+	while (Size != 0)
+	{
+		uint32_t pageAddress = Address & READ_CACHE_PAGE_MASK;
+		uint32_t offset = Address - pageAddress;
+		uint32_t amount = guiConfigREAD_CACHE_PAGE_SIZE - offset;
+		if (amount > Size)
+			amount = Size;
+
+		int32_t page = -1;
+		if (pageAddress + guiConfigREAD_CACHE_PAGE_SIZE <= cacheableEndAddress)
+			page = prvReadCacheGetPage(TextBox, pageAddress, true);
+
+		/* The rest can't be cached so read all of it at once */
+		if (page < 0)
+		{
+			TextBox->dataReadFunction(pBuffer, Address, Size, 100);
+			break;
+		}
+
+		memcpy(pBuffer, &prvReadCacheData[page][offset], amount);
+		pBuffer += amount;
+		Address += amount;
+		Size -= amount;
+	}
+
+	/* Read ahead in the direction we are scrolling, a jump to somewhere else doesn't read ahead */
+	if (prvReadCacheLastAddress != READ_CACHE_INVALID_ADDRESS && startAddress != prvReadCacheLastAddress &&
+		startAddress + maxAmountOfData > prvReadCacheLastAddress && prvReadCacheLastAddress + maxAmountOfData > startAddress)
+	{
+		for (uint32_t i = 1; i <= guiConfigREAD_CACHE_READ_AHEAD_PAGES; i++)
+		{
+			uint32_t pageAddress;
+			if (startAddress < prvReadCacheLastAddress)
+			{
+				pageAddress = (startAddress & READ_CACHE_PAGE_MASK) - i * guiConfigREAD_CACHE_PAGE_SIZE;
+				if (pageAddress < (TextBox->readMinAddress & READ_CACHE_PAGE_MASK) || pageAddress > startAddress)
+					break;
+			}
+			else
+			{
+				pageAddress = ((endAddress - 1) & READ_CACHE_PAGE_MASK) + i * guiConfigREAD_CACHE_PAGE_SIZE;
+				if (pageAddress + guiConfigREAD_CACHE_PAGE_SIZE > cacheableEndAddress)
+					break;
+			}
+
+			if (prvReadCacheGetPage(TextBox, pageAddress, false) < 0 && prvReadCacheGetPage(TextBox, pageAddress, true) >= 0)
+			{
+				/* It was counted as a miss but it was not needed yet */
+				prvReadCacheStats.numOfMisses--;
+				prvReadCacheStats.numOfReadAheads++;
+			}
+		}
+	}
+
+	prvReadCacheLastAddress = startAddress;
+}
+
+/**
+ * @brief	Get the index of a page in the read cache
+ * @param	TextBox: The text box that reads the data
+ * @param	PageAddress: Address of the first byte in the page
+ * @param	ReadIfMissing: true if the page should be read from memory if it's not in the cache
+ * @retval	Index of the page or -1 if it's not in the cache
+ */
+static int32_t prvReadCacheGetPage(GUITextBox* TextBox, uint32_t PageAddress, bool ReadIfMissing)
+{
+	int32_t leastRecentlyUsed = 0;
+
+	for (int32_t i = 0; i < guiConfigREAD_CACHE_NUM_OF_PAGES; i++)
+	{
+		if (prvReadCachePages[i].address == PageAddress)
+		{
+			if (ReadIfMissing)
+			{
+				prvReadCachePages[i].lastUsed = ++prvReadCacheClock;
+				prvReadCacheStats.numOfHits++;
+			}
+			return i;
+		}
+
+		/* Unused pages have lastUsed set to 0 so they will be used first */
+		if (prvReadCachePages[i].lastUsed < prvReadCachePages[leastRecentlyUsed].lastUsed)
+			leastRecentlyUsed = i;
+	}
+
+	if (!ReadIfMissing)
+		return -1;
+
+	/* Replace the least recently used page */
+	if (TextBox->dataReadFunction(prvReadCacheBounceBuffer, PageAddress, guiConfigREAD_CACHE_PAGE_SIZE, 100) != SUCCESS)
+		return -1;
+
+	memcpy(prvReadCacheData[leastRecentlyUsed], prvReadCacheBounceBuffer, guiConfigREAD_CACHE_PAGE_SIZE);
+	prvReadCachePages[leastRecentlyUsed].address = PageAddress;
+	prvReadCachePages[leastRecentlyUsed].lastUsed = ++prvReadCacheClock;
+	prvReadCacheStats.numOfMisses++;
+	return leastRecentlyUsed;
+}
+
+/**
+ * @brief	Remove the pages that overlap an address range from the read cache
+ * @param	StartAddress: First address of the range
+ * @param	EndAddress: Last address of the range
+ * @retval	None
+ */
+static void prvReadCacheInvalidate(uint32_t StartAddress, uint32_t EndAddress)
+{
+	for (uint32_t i = 0; i < guiConfigREAD_CACHE_NUM_OF_PAGES; i++)
+	{
+		uint32_t pageAddress = prvReadCachePages[i].address;
+		if (pageAddress == READ_CACHE_INVALID_ADDRESS ||
+			(pageAddress + guiConfigREAD_CACHE_PAGE_SIZE > StartAddress && pageAddress <= EndAddress))
+		{
+			prvReadCachePages[i].address = READ_CACHE_INVALID_ADDRESS;
+			prvReadCachePages[i].lastUsed = 0;
+		}
+	}
+	prvReadCacheLastAddress = READ_CACHE_INVALID_ADDRESS;
+}
+
+/**
+ * @brief	Get how many characters there are on a row of data in a text box
+ * @param	TextBox: The text box
+ * @retval	The characters on a row rounded down to whole formatted bytes
+ * @note	The rows are as long as the data rows in MoveDisplayedDataToPosition so the bytes line up in columns
+ */
+static uint32_t prvTextBoxGetCharsPerDataRow(GUITextBox* TextBox)
+{
+	uint32_t charsPerByte = prvNumOfCharsPerByteForTextFormat[TextBox->textFormat];
+	return (TextBox->maxCharactersPerRow / charsPerByte) * charsPerByte;
+}
+
+/**
+ * @brief	Get the area of a text box where the data from memory is written
+ * @param	TextBox: The text box
+ * @retval	The window, narrowed so the LCD wraps the text after the last whole byte on a row
+ */
+static LCDActiveWindow prvTextBoxGetDataWindow(GUITextBox* TextBox)
+{
+	LCDActiveWindow window;
+	window.xLeft = TextBox->object.xPos + TextBox->padding.left;
+	window.xRight = window.xLeft + prvTextBoxGetCharsPerDataRow(TextBox) * guiConfigFONT_WIDTH_UNIT * TextBox->textSize - 1;
+	window.yTop = TextBox->object.yPos + TextBox->padding.top;
+	window.yBottom = TextBox->object.yPos + TextBox->object.height - 1 - TextBox->padding.bottom;
+	return window;
+}
+
+/**
+ * @brief	Get the area of a text box where the scrollbar is
+ * @param	TextBox: The text box
+ * @retval	The window for the scrollbar, it's inside the right border
+ */
+static LCDActiveWindow prvTextBoxGetScrollbarWindow(GUITextBox* TextBox)
+{
+	uint16_t rightBorder = (TextBox->object.border & GUIBorder_Right) ? TextBox->object.borderThickness : 0;
+
+	LCDActiveWindow window;
+	window.xRight = TextBox->object.xPos + TextBox->object.width - 1 - rightBorder;
+	window.xLeft = window.xRight - TextBox->scrollbarWidth + 1;
+	window.yTop = TextBox->object.yPos + TextBox->padding.top;
+	window.yBottom = TextBox->object.yPos + TextBox->object.height - 1 - TextBox->padding.bottom;
+	return window;
+}
+
+/**
+ * @brief	Draw the scrollbar of a text box if it has one
+ * @param	TextBox: The text box
+ * @retval	None
+ * @note	The size and position of the thumb shows which part of all saved data that is displayed
+ */
+static void prvTextBoxDrawScrollbar(GUITextBox* TextBox)
+{
+	if (TextBox->scrollbarWidth == 0 || TextBox->object.displayState != GUIDisplayState_NotHidden)
+		return;
+
+	LCDActiveWindow track = prvTextBoxGetScrollbarWindow(TextBox);
+	uint32_t trackHeight = track.yBottom - track.yTop + 1;
+
+	uint32_t totalAmountOfData = TextBox->readLastValidByteAddress - TextBox->readMinAddress;
+	uint32_t displayedAmountOfData = TextBox->readEndAddress - TextBox->readStartAddress;
+	uint32_t thumbHeight = trackHeight;
+	uint32_t thumbOffset = 0;
+	if (totalAmountOfData > displayedAmountOfData && TextBox->readStartAddress >= TextBox->readMinAddress)
+	{
+		thumbHeight = (uint64_t)trackHeight * displayedAmountOfData / totalAmountOfData;
+		if (thumbHeight < guiConfigSCROLLBAR_MIN_THUMB_HEIGHT)
+			thumbHeight = guiConfigSCROLLBAR_MIN_THUMB_HEIGHT;
+		if (thumbHeight > trackHeight)
+			thumbHeight = trackHeight;
+
+		thumbOffset = (uint64_t)(trackHeight - thumbHeight) * (TextBox->readStartAddress - TextBox->readMinAddress) /
+					  (totalAmountOfData - displayedAmountOfData);
+		if (thumbOffset > trackHeight - thumbHeight)
+			thumbOffset = trackHeight - thumbHeight;
+	}
+
+	/* Nothing to do if the thumb is already drawn like this */
+	uint16_t thumbTop = track.yTop + thumbOffset;
+	uint16_t thumbBottom = thumbTop + thumbHeight - 1;
+	if (thumbTop == TextBox->scrollbarThumbTop && thumbHeight == TextBox->scrollbarThumbHeight)
+		return;
+	TextBox->scrollbarThumbTop = thumbTop;
+	TextBox->scrollbarThumbHeight = thumbHeight;
+
+	/* Draw the track around the thumb and the thumb separately to avoid flicker */
+	LCD_SetBackgroundColor(guiConfigSCROLLBAR_TRACK_COLOR);
+	if (thumbTop > track.yTop)
+		LCD_ClearActiveWindow(track.xLeft, track.xRight, track.yTop, thumbTop - 1);
+	if (thumbBottom < track.yBottom)
+		LCD_ClearActiveWindow(track.xLeft, track.xRight, thumbBottom + 1, track.yBottom);
+	LCD_SetBackgroundColor(guiConfigSCROLLBAR_THUMB_COLOR);
+	LCD_ClearActiveWindow(track.xLeft, track.xRight, thumbTop, thumbBottom);
+}
+
+/**
+ * @brief	Move the displayed data of a text box to the part of the memory that a position on the scrollbar maps to
+ * @param	Index: Index of the text box
+ * @param	YPos: Y-position of the touch
+ * @retval	None
+ */
+static void prvTextBoxScrollbarTouchAt(uint32_t Index, uint16_t YPos)
+{
+	GUITextBox* textBox = &prvTextBox_list[Index];
+	if (textBox->object.displayState != GUIDisplayState_NotHidden)
+		return;
+
+	LCDActiveWindow track = prvTextBoxGetScrollbarWindow(textBox);
+	uint32_t trackHeight = track.yBottom - track.yTop + 1;
+	uint32_t yOffset = 0;
+	if (YPos > track.yBottom)
+		yOffset = trackHeight - 1;
+	else if (YPos > track.yTop)
+		yOffset = YPos - track.yTop;
+
+	/* Center the displayed data around the position that was touched */
+	uint32_t totalAmountOfData = textBox->readLastValidByteAddress - textBox->readMinAddress;
+	uint32_t displayedAmountOfData = textBox->maxNumOfCharacters / prvNumOfCharsPerByteForTextFormat[textBox->textFormat];
+	uint32_t position = (uint64_t)totalAmountOfData * yOffset / trackHeight;
+	if (position > displayedAmountOfData / 2)
+		position -= displayedAmountOfData / 2;
+	else
+		position = 0;
+
+	prvTextBoxSetPendingPosition(textBox, position);
+}
+
+/**
+ * @brief	Get the area of a text box where the minimap is
+ * @param	TextBox: The text box
+ * @retval	The window for the minimap, it's to the left of the scrollbar
+ */
+static LCDActiveWindow prvTextBoxGetMinimapWindow(GUITextBox* TextBox)
+{
+	LCDActiveWindow window = prvTextBoxGetScrollbarWindow(TextBox);
+	window.xRight = window.xLeft - 1;
+	window.xLeft = window.xRight - TextBox->minimapWidth + 1;
+	return window;
+}
+
+/**
+ * @brief	Draw the minimap of a text box if it has one
+ * @param	TextBox: The text box
+ * @retval	None
+ * @note	Every bucket gets a row with a bar as wide as its activity so that the rows don't move when more
+ *			buckets are added. Only the summary from the minimapFunction is used, the saved data is never read.
+ */
+static void prvTextBoxDrawMinimap(GUITextBox* TextBox)
+{
+	if (TextBox->minimapWidth == 0 || TextBox->object.displayState != GUIDisplayState_NotHidden)
+		return;
+
+	TextBox->minimapLastDrawTime = xTaskGetTickCount();
+
+	LCDActiveWindow window = prvTextBoxGetMinimapWindow(TextBox);
+	uint32_t rowHeight = (window.yBottom - window.yTop + 1) / guiConfigMINIMAP_MAX_NUM_OF_BUCKETS;
+	if (rowHeight == 0)
+		rowHeight = 1;
+
+	uint32_t numOfBuckets = TextBox->minimapFunction(prvMinimapBuckets, guiConfigMINIMAP_MAX_NUM_OF_BUCKETS);
+
+	uint16_t yTop = window.yTop;
+	for (uint32_t i = 0; i < numOfBuckets && yTop + rowHeight - 1 <= window.yBottom; i++)
+	{
+		uint16_t yBottom = yTop + rowHeight - 1;
+
+		/* The bucket ends where the next one starts, the last one at the last saved byte */
+		uint32_t endAddress = TextBox->readLastValidByteAddress;
+		if (i + 1 < numOfBuckets)
+			endAddress = prvMinimapBuckets[i+1].address;
+		bool isDisplayed = (prvMinimapBuckets[i].address < TextBox->readEndAddress &&
+							endAddress > TextBox->readStartAddress);
+
+		uint32_t barWidth = (uint32_t)prvMinimapBuckets[i].activity * TextBox->minimapWidth / 255;
+		if (barWidth == 0 && prvMinimapBuckets[i].activity != 0)
+			barWidth = 1;
+
+		if (barWidth != 0)
+		{
+			if (prvMinimapBuckets[i].hasErrors)
+				LCD_SetBackgroundColor(guiConfigMINIMAP_ERROR_COLOR);
+			else
+				LCD_SetBackgroundColor(guiConfigMINIMAP_ACTIVITY_COLOR);
+			LCD_ClearActiveWindow(window.xLeft, window.xLeft + barWidth - 1, yTop, yBottom);
+		}
+		if (barWidth < TextBox->minimapWidth)
+		{
+			if (isDisplayed)
+				LCD_SetBackgroundColor(guiConfigMINIMAP_DISPLAYED_COLOR);
+			else
+				LCD_SetBackgroundColor(guiConfigMINIMAP_BACKGROUND_COLOR);
+			LCD_ClearActiveWindow(window.xLeft + barWidth, window.xRight, yTop, yBottom);
+		}
+
+		yTop += rowHeight;
+	}
+
+	/* Clear the rows that don't have a bucket yet */
+	if (yTop <= window.yBottom)
+	{
+		LCD_SetBackgroundColor(guiConfigMINIMAP_BACKGROUND_COLOR);
+		LCD_ClearActiveWindow(window.xLeft, window.xRight, yTop, window.yBottom);
+	}
+}
+
+/**
+ * @brief	Move the displayed data of a text box to the start of the minimap bucket at a position
+ * @param	Index: Index of the text box
+ * @param	YPos: Y-position of the touch
+ * @retval	None
+ */
+static void prvTextBoxMinimapTouchAt(uint32_t Index, uint16_t YPos)
+{
+	GUITextBox* textBox = &prvTextBox_list[Index];
+	if (textBox->object.displayState != GUIDisplayState_NotHidden)
+		return;
+
+	uint32_t numOfBuckets = textBox->minimapFunction(prvMinimapTouchBuckets, guiConfigMINIMAP_MAX_NUM_OF_BUCKETS);
+	if (numOfBuckets == 0)
+		return;
+
+	LCDActiveWindow window = prvTextBoxGetMinimapWindow(textBox);
+	uint32_t rowHeight = (window.yBottom - window.yTop + 1) / guiConfigMINIMAP_MAX_NUM_OF_BUCKETS;
+	if (rowHeight == 0)
+		rowHeight = 1;
+
+	uint32_t bucket = 0;
+	if (YPos > window.yTop)
+		bucket = (YPos - window.yTop) / rowHeight;
+	if (bucket >= numOfBuckets)
+		bucket = numOfBuckets - 1;
+
+	if (prvMinimapTouchBuckets[bucket].address < textBox->readMinAddress)
+		return;
+
+	prvTextBoxSetPendingPosition(textBox, prvMinimapTouchBuckets[bucket].address - textBox->readMinAddress);
+}
+
+/**
+ * @brief	Save a position the displayed data should be moved to by the task that manages the text box
+ * @param	TextBox: The text box
+ * @param	Position: Number of bytes from the min address where the displayed data should start
+ * @retval	None
+ * @note	The position is written before the flag, and the flag last behind a barrier, so the manager never
+ * 			sees the flag without the position it belongs to
+ */
+static void prvTextBoxSetPendingPosition(GUITextBox* TextBox, uint32_t Position)
+{
+	TextBox->pendingPosition = Position;
+	COMPILER_BARRIER();
+	TextBox->hasPendingPosition = true;
+}
+
+/**
+ * @brief	Give back the text buffer of a text box to the pool
+ * @param	TextBox: The text box
+ * @retval	None
+ * @note	Buffers from the heap are kept by the text box
+ */
+static void prvTextBoxReleaseBuffer(GUITextBox* TextBox)
+{
+	for (uint32_t i = 0; i < guiConfigTEXT_BUFFER_POOL_NUM_OF_BLOCKS; i++)
+	{
+		if (prvTextBufferPoolOwner[i] == TextBox)
+		{
+			prvTextBufferPoolOwner[i] = 0;
+			TextBox->textBuffer = 0;
+			TextBox->bufferCount = 0;
+			prvTextBufferPoolStats.numOfBlocksInUse--;
+			return;
+		}
+	}
+}
+
+/**
+ * @brief	Check if an object has been added, the slots in the object lists are cleared in GUI_Init
+ * @param	Object: The object in one of the object lists
+ * @retval	true if it has been added, false otherwise
+ */
+static inline bool prvObjectIsAdded(GUIObject* Object)
+{
+	return (Object->id != 0);
+}
+
+/**
+ * @brief	Get a button in a container
+ * @param	Container: The container
+ * @param	Index: Which of the buttons in the container to get, must be less than numOfButtons
+ * @retval	Pointer to the button
+ */
+static inline GUIButton* prvGetButtonInContainer(GUIContainer* Container, uint32_t Index)
+{
+	return &prvButton_list[Container->children[Index]];
+}
+
+/**
+ * @brief	Get a text box in a container
+ * @param	Container: The container
+ * @param	Index: Which of the text boxes in the container to get, must be less than numOfTextBoxes
+ * @retval	Pointer to the text box
+ */
+static inline GUITextBox* prvGetTextBoxInContainer(GUIContainer* Container, uint32_t Index)
+{
+	return &prvTextBox_list[Container->children[Container->numOfButtons + Index]];
+}
+
+/**
+ * @brief	Get a container in a container
+ * @param	Container: The container
+ * @param	Index: Which of the containers in the container to get, must be less than numOfContainers
+ * @retval	Pointer to the container
+ */
+static inline GUIContainer* prvGetContainerInContainer(GUIContainer* Container, uint32_t Index)
+{
+	return &prvContainer_list[Container->children[Container->numOfButtons + Container->numOfTextBoxes + Index]];
+}
+
+/**
+ * @brief	Set the bit for an object in all the grid cells it overlaps and clear it in the others
+ * @param	pGrid: The grid for the type of object
+ * @param	WordsPerCell: Number of words in the bitmap for each cell
+ * @param	Object: The object
+ * @param	Index: The index of the object in its list
+ * @retval	None
+ * @note	The touch checks include the pixel right of and below the object so those are included here too
+ */
+static void prvTouchGridAddObject(uint32_t* pGrid, uint32_t WordsPerCell, GUIObject* Object, uint32_t Index)
+{
+	uint32_t word = Index / 32;
+	uint32_t bit = 1UL << (Index % 32);
+
+	uint32_t firstColumn = Object->xPos / TOUCH_GRID_CELL_WIDTH;
+	uint32_t lastColumn = (Object->xPos + Object->width) / TOUCH_GRID_CELL_WIDTH;
+	uint32_t firstRow = Object->yPos / TOUCH_GRID_CELL_HEIGHT;
+	uint32_t lastRow = (Object->yPos + Object->height) / TOUCH_GRID_CELL_HEIGHT;
+
+	for (uint32_t row = 0; row < guiConfigTOUCH_GRID_ROWS; row++)
+	{
+		for (uint32_t column = 0; column < guiConfigTOUCH_GRID_COLUMNS; column++)
+		{
+			uint32_t* cell = &pGrid[(row * guiConfigTOUCH_GRID_COLUMNS + column) * WordsPerCell];
+			if (row >= firstRow && row <= lastRow && column >= firstColumn && column <= lastColumn)
+				cell[word] |= bit;
+			else
+				cell[word] &= ~bit;
+		}
+	}
+}
+
+/**
+ * @brief	Get the bitmap for the grid cell a position is in
+ * @param	pGrid: The grid for the type of object
+ * @param	WordsPerCell: Number of words in the bitmap for each cell
+ * @param	XPos: X-position
+ * @param	YPos: Y-position
+ * @retval	Pointer to the first word of the bitmap
+ */
+static uint32_t* prvTouchGridGetCell(uint32_t* pGrid, uint32_t WordsPerCell, uint16_t XPos, uint16_t YPos)
+{
+	uint32_t column = XPos / TOUCH_GRID_CELL_WIDTH;
+	uint32_t row = YPos / TOUCH_GRID_CELL_HEIGHT;
+	if (column >= guiConfigTOUCH_GRID_COLUMNS)
+		column = guiConfigTOUCH_GRID_COLUMNS - 1;
+	if (row >= guiConfigTOUCH_GRID_ROWS)
+		row = guiConfigTOUCH_GRID_ROWS - 1;
+
+	return &pGrid[(row * guiConfigTOUCH_GRID_COLUMNS + column) * WordsPerCell];
+}
+
 /* Interrupt Handlers --------------------------------------------------------*/
@@ -47,6 +47,11 @@
 #define FLASH_MOSI_PIN			(GPIO_PIN_15)
 
 /* Private variables ---------------------------------------------------------*/
+/*
+ * SPI1 is shared by the ADC and the thermocouple but has no lock. The MAX1301 driver owns it
+ * while an acquisition is running (the DMA writes the data register on every timer period),
+ * so the thermocouple must not be read then. Nothing uses the thermocouple channel yet.
+ */
 static SPI_HandleTypeDef SPI_Handle_ADC_Thermocouple = {
 		.Instance 				= ADC_SPI,
 		.Init.Mode 				= SPI_MODE_MASTER,
@@ -67,6 +67,9 @@
 
 #define SPI_FLASH_SECTOR_CLEAN_CHECK_SIZE		(128)
 
+/* A page program wraps around to the start of the page instead of continuing on the next one */
+#define SPI_FLASH_PAGE_SIZE						(256)
+
 /* Private typedefs ----------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 static SPI_HandleTypeDef SPI_Handle = {
@@ -247,7 +250,7 @@ uint32_t SPI_FLASH_ReadID()
 }
 
 /**
-  * @brief  Write a buffer to the FLASH
+  * @brief  Write a buffer to the FLASH, split into one page program for every page it touches
   * @note   Addresses to be written must be in the erased state
   * @param	pBuff: pointer to the buffer with data to write
   * @param  WriteAddress: start of FLASH's internal address to write to
@@ -256,39 +259,48 @@ uint32_t SPI_FLASH_ReadID()
   */
 void SPI_FLASH_WriteBuffer(uint8_t* pBuffer, uint32_t WriteAddress, uint32_t NumByteToWrite)
 {
+	if (NumByteToWrite == 0)
+		return;
+
 	/* Try to take the semaphore in case some other process is using the device */
 	if (xSemaphoreTake(xSemaphore, 100) == pdTRUE)
 	{
-		prvSPI_FLASH_WriteBytes(pBuffer, WriteAddress, NumByteToWrite);
-
-		/* TODO: Something is wrong with this functions. Data are overwritten sometime */
-//		uint32_t evenBytes;
-//		/* If write starts at an odd address, need to use single byte write
-//		* to write the first address. */
-//		if ((WriteAddress & 0x1) == 0x1)
-//		{
-//			prvSPI_FLASH_WriteByte(WriteAddress, *pBuffer++);
-//			WriteAddress++;
-//			NumByteToWrite--;
-//		}
-//
-//		/* Write bulk of bytes using auto increment write, with restriction
-//		* that address must always be even and two bytes are written at a time. */
-//		evenBytes = NumByteToWrite & ~0x1;
-//		if (evenBytes)
-//		{
-//			prvSPI_FLASH_WriteBytes(pBuffer, WriteAddress, evenBytes);
-//			NumByteToWrite -= evenBytes;
-//		}
-//
-//		/* If number of bytes to write is odd, need to use a single byte write
-//		* to write the last address. */
-//		if (NumByteToWrite)
-//		{
-//			pBuffer += evenBytes;
-//			WriteAddress += evenBytes;
-//			prvSPI_FLASH_WriteByte(WriteAddress, *pBuffer++);
-//		}
+		if (prvDeviceId == SPI_FLASH_SST25VF016B_ID)
+		{
+			/* The auto address increment program writes two bytes at a time from an even address */
+			if ((WriteAddress & 0x1) == 0x1)
+			{
+				prvSPI_FLASH_WriteByte(WriteAddress++, *pBuffer++);
+				NumByteToWrite--;
+			}
+
+			uint32_t evenBytes = NumByteToWrite & ~0x1;
+			if (evenBytes)
+			{
+				prvSPI_FLASH_WriteBytes(pBuffer, WriteAddress, evenBytes);
+				pBuffer += evenBytes;
+				WriteAddress += evenBytes;
+				NumByteToWrite -= evenBytes;
+			}
+
+			if (NumByteToWrite)
+				prvSPI_FLASH_WriteByte(WriteAddress, *pBuffer);
+		}
+		else
+		{
+			/* One page program for every page that is touched */
+			while (NumByteToWrite)
+			{
+				uint32_t numOfBytes = SPI_FLASH_PAGE_SIZE - (WriteAddress & (SPI_FLASH_PAGE_SIZE - 1));
+				if (numOfBytes > NumByteToWrite)
+					numOfBytes = NumByteToWrite;
+
+				prvSPI_FLASH_WriteBytes(pBuffer, WriteAddress, numOfBytes);
+				pBuffer += numOfBytes;
+				WriteAddress += numOfBytes;
+				NumByteToWrite -= numOfBytes;
+			}
+		}
 
 		/* Give back the semaphore */
 		xSemaphoreGive(xSemaphore);
@@ -579,8 +591,9 @@ static void prvSPI_FLASH_WriteByte(uint32_t WriteAddress, uint8_t Byte)
 
 /**
   * @brief  Writes more than one byte to the FLASH.
-  * @note   The address must be even and the number of bytes must be a multiple
-  *         of two.
+  * @note   For the SST25VF016B the address must be even and the number of bytes
+  *         must be a multiple of two. For the other devices all bytes must be in
+  *         the same page.
   * @note   Addresses to be written must be in the erased state
   * @param  pBuffer: pointer to the buffer containing the data to be written
   *         to the FLASH.
@@ -626,6 +639,12 @@ static void prvSPI_FLASH_WriteBytes(uint8_t* pBuffer, uint32_t WriteAddress, uin
 			prvSPI_FLASH_SendReceiveByte(*pBuffer++);
 			/* Update NumByteToWrite */
 			NumByteToWrite -= 2;
+			/* Every word is programmed separately, the next one can't be sent until this one is done */
+			if (NumByteToWrite)
+			{
+				prvSPI_FLASH_CS_HIGH();
+				prvSPI_FLASH_WaitForWriteEnd();
+			}
 		}
 	}
 	else
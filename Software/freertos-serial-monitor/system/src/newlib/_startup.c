@@ -50,6 +50,11 @@ extern unsigned int __bss_start__;
 // End address for the .bss section; defined in linker script
 extern unsigned int __bss_end__;
 
+// Begin address for the CCM RAM .bss section; defined in linker script
+extern unsigned int _sbss_CCMRAM;
+// End address for the CCM RAM .bss section; defined in linker script
+extern unsigned int _ebss_CCMRAM;
+
 extern void
 __initialize_args(int*, char***);
 
@@ -209,6 +214,9 @@ _start(void)
   // Zero fill the bss segment
   __initialize_bss(&__bss_start__, &__bss_end__);
 
+  // Zero fill the bss segment in the CCM RAM
+  __initialize_bss(&_sbss_CCMRAM, &_ebss_CCMRAM);
+
 #if defined(DEBUG) && defined(OS_INCLUDE_STARTUP_GUARD_CHECKS)
   if ((__bss_begin_guard != 0) || (__bss_end_guard != 0))
     {
@@ -0,0 +1,253 @@
+/**
+ ******************************************************************************
+ * @file	bench_gui_layout.c
+ * @brief	Host benchmark of adding the GUI objects at boot in simple_gui.c.
+ *
+ *			The full object set from simple_gui_config.h is described in
+ *			const tables like the firmware. Adding every object at boot is
+ *			timed against adding only the top bar, status and main content
+ *			at boot and each page the first time it's shown. The container
+ *			lists are allocated from a model of heap_1 so the heap used at
+ *			boot is printed as well.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "lcd_bus_sim.h"
+#include "lcd_ra8875.h"
+#include "simple_gui.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define NUM_OF_BOOTS			(2000)
+#define HEAP_SIZE				(16 * 1024)
+
+/* Added at boot like the top buttons, the main and status text boxes and containers and the empty sidebar */
+#define NUM_OF_BOOT_BUTTONS		(8)
+#define NUM_OF_BOOT_TEXT_BOXES	(4)
+#define NUM_OF_BOOT_CONTAINERS	(4)
+
+#define NUM_OF_PAGES			(guiConfigNUMBER_OF_CONTAINERS - NUM_OF_BOOT_CONTAINERS)
+
+/* The modules that kept a GUITextBox, GUIButton and GUIContainerTemplate in RAM to fill in before */
+#define NUM_OF_TEMPLATE_MODULES	(10)
+
+/* Private variables ---------------------------------------------------------*/
+static GUIButton prvButtons[guiConfigNUMBER_OF_BUTTONS];
+static GUITextBox prvTextBoxes[guiConfigNUMBER_OF_TEXT_BOXES];
+static GUIContainerTemplate prvContainers[guiConfigNUMBER_OF_CONTAINERS];
+
+/* The children of the page in each container, the first ones are added at boot */
+static GUILayout prvPages[NUM_OF_PAGES];
+
+static uint8_t prvHeap[HEAP_SIZE];
+static size_t prvHeapUsed;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief	Fill in the tables, every object is hidden and the pages get the objects in turn
+ */
+static void prvFillTables()
+{
+	for (uint32_t i = 0; i < guiConfigNUMBER_OF_BUTTONS; i++)
+	{
+		GUIButton* button = &prvButtons[i];
+		button->object.id = i + guiConfigBUTTON_ID_OFFSET;
+		button->object.xPos = (i < NUM_OF_BOOT_BUTTONS) ? i * 81 : 650;
+		button->object.yPos = (i < NUM_OF_BOOT_BUTTONS) ? 0 : 80 + (i % 6) * 65;
+		button->object.width = (i < NUM_OF_BOOT_BUTTONS) ? 80 : 149;
+		button->object.height = (i < NUM_OF_BOOT_BUTTONS) ? 44 : 58;
+		button->object.border = GUIBorder_Bottom | GUIBorder_Left;
+		button->object.borderThickness = 1;
+		button->object.borderColor = GUI_WHITE;
+		button->enabledTextColor = GUI_WHITE;
+		button->enabledBackgroundColor = GUI_BLUE;
+		button->state = GUIButtonState_Enabled;
+		button->text[0] = (uint8_t*)"BUTTON";
+		button->textSize[0] = LCDFontEnlarge_1x;
+	}
+
+	for (uint32_t i = 0; i < guiConfigNUMBER_OF_TEXT_BOXES; i++)
+	{
+		GUITextBox* textBox = &prvTextBoxes[i];
+		textBox->object.id = i + guiConfigTEXT_BOX_ID_OFFSET;
+		textBox->object.xPos = (i == 0) ? 0 : 650;
+		textBox->object.yPos = (i == 0) ? 45 : 48;
+		textBox->object.width = (i == 0) ? 650 : 150;
+		textBox->object.height = (i == 0) ? 435 : 24;
+		textBox->textColor = GUI_WHITE;
+		textBox->backgroundColor = GUI_BLACK;
+		textBox->textSize = LCDFontEnlarge_1x;
+		textBox->staticText = (i == 0) ? 0 : (uint8_t*)"LABEL";
+	}
+
+	for (uint32_t i = 0; i < guiConfigNUMBER_OF_CONTAINERS; i++)
+	{
+		GUIContainerTemplate* container = &prvContainers[i];
+		container->object.id = i + guiConfigCONTAINER_ID_OFFSET;
+		container->object.xPos = (i == 0) ? 0 : 650;
+		container->object.yPos = 45;
+		container->object.width = (i == 0) ? 650 : 150;
+		container->object.height = 435;
+		container->backgroundColor = GUI_BLACK;
+		container->contentHideState = GUIHideState_KeepBorders;
+	}
+
+	/* The main content lists the page containers that are added later like the channel main content */
+	for (uint32_t i = 0; i < guiConfigMAX_NUM_OF_CONTAINERS_IN_CONTAINER && i < NUM_OF_PAGES; i++)
+		prvContainers[0].containers[i] = NUM_OF_BOOT_CONTAINERS + i + guiConfigCONTAINER_ID_OFFSET;
+	prvContainers[1].textBoxes[0] = 1 + guiConfigTEXT_BOX_ID_OFFSET;
+	prvContainers[1].textBoxes[1] = 2 + guiConfigTEXT_BOX_ID_OFFSET;
+
+	/* Every page takes a run of the objects that are left, the tables are sorted by page */
+	uint32_t numOfButtons = guiConfigNUMBER_OF_BUTTONS - NUM_OF_BOOT_BUTTONS;
+	uint32_t numOfTextBoxes = guiConfigNUMBER_OF_TEXT_BOXES - NUM_OF_BOOT_TEXT_BOXES;
+	uint32_t button = NUM_OF_BOOT_BUTTONS, textBox = NUM_OF_BOOT_TEXT_BOXES;
+	for (uint32_t page = 0; page < NUM_OF_PAGES; page++)
+	{
+		GUIContainerTemplate* container = &prvContainers[NUM_OF_BOOT_CONTAINERS + page];
+		uint32_t lastButton = NUM_OF_BOOT_BUTTONS + numOfButtons * (page + 1) / NUM_OF_PAGES;
+		uint32_t lastTextBox = NUM_OF_BOOT_TEXT_BOXES + numOfTextBoxes * (page + 1) / NUM_OF_PAGES;
+
+		prvPages[page].buttons = &prvButtons[button];
+		prvPages[page].textBoxes = &prvTextBoxes[textBox];
+		prvPages[page].containers = container;
+		prvPages[page].numOfContainers = 1;
+		for (uint32_t i = 0; button < lastButton; i++, button++)
+		{
+			if (i < guiConfigMAX_NUM_OF_BUTTONS_IN_CONTAINER)
+				container->buttons[i] = button + guiConfigBUTTON_ID_OFFSET;
+			prvPages[page].numOfButtons++;
+		}
+		for (uint32_t i = 0; textBox < lastTextBox; i++, textBox++)
+		{
+			if (i < guiConfigMAX_NUM_OF_TEXT_BOXES_IN_CONTAINER)
+				container->textBoxes[i] = textBox + guiConfigTEXT_BOX_ID_OFFSET;
+			prvPages[page].numOfTextBoxes++;
+		}
+	}
+}
+
+/**
+ * @brief	Boot with a clean GUI and heap and add the layouts given
+ * @retval	Nanoseconds spent adding the objects
+ */
+static uint64_t prvBoot(const GUILayout* pLayouts, uint32_t NumOfLayouts)
+{
+	GUI_Init();
+	prvHeapUsed = 0;
+
+	uint64_t start = testNanoseconds();
+	for (uint32_t i = 0; i < NumOfLayouts; i++)
+		GUI_AddLayout(&pLayouts[i]);
+	return testNanoseconds() - start;
+}
+
+/**
+ * @brief	Check that every object in the tables has been added
+ */
+static bool prvAllAreAdded()
+{
+	for (uint32_t i = 0; i < guiConfigNUMBER_OF_BUTTONS; i++)
+	{
+		if (GUIButton_GetFromId(i + guiConfigBUTTON_ID_OFFSET)->object.id != i + guiConfigBUTTON_ID_OFFSET)
+			return false;
+	}
+	for (uint32_t i = 0; i < guiConfigNUMBER_OF_TEXT_BOXES; i++)
+	{
+		if (GUITextBox_GetFromId(i + guiConfigTEXT_BOX_ID_OFFSET)->object.id != i + guiConfigTEXT_BOX_ID_OFFSET)
+			return false;
+	}
+	for (uint32_t i = 0; i < guiConfigNUMBER_OF_CONTAINERS; i++)
+	{
+		if (!GUIContainer_IsAdded(i + guiConfigCONTAINER_ID_OFFSET))
+			return false;
+	}
+	return true;
+}
+
+/* Functions -----------------------------------------------------------------*/
+/**
+ * @brief	heap_1, nothing is ever freed
+ */
+void* pvPortMalloc(size_t Size)
+{
+	Size = (Size + 7) & ~(size_t)7;
+	if (prvHeapUsed + Size > HEAP_SIZE)
+		return 0;
+	void* pMemory = &prvHeap[prvHeapUsed];
+	prvHeapUsed += Size;
+	return pMemory;
+}
+
+/**
+ * @brief	The beep is off during the benchmark
+ */
+void BUZZER_BeepNumOfTimes(uint32_t NumOfTimes)
+{
+}
+
+int main()
+{
+	lcdSimInit(LCD_WAIT_Callback);
+	LCD_Init();
+	GUI_SetBeepOff();
+	prvFillTables();
+
+	const GUILayout all = {
+		prvTextBoxes, guiConfigNUMBER_OF_TEXT_BOXES,
+		prvButtons, guiConfigNUMBER_OF_BUTTONS,
+		prvContainers, guiConfigNUMBER_OF_CONTAINERS,
+	};
+	const GUILayout boot = {
+		prvTextBoxes, NUM_OF_BOOT_TEXT_BOXES,
+		prvButtons, NUM_OF_BOOT_BUTTONS,
+		prvContainers, NUM_OF_BOOT_CONTAINERS,
+	};
+
+	/* Once each to check the objects and to get the heap used */
+	prvBoot(&all, 1);
+	TEST_CHECK(prvAllAreAdded(), "an object is missing after adding everything at boot");
+	size_t allHeap = prvHeapUsed;
+
+	prvBoot(&boot, 1);
+	size_t bootHeap = prvHeapUsed;
+	TEST_CHECK(!GUIContainer_IsAdded(NUM_OF_BOOT_CONTAINERS + guiConfigCONTAINER_ID_OFFSET),
+			   "a page was added at boot");
+	GUIContainer_Draw(guiConfigCONTAINER_ID_OFFSET);
+	for (uint32_t i = 0; i < NUM_OF_PAGES; i++)
+		GUI_AddLayout(&prvPages[i]);
+	TEST_CHECK(prvAllAreAdded(), "an object is missing after adding every page");
+	TEST_CHECK(prvHeapUsed == allHeap, "%u bytes of heap with every page added, %u when added at boot",
+			   (unsigned)prvHeapUsed, (unsigned)allHeap);
+
+	uint64_t allTime = 0, bootTime = 0;
+	for (uint32_t i = 0; i < NUM_OF_BOOTS; i++)
+	{
+		allTime += prvBoot(&all, 1);
+		bootTime += prvBoot(&boot, 1);
+	}
+
+	printf("%u buttons, %u text boxes, %u containers, %u pages\n",
+		   (unsigned)guiConfigNUMBER_OF_BUTTONS, (unsigned)guiConfigNUMBER_OF_TEXT_BOXES,
+		   (unsigned)guiConfigNUMBER_OF_CONTAINERS, (unsigned)NUM_OF_PAGES);
+	printf("%-12s %8s %12s %12s\n", "boot", "objects", "ns/boot", "heap bytes");
+	printf("%-12s %8u %12.1f %12u\n", "everything",
+		   (unsigned)(guiConfigNUMBER_OF_BUTTONS + guiConfigNUMBER_OF_TEXT_BOXES + guiConfigNUMBER_OF_CONTAINERS),
+		   (double)allTime / NUM_OF_BOOTS, (unsigned)allHeap);
+	printf("%-12s %8u %12.1f %12u\n", "top bar",
+		   (unsigned)(NUM_OF_BOOT_BUTTONS + NUM_OF_BOOT_TEXT_BOXES + NUM_OF_BOOT_CONTAINERS),
+		   (double)bootTime / NUM_OF_BOOTS, (unsigned)bootHeap);
+	printf("speedup %.1fx\n", (double)allTime / (double)bootTime);
+	printf("templates no longer in RAM: %u x (%u + %u + %u) = %u bytes on the host\n",
+		   (unsigned)NUM_OF_TEMPLATE_MODULES, (unsigned)sizeof(GUITextBox), (unsigned)sizeof(GUIButton),
+		   (unsigned)sizeof(GUIContainerTemplate),
+		   (unsigned)(NUM_OF_TEMPLATE_MODULES * (sizeof(GUITextBox) + sizeof(GUIButton) + sizeof(GUIContainerTemplate))));
+
+	TEST_CHECK(lcdSimGetNumOfErrors() == 0, "the bus model found errors");
+	TEST_EXIT();
+}
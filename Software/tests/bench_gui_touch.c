@@ -0,0 +1,393 @@
+/**
+ ******************************************************************************
+ * @file	bench_gui_touch.c
+ * @brief	Host benchmark of the touch lookups in simple_gui.c.
+ *
+ *			The full object set from simple_gui_config.h is added with a
+ *			layout like the firmware: a top bar, the main content, one
+ *			sidebar per page where only one is shown and hidden pop-outs.
+ *			Random taps are checked with the grid lookups and with a copy
+ *			of the linear scans they replaced, both have to find the same
+ *			objects. The GUI draws on the RA8875 model in lcd_bus_sim.c
+ *			but nothing is redrawn while the taps are timed.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "lcd_bus_sim.h"
+#include "lcd_ra8875.h"
+#include "simple_gui.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define NUM_OF_TAPS				(200000)
+
+#define TOP_BAR_HEIGHT			(45)
+#define SIDEBAR_X_POS			(650)
+#define SIDEBAR_WIDTH			(150)
+#define BUTTONS_PER_SIDEBAR		(6)
+#define NUM_OF_TOP_BAR_BUTTONS	(8)
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t prvRandomState = 0x2545F491;
+static uint16_t prvTapX[NUM_OF_TAPS];
+static uint16_t prvTapY[NUM_OF_TAPS];
+
+/* What the callbacks saw during a run, the container callbacks don't get an id so only the hits are counted */
+static uint32_t prvButtonHits[guiConfigNUMBER_OF_BUTTONS];
+static uint32_t prvTextBoxHits[guiConfigNUMBER_OF_TEXT_BOXES];
+static uint32_t prvNumOfContainerHits;
+
+static uint8_t prvButtonText[guiConfigNUMBER_OF_BUTTONS][8];
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief	Callbacks for the objects, they count the hits
+ */
+static void prvButtonCallback(GUITouchEvent Event, uint32_t ButtonId)
+{
+	if (Event == GUITouchEvent_Up)
+		prvButtonHits[ButtonId - guiConfigBUTTON_ID_OFFSET]++;
+}
+
+static void prvTextBoxCallback(GUITouchEvent Event, uint16_t XPos, uint16_t YPos)
+{
+	if (Event != GUITouchEvent_Up)
+		return;
+
+	/* Find the first visible text box under the touch, the same rule both lookups use */
+	for (uint32_t i = 0; i < guiConfigNUMBER_OF_TEXT_BOXES; i++)
+	{
+		GUITextBox* textBox = GUITextBox_GetFromId(i + guiConfigTEXT_BOX_ID_OFFSET);
+		if (textBox->object.displayState == GUIDisplayState_NotHidden &&
+			XPos >= textBox->object.xPos && XPos <= textBox->object.xPos + textBox->object.width &&
+			YPos >= textBox->object.yPos && YPos <= textBox->object.yPos + textBox->object.height)
+		{
+			prvTextBoxHits[i]++;
+			return;
+		}
+	}
+}
+
+static void prvContainerCallback(GUITouchEvent Event, uint16_t XPos, uint16_t YPos)
+{
+	if (Event == GUITouchEvent_Up)
+		prvNumOfContainerHits++;
+}
+
+/**
+ * @brief	The linear scan over every button, as it was before the touch grid
+ */
+static void prvLinearButtonCheck(GUITouchEvent Event, uint16_t XPos, uint16_t YPos)
+{
+	static GUIButton* lastActiveButton = 0;
+	static GUIButtonState lastState = GUIButtonState_NoState;
+
+	for (uint32_t index = 0; index < guiConfigNUMBER_OF_BUTTONS; index++)
+	{
+		GUIButton* activeButton = GUIButton_GetFromId(index + guiConfigBUTTON_ID_OFFSET);
+		/* Check if the button is not hidden and enabled and if it's hit */
+		if (activeButton->object.displayState == GUIDisplayState_NotHidden && activeButton->state != GUIButtonState_NoState &&
+			activeButton->object.layer == GUI_GetActiveLayer() && activeButton->state != GUIButtonState_DisabledTouch &&
+			XPos >= activeButton->object.xPos && XPos <= activeButton->object.xPos + activeButton->object.width &&
+			YPos >= activeButton->object.yPos && YPos <= activeButton->object.yPos + activeButton->object.height)
+		{
+			if (Event == GUITouchEvent_Up)
+			{
+				GUIButton_SetState(index + guiConfigBUTTON_ID_OFFSET, lastState);
+				lastActiveButton = 0;
+				lastState = GUIButtonState_Disabled;
+				if (activeButton->touchCallback != 0)
+				{
+					activeButton->touchCallback(Event, index + guiConfigBUTTON_ID_OFFSET);
+					if (GUI_BeepIsOn())
+						BUZZER_BeepNumOfTimes(1);
+				}
+			}
+			else if (Event == GUITouchEvent_Down)
+			{
+				if (lastActiveButton == 0 || lastActiveButton->object.id != activeButton->object.id)
+				{
+					if (lastActiveButton != 0)
+						GUIButton_SetState(lastActiveButton->object.id, lastState);
+
+					lastState = activeButton->state;
+					lastActiveButton = activeButton;
+					GUIButton_SetState(index + guiConfigBUTTON_ID_OFFSET, GUIButtonState_TouchDown);
+				}
+				if (activeButton->touchCallback != 0)
+					activeButton->touchCallback(Event, index + guiConfigBUTTON_ID_OFFSET);
+			}
+			return;
+		}
+	}
+
+	if (lastActiveButton != 0)
+	{
+		GUIButton_SetState(lastActiveButton->object.id, lastState);
+		lastActiveButton = 0;
+		lastState = GUIButtonState_NoState;
+	}
+}
+
+/**
+ * @brief	The linear scan over every text box, as it was before the touch grid
+ */
+static bool prvLinearTextBoxCheck(GUITouchEvent Event, uint16_t XPos, uint16_t YPos)
+{
+	for (uint32_t index = 0; index < guiConfigNUMBER_OF_TEXT_BOXES; index++)
+	{
+		GUITextBox* activeTextBox = GUITextBox_GetFromId(index + guiConfigTEXT_BOX_ID_OFFSET);
+		if (activeTextBox->object.displayState == GUIDisplayState_NotHidden &&
+			activeTextBox->object.layer == GUI_GetActiveLayer() &&
+			XPos >= activeTextBox->object.xPos && XPos <= activeTextBox->object.xPos + activeTextBox->object.width &&
+			YPos >= activeTextBox->object.yPos && YPos <= activeTextBox->object.yPos + activeTextBox->object.height)
+		{
+			if (activeTextBox->touchCallback != 0)
+				activeTextBox->touchCallback(Event, XPos, YPos);
+			return false;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief	The linear scan over every container, as it was before the touch grid
+ */
+static void prvLinearContainerCheck(GUITouchEvent Event, uint16_t XPos, uint16_t YPos)
+{
+	for (uint32_t index = 0; index < guiConfigNUMBER_OF_CONTAINERS; index++)
+	{
+		GUIContainer* activeContainer = GUIContainer_GetFromId(index + guiConfigCONTAINER_ID_OFFSET);
+		if (activeContainer->object.displayState == GUIDisplayState_NotHidden &&
+			activeContainer->object.layer == GUI_GetActiveLayer() &&
+			XPos >= activeContainer->object.xPos && XPos <= activeContainer->object.xPos + activeContainer->object.width &&
+			YPos >= activeContainer->object.yPos && YPos <= activeContainer->object.yPos + activeContainer->object.height)
+		{
+			if (activeContainer->touchCallback != 0)
+				activeContainer->touchCallback(Event, XPos, YPos);
+			return;
+		}
+	}
+}
+
+/**
+ * @brief	Add the objects, the sidebar in the middle of the lists is the one that is shown
+ */
+static void prvAddObjects()
+{
+	const uint32_t numOfSidebars = (guiConfigNUMBER_OF_BUTTONS - NUM_OF_TOP_BAR_BUTTONS + BUTTONS_PER_SIDEBAR - 1) /
+								   BUTTONS_PER_SIDEBAR;
+	const uint32_t visibleSidebar = numOfSidebars / 2;
+
+	GUIButton button = {0};
+	for (uint32_t i = 0; i < guiConfigNUMBER_OF_BUTTONS; i++)
+	{
+		bool isVisible;
+		button.object.id = i + guiConfigBUTTON_ID_OFFSET;
+		if (i < NUM_OF_TOP_BAR_BUTTONS)
+		{
+			button.object.xPos = i * 81;
+			button.object.yPos = 0;
+			button.object.width = 80;
+			button.object.height = TOP_BAR_HEIGHT - 1;
+			isVisible = true;
+		}
+		else
+		{
+			uint32_t sidebar = (i - NUM_OF_TOP_BAR_BUTTONS) / BUTTONS_PER_SIDEBAR;
+			uint32_t slot = (i - NUM_OF_TOP_BAR_BUTTONS) % BUTTONS_PER_SIDEBAR;
+			button.object.xPos = SIDEBAR_X_POS;
+			button.object.yPos = 80 + slot * 65;
+			button.object.width = SIDEBAR_WIDTH - 1;
+			button.object.height = 58;
+			isVisible = (sidebar == visibleSidebar);
+		}
+		button.object.displayState = isVisible ? GUIDisplayState_NotHidden : GUIDisplayState_Hidden;
+		button.object.border = GUIBorder_Bottom | GUIBorder_Left;
+		button.object.borderThickness = 1;
+		button.object.borderColor = GUI_WHITE;
+		button.enabledTextColor = GUI_WHITE;
+		button.enabledBackgroundColor = GUI_BLUE;
+		button.disabledTextColor = GUI_WHITE;
+		button.disabledBackgroundColor = GUI_GRAY;
+		button.pressedTextColor = GUI_BLUE;
+		button.pressedBackgroundColor = GUI_WHITE;
+		button.state = GUIButtonState_Enabled;
+		button.touchCallback = prvButtonCallback;
+		snprintf((char*)prvButtonText[i], sizeof(prvButtonText[i]), "B%u", (unsigned)i);
+		button.text[0] = prvButtonText[i];
+		button.textSize[0] = LCDFontEnlarge_1x;
+		GUIButton_Add(&button);
+	}
+
+	/* The main content, a label at the top of every sidebar and labels in the pop-outs */
+	GUITextBox textBox = {0};
+	for (uint32_t i = 0; i < guiConfigNUMBER_OF_TEXT_BOXES; i++)
+	{
+		textBox.object.id = i + guiConfigTEXT_BOX_ID_OFFSET;
+		if (i == 0)
+		{
+			textBox.object.xPos = 0;
+			textBox.object.yPos = TOP_BAR_HEIGHT;
+			textBox.object.width = SIDEBAR_X_POS;
+			textBox.object.height = 480 - TOP_BAR_HEIGHT;
+			textBox.object.displayState = GUIDisplayState_NotHidden;
+		}
+		else if (i <= numOfSidebars)
+		{
+			textBox.object.xPos = SIDEBAR_X_POS;
+			textBox.object.yPos = 48;
+			textBox.object.width = SIDEBAR_WIDTH;
+			textBox.object.height = 24;
+			textBox.object.displayState = (i - 1 == visibleSidebar) ? GUIDisplayState_NotHidden : GUIDisplayState_Hidden;
+			textBox.staticText = (uint8_t*)"LABEL";
+		}
+		else
+		{
+			textBox.object.xPos = 160;
+			textBox.object.yPos = 110 + (i % 4) * 40;
+			textBox.object.width = 330;
+			textBox.object.height = 30;
+			textBox.object.displayState = GUIDisplayState_Hidden;
+			textBox.staticText = (uint8_t*)"POP-OUT";
+		}
+		textBox.textColor = GUI_WHITE;
+		textBox.backgroundColor = GUI_BLACK;
+		textBox.textSize = LCDFontEnlarge_1x;
+		textBox.touchCallback = prvTextBoxCallback;
+		GUITextBox_Add(&textBox);
+	}
+
+	/* The top bar, the main content, the sidebars and the pop-outs */
+	GUIContainerTemplate container = {0};
+	for (uint32_t i = 0; i < guiConfigNUMBER_OF_CONTAINERS; i++)
+	{
+		container.object.id = i + guiConfigCONTAINER_ID_OFFSET;
+		if (i == 0)
+		{
+			container.object.width = 800;
+			container.object.height = TOP_BAR_HEIGHT;
+			container.object.displayState = GUIDisplayState_NotHidden;
+		}
+		else if (i == 1)
+		{
+			container.object.yPos = TOP_BAR_HEIGHT;
+			container.object.width = SIDEBAR_X_POS;
+			container.object.height = 480 - TOP_BAR_HEIGHT;
+			container.object.displayState = GUIDisplayState_NotHidden;
+		}
+		else if (i < 2 + numOfSidebars)
+		{
+			container.object.xPos = SIDEBAR_X_POS;
+			container.object.yPos = TOP_BAR_HEIGHT;
+			container.object.width = SIDEBAR_WIDTH;
+			container.object.height = 480 - TOP_BAR_HEIGHT;
+			container.object.displayState = (i - 2 == visibleSidebar) ? GUIDisplayState_NotHidden : GUIDisplayState_Hidden;
+		}
+		else
+		{
+			container.object.xPos = 150;
+			container.object.yPos = 100;
+			container.object.width = 350;
+			container.object.height = 280;
+			container.object.displayState = GUIDisplayState_Hidden;
+		}
+		container.backgroundColor = GUI_BLACK;
+		container.touchCallback = prvContainerCallback;
+		GUIContainer_Add(&container);
+	}
+}
+
+/**
+ * @brief	Tap every point, touch down and up like a finger, with the lookups given
+ * @retval	Nanoseconds per tap
+ */
+static double prvTapAll(void (*ButtonCheck)(GUITouchEvent, uint16_t, uint16_t),
+						bool (*TextBoxCheck)(GUITouchEvent, uint16_t, uint16_t),
+						void (*ContainerCheck)(GUITouchEvent, uint16_t, uint16_t))
+{
+	memset(prvButtonHits, 0, sizeof(prvButtonHits));
+	memset(prvTextBoxHits, 0, sizeof(prvTextBoxHits));
+	prvNumOfContainerHits = 0;
+
+	uint64_t start = testNanoseconds();
+	for (uint32_t i = 0; i < NUM_OF_TAPS; i++)
+	{
+		ButtonCheck(GUITouchEvent_Down, prvTapX[i], prvTapY[i]);
+		TextBoxCheck(GUITouchEvent_Down, prvTapX[i], prvTapY[i]);
+		ContainerCheck(GUITouchEvent_Down, prvTapX[i], prvTapY[i]);
+		ButtonCheck(GUITouchEvent_Up, prvTapX[i], prvTapY[i]);
+		TextBoxCheck(GUITouchEvent_Up, prvTapX[i], prvTapY[i]);
+		ContainerCheck(GUITouchEvent_Up, prvTapX[i], prvTapY[i]);
+	}
+	return (double)(testNanoseconds() - start) / NUM_OF_TAPS;
+}
+
+/* Functions -----------------------------------------------------------------*/
+/**
+ * @brief	The containers allocate their lists of children from the heap
+ */
+void* pvPortMalloc(size_t Size)
+{
+	return malloc(Size);
+}
+
+/**
+ * @brief	The beep is off during the benchmark
+ */
+void BUZZER_BeepNumOfTimes(uint32_t NumOfTimes)
+{
+}
+
+int main()
+{
+	lcdSimInit(LCD_WAIT_Callback);
+	LCD_Init();
+	GUI_Init();
+	GUI_SetBeepOff();
+	prvAddObjects();
+	GUI_RedrawDirtyRegions();
+
+	for (uint32_t i = 0; i < NUM_OF_TAPS; i++)
+	{
+		prvTapX[i] = testRandom(&prvRandomState) % 800;
+		prvTapY[i] = testRandom(&prvRandomState) % 480;
+	}
+
+	/* Once each to warm up and to get the hits to compare */
+	prvTapAll(prvLinearButtonCheck, prvLinearTextBoxCheck, prvLinearContainerCheck);
+	uint32_t linearButtonHits[guiConfigNUMBER_OF_BUTTONS], linearTextBoxHits[guiConfigNUMBER_OF_TEXT_BOXES];
+	memcpy(linearButtonHits, prvButtonHits, sizeof(prvButtonHits));
+	memcpy(linearTextBoxHits, prvTextBoxHits, sizeof(prvTextBoxHits));
+	uint32_t linearContainerHits = prvNumOfContainerHits;
+
+	prvTapAll(GUIButton_CheckAllActiveForTouchEventAt, GUITextBox_CheckAllActiveForTouchEventAt,
+			  GUIContainer_CheckAllActiveForTouchEventAt);
+	TEST_CHECK(memcmp(linearButtonHits, prvButtonHits, sizeof(prvButtonHits)) == 0, "the buttons hit are different");
+	TEST_CHECK(memcmp(linearTextBoxHits, prvTextBoxHits, sizeof(prvTextBoxHits)) == 0, "the text boxes hit are different");
+	TEST_CHECK(linearContainerHits == prvNumOfContainerHits, "%u container hits with the grid, %u with the linear scan",
+			   (unsigned)prvNumOfContainerHits, (unsigned)linearContainerHits);
+
+	double linear = prvTapAll(prvLinearButtonCheck, prvLinearTextBoxCheck, prvLinearContainerCheck);
+	double grid = prvTapAll(GUIButton_CheckAllActiveForTouchEventAt, GUITextBox_CheckAllActiveForTouchEventAt,
+							GUIContainer_CheckAllActiveForTouchEventAt);
+
+	uint32_t numOfButtonHits = 0;
+	for (uint32_t i = 0; i < guiConfigNUMBER_OF_BUTTONS; i++)
+		numOfButtonHits += prvButtonHits[i];
+	printf("%u buttons, %u text boxes, %u containers, %u taps, %u on a button\n",
+		   (unsigned)guiConfigNUMBER_OF_BUTTONS, (unsigned)guiConfigNUMBER_OF_TEXT_BOXES,
+		   (unsigned)guiConfigNUMBER_OF_CONTAINERS, (unsigned)NUM_OF_TAPS, (unsigned)numOfButtonHits);
+	printf("%-12s %12s\n", "lookup", "ns/tap");
+	printf("%-12s %12.1f\n", "linear", linear);
+	printf("%-12s %12.1f\n", "grid", grid);
+	printf("speedup %.1fx\n", linear / grid);
+
+	TEST_CHECK(lcdSimGetNumOfErrors() == 0, "the bus model found errors");
+	TEST_EXIT();
+}
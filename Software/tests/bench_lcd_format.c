@@ -0,0 +1,128 @@
+/**
+ ******************************************************************************
+ * @file	bench_lcd_format.c
+ * @brief	Host benchmark of the text format kernels in lcd_format.c.
+ *
+ *			Every format is timed over a buffer of random bytes and
+ *			compared with the nibble at a time loop the text boxes used
+ *			before and with snprintf. The numbers are for the host, the
+ *			ratio between them is what carries over to the target.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "lcd_format.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define BUFFER_SIZE			(4096)
+#define NUM_OF_ROUNDS		(2000)
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t prvSource[BUFFER_SIZE];
+static uint8_t prvDestination[BUFFER_SIZE * LCD_HEX_DUMP_CHARS_PER_ROW];
+static volatile uint32_t prvSink;
+static uint32_t prvRandomState = 0x6C078965;
+
+static const uint8_t prvHexTable[16] = "0123456789ABCDEF";
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief	The nibble at a time formatting the text boxes used before the kernels
+ */
+static uint32_t prvBaselineFormat(const uint8_t* pSource, uint32_t Size, uint8_t* pDestination, LCDTextFormat Format)
+{
+	uint32_t numOfChars = 0;
+	for (uint32_t i = 0; i < Size; i++)
+	{
+		if (Format == LCDTextFormat_HexWithSpaces)
+		{
+			pDestination[numOfChars++] = prvHexTable[pSource[i] >> 4];
+			pDestination[numOfChars++] = prvHexTable[pSource[i] & 0x0F];
+			pDestination[numOfChars++] = ' ';
+		}
+		else if (Format == LCDTextFormat_HexWithoutSpaces)
+		{
+			pDestination[numOfChars++] = prvHexTable[pSource[i] >> 4];
+			pDestination[numOfChars++] = prvHexTable[pSource[i] & 0x0F];
+		}
+		else if (Format == LCDTextFormat_Decimal)
+		{
+			numOfChars += sprintf((char*)&pDestination[numOfChars], "%3u ", pSource[i]);
+		}
+		else if (Format == LCDTextFormat_Binary)
+		{
+			for (int bit = 7; bit >= 0; bit--)
+				pDestination[numOfChars++] = '0' + ((pSource[i] >> bit) & 1);
+			pDestination[numOfChars++] = ' ';
+		}
+	}
+	return numOfChars;
+}
+
+/**
+ * @brief	snprintf for every byte
+ */
+static uint32_t prvSnprintfFormat(const uint8_t* pSource, uint32_t Size, uint8_t* pDestination, LCDTextFormat Format)
+{
+	const char* format = (Format == LCDTextFormat_Decimal) ? "%3u " :
+						 (Format == LCDTextFormat_HexWithSpaces) ? "%02X " : "%02X";
+	uint32_t numOfChars = 0;
+	for (uint32_t i = 0; i < Size; i++)
+		numOfChars += snprintf((char*)&pDestination[numOfChars], 8, format, pSource[i]);
+	return numOfChars;
+}
+
+/**
+ * @brief	Time a format function
+ * @retval	Nanoseconds per byte
+ */
+static double prvTime(uint32_t (*Function)(const uint8_t*, uint32_t, uint8_t*, LCDTextFormat), LCDTextFormat Format)
+{
+	uint64_t start = testNanoseconds();
+	for (uint32_t round = 0; round < NUM_OF_ROUNDS; round++)
+		prvSink += Function(prvSource, BUFFER_SIZE, prvDestination, Format);
+	return (double)(testNanoseconds() - start) / ((double)NUM_OF_ROUNDS * BUFFER_SIZE);
+}
+
+/* Functions -----------------------------------------------------------------*/
+int main()
+{
+	static const struct
+	{
+		const char* name;
+		LCDTextFormat format;
+		bool hasBaseline;
+		bool hasSnprintf;
+	} formats[] = {
+		{ "HexWithSpaces",		LCDTextFormat_HexWithSpaces,	true,	true },
+		{ "HexWithoutSpaces",	LCDTextFormat_HexWithoutSpaces,	true,	true },
+		{ "Decimal",			LCDTextFormat_Decimal,			true,	true },
+		{ "Binary",				LCDTextFormat_Binary,			true,	false },
+		{ "CEscaped",			LCDTextFormat_CEscaped,			false,	false },
+		{ "HexDump",			LCDTextFormat_HexDump,			false,	false },
+	};
+
+	for (uint32_t i = 0; i < BUFFER_SIZE; i++)
+		prvSource[i] = testRandom(&prvRandomState);
+
+	printf("%-18s %12s %12s %14s %9s\n", "format", "kernel ns/B", "nibble ns/B", "snprintf ns/B", "speedup");
+	for (uint32_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i++)
+	{
+		char baseline[16] = "-", reference[16] = "-", speedup[16] = "-";
+		double kernel = prvTime(LCD_FormatBuffer, formats[i].format);
+		if (formats[i].hasBaseline)
+		{
+			double time = prvTime(prvBaselineFormat, formats[i].format);
+			snprintf(baseline, sizeof(baseline), "%.3f", time);
+			snprintf(speedup, sizeof(speedup), "%.1fx", time / kernel);
+		}
+		if (formats[i].hasSnprintf)
+			snprintf(reference, sizeof(reference), "%.3f", prvTime(prvSnprintfFormat, formats[i].format));
+		printf("%-18s %12.3f %12s %14s %9s\n", formats[i].name, kernel, baseline, reference, speedup);
+	}
+	return 0;
+}
@@ -0,0 +1,147 @@
+/**
+ ******************************************************************************
+ * @file	bench_uart_search.c
+ * @brief	Host benchmark of the pattern search in uart_search.c.
+ *
+ *			A 16 MB FLASH image with logged text lines is searched in
+ *			blocks through SPI_FLASH_ReadBufferDMA like on the target and
+ *			compared with a byte at a time scan.
+ *			The pattern is only at the far end of the image so all of it
+ *			has to be searched. On the target the 21 MHz SPI FLASH limits
+ *			the search to about 2.6 MB/s, the host numbers show how much
+ *			of that the CPU part of the search would use.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "uart_search.h"
+#include "spi_flash.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define IMAGE_SIZE				(16 * 1024 * 1024)
+#define NUM_OF_ROUNDS			(3)
+#define MEGABYTE				(1024.0 * 1024.0)
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t* prvImage;
+static UARTSearch prvSearch;
+static uint32_t prvRandomState = 0x2545F491;
+static volatile uint32_t prvSink;
+
+/* FLASH model ---------------------------------------------------------------*/
+/**
+ * @brief	The SPI FLASH read the UART channels search with, the image starts at address 0
+ */
+ErrorStatus SPI_FLASH_ReadBufferDMA(uint8_t* pBuffer, uint32_t ReadAddress, uint32_t NumByteToRead, TickType_t BlockTime)
+{
+	if (ReadAddress + NumByteToRead > IMAGE_SIZE)
+		return ERROR;
+	memcpy(pBuffer, &prvImage[ReadAddress], NumByteToRead);
+	return SUCCESS;
+}
+
+/**
+ * @brief	The search summaries are not used so nothing is written
+ */
+void SPI_FLASH_WriteByte(uint32_t WriteAddress, uint8_t Byte)
+{
+}
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief	Fill the image with lines like the ones a device logs on a UART
+ */
+static void prvFillImage()
+{
+	static const char* const names[] = { "TEMP", "ADC", "STATUS", "RX", "TX", "BATT", "ERR", "OK" };
+	uint32_t size = 0;
+	while (size < IMAGE_SIZE)
+	{
+		char line[64];
+		uint32_t value = testRandom(&prvRandomState);
+		int length = snprintf(line, sizeof(line), "%08u %s=%u,%u\r\n", size / 16,
+							  names[value % 8], (value >> 3) % 4096, (value >> 15) % 100);
+		for (int i = 0; i < length && size < IMAGE_SIZE; i++)
+			prvImage[size++] = line[i];
+	}
+}
+
+/**
+ * @brief	Byte at a time scan of the image, what a search without skips has to do
+ */
+static int64_t prvNaiveFind(const uint8_t* pPattern, uint32_t Size, bool Forward)
+{
+	for (uint32_t n = 0; n + Size <= IMAGE_SIZE; n++)
+	{
+		uint32_t i = Forward ? n : IMAGE_SIZE - Size - n;
+		if (prvImage[i] == pPattern[0] && memcmp(&prvImage[i], pPattern, Size) == 0)
+			return i;
+	}
+	return -1;
+}
+
+/**
+ * @brief	Run a search until it's done
+ */
+static int64_t prvSearchFind(bool Forward)
+{
+	uartSearchStart(&prvSearch, SPI_FLASH_ReadBufferDMA, 0, 0, IMAGE_SIZE, Forward ? 0 : IMAGE_SIZE,
+					Forward ? UARTSearchDirection_Forward : UARTSearchDirection_Backward);
+	while (uartSearchContinue(&prvSearch, 8) == UARTSearchState_Searching);
+	return (uartSearchGetState(&prvSearch) == UARTSearchState_Found) ? uartSearchGetMatchAddress(&prvSearch) : -1;
+}
+
+/* Functions -----------------------------------------------------------------*/
+int main()
+{
+	static const char* const patterns[] = { "#", "#GO#", "#FIND THIS NOW!#" };
+
+	prvImage = malloc(IMAGE_SIZE);
+	if (prvImage == 0)
+		return 1;
+	prvFillImage();
+
+	printf("%-20s %-9s %12s %12s %9s\n", "pattern", "direction", "search MB/s", "naive MB/s", "speedup");
+	for (uint32_t p = 0; p < sizeof(patterns) / sizeof(patterns[0]); p++)
+	{
+		uint32_t size = strlen(patterns[p]);
+		uartSearchSetPatternFromString(&prvSearch, (const uint8_t*)patterns[p], UARTSearchPatternFormat_Ascii);
+
+		for (uint32_t d = 0; d < 2; d++)
+		{
+			bool forward = (d == 0);
+
+			/* The only match is at the end the search reaches last */
+			prvFillImage();
+			uint32_t matchAddress = forward ? IMAGE_SIZE - 1000 : 1000;
+			memcpy(&prvImage[matchAddress], patterns[p], size);
+
+			uint64_t searchTime = 0, naiveTime = 0;
+			for (uint32_t round = 0; round < NUM_OF_ROUNDS; round++)
+			{
+				uint64_t start = testNanoseconds();
+				int64_t found = prvSearchFind(forward);
+				searchTime += testNanoseconds() - start;
+				TEST_CHECK(found == matchAddress, "\"%s\" was found at %lld instead of %u", patterns[p], (long long)found,
+						   (unsigned)matchAddress);
+
+				start = testNanoseconds();
+				prvSink += prvNaiveFind((const uint8_t*)patterns[p], size, forward);
+				naiveTime += testNanoseconds() - start;
+			}
+
+			double searchSpeed = NUM_OF_ROUNDS * IMAGE_SIZE / MEGABYTE / (searchTime * 1e-9);
+			double naiveSpeed = NUM_OF_ROUNDS * IMAGE_SIZE / MEGABYTE / (naiveTime * 1e-9);
+			printf("%-20s %-9s %12.0f %12.0f %8.1fx\n", patterns[p], forward ? "forward" : "backward",
+				   searchSpeed, naiveSpeed, searchSpeed / naiveSpeed);
+		}
+	}
+
+	free(prvImage);
+	TEST_EXIT();
+}
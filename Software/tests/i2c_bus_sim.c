@@ -0,0 +1,709 @@
+/**
+ ******************************************************************************
+ * @file	i2c_bus_sim.c
+ * @brief	Model of the I2C2 peripheral and the slaves on the bus for the
+ *			host tests.
+ *
+ *			The register macros in i2c_bus_sim.h turn every access into a
+ *			call of i2cSimAccess. It fills in the value the register has
+ *			and finds out at the next access whether the driver wrote to
+ *			it, the side effects of a read or a write are then carried out
+ *			like in the master mode of the reference manual: DR writes
+ *			clear SB and send bytes, SR2 reads clear ADDR, DR reads take
+ *			the received byte and let the next one in, and START and STOP
+ *			are sent after the current byte.
+ *
+ *			The bus moves on with the modelled time. Every register access
+ *			takes a few cycles so the bus keeps running while the driver
+ *			waits for something, but the interrupts are only called from
+ *			i2cSimRun and the semaphores, never in the middle of the driver.
+ *			The slaves have a register file with an address pointer that is
+ *			set by the first byte written and incremented by every byte.
+ *
+ *			There is only one task on the host so xSemaphoreTake runs the
+ *			bus and the interrupts the task would sleep through, and the
+ *			functions pended on the timer task run a context switch later.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "i2c_bus_sim.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "timers.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define CORE_CLOCK				(168000000)
+#define CYCLES_PER_US			(CORE_CLOCK / 1000000)
+#define CYCLES_PER_TICK			(CORE_CLOCK / configTICK_RATE_HZ)
+
+/* 400 kHz, a byte is eight bits and the acknowledge */
+#define BIT_CYCLES				(CORE_CLOCK / 400000)
+#define BYTE_CYCLES				(9 * BIT_CYCLES)
+
+/* APB1 runs at a quarter of the core clock */
+#define ACCESS_CYCLES			(4)
+#define COUNTER_READ_CYCLES		(1)
+/* Time until the timer task runs a pended function */
+#define TIMER_TASK_LATENCY		(20 * CYCLES_PER_US)
+
+#define ERROR_FLAGS				(I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_AF | I2C_SR1_OVR | I2C_SR1_TIMEOUT)
+
+/* Set in the value of DR while it's being accessed, the driver only writes bytes */
+#define DR_READ_MARKER			(0xA500)
+
+#define MAX_NUM_OF_SEMAPHORES	(8)
+#define MAX_NUM_OF_PENDED_CALLS	(4)
+
+/* Things the driver does that the peripheral would not handle, counted and checked by the tests */
+#define SIM_CHECK(CONDITION, ...)											\
+	do {																	\
+		if (!(CONDITION))													\
+		{																	\
+			prvSim.numOfErrors++;											\
+			printf("%s:%d: FAIL: ", __FILE__, __LINE__);					\
+			printf(__VA_ARGS__);											\
+			printf("\n");													\
+		}																	\
+	} while (0)
+
+/* Private typedefs ----------------------------------------------------------*/
+typedef enum
+{
+	Operation_None,
+	Operation_Start,
+	Operation_Address,
+	Operation_Transmit,
+	Operation_Receive,
+	Operation_Stop,
+} Operation;
+
+typedef enum
+{
+	Mode_Idle,						/* The bus is free or the slave didn't answer */
+	Mode_Address,					/* After a start condition */
+	Mode_Transmit,
+	Mode_Receive,
+} Mode;
+
+typedef struct
+{
+	uint8_t address;
+	uint8_t* pRegisters;
+	uint8_t pointer;
+	bool pointerIsNext;				/* The next byte written sets the pointer */
+} Device;
+
+typedef struct
+{
+	PendedFunction_t function;
+	void* pvParameter1;
+	uint32_t ulParameter2;
+	uint64_t time;
+} PendedCall;
+
+typedef struct
+{
+	bool available;
+} SimSemaphore;
+
+/* Private variables ---------------------------------------------------------*/
+uint32_t SystemCoreClock = CORE_CLOCK;
+I2C_TypeDef i2cSimPeripheral;
+
+static struct
+{
+	uint32_t cr1;
+	uint32_t cr2;
+	uint32_t sr1;
+	uint32_t sr2;
+	uint32_t dr;
+
+	/* The register the driver is accessing and the value it had */
+	bool isAccessing;
+	I2CSimRegister accessRegister;
+	uint32_t accessValue;
+
+	uint64_t time;					/* Modelled time in cycles */
+	uint64_t busTime;				/* The bus has been run up to this time */
+	Operation operation;
+	uint64_t operationEnd;
+
+	bool isMaster;
+	Mode mode;
+	Device* pDevice;
+	uint8_t shift;					/* The byte in the shift register */
+	uint8_t transmitData;
+	bool transmitIsFull;
+	bool receiveIsHeld;				/* A received byte waits in the shift register because DR is full */
+	bool lastWasNacked;
+	bool ackForNext;				/* ACK when the last byte was done, used for the next byte when POS is set */
+
+	Device devices[I2C_SIM_MAX_NUM_OF_DEVICES];
+	uint32_t numOfDevices;
+
+	/* An interrupt that changed nothing is not called again until the bus has moved on */
+	uint64_t numOfChanges;
+	bool interruptIsWaiting;
+
+	PendedCall pendedCalls[MAX_NUM_OF_PENDED_CALLS];
+	uint32_t numOfPendedCalls;
+	SimSemaphore semaphores[MAX_NUM_OF_SEMAPHORES];
+	uint32_t numOfSemaphores;
+
+	I2CSimCounters counters;
+	uint32_t numOfErrors;
+} prvSim;
+
+/* Private function prototypes -----------------------------------------------*/
+static void prvReset();
+static void prvFinishAccess();
+static void prvRunBus(uint64_t Time);
+static void prvStartOperation();
+static void prvFinishOperation();
+static bool prvStep(uint64_t EndTime);
+static void prvCallInterrupt(void (*Handler)(void));
+
+/* Functions -----------------------------------------------------------------*/
+/**
+ * @brief	Called for every register access of the driver
+ * @param	Register: The register
+ * @retval	The index of the register in I2C_TypeDef
+ */
+uint32_t i2cSimAccess(I2CSimRegister Register)
+{
+	prvRunBus(prvSim.time);
+	prvFinishAccess();
+	prvSim.time += ACCESS_CYCLES;
+	prvRunBus(prvSim.time);
+
+	uint32_t value = 0;
+	switch (Register)
+	{
+		case I2CSimRegister_CR1:	value = prvSim.cr1; break;
+		case I2CSimRegister_CR2:	value = prvSim.cr2; break;
+		case I2CSimRegister_DR:		value = DR_READ_MARKER | prvSim.dr; break;
+		case I2CSimRegister_SR1:	value = prvSim.sr1; break;
+		case I2CSimRegister_SR2:	value = prvSim.sr2; break;
+		default:					break;
+	}
+	i2cSimPeripheral.registers[Register] = value;
+	prvSim.isAccessing = true;
+	prvSim.accessRegister = Register;
+	prvSim.accessValue = value;
+	return Register;
+}
+
+/**
+ * @brief	Called for every access to the cycle counter
+ * @param	None
+ * @retval	The cycle counter with the modelled time
+ */
+DWT_Type* i2cSimCycleCounter()
+{
+	prvSim.time += COUNTER_READ_CYCLES;
+	prvHostDWT.CYCCNT = (uint32_t)prvSim.time;
+	return &prvHostDWT;
+}
+
+/**
+ * @brief	Resets the model, the semaphores created by the driver are kept
+ * @param	None
+ * @retval	None
+ */
+void i2cSimInit()
+{
+	uint32_t numOfSemaphores = prvSim.numOfSemaphores;
+	SimSemaphore semaphores[MAX_NUM_OF_SEMAPHORES];
+	memcpy(semaphores, prvSim.semaphores, sizeof(semaphores));
+
+	memset(&prvSim, 0, sizeof(prvSim));
+	prvSim.numOfSemaphores = numOfSemaphores;
+	memcpy(prvSim.semaphores, semaphores, sizeof(semaphores));
+
+	/* Nothing holds SDA or SCL low */
+	GPIOB->IDR |= GPIO_PIN_10 | GPIO_PIN_11;
+}
+
+/**
+ * @brief	Adds a slave to the bus
+ * @param	Address: The 7-bit address
+ * @param	pRegisters: The 256 registers of the slave
+ * @retval	None
+ */
+void i2cSimAddDevice(uint8_t Address, uint8_t* pRegisters)
+{
+	if (prvSim.numOfDevices < I2C_SIM_MAX_NUM_OF_DEVICES)
+	{
+		Device* pDevice = &prvSim.devices[prvSim.numOfDevices++];
+		pDevice->address = Address;
+		pDevice->pRegisters = pRegisters;
+	}
+}
+
+/**
+ * @brief	Runs the bus, the interrupts and the timer task
+ * @param	Microseconds: Time to run
+ * @retval	None
+ */
+void i2cSimRun(uint32_t Microseconds)
+{
+	uint64_t endTime = prvSim.time + (uint64_t)Microseconds * CYCLES_PER_US;
+	while (prvStep(endTime));
+}
+
+/**
+ * @brief	Check if the bus is free and nothing more will happen on it
+ * @param	None
+ * @retval	true if idle
+ */
+bool i2cSimIsIdle()
+{
+	prvFinishAccess();
+	prvRunBus(prvSim.time);
+	return !prvSim.isMaster && prvSim.operation == Operation_None && prvSim.numOfPendedCalls == 0 &&
+		   (prvSim.cr1 & (I2C_CR1_START | I2C_CR1_STOP)) == 0;
+}
+
+/**
+ * @brief	Get the counters
+ * @param	None
+ * @retval	The counters
+ */
+I2CSimCounters i2cSimGetCounters()
+{
+	prvSim.counters.cycles = prvSim.time;
+	return prvSim.counters;
+}
+
+/**
+ * @brief	Get the number of things the driver did that the peripheral would not handle
+ * @param	None
+ * @retval	The number of errors
+ */
+uint32_t i2cSimGetNumOfErrors()
+{
+	return prvSim.numOfErrors;
+}
+
+/* HAL and FreeRTOS ----------------------------------------------------------*/
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef* hi2c)
+{
+	prvFinishAccess();
+	prvReset();
+	prvSim.cr1 = I2C_CR1_PE;
+	return HAL_OK;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex()
+{
+	if (prvSim.numOfSemaphores == MAX_NUM_OF_SEMAPHORES)
+		return 0;
+	SimSemaphore* pSemaphore = &prvSim.semaphores[prvSim.numOfSemaphores++];
+	pSemaphore->available = true;
+	return pSemaphore;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary()
+{
+	SimSemaphore* pSemaphore = xSemaphoreCreateMutex();
+	if (pSemaphore != 0)
+		pSemaphore->available = false;
+	return pSemaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t Semaphore, TickType_t BlockTime)
+{
+	SimSemaphore* pSemaphore = Semaphore;
+	uint64_t endTime = prvSim.time + (uint64_t)BlockTime * CYCLES_PER_TICK;
+	while (!pSemaphore->available && prvStep(endTime));
+
+	if (!pSemaphore->available)
+		return pdFALSE;
+	pSemaphore->available = false;
+	return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t Semaphore)
+{
+	((SimSemaphore*)Semaphore)->available = true;
+	return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t Semaphore, BaseType_t* pHigherPriorityTaskWoken)
+{
+	return xSemaphoreGive(Semaphore);
+}
+
+BaseType_t xTimerPendFunctionCallFromISR(PendedFunction_t FunctionToPend, void* pvParameter1, uint32_t ulParameter2,
+										 BaseType_t* pHigherPriorityTaskWoken)
+{
+	if (prvSim.numOfPendedCalls == MAX_NUM_OF_PENDED_CALLS)
+		return pdFAIL;
+
+	PendedCall* pCall = &prvSim.pendedCalls[prvSim.numOfPendedCalls++];
+	pCall->function = FunctionToPend;
+	pCall->pvParameter1 = pvParameter1;
+	pCall->ulParameter2 = ulParameter2;
+	pCall->time = prvSim.time + TIMER_TASK_LATENCY;
+	return pdPASS;
+}
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief	Puts the peripheral in its reset state and releases the bus
+ */
+static void prvReset()
+{
+	prvSim.cr1 = 0;
+	prvSim.cr2 = 0;
+	prvSim.sr1 = 0;
+	prvSim.sr2 = 0;
+	prvSim.dr = 0;
+	prvSim.operation = Operation_None;
+	prvSim.isMaster = false;
+	prvSim.mode = Mode_Idle;
+	prvSim.transmitIsFull = false;
+	prvSim.receiveIsHeld = false;
+	prvSim.busTime = prvSim.time;
+}
+
+/**
+ * @brief	Carries out the side effects of the last register access
+ */
+static void prvFinishAccess()
+{
+	if (!prvSim.isAccessing)
+		return;
+	prvSim.isAccessing = false;
+	prvRunBus(prvSim.time);
+
+	uint32_t value = i2cSimPeripheral.registers[prvSim.accessRegister];
+	bool isWrite = (value != prvSim.accessValue);
+	uint64_t numOfChanges = prvSim.numOfChanges;
+
+	switch (prvSim.accessRegister)
+	{
+		case I2CSimRegister_CR1:
+			if (prvSim.cr1 & I2C_CR1_STOP)
+			{
+				if (isWrite)
+					prvSim.counters.writesDuringStop++;
+				else
+					prvSim.counters.stopWaitReads++;
+			}
+			if (!isWrite)
+				break;
+
+			if (value & I2C_CR1_SWRST)
+				prvReset();
+			/* START and STOP can only be set, the peripheral clears them */
+			prvSim.cr1 = (value & ~(I2C_CR1_START | I2C_CR1_STOP)) | ((prvSim.cr1 | value) & (I2C_CR1_START | I2C_CR1_STOP));
+			prvSim.numOfChanges++;
+			break;
+
+		case I2CSimRegister_CR2:
+			if (isWrite)
+			{
+				prvSim.cr2 = value;
+				prvSim.numOfChanges++;
+			}
+			break;
+
+		case I2CSimRegister_DR:
+			if (isWrite)
+			{
+				prvSim.numOfChanges++;
+				if (prvSim.sr1 & I2C_SR1_SB)
+				{
+					/* The address is sent right away */
+					prvSim.sr1 &= ~I2C_SR1_SB;
+					prvSim.shift = value;
+					prvSim.operation = Operation_Address;
+					prvSim.operationEnd = prvSim.busTime + BYTE_CYCLES;
+				}
+				else
+				{
+					SIM_CHECK(prvSim.mode == Mode_Transmit, "DR written while not sending");
+					SIM_CHECK(!prvSim.transmitIsFull, "DR written before the last byte was sent");
+					prvSim.transmitData = value;
+					prvSim.transmitIsFull = true;
+					prvSim.sr1 &= ~(I2C_SR1_TXE | I2C_SR1_BTF);
+				}
+			}
+			else if (prvSim.sr1 & I2C_SR1_RXNE)
+			{
+				/* The byte waiting in the shift register moves in */
+				prvSim.numOfChanges++;
+				if (prvSim.receiveIsHeld)
+				{
+					prvSim.dr = prvSim.shift;
+					prvSim.receiveIsHeld = false;
+					prvSim.sr1 &= ~I2C_SR1_BTF;
+				}
+				else
+					prvSim.sr1 &= ~I2C_SR1_RXNE;
+			}
+			else
+				SIM_CHECK(prvSim.mode != Mode_Receive, "DR read before a byte was received");
+			break;
+
+		case I2CSimRegister_SR1:
+			/* Only the error flags can be cleared by writing 0 */
+			if (isWrite)
+			{
+				prvSim.sr1 &= value | ~ERROR_FLAGS;
+				prvSim.numOfChanges++;
+			}
+			break;
+
+		case I2CSimRegister_SR2:
+			/* Reading SR2 after SR1 clears ADDR */
+			if (prvSim.sr1 & I2C_SR1_ADDR)
+			{
+				prvSim.sr1 &= ~I2C_SR1_ADDR;
+				prvSim.numOfChanges++;
+			}
+			break;
+
+		default:
+			break;
+	}
+
+	if (prvSim.numOfChanges != numOfChanges)
+		prvSim.interruptIsWaiting = false;
+	prvStartOperation();
+}
+
+/**
+ * @brief	Runs the bus up to a time
+ * @param	Time: The time in cycles
+ */
+static void prvRunBus(uint64_t Time)
+{
+	while (true)
+	{
+		prvStartOperation();
+		if (prvSim.operation == Operation_None || prvSim.operationEnd > Time)
+			break;
+		prvSim.busTime = prvSim.operationEnd;
+		prvFinishOperation();
+	}
+	prvSim.busTime = Time;
+}
+
+/**
+ * @brief	Starts what the peripheral does next if the bus is not busy
+ */
+static void prvStartOperation()
+{
+	if (prvSim.operation != Operation_None)
+		return;
+
+	if (prvSim.isMaster && (prvSim.cr1 & I2C_CR1_STOP))
+	{
+		/* After the current byte, a received byte that has not been NACKed is lost */
+		prvSim.operation = Operation_Stop;
+		prvSim.operationEnd = prvSim.busTime + BIT_CYCLES;
+	}
+	else if ((prvSim.cr1 & I2C_CR1_START) &&
+			 (!prvSim.isMaster || (prvSim.mode == Mode_Transmit && (prvSim.sr1 & I2C_SR1_BTF))))
+	{
+		prvSim.operation = Operation_Start;
+		prvSim.operationEnd = prvSim.busTime + BIT_CYCLES;
+	}
+	else if (prvSim.mode == Mode_Transmit && !(prvSim.sr1 & I2C_SR1_ADDR) && prvSim.transmitIsFull)
+	{
+		prvSim.shift = prvSim.transmitData;
+		prvSim.transmitIsFull = false;
+		prvSim.sr1 |= I2C_SR1_TXE;
+		prvSim.operation = Operation_Transmit;
+		prvSim.operationEnd = prvSim.busTime + BYTE_CYCLES;
+	}
+	else if (prvSim.mode == Mode_Receive && !(prvSim.sr1 & I2C_SR1_ADDR) && !prvSim.lastWasNacked &&
+			 !prvSim.receiveIsHeld)
+	{
+		prvSim.operation = Operation_Receive;
+		prvSim.operationEnd = prvSim.busTime + BYTE_CYCLES;
+	}
+}
+
+/**
+ * @brief	Finishes the operation on the bus
+ */
+static void prvFinishOperation()
+{
+	Operation operation = prvSim.operation;
+	prvSim.operation = Operation_None;
+	prvSim.interruptIsWaiting = false;
+
+	switch (operation)
+	{
+		case Operation_Start:
+			prvSim.cr1 &= ~I2C_CR1_START;
+			prvSim.sr1 = (prvSim.sr1 & ~(I2C_SR1_BTF | I2C_SR1_TXE)) | I2C_SR1_SB;
+			prvSim.sr2 |= I2C_SR2_MSL | I2C_SR2_BUSY;
+			prvSim.isMaster = true;
+			prvSim.mode = Mode_Address;
+			prvSim.counters.starts++;
+			break;
+
+		case Operation_Address:
+			prvSim.pDevice = 0;
+			for (uint32_t i = 0; i < prvSim.numOfDevices; i++)
+			{
+				if (prvSim.devices[i].address == (prvSim.shift >> 1))
+					prvSim.pDevice = &prvSim.devices[i];
+			}
+
+			if (prvSim.pDevice == 0)
+			{
+				/* Nobody answered */
+				prvSim.sr1 |= I2C_SR1_AF;
+				prvSim.mode = Mode_Idle;
+			}
+			else if (prvSim.shift & 0x1)
+			{
+				prvSim.sr1 |= I2C_SR1_ADDR;
+				prvSim.sr2 &= ~I2C_SR2_TRA;
+				prvSim.mode = Mode_Receive;
+				prvSim.lastWasNacked = false;
+				prvSim.receiveIsHeld = false;
+				prvSim.ackForNext = (prvSim.cr1 & I2C_CR1_ACK) != 0;
+			}
+			else
+			{
+				prvSim.sr1 |= I2C_SR1_ADDR | I2C_SR1_TXE;
+				prvSim.sr2 |= I2C_SR2_TRA;
+				prvSim.mode = Mode_Transmit;
+				prvSim.pDevice->pointerIsNext = true;
+			}
+			break;
+
+		case Operation_Transmit:
+			if (prvSim.pDevice->pointerIsNext)
+			{
+				prvSim.pDevice->pointer = prvSim.shift;
+				prvSim.pDevice->pointerIsNext = false;
+			}
+			else
+				prvSim.pDevice->pRegisters[prvSim.pDevice->pointer++] = prvSim.shift;
+			prvSim.counters.writtenBytes++;
+
+			/* The clock is held low until there's a new byte */
+			if (!prvSim.transmitIsFull)
+				prvSim.sr1 |= I2C_SR1_BTF;
+			break;
+
+		case Operation_Receive:
+		{
+			prvSim.shift = prvSim.pDevice->pRegisters[prvSim.pDevice->pointer++];
+			prvSim.counters.readBytes++;
+
+			/* With POS set ACK is for the byte after the one being received */
+			bool ack = (prvSim.cr1 & I2C_CR1_POS) ? prvSim.ackForNext : (prvSim.cr1 & I2C_CR1_ACK) != 0;
+			prvSim.ackForNext = (prvSim.cr1 & I2C_CR1_ACK) != 0;
+			prvSim.lastWasNacked = !ack;
+
+			/* The clock is held low until DR has been read */
+			if (prvSim.sr1 & I2C_SR1_RXNE)
+			{
+				prvSim.receiveIsHeld = true;
+				prvSim.sr1 |= I2C_SR1_BTF;
+			}
+			else
+			{
+				prvSim.dr = prvSim.shift;
+				prvSim.sr1 |= I2C_SR1_RXNE;
+			}
+			break;
+		}
+
+		case Operation_Stop:
+			prvSim.cr1 &= ~I2C_CR1_STOP;
+			prvSim.sr1 &= ~(I2C_SR1_SB | I2C_SR1_ADDR | I2C_SR1_BTF | I2C_SR1_TXE);
+			prvSim.sr2 &= ~(I2C_SR2_MSL | I2C_SR2_BUSY | I2C_SR2_TRA);
+			prvSim.isMaster = false;
+			prvSim.mode = Mode_Idle;
+			prvSim.transmitIsFull = false;
+			prvSim.receiveIsHeld = false;
+			prvSim.counters.stops++;
+			break;
+
+		default:
+			break;
+	}
+}
+
+/**
+ * @brief	Runs the next interrupt, pended function or bus operation
+ * @param	EndTime: Time to stop at
+ * @retval	false when the end time has been reached
+ */
+static bool prvStep(uint64_t EndTime)
+{
+	prvFinishAccess();
+	prvRunBus(prvSim.time);
+	if (prvSim.time >= EndTime)
+		return false;
+
+	if (!prvSim.interruptIsWaiting)
+	{
+		if ((prvSim.cr2 & I2C_CR2_ITERREN) && (prvSim.sr1 & ERROR_FLAGS))
+		{
+			prvCallInterrupt(I2C2_ER_IRQHandler);
+			return true;
+		}
+		if ((prvSim.cr2 & I2C_CR2_ITEVTEN) &&
+			((prvSim.sr1 & (I2C_SR1_SB | I2C_SR1_ADDR | I2C_SR1_BTF)) ||
+			 ((prvSim.cr2 & I2C_CR2_ITBUFEN) && (prvSim.sr1 & (I2C_SR1_RXNE | I2C_SR1_TXE)))))
+		{
+			prvCallInterrupt(I2C2_EV_IRQHandler);
+			return true;
+		}
+	}
+
+	/* The timer task */
+	uint64_t nextTime = EndTime;
+	for (uint32_t i = 0; i < prvSim.numOfPendedCalls; i++)
+	{
+		PendedCall call = prvSim.pendedCalls[i];
+		if (call.time <= prvSim.time)
+		{
+			memmove(&prvSim.pendedCalls[i], &prvSim.pendedCalls[i + 1], (--prvSim.numOfPendedCalls - i) * sizeof(call));
+			call.function(call.pvParameter1, call.ulParameter2);
+			return true;
+		}
+		if (call.time < nextTime)
+			nextTime = call.time;
+	}
+
+	if (prvSim.operation != Operation_None && prvSim.operationEnd < nextTime)
+		nextTime = prvSim.operationEnd;
+	prvSim.time = nextTime;
+	return true;
+}
+
+/**
+ * @brief	Calls an interrupt handler of the driver and measures the time in it
+ * @param	Handler: The handler
+ */
+static void prvCallInterrupt(void (*Handler)(void))
+{
+	uint64_t startTime = prvSim.time;
+	uint64_t numOfChanges = prvSim.numOfChanges;
+
+	Handler();
+	prvFinishAccess();
+
+	prvSim.counters.interrupts++;
+	if (prvSim.time - startTime > prvSim.counters.maxInterruptCycles)
+		prvSim.counters.maxInterruptCycles = prvSim.time - startTime;
+
+	/* A flag that stays set only calls the interrupt again once the bus has moved on, the target would call it repeatedly */
+	if (prvSim.numOfChanges == numOfChanges)
+		prvSim.interruptIsWaiting = true;
+}
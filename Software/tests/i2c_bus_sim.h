@@ -0,0 +1,84 @@
+/**
+ ******************************************************************************
+ * @file	i2c_bus_sim.h
+ * @brief	Model of the I2C2 peripheral and the slaves on the bus for the
+ *			host tests.
+ *
+ *			Included before the I2C driver with -include so every access
+ *			to an I2C2 register and to the cycle counter calls the model.
+ *			The model carries out the side effects the registers have on
+ *			the target, runs the bus at 400 kHz and answers for register
+ *			file slaves like the FT5206. It also provides the semaphores
+ *			and the timer task the driver uses, see i2c_bus_sim.c.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef I2C_BUS_SIM_H_
+#define I2C_BUS_SIM_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx_hal.h"
+
+/* Typedefs ------------------------------------------------------------------*/
+typedef enum
+{
+	I2CSimRegister_CR1,
+	I2CSimRegister_CR2,
+	I2CSimRegister_DR,
+	I2CSimRegister_SR1,
+	I2CSimRegister_SR2,
+	I2CSimRegister_NumOfRegisters,
+} I2CSimRegister;
+
+/* Every register access goes through i2cSimAccess, which returns the index to use */
+struct I2C_TypeDef
+{
+	volatile uint32_t registers[I2CSimRegister_NumOfRegisters];
+};
+
+typedef struct
+{
+	uint64_t starts;				/* Start and repeated start conditions */
+	uint64_t stops;
+	uint64_t writtenBytes;			/* Bytes sent to a slave, register addresses included */
+	uint64_t readBytes;				/* Bytes clocked out of a slave */
+	uint64_t interrupts;			/* Calls of the event and error interrupt handlers */
+	uint64_t maxInterruptCycles;	/* Longest time in one I2C interrupt */
+	uint64_t stopWaitReads;			/* Reads of CR1 while a stop condition was waiting to be sent */
+	uint64_t writesDuringStop;		/* Writes to CR1 while a stop condition was waiting to be sent */
+	uint64_t cycles;				/* Modelled time */
+} I2CSimCounters;
+
+/* Defines -------------------------------------------------------------------*/
+#define I2C_SIM_MAX_NUM_OF_DEVICES	(4)
+
+extern I2C_TypeDef i2cSimPeripheral;
+#define I2C2						(&i2cSimPeripheral)
+
+#define CR1							registers[i2cSimAccess(I2CSimRegister_CR1)]
+#define CR2							registers[i2cSimAccess(I2CSimRegister_CR2)]
+#define DR							registers[i2cSimAccess(I2CSimRegister_DR)]
+#define SR1							registers[i2cSimAccess(I2CSimRegister_SR1)]
+#define SR2							registers[i2cSimAccess(I2CSimRegister_SR2)]
+
+/* Reading the cycle counter takes time like everything else on the target */
+#undef DWT
+#define DWT							(i2cSimCycleCounter())
+
+/* Function prototypes -------------------------------------------------------*/
+uint32_t i2cSimAccess(I2CSimRegister Register);
+DWT_Type* i2cSimCycleCounter(void);
+
+void i2cSimInit(void);
+void i2cSimAddDevice(uint8_t Address, uint8_t* pRegisters);
+void i2cSimRun(uint32_t Microseconds);
+bool i2cSimIsIdle(void);
+I2CSimCounters i2cSimGetCounters(void);
+uint32_t i2cSimGetNumOfErrors(void);
+
+/* The interrupt handlers in the driver */
+void I2C2_EV_IRQHandler(void);
+void I2C2_ER_IRQHandler(void);
+
+#endif /* I2C_BUS_SIM_H_ */
@@ -0,0 +1,527 @@
+/**
+ ******************************************************************************
+ * @file	lcd_bus_sim.c
+ * @brief	Model of the RA8875 on the FSMC bus for the host tests.
+ *
+ *			Register writes with side effects are carried out at once:
+ *			memory clears, squares, lines, text in the active window, BTE
+ *			writes from the MCU and BTE moves with ROP = S. Everything
+ *			else is only stored. Like on the RA8875 all drawing except the
+ *			full screen memory clear is limited to the active window. The
+ *			status register reports busy for the modelled time of the last
+ *			operation.
+ *
+ *			There is only one task on the host so the semaphores run the
+ *			WAIT and DMA interrupts the task would sleep through. The
+ *			driver keeps DMA addresses in 32 bits like on the target, the
+ *			upper half of the host address is taken from the static data
+ *			of the program so the DMA source must not be on the heap.
+ *
+ *			The cycle counter is advanced by the modelled bus and LCD time
+ *			only, the CPU time of the driver is not included.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "lcd_bus_sim.h"
+#include "lcd_ra8875_registers.h"
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task.h"
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define LCD_RAM_ADDRESS				(0x60000000)
+
+/* Modelled cost in core clock cycles, the FSMC timing is address setup 4 and data setup 3 */
+#define BUS_WRITE_CYCLES			(9)
+#define BUS_READ_CYCLES				(9)
+/* The DMA writes use the stretched data phase, LCD_DMA_DATA_SETUP_TIME in the driver */
+#define BUS_DMA_WRITE_CYCLES		(18)
+/* Time the LCD is busy after a command, per pixel for fills, draws and moves */
+#define LCD_FILL_CYCLES_PER_PIXEL	(2)
+#define LCD_MOVE_CYCLES_PER_PIXEL	(4)
+#define LCD_CHARACTER_CYCLES		(200)
+
+#define STATUS_MEMORY_BUSY			(0x80)
+#define STATUS_BTE_BUSY				(0x40)
+
+#define MAX_NUM_OF_SEMAPHORES		(16)
+
+/* Things the driver does that the LCD or the MCU would not handle, counted and checked by the tests */
+#define SIM_CHECK(CONDITION, ...)											\
+	do {																	\
+		if (!(CONDITION))													\
+		{																	\
+			prvNumOfErrors++;												\
+			printf("%s:%d: FAIL: ", __FILE__, __LINE__);					\
+			printf(__VA_ARGS__);											\
+			printf("\n");													\
+		}																	\
+	} while (0)
+
+/* Private variables ---------------------------------------------------------*/
+uint32_t SystemCoreClock = 168000000;
+
+static struct
+{
+	uint8_t regs[256];
+	uint8_t currentRegister;
+	uint16_t frameBuffer[LCD_SIM_HEIGHT][LCD_SIM_WIDTH];
+
+	uint64_t time;				/* Modelled time in cycles */
+	uint64_t busyUntil;			/* Memory busy until this time */
+	uint64_t bteBusyUntil;
+
+	/* Set while the whole screen is cleared, the active window doesn't limit it */
+	bool windowIsIgnored;
+
+	/* BTE write in progress */
+	bool bteWriteActive;
+	uint32_t bteWriteIndex;
+
+	LCDSimCounters bus;
+} prvLcd;
+
+static int prvSemaphores[MAX_NUM_OF_SEMAPHORES];
+static uint32_t prvNumOfSemaphores = 0;
+
+/* The DMA transfer the driver started and that has not been run yet */
+static struct
+{
+	DMA_HandleTypeDef* handle;
+	const uint16_t* pSource;
+	uint32_t length;
+} prvDMA;
+
+static uint32_t prvNumOfErrors = 0;
+
+/* Called for the WAIT interrupt, the drivers have different names for it */
+static void (*prvWaitCallback)(void) = 0;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief	16 bit register pair of the model
+ */
+static uint32_t prvReg16(uint8_t Low)
+{
+	return prvLcd.regs[Low] | ((prvLcd.regs[Low + 1] & 0x03) << 8);
+}
+
+static uint16_t prvColor(uint8_t Register)
+{
+	return ((prvLcd.regs[Register] & 0x1F) << 11) | ((prvLcd.regs[Register + 1] & 0x3F) << 5) |
+			(prvLcd.regs[Register + 2] & 0x1F);
+}
+
+static void prvSetPixel(uint32_t X, uint32_t Y, uint16_t Color)
+{
+	bool isInWindow = (X >= prvReg16(LCD_HSAW0) && X <= prvReg16(LCD_HEAW0) &&
+					   Y >= prvReg16(LCD_VSAW0) && Y <= prvReg16(LCD_VEAW0));
+	if (X < LCD_SIM_WIDTH && Y < LCD_SIM_HEIGHT && (isInWindow || prvLcd.windowIsIgnored))
+	{
+		prvLcd.frameBuffer[Y][X] = Color;
+		prvLcd.bus.pixelWrites++;
+	}
+}
+
+static void prvFillRectangle(uint32_t XLeft, uint32_t XRight, uint32_t YTop, uint32_t YBottom, uint16_t Color)
+{
+	for (uint32_t y = YTop; y <= YBottom; y++)
+	{
+		for (uint32_t x = XLeft; x <= XRight; x++)
+			prvSetPixel(x, y, Color);
+	}
+	prvLcd.busyUntil = prvLcd.time + (uint64_t)(XRight - XLeft + 1) * (YBottom - YTop + 1) * LCD_FILL_CYCLES_PER_PIXEL;
+}
+
+/**
+ * @brief	Memory clear with the background color
+ */
+static void prvMemoryClear(uint8_t Value)
+{
+	if (!(Value & 0x80))
+		return;
+	if (Value & 0x40)
+		prvFillRectangle(prvReg16(LCD_HSAW0), prvReg16(LCD_HEAW0), prvReg16(LCD_VSAW0), prvReg16(LCD_VEAW0),
+						 prvColor(LCD_BGCR0));
+	else
+	{
+		prvLcd.windowIsIgnored = true;
+		prvFillRectangle(0, LCD_SIM_WIDTH - 1, 0, LCD_SIM_HEIGHT - 1, prvColor(LCD_BGCR0));
+		prvLcd.windowIsIgnored = false;
+	}
+}
+
+/**
+ * @brief	Square and line drawing with the foreground color
+ */
+static void prvDraw(uint8_t Value)
+{
+	if (!(Value & 0x80) || (Value & 0x40))
+		return;		/* Circles are only counted */
+
+	uint32_t xStart = prvReg16(LCD_DLHSR0), xEnd = prvReg16(LCD_DLHER0);
+	uint32_t yStart = prvReg16(LCD_DLVSR0), yEnd = prvReg16(LCD_DLVER0);
+	uint16_t color = prvColor(LCD_FGCR0);
+	if ((Value & 0x30) == 0x30)
+		prvFillRectangle(xStart, xEnd, yStart, yEnd, color);
+	else if (Value & 0x10)
+	{
+		prvFillRectangle(xStart, xEnd, yStart, yStart, color);
+		prvFillRectangle(xStart, xEnd, yEnd, yEnd, color);
+		prvFillRectangle(xStart, xStart, yStart, yEnd, color);
+		prvFillRectangle(xEnd, xEnd, yStart, yEnd, color);
+	}
+	else
+	{
+		/* Only the straight lines the GUI uses are drawn exactly */
+		uint32_t steps = abs((int)xEnd - (int)xStart) > abs((int)yEnd - (int)yStart) ?
+						 abs((int)xEnd - (int)xStart) : abs((int)yEnd - (int)yStart);
+		for (uint32_t i = 0; i <= steps; i++)
+		{
+			int x = xStart + (steps ? ((int)xEnd - (int)xStart) * (int)i / (int)steps : 0);
+			int y = yStart + (steps ? ((int)yEnd - (int)yStart) * (int)i / (int)steps : 0);
+			prvSetPixel(x, y, color);
+		}
+		prvLcd.busyUntil = prvLcd.time + (steps + 1) * LCD_FILL_CYCLES_PER_PIXEL;
+	}
+}
+
+/**
+ * @brief	Start of a BTE operation, only the MCU write and the move with ROP = S are modelled
+ */
+static void prvStartBTE(uint8_t Value)
+{
+	if (!(Value & 0x80))
+	{
+		prvLcd.bteWriteActive = false;
+		return;
+	}
+
+	uint8_t operation = prvLcd.regs[LCD_BECR1] & 0x0F;
+	uint32_t width = prvReg16(LCD_BEWR0), height = prvReg16(LCD_BEHR0);
+	if (operation == 0x00)
+	{
+		prvLcd.bteWriteActive = true;
+		prvLcd.bteWriteIndex = 0;
+	}
+	else if (operation == 0x02)
+	{
+		uint32_t sourceX = prvReg16(LCD_HSBE0), sourceY = prvReg16(LCD_VSBE0);
+		uint32_t destinationX = prvReg16(LCD_HDBE0), destinationY = prvReg16(LCD_VDBE0);
+		SIM_CHECK((prvLcd.regs[LCD_BECR1] & 0xF0) == 0xC0, "BTE move with ROP 0x%X, expected S", prvLcd.regs[LCD_BECR1] >> 4);
+		for (uint32_t y = 0; y < height; y++)
+		{
+			for (uint32_t x = 0; x < width; x++)
+			{
+				if (sourceX + x < LCD_SIM_WIDTH && sourceY + y < LCD_SIM_HEIGHT)
+					prvSetPixel(destinationX + x, destinationY + y, prvLcd.frameBuffer[sourceY + y][sourceX + x]);
+			}
+		}
+		prvLcd.bteBusyUntil = prvLcd.time + (uint64_t)width * height * LCD_MOVE_CYCLES_PER_PIXEL;
+	}
+	else
+		SIM_CHECK(false, "BTE operation 0x%X is not modelled", operation);
+}
+
+/**
+ * @brief	One character in text mode, a filled cell for everything except space
+ */
+static void prvWriteCharacter(uint16_t Character)
+{
+	uint32_t width = 8 * (((prvLcd.regs[LCD_FNCR1] >> 2) & 0x03) + 1);
+	uint32_t height = 16 * ((prvLcd.regs[LCD_FNCR1] & 0x03) + 1);
+	uint32_t x = prvReg16(LCD_F_CURXL), y = prvReg16(LCD_F_CURYL);
+
+	/* The LCD continues on the next row at the edge of the active window */
+	if (x + width > prvReg16(LCD_HEAW0) + 1)
+	{
+		x = prvReg16(LCD_HSAW0);
+		y += height;
+	}
+
+	bool transparent = (prvLcd.regs[LCD_FNCR1] & 0x40) != 0;
+	if (Character != ' ' || !transparent)
+	{
+		uint16_t color = (Character != ' ') ? prvColor(LCD_FGCR0) : prvColor(LCD_BGCR0);
+		for (uint32_t row = 0; row < height; row++)
+		{
+			for (uint32_t column = 0; column < width; column++)
+				prvSetPixel(x + column, y + row, color);
+		}
+	}
+
+	x += width;
+	prvLcd.regs[LCD_F_CURXL] = x;
+	prvLcd.regs[LCD_F_CURXH] = x >> 8;
+	prvLcd.regs[LCD_F_CURYL] = y;
+	prvLcd.regs[LCD_F_CURYH] = y >> 8;
+	prvLcd.busyUntil = prvLcd.time + LCD_CHARACTER_CYCLES;
+}
+
+/**
+ * @brief	Data write to MRWC from the CPU or the DMA
+ */
+static void prvWriteMemory(uint16_t Value)
+{
+	if (prvLcd.bteWriteActive)
+	{
+		uint32_t width = prvReg16(LCD_BEWR0), height = prvReg16(LCD_BEHR0);
+		uint32_t index = prvLcd.bteWriteIndex++;
+		prvSetPixel(prvReg16(LCD_HDBE0) + index % width, prvReg16(LCD_VDBE0) + index / width, Value);
+		if (prvLcd.bteWriteIndex == width * height)
+			prvLcd.bteWriteActive = false;
+	}
+	else if (prvLcd.regs[LCD_MWCR0] & 0x80)
+		prvWriteCharacter(Value);
+	else
+	{
+		uint32_t x = prvReg16(LCD_CURH0), y = prvReg16(LCD_CURV0);
+		prvSetPixel(x, y, Value);
+		if (++x > prvReg16(LCD_HEAW0))
+		{
+			x = prvReg16(LCD_HSAW0);
+			y++;
+		}
+		prvLcd.regs[LCD_CURH0] = x;
+		prvLcd.regs[LCD_CURH1] = x >> 8;
+		prvLcd.regs[LCD_CURV0] = y;
+		prvLcd.regs[LCD_CURV1] = y >> 8;
+	}
+}
+
+/**
+ * @brief	Advance the modelled time and the DWT cycle counter the benchmark reads
+ */
+static void prvElapse(uint32_t Cycles)
+{
+	prvLcd.time += Cycles;
+	prvLcd.bus.cycles += Cycles;
+	DWT->CYCCNT += Cycles;
+}
+
+/**
+ * @brief	Run the interrupt that would happen next while the task sleeps
+ * @retval	false if nothing is pending
+ */
+static bool prvRunPendingInterrupt()
+{
+	if (EXTI->SWIER & GPIO_PIN_11)
+	{
+		EXTI->SWIER &= ~GPIO_PIN_11;
+		prvLcd.bus.interrupts++;
+		prvWaitCallback();
+		return true;
+	}
+	if (prvDMA.length != 0)
+	{
+		for (uint32_t i = 0; i < prvDMA.length; i++)
+		{
+			prvElapse(BUS_DMA_WRITE_CYCLES);
+			prvLcd.bus.dmaWrites++;
+			prvWriteMemory(prvDMA.pSource[i]);
+		}
+		prvDMA.length = 0;
+		prvLcd.bus.interrupts++;
+		prvDMA.handle->XferCpltCallback(prvDMA.handle);
+		return true;
+	}
+	return false;
+}
+
+/* Functions -----------------------------------------------------------------*/
+/**
+ * @brief	Start the model with WAIT high, call before LCD_Init
+ * @param	WaitCallback: The function the driver handles the WAIT interrupt in
+ * @retval	None
+ */
+void lcdSimInit(void (*WaitCallback)(void))
+{
+	prvWaitCallback = WaitCallback;
+	GPIOD->IDR |= GPIO_PIN_11;
+}
+
+/**
+ * @brief	Get the counters since the start
+ * @param	None
+ * @retval	The counters
+ */
+LCDSimCounters lcdSimGetCounters(void)
+{
+	return prvLcd.bus;
+}
+
+/**
+ * @brief	Get what happened between two calls to lcdSimGetCounters
+ * @param	pNow: The later counters
+ * @param	pBefore: The earlier counters
+ * @retval	The difference
+ */
+LCDSimCounters lcdSimDifference(const LCDSimCounters* pNow, const LCDSimCounters* pBefore)
+{
+	LCDSimCounters difference = {
+		pNow->commandWrites - pBefore->commandWrites,
+		pNow->registerWrites - pBefore->registerWrites,
+		pNow->memoryWrites - pBefore->memoryWrites,
+		pNow->dmaWrites - pBefore->dmaWrites,
+		pNow->statusReads - pBefore->statusReads,
+		pNow->dataReads - pBefore->dataReads,
+		pNow->interrupts - pBefore->interrupts,
+		pNow->pixelWrites - pBefore->pixelWrites,
+		pNow->cycles - pBefore->cycles,
+	};
+	return difference;
+}
+
+/**
+ * @brief	Get the number of errors the model found
+ * @param	None
+ * @retval	The number of errors
+ */
+uint32_t lcdSimGetNumOfErrors(void)
+{
+	return prvNumOfErrors;
+}
+
+/**
+ * @brief	Get the frame buffer of the model
+ * @param	None
+ * @retval	The frame buffer, indexed [y][x]
+ */
+uint16_t (*lcdSimGetFrameBuffer(void))[LCD_SIM_WIDTH]
+{
+	return prvLcd.frameBuffer;
+}
+
+/* Bus -----------------------------------------------------------------------*/
+void lcdSimWriteRegister(uint16_t Value)
+{
+	prvElapse(BUS_WRITE_CYCLES);
+	prvLcd.bus.commandWrites++;
+	prvLcd.currentRegister = Value;
+}
+
+void lcdSimWriteData(uint16_t Value)
+{
+	prvElapse(BUS_WRITE_CYCLES);
+	if (prvLcd.currentRegister == LCD_MRWC)
+	{
+		prvLcd.bus.memoryWrites++;
+		prvWriteMemory(Value);
+		return;
+	}
+
+	prvLcd.bus.registerWrites++;
+	prvLcd.regs[prvLcd.currentRegister] = Value;
+	if (prvLcd.currentRegister == LCD_MCLR)
+		prvMemoryClear(Value);
+	else if (prvLcd.currentRegister == LCD_DCR)
+		prvDraw(Value);
+	else if (prvLcd.currentRegister == LCD_BECR0)
+		prvStartBTE(Value);
+}
+
+uint16_t lcdSimReadStatus(void)
+{
+	prvElapse(BUS_READ_CYCLES);
+	prvLcd.bus.statusReads++;
+	uint16_t status = 0;
+	if (prvLcd.time < prvLcd.busyUntil)
+		status |= STATUS_MEMORY_BUSY;
+	if (prvLcd.bteWriteActive || prvLcd.time < prvLcd.bteBusyUntil)
+		status |= STATUS_BTE_BUSY;
+	return status;
+}
+
+uint16_t lcdSimReadData(void)
+{
+	prvElapse(BUS_READ_CYCLES);
+	prvLcd.bus.dataReads++;
+	return prvLcd.regs[prvLcd.currentRegister];
+}
+
+/* FreeRTOS ------------------------------------------------------------------*/
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+	prvSemaphores[prvNumOfSemaphores] = 0;
+	return &prvSemaphores[prvNumOfSemaphores++];
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+	prvSemaphores[prvNumOfSemaphores] = 1;
+	return &prvSemaphores[prvNumOfSemaphores++];
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t Semaphore)
+{
+	int* pCount = Semaphore;
+	if (*pCount != 0)
+		return pdFALSE;
+	*pCount = 1;
+	return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t Semaphore, BaseType_t* pHigherPriorityTaskWoken)
+{
+	return xSemaphoreGive(Semaphore);
+}
+
+/**
+ * @brief	There is only one task so the interrupts it would sleep through are run here
+ */
+BaseType_t xSemaphoreTake(SemaphoreHandle_t Semaphore, TickType_t BlockTime)
+{
+	int* pCount = Semaphore;
+	while (*pCount == 0)
+	{
+		if (!prvRunPendingInterrupt())
+		{
+			SIM_CHECK(BlockTime != portMAX_DELAY, "waiting forever on a semaphore nothing will give");
+			return pdFALSE;
+		}
+	}
+	*pCount = 0;
+	return pdTRUE;
+}
+
+void vTaskDelay(TickType_t TicksToDelay)
+{
+	prvElapse(TicksToDelay * (SystemCoreClock / configTICK_RATE_HZ));
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+	return prvLcd.time / (SystemCoreClock / configTICK_RATE_HZ);
+}
+
+/* HAL -----------------------------------------------------------------------*/
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef* hdma)
+{
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef* hdma, uint32_t SrcAddress, uint32_t DstAddress, uint32_t DataLength)
+{
+	SIM_CHECK(DstAddress == LCD_RAM_ADDRESS, "DMA to 0x%08X instead of the LCD data address", DstAddress);
+	SIM_CHECK(prvDMA.length == 0, "DMA started while a transfer is running");
+	prvDMA.handle = hdma;
+	prvDMA.pSource = (const uint16_t*)(((uintptr_t)&prvLcd & ~(uintptr_t)0xFFFFFFFF) | SrcAddress);
+	prvDMA.length = DataLength;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef* hdma)
+{
+	prvDMA.length = 0;
+	return HAL_OK;
+}
+
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef* hdma)
+{
+}
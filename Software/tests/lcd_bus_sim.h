@@ -0,0 +1,57 @@
+/**
+ ******************************************************************************
+ * @file	lcd_bus_sim.h
+ * @brief	Model of the RA8875 on the FSMC bus for the host tests.
+ *
+ *			Included before the LCD driver with -include so its bus macros
+ *			call the model instead of dereferencing the FSMC addresses.
+ *			The model keeps the registers and a frame buffer and counts
+ *			every bus transaction and every pixel the LCD writes. It also
+ *			provides the semaphores, the DMA and the WAIT interrupt the
+ *			driver uses, see lcd_bus_sim.c.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef LCD_BUS_SIM_H_
+#define LCD_BUS_SIM_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Defines -------------------------------------------------------------------*/
+#define LCD_BUS_WRITE_REG(VALUE)	(lcdSimWriteRegister(VALUE))
+#define LCD_BUS_WRITE_RAM(VALUE)	(lcdSimWriteData(VALUE))
+#define LCD_BUS_READ_REG()			(lcdSimReadStatus())
+#define LCD_BUS_READ_RAM()			(lcdSimReadData())
+
+#define LCD_SIM_WIDTH				(800)
+#define LCD_SIM_HEIGHT				(480)
+
+/* Typedefs ------------------------------------------------------------------*/
+typedef struct
+{
+	uint64_t commandWrites;		/* Writes to the register address */
+	uint64_t registerWrites;	/* Writes to the data address of a register other than MRWC */
+	uint64_t memoryWrites;		/* Pixels or characters written through MRWC by the CPU */
+	uint64_t dmaWrites;			/* Pixels written through MRWC by the DMA */
+	uint64_t statusReads;
+	uint64_t dataReads;
+	uint64_t interrupts;		/* WAIT and DMA interrupts */
+	uint64_t pixelWrites;		/* Pixels the LCD wrote in its frame buffer for clears, drawing, text and BTE */
+	uint64_t cycles;			/* Modelled bus and LCD time */
+} LCDSimCounters;
+
+/* Function prototypes -------------------------------------------------------*/
+void lcdSimWriteRegister(uint16_t Value);
+void lcdSimWriteData(uint16_t Value);
+uint16_t lcdSimReadStatus(void);
+uint16_t lcdSimReadData(void);
+
+void lcdSimInit(void (*WaitCallback)(void));
+LCDSimCounters lcdSimGetCounters(void);
+LCDSimCounters lcdSimDifference(const LCDSimCounters* pNow, const LCDSimCounters* pBefore);
+uint32_t lcdSimGetNumOfErrors(void);
+uint16_t (*lcdSimGetFrameBuffer(void))[LCD_SIM_WIDTH];
+
+#endif /* LCD_BUS_SIM_H_ */
@@ -0,0 +1,48 @@
+/**
+ ******************************************************************************
+ * @file	FreeRTOS.h
+ * @brief	Host replacement for the FreeRTOS headers used by the host tests.
+ *
+ *			Only the types and constants the hardware independent modules
+ *			use. The few kernel functions a test needs are declared in
+ *			task.h and semphr.h and defined by the test itself.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Defines -------------------------------------------------------------------*/
+#define pdFALSE					((BaseType_t)0)
+#define pdTRUE					((BaseType_t)1)
+#define pdPASS					(pdTRUE)
+#define pdFAIL					(pdFALSE)
+#define portMAX_DELAY			((TickType_t)0xFFFFFFFFUL)
+#define configTICK_RATE_HZ		((TickType_t)1000)
+#define portTICK_PERIOD_MS		((TickType_t)1000 / configTICK_RATE_HZ)
+#define configLIBRARY_LOWEST_INTERRUPT_PRIORITY			(15)
+#define configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY	(5)
+
+/* The tests run everything in one thread, see task.h */
+#define portSET_INTERRUPT_MASK_FROM_ISR()		(0)
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(X)	((void)(X))
+
+/* Typedefs ------------------------------------------------------------------*/
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+typedef void* QueueHandle_t;
+typedef void* SemaphoreHandle_t;
+typedef void* TaskHandle_t;
+typedef void* TimerHandle_t;
+
+/* Function prototypes -------------------------------------------------------*/
+void* pvPortMalloc(size_t Size);
+
+#endif /* INC_FREERTOS_H */
@@ -0,0 +1,20 @@
+/**
+ ******************************************************************************
+ * @file	queue.h
+ * @brief	Host replacement for the FreeRTOS queue API, see FreeRTOS.h.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef QUEUE_H
+#define QUEUE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+
+/* Function prototypes -------------------------------------------------------*/
+BaseType_t xQueueSendToBack(QueueHandle_t Queue, const void* pItem, TickType_t BlockTime);
+BaseType_t xQueueSendToBackFromISR(QueueHandle_t Queue, const void* pItem, BaseType_t* pHigherPriorityTaskWoken);
+BaseType_t xQueueReceive(QueueHandle_t Queue, void* pItem, TickType_t BlockTime);
+
+#endif /* QUEUE_H */
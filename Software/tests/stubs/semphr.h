@@ -0,0 +1,22 @@
+/**
+ ******************************************************************************
+ * @file	semphr.h
+ * @brief	Host replacement for the FreeRTOS semaphore API, see FreeRTOS.h.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef SEMAPHORE_H
+#define SEMAPHORE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+
+/* Function prototypes -------------------------------------------------------*/
+BaseType_t xSemaphoreTake(SemaphoreHandle_t Semaphore, TickType_t BlockTime);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t Semaphore);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t Semaphore, BaseType_t* pHigherPriorityTaskWoken);
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+
+#endif /* SEMAPHORE_H */
@@ -0,0 +1,419 @@
+/**
+ ******************************************************************************
+ * @file	stm32f4xx_hal.h
+ * @brief	Host replacement for the HAL header used by the host tests.
+ *
+ *			Only the types and Cortex-M4 intrinsics that the hardware
+ *			independent modules use are provided, implemented in plain C
+ *			with the same results as the instructions. The DMA, FSMC and
+ *			UART parts are what the LCD driver of the lcd-test project
+ *			needs, the tests that use them define the functions. The I2C
+ *			registers are defined by the bus model in i2c_bus_sim.h.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32F4xx_HAL_H_
+#define STM32F4xx_HAL_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Typedefs ------------------------------------------------------------------*/
+#define __IO	volatile
+
+typedef enum {RESET = 0, SET = !RESET} FlagStatus, ITStatus;
+typedef enum {DISABLE = 0, ENABLE = !DISABLE} FunctionalState;
+typedef enum {SUCCESS = 0, ERROR = !SUCCESS} ErrorStatus;
+
+typedef enum
+{
+	HAL_OK       = 0x00,
+	HAL_ERROR    = 0x01,
+	HAL_BUSY     = 0x02,
+	HAL_TIMEOUT  = 0x03
+} HAL_StatusTypeDef;
+
+/* Peripheral constants --------------------------------------------------------*/
+/* Used as enum values in the channel settings, same values as in the HAL */
+#define CAN_SJW_1TQ			((uint32_t)0x00000000)
+#define CAN_BS1_11TQ		((uint32_t)0x000A0000)
+#define CAN_BS2_2TQ			((uint32_t)0x00100000)
+#define CAN_ID_STD			((uint32_t)0x00000000)
+#define CAN_ID_EXT			((uint32_t)0x00000004)
+
+#define UART_PARITY_NONE	((uint32_t)0x00000000)
+#define UART_PARITY_EVEN	((uint32_t)0x00000400)
+#define UART_PARITY_ODD		((uint32_t)0x00000600)
+#define UART_MODE_RX		((uint32_t)0x00000004)
+#define UART_MODE_TX		((uint32_t)0x00000008)
+#define UART_MODE_TX_RX		((uint32_t)0x0000000C)
+
+/* GPIO, NVIC and the cycle counter ---------------------------------------------*/
+/* The instances are weak so that every test and firmware source sees the same registers */
+typedef struct
+{
+	volatile uint32_t IDR;
+	volatile uint32_t ODR;
+} GPIO_TypeDef;
+
+typedef struct
+{
+	uint32_t Pin;
+	uint32_t Mode;
+	uint32_t Pull;
+	uint32_t Speed;
+	uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+typedef enum {GPIO_PIN_RESET = 0, GPIO_PIN_SET} GPIO_PinState;
+
+typedef struct
+{
+	volatile uint32_t CTRL;
+	volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+	volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+typedef enum
+{
+	EXTI9_5_IRQn	= 23,
+	I2C2_EV_IRQn	= 33,
+	I2C2_ER_IRQn	= 34,
+	EXTI15_10_IRQn	= 40,
+	DMA2_Stream0_IRQn	= 56,
+} IRQn_Type;
+
+GPIO_TypeDef prvHostGPIO[5] __attribute__((weak));
+DWT_Type prvHostDWT __attribute__((weak));
+CoreDebug_Type prvHostCoreDebug __attribute__((weak));
+
+#define GPIOA					(&prvHostGPIO[0])
+#define GPIOB					(&prvHostGPIO[1])
+#define GPIOC					(&prvHostGPIO[2])
+#define GPIOD					(&prvHostGPIO[3])
+#define GPIOE					(&prvHostGPIO[4])
+#define DWT						(&prvHostDWT)
+#define CoreDebug				(&prvHostCoreDebug)
+
+#define GPIO_PIN_0				((uint16_t)0x0001)
+#define GPIO_PIN_1				((uint16_t)0x0002)
+#define GPIO_PIN_2				((uint16_t)0x0004)
+#define GPIO_PIN_3				((uint16_t)0x0008)
+#define GPIO_PIN_4				((uint16_t)0x0010)
+#define GPIO_PIN_5				((uint16_t)0x0020)
+#define GPIO_PIN_6				((uint16_t)0x0040)
+#define GPIO_PIN_7				((uint16_t)0x0080)
+#define GPIO_PIN_8				((uint16_t)0x0100)
+#define GPIO_PIN_9				((uint16_t)0x0200)
+#define GPIO_PIN_10				((uint16_t)0x0400)
+#define GPIO_PIN_11				((uint16_t)0x0800)
+#define GPIO_PIN_12				((uint16_t)0x1000)
+#define GPIO_PIN_13				((uint16_t)0x2000)
+#define GPIO_PIN_14				((uint16_t)0x4000)
+#define GPIO_PIN_15				((uint16_t)0x8000)
+
+#define GPIO_MODE_INPUT			((uint32_t)0x00000000)
+#define GPIO_MODE_OUTPUT_PP		((uint32_t)0x00000001)
+#define GPIO_MODE_OUTPUT_OD		((uint32_t)0x00000011)
+#define GPIO_MODE_AF_PP			((uint32_t)0x00000002)
+#define GPIO_MODE_AF_OD			((uint32_t)0x00000012)
+#define GPIO_MODE_IT_RISING		((uint32_t)0x10110000)
+#define GPIO_MODE_IT_FALLING	((uint32_t)0x10210000)
+#define GPIO_NOPULL				((uint32_t)0x00000000)
+#define GPIO_PULLUP				((uint32_t)0x00000001)
+#define GPIO_SPEED_FAST			((uint32_t)0x00000002)
+#define GPIO_SPEED_HIGH			((uint32_t)0x00000002)
+#define GPIO_AF4_I2C2			((uint8_t)0x04)
+#define GPIO_AF7_USART1			((uint8_t)0x07)
+#define GPIO_AF12_FSMC			((uint8_t)0x0C)
+
+#define CoreDebug_DEMCR_TRCENA_Msk	(1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk		(1UL << 0)
+
+#define __GPIOA_CLK_ENABLE()	((void)0)
+#define __GPIOB_CLK_ENABLE()	((void)0)
+#define __GPIOC_CLK_ENABLE()	((void)0)
+#define __GPIOD_CLK_ENABLE()	((void)0)
+#define __GPIOE_CLK_ENABLE()	((void)0)
+
+static inline void HAL_GPIO_Init(GPIO_TypeDef* GPIOx, GPIO_InitTypeDef* GPIO_Init) {}
+
+static inline void HAL_GPIO_WritePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+	if (PinState == GPIO_PIN_SET)
+		GPIOx->ODR |= GPIO_Pin;
+	else
+		GPIOx->ODR &= ~GPIO_Pin;
+}
+
+static inline void HAL_GPIO_TogglePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+	GPIOx->ODR ^= GPIO_Pin;
+}
+
+static inline GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+	return (GPIOx->IDR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+static inline void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority) {}
+static inline void HAL_NVIC_EnableIRQ(IRQn_Type IRQn) {}
+static inline void HAL_NVIC_DisableIRQ(IRQn_Type IRQn) {}
+static inline void HAL_NVIC_ClearPendingIRQ(IRQn_Type IRQn) {}
+
+/* External interrupts -----------------------------------------------------------*/
+typedef struct
+{
+	volatile uint32_t IMR;
+	volatile uint32_t SWIER;
+	volatile uint32_t PR;
+} EXTI_TypeDef;
+
+EXTI_TypeDef prvHostEXTI __attribute__((weak));
+#define EXTI					(&prvHostEXTI)
+
+#define __HAL_GPIO_EXTI_CLEAR_IT(PIN)	(EXTI->PR = (PIN))
+
+/* I2C ---------------------------------------------------------------------------*/
+typedef struct I2C_TypeDef I2C_TypeDef;
+
+typedef struct
+{
+	uint32_t ClockSpeed;
+	uint32_t DutyCycle;
+	uint32_t OwnAddress1;
+	uint32_t AddressingMode;
+	uint32_t DualAddressMode;
+	uint32_t OwnAddress2;
+	uint32_t GeneralCallMode;
+	uint32_t NoStretchMode;
+} I2C_InitTypeDef;
+
+typedef struct
+{
+	I2C_TypeDef* Instance;
+	I2C_InitTypeDef Init;
+} I2C_HandleTypeDef;
+
+#define I2C_DUTYCYCLE_2				((uint32_t)0x00000000)
+#define I2C_ADDRESSINGMODE_7BIT		((uint32_t)0x00004000)
+#define I2C_DUALADDRESS_DISABLED	((uint32_t)0x00000000)
+#define I2C_GENERALCALL_DISABLED	((uint32_t)0x00000000)
+#define I2C_NOSTRETCH_DISABLED		((uint32_t)0x00000000)
+
+#define I2C_CR1_PE					((uint32_t)0x00000001)
+#define I2C_CR1_START				((uint32_t)0x00000100)
+#define I2C_CR1_STOP				((uint32_t)0x00000200)
+#define I2C_CR1_ACK					((uint32_t)0x00000400)
+#define I2C_CR1_POS					((uint32_t)0x00000800)
+#define I2C_CR1_SWRST				((uint32_t)0x00008000)
+#define I2C_CR2_ITERREN				((uint32_t)0x00000100)
+#define I2C_CR2_ITEVTEN				((uint32_t)0x00000200)
+#define I2C_CR2_ITBUFEN				((uint32_t)0x00000400)
+#define I2C_SR1_SB					((uint32_t)0x00000001)
+#define I2C_SR1_ADDR				((uint32_t)0x00000002)
+#define I2C_SR1_BTF					((uint32_t)0x00000004)
+#define I2C_SR1_RXNE				((uint32_t)0x00000040)
+#define I2C_SR1_TXE					((uint32_t)0x00000080)
+#define I2C_SR1_BERR				((uint32_t)0x00000100)
+#define I2C_SR1_ARLO				((uint32_t)0x00000200)
+#define I2C_SR1_AF					((uint32_t)0x00000400)
+#define I2C_SR1_OVR					((uint32_t)0x00000800)
+#define I2C_SR1_TIMEOUT				((uint32_t)0x00004000)
+#define I2C_SR2_MSL					((uint32_t)0x00000001)
+#define I2C_SR2_BUSY				((uint32_t)0x00000002)
+#define I2C_SR2_TRA					((uint32_t)0x00000004)
+
+#define __I2C2_CLK_ENABLE()		((void)0)
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef* hi2c);
+
+/* DMA ---------------------------------------------------------------------------*/
+typedef struct
+{
+	volatile uint32_t CR;
+} DMA_Stream_TypeDef;
+
+typedef struct
+{
+	uint32_t Channel;
+	uint32_t Direction;
+	uint32_t PeriphInc;
+	uint32_t MemInc;
+	uint32_t PeriphDataAlignment;
+	uint32_t MemDataAlignment;
+	uint32_t Mode;
+	uint32_t Priority;
+	uint32_t FIFOMode;
+	uint32_t FIFOThreshold;
+	uint32_t MemBurst;
+	uint32_t PeriphBurst;
+} DMA_InitTypeDef;
+
+typedef struct __DMA_HandleTypeDef
+{
+	DMA_Stream_TypeDef* Instance;
+	DMA_InitTypeDef Init;
+	void (*XferCpltCallback)(struct __DMA_HandleTypeDef* hdma);
+	void (*XferErrorCallback)(struct __DMA_HandleTypeDef* hdma);
+} DMA_HandleTypeDef;
+
+DMA_Stream_TypeDef prvHostDMA2Stream0 __attribute__((weak));
+#define DMA2_Stream0			(&prvHostDMA2Stream0)
+
+#define DMA_CHANNEL_0			((uint32_t)0x00000000)
+#define DMA_MEMORY_TO_MEMORY	((uint32_t)0x00000080)
+#define DMA_PINC_ENABLE			((uint32_t)0x00000200)
+#define DMA_MINC_DISABLE		((uint32_t)0x00000000)
+#define DMA_PDATAALIGN_HALFWORD	((uint32_t)0x00000800)
+#define DMA_MDATAALIGN_HALFWORD	((uint32_t)0x00002000)
+#define DMA_NORMAL				((uint32_t)0x00000000)
+#define DMA_PRIORITY_MEDIUM		((uint32_t)0x00010000)
+#define DMA_FIFOMODE_ENABLE		((uint32_t)0x00000004)
+#define DMA_FIFO_THRESHOLD_FULL	((uint32_t)0x00000003)
+#define DMA_MBURST_SINGLE		((uint32_t)0x00000000)
+#define DMA_PBURST_SINGLE		((uint32_t)0x00000000)
+
+#define __DMA2_CLK_ENABLE()		((void)0)
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef* hdma);
+HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef* hdma, uint32_t SrcAddress, uint32_t DstAddress, uint32_t DataLength);
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef* hdma);
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef* hdma);
+
+/* FSMC --------------------------------------------------------------------------*/
+typedef struct
+{
+	volatile uint32_t BTCR[8];
+} FSMC_Bank1_TypeDef;
+
+typedef struct
+{
+	uint32_t NSBank;
+	uint32_t DataAddressMux;
+	uint32_t MemoryType;
+	uint32_t MemoryDataWidth;
+	uint32_t BurstAccessMode;
+	uint32_t WaitSignalPolarity;
+	uint32_t WrapMode;
+	uint32_t WaitSignalActive;
+	uint32_t WriteOperation;
+	uint32_t WaitSignal;
+	uint32_t ExtendedMode;
+	uint32_t AsynchronousWait;
+	uint32_t WriteBurst;
+} FSMC_NORSRAM_InitTypeDef;
+
+typedef struct
+{
+	uint32_t AddressSetupTime;
+	uint32_t AddressHoldTime;
+	uint32_t DataSetupTime;
+	uint32_t BusTurnAroundDuration;
+	uint32_t CLKDivision;
+	uint32_t DataLatency;
+	uint32_t AccessMode;
+} FSMC_NORSRAM_TimingTypeDef;
+
+FSMC_Bank1_TypeDef prvHostFSMCBank1 __attribute__((weak));
+#define FSMC_Bank1						(&prvHostFSMCBank1)
+#define FSMC_NORSRAM_DEVICE				(FSMC_Bank1)
+
+#define FSMC_BTR1_DATAST				((uint32_t)0x0000FF00)
+#define FSMC_NORSRAM_BANK1				((uint32_t)0x00000000)
+#define FSMC_DATA_ADDRESS_MUX_DISABLE	((uint32_t)0x00000000)
+#define FSMC_MEMORY_TYPE_SRAM			((uint32_t)0x00000000)
+#define FSMC_NORSRAM_MEM_BUS_WIDTH_16	((uint32_t)0x00000010)
+#define FSMC_BURST_ACCESS_MODE_DISABLE	((uint32_t)0x00000000)
+#define FSMC_WAIT_SIGNAL_POLARITY_LOW	((uint32_t)0x00000000)
+#define FSMC_WRAP_MODE_DISABLE			((uint32_t)0x00000000)
+#define FSMC_WAIT_TIMING_BEFORE_WS		((uint32_t)0x00000000)
+#define FSMC_WRITE_OPERATION_ENABLE		((uint32_t)0x00001000)
+#define FSMC_WAIT_SIGNAL_DISABLE		((uint32_t)0x00000000)
+#define FSMC_EXTENDED_MODE_DISABLE		((uint32_t)0x00000000)
+#define FSMC_ASYNCHRONOUS_WAIT_DISABLE	((uint32_t)0x00000000)
+#define FSMC_WRITE_BURST_DISABLE		((uint32_t)0x00000000)
+#define FSMC_ACCESS_MODE_B				((uint32_t)0x10000000)
+
+#define __FSMC_CLK_ENABLE()		((void)0)
+
+static inline HAL_StatusTypeDef FSMC_NORSRAM_Init(FSMC_Bank1_TypeDef* Device, FSMC_NORSRAM_InitTypeDef* Init) { return HAL_OK; }
+static inline HAL_StatusTypeDef FSMC_NORSRAM_Timing_Init(FSMC_Bank1_TypeDef* Device, FSMC_NORSRAM_TimingTypeDef* Timing, uint32_t Bank) { return HAL_OK; }
+static inline void FSMC_NORSRAMCmd(uint32_t Bank, FunctionalState NewState) {}
+
+/* UART --------------------------------------------------------------------------*/
+typedef struct
+{
+	uint32_t BaudRate;
+	uint32_t WordLength;
+	uint32_t StopBits;
+	uint32_t Parity;
+	uint32_t Mode;
+	uint32_t HwFlowCtl;
+	uint32_t OverSampling;
+} UART_InitTypeDef;
+
+typedef struct
+{
+	void* Instance;
+	UART_InitTypeDef Init;
+} UART_HandleTypeDef;
+
+#define USART1					((void*)&prvHostGPIO[0])
+#define UART_WORDLENGTH_8B		((uint32_t)0x00000000)
+#define UART_STOPBITS_1			((uint32_t)0x00000000)
+#define UART_HWCONTROL_NONE		((uint32_t)0x00000000)
+#define UART_OVERSAMPLING_16	((uint32_t)0x00000000)
+
+#define __USART1_CLK_ENABLE()	((void)0)
+
+static inline HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef* huart) { return HAL_OK; }
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef* huart, uint8_t* pData, uint16_t Size, uint32_t Timeout);
+
+extern uint32_t SystemCoreClock;
+
+/* Intrinsics ----------------------------------------------------------------*/
+/* Dual 16-bit signed multiply with a 32-bit accumulate */
+static inline uint32_t __SMLAD(uint32_t X, uint32_t Y, uint32_t Accumulator)
+{
+	int32_t low = (int32_t)(int16_t)X * (int16_t)Y;
+	int32_t high = (int32_t)(int16_t)(X >> 16) * (int16_t)(Y >> 16);
+	return Accumulator + (uint32_t)low + (uint32_t)high;
+}
+
+/* Signed saturation to Bits bits */
+static inline int32_t prvHostSSAT(int32_t Value, uint32_t Bits)
+{
+	int32_t max = (int32_t)((1UL << (Bits - 1)) - 1);
+	int32_t min = -max - 1;
+	return Value > max ? max : (Value < min ? min : Value);
+}
+#define __SSAT(VALUE, BITS)		prvHostSSAT((VALUE), (BITS))
+
+/* Reverse the bit order */
+static inline uint32_t __RBIT(uint32_t Value)
+{
+	uint32_t result = 0;
+	for (uint32_t i = 0; i < 32; i++)
+	{
+		result = (result << 1) | (Value & 1);
+		Value >>= 1;
+	}
+	return result;
+}
+
+/* Count leading zeros, 32 for 0 like the instruction */
+#define __CLZ(VALUE)			((uint8_t)((VALUE) == 0 ? 32 : __builtin_clz(VALUE)))
+
+#define __DSB()
+#define __DMB()
+#define __ISB()
+
+#endif /* STM32F4xx_HAL_H_ */
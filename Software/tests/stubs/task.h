@@ -0,0 +1,26 @@
+/**
+ ******************************************************************************
+ * @file	task.h
+ * @brief	Host replacement for the FreeRTOS task API, see FreeRTOS.h.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_TASK_H
+#define INC_TASK_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+
+/* Defines -------------------------------------------------------------------*/
+/* The tests run everything in one thread */
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+#define taskENTER_CRITICAL_FROM_ISR()		(0)
+#define taskEXIT_CRITICAL_FROM_ISR(X)		((void)(X))
+
+/* Function prototypes -------------------------------------------------------*/
+TickType_t xTaskGetTickCount(void);
+void vTaskDelay(TickType_t TicksToDelay);
+
+#endif /* INC_TASK_H */
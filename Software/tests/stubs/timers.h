@@ -0,0 +1,23 @@
+/**
+ ******************************************************************************
+ * @file	timers.h
+ * @brief	Host replacement for the FreeRTOS timer API, see FreeRTOS.h.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TIMERS_H
+#define TIMERS_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Typedefs ------------------------------------------------------------------*/
+typedef void (*PendedFunction_t)(void* pvParameter1, uint32_t ulParameter2);
+
+/* Function prototypes -------------------------------------------------------*/
+BaseType_t xTimerPendFunctionCallFromISR(PendedFunction_t FunctionToPend, void* pvParameter1, uint32_t ulParameter2,
+										 BaseType_t* pHigherPriorityTaskWoken);
+
+#endif /* TIMERS_H */
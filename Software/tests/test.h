@@ -0,0 +1,72 @@
+/**
+ ******************************************************************************
+ * @file	test.h
+ * @brief	Minimal checks shared by the host tests.
+ *
+ *			Every test is one program, a failed check prints where it
+ *			failed and the program exits with 1 at the end.
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TEST_H_
+#define TEST_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+/* Private variables ---------------------------------------------------------*/
+static int prvTestNumOfChecks __attribute__((unused)) = 0;
+static int prvTestNumOfFailures __attribute__((unused)) = 0;
+
+/* Defines -------------------------------------------------------------------*/
+#define TEST_CHECK(CONDITION, ...)											\
+	do {																	\
+		prvTestNumOfChecks++;												\
+		if (!(CONDITION))													\
+		{																	\
+			prvTestNumOfFailures++;											\
+			printf("%s:%d: FAIL: ", __FILE__, __LINE__);					\
+			printf(__VA_ARGS__);											\
+			printf("\n");													\
+		}																	\
+	} while (0)
+
+#define TEST_EXIT()															\
+	do {																	\
+		printf("%s: %d checks, %d failed\n", __FILE__,						\
+				prvTestNumOfChecks, prvTestNumOfFailures);					\
+		return prvTestNumOfFailures != 0;									\
+	} while (0)
+
+/* Functions -----------------------------------------------------------------*/
+/**
+ * @brief	Monotonic time for the host benchmarks
+ * @param	None
+ * @retval	Time in nanoseconds
+ */
+static inline uint64_t testNanoseconds()
+{
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (uint64_t)time.tv_sec * 1000000000ULL + (uint64_t)time.tv_nsec;
+}
+
+/**
+ * @brief	Deterministic pseudo random numbers so failures can be reproduced
+ * @param	pState: State of the generator, any non-zero start value
+ * @retval	The next number
+ */
+static inline uint32_t testRandom(uint32_t* pState)
+{
+	uint32_t x = *pState;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*pState = x;
+	return x;
+}
+
+#endif /* TEST_H_ */
@@ -0,0 +1,231 @@
+/**
+ ******************************************************************************
+ * @file	test_adc_filter.c
+ * @brief	Host test of adc_filter.c against double precision references.
+ *
+ *			Random blocks of random length are filtered by the fixed point
+ *			code and by a double precision model of the same design, the
+ *			outputs must agree to a few LSB. The frequency responses are
+ *			measured with sine inputs.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "adc_filter.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define NUM_OF_SAMPLES			(20000)
+#define NOTCH_Q					(5.0)
+
+/* Private variables ---------------------------------------------------------*/
+static ADCFilter prvFilter;
+static int16_t prvInput[NUM_OF_SAMPLES];
+static int16_t prvOutput[NUM_OF_SAMPLES];
+static uint32_t prvRandomState = 12345;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief	Filters prvInput into prvOutput in blocks of random length
+ */
+static void prvFilterInRandomBlocks()
+{
+	memcpy(prvOutput, prvInput, sizeof(prvInput));
+	for (uint32_t i = 0; i < NUM_OF_SAMPLES; )
+	{
+		uint32_t length = 1 + testRandom(&prvRandomState) % 600;
+		if (i + length > NUM_OF_SAMPLES)
+			length = NUM_OF_SAMPLES - i;
+		adcFilterProcess(&prvFilter, &prvOutput[i], length);
+		i += length;
+	}
+}
+
+/**
+ * @brief	Fills prvInput with uniform noise of the given amplitude
+ */
+static void prvMakeNoise(int32_t Amplitude)
+{
+	for (uint32_t i = 0; i < NUM_OF_SAMPLES; i++)
+		prvInput[i] = (int16_t)((int32_t)(testRandom(&prvRandomState) % (2 * Amplitude + 1)) - Amplitude);
+}
+
+/**
+ * @brief	Largest difference between prvOutput and a reference
+ */
+static double prvMaxError(const double* pReference)
+{
+	double maxError = 0.0;
+	for (uint32_t i = 0; i < NUM_OF_SAMPLES; i++)
+	{
+		double error = fabs(pReference[i] - prvOutput[i]);
+		if (error > maxError)
+			maxError = error;
+	}
+	return maxError;
+}
+
+/**
+ * @brief	Gain in dB of the selected filter for a sine, measured after it has settled
+ */
+static double prvGain(ADCFilterType Type, uint32_t SampleRate, uint32_t Cutoff, double Frequency)
+{
+	adcFilterInit(&prvFilter, Type, SampleRate, Cutoff);
+	for (uint32_t i = 0; i < NUM_OF_SAMPLES; i++)
+		prvInput[i] = (int16_t)lrint(10000.0 * sin(2.0 * M_PI * Frequency * i / SampleRate));
+	prvFilterInRandomBlocks();
+
+	double inputPower = 0.0;
+	double outputPower = 0.0;
+	for (uint32_t i = NUM_OF_SAMPLES / 2; i < NUM_OF_SAMPLES; i++)
+	{
+		inputPower += (double)prvInput[i] * prvInput[i];
+		outputPower += (double)prvOutput[i] * prvOutput[i];
+	}
+	return 10.0 * log10(outputPower / inputPower);
+}
+
+/**
+ * @brief	Moving average, the reference is the exact floored mean
+ */
+static void prvTestMovingAverage()
+{
+	static double reference[NUM_OF_SAMPLES];
+	prvMakeNoise(32768 - 1);
+	adcFilterInit(&prvFilter, ADCFilterType_MovingAverage, 1000, 0);
+	prvFilterInRandomBlocks();
+
+	for (uint32_t i = 0; i < NUM_OF_SAMPLES; i++)
+	{
+		double sum = 0.0;
+		for (uint32_t k = 0; k < ADC_FILTER_AVERAGE_LENGTH && k <= i; k++)
+			sum += prvInput[i - k];
+		reference[i] = floor(sum / ADC_FILTER_AVERAGE_LENGTH);
+	}
+	double error = prvMaxError(reference);
+	TEST_CHECK(error == 0.0, "moving average differs by %.0f LSB", error);
+}
+
+/**
+ * @brief	Low-pass FIR against the unquantized windowed sinc in double
+ */
+static void prvTestLowPass(uint32_t SampleRate, uint32_t Cutoff)
+{
+	static double reference[NUM_OF_SAMPLES];
+	double taps[ADC_FILTER_NUM_OF_TAPS];
+	double sum = 0.0;
+	for (uint32_t i = 0; i < ADC_FILTER_NUM_OF_TAPS; i++)
+	{
+		double t = i - (ADC_FILTER_NUM_OF_TAPS - 1) / 2.0;
+		double window = 0.54 - 0.46 * cos(2.0 * M_PI * i / (ADC_FILTER_NUM_OF_TAPS - 1));
+		taps[i] = sin(2.0 * M_PI * Cutoff / SampleRate * t) / (M_PI * t) * window;
+		sum += taps[i];
+	}
+
+	prvMakeNoise(8000);
+	adcFilterInit(&prvFilter, ADCFilterType_LowPass, SampleRate, Cutoff);
+	prvFilterInRandomBlocks();
+
+	for (uint32_t i = 0; i < NUM_OF_SAMPLES; i++)
+	{
+		double acc = 0.0;
+		for (uint32_t k = 0; k < ADC_FILTER_NUM_OF_TAPS && k <= i; k++)
+			acc += taps[ADC_FILTER_NUM_OF_TAPS - 1 - k] / sum * prvInput[i - k];
+		reference[i] = acc;
+	}
+
+	/* Bounded by the coefficient quantization, 32 taps * 8000 * 2^-16 is about 4 LSB */
+	double error = prvMaxError(reference);
+	TEST_CHECK(error <= 4.0, "low-pass %u Hz at %u Hz differs by %.2f LSB", Cutoff, SampleRate, error);
+}
+
+/**
+ * @brief	Notch biquad against the RBJ design run in double
+ */
+static void prvTestNotch(ADCFilterType Type, double Frequency, uint32_t SampleRate, bool FullScaleSquare)
+{
+	static double reference[NUM_OF_SAMPLES];
+	double omega = 2.0 * M_PI * Frequency / SampleRate;
+	double alpha = sin(omega) / (2.0 * NOTCH_Q);
+	double a0 = 1.0 + alpha;
+	double b0 = 1.0 / a0;
+	double b1 = -2.0 * cos(omega) / a0;
+	double a1 = b1;
+	double a2 = (1.0 - alpha) / a0;
+
+	/* A full scale square wave checks the headroom of the state and the accumulator */
+	if (FullScaleSquare)
+	{
+		for (uint32_t i = 0; i < NUM_OF_SAMPLES; i++)
+			prvInput[i] = ((uint32_t)(i * 2 * Frequency / SampleRate) & 1) ? INT16_MIN : INT16_MAX;
+	}
+	else
+		prvMakeNoise(16000);
+	adcFilterInit(&prvFilter, Type, SampleRate, 0);
+	prvFilterInRandomBlocks();
+
+	/*
+	 * Near the notch the Q30 coefficients limit the depth to about -70 dB at the highest
+	 * sample rate, so the full scale check uses them and only tests the arithmetic
+	 */
+	if (FullScaleSquare)
+	{
+		b0 = prvFilter.biquadCoefficients[0] / 1073741824.0;
+		b1 = prvFilter.biquadCoefficients[1] / 1073741824.0;
+		a1 = prvFilter.biquadCoefficients[3] / 1073741824.0;
+		a2 = prvFilter.biquadCoefficients[4] / 1073741824.0;
+	}
+
+	double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+	for (uint32_t i = 0; i < NUM_OF_SAMPLES; i++)
+	{
+		double y0 = b0 * prvInput[i] + b1 * x1 + b0 * x2 - a1 * y1 - a2 * y2;
+		x2 = x1;
+		x1 = prvInput[i];
+		y2 = y1;
+		y1 = y0;
+		reference[i] = y0 > 32767.0 ? 32767.0 : (y0 < -32768.0 ? -32768.0 : y0);
+	}
+
+	double error = prvMaxError(reference);
+	TEST_CHECK(error <= 2.0, "notch %.0f Hz at %u Hz differs by %.2f LSB", Frequency, SampleRate, error);
+}
+
+/* Functions -----------------------------------------------------------------*/
+int main()
+{
+	prvTestMovingAverage();
+
+	prvTestLowPass(1000, 100);
+	prvTestLowPass(100000, 1000);
+	prvTestLowPass(10000, 4000);
+
+	prvTestNotch(ADCFilterType_Notch50Hz, 50.0, 1000, false);
+	prvTestNotch(ADCFilterType_Notch60Hz, 60.0, 10000, false);
+	prvTestNotch(ADCFilterType_Notch50Hz, 50.0, 100000, false);
+	prvTestNotch(ADCFilterType_Notch50Hz, 50.0, 1000, true);
+	prvTestNotch(ADCFilterType_Notch60Hz, 60.0, 100000, true);
+
+	/* Frequency responses */
+	double gain = prvGain(ADCFilterType_LowPass, 1000, 100, 10.0);
+	TEST_CHECK(fabs(gain) < 0.1, "low-pass pass band gain %.2f dB", gain);
+	gain = prvGain(ADCFilterType_LowPass, 1000, 100, 300.0);
+	TEST_CHECK(gain < -30.0, "low-pass stop band gain %.2f dB", gain);
+	gain = prvGain(ADCFilterType_Notch50Hz, 1000, 0, 50.0);
+	TEST_CHECK(gain < -30.0, "50 Hz notch gain %.2f dB", gain);
+	gain = prvGain(ADCFilterType_Notch50Hz, 1000, 0, 200.0);
+	TEST_CHECK(fabs(gain) < 0.1, "50 Hz notch gain at 200 Hz %.2f dB", gain);
+	gain = prvGain(ADCFilterType_Notch60Hz, 10000, 0, 60.0);
+	TEST_CHECK(gain < -30.0, "60 Hz notch gain %.2f dB", gain);
+
+	/* A notch above the Nyquist frequency is turned off */
+	adcFilterInit(&prvFilter, ADCFilterType_Notch60Hz, 100, 0);
+	TEST_CHECK(prvFilter.type == ADCFilterType_None, "notch above Nyquist not disabled");
+
+	TEST_EXIT();
+}
@@ -0,0 +1,228 @@
+/**
+ ******************************************************************************
+ * @file	test_adc_scope.c
+ * @brief	Host test of the trigger in adc_scope.c.
+ *
+ *			A signal is fed through adcScopeAddBlock in random block sizes
+ *			and every captured frame is compared with the frame a simple
+ *			reference of the trigger rules expects: edge with hysteresis,
+ *			pre-trigger depth, holdoff and the auto mode timeout.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "adc_scope.h"
+
+#include <string.h>
+#include <stdlib.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define SIGNAL_LENGTH		(100000)
+#define MAX_BLOCK_SIZE		(512)
+#define MAX_NUM_OF_FRAMES	(SIGNAL_LENGTH / 100)
+
+/* Private typedefs ----------------------------------------------------------*/
+typedef struct
+{
+	uint32_t triggerSample;
+	bool triggered;
+} ReferenceFrame;
+
+/* Private variables ---------------------------------------------------------*/
+static ADCScope prvScope;
+static int16_t prvSignal[SIGNAL_LENGTH];
+static bool prvEdge[SIGNAL_LENGTH];
+static ReferenceFrame prvReference[MAX_NUM_OF_FRAMES];
+static uint32_t prvRandomState = 0x2545F491;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief	Triangle wave with the given period plus a little noise
+ */
+static void prvMakeTriangle(uint32_t Period, int32_t Amplitude, int32_t Noise)
+{
+	for (uint32_t n = 0; n < SIGNAL_LENGTH; n++)
+	{
+		int32_t phase = n % Period;
+		int32_t value = (phase < Period / 2) ? phase : Period - phase;
+		value = (value * 4 * Amplitude) / (int32_t)Period - Amplitude;
+		if (Noise)
+			value += (int32_t)(testRandom(&prvRandomState) % (2 * Noise + 1)) - Noise;
+		prvSignal[n] = (int16_t)value;
+	}
+}
+
+/**
+ * @brief	Where the edges are: the signal has to be past the hysteresis before it crosses the level
+ */
+static void prvFindEdges(const ADCScopeSettings* pSettings)
+{
+	bool armed = false;
+	for (uint32_t n = 0; n < SIGNAL_LENGTH; n++)
+	{
+		int32_t sample = prvSignal[n];
+		if (pSettings->edge == ADCScopeEdge_Falling)
+			sample = -sample;
+		int32_t level = (pSettings->edge == ADCScopeEdge_Falling) ? -pSettings->level : pSettings->level;
+
+		prvEdge[n] = false;
+		if (sample <= level - (int32_t)pSettings->hysteresis)
+			armed = true;
+		else if (armed && sample >= level)
+		{
+			armed = false;
+			prvEdge[n] = true;
+		}
+	}
+}
+
+/**
+ * @brief	The frames the trigger rules give for the whole signal
+ * @retval	Number of frames
+ */
+static uint32_t prvReferenceFrames(const ADCScopeSettings* pSettings)
+{
+	uint32_t numOfFrames = 0;
+	uint32_t armedAt = 0;
+	bool hasTriggered = false;
+	uint32_t lastTrigger = 0;
+
+	prvFindEdges(pSettings);
+	for (uint32_t n = armedAt + pSettings->preTriggerDepth; n < SIGNAL_LENGTH; n++)
+	{
+		bool edge = prvEdge[n] && !(hasTriggered && n - lastTrigger < pSettings->holdoff);
+		bool forced = !edge && pSettings->mode == ADCScopeMode_Auto &&
+					  n + 1 - armedAt - pSettings->preTriggerDepth >= pSettings->autoTimeout;
+		if (!edge && !forced)
+			continue;
+
+		/* The frame is finished when the samples after the trigger fill the rest of it */
+		uint32_t finished = n + ADC_SCOPE_FRAME_SIZE - 1 - pSettings->preTriggerDepth;
+		if (finished >= SIGNAL_LENGTH)
+			break;
+		prvReference[numOfFrames].triggerSample = n;
+		prvReference[numOfFrames].triggered = edge;
+		numOfFrames++;
+		hasTriggered = true;
+		lastTrigger = n;
+		if (pSettings->mode == ADCScopeMode_Single)
+			break;
+		armedAt = finished + 1;
+		n = armedAt + pSettings->preTriggerDepth - 1;
+	}
+	return numOfFrames;
+}
+
+/**
+ * @brief	Checks a frame against the min and max of the samples the reference frame covers
+ */
+static bool prvFrameMatches(const ADCScopeFrame* pFrame, const ReferenceFrame* pReference, uint32_t PreTriggerDepth)
+{
+	uint32_t start = pReference->triggerSample - PreTriggerDepth;
+	for (uint32_t column = 0; column < ADC_SCOPE_NUM_OF_COLUMNS; column++)
+	{
+		uint32_t from = column * ADC_SCOPE_FRAME_SIZE / ADC_SCOPE_NUM_OF_COLUMNS;
+		uint32_t to = (column + 1) * ADC_SCOPE_FRAME_SIZE / ADC_SCOPE_NUM_OF_COLUMNS;
+		int16_t min = INT16_MAX, max = INT16_MIN;
+		for (uint32_t i = from; i < to; i++)
+		{
+			if (prvSignal[start + i] < min)
+				min = prvSignal[start + i];
+			if (prvSignal[start + i] > max)
+				max = prvSignal[start + i];
+		}
+		if (pFrame->min[column] != min || pFrame->max[column] != max)
+			return false;
+	}
+	return pFrame->triggered == pReference->triggered &&
+		   pFrame->triggerColumn == PreTriggerDepth * ADC_SCOPE_NUM_OF_COLUMNS / ADC_SCOPE_FRAME_SIZE;
+}
+
+/**
+ * @brief	Feeds the signal in random blocks, drawing every frame right away, and compares the frames
+ * @retval	Number of frames the scope captured
+ */
+static uint32_t prvRun(const char* pName, const ADCScopeSettings* pSettings)
+{
+	uint32_t numOfReferenceFrames = prvReferenceFrames(pSettings);
+	uint32_t numOfFrames = 0;
+
+	adcScopeReset(&prvScope);
+	adcScopeStart(&prvScope, pSettings);
+	for (uint32_t offset = 0; offset < SIGNAL_LENGTH;)
+	{
+		uint32_t blockSize = 1 + testRandom(&prvRandomState) % MAX_BLOCK_SIZE;
+		if (blockSize > SIGNAL_LENGTH - offset)
+			blockSize = SIGNAL_LENGTH - offset;
+		adcScopeAddBlock(&prvScope, &prvSignal[offset], blockSize, offset);
+		offset += blockSize;
+
+		const ADCScopeFrame* pFrame;
+		if (adcScopeGetFrame(&prvScope, &pFrame))
+		{
+			if (numOfFrames < numOfReferenceFrames)
+				TEST_CHECK(prvFrameMatches(pFrame, &prvReference[numOfFrames], pSettings->preTriggerDepth),
+						   "%s: frame %u should trigger at sample %u", pName, numOfFrames,
+						   prvReference[numOfFrames].triggerSample);
+			numOfFrames++;
+			adcScopeReleaseFrame(&prvScope);
+		}
+	}
+	TEST_CHECK(numOfFrames == numOfReferenceFrames, "%s: %u frames, expected %u", pName, numOfFrames, numOfReferenceFrames);
+	return numOfFrames;
+}
+
+/* Functions -----------------------------------------------------------------*/
+int main()
+{
+	/* Normal mode on both edges, the noise would retrigger without the hysteresis */
+	prvMakeTriangle(1500, 10000, 300);
+	ADCScopeSettings settings = {ADCScopeMode_Normal, ADCScopeEdge_Rising, 1000, 400, 0, 1024, 0};
+	uint32_t numOfFrames = prvRun("rising", &settings);
+	TEST_CHECK(numOfFrames > 10, "rising: only %u frames", numOfFrames);
+	settings.edge = ADCScopeEdge_Falling;
+	prvRun("falling", &settings);
+	settings.preTriggerDepth = 0;
+	prvRun("no pre-trigger", &settings);
+	settings.preTriggerDepth = ADC_SCOPE_FRAME_SIZE - 1;
+	prvRun("all pre-trigger", &settings);
+
+	/* A holdoff longer than a frame skips edges */
+	settings = (ADCScopeSettings){ADCScopeMode_Normal, ADCScopeEdge_Rising, 0, 200, 0, 512, 0};
+	prvMakeTriangle(700, 8000, 0);
+	uint32_t withoutHoldoff = prvRun("without holdoff", &settings);
+	settings.holdoff = 5000;
+	uint32_t withHoldoff = prvRun("holdoff", &settings);
+	TEST_CHECK(withHoldoff < withoutHoldoff, "holdoff: %u frames, %u without it", withHoldoff, withoutHoldoff);
+	for (uint32_t i = 1; i < withHoldoff; i++)
+		TEST_CHECK(prvReference[i].triggerSample - prvReference[i - 1].triggerSample >= settings.holdoff,
+				   "holdoff: triggers at %u and %u", prvReference[i - 1].triggerSample, prvReference[i].triggerSample);
+
+	/* Auto mode forces frames on a signal that never crosses the level but triggers normally when it does */
+	settings = (ADCScopeSettings){ADCScopeMode_Auto, ADCScopeEdge_Rising, 20000, 100, 0, 1024, 6000};
+	numOfFrames = prvRun("auto without trigger", &settings);
+	TEST_CHECK(numOfFrames == SIGNAL_LENGTH / (ADC_SCOPE_FRAME_SIZE + 6000),
+			   "auto without trigger: %u frames", numOfFrames);
+	TEST_CHECK(!prvReference[0].triggered && prvReference[0].triggerSample == 1024 + 6000 - 1,
+			   "auto without trigger: first frame at %u", prvReference[0].triggerSample);
+	settings.level = 0;
+	prvRun("auto with trigger", &settings);
+	TEST_CHECK(prvReference[0].triggered, "auto with trigger: first frame forced");
+
+	/* Single shot stops after the first frame */
+	settings = (ADCScopeSettings){ADCScopeMode_Single, ADCScopeEdge_Rising, 0, 100, 0, 300, 0};
+	TEST_CHECK(prvRun("single", &settings) == 1, "single: more than one frame");
+	TEST_CHECK(adcScopeGetState(&prvScope) == ADCScopeState_Done, "single: state %d", adcScopeGetState(&prvScope));
+
+	/* Lost samples start the pre-trigger collection over */
+	settings = (ADCScopeSettings){ADCScopeMode_Normal, ADCScopeEdge_Rising, 0, 100, 0, 1000, 0};
+	adcScopeReset(&prvScope);
+	adcScopeStart(&prvScope, &settings);
+	adcScopeAddBlock(&prvScope, prvSignal, 1500, 0);
+	TEST_CHECK(adcScopeGetState(&prvScope) != ADCScopeState_Filling, "gap: still filling");
+	adcScopeAddBlock(&prvScope, &prvSignal[2000], 10, 2000);
+	TEST_CHECK(adcScopeGetState(&prvScope) == ADCScopeState_Filling, "gap: state %d", adcScopeGetState(&prvScope));
+
+	TEST_EXIT();
+}
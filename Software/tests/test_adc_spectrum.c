@@ -0,0 +1,171 @@
+/**
+ ******************************************************************************
+ * @file	test_adc_spectrum.c
+ * @brief	Host test of the fixed point FFT and real split in adc_spectrum.c.
+ *
+ *			Known tones are run through the spectrum and every bin is
+ *			compared against a naive DFT in double precision with the
+ *			same Hann window and the same full scale reference.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "adc_spectrum.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define SAMPLE_RATE				(10000)
+#define FULL_SCALE				(32768.0)
+#define LEVEL_TOLERANCE			(3)			/* 0.1 dB */
+#define COMPARED_LEVEL			(-700)		/* Bins below this are only checked for spurs */
+#define SPUR_LEVEL				(-700)
+#define NUM_OF_SIZES			(4)
+
+/* Private typedefs ----------------------------------------------------------*/
+typedef struct
+{
+	double frequency;				/* In bins */
+	double amplitude;
+} Tone;
+
+/* Private variables ---------------------------------------------------------*/
+static ADCSpectrum prvSpectrum;
+static int16_t prvSamples[2 * ADC_SPECTRUM_MAX_SIZE];
+static double prvReference[ADC_SPECTRUM_MAX_NUM_OF_BINS];
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief	Fills prvSamples with the sum of the tones and a DC offset
+ */
+static void prvMakeSignal(uint32_t Size, uint32_t NumOfSamples, const Tone* pTones, uint32_t NumOfTones, double Offset)
+{
+	for (uint32_t n = 0; n < NumOfSamples; n++)
+	{
+		double value = Offset;
+		for (uint32_t i = 0; i < NumOfTones; i++)
+			value += pTones[i].amplitude * sin(2.0 * M_PI * pTones[i].frequency * n / Size + 0.3 * i);
+		value = round(value);
+		prvSamples[n] = (int16_t)(value > 32767.0 ? 32767.0 : (value < -32768.0 ? -32768.0 : value));
+	}
+}
+
+/**
+ * @brief	Naive Hann windowed DFT of the first Size samples in 0.1 dBFS
+ */
+static void prvReferenceLevels(uint32_t Size)
+{
+	for (uint32_t k = 0; k < Size / 2; k++)
+	{
+		double real = 0.0, imag = 0.0;
+		for (uint32_t n = 0; n < Size; n++)
+		{
+			double value = prvSamples[n] * (0.5 - 0.5 * cos(2.0 * M_PI * n / Size));
+			real += value * cos(2.0 * M_PI * k * n / Size);
+			imag -= value * sin(2.0 * M_PI * k * n / Size);
+		}
+		/* A full scale sine in one bin has the magnitude full scale * size / 4 with the window */
+		double magnitude = sqrt(real * real + imag * imag) / (FULL_SCALE * Size / 4.0);
+		prvReference[k] = (magnitude > 0.0) ? 200.0 * log10(magnitude) : -2000.0;
+	}
+}
+
+/**
+ * @brief	Runs NumOfSamples samples through the spectrum and returns the last frame
+ */
+static const ADCSpectrumFrame* prvRun(uint32_t Size, uint32_t NumOfAverages, uint32_t NumOfSamples)
+{
+	ADCSpectrumSettings settings = {Size, NumOfAverages};
+	adcSpectrumReset(&prvSpectrum);
+	TEST_CHECK(adcSpectrumStart(&prvSpectrum, &settings) == SUCCESS, "start size %u", Size);
+
+	const ADCSpectrumFrame* pFrame = 0;
+	for (uint32_t offset = 0; offset < NumOfSamples; offset += Size)
+	{
+		adcSpectrumAddBlock(&prvSpectrum, &prvSamples[offset], Size, offset, SAMPLE_RATE);
+		while (adcSpectrumGetState(&prvSpectrum) == ADCSpectrumState_Transforming)
+			adcSpectrumProcess(&prvSpectrum);
+		if (adcSpectrumGetFrame(&prvSpectrum, &pFrame))
+			adcSpectrumReleaseFrame(&prvSpectrum);
+	}
+	return pFrame;
+}
+
+/**
+ * @brief	Compares every bin of a single transform against the DFT
+ */
+static void prvCompare(const char* pName, uint32_t Size, const Tone* pTones, uint32_t NumOfTones, double Offset)
+{
+	prvMakeSignal(Size, Size, pTones, NumOfTones, Offset);
+	prvReferenceLevels(Size);
+	const ADCSpectrumFrame* pFrame = prvRun(Size, 1, Size);
+
+	TEST_CHECK(pFrame->numOfBins == Size / 2, "%s size %u: %u bins", pName, Size, pFrame->numOfBins);
+	double worstError = 0.0;
+	uint32_t worstBin = 0;
+	uint32_t referencePeak = 3;
+	for (uint32_t k = 0; k < Size / 2; k++)
+	{
+		double error = fabs(pFrame->level[k] - prvReference[k]);
+		if (prvReference[k] > COMPARED_LEVEL && error > worstError)
+		{
+			worstError = error;
+			worstBin = k;
+		}
+		if (prvReference[k] < COMPARED_LEVEL - 300)
+			TEST_CHECK(pFrame->level[k] < SPUR_LEVEL, "%s size %u: spur of %d at bin %u", pName, Size, pFrame->level[k], k);
+		if (k > 2 && prvReference[k] > prvReference[referencePeak])
+			referencePeak = k;
+	}
+	TEST_CHECK(worstError <= LEVEL_TOLERANCE, "%s size %u: bin %u is %d, the DFT gives %.1f",
+			   pName, Size, worstBin, pFrame->level[worstBin], prvReference[worstBin]);
+	TEST_CHECK(pFrame->peakBin == referencePeak, "%s size %u: peak in bin %u, the DFT has it in %u",
+			   pName, Size, pFrame->peakBin, referencePeak);
+}
+
+/* Functions -----------------------------------------------------------------*/
+int main()
+{
+	static const uint32_t sizes[NUM_OF_SIZES] = {256, 512, 1024, 2048};
+	for (uint32_t i = 0; i < NUM_OF_SIZES; i++)
+	{
+		uint32_t size = sizes[i];
+
+		/* Full scale on a bin, on the other side of the spectrum and between two bins */
+		Tone onBin = {size / 8, 32767.0};
+		prvCompare("full scale on bin", size, &onBin, 1, 0.0);
+		Tone highBin = {size / 2 - 9, 20000.0};
+		prvCompare("high bin", size, &highBin, 1, 0.0);
+		Tone betweenBins = {size / 5 + 0.37, 10000.0};
+		prvCompare("between bins", size, &betweenBins, 1, 0.0);
+
+		/* A weak tone next to a strong one and a DC offset */
+		Tone twoTones[2] = {{size / 16 + 0.4, 16000.0}, {size / 4, 50.0}};
+		prvCompare("two tones", size, twoTones, 2, 0.0);
+		Tone withOffset = {size / 3 + 0.21, 8000.0};
+		prvCompare("dc offset", size, &withOffset, 1, 12000.0);
+
+		/* A full scale sine on a bin is 0 dBFS and its peak frequency is exact */
+		prvMakeSignal(size, size, &onBin, 1, 0.0);
+		const ADCSpectrumFrame* pFrame = prvRun(size, 1, size);
+		TEST_CHECK(abs(pFrame->peakLevel) <= 1, "size %u: full scale peak is %d", size, pFrame->peakLevel);
+		uint32_t expectedFrequency = (uint32_t)(SAMPLE_RATE * 1000ULL / 8);
+		TEST_CHECK(abs((int32_t)(pFrame->peakFrequency - expectedFrequency)) <= (int32_t)pFrame->binWidth / 50,
+				   "size %u: peak at %u mHz, expected %u mHz", size, pFrame->peakFrequency, expectedFrequency);
+	}
+
+	/* Averaging two transforms of half and full scale gives the mean power, 10 * log10(1.25 / 2) = -2.04 dB */
+	Tone tone = {128, 16384.0};
+	prvMakeSignal(1024, 1024, &tone, 1, 0.0);
+	tone.amplitude = 32767.0;
+	prvMakeSignal(1024, 2048, &tone, 1, 0.0);
+	for (uint32_t n = 0; n < 1024; n++)
+		prvSamples[n] /= 2;
+	const ADCSpectrumFrame* pFrame = prvRun(1024, 2, 2048);
+	TEST_CHECK(pFrame->numOfAverages == 2, "%u averages", pFrame->numOfAverages);
+	TEST_CHECK(abs(pFrame->peakLevel + 20) <= 1, "averaged level %d, expected -20", pFrame->peakLevel);
+
+	TEST_EXIT();
+}
@@ -0,0 +1,163 @@
+/**
+ ******************************************************************************
+ * @file	test_adc_stats.c
+ * @brief	Host test of the fixed point statistics in adc_stats.c.
+ *
+ *			Blocks of random size are added and after every block the
+ *			total and the sliding window results are compared with min,
+ *			max, mean and RMS calculated in double precision.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "adc_stats.h"
+
+#include <math.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define MAX_BLOCK_SIZE		(65536)
+#define NUM_OF_BLOCKS		(400)
+
+/* Private typedefs ----------------------------------------------------------*/
+typedef struct
+{
+	int32_t min;
+	int32_t max;
+	double sum;
+	double sumOfSquares;
+	double numOfSamples;
+} ReferenceSums;
+
+/* Private variables ---------------------------------------------------------*/
+static ADCStats prvStats;
+static int16_t prvBlock[MAX_BLOCK_SIZE];
+static ReferenceSums prvBlockSums[NUM_OF_BLOCKS];
+static uint32_t prvRandomState = 0x9E3779B9;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief	Fills the block with one of a few kinds of signals
+ */
+static void prvMakeBlock(uint32_t NumOfSamples, uint32_t Kind, uint32_t* pPhase)
+{
+	for (uint32_t n = 0; n < NumOfSamples; n++, (*pPhase)++)
+	{
+		double value;
+		switch (Kind)
+		{
+			case 0:		/* Sine with an offset and noise */
+				value = 3000.0 + 20000.0 * sin(*pPhase * 0.0123) + (double)(testRandom(&prvRandomState) % 201) - 100.0;
+				break;
+			case 1:		/* Full scale square wave */
+				value = ((*pPhase / 37) & 1) ? 32767.0 : -32768.0;
+				break;
+			case 2:		/* Negative full scale */
+				value = -32768.0;
+				break;
+			default:	/* Uniform noise over the whole range */
+				value = (double)(int16_t)testRandom(&prvRandomState);
+				break;
+		}
+		prvBlock[n] = (int16_t)value;
+	}
+}
+
+/**
+ * @brief	Sums of a block in double precision
+ */
+static void prvSumBlock(uint32_t NumOfSamples, ReferenceSums* pSums)
+{
+	pSums->min = INT16_MAX;
+	pSums->max = INT16_MIN;
+	pSums->sum = 0.0;
+	pSums->sumOfSquares = 0.0;
+	pSums->numOfSamples = NumOfSamples;
+	for (uint32_t n = 0; n < NumOfSamples; n++)
+	{
+		double sample = prvBlock[n];
+		if (prvBlock[n] < pSums->min)
+			pSums->min = prvBlock[n];
+		if (prvBlock[n] > pSums->max)
+			pSums->max = prvBlock[n];
+		pSums->sum += sample;
+		pSums->sumOfSquares += sample * sample;
+	}
+}
+
+/**
+ * @brief	Adds the sums of one block to another
+ */
+static void prvAddSums(ReferenceSums* pTo, const ReferenceSums* pFrom)
+{
+	if (pFrom->min < pTo->min)
+		pTo->min = pFrom->min;
+	if (pFrom->max > pTo->max)
+		pTo->max = pFrom->max;
+	pTo->sum += pFrom->sum;
+	pTo->sumOfSquares += pFrom->sumOfSquares;
+	pTo->numOfSamples += pFrom->numOfSamples;
+}
+
+/**
+ * @brief	Compares a result with the reference, mean and RMS must be the reference rounded to the closest count
+ */
+static void prvCompare(const char* pName, uint32_t Block, const ADCStatsResult* pResult, const ReferenceSums* pSums)
+{
+	double mean = pSums->sum / pSums->numOfSamples;
+	double rms = sqrt(pSums->sumOfSquares / pSums->numOfSamples);
+
+	TEST_CHECK(pResult->min == pSums->min && pResult->max == pSums->max &&
+			   pResult->peakToPeak == pSums->max - pSums->min,
+			   "%s block %u: min %d max %d, expected %d %d", pName, Block, pResult->min, pResult->max, pSums->min, pSums->max);
+	TEST_CHECK(pResult->numOfSamples == (uint64_t)pSums->numOfSamples, "%s block %u: %llu samples, expected %.0f",
+			   pName, Block, (unsigned long long)pResult->numOfSamples, pSums->numOfSamples);
+	TEST_CHECK(fabs(pResult->mean - mean) <= 0.5 + 1e-9, "%s block %u: mean %d, expected %.3f", pName, Block, pResult->mean, mean);
+
+	/* The mean square is truncated to an integer before the root, that can move the root by at most 1 / (2 * rms) */
+	TEST_CHECK(fabs(pResult->rms - rms) <= 0.5 + 0.5 / (rms > 1.0 ? rms : 1.0) + 1e-9,
+			   "%s block %u: rms %u, expected %.3f", pName, Block, pResult->rms, rms);
+}
+
+/* Functions -----------------------------------------------------------------*/
+int main()
+{
+	ReferenceSums total = {INT16_MAX, INT16_MIN, 0.0, 0.0, 0.0};
+	uint32_t phase = 0;
+	adcStatsReset(&prvStats);
+	for (uint32_t block = 0; block < NUM_OF_BLOCKS; block++)
+	{
+		/* Mostly acquisition sized blocks with a few of the largest allowed size */
+		uint32_t numOfSamples = (block % 50 == 49) ? MAX_BLOCK_SIZE : 1 + testRandom(&prvRandomState) % 4096;
+		uint32_t kind = (block / 25) % 4;
+		prvMakeBlock(numOfSamples, kind, &phase);
+		prvSumBlock(numOfSamples, &prvBlockSums[block]);
+		adcStatsAddBlock(&prvStats, prvBlock, numOfSamples);
+
+		prvAddSums(&total, &prvBlockSums[block]);
+		ReferenceSums window = {INT16_MAX, INT16_MIN, 0.0, 0.0, 0.0};
+		for (uint32_t i = (block >= ADC_STATS_WINDOW_SIZE) ? block - ADC_STATS_WINDOW_SIZE + 1 : 0; i <= block; i++)
+			prvAddSums(&window, &prvBlockSums[i]);
+
+		prvCompare("total", block, &prvStats.totalResult, &total);
+		prvCompare("window", block, &prvStats.windowResult, &window);
+	}
+
+	/* Empty blocks change nothing */
+	ADCStatsResult before = prvStats.windowResult;
+	adcStatsAddBlock(&prvStats, prvBlock, 0);
+	TEST_CHECK(memcmp(&before, &prvStats.windowResult, sizeof(ADCStatsResult)) == 0, "empty block changed the window");
+
+	/* Close to the 64 bit limit the total mean and RMS start over with the new block but keep the extremes */
+	prvStats.total.sumOfSquares = UINT64_MAX - 1000;
+	prvMakeBlock(1000, 1, &phase);
+	ReferenceSums restarted;
+	prvSumBlock(1000, &restarted);
+	restarted.min = total.min;
+	restarted.max = total.max;
+	adcStatsAddBlock(&prvStats, prvBlock, 1000);
+	prvCompare("restarted total", 0, &prvStats.totalResult, &restarted);
+
+	TEST_EXIT();
+}
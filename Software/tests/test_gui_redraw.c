@@ -0,0 +1,377 @@
+/**
+ ******************************************************************************
+ * @file	test_gui_redraw.c
+ * @brief	Host test of the dirty region redraw in simple_gui.c.
+ *
+ *			The GUI is drawn with the real driver on the RA8875 model in
+ *			lcd_bus_sim.c. Common transitions are done through the dirty
+ *			regions and the way they were drawn before. Both have to give
+ *			the same screen, and the pixels the LCD wrote for each are
+ *			printed next to each other.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "lcd_bus_sim.h"
+#include "lcd_ra8875.h"
+#include "simple_gui.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define BUTTON_ID(INDEX)		(guiConfigBUTTON_ID_OFFSET + (INDEX))
+#define TEXT_BOX_ID(INDEX)		(guiConfigTEXT_BOX_ID_OFFSET + (INDEX))
+#define CONTAINER_ID(INDEX)		(guiConfigCONTAINER_ID_OFFSET + (INDEX))
+
+#define MAIN_TEXT_BOX			TEXT_BOX_ID(0)
+#define LABEL_TEXT_BOX			TEXT_BOX_ID(1)
+#define DEBUG_TEXT_BOX			TEXT_BOX_ID(2)
+#define MAIN_CONTAINER			CONTAINER_ID(0)
+#define SIDEBAR_CONTAINER		CONTAINER_ID(1)
+#define POPOUT_CONTAINER		CONTAINER_ID(2)
+
+#define NUM_OF_SIDEBAR_BUTTONS	(12)
+#define NUM_OF_POPOUT_BUTTONS	(2)
+#define DATA_SIZE				(4096)
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t prvData[DATA_SIZE];
+static uint16_t prvScreen[LCD_SIM_HEIGHT][LCD_SIM_WIDTH];
+static uint8_t prvButtonText[NUM_OF_SIDEBAR_BUTTONS + NUM_OF_POPOUT_BUTTONS][8];
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief	Data for the main text box
+ */
+static ErrorStatus prvReadData(uint8_t* pBuffer, uint32_t Address, uint32_t Size, TickType_t Timeout)
+{
+	if (Address + Size > DATA_SIZE)
+		return ERROR;
+	memcpy(pBuffer, &prvData[Address], Size);
+	return SUCCESS;
+}
+
+/**
+ * @brief	Pixels the LCD has written so far
+ */
+static uint64_t prvPixelWrites()
+{
+	LCDSimCounters counters = lcdSimGetCounters();
+	return counters.pixelWrites;
+}
+
+/**
+ * @brief	Save the screen so it can be compared with prvScreenIsSaved
+ */
+static void prvSaveScreen()
+{
+	memcpy(prvScreen, lcdSimGetFrameBuffer(), sizeof(prvScreen));
+}
+
+/**
+ * @brief	Check if the screen is the same as when prvSaveScreen was called
+ */
+static bool prvScreenIsSaved()
+{
+	return memcmp(prvScreen, lcdSimGetFrameBuffer(), sizeof(prvScreen)) == 0;
+}
+
+/**
+ * @brief	Print the pixels of a transition drawn before and with the dirty regions
+ */
+static void prvPrintTransition(const char* pName, uint64_t Before, uint64_t After)
+{
+	printf("%-16s %10llu %10llu %8.1f%%\n", pName, (unsigned long long)Before, (unsigned long long)After,
+		   100.0 * (double)After / (double)Before);
+}
+
+/**
+ * @brief	Add a button with the colors the sidebars use
+ */
+static void prvAddButton(uint32_t Index, uint16_t XPos, uint16_t YPos, GUILayer Layer, GUIContainerPage Page)
+{
+	GUIButton button = {0};
+	button.object.id = BUTTON_ID(Index);
+	button.object.xPos = XPos;
+	button.object.yPos = YPos;
+	button.object.width = 140;
+	button.object.height = 50;
+	button.object.layer = Layer;
+	button.object.displayState = GUIDisplayState_Hidden;
+	button.object.border = GUIBorder_Top | GUIBorder_Bottom;
+	button.object.borderThickness = 1;
+	button.object.borderColor = GUI_WHITE;
+	button.object.containerPage = Page;
+	button.enabledTextColor = GUI_WHITE;
+	button.enabledBackgroundColor = GUI_BLUE;
+	button.disabledTextColor = GUI_WHITE;
+	button.disabledBackgroundColor = GUI_GRAY;
+	button.pressedTextColor = GUI_BLUE;
+	button.pressedBackgroundColor = GUI_WHITE;
+	button.state = GUIButtonState_Enabled;
+	snprintf((char*)prvButtonText[Index], sizeof(prvButtonText[Index]), "BTN %u", (unsigned)Index);
+	button.text[0] = prvButtonText[Index];
+	button.textSize[0] = LCDFontEnlarge_1x;
+	GUIButton_Add(&button);
+}
+
+/**
+ * @brief	A main content with a text box showing data, a sidebar with two pages and a pop-out on layer 1
+ * @note	The buttons of the pop-out are added by prvAddPopoutButtons the first time it's shown
+ */
+static void prvAddObjects()
+{
+	for (uint32_t i = 0; i < NUM_OF_SIDEBAR_BUTTONS; i++)
+		prvAddButton(i, 655, 85 + (i % 6) * 58, GUILayer_0, (i < 6) ? GUIContainerPage_1 : GUIContainerPage_2);
+
+	GUITextBox textBox = {0};
+	textBox.object.id = MAIN_TEXT_BOX;
+	textBox.object.yPos = 45;
+	textBox.object.width = 650;
+	textBox.object.height = 435;
+	textBox.object.containerPage = GUIContainerPage_All;
+	textBox.textColor = GUI_WHITE;
+	textBox.backgroundColor = GUI_BLACK;
+	textBox.textSize = LCDFontEnlarge_1x;
+	textBox.padding.top = guiConfigFONT_HEIGHT_UNIT;
+	textBox.padding.bottom = guiConfigFONT_HEIGHT_UNIT;
+	textBox.padding.left = guiConfigFONT_WIDTH_UNIT;
+	textBox.padding.right = guiConfigFONT_WIDTH_UNIT;
+	textBox.dataReadFunction = prvReadData;
+	textBox.scrollbarWidth = guiConfigSCROLLBAR_WIDTH;
+	textBox.readMaxAddress = DATA_SIZE - 1;
+	GUITextBox_Add(&textBox);
+
+	memset(&textBox, 0, sizeof(textBox));
+	textBox.object.id = LABEL_TEXT_BOX;
+	textBox.object.xPos = 655;
+	textBox.object.yPos = 50;
+	textBox.object.width = 140;
+	textBox.object.height = 30;
+	textBox.object.containerPage = GUIContainerPage_All;
+	textBox.textColor = GUI_WHITE;
+	textBox.backgroundColor = GUI_BLUE;
+	textBox.textSize = LCDFontEnlarge_1x;
+	textBox.staticText = (uint8_t*)"PAGE 1";
+	GUITextBox_Add(&textBox);
+
+	memset(&textBox, 0, sizeof(textBox));
+	textBox.object.id = DEBUG_TEXT_BOX;
+	textBox.object.xPos = 655;
+	textBox.object.yPos = 435;
+	textBox.object.width = 140;
+	textBox.object.height = 40;
+	textBox.object.containerPage = GUIContainerPage_All;
+	textBox.textColor = GUI_WHITE;
+	textBox.backgroundColor = GUI_BLACK;
+	textBox.textSize = LCDFontEnlarge_1x;
+	GUITextBox_Add(&textBox);
+
+	GUIContainerTemplate container = {0};
+	container.object.id = MAIN_CONTAINER;
+	container.object.yPos = 45;
+	container.object.width = 650;
+	container.object.height = 435;
+	container.backgroundColor = GUI_BLACK;
+	container.textBoxes[0] = MAIN_TEXT_BOX;
+	container.activePage = GUIContainerPage_1;
+	GUIContainer_Add(&container);
+
+	memset(&container, 0, sizeof(container));
+	container.object.id = SIDEBAR_CONTAINER;
+	container.object.xPos = 650;
+	container.object.yPos = 45;
+	container.object.width = 150;
+	container.object.height = 435;
+	container.object.border = GUIBorder_Left;
+	container.object.borderThickness = 1;
+	container.object.borderColor = GUI_WHITE;
+	container.backgroundColor = GUI_SYSTEM_BLUE;
+	for (uint32_t i = 0; i < NUM_OF_SIDEBAR_BUTTONS; i++)
+		container.buttons[i] = BUTTON_ID(i);
+	container.textBoxes[0] = LABEL_TEXT_BOX;
+	container.textBoxes[1] = DEBUG_TEXT_BOX;
+	container.activePage = GUIContainerPage_1;
+	container.lastPage = GUIContainerPage_2;
+	GUIContainer_Add(&container);
+
+	memset(&container, 0, sizeof(container));
+	container.object.id = POPOUT_CONTAINER;
+	container.object.xPos = 200;
+	container.object.yPos = 120;
+	container.object.width = 240;
+	container.object.height = 200;
+	container.object.layer = GUILayer_1;
+	container.object.border = GUIBorder_Left | GUIBorder_Right | GUIBorder_Top | GUIBorder_Bottom;
+	container.object.borderThickness = 2;
+	container.object.borderColor = GUI_WHITE;
+	container.backgroundColor = GUI_SYSTEM_BLUE;
+	for (uint32_t i = 0; i < NUM_OF_POPOUT_BUTTONS; i++)
+		container.buttons[i] = BUTTON_ID(NUM_OF_SIDEBAR_BUTTONS + i);
+	container.activePage = GUIContainerPage_1;
+	GUIContainer_Add(&container);
+}
+
+/**
+ * @brief	Add the buttons of the pop-out after the container
+ */
+static void prvAddPopoutButtons()
+{
+	for (uint32_t i = 0; i < NUM_OF_POPOUT_BUTTONS; i++)
+		prvAddButton(NUM_OF_SIDEBAR_BUTTONS + i, 250, 150 + i * 80, GUILayer_1, GUIContainerPage_All);
+}
+
+/**
+ * @brief	Draw the pop-out on layer 1 and hide it again, the layer 0 objects under it are not redrawn
+ */
+static void prvShowAndHidePopout()
+{
+	GUI_SetActiveLayer(GUILayer_1);
+	GUIContainer_Draw(POPOUT_CONTAINER);
+	GUIContainer_Hide(POPOUT_CONTAINER);
+	GUI_SetActiveLayer(GUILayer_0);
+}
+
+/* Functions -----------------------------------------------------------------*/
+/**
+ * @brief	The containers allocate their lists of children from the heap
+ */
+void* pvPortMalloc(size_t Size)
+{
+	return malloc(Size);
+}
+
+/**
+ * @brief	The beep is off during the test
+ */
+void BUZZER_BeepNumOfTimes(uint32_t NumOfTimes)
+{
+}
+
+int main()
+{
+	uint64_t start, before, after;
+
+	lcdSimInit(LCD_WAIT_Callback);
+	LCD_Init();
+	GUI_Init();
+	GUI_SetBeepOff();
+	prvAddObjects();
+
+	/* The pop-out is drawn before its buttons are added and again when they have been added */
+	uint32_t popoutButton = BUTTON_ID(NUM_OF_SIDEBAR_BUTTONS);
+	GUI_SetActiveLayer(GUILayer_1);
+	GUIContainer_Draw(POPOUT_CONTAINER);
+	TEST_CHECK(GUIButton_GetDisplayState(popoutButton) == GUIDisplayState_Hidden, "a button that is not added was drawn");
+	GUIContainer_Hide(POPOUT_CONTAINER);
+	prvAddPopoutButtons();
+	GUIContainer_Draw(POPOUT_CONTAINER);
+	TEST_CHECK(GUIButton_GetDisplayState(popoutButton) == GUIDisplayState_NotHidden,
+			   "a button added after its container was not drawn");
+	GUIContainer_Hide(POPOUT_CONTAINER);
+	GUI_SetActiveLayer(GUILayer_0);
+
+	for (uint32_t i = 0; i < DATA_SIZE; i++)
+		prvData[i] = 'A' + i % 26;
+
+	GUIContainer_Draw(MAIN_CONTAINER);
+	GUIContainer_Draw(SIDEBAR_CONTAINER);
+	GUITextBox_SetAddressesTo(MAIN_TEXT_BOX, 0);
+	GUITextBox_AppendDataFromMemory(MAIN_TEXT_BOX, 1000);
+	GUITextBox_WriteString(DEBUG_TEXT_BOX, (uint8_t*)"DEBUG");
+	GUI_RedrawDirtyRegions();
+	uint32_t numOfCharacters = GUITextBox_GetNumOfCharactersDisplayed(MAIN_TEXT_BOX);
+	TEST_CHECK(numOfCharacters == 1000, "%u characters in the main text box", (unsigned)numOfCharacters);
+
+	printf("%-16s %10s %10s %9s\n", "transition", "before px", "after px", "after");
+
+	/* A button is pressed, it was drawn directly before */
+	start = prvPixelWrites();
+	GUIButton_SetState(BUTTON_ID(2), GUIButtonState_TouchDown);
+	GUI_RedrawDirtyRegions();
+	after = prvPixelWrites() - start;
+	prvSaveScreen();
+	start = prvPixelWrites();
+	GUIButton_Draw(BUTTON_ID(2));
+	before = prvPixelWrites() - start;
+	TEST_CHECK(prvScreenIsSaved(), "the pressed button is different from when it's drawn directly");
+	prvPrintTransition("button press", before, after);
+
+	/* The label of the sidebar changes, the text box was drawn directly before */
+	start = prvPixelWrites();
+	GUITextBox_SetStaticText(LABEL_TEXT_BOX, (uint8_t*)"PAGE 2");
+	GUI_RedrawDirtyRegions();
+	after = prvPixelWrites() - start;
+	prvSaveScreen();
+	start = prvPixelWrites();
+	GUITextBox_Draw(LABEL_TEXT_BOX);
+	before = prvPixelWrites() - start;
+	TEST_CHECK(prvScreenIsSaved(), "the label is different from when it's drawn directly");
+	prvPrintTransition("label change", before, after);
+
+	/* The sidebar changes page, the whole container was drawn before */
+	start = prvPixelWrites();
+	GUIContainer_ChangePage(SIDEBAR_CONTAINER, GUIContainerPage_2);
+	GUI_RedrawDirtyRegions();
+	after = prvPixelWrites() - start;
+	prvSaveScreen();
+	TEST_CHECK(GUIButton_GetDisplayState(BUTTON_ID(0)) == GUIDisplayState_Hidden &&
+			   GUIButton_GetDisplayState(BUTTON_ID(6)) == GUIDisplayState_NotHidden, "the sidebar didn't change page");
+	start = prvPixelWrites();
+	GUIContainer_Draw(SIDEBAR_CONTAINER);
+	before = prvPixelWrites() - start;
+	TEST_CHECK(prvScreenIsSaved(), "the new page is different from when the container is drawn");
+	prvPrintTransition("page change", before, after);
+
+	/*
+	 * A pop-out over the main text box is closed, the main text box was read and written again before.
+	 * The screen must be the same as before the pop-out was shown, the data can't be lost and no character
+	 * on the edge of the region can be cut.
+	 */
+	GUI_RedrawDirtyRegions();
+	prvSaveScreen();
+	GUIContainer* popout = GUIContainer_GetFromId(POPOUT_CONTAINER);
+	LCDActiveWindow popoutWindow = { popout->object.xPos, popout->object.xPos + popout->object.width - 1,
+									 popout->object.yPos, popout->object.yPos + popout->object.height - 1 };
+	prvShowAndHidePopout();
+	TEST_CHECK(!prvScreenIsSaved(), "the pop-out was not drawn");
+	start = prvPixelWrites();
+	GUI_InvalidateRegion(GUILayer_0, popoutWindow);
+	GUI_RedrawDirtyRegions();
+	after = prvPixelWrites() - start;
+	TEST_CHECK(prvScreenIsSaved(), "the screen is different after the pop-out was closed");
+	TEST_CHECK(GUITextBox_GetNumOfCharactersDisplayed(MAIN_TEXT_BOX) == numOfCharacters,
+			   "%u characters in the main text box after the redraw",
+			   (unsigned)GUITextBox_GetNumOfCharactersDisplayed(MAIN_TEXT_BOX));
+	prvShowAndHidePopout();
+	start = prvPixelWrites();
+	GUITextBox_RefreshCurrentDataFromMemory(MAIN_TEXT_BOX);
+	before = prvPixelWrites() - start;
+	TEST_CHECK(prvScreenIsSaved(), "the screen is different after the main text box was refreshed");
+	prvPrintTransition("pop-out close", before, after);
+
+	/* New data after a redraw continues where the data ended */
+	prvShowAndHidePopout();
+	GUI_InvalidateRegion(GUILayer_0, popoutWindow);
+	GUI_RedrawDirtyRegions();
+	GUITextBox_AppendDataFromMemory(MAIN_TEXT_BOX, 1100);
+	prvSaveScreen();
+	GUITextBox_RefreshCurrentDataFromMemory(MAIN_TEXT_BOX);
+	TEST_CHECK(prvScreenIsSaved(), "the data appended after a redraw is different from the data read again");
+	TEST_CHECK(GUITextBox_GetNumOfCharactersDisplayed(MAIN_TEXT_BOX) == 1100, "%u characters after the append",
+			   (unsigned)GUITextBox_GetNumOfCharactersDisplayed(MAIN_TEXT_BOX));
+
+	/* Text written to a text box without data is gone after a redraw so the next text starts at the top */
+	uint16_t xPos, yPos;
+	LCDActiveWindow debugPart = { 700, 710, 450, 460 };
+	GUI_InvalidateRegion(GUILayer_0, debugPart);
+	GUI_RedrawDirtyRegions();
+	GUITextBox_GetWritePosition(DEBUG_TEXT_BOX, &xPos, &yPos);
+	TEST_CHECK(xPos == 0 && yPos == 0, "the write position is %u,%u after a redraw", xPos, yPos);
+
+	TEST_CHECK(lcdSimGetNumOfErrors() == 0, "the bus model found errors");
+	TEST_EXIT();
+}
@@ -0,0 +1,302 @@
+/**
+ ******************************************************************************
+ * @file	test_i2c_bus.c
+ * @brief	Host test of i2c2.c and the touch reads of ft5206.c on the model
+ *			of the I2C2 peripheral in i2c_bus_sim.c.
+ *
+ *			Reads and writes of every length the driver handles
+ *			differently and the set up and reads of the touch registers
+ *			are checked against the register file of a simulated FT5206,
+ *			including that exactly the requested bytes are clocked out of
+ *			it so the NACK and STOP of the last byte come in time. Touches
+ *			are then read through the touch interrupt and the events in
+ *			xLCDEventQueue are compared with what the controller reported.
+ *			Last the queue is filled by several clients to check the
+ *			priorities, the client stats and that no interrupt waits for
+ *			a stop condition. The time in the interrupts is reported like
+ *			on the system page.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "ft5206.h"
+#include "i2c2.h"
+#include "messages.h"
+
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define FT5206_ADDRESS			(0x38)
+#define FT5206_TD_STATUS		(0x02)
+#define FT5206_TOUCH1_XH		(0x03)
+#define FT5206_PERIODACTIVE		(0x88)
+#define FT5206_CIPHER			(0xA3)
+#define FT5206_MODE				(0xA4)
+
+#define NUM_OF_TOUCHES			(200)
+#define TOUCH_READ_TIME			(500)		/* us, more than enough for the four touch registers */
+#define NUM_OF_QUEUED			(6)
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t prvTouchRegisters[256];
+static uint32_t prvRandomState = 0x12C0DE;
+static uint32_t prvNumOfDone;
+static uint32_t prvTouchDoneOrder;		/* Number of queued transactions done before the last touch */
+
+/* xLCDEventQueue */
+static LCDEventMessage prvQueue[LCD_EVENT_QUEUE_SIZE];
+static uint32_t prvQueueCount;
+
+/* Stubs ---------------------------------------------------------------------*/
+BaseType_t xQueueSendToBackFromISR(QueueHandle_t Queue, const void* pItem, BaseType_t* pHigherPriorityTaskWoken)
+{
+	if (prvQueueCount == LCD_EVENT_QUEUE_SIZE)
+		return pdFALSE;
+	memcpy(&prvQueue[prvQueueCount++], pItem, sizeof(LCDEventMessage));
+	prvTouchDoneOrder = prvNumOfDone;
+	return pdTRUE;
+}
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief	Callback of the queued transactions
+ */
+static void prvTransactionDone(I2C2Transaction* pTransaction)
+{
+	prvNumOfDone++;
+}
+
+/**
+ * @brief	The controller has a new touch and pulls the interrupt
+ */
+static void prvTouch(FT5206Event Event, uint16_t X, uint16_t Y)
+{
+	prvTouchRegisters[FT5206_TOUCH1_XH + 0] = (Event << 6) | ((X >> 8) & 0x0F);
+	prvTouchRegisters[FT5206_TOUCH1_XH + 1] = X & 0xFF;
+	prvTouchRegisters[FT5206_TOUCH1_XH + 2] = (Y >> 8) & 0x0F;
+	prvTouchRegisters[FT5206_TOUCH1_XH + 3] = Y & 0xFF;
+	CTP_INT_Callback();
+}
+
+/**
+ * @brief	Reads and writes of every length, the slave must see exactly the bytes of the transfer
+ */
+static void prvTestRegisterTransfers()
+{
+	for (uint32_t i = 0; i < 256; i++)
+		prvTouchRegisters[i] = i * 7 + 1;
+
+	for (uint16_t size = 1; size <= 8; size++)
+	{
+		uint8_t data[8] = {0};
+		uint8_t reg = 0x40 + size * 8;
+		I2CSimCounters before = i2cSimGetCounters();
+		ErrorStatus status = I2C2_ReadRegister(FT5206_ADDRESS, reg, data, size, I2C2Client_Other);
+		I2CSimCounters after = i2cSimGetCounters();
+
+		TEST_CHECK(status == SUCCESS, "read of %u bytes failed", size);
+		TEST_CHECK(memcmp(data, &prvTouchRegisters[reg], size) == 0, "read of %u bytes got the wrong data", size);
+		TEST_CHECK(after.readBytes - before.readBytes == size, "read of %u bytes clocked %u bytes out of the slave",
+				   size, (unsigned)(after.readBytes - before.readBytes));
+		TEST_CHECK(after.writtenBytes - before.writtenBytes == 1 && after.starts - before.starts == 2,
+				   "read of %u bytes: %u bytes written with %u starts", size,
+				   (unsigned)(after.writtenBytes - before.writtenBytes), (unsigned)(after.starts - before.starts));
+
+		i2cSimRun(100);
+		after = i2cSimGetCounters();
+		TEST_CHECK(after.stops - before.stops == 1 && i2cSimIsIdle(), "read of %u bytes didn't release the bus", size);
+	}
+
+	for (uint16_t size = 1; size <= 4; size++)
+	{
+		uint8_t data[4] = {0xA1, 0xB2, 0xC3, 0xD4};
+		uint8_t reg = 0xC0 + size * 4;
+		I2CSimCounters before = i2cSimGetCounters();
+		ErrorStatus status = I2C2_WriteRegister(FT5206_ADDRESS, reg, data, size, I2C2Client_Other);
+		i2cSimRun(100);
+		I2CSimCounters after = i2cSimGetCounters();
+
+		TEST_CHECK(status == SUCCESS, "write of %u bytes failed", size);
+		TEST_CHECK(memcmp(data, &prvTouchRegisters[reg], size) == 0 && prvTouchRegisters[reg + size] == (uint8_t)((reg + size) * 7 + 1),
+				   "write of %u bytes changed the wrong registers", size);
+		TEST_CHECK(after.writtenBytes - before.writtenBytes == size + 1u && after.stops - before.stops == 1,
+				   "write of %u bytes: %u bytes written and %u stops", size,
+				   (unsigned)(after.writtenBytes - before.writtenBytes), (unsigned)(after.stops - before.stops));
+	}
+}
+
+/**
+ * @brief	The reads the LCD task can do itself, the slave must see exactly the bytes of the transfer
+ */
+static void prvTestTouchRegisterReads()
+{
+	FT5206Event event;
+	FT5206TouchCoordinate position;
+	prvTouchRegisters[FT5206_TD_STATUS] = 1;
+	prvTouchRegisters[FT5206_TOUCH1_XH + 0] = (FT5206Event_Contact << 6) | 0x03;
+	prvTouchRegisters[FT5206_TOUCH1_XH + 1] = 0x12;
+	prvTouchRegisters[FT5206_TOUCH1_XH + 2] = 0x01;
+	prvTouchRegisters[FT5206_TOUCH1_XH + 3] = 0xAB;
+
+	I2CSimCounters before = i2cSimGetCounters();
+	uint32_t numOfPoints = FT5206_GetNumOfTouchPoints();
+	FT5206_GetTouchDataForPoint(&event, &position, FT5206Point_1);
+	i2cSimRun(100);
+	I2CSimCounters after = i2cSimGetCounters();
+
+	TEST_CHECK(numOfPoints == 1, "%u touch points read", numOfPoints);
+	TEST_CHECK(event == FT5206Event_Contact && position.x == 0x312 && position.y == 0x1AB, "touch read as %u at %u,%u",
+			   event, position.x, position.y);
+	TEST_CHECK(after.readBytes - before.readBytes == 5 && after.writtenBytes - before.writtenBytes == 2,
+			   "%u bytes read and %u written, the slave must see exactly the bytes of the transfers",
+			   (unsigned)(after.readBytes - before.readBytes), (unsigned)(after.writtenBytes - before.writtenBytes));
+	TEST_CHECK(after.stops - before.stops == 2 && i2cSimIsIdle(), "the reads didn't release the bus");
+}
+
+/**
+ * @brief	Touches read in the background, every put down and put up must reach the LCD task with its position
+ */
+static void prvTestTouches()
+{
+	uint32_t numOfWrong = 0;
+	uint32_t numOfMoves = 0;
+	for (uint32_t i = 0; i < NUM_OF_TOUCHES; i++)
+	{
+		FT5206Event event = (i % 3 == 0) ? FT5206Event_PutDown : ((i % 3 == 1) ? FT5206Event_Contact : FT5206Event_PutUp);
+		uint16_t x = testRandom(&prvRandomState) % 800;
+		uint16_t y = testRandom(&prvRandomState) % 480;
+
+		prvQueueCount = 0;
+		prvTouch(event, x, y);
+		i2cSimRun(TOUCH_READ_TIME);
+
+		/* The move is coalesced, the LCD task takes the position from the driver */
+		bool isRight = false;
+		if (prvQueueCount == 1 && event == FT5206Event_Contact && prvQueue[0].event == LCDEvent_TouchMove)
+		{
+			FT5206TouchCoordinate position;
+			isRight = FT5206_GetPendingMove(prvQueue[0].data[0], &position) && position.x == x && position.y == y;
+			numOfMoves++;
+		}
+		else if (prvQueueCount == 1 && prvQueue[0].event == LCDEvent_TouchEvent)
+		{
+			isRight = MESSAGES_TOUCH_X(prvQueue[0].data[0]) == x && MESSAGES_TOUCH_Y(prvQueue[0].data[0]) == y &&
+					  MESSAGES_TOUCH_EVENT(prvQueue[0].data[1]) == event &&
+					  MESSAGES_TOUCH_POINT(prvQueue[0].data[1]) == FT5206Point_1;
+		}
+		if (!isRight)
+			numOfWrong++;
+	}
+	TEST_CHECK(numOfWrong == 0, "%u of %u touches didn't reach the LCD task right", numOfWrong, NUM_OF_TOUCHES);
+	TEST_CHECK(numOfMoves == (NUM_OF_TOUCHES + 1) / 3, "%u moves were seen", numOfMoves);
+
+	/* The put up comes while the last move is being read, both are read and in order */
+	prvQueueCount = 0;
+	prvTouch(FT5206Event_PutDown, 100, 200);
+	i2cSimRun(50);
+	prvTouch(FT5206Event_PutUp, 110, 210);
+	i2cSimRun(TOUCH_READ_TIME);
+	TEST_CHECK(prvQueueCount == 2 && MESSAGES_TOUCH_EVENT(prvQueue[1].data[1]) == FT5206Event_PutUp &&
+			   MESSAGES_TOUCH_X(prvQueue[1].data[0]) == 110, "the put up during a read was lost");
+	TEST_CHECK(i2cSimIsIdle(), "the bus is still busy after the touches");
+}
+
+/**
+ * @brief	Transactions from several clients at once, the touch reads go first and every client gets its stats
+ */
+static void prvTestQueue()
+{
+	static uint8_t data[NUM_OF_QUEUED][4];
+	static I2C2Transaction transactions[NUM_OF_QUEUED];
+	I2C2ClientStats touchBefore, otherBefore, touchAfter, otherAfter;
+	I2C2_GetClientStats(I2C2Client_Touch, &touchBefore);
+	I2C2_GetClientStats(I2C2Client_Other, &otherBefore);
+
+	/* Low priority reads are queued and a touch comes in while the first one is being read */
+	prvNumOfDone = 0;
+	for (uint32_t i = 0; i < NUM_OF_QUEUED; i++)
+	{
+		I2C2Transaction transaction = {
+				.devAddress			= FT5206_ADDRESS,
+				.useRegister		= true,
+				.registerAddress	= 0x40 + i * 4,
+				.direction			= I2C2Direction_Read,
+				.pBuffer			= data[i],
+				.size				= 1 + i % 4,
+				.priority			= I2C2Priority_Low,
+				.client				= I2C2Client_Other,
+				.callback			= prvTransactionDone,
+		};
+		transactions[i] = transaction;
+		TEST_CHECK(I2C2_Submit(&transactions[i]) == SUCCESS, "transaction %u was not queued", i);
+	}
+	TEST_CHECK(I2C2_Submit(&transactions[0]) == ERROR, "a queued transaction was queued again");
+
+	prvQueueCount = 0;
+	i2cSimRun(50);
+	prvTouch(FT5206Event_PutDown, 321, 123);
+	i2cSimRun(NUM_OF_QUEUED * TOUCH_READ_TIME);
+
+	TEST_CHECK(prvNumOfDone == NUM_OF_QUEUED && i2cSimIsIdle(), "%u of %u transactions done", prvNumOfDone,
+			   NUM_OF_QUEUED);
+	TEST_CHECK(prvQueueCount == 1 && prvTouchDoneOrder == 1, "the touch read was done after %u other transactions",
+			   prvTouchDoneOrder);
+	for (uint32_t i = 0; i < NUM_OF_QUEUED; i++)
+		TEST_CHECK(transactions[i].state == I2C2TransactionState_Done &&
+				   memcmp(data[i], &prvTouchRegisters[0x40 + i * 4], 1 + i % 4) == 0, "transaction %u went wrong", i);
+
+	I2C2_GetClientStats(I2C2Client_Touch, &touchAfter);
+	I2C2_GetClientStats(I2C2Client_Other, &otherAfter);
+	TEST_CHECK(touchAfter.numOfTransactions == touchBefore.numOfTransactions + 1 &&
+			   otherAfter.numOfTransactions == otherBefore.numOfTransactions + NUM_OF_QUEUED,
+			   "the stats counted %u touch and %u other transactions",
+			   touchAfter.numOfTransactions - touchBefore.numOfTransactions,
+			   otherAfter.numOfTransactions - otherBefore.numOfTransactions);
+	TEST_CHECK(touchAfter.maxLatency < TOUCH_READ_TIME && otherAfter.maxLatency > touchAfter.maxLatency,
+			   "max latency %u us for the touch and %u us for the others", touchAfter.maxLatency, otherAfter.maxLatency);
+
+	/* Nobody answers, the transfer fails and the bus is free again */
+	uint8_t byte;
+	TEST_CHECK(I2C2_ReadRegister(0x55, 0, &byte, 1, I2C2Client_Other) == ERROR, "a read from a missing slave worked");
+	i2cSimRun(100);
+	I2C2_GetClientStats(I2C2Client_Other, &otherAfter);
+	TEST_CHECK(otherAfter.numOfErrors == otherBefore.numOfErrors + 1 && i2cSimIsIdle(),
+			   "%u errors counted after a read from a missing slave", otherAfter.numOfErrors - otherBefore.numOfErrors);
+}
+
+/* Functions -----------------------------------------------------------------*/
+int main()
+{
+	i2cSimInit();
+	prvTouchRegisters[FT5206_CIPHER] = 0x55;
+	i2cSimAddDevice(FT5206_ADDRESS, prvTouchRegisters);
+
+	FT5206_Init();
+	i2cSimRun(100);
+	TEST_CHECK(prvTouchRegisters[FT5206_MODE] == FT5206InterruptMode_Trigger && prvTouchRegisters[FT5206_PERIODACTIVE] == 12,
+			   "the touch controller was not set up");
+
+	prvTestRegisterTransfers();
+	prvTestTouchRegisterReads();
+	prvTestTouches();
+	prvTestQueue();
+
+	I2CSimCounters counters = i2cSimGetCounters();
+	TEST_CHECK(i2cSimGetNumOfErrors() == 0, "the driver did %u things the peripheral would not handle",
+			   i2cSimGetNumOfErrors());
+	/* The touch interrupt only queues the read */
+	TEST_CHECK(FT5206_GetMaxInterruptCycles() != 0 && FT5206_GetMaxInterruptCycles() < 2 * (SystemCoreClock / 1000000),
+			   "the touch interrupt took %u cycles", FT5206_GetMaxInterruptCycles());
+
+	/* Nothing waits for the stop condition, it's looked at once at most, and CR1 is left alone until it has been sent */
+	TEST_CHECK(counters.stopWaitReads <= counters.stops && counters.writesDuringStop == 0,
+			   "%u CR1 reads and %u CR1 writes while a stop condition was being sent", (unsigned)counters.stopWaitReads,
+			   (unsigned)counters.writesDuringStop);
+	TEST_CHECK(counters.maxInterruptCycles < 2 * (SystemCoreClock / 1000000), "an I2C interrupt took %u cycles",
+			   (unsigned)counters.maxInterruptCycles);
+	printf("  touch interrupt max %u cycles, I2C interrupt max %u cycles, %u I2C interrupts\n",
+		   FT5206_GetMaxInterruptCycles(), (unsigned)counters.maxInterruptCycles, (unsigned)counters.interrupts);
+
+	TEST_EXIT();
+}
@@ -0,0 +1,330 @@
+/**
+ ******************************************************************************
+ * @file	test_lcd_bus.c
+ * @brief	Host test of the RA8875 driver in freertos-serial-monitor-lcd-test
+ *			on the bus model in lcd_bus_sim.c.
+ *
+ *			The LCD benchmark is run on the model and the transactions of
+ *			every benchmark are printed next to its result so a change that
+ *			adds bus traffic shows up without hardware. The frame buffer is
+ *			checked after the fills, the image writes and the BTE moves.
+ *			The rates printed only include the modelled bus and LCD time.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "lcd_bus_sim.h"
+#include "lcd_ra8875.h"
+#include "lcd_benchmark.h"
+#include "simple_gui.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define LCD_WIDTH					(LCD_SIM_WIDTH)
+#define LCD_HEIGHT					(LCD_SIM_HEIGHT)
+
+#define SMALL_IMAGE_WIDTH			(200)
+#define SMALL_IMAGE_HEIGHT			(100)
+
+#define MAX_NUM_OF_RESULTS			(16)
+
+/* Private typedefs ----------------------------------------------------------*/
+typedef struct
+{
+	char name[32];
+	LCDSimCounters bus;
+} BenchResult;
+
+/* Private variables ---------------------------------------------------------*/
+/* Lines printed by the benchmark and the bus counters at the last line */
+static char prvLine[128];
+static uint32_t prvLineLength = 0;
+static LCDSimCounters prvLastCounters;
+static BenchResult prvResults[MAX_NUM_OF_RESULTS];
+static uint32_t prvNumOfResults = 0;
+/* The screen after the BTE moves, the benchmarks after it draw over it */
+static bool prvMoveBlocksAreCopies = false;
+static bool prvMoveStayedInside = false;
+
+static uint32_t prvRandomState = 0x1F123BB5;
+
+static uint16_t prvSmallPixels[SMALL_IMAGE_WIDTH * SMALL_IMAGE_HEIGHT];
+static uint16_t prvScreenPixels[LCD_WIDTH * LCD_HEIGHT];
+static uint8_t prvCompressedData[LCD_WIDTH * LCD_HEIGHT * 3];
+
+/* Private function prototypes -----------------------------------------------*/
+static bool prvFrameBufferEquals(uint32_t XPos, uint32_t YPos, uint32_t Width, uint32_t Height,
+								 const uint16_t* pPixels, uint32_t Stride);
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief	The driver handles the WAIT interrupt in the EXTI callback
+ */
+static void prvWaitCallback()
+{
+	HAL_GPIO_EXTI_Callback(GPIO_PIN_11);
+}
+
+/**
+ * @brief	Handle one line printed by the benchmark
+ */
+static void prvBenchmarkLine(const char* pLine)
+{
+	printf("  %s\n", pLine);
+	LCDSimCounters now = lcdSimGetCounters();
+	if (strncmp(pLine, "BENCH,", 6) == 0 && prvNumOfResults < MAX_NUM_OF_RESULTS)
+	{
+		BenchResult* pResult = &prvResults[prvNumOfResults++];
+		sscanf(pLine + 6, "%31[^,]", pResult->name);
+		pResult->bus = lcdSimDifference(&now, &prvLastCounters);
+		if (strcmp(pResult->name, "bte_move") == 0)
+		{
+			prvMoveBlocksAreCopies = prvFrameBufferEquals(0, 0, 400, 240, prvScreenPixels, LCD_WIDTH) &&
+									 prvFrameBufferEquals(400, 240, 400, 240, prvScreenPixels, LCD_WIDTH);
+			prvMoveStayedInside = prvFrameBufferEquals(400, 0, 400, 240, &prvScreenPixels[400], LCD_WIDTH);
+		}
+	}
+	prvLastCounters = now;
+}
+
+static const BenchResult* prvFindResult(const char* pName)
+{
+	for (uint32_t i = 0; i < prvNumOfResults; i++)
+	{
+		if (strcmp(prvResults[i].name, pName) == 0)
+			return &prvResults[i];
+	}
+	TEST_CHECK(false, "no result for %s", pName);
+	static const BenchResult empty;
+	return &empty;
+}
+
+/**
+ * @brief	Run-length encode pixels the way lcd_image_converter.py does without a palette
+ * @retval	Size of the encoded data
+ */
+static uint32_t prvCompress(const uint16_t* pPixels, uint32_t NumOfPixels, uint8_t* pData)
+{
+	uint32_t size = 0;
+	uint32_t i = 0;
+	while (i < NumOfPixels)
+	{
+		uint32_t run = 1;
+		while (i + run < NumOfPixels && run < 128 && pPixels[i + run] == pPixels[i])
+			run++;
+		if (run >= 2)
+		{
+			pData[size++] = 0x80 | (run - 1);
+			pData[size++] = pPixels[i] & 0xFF;
+			pData[size++] = pPixels[i] >> 8;
+			i += run;
+			continue;
+		}
+
+		uint32_t literal = 1;
+		while (i + literal < NumOfPixels && literal < 128 &&
+			   !(i + literal + 1 < NumOfPixels && pPixels[i + literal] == pPixels[i + literal + 1]))
+			literal++;
+		pData[size++] = literal - 1;
+		for (uint32_t j = 0; j < literal; j++)
+		{
+			pData[size++] = pPixels[i + j] & 0xFF;
+			pData[size++] = pPixels[i + j] >> 8;
+		}
+		i += literal;
+	}
+	return size;
+}
+
+/**
+ * @brief	Compare a block of the frame buffer with pixels
+ */
+static bool prvFrameBufferEquals(uint32_t XPos, uint32_t YPos, uint32_t Width, uint32_t Height,
+								 const uint16_t* pPixels, uint32_t Stride)
+{
+	for (uint32_t y = 0; y < Height; y++)
+	{
+		if (memcmp(&lcdSimGetFrameBuffer()[YPos + y][XPos], &pPixels[y * Stride], Width * sizeof(uint16_t)) != 0)
+			return false;
+	}
+	return true;
+}
+
+static bool prvFrameBufferIs(uint16_t Color)
+{
+	for (uint32_t y = 0; y < LCD_HEIGHT; y++)
+	{
+		for (uint32_t x = 0; x < LCD_WIDTH; x++)
+		{
+			if (lcdSimGetFrameBuffer()[y][x] != Color)
+				return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief	The buttons the benchmark firmware draws
+ */
+static void prvAddButtons()
+{
+	static uint8_t* names[] = { "CAN1", "CAN2", "UART1", "UART2" };
+	static const uint32_t ids[] = { guiConfigCAN1_BUTTON_ID, guiConfigCAN2_BUTTON_ID,
+									guiConfigUART1_BUTTON_ID, guiConfigUART2_BUTTON_ID };
+
+	GUIButton_TypeDef button;
+	memset(&button, 0, sizeof(button));
+	button.disabledBackgroundColor = LCD_COLOR_BLACK;
+	button.pressedBackgroundColor = LCD_COLOR_WHITE;
+	button.enabledTextColor = LCD_COLOR_WHITE;
+	button.enabledBackgroundColor = button.disabledTextColor = button.pressedTextColor = LCD_COLOR_BLUE;
+	button.object.borderColor = LCD_COLOR_WHITE;
+	button.object.borderThickness = 1;
+	button.object.border = BORDER_BOTTOM | BORDER_RIGHT;
+	button.object.yPos = 0;
+	button.object.width = 100;
+	button.object.height = 50;
+	button.object.layer = LAYER0;
+	button.object.hidden = NOT_HIDDEN;
+	button.state = DISABLED;
+	button.textSize = ENLARGE_2X;
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		button.object.id = ids[i];
+		button.object.xPos = i * 100;
+		button.text = names[i];
+		GUI_AddButton(&button);
+	}
+}
+/* HAL -----------------------------------------------------------------------*/
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef* huart, uint8_t* pData, uint16_t Size, uint32_t Timeout)
+{
+	for (uint16_t i = 0; i < Size; i++)
+	{
+		if (pData[i] == '\n')
+		{
+			prvLine[prvLineLength] = '\0';
+			prvBenchmarkLine(prvLine);
+			prvLineLength = 0;
+		}
+		else if (pData[i] != '\r' && prvLineLength < sizeof(prvLine) - 1)
+			prvLine[prvLineLength++] = pData[i];
+	}
+	return HAL_OK;
+}
+
+/* Functions -----------------------------------------------------------------*/
+int main()
+{
+	lcdSimInit(prvWaitCallback);
+
+	/* Init clears the screen */
+	memset(lcdSimGetFrameBuffer(), 0xFF, LCD_WIDTH * LCD_HEIGHT * sizeof(uint16_t));
+	LCD_Init();
+	TEST_CHECK(prvFrameBufferIs(LCD_COLOR_BLACK), "LCD_Init did not clear the screen");
+
+	/* Text in a window continues at the left edge of the window and the position is read back */
+	LCD_SetForegroundColor(LCD_COLOR_WHITE);
+	LCD_ActiveWindow_TypeDef window = { 100, 179, 200, 299 };
+	uint16_t xPos = 100, yPos = 200;
+	LCDSimCounters before = lcdSimGetCounters();
+	LCD_WriteStringInActiveWindowAtPosition("0123456789ABCDEFGHIJKLMNO", NOT_TRANSPARENT, ENLARGE_1X,
+											window, &xPos, &yPos);
+	LCDSimCounters now = lcdSimGetCounters();
+	LCDSimCounters text = lcdSimDifference(&now, &before);
+	TEST_CHECK(xPos == 140 && yPos == 232, "text ended at %u,%u, expected 140,232", xPos, yPos);
+	TEST_CHECK(text.memoryWrites == 25, "%llu memory writes for 25 characters", (unsigned long long)text.memoryWrites);
+	TEST_CHECK(lcdSimGetFrameBuffer()[200][100] == LCD_COLOR_WHITE && lcdSimGetFrameBuffer()[247][179] == LCD_COLOR_BLACK &&
+			   lcdSimGetFrameBuffer()[232][139] == LCD_COLOR_WHITE && lcdSimGetFrameBuffer()[200][180] == LCD_COLOR_BLACK,
+			   "text was not drawn inside the window");
+
+	/* Images, the small one is streamed by the DMA in more than one chunk */
+	for (uint32_t i = 0; i < SMALL_IMAGE_WIDTH * SMALL_IMAGE_HEIGHT; i++)
+		prvSmallPixels[i] = testRandom(&prvRandomState);
+	for (uint32_t i = 0; i < LCD_WIDTH * LCD_HEIGHT; )
+	{
+		uint32_t run = 1 + testRandom(&prvRandomState) % 300;
+		uint16_t color = testRandom(&prvRandomState);
+		bool isNoise = (testRandom(&prvRandomState) & 3) == 0;
+		for (uint32_t j = 0; j < run && i < LCD_WIDTH * LCD_HEIGHT; j++, i++)
+			prvScreenPixels[i] = isNoise ? (uint16_t)testRandom(&prvRandomState) : color;
+	}
+	LCD_Image_TypeDef smallImage = { prvSmallPixels, SMALL_IMAGE_WIDTH, SMALL_IMAGE_HEIGHT };
+	LCD_CompressedImage_TypeDef screenImage = { prvCompressedData, 0, LCD_WIDTH, LCD_HEIGHT };
+	prvCompress(prvScreenPixels, LCD_WIDTH * LCD_HEIGHT, prvCompressedData);
+
+	/* The benchmark prints its results through HAL_UART_Transmit */
+	LCD_BENCHMARK_Init();
+	prvAddButtons();
+	printf("LCD benchmark on the bus model, the rates only include the modelled bus and LCD time:\n");
+	LCD_BENCHMARK_Run(&smallImage, &screenImage);
+
+	/* Bus transactions of every benchmark */
+	printf("\n%-24s %9s %9s %9s %9s %9s %9s %6s\n", "benchmark", "cmd wr", "reg wr", "mem wr", "dma wr",
+		   "status rd", "data rd", "irqs");
+	for (uint32_t i = 0; i < prvNumOfResults; i++)
+	{
+		const LCDSimCounters* pBus = &prvResults[i].bus;
+		printf("%-24s %9llu %9llu %9llu %9llu %9llu %9llu %6llu\n", prvResults[i].name,
+			   (unsigned long long)pBus->commandWrites, (unsigned long long)pBus->registerWrites,
+			   (unsigned long long)pBus->memoryWrites, (unsigned long long)pBus->dmaWrites,
+			   (unsigned long long)pBus->statusReads, (unsigned long long)pBus->dataReads,
+			   (unsigned long long)pBus->interrupts);
+	}
+
+	/* One memory write per character and a bounded number of register accesses per line */
+	const LCDSimCounters* pText = &prvFindResult("text")->bus;
+	TEST_CHECK(pText->memoryWrites == 20 * 64, "text: %llu memory writes for %u characters",
+			   (unsigned long long)pText->memoryWrites, 20 * 64);
+	TEST_CHECK(pText->commandWrites <= 20 * 8, "text: %llu command writes for 20 lines",
+			   (unsigned long long)pText->commandWrites);
+
+	/* A fill is a few register writes whatever the size, the last one was blue */
+	const LCDSimCounters* pFill = &prvFindResult("fill")->bus;
+	TEST_CHECK(pFill->memoryWrites == 0 && pFill->commandWrites + pFill->registerWrites <= 10 * 10,
+			   "fill: %llu register accesses for 10 fills",
+			   (unsigned long long)(pFill->commandWrites + pFill->registerWrites));
+	TEST_CHECK(pFill->dataReads == 0, "fill: reads data registers");
+
+	/* Every pixel of an image is written once and the set up is a constant number of writes */
+	const LCDSimCounters* pImage = &prvFindResult("image_write")->bus;
+	TEST_CHECK(pImage->memoryWrites + pImage->dmaWrites == 20 * SMALL_IMAGE_WIDTH * SMALL_IMAGE_HEIGHT,
+			   "image_write: %llu pixel writes", (unsigned long long)(pImage->memoryWrites + pImage->dmaWrites));
+	TEST_CHECK(pImage->commandWrites <= 20 * 20, "image_write: %llu command writes for 20 images",
+			   (unsigned long long)pImage->commandWrites);
+	TEST_CHECK(pImage->interrupts <= 20 * 6, "image_write: %llu interrupts for 20 images",
+			   (unsigned long long)pImage->interrupts);
+	const LCDSimCounters* pCompressed = &prvFindResult("image_write_compressed")->bus;
+	TEST_CHECK(pCompressed->memoryWrites == 20ULL * LCD_WIDTH * LCD_HEIGHT, "image_write_compressed: %llu pixel writes",
+			   (unsigned long long)pCompressed->memoryWrites);
+
+	/* The move copies the block inside the LCD, the compressed image was the last thing written */
+	const LCDSimCounters* pMove = &prvFindResult("bte_move")->bus;
+	TEST_CHECK(pMove->memoryWrites == 0 && pMove->dmaWrites == 0, "bte_move: pixels went over the bus");
+	TEST_CHECK(pMove->commandWrites + pMove->registerWrites + pMove->dataReads <= 20 * 40,
+			   "bte_move: %llu register accesses for 20 moves",
+			   (unsigned long long)(pMove->commandWrites + pMove->registerWrites + pMove->dataReads));
+	TEST_CHECK(prvMoveBlocksAreCopies, "bte_move: the blocks are not copies of the image");
+	TEST_CHECK(prvMoveStayedInside, "bte_move: wrote outside the destination");
+
+	/* The text box writes its ten characters per append */
+	const LCDSimCounters* pAppend = &prvFindResult("textbox_append")->bus;
+	TEST_CHECK(pAppend->memoryWrites == 100 * 10, "textbox_append: %llu memory writes for 1000 characters",
+			   (unsigned long long)pAppend->memoryWrites);
+
+	/* The image write on its own leaves the image on the screen */
+	LCD_BTEDisplayImageOfSizeAt(&smallImage, 37, 11);
+	LCD_WaitUntilIdle();
+	TEST_CHECK(prvFrameBufferEquals(37, 11, SMALL_IMAGE_WIDTH, SMALL_IMAGE_HEIGHT, prvSmallPixels, SMALL_IMAGE_WIDTH),
+			   "the image written with the DMA differs");
+	LCD_BTEDisplayCompressedImageAt(&screenImage, 0, 0);
+	LCD_WaitUntilIdle();
+	TEST_CHECK(prvFrameBufferEquals(0, 0, LCD_WIDTH, LCD_HEIGHT, prvScreenPixels, LCD_WIDTH),
+			   "the decoded compressed image differs");
+
+	TEST_CHECK(lcdSimGetNumOfErrors() == 0, "the bus model found errors");
+	TEST_EXIT();
+}
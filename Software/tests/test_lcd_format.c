@@ -0,0 +1,179 @@
+/**
+ ******************************************************************************
+ * @file	test_lcd_format.c
+ * @brief	Host test of the text format kernels in lcd_format.c.
+ *
+ *			Every format is compared with a reference built with snprintf
+ *			for all byte values and for random buffers of every size and
+ *			alignment so the four bytes at a time paths and their tails
+ *			are covered.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "lcd_format.h"
+
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define MAX_SIZE			(64)
+#define NUM_OF_BUFFERS		(2000)
+/* Written after the formatted characters to find writes past the end */
+#define GUARD				(0xA5)
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t prvRandomState = 0x2545F491;
+
+static const char* prvFormatName[] = {
+	"ASCII", "HexWithSpaces", "HexWithoutSpaces", "Decimal", "Binary", "CEscaped", "HexDump",
+};
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief	Reference for a single byte in every format except the hex dump
+ * @retval	The number of characters written
+ */
+static uint32_t prvReferenceByte(uint8_t Value, LCDTextFormat Format, char* pDestination)
+{
+	char buffer[16];
+	switch (Format)
+	{
+		case LCDTextFormat_ASCII:
+			pDestination[0] = Value;
+			return 1;
+		case LCDTextFormat_HexWithSpaces:
+			snprintf(buffer, sizeof(buffer), "%02X ", Value);
+			break;
+		case LCDTextFormat_HexWithoutSpaces:
+			snprintf(buffer, sizeof(buffer), "%02X", Value);
+			break;
+		case LCDTextFormat_Decimal:
+			snprintf(buffer, sizeof(buffer), "%3u ", Value);
+			break;
+		case LCDTextFormat_Binary:
+			for (int bit = 7; bit >= 0; bit--)
+				buffer[7 - bit] = '0' + ((Value >> bit) & 1);
+			buffer[8] = ' ';
+			buffer[9] = 0;
+			break;
+		case LCDTextFormat_CEscaped:
+		{
+			const char* escapes = "\0" "0" "\a" "a" "\b" "b" "\t" "t" "\n" "n" "\v" "v" "\f" "f" "\r" "r" "\\" "\\";
+			int escape = -1;
+			for (int i = 0; i < 9; i++)
+			{
+				if (escapes[2*i] == (char)Value)
+					escape = escapes[2*i + 1];
+			}
+			if (escape != -1)
+				snprintf(buffer, sizeof(buffer), "\\%c  ", escape);
+			else if (Value >= 0x20 && Value <= 0x7E)
+				snprintf(buffer, sizeof(buffer), "%c   ", Value);
+			else
+				snprintf(buffer, sizeof(buffer), "\\x%02X", Value);
+			break;
+		}
+		default:
+			return 0;
+	}
+	uint32_t length = strlen(buffer);
+	memcpy(pDestination, buffer, length);
+	return length;
+}
+
+/**
+ * @brief	Reference for a hex dump
+ * @retval	The number of characters written
+ */
+static uint32_t prvReferenceHexDump(const uint8_t* pSource, uint32_t Size, uint32_t Offset, char* pDestination)
+{
+	uint32_t numOfChars = 0;
+	for (uint32_t rowStart = 0; rowStart < Size; rowStart += LCD_HEX_DUMP_BYTES_PER_ROW)
+	{
+		char row[LCD_HEX_DUMP_CHARS_PER_ROW + 1];
+		int length = snprintf(row, sizeof(row), "%04X: ", (Offset + rowStart) & 0xFFFF);
+		for (uint32_t i = 0; i < LCD_HEX_DUMP_BYTES_PER_ROW; i++)
+		{
+			if (rowStart + i < Size)
+				length += snprintf(&row[length], sizeof(row) - length, "%02X ", pSource[rowStart + i]);
+			else
+				length += snprintf(&row[length], sizeof(row) - length, "   ");
+		}
+		length += snprintf(&row[length], sizeof(row) - length, "| ");
+		for (uint32_t i = 0; i < LCD_HEX_DUMP_BYTES_PER_ROW; i++)
+		{
+			char c = ' ';
+			if (rowStart + i < Size)
+				c = (pSource[rowStart + i] >= 0x20 && pSource[rowStart + i] <= 0x7E) ? pSource[rowStart + i] : '.';
+			row[length++] = c;
+		}
+		memcpy(&pDestination[numOfChars], row, length);
+		numOfChars += length;
+	}
+	return numOfChars;
+}
+
+/**
+ * @brief	Format with the kernel and the reference and compare
+ */
+static void prvCheck(const uint8_t* pSource, uint32_t Size, LCDTextFormat Format)
+{
+	static uint8_t formatted[MAX_SIZE * LCD_HEX_DUMP_CHARS_PER_ROW + 16];
+	static char reference[MAX_SIZE * LCD_HEX_DUMP_CHARS_PER_ROW + 16];
+
+	uint32_t referenceSize = 0;
+	if (Format == LCDTextFormat_HexDump)
+		referenceSize = prvReferenceHexDump(pSource, Size, 0, reference);
+	else
+	{
+		for (uint32_t i = 0; i < Size; i++)
+			referenceSize += prvReferenceByte(pSource[i], Format, &reference[referenceSize]);
+	}
+
+	memset(formatted, GUARD, sizeof(formatted));
+	uint32_t size = LCD_FormatBuffer(pSource, Size, formatted, Format);
+
+	TEST_CHECK(size == referenceSize, "%s: %u bytes gave %u characters, expected %u",
+			   prvFormatName[Format], Size, size, referenceSize);
+	TEST_CHECK(memcmp(formatted, reference, referenceSize) == 0, "%s: %u bytes differ from the reference",
+			   prvFormatName[Format], Size);
+	TEST_CHECK(formatted[size] == GUARD, "%s: %u bytes wrote past the end", prvFormatName[Format], Size);
+}
+
+/* Functions -----------------------------------------------------------------*/
+int main()
+{
+	/* Every byte value on its own and all of them in a row */
+	uint8_t allValues[256];
+	for (uint32_t i = 0; i < 256; i++)
+		allValues[i] = i;
+	for (LCDTextFormat format = LCDTextFormat_ASCII; format <= LCDTextFormat_HexDump; format++)
+	{
+		for (uint32_t i = 0; i < 256; i++)
+			prvCheck(&allValues[i], 1, format);
+		for (uint32_t i = 0; i + MAX_SIZE <= 256; i += MAX_SIZE)
+			prvCheck(&allValues[i], MAX_SIZE, format);
+	}
+
+	/* Random buffers of every size at every alignment */
+	static uint8_t source[MAX_SIZE + 4];
+	for (uint32_t n = 0; n < NUM_OF_BUFFERS; n++)
+	{
+		for (uint32_t i = 0; i < sizeof(source); i++)
+			source[i] = testRandom(&prvRandomState);
+		uint32_t size = n % (MAX_SIZE + 1);
+		uint32_t alignment = (n / (MAX_SIZE + 1)) % 4;
+		for (LCDTextFormat format = LCDTextFormat_ASCII; format <= LCDTextFormat_HexDump; format++)
+			prvCheck(&source[alignment], size, format);
+	}
+
+	/* The hex dump offset continues from the chunk before */
+	uint8_t formatted[LCD_HEX_DUMP_CHARS_PER_ROW * 2];
+	char reference[LCD_HEX_DUMP_CHARS_PER_ROW * 2];
+	uint32_t size = LCD_FormatHexDump(allValues, 12, 0x1234, formatted);
+	uint32_t referenceSize = prvReferenceHexDump(allValues, 12, 0x1234, reference);
+	TEST_CHECK(size == referenceSize && memcmp(formatted, reference, size) == 0, "hex dump with an offset differs");
+
+	TEST_EXIT();
+}
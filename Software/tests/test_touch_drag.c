@@ -0,0 +1,303 @@
+/**
+ ******************************************************************************
+ * @file	test_touch_drag.c
+ * @brief	Host test of the touch move coalescing in ft5206.c.
+ *
+ *			Drags are replayed sample by sample through the touch interrupt
+ *			and a simulated I2C read. A model of the LCD task drains
+ *			xLCDEventQueue the same way lcd_task.c does, and a 10 ms refresh
+ *			scrolls whole rows like the text box refresh. The test checks
+ *			that the queue never fills, that taps and the last position of a
+ *			drag are never merged away, that positions arrive in order and
+ *			that no scroll distance is lost, and it reports how many messages
+ *			and redraws a drag costs.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "ft5206.h"
+#include "i2c2.h"
+#include "messages.h"
+#include "simple_gui.h"
+
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define TIME_STEP				(10)		/* us */
+#define I2C_READ_TIME			(160)		/* us to read the four touch registers at 400 kHz */
+#define REFRESH_PERIOD			(10000)		/* us between text box refreshes */
+#define ROW_HEIGHT				(16)		/* Pixels scrolled by one row, SCROLL_ROW_HEIGHT in lcd_task.c */
+#define MAX_NUM_OF_SAMPLES		(700)
+#define FIRST_X					(50)		/* The x coordinate numbers the samples so they can be recognized */
+
+/* Private typedefs ----------------------------------------------------------*/
+typedef struct
+{
+	uint32_t time;					/* us */
+	FT5206Event event;
+	uint16_t x;
+	uint16_t y;
+} Sample;
+
+/* Private variables ---------------------------------------------------------*/
+static Sample prvSamples[MAX_NUM_OF_SAMPLES];
+static uint32_t prvNumOfSamples;
+static bool prvDelivered[MAX_NUM_OF_SAMPLES];
+static int32_t prvLastDelivered;
+static uint32_t prvRandomState = 0xC0FFEE;
+
+/* The touch registers of the controller, they always hold the latest sample */
+static uint8_t prvRegisters[4];
+
+/* The I2C read in progress */
+static uint32_t prvTime;
+static I2C2Transaction* prvActiveRead;
+static uint32_t prvReadDoneTime;
+
+/* xLCDEventQueue */
+static LCDEventMessage prvQueue[LCD_EVENT_QUEUE_SIZE];
+static uint32_t prvQueueHead;
+static uint32_t prvQueueCount;
+static uint32_t prvMaxQueueCount;
+static uint32_t prvNumOfLostMessages;
+
+/* Stubs ---------------------------------------------------------------------*/
+void I2C2_Init() {}
+
+ErrorStatus I2C2_ReadRegister(uint8_t DevAddress, uint8_t Register, uint8_t* pBuffer, uint16_t Size, I2C2Client Client)
+{
+	memset(pBuffer, 0, Size);
+	return SUCCESS;
+}
+
+ErrorStatus I2C2_WriteRegister(uint8_t DevAddress, uint8_t Register, uint8_t* pBuffer, uint16_t Size, I2C2Client Client)
+{
+	return SUCCESS;
+}
+
+ErrorStatus I2C2_SubmitFromISR(I2C2Transaction* pTransaction)
+{
+	TEST_CHECK(prvActiveRead == 0, "a second touch read was started before the first was done");
+	pTransaction->state = I2C2TransactionState_Active;
+	prvActiveRead = pTransaction;
+	prvReadDoneTime = prvTime + I2C_READ_TIME;
+	return SUCCESS;
+}
+
+BaseType_t xQueueSendToBackFromISR(QueueHandle_t Queue, const void* pItem, BaseType_t* pHigherPriorityTaskWoken)
+{
+	if (prvQueueCount == LCD_EVENT_QUEUE_SIZE)
+	{
+		prvNumOfLostMessages++;
+		return pdFALSE;
+	}
+	memcpy(&prvQueue[(prvQueueHead + prvQueueCount) % LCD_EVENT_QUEUE_SIZE], pItem, sizeof(LCDEventMessage));
+	if (++prvQueueCount > prvMaxQueueCount)
+		prvMaxQueueCount = prvQueueCount;
+	return pdTRUE;
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t Queue, const void* pItem, TickType_t BlockTime)
+{
+	return xQueueSendToBackFromISR(Queue, pItem, 0);
+}
+
+TickType_t xTaskGetTickCount()
+{
+	return 0;
+}
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief	Adds a drag: put down, moves along an ease-out path and put up
+ * @retval	The y distance of the drag
+ */
+static int32_t prvAddDrag(uint32_t* pTime, uint32_t SamplePeriod, uint32_t NumOfMoves, int32_t StartY, int32_t Distance)
+{
+	for (uint32_t i = 0; i <= NumOfMoves + 1; i++)
+	{
+		Sample* pSample = &prvSamples[prvNumOfSamples];
+		uint32_t step = (i > NumOfMoves) ? NumOfMoves : i;
+		double progress = (double)step / NumOfMoves;
+		pSample->time = *pTime;
+		pSample->event = (i == 0) ? FT5206Event_PutDown : (i > NumOfMoves ? FT5206Event_PutUp : FT5206Event_Contact);
+		pSample->x = FIRST_X + prvNumOfSamples;
+		pSample->y = StartY + (int32_t)(Distance * progress * (2.0 - progress));
+		prvNumOfSamples++;
+
+		/* The controller period jitters a little */
+		*pTime += SamplePeriod - SamplePeriod / 20 + testRandom(&prvRandomState) % (SamplePeriod / 10);
+	}
+	return prvSamples[prvNumOfSamples - 2].y - StartY;
+}
+
+/**
+ * @brief	What the LCD task does with a touch, Down is also used for every move like in lcd_task.c
+ */
+static void prvHandleTouch(GUITouchEvent Event, uint16_t X, uint16_t Y, bool IsPutDown, bool* pTouching,
+						   int32_t* pLastY, int32_t* pOffset)
+{
+	int32_t index = X - FIRST_X;
+	TEST_CHECK(index >= 0 && index < (int32_t)prvNumOfSamples, "unknown position %u,%u", X, Y);
+	TEST_CHECK(index > prvLastDelivered, "sample %d delivered after sample %d", index, prvLastDelivered);
+	prvDelivered[index] = true;
+	prvLastDelivered = index;
+
+	if (Event == GUITouchEvent_Up)
+		*pTouching = false;
+	else
+	{
+		if (*pTouching && !IsPutDown)
+			*pOffset += Y - *pLastY;
+		*pTouching = true;
+		*pLastY = Y;
+	}
+}
+
+/**
+ * @brief	Replays the samples
+ * @param	pName: Name in the report
+ * @param	HandlingTime: us the LCD task is busy with every touch message
+ * @param	TotalDistance: Sum of the y distances of the drags
+ * @retval	None
+ */
+static void prvReplay(const char* pName, uint32_t HandlingTime, int32_t TotalDistance)
+{
+	uint32_t nextSample = 0;
+	uint32_t lcdBusyUntil = 0;
+	uint32_t numOfHandled = 0;
+	uint32_t numOfRedraws = 0;
+	bool touching = false;
+	int32_t lastY = 0;
+	int32_t offset = 0;
+	int32_t scrolled = 0;
+
+	memset(prvDelivered, 0, sizeof(prvDelivered));
+	prvLastDelivered = -1;
+	prvMaxQueueCount = 0;
+	prvNumOfLostMessages = 0;
+
+	/* Runs until everything has been handled and the last rows have been scrolled */
+	uint32_t endTime = prvSamples[prvNumOfSamples - 1].time + 10000000;
+	for (uint32_t time = 0; time < endTime; time += TIME_STEP)
+	{
+		if (nextSample == prvNumOfSamples && prvQueueCount == 0 && prvActiveRead == 0 &&
+			time > lcdBusyUntil + REFRESH_PERIOD)
+			break;
+
+		prvTime = time;
+
+		/* The controller has a new sample and pulls the interrupt */
+		if (nextSample < prvNumOfSamples && prvSamples[nextSample].time <= time)
+		{
+			const Sample* pSample = &prvSamples[nextSample++];
+			prvRegisters[0] = (pSample->event << 6) | ((pSample->x >> 8) & 0x0F);
+			prvRegisters[1] = pSample->x & 0xFF;
+			prvRegisters[2] = (pSample->y >> 8) & 0x0F;
+			prvRegisters[3] = pSample->y & 0xFF;
+			CTP_INT_Callback();
+		}
+
+		/* The read finishes and the I2C interrupt calls back, which may start the next read */
+		if (prvActiveRead != 0 && time >= prvReadDoneTime)
+		{
+			I2C2Transaction* pTransaction = prvActiveRead;
+			prvActiveRead = 0;
+			memcpy(pTransaction->pBuffer, prvRegisters, pTransaction->size);
+			pTransaction->state = I2C2TransactionState_Done;
+			pTransaction->callback(pTransaction);
+		}
+
+		/* The LCD task takes the next message when it's done with the last one */
+		if (time >= lcdBusyUntil && prvQueueCount != 0)
+		{
+			LCDEventMessage message = prvQueue[prvQueueHead];
+			prvQueueHead = (prvQueueHead + 1) % LCD_EVENT_QUEUE_SIZE;
+			prvQueueCount--;
+			numOfHandled++;
+			lcdBusyUntil = time + HandlingTime;
+
+			if (message.event == LCDEvent_TouchEvent && MESSAGES_TOUCH_POINT(message.data[1]) == FT5206Point_1)
+			{
+				FT5206Event event = MESSAGES_TOUCH_EVENT(message.data[1]);
+				prvHandleTouch(event == FT5206Event_PutUp ? GUITouchEvent_Up : GUITouchEvent_Down,
+							   MESSAGES_TOUCH_X(message.data[0]), MESSAGES_TOUCH_Y(message.data[0]),
+							   event == FT5206Event_PutDown, &touching, &lastY, &offset);
+			}
+			else if (message.event == LCDEvent_TouchMove)
+			{
+				FT5206TouchCoordinate position;
+				if (FT5206_GetPendingMove(message.data[0], &position))
+					prvHandleTouch(GUITouchEvent_Down, position.x, position.y, false, &touching, &lastY, &offset);
+			}
+		}
+
+		/* The refresh moves all whole rows at once */
+		if (time % REFRESH_PERIOD == 0 && offset / ROW_HEIGHT != 0)
+		{
+			int32_t rows = offset / ROW_HEIGHT;
+			offset -= rows * ROW_HEIGHT;
+			scrolled += rows * ROW_HEIGHT;
+			numOfRedraws++;
+		}
+	}
+
+	TEST_CHECK(prvNumOfLostMessages == 0, "%s: %u messages didn't fit in the queue", pName, prvNumOfLostMessages);
+	TEST_CHECK(prvQueueCount == 0 && prvActiveRead == 0 && !touching, "%s: not done at the end", pName);
+	TEST_CHECK(scrolled + offset == TotalDistance, "%s: scrolled %d, the fingers moved %d", pName, scrolled + offset,
+			   TotalDistance);
+
+	/* Put down and put up are never merged, and neither is the last position before put up */
+	uint32_t numOfMovesDelivered = 0;
+	for (uint32_t i = 0; i < prvNumOfSamples; i++)
+	{
+		if (prvSamples[i].event != FT5206Event_Contact)
+			TEST_CHECK(prvDelivered[i], "%s: %s of sample %u was lost", pName,
+					   prvSamples[i].event == FT5206Event_PutUp ? "put up" : "put down", i);
+		else if (prvSamples[i + 1].event == FT5206Event_PutUp)
+			TEST_CHECK(prvDelivered[i], "%s: last move before put up in sample %u was lost", pName, i);
+		if (prvSamples[i].event == FT5206Event_Contact && prvDelivered[i])
+			numOfMovesDelivered++;
+	}
+
+	printf("  %-32s %3u samples, %3u messages handled, %3u moves seen, %2u redraws, queue max %u\n", pName,
+		   prvNumOfSamples, numOfHandled, numOfMovesDelivered, numOfRedraws, prvMaxQueueCount);
+}
+
+/* Functions -----------------------------------------------------------------*/
+int main()
+{
+	FT5206_Init();
+
+	/* A drag at 100 Hz with an LCD task that keeps up, every move is seen */
+	uint32_t time = 1000;
+	prvNumOfSamples = 0;
+	int32_t distance = prvAddDrag(&time, 10000, 60, 400, -300);
+	prvReplay("100 Hz, fast LCD task", 500, distance);
+
+	/* The same drag at 250 Hz while the LCD task spends 8 ms on every message, moves are merged to what it can handle */
+	time = 1000;
+	prvNumOfSamples = 0;
+	distance = prvAddDrag(&time, 4000, 150, 400, -300);
+	prvReplay("250 Hz, slow LCD task", 8000, distance);
+	uint32_t numOfMoves = 0;
+	for (uint32_t i = 0; i < prvNumOfSamples; i++)
+		numOfMoves += prvDelivered[i] && prvSamples[i].event == FT5206Event_Contact;
+	uint32_t maxNumOfMoves = (prvSamples[prvNumOfSamples - 1].time - prvSamples[0].time) / 8000 + 2;
+	TEST_CHECK(numOfMoves <= maxNumOfMoves, "250 Hz: %u of 150 moves handled, the LCD task only has time for %u",
+			   numOfMoves, maxNumOfMoves);
+
+	/* Quick flicks while the LCD task is slow, the next one starts before it has handled the end of the last one */
+	time = 1000;
+	prvNumOfSamples = 0;
+	distance = 0;
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		distance += prvAddDrag(&time, 4000, 12, 300 + i * 20, (i & 1) ? 120 : -150);
+		time += 1000 - 4000;
+	}
+	prvReplay("flicks back to back", 20000, distance);
+
+	TEST_EXIT();
+}
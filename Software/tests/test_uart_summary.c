@@ -0,0 +1,252 @@
+/**
+ ******************************************************************************
+ * @file	test_uart_summary.c
+ * @brief	Host test of the search summaries in uart_summary.c together with
+ *			the search in uart_search.c.
+ *
+ *			Realistic captures are logged through uartSummaryAdd into a
+ *			model of the FLASH and searched with and without the summaries.
+ *			Both must find the same matches, and the fraction of skipped
+ *			blocks and the FLASH read time saved are reported. The read time
+ *			is modelled from the 21 MHz SPI clock as the FLASH reads are what
+ *			a search spends its time on.
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "uart_search.h"
+#include "uart_summary.h"
+#include "spi_flash.h"
+#include "spi_flash_memory_map.h"
+
+#include <string.h>
+#include <stdlib.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define CHANNEL_SIZE			(0x100000)
+#define DATA_SIZE				(FLASH_CHANNEL_SUMMARY_OFFSET - 1000)	/* The last block is still being built */
+#define MAX_CHUNK_SIZE			(512)
+#define SPI_CLOCK				(21000000.0)
+#define READ_COMMAND_SIZE		(4)		/* Command and three address bytes */
+#define READ_OVERHEAD			(20e-6)	/* s to set up the DMA and wait for the semaphore */
+#define NUM_OF_CAPTURES			(3)
+
+/* Private typedefs ----------------------------------------------------------*/
+typedef struct
+{
+	uint32_t numOfReads;
+	uint32_t numOfBytes;
+} ReadCount;
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t prvFlash[CHANNEL_SIZE];
+static UARTSummary prvSummary;
+static UARTSearch prvSearch;
+static ReadCount prvDataReads;
+static ReadCount prvSummaryReads;
+static uint32_t prvRandomState = 0x1234567;
+
+/* FLASH model ---------------------------------------------------------------*/
+static uint8_t* prvFlashAt(uint32_t Address, uint32_t NumOfBytes)
+{
+	if (Address < FLASH_ADR_UART1_DATA || Address + NumOfBytes > FLASH_ADR_UART1_DATA + CHANNEL_SIZE)
+	{
+		printf("FLASH access outside the channel at 0x%X\n", Address);
+		exit(1);
+	}
+	return &prvFlash[Address - FLASH_ADR_UART1_DATA];
+}
+
+void SPI_FLASH_WriteByte(uint32_t WriteAddress, uint8_t Byte)
+{
+	/* Programming can only clear bits */
+	*prvFlashAt(WriteAddress, 1) &= Byte;
+}
+
+ErrorStatus SPI_FLASH_ReadBufferDMA(uint8_t* pBuffer, uint32_t ReadAddress, uint32_t NumByteToRead, TickType_t BlockTime)
+{
+	memcpy(pBuffer, prvFlashAt(ReadAddress, NumByteToRead), NumByteToRead);
+	prvSummaryReads.numOfReads++;
+	prvSummaryReads.numOfBytes += NumByteToRead;
+	return SUCCESS;
+}
+
+static ErrorStatus prvReadData(uint8_t* pBuffer, uint32_t ReadAddress, uint32_t NumByteToRead, TickType_t BlockTime)
+{
+	memcpy(pBuffer, prvFlashAt(ReadAddress, NumByteToRead), NumByteToRead);
+	prvDataReads.numOfReads++;
+	prvDataReads.numOfBytes += NumByteToRead;
+	return SUCCESS;
+}
+
+static double prvReadTime(const ReadCount* pCount)
+{
+	return pCount->numOfReads * (READ_OVERHEAD + READ_COMMAND_SIZE * 8 / SPI_CLOCK) + pCount->numOfBytes * 8 / SPI_CLOCK;
+}
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t prvRandom(uint32_t Max)
+{
+	return testRandom(&prvRandomState) % Max;
+}
+
+/**
+ * @brief	Appends the next message of a capture to a buffer
+ * @retval	Number of bytes
+ */
+static uint32_t prvMessage(uint32_t Capture, uint32_t Index, uint8_t* pBuffer)
+{
+	switch (Capture)
+	{
+		case 0:		/* Debug log of a sensor node */
+			if (prvRandom(40) == 0)
+				return sprintf((char*)pBuffer, "%8u W/batt: low voltage %u.%02u V\r\n", Index * 10, 3, prvRandom(100));
+			return sprintf((char*)pBuffer, "%8u I/main: temp=%u.%02u C, rh=%u.%u %%, fan=%u rpm\r\n",
+						   Index * 10, 20 + prvRandom(5), prvRandom(100), 40 + prvRandom(20), prvRandom(10),
+						   1100 + prvRandom(200));
+
+		case 1:		/* NMEA from a GPS receiver */
+			if (Index & 1)
+				return sprintf((char*)pBuffer, "$GPGGA,%02u%02u%02u.00,4807.%03u,N,01131.%03u,E,1,%02u,0.9,%u.%u,M,46.9,M,,*%02X\r\n",
+							   (Index / 3600) % 24, (Index / 60) % 60, Index % 60, prvRandom(1000), prvRandom(1000),
+							   4 + prvRandom(8), 540 + prvRandom(10), prvRandom(10), prvRandom(256));
+			return sprintf((char*)pBuffer, "$GPRMC,%02u%02u%02u.00,A,4807.%03u,N,01131.%03u,E,%03u.%u,%03u.%u,230394,003.1,W*%02X\r\n",
+						   (Index / 3600) % 24, (Index / 60) % 60, Index % 60, prvRandom(1000), prvRandom(1000),
+						   prvRandom(30), prvRandom(10), prvRandom(360), prvRandom(10), prvRandom(256));
+
+		default:	/* Binary Modbus RTU requests and responses */
+		{
+			uint32_t size = 0;
+			pBuffer[size++] = 1 + prvRandom(4);
+			pBuffer[size++] = 0x03;
+			if (Index & 1)
+			{
+				pBuffer[size++] = 0x00;
+				pBuffer[size++] = prvRandom(16);
+				pBuffer[size++] = 0x00;
+				pBuffer[size++] = 2;
+			}
+			else
+			{
+				pBuffer[size++] = 4;
+				for (uint32_t i = 0; i < 4; i++)
+					pBuffer[size++] = prvRandom(256);
+			}
+			pBuffer[size++] = prvRandom(256);
+			pBuffer[size++] = prvRandom(256);
+			return size;
+		}
+	}
+}
+
+/**
+ * @brief	Logs a capture the same way the UART tasks do, the summary sees the data before it's written
+ * @retval	Address of the rare pattern that was put in close to the end
+ */
+static uint32_t prvLogCapture(uint32_t Capture, const uint8_t* pRarePattern, uint32_t RarePatternSize)
+{
+	static uint8_t capture[DATA_SIZE + 256];
+	uint32_t size = 0;
+	for (uint32_t index = 0; size < DATA_SIZE; index++)
+		size += prvMessage(Capture, index, &capture[size]);
+
+	uint32_t rareOffset = DATA_SIZE - DATA_SIZE / 10;
+	memcpy(&capture[rareOffset], pRarePattern, RarePatternSize);
+
+	memset(prvFlash, 0xFF, sizeof(prvFlash));
+	uartSummaryReset(&prvSummary, FLASH_ADR_UART1_DATA, FLASH_ADR_UART1_DATA);
+	for (uint32_t offset = 0; offset < DATA_SIZE;)
+	{
+		uint32_t chunk = 1 + prvRandom(MAX_CHUNK_SIZE);
+		if (chunk > DATA_SIZE - offset)
+			chunk = DATA_SIZE - offset;
+		uartSummaryAdd(&prvSummary, FLASH_ADR_UART1_DATA + offset, &capture[offset], chunk);
+		memcpy(prvFlashAt(FLASH_ADR_UART1_DATA + offset, chunk), &capture[offset], chunk);
+		offset += chunk;
+	}
+	return FLASH_ADR_UART1_DATA + rareOffset;
+}
+
+/**
+ * @brief	Runs a search to the end
+ * @retval	The match address or 0 if there was no match
+ */
+static uint32_t prvRunSearch(UARTSummary* pSummary, uint32_t FromAddress, UARTSearchDirection Direction)
+{
+	uartSearchStart(&prvSearch, prvReadData, pSummary, FLASH_ADR_UART1_DATA, FLASH_ADR_UART1_DATA + DATA_SIZE,
+					FromAddress, Direction);
+	UARTSearchState state;
+	while ((state = uartSearchContinue(&prvSearch, 8)) == UARTSearchState_Searching);
+	TEST_CHECK(state == UARTSearchState_Found || state == UARTSearchState_NotFound, "search state %d", state);
+	return (state == UARTSearchState_Found) ? uartSearchGetMatchAddress(&prvSearch) : 0;
+}
+
+/**
+ * @brief	Searches for a pattern with and without the summary from a few places in both directions
+ * @retval	The fraction of the searched bytes that were skipped
+ */
+static double prvCompareSearches(const char* pName, const char* pPattern, uint32_t ExpectedMatch)
+{
+	static const uint32_t fromOffsets[] = {0, DATA_SIZE / 3, DATA_SIZE};
+	ReadCount plain = {0, 0}, summary = {0, 0};
+	uint64_t searched = 0, skipped = 0;
+
+	TEST_CHECK(uartSearchSetPattern(&prvSearch, (const uint8_t*)pPattern, strlen(pPattern)) == SUCCESS, "%s: pattern", pName);
+	for (uint32_t i = 0; i < sizeof(fromOffsets) / sizeof(fromOffsets[0]); i++)
+	{
+		for (UARTSearchDirection direction = UARTSearchDirection_Forward; direction <= UARTSearchDirection_Backward; direction++)
+		{
+			uint32_t from = FLASH_ADR_UART1_DATA + fromOffsets[i];
+
+			memset(&prvDataReads, 0, sizeof(ReadCount));
+			uint32_t expected = prvRunSearch(0, from, direction);
+			plain.numOfReads += prvDataReads.numOfReads;
+			plain.numOfBytes += prvDataReads.numOfBytes;
+
+			memset(&prvDataReads, 0, sizeof(ReadCount));
+			memset(&prvSummaryReads, 0, sizeof(ReadCount));
+			uint32_t match = prvRunSearch(&prvSummary, from, direction);
+			summary.numOfReads += prvDataReads.numOfReads + prvSummaryReads.numOfReads;
+			summary.numOfBytes += prvDataReads.numOfBytes + prvSummaryReads.numOfBytes;
+			searched += prvSearch.numOfBytesSearched;
+			skipped += prvSearch.numOfBytesSkipped;
+
+			TEST_CHECK(match == expected, "%s from 0x%X %s: match at 0x%X, 0x%X without the summary", pName, from,
+					   direction == UARTSearchDirection_Forward ? "forward" : "backward", match, expected);
+			if (i == 0 && direction == UARTSearchDirection_Forward && ExpectedMatch != 0)
+				TEST_CHECK(match == ExpectedMatch, "%s: first match at 0x%X, expected 0x%X", pName, match, ExpectedMatch);
+		}
+	}
+
+	double skippedFraction = searched ? (double)skipped / searched : 0.0;
+	printf("  %-28s skipped %5.1f %%, FLASH read %7.1f ms instead of %7.1f ms, %5.2fx\n", pName, skippedFraction * 100.0,
+		   prvReadTime(&summary) * 1000.0, prvReadTime(&plain) * 1000.0, prvReadTime(&plain) / prvReadTime(&summary));
+	return skippedFraction;
+}
+
+/* Functions -----------------------------------------------------------------*/
+int main()
+{
+	static const char* captureNames[NUM_OF_CAPTURES] = {"debug log", "NMEA", "Modbus RTU"};
+	static const char* rarePatterns[NUM_OF_CAPTURES] = {"E/main: PANIC", "$GPTXT,ANT OPEN", "\x01\x10\x01\x40\x7F\x02\x04\xAA"};
+
+	for (uint32_t capture = 0; capture < NUM_OF_CAPTURES; capture++)
+	{
+		const char* rare = rarePatterns[capture];
+		uint32_t rareAddress = prvLogCapture(capture, (const uint8_t*)rare, strlen(rare));
+		printf("%s:\n", captureNames[capture]);
+
+		/* A rare message has to be found in the middle of the data that is skipped, random binary data sets too many
+		   filter bits for that so it's only reported */
+		double skipped = prvCompareSearches("rare message", rare, rareAddress);
+		if (capture != 2)
+			TEST_CHECK(skipped > 0.5, "%s: only %.1f %% skipped for a rare message", captureNames[capture], skipped * 100.0);
+
+		/* Something that isn't there at all, and something that is everywhere */
+		prvCompareSearches("missing", capture == 2 ? "\x05\x06\x07\x08\x09\x0A" : "watchdog reset", 0);
+		prvCompareSearches("common", capture == 0 ? "rpm" : (capture == 1 ? "$GPRMC" : "\x03\x04"), 0);
+	}
+
+	TEST_EXIT();
+}
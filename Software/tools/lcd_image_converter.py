@@ -0,0 +1,346 @@
+#!/usr/bin/env python3
+"""
+ ******************************************************************************
+ * @file	lcd_image_converter.py
+ * @author	Hampus Sandberg
+ * @version	0.1
+ * @date	2015-02-14
+ * @brief	Converts PNG/PPM images to run-length encoded RGB565 C-files which
+ *			can be displayed with LCD_BTEDisplayCompressedImageAt()
+ ******************************************************************************
+	Copyright (c) 2015 Hampus Sandberg.
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation, either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+
+Format of the encoded data:
+	The pixels are stored top to bottom, left to right as a stream of packets.
+	Every packet starts with a header byte:
+		0x00-0x7F: Literal packet, (header + 1) pixels follow
+		0x80-0xFF: Run packet, one pixel follows which is repeated ((header & 0x7F) + 1) times
+	If the image has 256 colors or less every pixel is a 1 byte index into a
+	palette of RGB565 colors, otherwise every pixel is a 2 byte RGB565 value
+	stored little-endian.
+
+Usage:
+	lcd_image_converter.py input.png -n splash -o splash_image.c
+	lcd_image_converter.py input.ppm -n icon --type LCD_CompressedImage_TypeDef
+	lcd_image_converter.py --from-c-array test_image.c -W 30 -H 29 -n test
+
+Only the Python standard library is needed. PNG files must be non-interlaced
+with a bit depth of 8 (gray, RGB, palette, gray+alpha or RGBA).
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+RLE_RUN_FLAG = 0x80
+RLE_MAX_PACKET_LENGTH = 128
+MAX_PALETTE_SIZE = 256
+
+
+# Readers ----------------------------------------------------------------------
+def read_ppm(path):
+	"""Read a binary (P6) or ASCII (P3) PPM file, returns (width, height, [(r, g, b)])"""
+	with open(path, "rb") as f:
+		data = f.read()
+
+	# Split the header into tokens while skipping comments
+	tokens = []
+	index = 0
+	while len(tokens) < 4:
+		while data[index:index + 1].isspace():
+			index += 1
+		if data[index:index + 1] == b"#":
+			while data[index:index + 1] not in (b"\n", b""):
+				index += 1
+			continue
+		start = index
+		while not data[index:index + 1].isspace():
+			index += 1
+		tokens.append(data[start:index])
+
+	magic, width, height, maxValue = tokens[0], int(tokens[1]), int(tokens[2]), int(tokens[3])
+	if magic == b"P6":
+		index += 1
+		bytesPerSample = 2 if maxValue > 255 else 1
+		samples = []
+		for i in range(width * height * 3):
+			offset = index + i * bytesPerSample
+			if bytesPerSample == 2:
+				samples.append((data[offset] << 8) | data[offset + 1])
+			else:
+				samples.append(data[offset])
+	elif magic == b"P3":
+		samples = [int(x) for x in data[index:].split()[:width * height * 3]]
+	else:
+		raise ValueError("%s: only P3 and P6 PPM files are supported" % path)
+
+	scale = 255.0 / maxValue
+	pixels = [(int(samples[i] * scale), int(samples[i + 1] * scale), int(samples[i + 2] * scale))
+			  for i in range(0, len(samples), 3)]
+	return width, height, pixels
+
+
+def _paeth(a, b, c):
+	p = a + b - c
+	pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+	if pa <= pb and pa <= pc:
+		return a
+	if pb <= pc:
+		return b
+	return c
+
+
+def read_png(path):
+	"""Read an 8-bit non-interlaced PNG file, returns (width, height, [(r, g, b)])"""
+	with open(path, "rb") as f:
+		data = f.read()
+	if data[:8] != b"\x89PNG\r\n\x1a\n":
+		raise ValueError("%s: not a PNG file" % path)
+
+	index = 8
+	idat = b""
+	palette = []
+	while index < len(data):
+		length, chunkType = struct.unpack(">I4s", data[index:index + 8])
+		chunk = data[index + 8:index + 8 + length]
+		index += 12 + length
+		if chunkType == b"IHDR":
+			width, height, bitDepth, colorType, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+		elif chunkType == b"PLTE":
+			palette = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+		elif chunkType == b"IDAT":
+			idat += chunk
+		elif chunkType == b"IEND":
+			break
+
+	if bitDepth != 8 or interlace != 0:
+		raise ValueError("%s: only 8-bit non-interlaced PNG files are supported" % path)
+	channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[colorType]
+
+	raw = zlib.decompress(idat)
+	stride = width * channels
+	previous = bytearray(stride)
+	pixels = []
+	offset = 0
+	for y in range(height):
+		filterType = raw[offset]
+		line = bytearray(raw[offset + 1:offset + 1 + stride])
+		offset += 1 + stride
+		for x in range(stride):
+			left = line[x - channels] if x >= channels else 0
+			up = previous[x]
+			upLeft = previous[x - channels] if x >= channels else 0
+			if filterType == 1:
+				line[x] = (line[x] + left) & 0xFF
+			elif filterType == 2:
+				line[x] = (line[x] + up) & 0xFF
+			elif filterType == 3:
+				line[x] = (line[x] + ((left + up) >> 1)) & 0xFF
+			elif filterType == 4:
+				line[x] = (line[x] + _paeth(left, up, upLeft)) & 0xFF
+		previous = line
+
+		for x in range(width):
+			p = line[x * channels:(x + 1) * channels]
+			if colorType == 3:
+				pixels.append(palette[p[0]])
+			elif colorType in (0, 4):
+				pixels.append((p[0], p[0], p[0]))
+			else:
+				pixels.append((p[0], p[1], p[2]))
+	return width, height, pixels
+
+
+def read_c_array(path):
+	"""Read the RGB565 values from an existing uncompressed image C-file"""
+	with open(path, "r", errors="ignore") as f:
+		text = f.read()
+	body = text[text.index("{", text.index("image_data_")) + 1:]
+	body = body[:body.index("}")]
+	return [int(x, 16) for x in re.findall(r"0x[0-9a-fA-F]+", body)]
+
+
+# Encoding ---------------------------------------------------------------------
+def to_rgb565(pixel):
+	r, g, b = pixel
+	return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+
+
+def encode_rle(values):
+	"""Run-length encode a list of pixel symbols, returns a list of packets (isRun, [symbols])"""
+	packets = []
+	literal = []
+	i = 0
+	while i < len(values):
+		run = 1
+		while i + run < len(values) and values[i + run] == values[i] and run < RLE_MAX_PACKET_LENGTH:
+			run += 1
+
+		# Only break a literal packet for runs of 3 or more, a run of 2 costs the same as the literal
+		if run >= 3 or (run == 2 and not literal):
+			if literal:
+				packets.append((False, literal))
+				literal = []
+			packets.append((True, [values[i]]*run))
+			i += run
+		else:
+			literal.append(values[i])
+			i += 1
+			if len(literal) == RLE_MAX_PACKET_LENGTH:
+				packets.append((False, literal))
+				literal = []
+	if literal:
+		packets.append((False, literal))
+	return packets
+
+
+def serialize(packets, usePalette):
+	out = bytearray()
+	for isRun, symbols in packets:
+		if isRun:
+			out.append(RLE_RUN_FLAG | (len(symbols) - 1))
+			symbols = symbols[:1]
+		else:
+			out.append(len(symbols) - 1)
+		for symbol in symbols:
+			if usePalette:
+				out.append(symbol)
+			else:
+				out += struct.pack("<H", symbol)
+	return out
+
+
+def compress(colors):
+	"""Returns (palette or None, encoded bytes)"""
+	palette = sorted(set(colors))
+	if len(palette) <= MAX_PALETTE_SIZE:
+		lookup = {color: index for index, color in enumerate(palette)}
+		return palette, serialize(encode_rle([lookup[c] for c in colors]), True)
+	return None, serialize(encode_rle(colors), False)
+
+
+def decompress(data, palette, numOfPixels):
+	"""Reference decoder, same logic as the one in the LCD driver"""
+	pixels = []
+	index = 0
+	while len(pixels) < numOfPixels:
+		header = data[index]
+		index += 1
+		count = (header & 0x7F) + 1
+		for n in range(1 if header & RLE_RUN_FLAG else count):
+			if palette is not None:
+				pixel = palette[data[index]]
+				index += 1
+			else:
+				pixel = data[index] | (data[index + 1] << 8)
+				index += 2
+			pixels += [pixel]*(count if header & RLE_RUN_FLAG else 1)
+	return pixels
+
+
+# Output -----------------------------------------------------------------------
+def format_array(values, perLine, digits):
+	lines = []
+	for i in range(0, len(values), perLine):
+		lines.append("    " + ", ".join("0x%0*x" % (digits, v) for v in values[i:i + perLine]))
+	return ",\n".join(lines)
+
+
+def write_c_file(path, name, source, width, height, palette, data, typeName):
+	rawSize = width * height * 2
+	paletteSize = len(palette) * 2 if palette is not None else 0
+	text = []
+	text.append("/*******************************************************************************")
+	text.append("* image")
+	text.append("* filename: %s" % os.path.basename(source))
+	text.append("* name: %s" % name)
+	text.append("*")
+	text.append("* preset name: Color R5G6B5")
+	text.append("* data block size: 8 bit(s), uint8_t")
+	text.append("* RLE compression enabled: yes%s" % (", %d color palette" % len(palette) if palette is not None else ""))
+	text.append("* size: %d bytes (uncompressed %d bytes)" % (len(data) + paletteSize, rawSize))
+	text.append("*")
+	text.append("* generated by lcd_image_converter.py")
+	text.append("*******************************************************************************/")
+	text.append("")
+	text.append("#include \"lcd_ra8875.h\"")
+	text.append("")
+	if palette is not None:
+		text.append("static const uint16_t image_palette_%s[%d] = {" % (name, len(palette)))
+		text.append(format_array(palette, 8, 4))
+		text.append("};")
+		text.append("")
+	text.append("static const uint8_t image_data_%s[%d] = {" % (name, len(data)))
+	text.append(format_array(list(data), 16, 2))
+	text.append("};")
+	text.append("")
+	text.append("const %s %s = {image_data_%s, %s, %d, %d};" %
+				(typeName, name, name, "image_palette_" + name if palette is not None else "0", width, height))
+	text.append("")
+
+	with open(path, "w", newline="\r\n") as f:
+		f.write("\n".join(text))
+
+
+def main():
+	parser = argparse.ArgumentParser(description="Convert an image to a run-length encoded RGB565 C-file")
+	parser.add_argument("input", help="PNG or PPM file, or an uncompressed image C-file with --from-c-array")
+	parser.add_argument("-n", "--name", required=True, help="Name of the image variable")
+	parser.add_argument("-o", "--output", help="Output C-file, default is <name>_image.c")
+	parser.add_argument("--type", default="LCDCompressedImage",
+						help="Name of the image struct type (LCD_CompressedImage_TypeDef in the lcd-test project)")
+	parser.add_argument("--from-c-array", action="store_true", help="Input is an uncompressed image C-file")
+	parser.add_argument("-W", "--width", type=int, help="Width of the image, needed with --from-c-array")
+	parser.add_argument("-H", "--height", type=int, help="Height of the image, needed with --from-c-array")
+	args = parser.parse_args()
+
+	if args.from_c_array:
+		if args.width is None or args.height is None:
+			parser.error("--width and --height are needed with --from-c-array")
+		width, height = args.width, args.height
+		colors = read_c_array(args.input)[:width * height]
+	else:
+		extension = os.path.splitext(args.input)[1].lower()
+		if extension == ".png":
+			width, height, pixels = read_png(args.input)
+		elif extension in (".ppm", ".pnm"):
+			width, height, pixels = read_ppm(args.input)
+		else:
+			parser.error("unsupported file type: %s" % extension)
+		colors = [to_rgb565(p) for p in pixels]
+
+	if len(colors) != width * height:
+		sys.exit("error: expected %d pixels but got %d" % (width * height, len(colors)))
+
+	palette, data = compress(colors)
+	if decompress(data, palette, width * height) != colors:
+		sys.exit("error: verification of the encoded data failed")
+
+	output = args.output or "%s_image.c" % args.name
+	write_c_file(output, args.name, args.input, width, height, palette, data, args.type)
+
+	compressedSize = len(data) + (len(palette) * 2 if palette is not None else 0)
+	print("%s: %dx%d, %d -> %d bytes (%.1f %%)%s" %
+		  (output, width, height, width * height * 2, compressedSize, 100.0 * compressedSize / (width * height * 2),
+		   ", %d color palette" % len(palette) if palette is not None else ""))
+
+
+if __name__ == "__main__":
+	main()